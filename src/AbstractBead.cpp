@@ -28,20 +28,10 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // Default constructor
 
-CAbstractBead::CAbstractBead() : m_id(0), m_Type(0), m_bIsVisible(true), m_bIsMovable(true), m_bIsFrozen(false), m_ForceCounter(0), 
-#if SimIdentifier == BD
-                                 m_Radius(0.0),
-                                 m_TransDiff(0.0),
-                                 m_RotDiff(0.0)
-#else
+CAbstractBead::CAbstractBead() : m_id(0), m_Type(0), m_bIsVisible(true), m_bIsMovable(true), m_bIsFrozen(false),
+                                 m_ColdIndex(CBeadColdState::Create()), m_ForceCounter(0),
                                  m_Radius(0.0)
-#endif
 {
-#if EnableDPDLG == ExperimentEnabled
-    m_LGRadius  = 0.0;
-    m_LGDensity = 0.0;
-#endif
-
 #if EnableParallelSimBox == SimMPSEnabled
     m_pPolymer = 0;
 #endif
@@ -51,12 +41,10 @@ CAbstractBead::CAbstractBead() : m_id(0), m_Type(0), m_bIsVisible(true), m_bIsMo
 		m_Pos[i]		= 0.0;
 		m_Mom[i]		= 0.0;
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
@@ -76,20 +64,10 @@ CAbstractBead::CAbstractBead(long type) : m_id(-1), m_Type(type),
 										  m_bIsVisible(true), 
 										  m_bIsMovable(true), 
 										  m_bIsFrozen(false), 
+										  m_ColdIndex(CBeadColdState::Create()),
 										  m_ForceCounter(0),
-#if SimIdentifier == BD
-                                 m_Radius(0.0),
-                                 m_TransDiff(0.0),
-                                 m_RotDiff(0.0)
-#else
                                  m_Radius(0.0)
-#endif
 {
-#if EnableDPDLG == ExperimentEnabled
-    m_LGRadius  = 0.0;
-    m_LGDensity = 0.0;
-#endif
-
 #if EnableParallelSimBox == SimMPSEnabled
     m_pPolymer = 0;
 #endif
@@ -99,12 +77,10 @@ CAbstractBead::CAbstractBead(long type) : m_id(-1), m_Type(type),
 		m_Pos[i]		= 0.0;
 		m_Mom[i]		= 0.0;
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
@@ -122,20 +98,10 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable,
 															m_bIsVisible(true),
 															m_bIsMovable(movable),
 															m_bIsFrozen(false),
+															m_ColdIndex(CBeadColdState::Create()),
 															m_ForceCounter(0),
-#if SimIdentifier == BD
-                                                            m_Radius(0.5),
-                                                            m_TransDiff(0.0),
-                                                            m_RotDiff(0.0)
-#else
                                                             m_Radius(0.5)
-#endif
 {
-#if EnableDPDLG == ExperimentEnabled
-    m_LGRadius  = 0.0;
-    m_LGDensity = 0.0;
-#endif
-
 #if EnableParallelSimBox == SimMPSEnabled
     m_pPolymer = 0;
 #endif
@@ -145,12 +111,10 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable,
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
@@ -166,20 +130,10 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius,
 															m_bIsVisible(true),
 															m_bIsMovable(movable),
 															m_bIsFrozen(false),
+															m_ColdIndex(CBeadColdState::Create()),
 															m_ForceCounter(0),
-#if SimIdentifier == BD
-                                                            m_Radius(radius),
-                                                            m_TransDiff(0.0),
-                                                            m_RotDiff(0.0)
-#else
                                                             m_Radius(radius)
-#endif
 {
-#if EnableDPDLG == ExperimentEnabled
-    m_LGRadius  = 0.0;
-    m_LGDensity = 0.0;
-#endif
-
 #if EnableParallelSimBox == SimMPSEnabled
     m_pPolymer = 0;
 #endif
@@ -189,12 +143,10 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius,
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
@@ -205,17 +157,17 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius,
 // Constructor that sets the force parameter for a liquid-gas DPD simulation
 // using a density-dependent potential.
 
-#if EnableDPDLG == ExperimentEnabled
 CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius, double lgRadius,
 							 double x0[3], double v0[3] ) : m_id(id), m_Type(type), 
 															m_bIsVisible(true),
 															m_bIsMovable(movable),
 															m_bIsFrozen(false),
+															m_ColdIndex(CBeadColdState::Create()),
 															m_ForceCounter(0),
-                                                            m_Radius(radius),
-                                                            m_LGRadius(lgRadius),
-                                                            m_LGDensity(0.0)
+                                                            m_Radius(radius)
 {
+    CBeadColdState::SetLGRadius(m_ColdIndex, lgRadius);
+
 #if EnableParallelSimBox == SimMPSEnabled
     m_pPolymer = 0;
 #endif
@@ -225,19 +177,16 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius, do
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
 	}
 }
-#endif
 
 // Constructor for use in the parallel code when beads need access to their 
 // parent polymer.
@@ -248,6 +197,7 @@ CAbstractBead::CAbstractBead(CPolymer* const pPolymer, long id, long type, bool
 															m_bIsVisible(true),
 															m_bIsMovable(movable),
 															m_bIsFrozen(false),
+															m_ColdIndex(CBeadColdState::Create()),
 															m_ForceCounter(0),
                                                             m_Radius(radius),
                                                             m_pPolymer(pPolymer)
@@ -257,12 +207,10 @@ CAbstractBead::CAbstractBead(CPolymer* const pPolymer, long id, long type, bool
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
@@ -278,20 +226,9 @@ CAbstractBead::CAbstractBead(const CAbstractBead& oldBead) : m_id(oldBead.m_id),
 															 m_bIsVisible(oldBead.m_bIsVisible),
 															 m_bIsMovable(oldBead.m_bIsMovable),
 															 m_bIsFrozen(oldBead.m_bIsFrozen),
+															 m_ColdIndex(CBeadColdState::Copy(oldBead.m_ColdIndex)),
 															 m_ForceCounter(oldBead.m_ForceCounter),
-#if SimIdentifier == BD
-															 m_Radius(oldBead.m_Radius),
-															 m_TransDiff(oldBead.m_TransDiff),
-															 m_RotDiff(oldBead.m_RotDiff)
-#else
-#if EnableDPDLG == ExperimentDisabled
 															 m_Radius(oldBead.m_Radius)
-#elif EnableDPDLG == ExperimentEnabled
-															 m_Radius(oldBead.m_Radius),
-															 m_LGRadius(oldBead.m_LGRadius),
-															 m_LGDensity(oldBead.m_LGDensity)
-#endif
-#endif
 #if EnableParallelSimBox == SimMPSEnabled
                                                              , m_pPolymer(oldBead.m_pPolymer)
 #endif                                                          
@@ -302,13 +239,11 @@ CAbstractBead::CAbstractBead(const CAbstractBead& oldBead) : m_id(oldBead.m_id),
 		m_Pos[i]		= oldBead.m_Pos[i];
 		m_Mom[i]		= oldBead.m_Mom[i];
 		m_Force[i]		= oldBead.m_Force[i];
-		m_AngMom[i]		= oldBead.m_AngMom[i];
 
 		m_oldPos[i]		= oldBead.m_oldPos[i];
 		m_oldMom[i]		= oldBead.m_oldMom[i];
 		m_oldForce[i]	= oldBead.m_oldForce[i];
 
-		m_InitialPos[i]	= oldBead.m_InitialPos[i];
 		m_unPBCPos[i]	= oldBead.m_unPBCPos[i];
 		m_dPos[i]		= oldBead.m_dPos[i];
 		m_Stress[3*i]	= oldBead.m_Stress[3*i];
@@ -317,8 +252,11 @@ CAbstractBead::CAbstractBead(const CAbstractBead& oldBead) : m_id(oldBead.m_id),
 	}
 }
 
+// The destructor releases the bead's index into the cold state table.
+
 CAbstractBead::~CAbstractBead()
 {
+	CBeadColdState::Release(m_ColdIndex);
 }
 
 // Function used in the parallel code to set the bead's owning polymer. This allows
@@ -20,6 +20,7 @@ class CPolymer;
 #include "SimDefs.h"
 #include "ExperimentDefs.h"
 #include "SimMPSFlags.h"
+#include "BeadColdState.h"
 
 class CAbstractBead  
 {
@@ -32,10 +33,12 @@ class CAbstractBead
 	friend class CBond;
 	friend class CBondPair;
 	friend class CCNTCell;
+	friend class CCNTCellBeadStore;
 	friend class CExternalCNTCell;
 	friend class CForceTarget;
 	friend class CMonitor;
 	friend class CSimBox;
+	friend class CSingleBeadSampleKernel;
 	friend class taForceDecorator;	// Needed by command target force decorators
 
 // Friend classes for parallel code
@@ -54,10 +57,8 @@ public:
 	CAbstractBead(long id, long type, bool movable, double radius,
 				  double x0[3], double v0[3] );
 
-#if EnableDPDLG == ExperimentEnabled
 	CAbstractBead(long id, long type, bool movable, double radius, double lgRadius,
 				  double x0[3], double v0[3] );
-#endif
 
 #if EnableParallelSimBox == SimMPSEnabled
     CAbstractBead(CPolymer* const pPolymer, long id, long type, bool movable, double radius,
@@ -77,15 +78,11 @@ public:
 	inline bool	  GetFrozen()	const {return m_bIsFrozen;}
 	inline double GetRadius()	const {return m_Radius;}
 
-#if EnableDPDLG == ExperimentEnabled
-	inline double GetLGRadius()	    const {return m_LGRadius;}
-	inline double GetLGDensity()    const {return m_LGDensity;}
-#endif
+	inline double GetLGRadius()	    const {return CBeadColdState::GetLGRadius(m_ColdIndex);}
+	inline double GetLGDensity()    const {return CBeadColdState::GetLGDensity(m_ColdIndex);}
 
-#if SimIdentifier == BD
-	inline double GetTransDiff()	const {return m_TransDiff;}
-	inline double GetRotDiff()	    const {return m_RotDiff;}
-#endif
+	inline double GetTransDiff()	const {return CBeadColdState::GetTransDiff(m_ColdIndex);}
+	inline double GetRotDiff()	    const {return CBeadColdState::GetRotDiff(m_ColdIndex);}
 
 #if EnableParallelSimBox == SimMPSEnabled
 	void SetOwningPolymer(CPolymer* pPolymer);
@@ -105,16 +102,19 @@ public:
 	inline double GetYForce()	const {return m_Force[1];}
 	inline double GetZForce()	const {return m_Force[2];}
 
-	inline double GetXAngMom()	const {return m_AngMom[0];}
-	inline double GetYAngMom()	const {return m_AngMom[1];}
-	inline double GetZAngMom()	const {return m_AngMom[2];}
+	// The angular momentum is not stored but derived from the current
+	// position and momentum whenever an observable asks for it.
+
+	inline double GetXAngMom()	const {return  m_Pos[1]*m_Mom[2] - m_Pos[2]*m_Mom[1];}
+	inline double GetYAngMom()	const {return -m_Pos[0]*m_Mom[2] + m_Pos[2]*m_Mom[0];}
+	inline double GetZAngMom()	const {return  m_Pos[0]*m_Mom[1] - m_Pos[1]*m_Mom[0];}
 
 	inline double GetunPBCXPos()	const {return m_unPBCPos[0];}
 	inline double GetunPBCYPos()	const {return m_unPBCPos[1];}
 	inline double GetunPBCZPos()	const {return m_unPBCPos[2];}
-	inline double GetInitialXPos()	const {return m_InitialPos[0];}
-	inline double GetInitialYPos()	const {return m_InitialPos[1];}
-	inline double GetInitialZPos()	const {return m_InitialPos[2];}
+	inline double GetInitialXPos()	const {return CBeadColdState::GetInitialPos(m_ColdIndex, 0);}
+	inline double GetInitialYPos()	const {return CBeadColdState::GetInitialPos(m_ColdIndex, 1);}
+	inline double GetInitialZPos()	const {return CBeadColdState::GetInitialPos(m_ColdIndex, 2);}
 
     // Functions to returned bead coordinates shifted to whole simulation Space
 
@@ -172,15 +172,12 @@ public:
 	inline void   SetVisible(bool bVisible)	{m_bIsVisible	= bVisible;}
 	inline void   SetRadius(double radius)	{m_Radius		= radius;}
 
-#if EnableDPDLG == ExperimentEnabled
-	inline void   SetLGRadius(double radius)   {m_LGRadius	= radius;}
-	inline void   SetLGDensity(double density) {m_LGDensity	= density;}
-#endif
+	inline void   SetLGRadius(double radius)   {CBeadColdState::SetLGRadius(m_ColdIndex, radius);}
+	inline void   SetLGDensity(double density) {CBeadColdState::SetLGDensity(m_ColdIndex, density);}
+	inline void   AddLGDensity(double density) {CBeadColdState::AddLGDensity(m_ColdIndex, density);}
 
-#if SimIdentifier == BD
-	inline void   SetTransDiff(double diff)	{m_TransDiff    = diff;}
-	inline void   SetRotDiff(double diff)	{m_RotDiff      = diff;}
-#endif
+	inline void   SetTransDiff(double diff)	{CBeadColdState::SetTransDiff(m_ColdIndex, diff);}
+	inline void   SetRotDiff(double diff)	{CBeadColdState::SetRotDiff(m_ColdIndex, diff);}
 
 	inline void   SetXPos(double x)			{m_Pos[0] = x;}
 	inline void   SetYPos(double y)			{m_Pos[1] = y;}
@@ -194,9 +191,9 @@ public:
 	inline void	  SetunPBCXPos(double x)	{m_unPBCPos[0] = x;}
 	inline void   SetunPBCYPos(double y)	{m_unPBCPos[1] = y;}
 	inline void   SetunPBCZPos(double z)	{m_unPBCPos[2] = z;}
-	inline void   SetInitialXPos(double x)	{m_InitialPos[0] = x;}
-	inline void   SetInitialYPos(double y)	{m_InitialPos[1] = y;}
-	inline void   SetInitialZPos(double z)	{m_InitialPos[2] = z;}
+	inline void   SetInitialXPos(double x)	{CBeadColdState::SetInitialPos(m_ColdIndex, 0, x);}
+	inline void   SetInitialYPos(double y)	{CBeadColdState::SetInitialPos(m_ColdIndex, 1, y);}
+	inline void   SetInitialZPos(double z)	{CBeadColdState::SetInitialPos(m_ColdIndex, 2, z);}
 	inline void   SetdXPos(double x)		{m_dPos[0] = x;}
 	inline void   SetdYPos(double y)		{m_dPos[1] = y;}
 	inline void   SetdZPos(double z)		{m_dPos[2] = z;}
@@ -221,6 +218,13 @@ public:
 	virtual bool  SetFrozen()		= 0;	// must be provided by derived classes
 	virtual bool  SetNotFrozen()	= 0;	// must be provided by derived classes
 
+private:
+
+	// Explicitly disallow the assignment operator by declaring it privately
+	// but providing NO definition, as each bead owns its index into the cold state table.
+
+	CAbstractBead& operator=(const CAbstractBead& rhs);
+
 protected:
 
 	long m_id;				// member variable order here sets order of initialisation
@@ -228,34 +232,29 @@ protected:
 	bool m_bIsVisible;		// Indicates a bead is written to current state snapshots
 	bool m_bIsMovable;		// Indicates a bead can move in the current time step
 	bool m_bIsFrozen;		// Indicates a bead has been frozen in place		
+	const int m_ColdIndex;	// Index of initial position and LG/BD parameters in CBeadColdState
 
 	long   m_ForceCounter;  // Debug variable to count how many interactions a bead has 
 
 	double m_Radius;		// Interaction radius
 
-#if EnableDPDLG == ExperimentEnabled
-	double m_LGRadius;		// Interaction radius for density-dependent LG force
-	double m_LGDensity;		// Local bead density for density-dependent LG force
-#endif
 
-#if SimIdentifier == BD
-    double m_TransDiff;     // Translational diffusion coefficient for BD beads
-    double m_RotDiff;       // Rotational diffusion coefficient for BD beads
-#endif
+	// The members below are the bead's state that is read or written on every
+	// time step. The initial position and fixed LG/BD parameters are held in
+	// the CBeadColdState table at the index above.
 
 	double m_Pos[3];		// Current coordinates
 	double m_Mom[3];
 	double m_Force[3];
-	double m_AngMom[3];
 
 	double m_oldPos[3];		// Coordinates at previous time step
 	double m_oldMom[3];
 	double m_oldForce[3];
 
 	double m_unPBCPos[3];
-	double m_InitialPos[3];
 	double m_dPos[3];		// Differential position coordinates
-	double m_Stress[9];
+
+	double m_Stress[9];		// Stress tensor contributions from non-bonded and bonded forces
     
 #if EnableParallelSimBox == SimMPSEnabled
     CPolymer* m_pPolymer;   // Parent polymer needed for trans-processor messaging
@@ -31,6 +31,10 @@ public:
 	
 	inline BeadList GetBeads()		const {return m_lBeads;}
 
+	// Access to the cell's own bead list without copying it
+
+	inline const BeadList& GetBeadList() const {return m_lBeads;}
+
 	inline void SetId(long id) {m_id = id;}
 
 
@@ -28,7 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-long CAnalysis::m_AggregateTotal = 0;
+thread_local long CAnalysis::m_AggregateTotal = 0;
 
 long CAnalysis::GetAggregateTotal()
 {
@@ -143,6 +143,16 @@ bool CAnalysis::TimeToAnalyse(long simTime, long analysisPeriod) const
 		return false;
 }
 
+// Function showing if the analysis object uses the stress tensor profile 
+// calculated by the CMonitor. Derived classes that call StressTensorProfile()
+// must override this function so that the stress contributions are 
+// accumulated on the time steps that they are sampled.
+
+bool CAnalysis::IsStressProfileUsed() const
+{
+	return false;
+}
+
 // Forwarding unction to the enclosed aggregate state object.
 
 bool CAnalysis::Serialize() const
@@ -93,6 +93,12 @@ public:
 
 	virtual void ConvertNames(const CAnalysisState& raState) = 0;
 
+	// Function showing if the analysis uses the stress tensor averaged over 
+	// slices through the SimBox. The CMonitor only accumulates the stress 
+	// contributions on sampling steps when an analysis object needs them.
+
+	virtual bool IsStressProfileUsed() const;
+
 	// ****************************************
 	// Function to tell the enclosed aggregate state object to write its data to file
 
@@ -121,7 +127,7 @@ protected:
 	// Static member variables
 
 private:
-	static long m_AggregateTotal;		// Number of aggregates created
+	static thread_local long m_AggregateTotal;		// Number of aggregates created
 
 
 	// Local member variables
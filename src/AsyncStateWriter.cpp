@@ -0,0 +1,184 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// AsyncStateWriter.cpp: implementation of the CAsyncStateWriter class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "AsyncStateWriter.h"
+#include "IStateSnapshot.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CAsyncStateWriter::CAsyncStateWriter(long maxPending) : m_MaxPending(maxPending > 0 ? maxPending : 1),
+														m_BufferTotal(0), m_FailedTotal(0),
+														m_bStop(false)
+{
+	m_vFreeBuffers.clear();
+	m_Jobs.clear();
+}
+
+// The destructor waits for the writer to finish all submitted states before
+// deleting the buffers.
+
+CAsyncStateWriter::~CAsyncStateWriter()
+{
+	Stop();
+
+	for(std::vector<Buffer*>::iterator iterBuffer=m_vFreeBuffers.begin(); iterBuffer!=m_vFreeBuffers.end(); iterBuffer++)
+	{
+		delete *iterBuffer;
+	}
+
+	m_vFreeBuffers.clear();
+}
+
+// Function to return an empty buffer from the pool, creating one if fewer than
+// the maximum number exist. If all the buffers are in use, we wait for the 
+// writer to return one.
+
+CAsyncStateWriter::Buffer* CAsyncStateWriter::AcquireBuffer()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+
+	while(m_vFreeBuffers.empty() && m_BufferTotal >= m_MaxPending)
+	{
+		m_BufferCondition.wait(lock);
+	}
+
+	if(m_vFreeBuffers.empty())
+	{
+		m_BufferTotal++;
+		return new Buffer();
+	}
+
+	Buffer* const pBuffer = m_vFreeBuffers.back();
+	m_vFreeBuffers.pop_back();
+
+	return pBuffer;
+}
+
+// Function to return a buffer to the pool without writing a state, e.g., if 
+// the state cannot be written asynchronously. Its contents are discarded but
+// its memory is kept for reuse.
+
+void CAsyncStateWriter::ReleaseBuffer(Buffer* const pBuffer)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		pBuffer->m_vLong.clear();
+		pBuffer->m_vDouble.clear();
+		m_vFreeBuffers.push_back(pBuffer);
+	}
+
+	m_BufferCondition.notify_all();
+}
+
+// Function to pass a state and its filled buffer to the writer thread. The 
+// writer takes ownership of the state and deletes it once written.
+
+void CAsyncStateWriter::Submit(IStateSnapshot* const pState, Buffer* const pBuffer)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		if(!m_Writer.joinable())
+		{
+			m_Writer = std::thread(&CAsyncStateWriter::WriterLoop, this);
+		}
+
+		m_Jobs.push_back(Job(pState, pBuffer));
+	}
+
+	m_JobCondition.notify_one();
+}
+
+// Function to wait until all submitted states have been written and stop the
+// writer thread. A state submitted afterwards starts a new thread.
+
+void CAsyncStateWriter::Stop()
+{
+	if(m_Writer.joinable())
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_bStop = true;
+		}
+
+		m_JobCondition.notify_all();
+		m_Writer.join();
+
+		m_bStop = false;
+	}
+}
+
+// Function to return the number of states the writer has failed to write
+// since the last call, so that the caller can report each failure once.
+
+long CAsyncStateWriter::TakeFailedTotal()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+
+	const long failedTotal = m_FailedTotal;
+	m_FailedTotal = 0;
+
+	return failedTotal;
+}
+
+// Private function executed by the writer thread. It writes the submitted 
+// states in order until told to stop, and always empties the queue before 
+// exiting so that no output is lost.
+
+void CAsyncStateWriter::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+
+	while(true)
+	{
+		while(m_Jobs.empty() && !m_bStop)
+		{
+			m_JobCondition.wait(lock);
+		}
+
+		if(m_Jobs.empty())
+			return;
+
+		const Job job = m_Jobs.front();
+		m_Jobs.pop_front();
+
+		lock.unlock();
+
+		const bool bWritten = job.first->WriteSnapshot();
+
+		delete job.first;
+
+		job.second->m_vLong.clear();
+		job.second->m_vDouble.clear();
+
+		lock.lock();
+
+		if(!bWritten)
+		{
+			m_FailedTotal++;
+		}
+
+		m_vFreeBuffers.push_back(job.second);
+
+		m_BufferCondition.notify_all();
+	}
+}
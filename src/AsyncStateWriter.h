@@ -0,0 +1,107 @@
+// AsyncStateWriter.h: interface for the CAsyncStateWriter class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_ASYNCSTATEWRITER_H__B72E4D19_0A6C_4F38_9D51_E36C8A2F7B04__INCLUDED_)
+#define AFX_ASYNCSTATEWRITER_H__B72E4D19_0A6C_4F38_9D51_E36C8A2F7B04__INCLUDED_
+
+
+// Forward declarations
+
+class IStateSnapshot;
+
+
+#include "xxBase.h"
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Background writer for xxState-derived objects that implement the 
+// IStateSnapshot interface. The simulation thread takes a buffer from the
+// writer's pool, copies the data to be written into it, and submits the state
+// with its buffer. A single writer thread then formats and writes each state
+// in the order submitted, deletes it and returns its buffer to the pool.
+//
+// The number of buffers is bounded: if all of them are waiting to be written,
+// AcquireBuffer() blocks until the writer has finished with one, so a slow 
+// file system delays the simulation instead of consuming unbounded memory.
+// Buffers keep their capacity when they are returned, so that after the first
+// few snapshots no memory is allocated. The writer thread is started when the
+// first state is submitted, and Stop() or the destructor waits for all 
+// submitted states to be written. The writer only counts the states it fails
+// to write: the simulation thread collects the count with TakeFailedTotal()
+// and reports the failures.
+//
+// Only current state snapshots are written this way. Restart states read the
+// whole SimBox and polymer data, and must be complete when the simulation
+// stops; density states are kept by the CMonitor for analysis and refer to
+// their grid observable's data; history and log output is small. These are
+// all still written on the simulation thread. No output is compressed.
+
+class CAsyncStateWriter
+{
+public:
+
+	// Buffer holding a snapshot of the data to be written by a state
+
+	struct Buffer
+	{
+		zLongVector   m_vLong;
+		zDoubleVector m_vDouble;
+	};
+
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CAsyncStateWriter(long maxPending = 4);
+
+	~CAsyncStateWriter();
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetMaxPending()   const {return m_MaxPending;}
+
+	Buffer* AcquireBuffer();
+	void    ReleaseBuffer(Buffer* const pBuffer);
+	void    Submit(IStateSnapshot* const pState, Buffer* const pBuffer);
+	void    Stop();
+	long    TakeFailedTotal();
+
+	// ****************************************
+	// Private functions
+private:
+
+	void WriterLoop();
+
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CAsyncStateWriter(const CAsyncStateWriter& oldWriter);
+	CAsyncStateWriter& operator=(const CAsyncStateWriter& rhs);
+
+	// ****************************************
+	// Data members
+private:
+
+	typedef std::pair<IStateSnapshot*, Buffer*> Job;
+
+	const long m_MaxPending;			// Maximum number of buffers in use
+	long       m_BufferTotal;			// Number of buffers created
+	long       m_FailedTotal;			// Number of states that could not be written since last collected
+	bool       m_bStop;					// Flag telling the writer thread to exit
+
+	std::vector<Buffer*> m_vFreeBuffers;
+	std::deque<Job>      m_Jobs;
+
+	std::thread             m_Writer;
+	std::mutex              m_Mutex;
+	std::condition_variable m_JobCondition;		// Signalled when a job is submitted
+	std::condition_variable m_BufferCondition;	// Signalled when a buffer is returned
+};
+
+#endif // !defined(AFX_ASYNCSTATEWRITER_H__B72E4D19_0A6C_4F38_9D51_E36C8A2F7B04__INCLUDED_)
@@ -18,9 +18,11 @@ class CBeadChargeWrapper
 	// so that this wrapper class cannot be instantiated elsewhere, and the
 	// destructor is not virtual because we have no base classes.
 	// Other command classes that need to modify charged beads must also be
-	// declared as friends here.
+	// declared as friends here. The CChargedBeadCellList calculates the
+	// forces between charged beads for the SimBox when a cutoff is set.
 
 	friend class CSimBox;
+	friend class CChargedBeadCellList;
 	friend class ccChargeBeadByTypeImpl;
 	friend class ccUnchargeBeadByTypeImpl;
 
@@ -0,0 +1,157 @@
+// BeadColdState.cpp: implementation of the CBeadColdState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "BeadColdState.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Static member variable holding the table for the current thread.
+//////////////////////////////////////////////////////////////////////
+
+thread_local CBeadColdState* CBeadColdState::m_pTable = 0;
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CBeadColdState::CBeadColdState() : m_BeadTotal(0)
+{
+	m_vFree.clear();
+	m_vInitialPos.clear();
+	m_vLGRadius.clear();
+	m_vLGDensity.clear();
+	m_vTransDiff.clear();
+	m_vRotDiff.clear();
+}
+
+// Function to return a new index into the table for a bead, creating the 
+// table if this is the first bead in the thread. A released index is reused
+// if one is available, otherwise the arrays are extended. Only the initial 
+// position array is extended here: the parameter arrays grow when a bead sets
+// a value beyond their current end. All values of a new index are zero.
+
+int CBeadColdState::Create()
+{
+	if(!m_pTable)
+	{
+		m_pTable = new CBeadColdState();
+	}
+
+	int index = 0;
+
+	if(!m_pTable->m_vFree.empty())
+	{
+		index = m_pTable->m_vFree.back();
+		m_pTable->m_vFree.pop_back();
+
+		for(short int i=0; i<3; i++)
+		{
+			m_pTable->m_vInitialPos[3*index+i] = 0.0;
+		}
+
+		if(index < static_cast<int>(m_pTable->m_vLGRadius.size()))
+			m_pTable->m_vLGRadius[index] = 0.0;
+
+		if(index < static_cast<int>(m_pTable->m_vLGDensity.size()))
+			m_pTable->m_vLGDensity[index] = 0.0;
+
+		if(index < static_cast<int>(m_pTable->m_vTransDiff.size()))
+			m_pTable->m_vTransDiff[index] = 0.0;
+
+		if(index < static_cast<int>(m_pTable->m_vRotDiff.size()))
+			m_pTable->m_vRotDiff[index] = 0.0;
+	}
+	else
+	{
+		index = static_cast<int>(m_pTable->m_vInitialPos.size()/3);
+		m_pTable->m_vInitialPos.resize(3*(index+1), 0.0);
+	}
+
+	m_pTable->m_BeadTotal++;
+
+	return index;
+}
+
+// Function to return a new index holding a copy of the values at an existing one.
+
+int CBeadColdState::Copy(int oldIndex)
+{
+	const int index = Create();
+
+	for(short int i=0; i<3; i++)
+	{
+		SetInitialPos(index, i, GetInitialPos(oldIndex, i));
+	}
+
+	if(GetLGRadius(oldIndex) != 0.0)
+		SetLGRadius(index, GetLGRadius(oldIndex));
+
+	if(GetLGDensity(oldIndex) != 0.0)
+		SetLGDensity(index, GetLGDensity(oldIndex));
+
+	if(GetTransDiff(oldIndex) != 0.0)
+		SetTransDiff(index, GetTransDiff(oldIndex));
+
+	if(GetRotDiff(oldIndex) != 0.0)
+		SetRotDiff(index, GetRotDiff(oldIndex));
+
+	return index;
+}
+
+// Function to release an index when its bead is destroyed. When the last 
+// bead in the thread is destroyed the table is deleted.
+
+void CBeadColdState::Release(int index)
+{
+	if(m_pTable)
+	{
+		m_pTable->m_vFree.push_back(index);
+
+		if(--m_pTable->m_BeadTotal == 0)
+		{
+			delete m_pTable;
+			m_pTable = 0;
+		}
+	}
+}
+
+void CBeadColdState::SetLGRadius(int index, double radius)
+{
+	SetParameter(m_pTable->m_vLGRadius, index, radius);
+}
+
+void CBeadColdState::SetLGDensity(int index, double density)
+{
+	SetParameter(m_pTable->m_vLGDensity, index, density);
+}
+
+void CBeadColdState::AddLGDensity(int index, double density)
+{
+	SetParameter(m_pTable->m_vLGDensity, index, GetLGDensity(index) + density);
+}
+
+void CBeadColdState::SetTransDiff(int index, double diff)
+{
+	SetParameter(m_pTable->m_vTransDiff, index, diff);
+}
+
+void CBeadColdState::SetRotDiff(int index, double diff)
+{
+	SetParameter(m_pTable->m_vRotDiff, index, diff);
+}
+
+// Private function to store a parameter value, extending its array to cover
+// all the indices in use the first time it is set.
+
+void CBeadColdState::SetParameter(std::vector<double>& rvValues, int index, double value)
+{
+	if(index >= static_cast<int>(rvValues.size()))
+	{
+		rvValues.resize(m_pTable->m_vInitialPos.size()/3, 0.0);
+	}
+
+	rvValues[index] = value;
+}
@@ -0,0 +1,86 @@
+// BeadColdState.h: interface for the CBeadColdState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_BEADCOLDSTATE_H__58E3A1C6_0F47_4B2D_A9D5_7E61C2B04F38__INCLUDED_)
+#define AFX_BEADCOLDSTATE_H__58E3A1C6_0F47_4B2D_A9D5_7E61C2B04F38__INCLUDED_
+
+
+#include "SimDefs.h"
+
+#include <vector>
+
+// Side table holding the bead data that is set once and only read when a
+// simulation is built or analysed: the initial position, the LG interaction
+// radius and the BD diffusion coefficients. The local bead density used by 
+// the DPD-LG force is also held here as only LG runs need it. Each 
+// CAbstractBead obtains an index into the table when it is created so that 
+// the bead itself contains only the data written during a standard time step.
+// The data are stored as arrays rather than records, and the arrays for the
+// LG and BD data are only allocated when a bead first sets them, so a standard
+// DPD run pays only for the initial positions. Indices released by destroyed
+// beads are reused.
+//
+// Each simulation runs in its own thread (see CEnsemble), so the table is
+// thread_local and needs no locking. It is deleted when its last bead is
+// destroyed so that its memory is returned to the system.
+
+class CBeadColdState
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	static int  Create();
+	static int  Copy(int oldIndex);
+	static void Release(int index);
+
+	// ****************************************
+	// Access functions
+public:
+
+	static inline double GetInitialPos(int index, short int i) {return m_pTable->m_vInitialPos[3*index+i];}
+	static inline void   SetInitialPos(int index, short int i, double x) {m_pTable->m_vInitialPos[3*index+i] = x;}
+
+	static inline double GetLGRadius(int index)  {return GetParameter(m_pTable->m_vLGRadius, index);}
+	static inline double GetLGDensity(int index) {return GetParameter(m_pTable->m_vLGDensity, index);}
+	static inline double GetTransDiff(int index) {return GetParameter(m_pTable->m_vTransDiff, index);}
+	static inline double GetRotDiff(int index)   {return GetParameter(m_pTable->m_vRotDiff, index);}
+
+	static void SetLGRadius(int index, double radius);
+	static void SetLGDensity(int index, double density);
+	static void AddLGDensity(int index, double density);
+	static void SetTransDiff(int index, double diff);
+	static void SetRotDiff(int index, double diff);
+
+	// ****************************************
+	// Implementation
+private:
+
+	CBeadColdState();
+
+	static inline double GetParameter(const std::vector<double>& rvValues, int index)
+	{
+		return index < static_cast<int>(rvValues.size()) ? rvValues[index] : 0.0;
+	}
+
+	static void SetParameter(std::vector<double>& rvValues, int index, double value);
+
+	// ****************************************
+	// Data members
+private:
+
+	static thread_local CBeadColdState* m_pTable;	// Table for the simulation running in this thread
+
+	long              m_BeadTotal;		// Number of beads holding an index
+	std::vector<int>  m_vFree;			// Indices released by destroyed beads
+
+	std::vector<double> m_vInitialPos;	// Three components per index
+	std::vector<double> m_vLGRadius;	// Interaction radius for density-dependent LG force
+	std::vector<double> m_vLGDensity;	// Local bead density for density-dependent LG force
+	std::vector<double> m_vTransDiff;	// Translational diffusion coefficient for BD beads
+	std::vector<double> m_vRotDiff;		// Rotational diffusion coefficient for BD beads
+
+};
+
+#endif // !defined(AFX_BEADCOLDSTATE_H__58E3A1C6_0F47_4B2D_A9D5_7E61C2B04F38__INCLUDED_)
@@ -0,0 +1,93 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// BeadGridSampleKernel.cpp: implementation of the CBeadGridSampleKernel class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "BeadGridSampleKernel.h"
+#include "AbstractBead.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CBeadGridSampleKernel::CBeadGridSampleKernel(long xCellNo, long yCellNo, long zCellNo,
+											 double xCellWidth, double yCellWidth, double zCellWidth) : m_GridXCellNo(xCellNo),
+											 m_GridYCellNo(yCellNo),
+											 m_GridCellTotal(xCellNo*yCellNo*zCellNo),
+											 m_GridXCellWidth(xCellWidth),
+											 m_GridYCellWidth(yCellWidth),
+											 m_GridZCellWidth(zCellWidth),
+											 m_TypeTotal(0)
+{
+}
+
+CBeadGridSampleKernel::~CBeadGridSampleKernel()
+{
+}
+
+// Function to set the number of bead types that are counted. It must be 
+// called again if new bead types are created during a run.
+
+void CBeadGridSampleKernel::SetBeadTypeTotal(long typeTotal)
+{
+	m_TypeTotal = typeTotal;
+}
+
+void CBeadGridSampleKernel::StartSample(long threadTotal)
+{
+	m_vvCounts.resize(threadTotal);
+
+	for(long thread=0; thread<threadTotal; thread++)
+	{
+		m_vvCounts[thread].assign(m_TypeTotal*m_GridCellTotal, 0.0);
+	}
+}
+
+// Function to add a bead to the count for its type in the grid cell that 
+// contains it.
+
+void CBeadGridSampleKernel::SampleBead(long thread, const CAbstractBead* const pBead)
+{
+	const long ix = static_cast<long>(pBead->GetXPos()/m_GridXCellWidth);
+	const long iy = static_cast<long>(pBead->GetYPos()/m_GridYCellWidth);
+
+#if SimDimension == 2
+	const long iz = 0;	
+#elif SimDimension == 3
+	const long iz = static_cast<long>(pBead->GetZPos()/m_GridZCellWidth);	
+#endif
+
+	m_vvCounts[thread].at(pBead->GetType()*m_GridCellTotal + m_GridXCellNo*(m_GridYCellNo*iz+iy) + ix) += 1.0;
+}
+
+// Function to add the counts of all threads to those of thread 0. As the 
+// counts are integers, the totals do not depend on the number of threads.
+
+void CBeadGridSampleKernel::EndSample()
+{
+	zDoubleVector& rvTotals = m_vvCounts[0];
+
+	for(long thread=1; thread<static_cast<long>(m_vvCounts.size()); thread++)
+	{
+		const zDoubleVector& rvCounts = m_vvCounts[thread];
+
+		for(long i=0; i<static_cast<long>(rvTotals.size()); i++)
+		{
+			rvTotals[i] += rvCounts[i];
+		}
+	}
+}
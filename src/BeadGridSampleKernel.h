@@ -0,0 +1,63 @@
+// BeadGridSampleKernel.h: interface for the CBeadGridSampleKernel class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_BEADGRIDSAMPLEKERNEL_H__C81E4D6A_2F93_4B15_A7D8_5E09B3F14C62__INCLUDED_)
+#define AFX_BEADGRIDSAMPLEKERNEL_H__C81E4D6A_2F93_4B15_A7D8_5E09B3F14C62__INCLUDED_
+
+
+#include "ISampleKernel.h"
+#include "xxBase.h"
+
+// Sample kernel that counts the number of beads of each type in the cells
+// of the CMonitor's analysis grid. The counts for type t are stored in the
+// block [t*GetGridCellTotal(), (t+1)*GetGridCellTotal()) of the vector
+// returned by GetCounts(), ordered in the same way as the CGridObservable
+// density fields.
+
+class CBeadGridSampleKernel : public ISampleKernel
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CBeadGridSampleKernel(long xCellNo, long yCellNo, long zCellNo,
+						  double xCellWidth, double yCellWidth, double zCellWidth);
+
+	virtual ~CBeadGridSampleKernel();
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual void StartSample(long threadTotal);
+	virtual void SampleBead(long thread, const CAbstractBead* const pBead);
+	virtual void EndSample();
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void SetBeadTypeTotal(long typeTotal);
+
+	inline long GetGridCellTotal() const {return m_GridCellTotal;}
+
+	inline const zDoubleVector& GetCounts() const {return m_vvCounts.at(0);}
+
+	// ****************************************
+	// Data members
+private:
+
+	const long   m_GridXCellNo;
+	const long   m_GridYCellNo;
+	const long   m_GridCellTotal;
+	const double m_GridXCellWidth;
+	const double m_GridYCellWidth;
+	const double m_GridZCellWidth;
+
+	long m_TypeTotal;						// Number of bead types
+
+	std::vector<zDoubleVector> m_vvCounts;	// Bead counts for each thread
+};
+
+#endif // !defined(AFX_BEADGRIDSAMPLEKERNEL_H__C81E4D6A_2F93_4B15_A7D8_5E09B3F14C62__INCLUDED_)
@@ -0,0 +1,373 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// BeadPairHistogram.cpp: implementation of the CBeadPairHistogram class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "BeadPairHistogram.h"
+#include "ISimBox.h"
+#include "Bead.h"
+
+#include <thread>
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CBeadPairHistogram::CBeadPairHistogram(long binTotal, double rMax) : m_BinTotal(binTotal), m_RMax(rMax),
+											m_dr(binTotal > 0 ? rMax/static_cast<double>(binTotal) : 0.0)
+{
+	for(short int i=0; i<3; i++)
+	{
+		m_Length[i]		= 0.0;
+		m_HalfLength[i]	= 0.0;
+		m_CellNo[i]		= 0;
+	}
+}
+
+CBeadPairHistogram::~CBeadPairHistogram()
+{
+
+}
+
+// Function to add the separations of all pairs of beads in the set to the
+// histogram, and return the number of pairs added. Each pair within the
+// maximum distance is added twice, once for each bead. The beads are 
+// sorted into cells first, and the cells are then divided between the
+// threads, taking every threadTotal'th cell so that the work is spread 
+// evenly across the SimBox.
+
+long CBeadPairHistogram::AddPairs(const BeadVector& rvBeads, const ISimBox* const pISimBox, long threadTotal, zDoubleVector& rvHistogram)
+{
+	if(m_BinTotal < 1 || rvBeads.size() < 2)
+		return 0;
+
+	MakeCells(pISimBox);
+	SortBeads(rvBeads);
+
+	const long cellTotal = m_vCellStart.size() - 1;
+
+	threadTotal = std::max(1L, std::min(threadTotal, cellTotal));
+
+	m_vThreadBins.resize(threadTotal);
+	m_vThreadPairs.assign(threadTotal, 0);
+
+	for(long thread=0; thread<threadTotal; thread++)
+	{
+		m_vThreadBins[thread].assign(m_BinTotal, 0);
+	}
+
+	if(threadTotal == 1)
+	{
+		CountPairs(0, 1);
+	}
+	else
+	{
+		std::vector<std::thread> vThreads;
+
+		for(long thread=1; thread<threadTotal; thread++)
+		{
+			vThreads.push_back(std::thread(&CBeadPairHistogram::CountPairs, this, thread, threadTotal));
+		}
+
+		CountPairs(0, threadTotal);
+
+		for(std::vector<std::thread>::iterator iterThread=vThreads.begin(); iterThread!=vThreads.end(); iterThread++)
+		{
+			iterThread->join();
+		}
+	}
+
+	long pairTotal = 0;
+
+	for(long thread=0; thread<threadTotal; thread++)
+	{
+		pairTotal += m_vThreadPairs[thread];
+
+		for(long ir=0; ir<m_BinTotal; ir++)
+		{
+			rvHistogram.at(ir) += m_vThreadBins[thread][ir];
+		}
+	}
+
+	return pairTotal;
+}
+
+// Function to integrate a histogram of pair separations, weighted by 
+// sin(qr)/qr, over all space using the trapezoidal rule to obtain the 
+// scattering function I(q). The shell width dr is the integration step.
+// The result is evaluated at rvIQ.size() values of q starting at qMin and
+// separated by dq. Note that dividing the integration range into N steps 
+// requires N+1 values of the histogram as we integrate from 0 to N*dr 
+// inclusively.
+//
+// The values of sin(qr)/qr are obtained incrementally from the recurrences
+// for sin(qr) and cos(qr) so that only one sine and cosine are evaluated
+// for each value of q.
+
+void CBeadPairHistogram::SineTransform(const zDoubleVector& rvRDF, double dr, double qMin, double dq, zDoubleVector& rvIQ)
+{
+	const long N = rvRDF.size() - 1;	// No of steps in integral
+
+	double qvalue = qMin;
+
+	for(long iq=0; iq<static_cast<long>(rvIQ.size()); iq++)
+	{
+		const double sinStep = sin(qvalue*dr);
+		const double cosStep = cos(qvalue*dr);
+
+		double sinqr = sinStep;		// sin(q*r) at r = dr
+		double cosqr = cosStep;
+		double rvalue = dr;
+
+		double integrand = 0.0;
+
+		for(long ir=1; ir<N; ir++)
+		{
+			integrand += rvRDF[ir]*sinqr/(qvalue*rvalue);
+
+			const double sinNext = sinqr*cosStep + cosqr*sinStep;
+			cosqr  = cosqr*cosStep - sinqr*sinStep;
+			sinqr  = sinNext;
+			rvalue += dr;
+		}
+
+		// Now add in the end points, noting that sin(0)/0 = 1.
+
+		integrand += 0.5*(rvRDF[0] + rvRDF[N]*sinqr/(qvalue*rvalue));
+
+		rvIQ[iq] = integrand*dr*xxBase::m_globalFourPI;
+
+		qvalue += dq;
+	}
+}
+
+// Private function to set up the grid of cells for the current SimBox size. 
+// The cells' neighbour lists are only rebuilt if the size has changed. Each 
+// cell stores only those neighbours with a higher index, so that every pair 
+// of neighbouring cells is visited once. When there are fewer than three 
+// cells in a direction, several neighbour offsets wrap round to the same 
+// cell, so duplicates are removed.
+
+void CBeadPairHistogram::MakeCells(const ISimBox* const pISimBox)
+{
+	double length[3];
+
+	length[0] = pISimBox->GetSimBoxXLength();
+	length[1] = pISimBox->GetSimBoxYLength();
+
+#if SimDimension == 3
+	length[2] = pISimBox->GetSimBoxZLength();
+#else
+	length[2] = 0.0;
+#endif
+
+	if(!m_vCellStart.empty() && length[0] == m_Length[0] && length[1] == m_Length[1] && length[2] == m_Length[2])
+		return;
+
+	for(short int i=0; i<3; i++)
+	{
+		m_Length[i]		= length[i];
+		m_HalfLength[i]	= 0.5*length[i];
+		m_CellNo[i]		= (m_RMax > 0.0) ? static_cast<long>(length[i]/m_RMax) : 1;
+
+		if(m_CellNo[i] < 3)
+		{
+			m_CellNo[i] = 1;
+		}
+	}
+
+	const long cellTotal = m_CellNo[0]*m_CellNo[1]*m_CellNo[2];
+
+	m_vCellStart.assign(cellTotal+1, 0);
+	m_vNNStart.assign(cellTotal+1, 0);
+	m_vNNCells.clear();
+
+	long cell = 0;
+
+	for(long iz=0; iz<m_CellNo[2]; iz++)
+	{
+		for(long iy=0; iy<m_CellNo[1]; iy++)
+		{
+			for(long ix=0; ix<m_CellNo[0]; ix++)
+			{
+				m_vNNStart[cell] = m_vNNCells.size();
+
+				for(long dz=-1; dz<=1; dz++)
+				{
+					for(long dy=-1; dy<=1; dy++)
+					{
+						for(long dx=-1; dx<=1; dx++)
+						{
+							const long jx = (ix + dx + m_CellNo[0])%m_CellNo[0];
+							const long jy = (iy + dy + m_CellNo[1])%m_CellNo[1];
+							const long jz = (iz + dz + m_CellNo[2])%m_CellNo[2];
+
+							const long neighbour = m_CellNo[0]*(m_CellNo[1]*jz + jy) + jx;
+
+							if(neighbour > cell && std::find(m_vNNCells.begin() + m_vNNStart[cell], m_vNNCells.end(), neighbour) == m_vNNCells.end())
+							{
+								m_vNNCells.push_back(neighbour);
+							}
+						}
+					}
+				}
+
+				cell++;
+			}
+		}
+	}
+
+	m_vNNStart[cellTotal] = m_vNNCells.size();
+}
+
+// Private function to copy the bead positions into contiguous arrays sorted
+// by cell using a counting sort.
+
+void CBeadPairHistogram::SortBeads(const BeadVector& rvBeads)
+{
+	const long beadTotal = rvBeads.size();
+	const long cellTotal = m_vCellStart.size() - 1;
+
+	double cellWidth[3];
+
+	for(short int i=0; i<3; i++)
+	{
+		cellWidth[i] = (m_Length[i] > 0.0) ? m_Length[i]/static_cast<double>(m_CellNo[i]) : 1.0;
+	}
+
+	zLongVector vBeadCell(beadTotal);
+
+	m_vCellStart.assign(cellTotal+1, 0);
+
+	for(long bead=0; bead<beadTotal; bead++)
+	{
+		const CBead* const pBead = rvBeads[bead];
+
+		const long ix = std::min(m_CellNo[0]-1, std::max(0L, static_cast<long>(pBead->GetXPos()/cellWidth[0])));
+		const long iy = std::min(m_CellNo[1]-1, std::max(0L, static_cast<long>(pBead->GetYPos()/cellWidth[1])));
+#if SimDimension == 3
+		const long iz = std::min(m_CellNo[2]-1, std::max(0L, static_cast<long>(pBead->GetZPos()/cellWidth[2])));
+#else
+		const long iz = 0;
+#endif
+
+		vBeadCell[bead] = m_CellNo[0]*(m_CellNo[1]*iz + iy) + ix;
+		m_vCellStart[vBeadCell[bead]+1]++;
+	}
+
+	for(long cell=0; cell<cellTotal; cell++)
+	{
+		m_vCellStart[cell+1] += m_vCellStart[cell];
+	}
+
+	zLongVector vNextSlot;
+	vNextSlot.insert(vNextSlot.end(), m_vCellStart.begin(), m_vCellStart.end() - 1);
+
+	m_vXPos.resize(beadTotal);
+	m_vYPos.resize(beadTotal);
+	m_vZPos.resize(beadTotal);
+
+	for(long bead=0; bead<beadTotal; bead++)
+	{
+		const long slot = vNextSlot[vBeadCell[bead]]++;
+
+		m_vXPos[slot] = rvBeads[bead]->GetXPos();
+		m_vYPos[slot] = rvBeads[bead]->GetYPos();
+#if SimDimension == 3
+		m_vZPos[slot] = rvBeads[bead]->GetZPos();
+#else
+		m_vZPos[slot] = 0.0;
+#endif
+	}
+}
+
+// Private function to bin the pairs of beads in every threadTotal'th cell, 
+// starting at cell thread, into the thread's own histogram. Pairs within a
+// cell are visited once, as are pairs in a cell and its higher-indexed 
+// neighbours.
+
+void CBeadPairHistogram::CountPairs(long thread, long threadTotal)
+{
+	zLongVector& rvBins = m_vThreadBins[thread];
+	long&        rPairs = m_vThreadPairs[thread];
+
+	const long cellTotal = m_vCellStart.size() - 1;
+
+	for(long cell=thread; cell<cellTotal; cell+=threadTotal)
+	{
+		const long begin = m_vCellStart[cell];
+		const long end   = m_vCellStart[cell+1];
+
+		for(long i=begin; i<end; i++)
+		{
+			for(long j=i+1; j<end; j++)
+			{
+				AddPair(i, j, rvBins, rPairs);
+			}
+
+			for(long nn=m_vNNStart[cell]; nn<m_vNNStart[cell+1]; nn++)
+			{
+				const long neighbour = m_vNNCells[nn];
+
+				for(long j=m_vCellStart[neighbour]; j<m_vCellStart[neighbour+1]; j++)
+				{
+					AddPair(i, j, rvBins, rPairs);
+				}
+			}
+		}
+	}
+}
+
+// Private function to add a pair of beads to a histogram if their separation
+// lies within the maximum distance. A separation that lies exactly on the 
+// boundary between two shells is assigned to the inner shell, and coincident 
+// beads are ignored, as in the original shell-by-shell loop.
+
+inline void CBeadPairHistogram::AddPair(long i, long j, zLongVector& rvBins, long& rPairs) const
+{
+	double dx[3];
+
+	dx[0] = m_vXPos[i] - m_vXPos[j];
+	dx[1] = m_vYPos[i] - m_vYPos[j];
+	dx[2] = m_vZPos[i] - m_vZPos[j];
+
+	// Correct for the PBCs
+
+	for(short int k=0; k<3; k++)
+	{
+		if( dx[k] > m_HalfLength[k] )
+			dx[k] -= m_Length[k];
+		else if( dx[k] < -m_HalfLength[k] )
+			dx[k] += m_Length[k];
+	}
+
+	const double dr = sqrt(dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2]);
+
+	if(dr > 0.0 && dr <= m_RMax)
+	{
+		long ir = static_cast<long>(dr/m_dr);
+
+		if(ir > 0 && ir*m_dr >= dr)
+			ir--;
+
+		if(ir < m_BinTotal)
+		{
+			rvBins[ir] += 2;
+			rPairs     += 2;
+		}
+	}
+}
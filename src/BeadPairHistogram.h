@@ -0,0 +1,89 @@
+// BeadPairHistogram.h: interface for the CBeadPairHistogram class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_BEADPAIRHISTOGRAM_H__4C81E2A7_5B3F_4D96_A0C8_37E9F2D6B154__INCLUDED_)
+#define AFX_BEADPAIRHISTOGRAM_H__4C81E2A7_5B3F_4D96_A0C8_37E9F2D6B154__INCLUDED_
+
+
+// Forward declarations
+
+class ISimBox;
+
+
+#include "xxBase.h"
+
+// Histogram of the separations of all pairs of beads in a set, used by the
+// RDF and pair-correlation processes. Each sample copies the bead positions
+// into a grid of cells whose width is at least the maximum distance of the
+// histogram, so that only beads in the same or neighbouring cells are
+// compared, and each pair within range is binned directly into its shell
+// instead of being tested against every shell in turn. Pairs are counted
+// in both orders, as the processes did originally, so that the counts and
+// normalisations are unchanged.
+//
+// The cells are shared between threads, each of which accumulates its own
+// histogram; these are summed when all threads have finished. If the SimBox
+// is too small for three cells of the required width in a direction, the
+// grid has a single cell in that direction.
+
+class CBeadPairHistogram
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CBeadPairHistogram(long binTotal, double rMax);
+
+	~CBeadPairHistogram();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static void SineTransform(const zDoubleVector& rvRDF, double dr, double qMin, double dq, zDoubleVector& rvIQ);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long   GetBinTotal() const {return m_BinTotal;}
+	inline double GetBinWidth() const {return m_dr;}
+	inline double GetRMax()     const {return m_RMax;}
+
+	long AddPairs(const BeadVector& rvBeads, const ISimBox* const pISimBox, long threadTotal, zDoubleVector& rvHistogram);
+
+	// ****************************************
+	// Private functions
+private:
+
+	void MakeCells(const ISimBox* const pISimBox);
+	void SortBeads(const BeadVector& rvBeads);
+	void CountPairs(long thread, long threadTotal);
+	void AddPair(long i, long j, zLongVector& rvBins, long& rPairs) const;
+
+	// ****************************************
+	// Data members
+private:
+
+	const long   m_BinTotal;		// Number of shells in the histogram
+	const double m_RMax;			// Maximum separation binned
+	const double m_dr;				// Width of each shell
+
+	double m_Length[3];				// SimBox side lengths
+	double m_HalfLength[3];
+	long   m_CellNo[3];				// Number of cells in each direction
+
+	zLongVector m_vNNStart;			// Index of first neighbour of each cell, plus one past the end
+	zLongVector m_vNNCells;			// Neighbours of each cell with a higher index
+
+	zLongVector   m_vCellStart;		// Index of first bead in each cell, plus one past the end
+	zDoubleVector m_vXPos;			// Bead positions sorted by cell
+	zDoubleVector m_vYPos;
+	zDoubleVector m_vZPos;
+
+	std::vector<zLongVector> m_vThreadBins;	// Histogram counted by each thread
+	zLongVector              m_vThreadPairs;	// Number of pairs binned by each thread
+};
+
+#endif // !defined(AFX_BEADPAIRHISTOGRAM_H__4C81E2A7_5B3F_4D96_A0C8_37E9F2D6B154__INCLUDED_)
@@ -0,0 +1,128 @@
+// BeadRange.h: interface for the CBeadRange class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_BEADRANGE_H__4E7A2C95_B1D3_4F86_9A0C_6D25E83F71B4__INCLUDED_)
+#define AFX_BEADRANGE_H__4E7A2C95_B1D3_4F86_9A0C_6D25E83F71B4__INCLUDED_
+
+
+#include "CNTCell.h"
+
+// Read-only view of all the beads held in a set of CNT cells. It iterates
+// over each cell's bead list in place, so that analysis code can visit every
+// bead in the SimBox without building a temporary AbstractBeadVector. The
+// beads are visited in the same order as the vector returned by 
+// CSimBox::GetAllBeadsInCNTCells().
+//
+// The range is only valid while no bead moves between cells, i.e., it must
+// not be kept across time steps or used while beads are added or removed.
+// The beads themselves may be modified through the iterator.
+//
+// Usage:
+//
+//	const CBeadRange vAllBeads = GetSimBoxBeadRange();
+//	for(CBeadRange::const_iterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
+//	{
+//		(*iterBead)->GetType();
+//	}
+
+class CBeadRange
+{
+public:
+
+	// ****************************************
+	// Iterator that steps through the beads of each cell in turn, skipping
+	// empty cells. The end iterator points to the end of the cell vector.
+
+	class const_iterator
+	{
+		friend class CBeadRange;
+
+	public:
+
+		inline CAbstractBead* operator*() const {return *m_iterBead;}
+
+		inline const_iterator& operator++()
+		{
+			if(++m_iterBead == (*m_iterCell)->GetBeadList().end())
+			{
+				++m_iterCell;
+				SkipEmptyCells();
+			}
+			return *this;
+		}
+
+		inline const_iterator operator++(int)
+		{
+			const_iterator old(*this);
+			++(*this);
+			return old;
+		}
+
+		inline bool operator==(const const_iterator& rhs) const
+		{
+			return m_iterCell == rhs.m_iterCell && (m_iterCell == m_endCell || m_iterBead == rhs.m_iterBead);
+		}
+
+		inline bool operator!=(const const_iterator& rhs) const {return !(*this == rhs);}
+
+	private:
+
+		const_iterator(cCNTCellIterator iterCell, cCNTCellIterator endCell) : m_iterCell(iterCell), m_endCell(endCell)
+		{
+			SkipEmptyCells();
+		}
+
+		inline void SkipEmptyCells()
+		{
+			while(m_iterCell != m_endCell && (*m_iterCell)->GetBeadList().empty())
+			{
+				++m_iterCell;
+			}
+
+			if(m_iterCell != m_endCell)
+			{
+				m_iterBead = (*m_iterCell)->GetBeadList().begin();
+			}
+		}
+
+		cCNTCellIterator  m_iterCell;
+		cCNTCellIterator  m_endCell;
+		cBeadListIterator m_iterBead;
+	};
+
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CBeadRange(const CNTCellVector& rvCells) : m_rvCells(rvCells)
+	{
+	}
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline const_iterator begin() const {return const_iterator(m_rvCells.begin(), m_rvCells.end());}
+	inline const_iterator end()   const {return const_iterator(m_rvCells.end(),   m_rvCells.end());}
+
+	long size() const
+	{
+		long total = 0;
+
+		for(cCNTCellIterator iterCell=m_rvCells.begin(); iterCell!=m_rvCells.end(); iterCell++)
+		{
+			total += (*iterCell)->GetBeadList().size();
+		}
+
+		return total;
+	}
+
+	// ****************************************
+	// Data members
+private:
+
+	const CNTCellVector& m_rvCells;		// CNT cells owned by the CSimBox
+};
+
+#endif // !defined(AFX_BEADRANGE_H__4E7A2C95_B1D3_4F86_9A0C_6D25E83F71B4__INCLUDED_)
@@ -40,7 +40,7 @@ bool operator==(const CBeadType& a, const CBeadType& b)
 // Static member definitions
 //////////////////////////////////////////////////////////////////////
 
-long CBeadType::m_BeadTypeTotal = 0;	// No of bead types created so far
+thread_local long CBeadType::m_BeadTypeTotal = 0;	// No of bead types created so far
 
 long CBeadType::GetTotal()
 {
@@ -101,11 +101,7 @@ CBeadType* CBeadType::AddDPDBeadType(zString name, double radius, zDoubleVector
 {
 	m_BeadTypeTotal++;	// count types starting at 1 but access vector from 0
 
-#ifndef UseDPDBeadRadii
-	CDPDBeadStructure* pStructure = new CDPDBeadStructure(consInt, dissInt);
-#else
 	CDPDBeadStructure* pStructure = new CDPDBeadStructure(radius, consInt, dissInt);
-#endif
 
 	return new CBeadType(name, pStructure);
 }
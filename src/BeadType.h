@@ -50,7 +50,7 @@ public:
 
 private:
 
-	static long m_BeadTypeTotal;
+	static thread_local long m_BeadTypeTotal;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -1352,6 +1352,14 @@ void CBilayer::ConvertNames(const CAnalysisState &raState)
 	m_SolventHeadType	= raState.GetPolymerHeadType(m_SolventType);
 }
 
+// The surface tension is calculated from the stress tensor profile each time 
+// the aggregate is sampled.
+
+bool CBilayer::IsStressProfileUsed() const
+{
+	return true;
+}
+
 
 // **********************************************************************
 // Function to calculate the thickness of the bilayer as a 1d function
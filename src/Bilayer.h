@@ -93,6 +93,10 @@ public:
 
 	virtual void ConvertNames(const CAnalysisState& raState);
 
+	// Function showing that the bilayer analysis needs the stress profile
+
+	virtual bool IsStressProfileUsed() const;
+
 private:
 
 	void Thickness(CCellProfileSet* const pCPS);
@@ -0,0 +1,591 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// BinaryRestartState.cpp: implementation of the CBinaryRestartState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "BinaryRestartState.h"
+#include "ISimBox.h"
+#include "InitialState.h"
+#include "Polymer.h"
+#include "Bead.h"
+#include "CommandTargetNode.h"
+
+#include "LogRestartStateBuilderError.h"  
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define UseMappedRestartFile
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// The header, checksum and read-only file mapping are only needed in this 
+// file, so we hide them in an anonymous namespace.
+
+namespace
+{
+	const char     BinaryRestartId[8] = {'D', 'P', 'D', 'B', 'R', 'S', 'T', '\0'};
+	const uint32_t BinaryRestartByteOrder = 0x01020304;
+
+	const long BinaryRestartIntArrayTotal    = 4;	// Polymer id and type, bead id and type
+	const long BinaryRestartDoubleArrayTotal = 13;	// Radius and four 3-vectors
+
+	struct BinaryRestartHeader
+	{
+		char     id[8];
+		uint32_t byteOrder;
+		uint32_t version;
+		uint64_t headerSize;
+		int64_t  time;
+		uint32_t wall;
+		uint32_t gravity;
+		uint32_t shear;
+		uint32_t reserved;
+		uint64_t beadTotal;
+		uint64_t inclusiveSize;
+		uint64_t checksum;
+	};
+
+	// 64-bit FNV-1a hash used as the checksum. It is updated incrementally 
+	// as each array is written.
+
+	const uint64_t ChecksumSeed = 14695981039346656037ULL;
+
+	uint64_t AddToChecksum(uint64_t checksum, const void* const pData, uint64_t size)
+	{
+		const unsigned char* const pBytes = static_cast<const unsigned char*>(pData);
+
+		for(uint64_t i=0; i<size; i++)
+		{
+			checksum ^= pBytes[i];
+			checksum *= 1099511628211ULL;
+		}
+
+		return checksum;
+	}
+
+	// Read-only view of a whole file. The file is mapped into memory if the 
+	// platform supports it, otherwise it is read into a buffer.
+
+	class BinaryRestartFile
+	{
+	public:
+
+		BinaryRestartFile(const zString fileName) : m_pData(0), m_Size(0), m_pMap(0)
+		{
+#if defined(UseMappedRestartFile)
+			const int fd = open(fileName.c_str(), O_RDONLY);
+
+			if(fd >= 0)
+			{
+				struct stat fileStat;
+
+				if(fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+				{
+					void* const pMap = mmap(0, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+					if(pMap != MAP_FAILED)
+					{
+						m_pMap  = pMap;
+						m_pData = static_cast<const char*>(pMap);
+						m_Size  = fileStat.st_size;
+					}
+				}
+
+				close(fd);
+			}
+#else
+			zInFileStream is(fileName.c_str(), zIos::in | zIos::binary);
+
+			if(is.good())
+			{
+				is.seekg(0, zIos::end);
+				m_Buffer.resize(static_cast<long>(is.tellg()));
+				is.seekg(0, zIos::beg);
+
+				if(!m_Buffer.empty() && is.read(&m_Buffer[0], m_Buffer.size()))
+				{
+					m_pData = &m_Buffer[0];
+					m_Size  = m_Buffer.size();
+				}
+			}
+#endif
+		}
+
+		~BinaryRestartFile()
+		{
+#if defined(UseMappedRestartFile)
+			if(m_pMap)
+			{
+				munmap(m_pMap, m_Size);
+			}
+#endif
+		}
+
+		const char* GetData() const {return m_pData;}
+		uint64_t    GetSize() const {return m_Size;}
+
+	private:
+
+		const char* m_pData;
+		uint64_t    m_Size;
+		void*       m_pMap;
+		std::vector<char> m_Buffer;
+	};
+}
+
+// Static member variable holding the version of the file layout. It must be
+// incremented whenever the layout changes.
+
+const long CBinaryRestartState::m_Version = 1;
+
+// Static function to return the name of a restart state file: this is the
+// same for the text and binary formats.
+
+const zString CBinaryRestartState::GetRestartFileName(long currentTime, const zString runId)
+{
+	zOutStringStream ssTime;
+
+	ssTime << currentTime;
+
+	return xxBase::GetRSPrefix() + runId + ".con." + ssTime.str() + ".dat";
+}
+
+// Static function showing whether a restart state file is in the binary format.
+// We only check the identifier at the start of the file: the remainder of the
+// header is validated when the file is read.
+
+bool CBinaryRestartState::IsBinaryRestartState(long currentTime, const zString runId)
+{
+	zInFileStream is(GetRestartFileName(currentTime, runId).c_str(), zIos::in | zIos::binary);
+
+	char id[8];
+
+	return is.read(id, 8) && memcmp(id, BinaryRestartId, 8) == 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Constructor that is used when reading a restart state from a file. As for
+// the CInclusiveRestartState, it only has access to the initial state, which
+// must store all the data required to define the restarted run.
+
+CBinaryRestartState::CBinaryRestartState(long currentTime, zString runId, CInitialState& riState) : xxState(GetRestartFileName(currentTime, runId), false, currentTime, runId),
+                                               m_pISimBox(0),
+                                               m_riState(riState)
+{
+
+}
+
+// Constructor that is used when writing a new restart state to a file.
+
+CBinaryRestartState::CBinaryRestartState(long currentTime, zString runId, 
+                                         const ISimBox* const pISimBox, 
+                                         CInitialState& riState) : xxState(GetRestartFileName(currentTime, runId), true, currentTime, runId),
+                                               m_pISimBox(pISimBox),
+                                               m_riState(riState)
+{
+
+}
+
+CBinaryRestartState::~CBinaryRestartState()
+{
+
+}
+
+// Function to read/write the restart state. If an error occurs the function
+// returns false so that the run can be aborted.
+
+bool CBinaryRestartState::Serialize()
+{
+	CollectBeads();
+
+	if(IsFileWritable())
+	{
+		return Write();
+	}
+	else
+	{
+		return Read();
+	}
+}
+
+// Private function to store the beads in the order in which they are written
+// to the file. The initial position of the beads in wall polymers, apart from 
+// their heads, is set to their PBC position when they are read in, as in the 
+// CRestartState.
+
+void CBinaryRestartState::CollectBeads()
+{
+	m_vBeads.clear();
+	m_vPolymers.clear();
+	m_vInitialUnPBC.clear();
+
+	for(cPolymerVectorIterator iterPoly=m_riState.GetPolymers().begin(); iterPoly!=m_riState.GetPolymers().end(); iterPoly++ )
+	{
+		for(cBeadVectorIterator iterBead=(*iterPoly)->GetBeads().begin(); iterBead!=(*iterPoly)->GetBeads().end(); iterBead++)
+		{
+			m_vBeads.push_back(*iterBead);
+			m_vPolymers.push_back(*iterPoly);
+			m_vInitialUnPBC.push_back(true);
+		}
+	}
+
+	if(m_riState.IsWallPresent())
+	{
+		for(cPolymerVectorIterator iterWallPoly=m_riState.GetWallPolymers().begin(); iterWallPoly!=m_riState.GetWallPolymers().end(); iterWallPoly++ )
+		{
+			m_vBeads.push_back((*iterWallPoly)->GetHead());
+			m_vPolymers.push_back(*iterWallPoly);
+			m_vInitialUnPBC.push_back(true);
+
+			for(cBeadVectorIterator iterBead=(*iterWallPoly)->GetBeads().begin(); iterBead!=(*iterWallPoly)->GetBeads().end(); iterBead++)
+			{
+				m_vBeads.push_back(*iterBead);
+				m_vPolymers.push_back(*iterWallPoly);
+				m_vInitialUnPBC.push_back(false);
+			}
+		}
+	}
+}
+
+// Private function to write the restart state. The text restart state moves 
+// beads that are very close to the SimBox boundaries to avoid them being read
+// back as lying on a boundary after rounding. This is not necessary here, as 
+// the coordinates are stored exactly, so the beads are only checked to lie
+// within the SimBox. The header is written twice: once to reserve its space,
+// and again when the checksum is known.
+
+bool CBinaryRestartState::Write()
+{
+	if(!IsFileStateOk())
+		return false;
+
+	const long beadTotal = m_vBeads.size();
+
+	const double lx = m_riState.GetSimBoxXLength();
+	const double ly = m_riState.GetSimBoxYLength();
+	const double lz = m_riState.GetSimBoxZLength();
+
+	for(long i=0; i<beadTotal; i++)
+	{
+		const CAbstractBead* const pBead = m_vBeads[i];
+
+		if(pBead->GetXPos() < 0.0 || pBead->GetXPos() > lx ||
+		   pBead->GetYPos() < 0.0 || pBead->GetYPos() > ly ||
+		   pBead->GetZPos() < 0.0 || pBead->GetZPos() > lz)
+		{
+			new CLogRestartStateBuilderError(m_CurrentTime, "Bead "+ ToString(pBead->GetId()) + " (type " + ToString(pBead->GetType()) + ") outside box");
+			return ErrorTrace("Bead coordinate error writing restart state");
+		}
+	}
+
+	// Collect the inclusive data in memory so that its size is known
+
+	zOutStringStream osInclusive;
+
+	m_riState.Write(osInclusive);
+
+	CommandTargetSequence targets = m_pISimBox->GetSimBox()->GetCommandTargets();
+
+	osInclusive << m_pISimBox->GetSimBox()->GetCommandTargetNodeTotal();
+
+	for(cCommandTargetIterator iterTarget=targets.begin(); iterTarget!=targets.end(); iterTarget++)
+	{
+		(*iterTarget)->Write(osInclusive);
+	}
+
+	osInclusive << zEndl;
+
+	if(!m_riState.IsRestartStateValid())
+	{
+		new CLogRestartStateBuilderError(m_CurrentTime, "Unable to write inclusive data to binary restart state");
+		return false;
+	}
+
+	const zString inclusiveData = osInclusive.str();
+
+	// Reopen the file for binary output
+
+	m_outStream.close();
+	m_outStream.open(m_FileName.c_str(), zIos::out | zIos::binary | zIos::trunc);
+
+	BinaryRestartHeader header;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.id, BinaryRestartId, 8);
+
+	header.byteOrder     = BinaryRestartByteOrder;
+	header.version       = m_Version;
+	header.headerSize    = sizeof(BinaryRestartHeader);
+	header.time          = m_CurrentTime;
+	header.wall          = m_riState.IsWallPresent();
+	header.gravity       = m_riState.IsGravityPresent();
+	header.shear         = m_riState.IsShearPresent();
+	header.beadTotal     = beadTotal;
+	header.inclusiveSize = inclusiveData.size();
+	header.checksum      = ChecksumSeed;
+
+	m_outStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// Integer arrays
+
+	std::vector<int64_t> vInt(beadTotal);
+
+	for(long array=0; array<BinaryRestartIntArrayTotal; array++)
+	{
+		for(long i=0; i<beadTotal; i++)
+		{
+			switch(array)
+			{
+			case 0: vInt[i] = m_vPolymers[i]->GetId();   break;
+			case 1: vInt[i] = m_vPolymers[i]->GetType(); break;
+			case 2: vInt[i] = m_vBeads[i]->GetId();      break;
+			case 3: vInt[i] = m_vBeads[i]->GetType();    break;
+			}
+		}
+
+		if(beadTotal > 0)
+		{
+			m_outStream.write(reinterpret_cast<const char*>(&vInt[0]), beadTotal*sizeof(int64_t));
+			header.checksum = AddToChecksum(header.checksum, &vInt[0], beadTotal*sizeof(int64_t));
+		}
+	}
+
+	// Double arrays
+
+	zDoubleVector vDouble(beadTotal);
+
+	for(long array=0; array<BinaryRestartDoubleArrayTotal; array++)
+	{
+		for(long i=0; i<beadTotal; i++)
+		{
+			const CAbstractBead* const pBead = m_vBeads[i];
+
+			switch(array)
+			{
+			case 0:  vDouble[i] = pBead->GetRadius();    break;
+			case 1:  vDouble[i] = pBead->GetXPos();      break;
+			case 2:  vDouble[i] = pBead->GetYPos();      break;
+			case 3:  vDouble[i] = pBead->GetZPos();      break;
+			case 4:  vDouble[i] = pBead->GetunPBCXPos(); break;
+			case 5:  vDouble[i] = pBead->GetunPBCYPos(); break;
+			case 6:  vDouble[i] = pBead->GetunPBCZPos(); break;
+			case 7:  vDouble[i] = pBead->GetXMom();      break;
+			case 8:  vDouble[i] = pBead->GetYMom();      break;
+			case 9:  vDouble[i] = pBead->GetZMom();      break;
+			case 10: vDouble[i] = pBead->GetXForce();    break;
+			case 11: vDouble[i] = pBead->GetYForce();    break;
+			case 12: vDouble[i] = pBead->GetZForce();    break;
+			}
+		}
+
+		if(beadTotal > 0)
+		{
+			m_outStream.write(reinterpret_cast<const char*>(&vDouble[0]), beadTotal*sizeof(double));
+			header.checksum = AddToChecksum(header.checksum, &vDouble[0], beadTotal*sizeof(double));
+		}
+	}
+
+	// Inclusive data
+
+	m_outStream.write(inclusiveData.data(), inclusiveData.size());
+	header.checksum = AddToChecksum(header.checksum, inclusiveData.data(), inclusiveData.size());
+
+	m_outStream.seekp(0, zIos::beg);
+	m_outStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	m_outStream.flush();
+
+	if(!m_outStream.good())
+	{
+		new CLogRestartStateBuilderError(m_CurrentTime, "Unable to write binary restart state");
+		return false;
+	}
+
+	return true;
+}
+
+// Private function to read the restart state. The header is checked against 
+// the current build and the initial state, and the checksum is verified, 
+// before any bead is modified. The polymer and bead ids must agree with 
+// those created from the new control data file, but the bead types may 
+// differ to allow command targets to have created new types, as in the 
+// CRestartState.
+
+bool CBinaryRestartState::Read()
+{
+	const BinaryRestartFile file(m_FileName);
+
+	const char* const pData = file.GetData();
+
+	if(!pData || file.GetSize() < sizeof(BinaryRestartHeader))
+	{
+		new CLogRestartStateBuilderError(0, "Unable to read binary restart state " + m_FileName);
+		return false;
+	}
+
+	BinaryRestartHeader header;
+
+	memcpy(&header, pData, sizeof(header));
+
+	if(memcmp(header.id, BinaryRestartId, 8) != 0 || header.byteOrder != BinaryRestartByteOrder)
+	{
+		new CLogRestartStateBuilderError(0, "Binary restart state has an invalid identifier or byte order");
+		return false;
+	}
+
+	if(header.version != static_cast<uint32_t>(m_Version) || header.headerSize != sizeof(BinaryRestartHeader))
+	{
+		new CLogRestartStateBuilderError(0, "Binary restart state version " + ToString(static_cast<long>(header.version)) + " is not supported");
+		return false;
+	}
+
+	const uint64_t beadTotal    = header.beadTotal;
+	const uint64_t arraysSize   = beadTotal*(BinaryRestartIntArrayTotal*sizeof(int64_t) + BinaryRestartDoubleArrayTotal*sizeof(double));
+
+	if(beadTotal != m_vBeads.size() || file.GetSize() != sizeof(BinaryRestartHeader) + arraysSize + header.inclusiveSize)
+	{
+		new CLogRestartStateBuilderError(0, "Binary restart state has the wrong number of beads or size");
+		return false;
+	}
+
+	if(AddToChecksum(ChecksumSeed, pData + sizeof(BinaryRestartHeader), arraysSize + header.inclusiveSize) != header.checksum)
+	{
+		new CLogRestartStateBuilderError(0, "Binary restart state checksum error (is restart file corrupt?)");
+		return false;
+	}
+
+	if(header.wall != static_cast<uint32_t>(m_riState.IsWallPresent()))
+	{
+		return ErrorTrace("Error reading Wall constraint");
+	}
+	else if(header.gravity != static_cast<uint32_t>(m_riState.IsGravityPresent()))
+	{
+		return ErrorTrace("Error reading Gravity constraint");
+	}
+	else if(header.shear != static_cast<uint32_t>(m_riState.IsShearPresent()))
+	{
+		return ErrorTrace("Error reading Shear constraint");
+	}
+
+	// The arrays start on 8-byte boundaries as the header size is a multiple of 8
+
+	const int64_t* const pInt    = reinterpret_cast<const int64_t*>(pData + sizeof(BinaryRestartHeader));
+	const double*  const pDouble = reinterpret_cast<const double*>(pInt + BinaryRestartIntArrayTotal*beadTotal);
+
+	const int64_t* const pPolyId   = pInt;
+	const int64_t* const pPolyType = pInt + beadTotal;
+	const int64_t* const pBeadId   = pInt + 2*beadTotal;
+	const int64_t* const pBeadType = pInt + 3*beadTotal;
+
+	const double lx = m_riState.GetSimBoxXLength();
+	const double ly = m_riState.GetSimBoxYLength();
+	const double lz = m_riState.GetSimBoxZLength();
+
+	for(uint64_t i=0; i<beadTotal; i++)
+	{
+		CAbstractBead* const pBead = m_vBeads[i];
+
+		if(pPolyId[i] != m_vPolymers[i]->GetId() || pPolyType[i] != m_vPolymers[i]->GetType() || pBeadId[i] != pBead->GetId())
+		{
+			TraceInt2("Polymer id", pPolyId[i], pBeadId[i]);
+			return ErrorTrace("Error reading restart state polymer/bead ids");
+		}
+
+		double value[BinaryRestartDoubleArrayTotal];
+
+		for(long array=0; array<BinaryRestartDoubleArrayTotal; array++)
+		{
+			value[array] = pDouble[array*beadTotal + i];
+		}
+
+		if(value[1] < 0.0 || value[1] > lx || value[2] < 0.0 || value[2] > ly || value[3] < 0.0 || value[3] > lz)
+		{
+			TraceInt2("Polymer coords", pPolyId[i], pBeadId[i]);
+			return ErrorTrace("Error reading bead coordinates");
+		}
+
+		pBead->SetType(pBeadType[i]);
+		pBead->SetRadius(value[0]);
+
+		pBead->SetXPos(value[1]);
+		pBead->SetYPos(value[2]);
+		pBead->SetZPos(value[3]);
+
+		if(m_vInitialUnPBC[i])
+		{
+			pBead->SetInitialXPos(value[4]);
+			pBead->SetInitialYPos(value[5]);
+			pBead->SetInitialZPos(value[6]);
+		}
+		else
+		{
+			pBead->SetInitialXPos(value[1]);
+			pBead->SetInitialYPos(value[2]);
+			pBead->SetInitialZPos(value[3]);
+		}
+
+		pBead->SetunPBCXPos(value[4]);
+		pBead->SetunPBCYPos(value[5]);
+		pBead->SetunPBCZPos(value[6]);
+
+		pBead->SetXMom(value[7]);
+		pBead->SetYMom(value[8]);
+		pBead->SetZMom(value[9]);
+
+		pBead->SetXForce(value[10]);
+		pBead->SetYForce(value[11]);
+		pBead->SetZForce(value[12]);
+	}
+
+	return ReadInclusiveData(pData + sizeof(BinaryRestartHeader) + arraysSize, header.inclusiveSize);
+}
+
+// Private function to pass the inclusive data to the initial state. The 
+// writer always stores them, so a binary restart state without them is 
+// invalid. Bead types larger than those defined in the control data file 
+// are created by the initial state from the bead type data they contain.
+
+bool CBinaryRestartState::ReadInclusiveData(const char* const pData, long size)
+{
+	if(size == 0)
+	{
+		new CLogRestartStateBuilderError(0, "Binary restart state has no inclusive data (is restart file corrupt?)");
+		return false;
+	}
+
+	zInStringStream isInclusive(zString(pData, size));
+
+	m_riState.Read(isInclusive);
+
+	if(!m_riState.IsRestartStateValid())
+	{
+		new CLogRestartStateBuilderError(0, "Unable to read inclusive data from binary restart state (has user modified unchangeable data?)");
+		return false;
+	}
+
+	return true;
+}
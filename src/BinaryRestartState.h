@@ -0,0 +1,120 @@
+// BinaryRestartState.h: interface for the CBinaryRestartState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_BINARYRESTARTSTATE_H__2F6B8D14_C3A9_4E70_B5D2_81E40A6F93C7__INCLUDED_)
+#define AFX_BINARYRESTARTSTATE_H__2F6B8D14_C3A9_4E70_B5D2_81E40A6F93C7__INCLUDED_
+
+
+// Forward declarations
+
+class ISimBox;
+class CInitialState;
+class CAbstractBead;
+class CPolymer;
+
+
+#include "xxState.h"
+
+// Binary alternative to the text restart state written by CInclusiveRestartState.
+// The file holds the same data in the same order, but the bead data are stored
+// as contiguous arrays of 64-bit integers and doubles, so that a restart state
+// is written and read without formatting or parsing every value, and the
+// coordinates, momenta and forces are restored exactly. The data that the
+// CInitialState and command targets write to an inclusive restart state,
+// such as new bead types, polymerised bonds and targets, are stored after 
+// the bead arrays in their usual text form. This is deliberate: they are
+// written and read by the stream functions of the CInitialState and of each 
+// command target class, which the text format also uses, and they are small
+// compared with the bead arrays. The polymers and bonds themselves are not 
+// stored, as they are recreated from the control data file in both formats.
+//
+// Unlike the text format there is no coordinates-only variant: the inclusive
+// data always holds at least the number of command targets, and a file
+// without it is rejected.
+//
+// The file has the same name as a text restart state, and the CRestartBuilder
+// distinguishes the two formats by the identifier at the start of the file.
+// Its layout is:
+//
+//	Header			identifier, byte order, version, time, constraint flags,
+//					number of beads, size of the inclusive data and checksum
+//	Integer arrays	polymer id, polymer type, bead id, bead type
+//	Double arrays	radius, position, unPBC position, momentum, force (X, Y, Z)
+//	Inclusive data	text written by CInitialState::Write() and the targets
+//
+// The beads are stored in the order of the text restart state: the beads of
+// the bulk polymers followed by those of the wall polymers, each wall
+// polymer's head bead first. The checksum covers everything after the header.
+// When reading, the file is mapped into memory where the platform allows it.
+
+class CBinaryRestartState : public xxState
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+    // Constructor for use when reading a restart state from file
+
+	CBinaryRestartState(long currentTime, zString runId, CInitialState& riState);
+
+    // Constructor for use when writing a restart state to file
+
+	CBinaryRestartState(long currentTime, zString runId, const ISimBox* const pISimBox, CInitialState& riState);
+
+	virtual ~CBinaryRestartState();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetRestartFileName(long currentTime, const zString runId);
+
+	static bool IsBinaryRestartState(long currentTime, const zString runId);
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+    bool Serialize();
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	void CollectBeads();
+	bool Write();
+	bool Read();
+	bool ReadInclusiveData(const char* const pData, long size);
+
+	// ****************************************
+	// Data members
+private:
+
+	static const long m_Version;		// Version of the file layout written by this class
+
+    const ISimBox* const m_pISimBox;
+    CInitialState&  m_riState;
+
+	// Beads in the order they are stored, with their polymers and a flag
+	// showing if the bead's initial position is its unPBC position (true)
+	// or its PBC position (false)
+
+	AbstractBeadVector m_vBeads;
+	PolymerVector      m_vPolymers;
+	zBoolVector        m_vInitialUnPBC;
+};
+
+#endif // !defined(AFX_BINARYRESTARTSTATE_H__2F6B8D14_C3A9_4E70_B5D2_81E40A6F93C7__INCLUDED_)
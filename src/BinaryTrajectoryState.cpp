@@ -0,0 +1,347 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// BinaryTrajectoryState.cpp: implementation of the CBinaryTrajectoryState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "BinaryTrajectoryState.h"
+#include "ISimBox.h"
+#include "BeadRange.h"
+#include "Bead.h"
+#include "CurrentState.h"
+
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// The file and frame headers are only needed in this file, so we hide them 
+// in an anonymous namespace.
+
+namespace
+{
+	const char     BinaryTrajectoryId[8] = {'D', 'P', 'D', 'B', 'T', 'R', 'J', '\0'};
+	const char     BinaryFrameId[8]      = {'F', 'R', 'A', 'M', 'E', '\0', '\0', '\0'};
+	const char     BinaryIndexId[8]      = {'I', 'N', 'D', 'E', 'X', '\0', '\0', '\0'};
+	const uint32_t BinaryTrajectoryByteOrder = 0x01020304;
+
+	struct BinaryTrajectoryHeader
+	{
+		char     id[8];
+		uint32_t byteOrder;
+		uint32_t version;
+		uint64_t headerSize;
+		double   simBoxLength[3];
+		uint64_t beadTypeTotal;
+		uint64_t frameTotal;
+		uint64_t indexOffset;
+	};
+
+	struct BinaryFrameHeader
+	{
+		char     id[8];
+		int64_t  time;
+		uint64_t beadTotal;
+		uint64_t beadTypeTotal;	// Number of bead types counted in this frame
+		uint64_t frameSize;		// Size of the frame including this header
+	};
+
+	template<typename T>
+	void WriteArray(zOutFileStream& os, const T* const pData, long size)
+	{
+		if(size > 0)
+		{
+			os.write(reinterpret_cast<const char*>(pData), size*sizeof(T));
+		}
+	}
+}
+
+// Static member variable holding the version of the file layout. It must be
+// incremented whenever the layout changes.
+
+const long CBinaryTrajectoryState::m_Version = 2;
+
+// Static function to return the name of the trajectory file for a run.
+
+const zString CBinaryTrajectoryState::GetTrajectoryFileName(const zString runId)
+{
+	return xxBase::GetCSPrefix() + runId + ".trj";
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// The file is reopened for binary output and the file header and bead type
+// names written immediately, so that frames can be appended as they are taken.
+
+CBinaryTrajectoryState::CBinaryTrajectoryState(const zString runId, const ISimBox* const pISimBox) : xxState(GetTrajectoryFileName(runId), true, 0, runId),
+													m_pISimBox(pISimBox),
+													m_HeaderBeadTypeTotal(pISimBox->GetBeadTypeTotal()),
+													m_BeadTypeTotal(pISimBox->GetBeadTypeTotal()),
+													m_bClosed(false)
+{
+	m_vFrameTime.clear();
+	m_vFrameOffset.clear();
+
+	m_vTypeCount.resize(m_BeadTypeTotal, 0);
+	m_vTypeStart.resize(m_BeadTypeTotal, 0);
+
+	if(IsFileStateOk())
+	{
+		m_outStream.close();
+		m_outStream.open(m_FileName.c_str(), zIos::out | zIos::binary | zIos::trunc);
+
+		WriteHeader(0, 0);
+
+		for(long type=0; type<m_BeadTypeTotal; type++)
+		{
+			const zString  name   = m_pISimBox->GetBeadNameFromType(type);
+			const uint32_t length = name.size();
+
+			m_outStream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+			m_outStream.write(name.data(), length);
+		}
+
+		m_outStream.flush();
+
+		if(!m_outStream.good())
+		{
+			IOError("Unable to write binary trajectory header to " + m_FileName);
+		}
+	}
+}
+
+// If the run ends without the CMonitor calling Serialize(), we still write
+// the frame index so that the file is complete.
+
+CBinaryTrajectoryState::~CBinaryTrajectoryState()
+{
+	if(!m_bClosed)
+	{
+		Serialize();
+	}
+}
+
+// Function to append the current bead coordinates to the file as a new frame.
+// The beads are selected as in CCurrentState::Serialize() and sorted into
+// groups by type with a counting sort before being written as contiguous arrays.
+
+bool CBinaryTrajectoryState::AddFrame(long currentTime, bool bRestrictCoords,
+									  double xmin, double ymin, double zmin,
+									  double xmax, double ymax, double zmax)
+{
+	if(m_bClosed || !m_outStream.good())
+		return false;
+
+	const double xMin = xmin*m_pISimBox->GetSimSpaceXLength();
+	const double yMin = ymin*m_pISimBox->GetSimSpaceYLength();
+	const double zMin = zmin*m_pISimBox->GetSimSpaceZLength();
+	const double xMax = xmax*m_pISimBox->GetSimSpaceXLength();
+	const double yMax = ymax*m_pISimBox->GetSimSpaceYLength();
+	const double zMax = zmax*m_pISimBox->GetSimSpaceZLength();
+
+	// The beads are visited in place in the CNT cells, as they do not move
+	// while the frame is written
+
+	const CBeadRange vAllBeads = m_pISimBox->GetBeadRange();
+
+	// Commands such as ctChangeBeadType add bead types during a run, so we
+	// extend the per-type arrays when the number of types grows. The names of 
+	// the new types are written with the frame index.
+
+	if(m_pISimBox->GetBeadTypeTotal() > m_BeadTypeTotal)
+	{
+		m_BeadTypeTotal = m_pISimBox->GetBeadTypeTotal();
+
+		m_vTypeCount.resize(m_BeadTypeTotal, 0);
+		m_vTypeStart.resize(m_BeadTypeTotal, 0);
+	}
+
+	// First pass: select the beads and count them by type
+
+	std::fill(m_vTypeCount.begin(), m_vTypeCount.end(), 0);
+
+	zBoolVector vSelected(vAllBeads.size(), false);
+	long beadTotal = 0;
+	long i = 0;
+
+	for(CBeadRange::const_iterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++, i++)
+	{
+		const CAbstractBead* const pBead = *iterBead;
+
+		const double x = pBead->GetXPos();
+		const double y = pBead->GetYPos();
+		const double z = pBead->GetZPos();
+
+		if(pBead->GetVisible() && 
+		   (!bRestrictCoords || (xMin < x && x < xMax &&
+								 yMin < y && y < yMax &&
+								 zMin < z && z < zMax)))
+		{
+			vSelected[i] = true;
+			m_vTypeCount[pBead->GetType()]++;
+			beadTotal++;
+		}
+	}
+
+	// Second pass: copy the selected beads into the arrays in type order
+
+	long start = 0;
+	for(long type=0; type<m_BeadTypeTotal; type++)
+	{
+		m_vTypeStart[type] = start;
+		start += m_vTypeCount[type];
+	}
+
+	m_vId.resize(beadTotal);
+	m_vDisplayId.resize(beadTotal);
+	m_vXPos.resize(beadTotal);
+	m_vYPos.resize(beadTotal);
+	m_vZPos.resize(beadTotal);
+
+	i = 0;
+
+	for(CBeadRange::const_iterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++, i++)
+	{
+		if(vSelected[i])
+		{
+			const CAbstractBead* const pBead = *iterBead;
+
+			const long slot = m_vTypeStart[pBead->GetType()]++;
+
+			m_vId[slot]        = static_cast<int32_t>(pBead->GetId());
+			m_vDisplayId[slot] = static_cast<int32_t>(CCurrentState::GetBeadDisplayId(pBead->GetId()));
+			m_vXPos[slot]      = static_cast<float>(pBead->GetXPos());
+			m_vYPos[slot]      = static_cast<float>(pBead->GetYPos());
+			m_vZPos[slot]      = static_cast<float>(pBead->GetZPos());
+		}
+	}
+
+	// Write the frame and record its position for the index
+
+	std::vector<int64_t> vTypeCount(m_vTypeCount.begin(), m_vTypeCount.end());
+
+	BinaryFrameHeader header;
+	memcpy(header.id, BinaryFrameId, 8);
+	header.time      = currentTime;
+	header.beadTotal = beadTotal;
+	header.beadTypeTotal = m_BeadTypeTotal;
+	header.frameSize = sizeof(BinaryFrameHeader) + m_BeadTypeTotal*sizeof(int64_t) + 
+					   beadTotal*(2*sizeof(int32_t) + 3*sizeof(float));
+
+	m_vFrameTime.push_back(currentTime);
+	m_vFrameOffset.push_back(static_cast<long>(m_outStream.tellp()));
+
+	m_outStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	WriteArray(m_outStream, vTypeCount.data(),   m_BeadTypeTotal);
+	WriteArray(m_outStream, m_vId.data(),        beadTotal);
+	WriteArray(m_outStream, m_vDisplayId.data(), beadTotal);
+	WriteArray(m_outStream, m_vXPos.data(),      beadTotal);
+	WriteArray(m_outStream, m_vYPos.data(),      beadTotal);
+	WriteArray(m_outStream, m_vZPos.data(),      beadTotal);
+
+	// Flush each frame so that the trajectory can be read while the run continues
+
+	m_outStream.flush();
+
+	if(!m_outStream.good())
+		return IOError("Error writing frame to binary trajectory " + m_FileName);
+
+	return true;
+}
+
+// Function to complete the file by writing the frame index after the last
+// frame, and updating the number of frames and index offset in the header.
+// No further frames can be added after this.
+
+bool CBinaryTrajectoryState::Serialize()
+{
+	if(m_bClosed)
+		return true;
+
+	m_bClosed = true;
+
+	if(!m_outStream.is_open() || !m_outStream.good())
+		return false;
+
+	const int64_t indexOffset = m_outStream.tellp();
+	const int64_t frameTotal  = GetFrameTotal();
+
+	std::vector<int64_t> vIndex;
+	vIndex.reserve(2*frameTotal);
+
+	for(long frame=0; frame<frameTotal; frame++)
+	{
+		vIndex.push_back(m_vFrameTime.at(frame));
+		vIndex.push_back(m_vFrameOffset.at(frame));
+	}
+
+	m_outStream.write(BinaryIndexId, 8);
+	m_outStream.write(reinterpret_cast<const char*>(&frameTotal), sizeof(frameTotal));
+	WriteArray(m_outStream, vIndex.data(), vIndex.size());
+
+	// Bead types added after the file header was written: the total number of
+	// types, followed by the names of those not already in the header
+
+	const int64_t beadTypeTotal = m_BeadTypeTotal;
+	m_outStream.write(reinterpret_cast<const char*>(&beadTypeTotal), sizeof(beadTypeTotal));
+
+	for(long type=m_HeaderBeadTypeTotal; type<m_BeadTypeTotal; type++)
+	{
+		const zString  name   = m_pISimBox->GetBeadNameFromType(type);
+		const uint32_t length = name.size();
+
+		m_outStream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		m_outStream.write(name.data(), length);
+	}
+
+	// Rewrite the header now the frame total and index offset are known
+
+	m_outStream.seekp(0, zIos::beg);
+
+	WriteHeader(frameTotal, indexOffset);
+
+	m_outStream.flush();
+
+	if(!m_outStream.good())
+		return IOError("Error writing frame index to binary trajectory " + m_FileName);
+
+	return Close();
+}
+
+// Private function to write the file header at the current position of the
+// output stream. It is written with no frames and a zero index offset when 
+// the file is opened, and rewritten when the frame index has been added.
+
+void CBinaryTrajectoryState::WriteHeader(long frameTotal, long indexOffset)
+{
+	BinaryTrajectoryHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.id, BinaryTrajectoryId, 8);
+	header.byteOrder       = BinaryTrajectoryByteOrder;
+	header.version         = m_Version;
+	header.headerSize      = sizeof(BinaryTrajectoryHeader);
+	header.simBoxLength[0] = m_pISimBox->GetSimSpaceXLength();
+	header.simBoxLength[1] = m_pISimBox->GetSimSpaceYLength();
+	header.simBoxLength[2] = m_pISimBox->GetSimSpaceZLength();
+	header.beadTypeTotal   = m_HeaderBeadTypeTotal;
+	header.frameTotal      = frameTotal;
+	header.indexOffset     = indexOffset;
+
+	m_outStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
@@ -0,0 +1,119 @@
+// BinaryTrajectoryState.h: interface for the CBinaryTrajectoryState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_BINARYTRAJECTORYSTATE_H__91D4C6E3_27AB_4F5C_8E06_B3A57D1F2C48__INCLUDED_)
+#define AFX_BINARYTRAJECTORYSTATE_H__91D4C6E3_27AB_4F5C_8E06_B3A57D1F2C48__INCLUDED_
+
+
+// Forward declarations
+
+class ISimBox;
+
+
+#include "xxState.h"
+
+// Binary trajectory file that holds all the current state snapshots of a run
+// selected by the "BinaryTrajectory" format of the SetCurrentStateDefaultFormat
+// command. Instead of writing a text file for each snapshot, the CMonitor 
+// creates one instance of this class when the first snapshot is taken, and 
+// each snapshot is appended to its file as a frame. The frames are written
+// with the same bead selection as the text formats: beads that are invisible, 
+// or outside the display bead range, are omitted.
+//
+// Coordinates are stored as 32-bit floats, which is ample for visualisation
+// and structural analysis and halves the storage needed. Within a frame the
+// beads are grouped by type, and the frame header holds the number of beads 
+// of each type, so that a reader can select the bead types it needs and seek 
+// past the rest. The layout is:
+//
+//	File header		identifier, byte order, version, SimBox size, number of
+//					bead types, number of frames and offset of the frame index
+//	Bead types		length and characters of each bead type's name
+//	Frames			time, number of beads, number of bead types, number of beads 
+//					of each type, then arrays of bead ids, display ids and 
+//					X, Y, Z coordinates
+//	Frame index		time and file offset of each frame, then the final number
+//					of bead types and the names of types added during the run
+//
+// Bead types created by commands during a run (e.g., ctChangeBeadType) are
+// appended to the type list, so each frame records how many types it counts.
+//
+// The frame index, and the number of frames in the file header, are written by
+// Serialize() when the run ends. If a run stops before then, the frames are 
+// still complete and can be found by reading the frame headers in sequence.
+
+class CBinaryTrajectoryState : public xxState
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CBinaryTrajectoryState(const zString runId, const ISimBox* const pISimBox);
+
+	virtual ~CBinaryTrajectoryState();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetTrajectoryFileName(const zString runId);
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetFrameTotal() const {return m_vFrameTime.size();}
+
+	bool AddFrame(long currentTime, bool bRestrictCoords,
+				  double xmin, double ymin, double zmin,
+				  double xmax, double ymax, double zmax);
+
+	bool Serialize();
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	void WriteHeader(long frameTotal, long indexOffset);
+
+	// ****************************************
+	// Data members
+private:
+
+	static const long m_Version;	// Version of the file layout written by this class
+
+	const ISimBox* const m_pISimBox;
+
+	const long m_HeaderBeadTypeTotal;	// Number of bead types named in the file header
+	long       m_BeadTypeTotal;			// Current number of bead types, including any added by commands
+
+	bool m_bClosed;					// Flag showing the frame index has been written
+
+	zLongVector m_vFrameTime;		// Time and file offset of each frame
+	zLongVector m_vFrameOffset;
+
+	// Frame data grouped by bead type: kept between frames to avoid reallocation
+
+	zLongVector          m_vTypeCount;
+	zLongVector          m_vTypeStart;
+	std::vector<int32_t> m_vId;
+	std::vector<int32_t> m_vDisplayId;
+	std::vector<float>   m_vXPos;
+	std::vector<float>   m_vYPos;
+	std::vector<float>   m_vZPos;
+};
+
+#endif // !defined(AFX_BINARYTRAJECTORYSTATE_H__91D4C6E3_27AB_4F5C_8E06_B3A57D1F2C48__INCLUDED_)
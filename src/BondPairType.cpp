@@ -42,7 +42,7 @@ bool operator==(const CBondPairType& a, const CBondPairType& b)
 // Static member definitions
 //////////////////////////////////////////////////////////////////////
 
-long CBondPairType::m_BondPairTypeTotal = 0;	// No of bond types created so far
+thread_local long CBondPairType::m_BondPairTypeTotal = 0;	// No of bond types created so far
 
 long CBondPairType::GetTotal()
 {
@@ -37,7 +37,7 @@ protected:
 	CBondPairType(zString name1, zString name2, zString name3, double Strength, double Phi0);
 
 private:
-	static long m_BondPairTypeTotal;
+	static thread_local long m_BondPairTypeTotal;
 
 	zString m_Name1;			// Name of first bead in bondpair triple
 	zString m_Name2;			// Name of middle bead 
@@ -35,7 +35,7 @@ protected:
 	CBondType(zString head, zString tail, double SprConst, double UnStrLen);
 
 private:
-	static long m_BondTypeTotal;
+	static thread_local long m_BondTypeTotal;
 
 	zString m_headName;
 	zString m_tailName;
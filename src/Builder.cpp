@@ -56,9 +56,9 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // The shuffle produced will be different to random_shuffle, but that order is implementation
 // defined and may not even be stable between runs.
 
-// This is shared. If the Builder code becomes multi-threaded then there
-// is a potential issue.
-static std::mt19937_64 g_ShuffleRng;
+// Each thread has its own generator so that simulations run concurrently by
+// a CEnsemble are built independently and reproducibly.
+static thread_local std::mt19937_64 g_ShuffleRng;
 
 template<class T>
 static void random_shuffle_wrapper(T begin, T end)
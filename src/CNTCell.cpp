@@ -39,70 +39,83 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-bool   CCNTCell::m_bReadFileOnce  = true;
-long   CCNTCell::m_NextRNIndex    = 0;
-zDoubleVector CCNTCell::m_RandomNumbers;
+thread_local bool   CCNTCell::m_bReadFileOnce  = true;
+thread_local long   CCNTCell::m_NextRNIndex    = 0;
+thread_local zDoubleVector CCNTCell::m_RandomNumbers;
 long          CCNTCell::m_StringSize = 8;
 const zString CCNTCell::m_StringSeparator = "-";
 const zString CCNTCell::m_AlphabetChars   = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
 
-long   CCNTCell::m_CNTXCellNo			= 0;
-long   CCNTCell::m_CNTYCellNo			= 0;
-long   CCNTCell::m_CNTZCellNo			= 0;
-double CCNTCell::m_CNTXCellWidth		= 0.0;
-double CCNTCell::m_CNTYCellWidth		= 0.0;
-double CCNTCell::m_CNTZCellWidth		= 0.0;
-double CCNTCell::m_SimBoxXLength		= 0.0;
-double CCNTCell::m_SimBoxYLength		= 0.0;
-double CCNTCell::m_SimBoxZLength		= 0.0;
-double CCNTCell::m_HalfSimBoxXLength	= 0.0;
-double CCNTCell::m_HalfSimBoxYLength	= 0.0;
-double CCNTCell::m_HalfSimBoxZLength	= 0.0;
-double CCNTCell::m_dt					= 0.0;
-double CCNTCell::m_lambda				= 0.0;
-double CCNTCell::m_cutoffradius			= 0.0;
-double CCNTCell::m_coradius2			= 0.0;
-double CCNTCell::m_kT					= 0.0;
-double CCNTCell::m_halfdt				= 0.0;
-double CCNTCell::m_halfdt2				= 0.0;
-double CCNTCell::m_invrootdt			= 0.0;
-double CCNTCell::m_lamdt				= 0.0;
-double CCNTCell::m_lgnorm               = 0.0;
-double CCNTCell::m_dtoverkt			    = 0.0;
-double CCNTCell::m_dispmag			    = 0.0;
-uint64_t   CCNTCell::m_RNGSeed	        = -1ull;
+thread_local long   CCNTCell::m_CNTXCellNo			= 0;
+thread_local long   CCNTCell::m_CNTYCellNo			= 0;
+thread_local long   CCNTCell::m_CNTZCellNo			= 0;
+thread_local double CCNTCell::m_CNTXCellWidth		= 0.0;
+thread_local double CCNTCell::m_CNTYCellWidth		= 0.0;
+thread_local double CCNTCell::m_CNTZCellWidth		= 0.0;
+thread_local double CCNTCell::m_SimBoxXLength		= 0.0;
+thread_local double CCNTCell::m_SimBoxYLength		= 0.0;
+thread_local double CCNTCell::m_SimBoxZLength		= 0.0;
+thread_local double CCNTCell::m_HalfSimBoxXLength	= 0.0;
+thread_local double CCNTCell::m_HalfSimBoxYLength	= 0.0;
+thread_local double CCNTCell::m_HalfSimBoxZLength	= 0.0;
+thread_local double CCNTCell::m_dt					= 0.0;
+thread_local double CCNTCell::m_lambda				= 0.0;
+thread_local double CCNTCell::m_cutoffradius			= 0.0;
+thread_local double CCNTCell::m_coradius2			= 0.0;
+thread_local double CCNTCell::m_kT					= 0.0;
+thread_local double CCNTCell::m_halfdt				= 0.0;
+thread_local double CCNTCell::m_halfdt2				= 0.0;
+thread_local double CCNTCell::m_invrootdt			= 0.0;
+thread_local double CCNTCell::m_lamdt				= 0.0;
+thread_local double CCNTCell::m_lgnorm               = 0.0;
+thread_local double CCNTCell::m_dtoverkt			    = 0.0;
+thread_local double CCNTCell::m_dispmag			    = 0.0;
+thread_local uint64_t   CCNTCell::m_RNGSeed	        = -1ull;
+thread_local uint64_t   CCNTCell::m_PairRNGKey          = -1ull;
+thread_local uint64_t   CCNTCell::m_PairRNGStep         = 0;
 long double CCNTCell::m_2Power32             =  4294967296.0l;              // 2**32
 long double CCNTCell::m_Inv2Power32          =  1.0l/CCNTCell::m_2Power32;  // Inverse of 2**32
 
-CMonitor* CCNTCell::m_pMonitor				 = 0;
-ISimBox* CCNTCell::m_pISimBox                = 0;
+thread_local CMonitor* CCNTCell::m_pMonitor				 = 0;
+thread_local ISimBox* CCNTCell::m_pISimBox                = 0;
 
-const zArray2dDouble* CCNTCell::m_pvvConsInt = 0;
-const zArray2dDouble* CCNTCell::m_pvvDissInt = 0;
-const zArray2dDouble* CCNTCell::m_pvvLGInt   = 0;
-const zArray2dDouble* CCNTCell::m_pvvLJDepth = 0;
-const zArray2dDouble* CCNTCell::m_pvvLJRange = 0;
-const zArray2dDouble* CCNTCell::m_pvvSCDepth = 0;
-const zArray2dDouble* CCNTCell::m_pvvSCRange = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvConsInt = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvDissInt = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvLGInt   = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvLJDepth = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvLJRange = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvSCDepth = 0;
+thread_local const zArray2dDouble* CCNTCell::m_pvvSCRange = 0;
 
 // Platform-dependent initialisation of static arrays
 
 
-zArray2dDouble	     CCNTCell::m_vvConsInt;
-zArray2dDouble	     CCNTCell::m_vvDissInt;
-zArray2dDouble	     CCNTCell::m_vvLGInt;
-zArray2dDouble	     CCNTCell::m_vvConsIntBackup;
-zArray2dDouble	     CCNTCell::m_vvDissIntBackup;
-zArray2dDouble	     CCNTCell::m_vvLGIntBackup;
-zArray2dDouble	     CCNTCell::m_vvLJDepth;
-zArray2dDouble	     CCNTCell::m_vvLJRange;
-zArray2dDouble	     CCNTCell::m_vvSCDepth;
-zArray2dDouble	     CCNTCell::m_vvSCRange;
-zArray2dDouble	     CCNTCell::m_vvLJDelta;
-zArray2dDouble	     CCNTCell::m_vvLJSlope;
-zArray2dDouble	     CCNTCell::m_vvSCDelta;
-zArray2dDouble	     CCNTCell::m_vvSCSlope;
+thread_local zArray2dDouble	     CCNTCell::m_vvConsInt;
+thread_local zArray2dDouble	     CCNTCell::m_vvDissInt;
+thread_local zArray2dDouble	     CCNTCell::m_vvLGInt;
+thread_local zArray2dDouble	     CCNTCell::m_vvConsIntBackup;
+thread_local zArray2dDouble	     CCNTCell::m_vvDissIntBackup;
+thread_local zArray2dDouble	     CCNTCell::m_vvLGIntBackup;
+thread_local long                CCNTCell::m_DPDIntegrator = CCNTCell::DPDVelocityVerlet;
+thread_local zArray2dDouble	     CCNTCell::m_vvSplitDissInt;
+thread_local bool                CCNTCell::m_bBeadRadii = false;
+
+// Force kernels used until SelectForceKernel() is called: DPD without bead radii
+
+thread_local CCNTCell::ForceKernel CCNTCell::m_ForceKernel[2]        = {&CCNTCell::UpdateForceKernel<DPD, false, false>,
+                                                                         &CCNTCell::UpdateForceKernel<DPD, false, true>};
+thread_local CCNTCell::ForceKernel CCNTCell::m_ForcePKernel          =  &CCNTCell::UpdateForcePKernel<DPD, false>;
+thread_local CCNTCell::PairKernel  CCNTCell::m_BetweenCellsKernel[2] = {&CCNTCell::BetweenCellsKernel<DPD, false, false>,
+                                                                         &CCNTCell::BetweenCellsKernel<DPD, false, true>};
+thread_local zArray2dDouble	     CCNTCell::m_vvLJDepth;
+thread_local zArray2dDouble	     CCNTCell::m_vvLJRange;
+thread_local zArray2dDouble	     CCNTCell::m_vvSCDepth;
+thread_local zArray2dDouble	     CCNTCell::m_vvSCRange;
+thread_local zArray2dDouble	     CCNTCell::m_vvLJDelta;
+thread_local zArray2dDouble	     CCNTCell::m_vvLJSlope;
+thread_local zArray2dDouble	     CCNTCell::m_vvSCDelta;
+thread_local zArray2dDouble	     CCNTCell::m_vvSCSlope;
 
 
 // Function to set the static member variable that holds a pointer to the
@@ -133,7 +146,17 @@ void CCNTCell::SetISimBoxPointer(ISimBox* pISimBox)
 
 void CCNTCell::SetRNGSeed(long idum)
 {
-    CCNTCell::m_RNGSeed = static_cast<uint64_t>(abs(idum));
+    CCNTCell::m_RNGSeed    = static_cast<uint64_t>(abs(idum));
+    CCNTCell::m_PairRNGKey = CCNTCell::m_RNGSeed;
+}
+
+// Function to set the time step used by the counter-based RNG. It must be 
+// called once per time step before any pair random numbers are generated
+// so that each step draws a distinct set of random numbers.
+
+void CCNTCell::SetRNGTimeStep(long step)
+{
+    CCNTCell::m_PairRNGStep = static_cast<uint64_t>(step);
 }
 
 // Function to set the static member variables holding the size of the
@@ -239,13 +262,11 @@ void CCNTCell::ToggleDPDBeadConservativeForces(bool bZero)
 		m_vvConsIntBackup.clear();
 		m_vvConsIntBackup.resize(m_vvConsInt.size());
 
-#if EnableDPDLG == ExperimentEnabled
         if(IGlobalSimBox::Instance()->IsDPDLG())
         {
 		    m_vvLGIntBackup.clear();
 		    m_vvLGIntBackup.resize(m_vvLGInt.size());
         }
-#endif
 
 		// Fill the backup array with the original values and replace them by 
 		// zeroes in the normal arrays: note that the array is guaranteed to 
@@ -260,13 +281,11 @@ void CCNTCell::ToggleDPDBeadConservativeForces(bool bZero)
 			copy(m_vvConsInt.at(row).begin(), m_vvConsInt.at(row).end(), back_inserter(m_vvConsIntBackup.at(row)));					
 			m_vvConsInt.at(row).assign(rowSize, 0.0);
 
-#if EnableDPDLG == ExperimentEnabled
         if(IGlobalSimBox::Instance()->IsDPDLG())
         {
 			copy(m_vvLGInt.at(row).begin(), m_vvLGInt.at(row).end(), back_inserter(m_vvLGIntBackup.at(row)));					
 			m_vvLGInt.at(row).assign(rowSize, 0.0);
         }
-#endif
 		}
 	}
 	else
@@ -275,8 +294,6 @@ void CCNTCell::ToggleDPDBeadConservativeForces(bool bZero)
 
         const long rowSize = m_vvConsInt.size();
 
-#if EnableDPDLG == ExperimentEnabled
-
 		for(long row=0; row<rowSize; row++)
 		{
 			m_vvConsInt.at(row).clear();
@@ -294,19 +311,6 @@ void CCNTCell::ToggleDPDBeadConservativeForces(bool bZero)
         {
 		    m_vvLGIntBackup.clear();
         }
-
-#elif EnableDPDLG == ExperimentDisabled
-
-		for(long row=0; row<rowSize; row++)
-		{
-			m_vvConsInt.at(row).clear();
-			copy(m_vvConsIntBackup.at(row).begin(), m_vvConsIntBackup.at(row).end(), back_inserter(m_vvConsInt.at(row)));
-        }
-
-		m_vvConsIntBackup.clear();
-
-#endif
-
 	}
 }
 
@@ -317,28 +321,33 @@ void CCNTCell::ToggleDPDBeadConservativeForces(bool bZero)
 
 void CCNTCell::ToggleDPDBeadThermostat(bool bZero)
 {
+	// If a split integration scheme is in use the thermostat's array holds
+	// the dissipation parameters, so we zero and restore that one instead.
+
+	zArray2dDouble& rvvDissInt = IsDPDThermostatSplit() ? m_vvSplitDissInt : m_vvDissInt;
+
 	if(bZero)
 	{
 		m_vvDissIntBackup.clear();
-		m_vvDissIntBackup.resize(m_vvDissInt.size());
+		m_vvDissIntBackup.resize(rvvDissInt.size());
 
-		const long rowSize = m_vvDissInt.size();
+		const long rowSize = rvvDissInt.size();
 
 		for(long row=0; row<rowSize; row++)
 		{
-			copy(m_vvDissInt.at(row).begin(), m_vvDissInt.at(row).end(), back_inserter(m_vvDissIntBackup.at(row)));
+			copy(rvvDissInt.at(row).begin(), rvvDissInt.at(row).end(), back_inserter(m_vvDissIntBackup.at(row)));
 						
-			m_vvDissInt.at(row).assign(rowSize, 0.0);
+			rvvDissInt.at(row).assign(rowSize, 0.0);
 		}
 	}
 	else
 	{		
-		const long rowSize = m_vvDissInt.size();
+		const long rowSize = rvvDissInt.size();
 
 		for(long row=0; row<rowSize; row++)
 		{
-			m_vvDissInt.at(row).clear();
-			copy(m_vvDissIntBackup.at(row).begin(), m_vvDissIntBackup.at(row).end(), back_inserter(m_vvDissInt.at(row)));
+			rvvDissInt.at(row).clear();
+			copy(m_vvDissIntBackup.at(row).begin(), m_vvDissIntBackup.at(row).end(), back_inserter(rvvDissInt.at(row)));
 		}
 
 		m_vvDissIntBackup.clear();
@@ -404,7 +413,6 @@ void CCNTCell::SetDPDBeadStructure(const zArray2dDouble* pvvConsInt,
 								   const zArray2dDouble* pvvDissInt,
                                    const zArray2dDouble* pvvLGInt)
 {
-#if EnableDPDLG == ExperimentEnabled
 	CCNTCell::m_pvvConsInt = pvvConsInt;
 	CCNTCell::m_pvvDissInt = pvvDissInt;
 
@@ -412,7 +420,6 @@ void CCNTCell::SetDPDBeadStructure(const zArray2dDouble* pvvConsInt,
     {
         CCNTCell::m_pvvLGInt   = pvvLGInt;
     }
-#endif
 }
 
 void CCNTCell::SetMDBeadStructure(const zArray2dDouble* pvvLJDepth,
@@ -445,19 +452,24 @@ void CCNTCell::SetDPDBeadConsInt(long firstType, long secondType, double newValu
 
 }
 
+// If a split integration scheme is in use, the dissipation parameters are
+// held in the thermostat's array and the force loop's array stays zeroed.
+
 void CCNTCell::SetDPDBeadDissInt(long firstType, long secondType, double newValue)
 {
-	if(0 <= firstType  && firstType  < static_cast<long>(m_vvDissInt.size()) &&
-	   0 <= secondType && secondType < static_cast<long>(m_vvDissInt.size()))
+	zArray2dDouble& rvvDissInt = IsDPDThermostatSplit() ? m_vvSplitDissInt : m_vvDissInt;
+
+	if(0 <= firstType  && firstType  < static_cast<long>(rvvDissInt.size()) &&
+	   0 <= secondType && secondType < static_cast<long>(rvvDissInt.size()))
 	{
-		m_vvDissInt.at(firstType).at(secondType) = newValue;
-		m_vvDissInt.at(secondType).at(firstType) = newValue;	
+		rvvDissInt.at(firstType).at(secondType) = newValue;
+		rvvDissInt.at(secondType).at(firstType) = newValue;	
 	}
 }
 
 // Function used by the CSimState to change the value of the DPD density-dependent
-// LG force. This feature is only allowed when the EnableDPDLG flag is set.
-// Because the matrix is symmetric we have to set both corresponding
+// LG force. This feature is only used when the control data file starts with
+// the "dpdlg" token. Because the matrix is symmetric we have to set both corresponding
 // elements when an off-diagonal element is specified.
 
 void CCNTCell::SetDPDBeadLGInt(long firstType, long secondType, double newValue)
@@ -465,7 +477,6 @@ void CCNTCell::SetDPDBeadLGInt(long firstType, long secondType, double newValue)
 	// Check that the types are within the container range: note that the 
 	// container is symmetric by construction so we only need to check one dimension.
 
-#if EnableDPDLG == ExperimentEnabled
         if(IGlobalSimBox::Instance()->IsDPDLG())
     {
 	    if(0 <= firstType  && firstType  < m_vvLGInt.size() &&
@@ -475,7 +486,6 @@ void CCNTCell::SetDPDBeadLGInt(long firstType, long secondType, double newValue)
 		    m_vvLGInt.at(secondType).at(firstType) = newValue;	
 	    }
     }
-#endif
 }
 
 // Function used by the CSimBox to add a new DPD bead type to the 
@@ -510,6 +520,11 @@ void CCNTCell::AddDPDBeadType(long oldType)
 		m_vvConsInt.at(row).push_back(oldConsInt);
 		m_vvDissInt.at(row).push_back(oldDissInt);
 
+		if(IsDPDThermostatSplit())
+		{
+			m_vvSplitDissInt.at(row).push_back(m_vvSplitDissInt.at(row).at(oldType));
+		}
+
 		// If the conservative or dissipative arrays are currently zeroed, 
 		// update the backup arrays as well. We store the original non-zero  
 		// value for the new bead type's interaction parameter not 0.0.
@@ -531,6 +546,11 @@ void CCNTCell::AddDPDBeadType(long oldType)
 	m_vvConsInt.push_back(m_vvConsInt.at(oldType));
 	m_vvDissInt.push_back(m_vvDissInt.at(oldType));
 
+	if(IsDPDThermostatSplit())
+	{
+		m_vvSplitDissInt.push_back(m_vvSplitDissInt.at(oldType));
+	}
+
 	if(m_vvConsIntBackup.size() > 0)
 	{
 		m_vvConsIntBackup.push_back(m_vvConsIntBackup.at(oldType));
@@ -543,7 +563,6 @@ void CCNTCell::AddDPDBeadType(long oldType)
 
     // Now repeat for the density-dependent force parameters
 
-#if EnableDPDLG == ExperimentEnabled
         if(IGlobalSimBox::Instance()->IsDPDLG())
     {
 	    for(row = 0; row < m_vvConsInt.size(); row++)
@@ -565,10 +584,66 @@ void CCNTCell::AddDPDBeadType(long oldType)
 		    m_vvLGIntBackup.push_back(m_vvLGIntBackup.at(oldType));
 	    }
     }
-#endif
 
 }
 
+// Command handler function to select the scheme used to integrate the DPD
+// equations of motion. The default is the modified velocity-Verlet scheme
+// in which UpdateForce() calculates the conservative, dissipative and random
+// forces together. The alternatives split the dissipative and random forces
+// off from the conservative ones (Shardlow, J. Sci. Comp. 24:1267 (2003)):
+// UpdateForce() calculates only the conservative forces, which are integrated
+// with velocity-Verlet, and UpdateThermostat() updates the velocities of each
+// interacting pair of beads in turn before the positions are updated:
+//
+//  DPDShardlow     - S1 splitting: each pair's dissipative and random forces
+//                    are integrated exactly over the time step using a half
+//                    explicit and half implicit update of its velocities.
+//
+//  DPDLoweAndersen - Lowe-Andersen thermostat (Lowe, Europhys. Lett. 47:145
+//                    (1999)): each pair's relative velocity along their
+//                    separation is replaced by one drawn from the Maxwell
+//                    distribution with a probability equal to the dissipation
+//                    parameter times the time step.
+//
+// Both schemes conserve momentum pair by pair and keep the temperature at
+// time steps several times larger than the velocity-Verlet scheme allows.
+//
+// The dissipation parameters are moved into a separate array while a split
+// scheme is in use, so that the force loops, including that of the
+// CCNTCellBeadStore, see zero dissipation without any change to their code.
+// They are restored when the velocity-Verlet scheme is selected again.
+
+void CCNTCell::SetDPDIntegrator(long integrator)
+{
+	if(integrator == m_DPDIntegrator || integrator < DPDVelocityVerlet || integrator > DPDLoweAndersen)
+		return;
+
+	if(!IsDPDThermostatSplit())
+	{
+		const long rowSize = m_vvDissInt.size();
+
+		m_vvSplitDissInt.clear();
+		m_vvSplitDissInt.resize(rowSize);
+
+		for(long row=0; row<rowSize; row++)
+		{
+			m_vvSplitDissInt.at(row).assign(m_vvDissInt.at(row).begin(), m_vvDissInt.at(row).end());
+			m_vvDissInt.at(row).assign(rowSize, 0.0);
+		}
+	}
+	else if(integrator == DPDVelocityVerlet)
+	{
+		for(long row=0; row<m_vvSplitDissInt.size(); row++)
+		{
+			m_vvDissInt.at(row).assign(m_vvSplitDissInt.at(row).begin(), m_vvSplitDissInt.at(row).end());
+		}
+		m_vvSplitDissInt.clear();
+	}
+
+	m_DPDIntegrator = integrator;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -626,22 +701,21 @@ CCNTCell::CCNTCell(long index, long coords[3], bool flag) : CAbstractCell()
 	// for the container being empty fails on all but the first of a sequence 
 	// of runs and the data from the first run is used for all subsequent runs.
 
-#if SimIdentifier == BD
-// We copy the DPD bead-bead interactions to the BD case for now
-	if(m_vvConsInt.empty())
+	if(GetSimIdentifier() == BD)
 	{
-		copy(m_pvvConsInt->begin(), m_pvvConsInt->end(), back_inserter(m_vvConsInt));
-		copy(m_pvvDissInt->begin(), m_pvvDissInt->end(), back_inserter(m_vvDissInt));
-	}
-
-#elif SimIdentifier == DPD
+		// We copy the DPD bead-bead interactions to the BD case for now
 
-	if(m_vvConsInt.empty())
+		if(m_vvConsInt.empty())
+		{
+			copy(m_pvvConsInt->begin(), m_pvvConsInt->end(), back_inserter(m_vvConsInt));
+			copy(m_pvvDissInt->begin(), m_pvvDissInt->end(), back_inserter(m_vvDissInt));
+		}
+	}
+	else if(GetSimIdentifier() == DPD && m_vvConsInt.empty())
 	{
 		copy(m_pvvConsInt->begin(), m_pvvConsInt->end(), back_inserter(m_vvConsInt));
 		copy(m_pvvDissInt->begin(), m_pvvDissInt->end(), back_inserter(m_vvDissInt));
 
-#if EnableDPDLG == ExperimentEnabled
         // We don't have access to the IGlobalSimBox::Instance()->IsDPDLG() here
         // as the CNT cells are created from within the SimBox's constructor
         // and it has not filled up its base class instance variables yet.
@@ -650,12 +724,8 @@ CCNTCell::CCNTCell(long index, long coords[3], bool flag) : CAbstractCell()
         {
 		    copy(m_pvvLGInt->begin(), m_pvvLGInt->end(), back_inserter(m_vvLGInt));
         }
-#endif
     }
-
-#elif SimIdentifier == MD
-
-	if(m_vvLJDepth.empty())
+	else if(GetSimIdentifier() == MD && m_vvLJDepth.empty())
 	{
 		copy(m_pvvLJDepth->begin(), m_pvvLJDepth->end(), back_inserter(m_vvLJDepth));
 		copy(m_pvvLJRange->begin(), m_pvvLJRange->end(), back_inserter(m_vvLJRange));
@@ -753,8 +823,6 @@ CCNTCell::CCNTCell(long index, long coords[3], bool flag) : CAbstractCell()
 				}
 			}
 	}
-
-#endif
 }
 
 // Copy constructor. We don't have to check any static members as they must have
@@ -778,32 +846,22 @@ CCNTCell::CCNTCell(const CCNTCell& oldCell) : CAbstractCell(oldCell),
 
 // Empty the static containers holding the bead-bead interaction parameters for
 // BD, DPD and MD simulations. We ensure this is only done once by checking
-// that the containers are not empty before doing it.
+// that the containers are not empty before doing it. BD simulations use the
+// DPD containers.
 
 CCNTCell::~CCNTCell()
 {
-#if SimIdentifier == BD
-
 	if(!m_vvConsInt.empty())
 	{
 		m_vvConsInt.clear();
 		m_vvDissInt.clear();
-	}
+		m_vvSplitDissInt.clear();
 
-#elif SimIdentifier == DPD
+		m_DPDIntegrator = DPDVelocityVerlet;
 
-	if(!m_vvConsInt.empty())
-	{
-		m_vvConsInt.clear();
-		m_vvDissInt.clear();
-
-#if EnableDPDLG == ExperimentEnabled
 		m_vvLGInt.clear();
-#endif
 	}
 
-#elif SimIdentifier == MD
-
 	if(!m_vvLJDepth.empty())
 	{
 		m_vvLJDepth.clear();
@@ -815,9 +873,6 @@ CCNTCell::~CCNTCell()
 		m_vvSCDelta.clear();
 		m_vvSCSlope.clear();
 	}
-
-#endif
-
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -830,8 +885,12 @@ CCNTCell::~CCNTCell()
 // We only apply the PBCs to interactions between beads in different
 // cells both of which are on the simulation box boundary.
 //
-// Conditional compilation is used to select which of the simulation methods
-// is used. 
+// The loop itself is in UpdateForceKernel(), which is specialised for each 
+// simulation type, for DPD beads with and without their own interaction radii,
+// and for cells that do or do not lie on the simulation box boundary. The 
+// specialisations are selected once by SelectForceKernel() when the simulation
+// starts, so the type tests are not evaluated inside the loop and interior
+// cells never test for the PBCs. The pair force itself is in PairForce().
 // 
 // In BD simulations, the equation of motion is:
 //
@@ -856,10 +915,10 @@ CCNTCell::~CCNTCell()
 // 3 Random iteraction
 //
 // in addition, DPD beads can have an explicit radius of interaction per bead type.
-// This is selected by the flag UseDPDBeadRadii. If the flag is not set the
-// radius of all beads is set to 0.5 and the test for interactions is compiled
-// using a hard-wired if() statement. This is to avoid the overhead of calculating
-// the explicit test of dr with bead interaction radii when they are not being used.
+// This is selected by the BeadRadii keyword in the control data file. If it is
+// not present the radius of all beads is 0.5 and the kernel tests the square of
+// the separation against unity, avoiding the square root and the bead radii 
+// lookup for pairs that do not interact.
 //
 // whereas the MD force has two contributions:
 //
@@ -873,888 +932,626 @@ CCNTCell::~CCNTCell()
 // requires that all bead coordinates be at the same timestep and that 
 // they not be updated until after it has been called for all CNT cells 
 // and their contained beads.
+//
+// In a serial DPD simulation, the CCNTCellBeadStore's kernels replace this
+// function when the store is compiled in. It remains the force loop for MD 
+// and BD simulations, for the bulk cells of a parallel simulation, and for
+// builds without the store.
 
 void CCNTCell::UpdateForce()
 {
-//    const long targetBeadId = 4; // Write out interactions for this bead only
+	(this->*m_ForceKernel[m_bExternal])();
+}
 
-	mpsSimBox::GlobalCellCounter++;  // increment the counter for intra-cell force calculations
-	
-	long  localCellCellCounter = 0;
+// Function to select the force kernels for the simulation type and bead radii
+// flag of the current run. It must be called after the control data file has
+// been read and before the first call to UpdateForce(), UpdateForceP() or
+// UpdateLGForce(). Beads in BD simulations always use their radii, and MD beads
+// interact within the fixed cut-off radius whatever their radii.
 
-#if SimIdentifier == BD
+void CCNTCell::SelectForceKernel()
+{
+	const long simType = GetSimIdentifier();
 
-	BeadListIterator iterBead1;
-	BeadListIterator iterBead2;
-	rBeadListIterator riterBead2;
+	if(simType == BD)
+	{
+		m_ForceKernel[0]        = &CCNTCell::UpdateForceKernel<BD, true, false>;
+		m_ForceKernel[1]        = &CCNTCell::UpdateForceKernel<BD, true, true>;
+		m_ForcePKernel          = &CCNTCell::UpdateForcePKernel<BD, true>;
+		m_BetweenCellsKernel[0] = &CCNTCell::BetweenCellsKernel<BD, true, false>;
+		m_BetweenCellsKernel[1] = &CCNTCell::BetweenCellsKernel<BD, true, true>;
+	}
+	else if(simType == MD)
+	{
+		m_ForceKernel[0]        = &CCNTCell::UpdateForceKernel<MD, false, false>;
+		m_ForceKernel[1]        = &CCNTCell::UpdateForceKernel<MD, false, true>;
+		m_ForcePKernel          = &CCNTCell::UpdateForcePKernel<MD, false>;
+		m_BetweenCellsKernel[0] = &CCNTCell::BetweenCellsKernel<MD, false, false>;
+		m_BetweenCellsKernel[1] = &CCNTCell::BetweenCellsKernel<MD, false, true>;
+	}
+	else if(m_bBeadRadii)
+	{
+		m_ForceKernel[0]        = &CCNTCell::UpdateForceKernel<DPD, true, false>;
+		m_ForceKernel[1]        = &CCNTCell::UpdateForceKernel<DPD, true, true>;
+		m_ForcePKernel          = &CCNTCell::UpdateForcePKernel<DPD, true>;
+		m_BetweenCellsKernel[0] = &CCNTCell::BetweenCellsKernel<DPD, true, false>;
+		m_BetweenCellsKernel[1] = &CCNTCell::BetweenCellsKernel<DPD, true, true>;
+	}
+	else
+	{
+		m_ForceKernel[0]        = &CCNTCell::UpdateForceKernel<DPD, false, false>;
+		m_ForceKernel[1]        = &CCNTCell::UpdateForceKernel<DPD, false, true>;
+		m_ForcePKernel          = &CCNTCell::UpdateForcePKernel<DPD, false>;
+		m_BetweenCellsKernel[0] = &CCNTCell::BetweenCellsKernel<DPD, false, false>;
+		m_BetweenCellsKernel[1] = &CCNTCell::BetweenCellsKernel<DPD, false, true>;
+	}
+}
 
-	double dx[3];
-	double dr, dr2, drmax;
+// Function to calculate the non-bonded force between two beads whose 
+// separation is dx, relative velocity dv, and squared separation dr2. The
+// sum of the beads' interaction radii, drmax, is only used by BD simulations
+// and DPD simulations with bead radii. It returns false, and leaves the force
+// unchanged, if the beads are too far apart to interact or so close that their 
+// separation vector is undefined. The force on the first bead is returned in 
+// newForce; the second bead feels its negative.
+//
+// The DPD random force uses CCNTCell::Randf() so the order in which pairs are
+// visited determines the random number each one receives, exactly as before
+// the force loops were specialised.
 
-	double wr, wr2;
-	double conForce;
-    double newForce1[3], newForce2[3];
-	
+template<long simType, bool bBeadRadii>
+bool CCNTCell::PairForce(long type1, long type2, double drmax, const double dx[3], 
+                         const double dv[3], double dr2, double newForce[3])
+{
+	double dr, wr;
 
-	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+	if(simType == MD)
 	{
-		// First add interactions between beads in the current cell. Note that
-		// we don't have to check the PBCs here and we perform a reverse loop
-		// over the neighbouring beads until the iterators are equal. Because you can't
-		// compare a forward and reverse iterator we compare the bead ids for
-		// the terminating condition.
+		if(dr2 >= m_coradius2)
+			return false;
 
-		// Zero the stress tensor for this bead. Notice that because of the
-		// way we only sum over beads distinct from the current bead in the same
-		// cell, and over beads in cells to the right and above the current cell
-		// we don't have to worry about double counting the pairwise forces. We
-		// can hence store the N(N-1)/2 contributions to the stress tensor in the
-		// beads that form the first ones accessed in the double loops.
+		dr = sqrt(dr2);
+		wr = 0.0;
+	}
+	else if(simType == BD || bBeadRadii)
+	{
+		dr = sqrt(dr2);
 
-		for(short int j=0; j<9; j++)
-		{
-			(*iterBead1)->m_Stress[j] = 0.0;
-		}
+		if(dr >= drmax)
+			return false;
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
-		{
-			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
-			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
+		wr = (1.0 - dr/drmax);
+	}
+	else
+	{
+		if(dr2 >= 1.0)
+			return false;
 
-#if SimDimension == 2
-			dx[2] = 0.0;
-#elif SimDimension == 3
-			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
-#endif
+		dr = sqrt(dr2);
+		wr = (1.0 - dr);
+	}
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-			dr = sqrt(dr2);
-			drmax = (*iterBead1)->GetRadius()+(*riterBead2)->GetRadius();
-			if( dr < drmax )
-			{		
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr/drmax);
-					wr2 = wr*wr;
+	if(dr <= 0.000000001)
+		return false;
 
-// Conservative force magnitude
+	if(simType == BD)
+	{
+		// Conservative force only: the random displacement is added in UpdatePos()
 
-					conForce = m_vvConsInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr/dr;				
-//                    conForce = 0.0;
-					
-                    for(short int i=0; i<3; i++)
-                    {
-                        newForce1[i] = conForce*dx[i];
- 					    newForce2[i] = -conForce*dx[i];
+		const double conForce = m_vvConsInt.at(type1).at(type2)*wr/dr;
 
-                        (*iterBead1)->m_Force[i]  += newForce1[i];
-					    (*riterBead2)->m_Force[i] += newForce2[i];
-                    }
+		newForce[0] = conForce*dx[0];
+		newForce[1] = conForce*dx[1];
+		newForce[2] = conForce*dx[2];
+	}
+	else if(simType == DPD)
+	{
+		// Conservative force magnitude
 
-					// stress tensor summation
+		const double conForce  = m_vvConsInt.at(type1).at(type2)*wr;				
 
-					(*iterBead1)->m_Stress[0] += dx[0]*newForce1[0];
-					(*iterBead1)->m_Stress[1] += dx[1]*newForce1[0];
-					(*iterBead1)->m_Stress[2] += dx[2]*newForce1[0];
-					(*iterBead1)->m_Stress[3] += dx[0]*newForce1[1];
-					(*iterBead1)->m_Stress[4] += dx[1]*newForce1[1];
-					(*iterBead1)->m_Stress[5] += dx[2]*newForce1[1];
-					(*iterBead1)->m_Stress[6] += dx[0]*newForce1[2];
-					(*iterBead1)->m_Stress[7] += dx[1]*newForce1[2];
-					(*iterBead1)->m_Stress[8] += dx[2]*newForce1[2];
+		// Dissipative and random force magnitudes. Note dr factor in newForce calculation
 
-					// Pass the stress tensor components to the CMonitor
-					// for use in analysing the stress over slices.
-					// Note that dx[2] might be close to zero and we should
-					// check for this.
-                    // Is there a problem in the stress calculation now that the 
-                    // force on each bead in an interacting pair is not the same?
-					
-					// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce1, dx);
-#endif
-				}
-				else
-				{
-					TraceInt("same cell bead", (*iterBead1)->GetId());
-					TraceInt("interacts with", (*riterBead2)->GetId());
-					TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-											(*iterBead1)->GetYPos(), 
-											(*iterBead1)->GetZPos() );
-					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
-											(*riterBead2)->GetYPos(), 
-											(*riterBead2)->GetZPos() );
-					TraceDouble("Bead distance", dr);
-				}
-			}
-		}
+		const double rdotv     = (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
+		const double gammap    = m_vvDissInt.at(type1).at(type2)*wr*wr;
 
-		// Next add in interactions with beads in neighbouring cells taking the
-		// PBCs into account and the presence of a wall. The PBCs are only applied
-		// if both the current CNT cell and the neighbouring one are external.
+		const double dissForce = -gammap*rdotv;				
+		const double randForce = sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+// Gauss RNG	randForce = 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
 
-#if SimDimension == 2
-		for( int i=0; i<4; i++ )
-#elif SimDimension == 3
-		for( int i=0; i<13; i++ )
-#endif
+		newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
+		newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
+		newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
+	}
+	else
+	{
+		// Calculate common factors in the LJ potential and include shifted force.
+		// Note that the shifted force term needs to be multiplied by the 
+		// unit vector in the bead-bead separation whereas the force term 
+		// has the full vector.
+
+		const double eLJ      = m_vvLJDepth.at(type1).at(type2);	
+		const double sLJOverR = m_vvLJRange.at(type1).at(type2)/dr;
+		const double sLJR3    = sLJOverR*sLJOverR*sLJOverR;
+		const double sLJR6    = sLJR3*sLJR3;
+
+		const double magLJ = (6.0*eLJ*sLJR6*(2.0*sLJR6 - 1.0) 
+						      - dr*m_vvLJSlope.at(type1).at(type2))/dr2;
+
+		// Only add the soft-core potential if the potential depth is non-zero
+
+		const double eSC = m_vvSCDepth.at(type1).at(type2);	
+
+		double magSC = 0.0;
+
+		if(eSC > 0.0)
 		{
-			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
-			{
-				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
+			const double sSCOverR = m_vvSCRange.at(type1).at(type2)/dr;
+			const double sSCR3    = sSCOverR*sSCOverR*sSCOverR;
+			
+			magSC = (9.0*eSC*sSCR3*sSCR3*sSCR3 - dr*m_vvSCSlope.at(type1).at(type2))/dr2;
+		}
 
-#if SimDimension == 2
-				dx[2] = 0.0;
-#elif SimDimension == 3
-				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
-#endif
+		newForce[0] = (magLJ + magSC)*dx[0];
+		newForce[1] = (magLJ + magSC)*dx[1];
+		newForce[2] = (magLJ + magSC)*dx[2];
+	}
 
-				if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
-				{
-					if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
-						dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
-					else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
-						dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+	return true;
+}
 
-					if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
-						dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
-					else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
-						dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+// Explicit instantiations of the pair force for the combinations chosen by
+// SelectForceKernel(). The CExternalCNTCell uses them for beads owned by
+// neighbouring processors.
+
+template bool CCNTCell::PairForce<BD, true>(long, long, double, const double*, const double*, double, double*);
+template bool CCNTCell::PairForce<DPD, false>(long, long, double, const double*, const double*, double, double*);
+template bool CCNTCell::PairForce<DPD, true>(long, long, double, const double*, const double*, double, double*);
+template bool CCNTCell::PairForce<MD, false>(long, long, double, const double*, const double*, double, double*);
+
+// Function to add the force between two beads to both of them, and the 
+// pair's contribution to the stress tensor to the first bead. Notice that 
+// because of the way we only sum over beads distinct from the current bead 
+// in the same cell, and over beads in cells to the right and above the 
+// current cell, we don't have to worry about double counting the pairwise 
+// forces. We can hence store the N(N-1)/2 contributions to the stress tensor 
+// in the beads that form the first ones accessed in the double loops.
+
+inline void CCNTCell::AddPairForce(CAbstractBead* const pBead1, CAbstractBead* const pBead2, 
+                                   const double dx[3], double newForce[3])
+{
+	double localStress[9];
 
-#if SimDimension == 3
-					if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
-						dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
-					else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
-						dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+	pBead1->m_ForceCounter++;
+	pBead2->m_ForceCounter++;
+	
+	pBead1->m_Force[0] += newForce[0];
+	pBead1->m_Force[1] += newForce[1];
+	pBead1->m_Force[2] += newForce[2];
+
+	pBead2->m_Force[0] -= newForce[0];
+	pBead2->m_Force[1] -= newForce[1];
+	pBead2->m_Force[2] -= newForce[2];
+
+	// stress tensor summation
+
+	localStress[0] = dx[0]*newForce[0];
+	localStress[1] = dx[1]*newForce[0];
+	localStress[2] = dx[2]*newForce[0];
+	localStress[3] = dx[0]*newForce[1];
+	localStress[4] = dx[1]*newForce[1];
+	localStress[5] = dx[2]*newForce[1];
+	localStress[6] = dx[0]*newForce[2];
+	localStress[7] = dx[1]*newForce[2];
+	localStress[8] = dx[2]*newForce[2];
+	
+	pBead1->m_Stress[0] += localStress[0];
+	pBead1->m_Stress[1] += localStress[1];
+	pBead1->m_Stress[2] += localStress[2];
+	pBead1->m_Stress[3] += localStress[3];
+	pBead1->m_Stress[4] += localStress[4];
+	pBead1->m_Stress[5] += localStress[5];
+	pBead1->m_Stress[6] += localStress[6];
+	pBead1->m_Stress[7] += localStress[7];
+	pBead1->m_Stress[8] += localStress[8];
+
+	// Pass the stress tensor components to the CMonitor
+	// for use in analysing the stress over slices.
+	// Note that dx[2] might be close to zero and we should
+	// check for this.
+
+	// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
+#if EnableParallelSimBox == SimMPSDisabled
+	m_pMonitor->AddBeadStress(pBead1, pBead2, newForce, dx);
 #endif
 
-				}
+#if EnableStressTensorSphere == SimMiscEnabled
+	// 11/05/10 Store the bead-bead stress in curvilinear coordinates in each cell containing the interacting pair.
+	// 26/05/10 I implemented the proper apportioning of the stress to each cell along the vector joining the two particles.
+	// 18/06/10 I changed the stress storage from CNT cells into stress grid cells that are smaller than the CNT cells.
+	
+	m_pISimBox->AddBeadStress(pBead1->m_Pos, pBead2->m_Pos, localStress);
+#endif
+}
 
-				dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+// Function to add the forces between the passed-in bead and the beads in the
+// same cell that precede it in the reverse traversal of the cell's bead list.
+// We don't have to check the PBCs here and we perform a reverse loop over the
+// neighbouring beads until we reach the passed-in bead. Because you can't
+// compare a forward and reverse iterator we compare the bead ids for the
+// terminating condition. The passed-in bead's stress tensor is zeroed first.
 
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we have to change the distance-dependence according
-// to the bead interaction radii.
+template<long simType, bool bBeadRadii>
+void CCNTCell::SameCellKernel(CAbstractBead* const pBead1)
+{
+	rBeadListIterator riterBead2;
 
-				dr = sqrt(dr2);
-				drmax = (*iterBead1)->GetRadius()+(*iterBead2)->GetRadius();
-				if( dr < drmax )
-				{		
-					if( dr > 0.000000001 )
-					{
-						wr = (1.0 - dr/drmax);
-						wr2 = wr*wr;
- 
- // Conservative force magnitude
+	double dx[3], newForce[3];
+	double dv[3] = {0.0, 0.0, 0.0};	// Only used by DPD
+	double dr2, drmax = 1.0;
 
-					    conForce = m_vvConsInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr/dr;				
- //                       conForce = 0.0;
+	for(short int j=0; j<9; j++)
+	{
+		pBead1->m_Stress[j] = 0.0;
+	}
 
-                        for(short int i=0; i<3; i++)
-                        {
-                            newForce1[i] = conForce*dx[i];
- 					        newForce2[i] = -conForce*dx[i];
+	for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
+	{
+		CAbstractBead* const pBead2 = *riterBead2;
 
-                            (*iterBead1)->m_Force[i] += newForce1[i];
-					        (*iterBead2)->m_Force[i] += newForce2[i];
-                        }
-                       
-						// stress tensor summation
+		dx[0] = (pBead1->m_Pos[0] - pBead2->m_Pos[0]);
+		dx[1] = (pBead1->m_Pos[1] - pBead2->m_Pos[1]);
 
-						(*iterBead1)->m_Stress[0] += dx[0]*newForce1[0];
-						(*iterBead1)->m_Stress[1] += dx[1]*newForce1[0];
-						(*iterBead1)->m_Stress[2] += dx[2]*newForce1[0];
-						(*iterBead1)->m_Stress[3] += dx[0]*newForce1[1];
-						(*iterBead1)->m_Stress[4] += dx[1]*newForce1[1];
-						(*iterBead1)->m_Stress[5] += dx[2]*newForce1[1];
-						(*iterBead1)->m_Stress[6] += dx[0]*newForce1[2];
-						(*iterBead1)->m_Stress[7] += dx[1]*newForce1[2];
-						(*iterBead1)->m_Stress[8] += dx[2]*newForce1[2];
+#if SimDimension == 2
+		dx[2] = 0.0;
+#elif SimDimension == 3
+		dx[2] = (pBead1->m_Pos[2] - pBead2->m_Pos[2]);
+#endif
 
-						// Pass the stress tensor components to the CMonitor
-						// for use in analysing the stress over slices.
-						// Note that dx[2] might be close to zero and we should
-						// check for this.
+		if(simType == DPD)
+		{
+			dv[0] = (pBead1->m_Mom[0] - pBead2->m_Mom[0]);
+			dv[1] = (pBead1->m_Mom[1] - pBead2->m_Mom[1]);
 
-					    // 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-						m_pMonitor->AddBeadStress(*iterBead1, *iterBead2, newForce1, dx);
+#if SimDimension == 2
+			dv[2] = 0.0;
+#elif SimDimension == 3
+			dv[2] = (pBead1->m_Mom[2] - pBead2->m_Mom[2]);
 #endif
-					}
-					else
-					{
-						TraceInt("neighbour cell bead", (*iterBead1)->GetId());
-						TraceInt("interacts with", (*iterBead2)->GetId());
-						TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-												(*iterBead1)->GetYPos(), 
-												(*iterBead1)->GetZPos() );
-						TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
-												(*iterBead2)->GetYPos(), 
-												(*iterBead2)->GetZPos() );
-						TraceDouble("Bead distance", dr);
-					}
-				}
-			}
+		}
+
+		dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+		if(simType == BD || bBeadRadii)
+		{
+			drmax = pBead1->GetRadius() + pBead2->GetRadius();
+		}
+
+		if(PairForce<simType, bBeadRadii>(pBead1->GetType(), pBead2->GetType(), drmax, dx, dv, dr2, newForce))
+		{
+			AddPairForce(pBead1, pBead2, dx, newForce);
 		}
 	}
+}
 
-#else
-    // DPD and MD equations of motion
+// Function to add the forces between the passed-in bead, which belongs to a 
+// neighbouring cell, and all beads in the current cell. The PBCs are only
+// applied in the specialisation for pairs of cells that are both on the 
+// simulation box boundary.
 
-	BeadListIterator iterBead1;
+template<long simType, bool bBeadRadii, bool bWrap>
+void CCNTCell::BetweenCellsKernel(CAbstractBead* const pBead1)
+{
 	BeadListIterator iterBead2;
-	rBeadListIterator riterBead2;
 
-	double dx[3], dv[3], newForce[3];
-	double localStress[9];
-	double dr, dr2;
+	double dx[3], newForce[3];
+	double dv[3] = {0.0, 0.0, 0.0};	// Only used by DPD
+	double dr2, drmax = 1.0;
 
+	for( iterBead2=m_lBeads.begin(); iterBead2!=m_lBeads.end(); iterBead2++ )
+	{
+		CAbstractBead* const pBead2 = *iterBead2;
 
-#if SimIdentifier == DPD
+		dx[0] = (pBead1->m_Pos[0] - pBead2->m_Pos[0]);
+		dx[1] = (pBead1->m_Pos[1] - pBead2->m_Pos[1]);
 
-	double gammap, rdotv, wr, wr2;
-	double conForce, dissForce, randForce;
+#if SimDimension == 2
+		dx[2] = 0.0;
+#elif SimDimension == 3
+		dx[2] = (pBead1->m_Pos[2] - pBead2->m_Pos[2]);
+#endif
 
-#ifdef UseDPDBeadRadii
-	double drmax;
+		if(simType == DPD)
+		{
+			dv[0] = (pBead1->m_Mom[0] - pBead2->m_Mom[0]);
+			dv[1] = (pBead1->m_Mom[1] - pBead2->m_Mom[1]);
+
+#if SimDimension == 2
+			dv[2] = 0.0;
+#elif SimDimension == 3
+			dv[2] = (pBead1->m_Mom[2] - pBead2->m_Mom[2]);
+#endif
+		}
+
+		if(bWrap)
+		{
+			if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+				dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+			else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+				dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+
+			if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+				dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+			else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+				dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+
+#if SimDimension == 3
+			if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+				dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+			else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+				dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
 #endif
+		}
+
+		dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+		if(simType == BD || bBeadRadii)
+		{
+			drmax = pBead1->GetRadius() + pBead2->GetRadius();
+		}
+
+		if(PairForce<simType, bBeadRadii>(pBead1->GetType(), pBead2->GetType(), drmax, dx, dv, dr2, newForce))
+		{
+			AddPairForce(pBead1, pBead2, dx, newForce);
+		}
+	}
+}
+
+// Serial force loop specialised for the simulation type, bead radii flag and
+// whether the current cell lies on the simulation box boundary. Only cells 
+// on the boundary can have neighbours across the periodic boundaries, so the 
+// specialisation for interior cells contains no PBC tests at all.
+
+template<long simType, bool bBeadRadii, bool bExternal>
+void CCNTCell::UpdateForceKernel()
+{
+	mpsSimBox::GlobalCellCounter++;  // increment the counter for intra-cell force calculations
+	
+	long  localCellCellCounter = 0;
 
-#elif SimIdentifier == MD
+	for(BeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
+	{
+		CAbstractBead* const pBead1 = *iterBead1;
 
-	double magLJ;						// LJ potential variables
-	double eLJ, sLJOverR, sLJR3, sLJR6;
+		// First add interactions between beads in the current cell
 
-	double magSC;						// SC potential variables
-	double eSC, sSCOverR, sSCR3;
+		SameCellKernel<simType, bBeadRadii>(pBead1);
+
+		// Next add in interactions with beads in neighbouring cells taking the
+		// PBCs into account. The PBCs are only applied if both the current CNT 
+		// cell and the neighbouring one are external.
 
+#if SimDimension == 2
+		for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+		for( int i=0; i<13; i++ )
 #endif
+		{
+			localCellCellCounter++;  // Increment the local cell-cell inteaction counter
+
+			CCNTCell* const pNNCell = m_aIntNNCells[i];
+
+			if(bExternal && pNNCell->IsExternal())
+			{
+				pNNCell->BetweenCellsKernel<simType, bBeadRadii, true>(pBead1);
+			}
+			else
+			{
+				pNNCell->BetweenCellsKernel<simType, bBeadRadii, false>(pBead1);
+			}
+		}
+	}
+
+	// Divide the local cell-cell counter by the number of beads in this cell and add the result to the global cell-cell counter
+	
+	if(m_lBeads.size() > 0)
+	{
+	    localCellCellCounter /= m_lBeads.size();
+	}
+	else
+	{
+	    localCellCellCounter = 13;
+	}
+	
+    mpsSimBox::GlobalCellCellIntCounter += localCellCellCounter;
+}
 
+// Function to update the position and intermediate velocity of the beads 
+// from the old values for position, velocity and force. 
+// Because the BD equation of motion is quite different from those of DPD and MD,
+// it is only used in a BD simulation. The treatment of the
+// PBC's and beads moving from cell to cell is the same for all simulation types.
+// 
+// This function only changes single bead properties,i.e., 
+// the update equation for the coordinates of a bead only depend on 
+// properties of that bead at the previous timestep. However, a complication
+// arises because we loop over CNT cells and then over beads within the cells.
+// If a bead crosses a cell boundary to another cell which comes later in the
+// cell sequence it could be moved twice. We use an IsMovable flag to indicate if
+// a bead should have its position changed in this routine. If the bead crosses 
+// a cell boundary the flag is set to false, and only reset in the 
+// CSimBox::UpdateMom() routine.
+//
+// Note that we also store the old velocity and force and zero the current
+// force arrays for later use in CSimBox::UpdateForce() and CSimBox::UpdateMom().
+// This is necessary because looping over CNT cells means we cannot zero the force
+// on a bead when we are in any particular cell.
+//
+// Also note that the erase() function increments the iterator but if the bead
+// does not change cell we have to increment it by hand.
+
+void CCNTCell::UpdatePos()
+{
 //	if( m_lBeads.size() > 0 )
 //	{
-//		TraceInt2("UpdateForce: Cell No has beads with ids:", m_id, m_lBeads.size());
-//		for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
+//		TraceInt2("UpdatePos: Cell No has beads:", GetId(), CellBeadTotal());
+//		for( iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
 //		{
-//			TraceIntNoEndl((*iterBead1)->m_id);
+//			TraceIntNoEndl((*iterBead)->GetId());
+//			TraceIntNoEndl((*iterBead)->GetType());
+//			TraceIntNoEndl((*iterBead)->GetMovable());
+//			TraceDoubleNoEndl((*iterBead)->GetXPos());
+//			TraceDoubleNoEndl((*iterBead)->GetYPos());
+//			TraceDoubleNoEndl((*iterBead)->GetZPos());
+//			TraceDoubleNoEndl((*iterBead)->GetunPBCXPos());
+//			TraceDoubleNoEndl((*iterBead)->GetunPBCYPos());
+//			TraceDoubleNoEndl((*iterBead)->GetunPBCZPos());
+//			TraceDoubleNoEndl((*iterBead)->m_Mom[0]);
+//			TraceDoubleNoEndl((*iterBead)->m_Mom[1]);
+//			TraceDoubleNoEndl((*iterBead)->m_Mom[2]);
+//			TraceDoubleNoEndl((*iterBead)->m_Force[0]);
+//			TraceDoubleNoEndl((*iterBead)->m_Force[1]);
+//			TraceDoubleNoEndl((*iterBead)->m_Force[2]);
+//			TraceEndl();
 //		}
-//		Trace("");
+//		TraceEndl();
 //	}
 
-	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
-	{
-		// First add interactions between beads in the current cell. Note that
-		// we don't have to check the PBCs here and we perform a reverse loop
-		// over the neighbouring beads until the iterators are equal. Because you can't
-		// compare a forward and reverse iterator we compare the bead ids for
-		// the terminating condition.
+	// Note that absence of an increment step here. If a bead changes cells the
+	// iterator is incremented by the erase() function that removes it from 
+	// its original cell; if no change occurs we increment the iterator by hand.
+	// However, the Cray list<>::erase function does not return the next iterator
+	// so we have to provide a method for incrementing it manually.
 
-		// Zero the stress tensor for this bead. Notice that because of the
-		// way we only sum over beads distinct from the current bead in the same
-		// cell, and over beads in cells to the right and above the current cell
-		// we don't have to worry about double counting the pairwise forces. We
-		// can hence store the N(N-1)/2 contributions to the stress tensor in the
-		// beads that form the first ones accessed in the double loops.
 
-		for(short int j=0; j<9; j++)
-		{
-			(*iterBead1)->m_Stress[j] = 0.0;
-		}
+	double dx[3];
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
+	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); )
+	{
+		// Only allow bead to move if its IsMovable flag is true. This allows
+		// us to indicate when a bead has already crossed a cell boundary and
+		// should not be moved again in this timestep.
+		
+		if((*iterBead)->GetMovable())
 		{
-			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
-			dv[0] = ((*iterBead1)->m_Mom[0] - (*riterBead2)->m_Mom[0]);
-
-			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
-			dv[1] = ((*iterBead1)->m_Mom[1] - (*riterBead2)->m_Mom[1]);
+			if(GetSimIdentifier() == BD)
+			{
+				// BD simulations
+				// Store current values of position and force for later use. Note that
+				// the velocity of the Brownian particles is identically zero.
 
-#if SimDimension == 2
-			dx[2] = 0.0;
-			dv[2] = 0.0;
-#elif SimDimension == 3
-			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
-			dv[2] = ((*iterBead1)->m_Mom[2] - (*riterBead2)->m_Mom[2]);
-#endif
+				(*iterBead)->m_oldPos[0] = (*iterBead)->m_Pos[0];
+				(*iterBead)->m_oldPos[1] = (*iterBead)->m_Pos[1];
+				(*iterBead)->m_oldPos[2] = (*iterBead)->m_Pos[2];
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+				(*iterBead)->m_oldForce[0] = (*iterBead)->m_Force[0];
+				(*iterBead)->m_oldForce[1] = (*iterBead)->m_Force[1];
+				(*iterBead)->m_oldForce[2] = (*iterBead)->m_Force[2];
 
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we use the flag UseDPDBeadRadii to determine whether
-// the interaction radius is bead-specific or not. Note that when we use the
-// interaction radius we have to compare the actual distance between beads
-// not its square!
+	
+				// Update position coordinates. Generate a Gaussian-distributed
+	            // random displacement for each bead
 
-#if SimIdentifier == DPD
+				dx[0] = m_dtoverkt*(*iterBead)->m_Force[0] + m_dispmag*Gasdev();
+				dx[1] = m_dtoverkt*(*iterBead)->m_Force[1] + m_dispmag*Gasdev();
+				dx[2] = m_dtoverkt*(*iterBead)->m_Force[2] + m_dispmag*Gasdev();
 
-#ifndef UseDPDBeadRadii
-			if( dr2 < 1.0 )
-			{		
-				dr = sqrt(dr2);
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr);
-					wr2 = wr*wr;
-#else
-			dr = sqrt(dr2);
-			drmax = (*iterBead1)->GetRadius()+(*riterBead2)->GetRadius();
-			if( dr < drmax )
-			{		
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr/drmax);
-					wr2 = wr*wr;
-#endif
+//          dx[0] = m_dtoverkt*(*iterBead)->m_Force[0] + m_dispmag*GetExternalRandomNumber();
+//			dx[1] = m_dtoverkt*(*iterBead)->m_Force[1] + m_dispmag*GetExternalRandomNumber();
+//			dx[2] = m_dtoverkt*(*iterBead)->m_Force[2] + m_dispmag*GetExternalRandomNumber();
+ 
+//          dx[0] = m_dtoverkt*(*iterBead)->m_Force[0] + 0.1*m_dispmag;
+//			dx[1] = m_dtoverkt*(*iterBead)->m_Force[1] + 0.1*m_dispmag;
+//			dx[2] = m_dtoverkt*(*iterBead)->m_Force[2] + 0.1*m_dispmag;
 
-// Conservative force magnitude
+				(*iterBead)->m_Pos[0] += dx[0];
+				(*iterBead)->m_Pos[1] += dx[1];
+				(*iterBead)->m_Pos[2] += dx[2];
 
-					conForce  = m_vvConsInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr;				
-//				    conForce = 0.0;		
+//            std::cout << m_dtoverkt << "  " << m_dispmag << zEndl;
+//            std::cout << "Bead id " << (*iterBead)->GetId() << zEndl;
+//            std::cout << "cons forces " << (*iterBead)->m_Force[0] << "  " <<(*iterBead)->m_Force[1] << "  " <<(*iterBead)->m_Force[2] << zEndl; 
+//            std::cout << "old pos     " << (*iterBead)->m_oldPos[0] << "  " << (*iterBead)->m_oldPos[1] << "  " << (*iterBead)->m_oldPos[2] << zEndl; 
+//            std::cout << "dx[]        " << dx[0] << "  " << dx[1] << "  " <<dx[2] << zEndl; 
+//            std::cout << "new pos     " << (*iterBead)->GetXPos() << "  " << (*iterBead)->GetYPos() << "  " << (*iterBead)->GetZPos() << zEndl; 
 
-// Dissipative and random force magnitudes. Note dr factor in newForce calculation
+				// Update the unPBC coordinates for use in calculating bond lengths
+				// where we don't want to have to check for beads at opposite side
+				// of the simulation box.
 
-					rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-					gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr2;
+				(*iterBead)->m_unPBCPos[0] += dx[0];
+				(*iterBead)->m_unPBCPos[1] += dx[1];
+				(*iterBead)->m_unPBCPos[2] += dx[2];
 
-					dissForce	= -gammap*rdotv;				
-					randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-// Gauss RNG		randForce	= 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
+				// Store position increments for later ease of use
 
-					newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
-					newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
-					newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
+				(*iterBead)->m_dPos[0] = dx[0];
+				(*iterBead)->m_dPos[1] = dx[1];
+				(*iterBead)->m_dPos[2] = dx[2];
 
-#elif SimIdentifier == MD
+				// Zero current force on beads so that UpdateForce() just has to form
+				// a sum of all bead-bead interactions
+			
+				(*iterBead)->m_Force[0] = 0.0;
+				(*iterBead)->m_Force[1] = 0.0;
+				(*iterBead)->m_Force[2] = 0.0;
+			}
+			else
+			{
+				// DPD and MD simulations
+				// Store current values of position, velocity and force for later use
 
-			if( dr2 < m_coradius2 )
-			{		
-				dr = sqrt(dr2);
+				(*iterBead)->m_oldPos[0] = (*iterBead)->m_Pos[0];
+				(*iterBead)->m_oldPos[1] = (*iterBead)->m_Pos[1];
+				(*iterBead)->m_oldPos[2] = (*iterBead)->m_Pos[2];
 
-				if( dr > 0.000000001 )
-				{
-					// Calculate common factors in the LJ potential and include shifted force.
-					// Note that the shifted force term needs to be multiplied by the 
-					// unit vector in the bead-bead separation whereas the force term 
-					// has the full vector.
+				(*iterBead)->m_oldMom[0] = (*iterBead)->m_Mom[0];
+				(*iterBead)->m_oldMom[1] = (*iterBead)->m_Mom[1];
+				(*iterBead)->m_oldMom[2] = (*iterBead)->m_Mom[2];
 
-					eLJ		  = m_vvLJDepth.at((*iterBead1)->GetType()).at((*riterBead2)->GetType());	
-					sLJOverR  = m_vvLJRange.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())/dr;
-					sLJR3     = sLJOverR*sLJOverR*sLJOverR;
-					sLJR6     = sLJR3*sLJR3;
+				(*iterBead)->m_oldForce[0] = (*iterBead)->m_Force[0];
+				(*iterBead)->m_oldForce[1] = (*iterBead)->m_Force[1];
+				(*iterBead)->m_oldForce[2] = (*iterBead)->m_Force[2];
+	
+				// Update position coordinates
 
-					magLJ = (6.0*eLJ*sLJR6*(2.0*sLJR6 - 1.0) 
-						     - dr*m_vvLJSlope.at((*iterBead1)->GetType()).at((*riterBead2)->GetType()))/dr2;
+				dx[0] = m_dt*(*iterBead)->m_Mom[0] + m_halfdt2*(*iterBead)->m_Force[0];
+				dx[1] = m_dt*(*iterBead)->m_Mom[1] + m_halfdt2*(*iterBead)->m_Force[1];
+				dx[2] = m_dt*(*iterBead)->m_Mom[2] + m_halfdt2*(*iterBead)->m_Force[2];
 
-					// Only add the soft-core potential if the potential depth is non-zero
+				(*iterBead)->m_Pos[0] += dx[0];
+				(*iterBead)->m_Pos[1] += dx[1];
+				(*iterBead)->m_Pos[2] += dx[2];
 
-					eSC = m_vvSCDepth.at((*iterBead1)->GetType()).at((*riterBead2)->GetType());	
+				// Update the unPBC coordinates for use in calculating bond lengths
+				// where we don't want to have to check for beads at opposite side
+				// of the simulation box.
 
-					if(eSC > 0.0)
-					{
-						sSCOverR = m_vvSCRange.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())/dr;
-						sSCR3    = sSCOverR*sSCOverR*sSCOverR;
-						
-						magSC = (9.0*eSC*sSCR3*sSCR3*sSCR3
-							     - dr*m_vvSCSlope.at((*iterBead1)->GetType()).at((*riterBead2)->GetType()))/dr2;
-					}
-					else
-					{
-						magSC = 0.0;
-					}
+				(*iterBead)->m_unPBCPos[0] += dx[0];
+				(*iterBead)->m_unPBCPos[1] += dx[1];
+				(*iterBead)->m_unPBCPos[2] += dx[2];
 
-					newForce[0] = (magLJ + magSC)*dx[0];
-					newForce[1] = (magLJ + magSC)*dx[1];
-					newForce[2] = (magLJ + magSC)*dx[2];
-#endif
+				// Store position increments for later ease of use
 
-					(*iterBead1)->m_ForceCounter++;
-					(*riterBead2)->m_ForceCounter++;
-					
-					(*iterBead1)->m_Force[0] += newForce[0];
-					(*iterBead1)->m_Force[1] += newForce[1];
-					(*iterBead1)->m_Force[2] += newForce[2];
+				(*iterBead)->m_dPos[0] = dx[0];
+				(*iterBead)->m_dPos[1] = dx[1];
+				(*iterBead)->m_dPos[2] = dx[2];
 
-					(*riterBead2)->m_Force[0] -= newForce[0];
-					(*riterBead2)->m_Force[1] -= newForce[1];
-					(*riterBead2)->m_Force[2] -= newForce[2];
+				// Update intermediate velocity
 
-					// stress tensor summation
+				(*iterBead)->m_Mom[0] = (*iterBead)->m_oldMom[0] + m_lamdt*(*iterBead)->m_oldForce[0];
+				(*iterBead)->m_Mom[1] = (*iterBead)->m_oldMom[1] + m_lamdt*(*iterBead)->m_oldForce[1];
+				(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + m_lamdt*(*iterBead)->m_oldForce[2];
 
-					localStress[0] = dx[0]*newForce[0];
-					localStress[1] = dx[1]*newForce[0];
-					localStress[2] = dx[2]*newForce[0];
-					localStress[3] = dx[0]*newForce[1];
-					localStress[4] = dx[1]*newForce[1];
-					localStress[5] = dx[2]*newForce[1];
-					localStress[6] = dx[0]*newForce[2];
-					localStress[7] = dx[1]*newForce[2];
-					localStress[8] = dx[2]*newForce[2];
-					
-					(*iterBead1)->m_Stress[0] += localStress[0];
-					(*iterBead1)->m_Stress[1] += localStress[1];
-					(*iterBead1)->m_Stress[2] += localStress[2];
-					(*iterBead1)->m_Stress[3] += localStress[3];
-					(*iterBead1)->m_Stress[4] += localStress[4];
-					(*iterBead1)->m_Stress[5] += localStress[5];
-					(*iterBead1)->m_Stress[6] += localStress[6];
-					(*iterBead1)->m_Stress[7] += localStress[7];
-					(*iterBead1)->m_Stress[8] += localStress[8];
+				// Zero current force on beads so that UpdateForce() just has to form
+				// a sum of all bead-bead interactions
 
-					// Pass the stress tensor components to the CMonitor
-					// for use in analysing the stress over slices.
-					// Note that dx[2] might be close to zero and we should
-					// check for this.
+				(*iterBead)->m_ForceCounter = 0;
 
-					// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce, dx);
-#endif
-
-#if EnableStressTensorSphere == SimMiscEnabled
-                    // 11/05/10 Store the bead-bead stress in curvilinear coordinates in the two cells containing the interacting pair: same-cell beads so 
-					// no other cells are involved. 
-					// 23/05/10 We double-count the stress to compensate for the case where the beads are in different cells and the stress is added to both
-					// 26/05/10 I removed the double-counting now that I have implemented the apportioning of the stress along the vector joining the two particles.
-					// 18/06/10 I changed the stress storage from CNT cells into stress grid cells that are smaller than the CNT cells.
-					
-					m_pISimBox->AddBeadStress((*iterBead1)->m_Pos, (*riterBead2)->m_Pos, localStress);
-#endif
-				}
-				else
-				{
-					TraceInt("same cell bead", (*iterBead1)->GetId());
-					TraceInt("interacts with", (*riterBead2)->GetId());
-					TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-											(*iterBead1)->GetYPos(), 
-											(*iterBead1)->GetZPos() );
-					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
-											(*riterBead2)->GetYPos(), 
-											(*riterBead2)->GetZPos() );
-					TraceDouble("Bead distance", dr);
-				}
-			}
-		}
-
-		// Next add in interactions with beads in neighbouring cells taking the
-		// PBCs into account and the presence of a wall. The PBCs are only applied
-		// if both the current CNT cell and the neighbouring one are external.
-
-#if SimDimension == 2
-		for( int i=0; i<4; i++ )
-#elif SimDimension == 3
-		for( int i=0; i<13; i++ )
-#endif
-		{
-/*		
-		    if(xxParallelBase::GlobalGetRank() == 0)
-			{
-			    if(dynamic_cast<CExternalCNTCell*>(m_aIntNNCells[i]))
-				{
-		            std::cout << "Calculating External  cell-cell forces for " << GetId() << " " << m_aIntNNCells[i]->GetId() << zEndl;
-				}
-				else
-				{
-		            std::cout << "Calculating Internal  cell-cell forces for " << GetId() << " " << m_aIntNNCells[i]->GetId() << zEndl;
-				}
-			}
-*/			
-			localCellCellCounter++;  // Increment the local cell-cell inteaction counter
-			
-			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
-			{
-				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-				dv[0] = ((*iterBead1)->m_Mom[0] - (*iterBead2)->m_Mom[0]);
-
-				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
-				dv[1] = ((*iterBead1)->m_Mom[1] - (*iterBead2)->m_Mom[1]);
-
-#if SimDimension == 2
-				dx[2] = 0.0;
-				dv[2] = 0.0;
-#elif SimDimension == 3
-				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
-				dv[2] = ((*iterBead1)->m_Mom[2] - (*iterBead2)->m_Mom[2]);
-#endif
-
-				if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
-				{
-					if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
-						dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
-					else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
-						dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
-
-					if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
-						dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
-					else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
-						dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
-
-#if SimDimension == 3
-					if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
-						dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
-					else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
-						dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
-#endif
-
-				}
-
-				dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we have to change the distance-dependence according
-// to the bead interaction radii.
-
-#if SimIdentifier == DPD
-
-#ifndef UseDPDBeadRadii
-				if( dr2 < 1.0 )
-				{		
-					dr = sqrt(dr2);
-					if( dr > 0.000000001 )
-					{
-						wr = (1.0 - dr);
-						wr2 = wr*wr;
-#else
-				dr = sqrt(dr2);
-				drmax = (*iterBead1)->GetRadius()+(*iterBead2)->GetRadius();
-				if( dr < drmax )
-				{		
-					if( dr > 0.000000001 )
-					{
-						wr = (1.0 - dr/drmax);
-						wr2 = wr*wr;
-#endif
-						conForce	= m_vvConsInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr;				
-//                        conForce = 0.0;
-
-						rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-						gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr2;
-
-						dissForce	= -gammap*rdotv;				
-						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-// Gauss RNG		    randForce	= 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
-
-						newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
-						newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
-						newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
-
-#elif SimIdentifier == MD
-
-				if( dr2 < m_coradius2 )
-				{		
-					dr = sqrt(dr2);
-
-					if( dr > 0.000000001 )
-					{
-						// Calculate common factors in the LJ potential and include shifted force.
-						// Note that the shifted force term needs to be multiplied by the 
-						// unit vector in the bead-bead separation whereas the force term 
-						// has the full vector.
-
-						eLJ       = m_vvLJDepth.at((*iterBead1)->GetType()).at((*riterBead2)->GetType());	
-						sLJOverR  = m_vvLJRange.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())/dr;
-						sLJR3     = sLJOverR*sLJOverR*sLJOverR;
-						sLJR6     = sLJR3*sLJR3;
-
-						magLJ = (6.0*eLJ*sLJR6*(2.0*sLJR6 - 1.0) 
-								 - dr*m_vvLJSlope.at((*iterBead1)->GetType()).at((*riterBead2)->GetType()))/dr2;
-
-						// Only add the soft-core potential if the potential depth is non-zero
-
-						eSC = m_vvSCDepth.at((*iterBead1)->GetType()).at((*iterBead2)->GetType());	
-
-						if(eSC > 0.0)
-						{
-							sSCOverR = m_vvSCRange.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())/dr;
-							sSCR3    = sSCOverR*sSCOverR*sSCOverR;
-
-							magSC = (9.0*eSC*sSCR3*sSCR3*sSCR3
-									 - dr*m_vvSCSlope.at((*iterBead1)->GetType()).at((*riterBead2)->GetType()))/dr2;
-						}
-						else
-						{
-							magSC = 0.0;
-						}
-
-						newForce[0] = (magLJ + magSC)*dx[0];
-						newForce[1] = (magLJ + magSC)*dx[1];
-						newForce[2] = (magLJ + magSC)*dx[2];
-#endif
-
-//                if(((*iterBead1)->GetId() == targetBeadId || (*iterBead2)->GetId() == targetBeadId))
-//				{
-//				    std::cout << "CNTCell " << GetId() << " calculating internal force with NN cell " << m_aIntNNCells[i]->GetId() << " for its beads " << (*iterBead1)->GetId() << " " << (*iterBead2)->GetId() << zEndl;
-//				}
-
-					    (*iterBead1)->m_ForceCounter++;
-					    (*iterBead2)->m_ForceCounter++;
-						
-						(*iterBead1)->m_Force[0] += newForce[0];
-						(*iterBead1)->m_Force[1] += newForce[1];
-						(*iterBead1)->m_Force[2] += newForce[2];
-
-						(*iterBead2)->m_Force[0] -= newForce[0];
-						(*iterBead2)->m_Force[1] -= newForce[1];
-						(*iterBead2)->m_Force[2] -= newForce[2];
-
-						// stress tensor summation
-
-					    localStress[0] = dx[0]*newForce[0];
-					    localStress[1] = dx[1]*newForce[0];
-					    localStress[2] = dx[2]*newForce[0];
-					    localStress[3] = dx[0]*newForce[1];
-					    localStress[4] = dx[1]*newForce[1];
-					    localStress[5] = dx[2]*newForce[1];
-					    localStress[6] = dx[0]*newForce[2];
-					    localStress[7] = dx[1]*newForce[2];
-					    localStress[8] = dx[2]*newForce[2];
-
-						(*iterBead1)->m_Stress[0] += localStress[0];
-						(*iterBead1)->m_Stress[1] += localStress[1];
-						(*iterBead1)->m_Stress[2] += localStress[2];
-						(*iterBead1)->m_Stress[3] += localStress[3];
-						(*iterBead1)->m_Stress[4] += localStress[4];
-						(*iterBead1)->m_Stress[5] += localStress[5];
-						(*iterBead1)->m_Stress[6] += localStress[6];
-						(*iterBead1)->m_Stress[7] += localStress[7];
-						(*iterBead1)->m_Stress[8] += localStress[8];
-
-						// Pass the stress tensor components to the CMonitor
-						// for use in analysing the stress over slices.
-						// Note that dx[2] might be close to zero and we should
-						// check for this.
-
-					    // 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-						m_pMonitor->AddBeadStress(*iterBead1, *iterBead2, newForce, dx);
-#endif
-
-#if EnableStressTensorSphere == SimMiscEnabled
-                    // 11/05/10 Store the bead-bead stress in curvilinear coordinates in each cell containing the interacting pair: neighbour-cell beads so 
-					// we have to add it to both cells and any intermediate cells traversed by the interaction vector.
-					// 26/05/10  I implemented the proper apportioning of the stress to each cell along the vector joining the two particles.
-					// 18/06/10  I changed the implementation of the stress calculation
-					
-					m_pISimBox->AddBeadStress((*iterBead1)->m_Pos, (*iterBead2)->m_Pos, localStress);
-#endif
-					}
-					else
-					{
-						TraceInt("neighbour cell bead", (*iterBead1)->GetId());
-						TraceInt("interacts with", (*iterBead2)->GetId());
-						TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-												(*iterBead1)->GetYPos(), 
-												(*iterBead1)->GetZPos() );
-						TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
-												(*iterBead2)->GetYPos(), 
-												(*iterBead2)->GetZPos() );
-						TraceDouble("Bead distance", dr);
-					}
-				}
-			}
-		}
-	}
-
-   // Divide the local cell-cell counter by the number of beads in this cell and add the result to the global cell-cell counter
-	
-	if(m_lBeads.size() > 0)
-	{
-	    localCellCellCounter /= m_lBeads.size();
-	}
-	else
-	{
-	    localCellCellCounter = 13;
-	}
-	
-    mpsSimBox::GlobalCellCellIntCounter += localCellCellCounter;
-
-
-#endif
-}
-
-// Function to update the position and intermediate velocity of the beads 
-// from the old values for position, velocity and force. 
-// Because the BD equation of motion is quite different from those of DPD and MD,
-// we conditionally compile it in only for a BD simulation. The treatment of the
-// PBC's and beads moving from cell to cell is the same for all simulation types.
-// 
-// This function only changes single bead properties,i.e., 
-// the update equation for the coordinates of a bead only depend on 
-// properties of that bead at the previous timestep. However, a complication
-// arises because we loop over CNT cells and then over beads within the cells.
-// If a bead crosses a cell boundary to another cell which comes later in the
-// cell sequence it could be moved twice. We use an IsMovable flag to indicate if
-// a bead should have its position changed in this routine. If the bead crosses 
-// a cell boundary the flag is set to false, and only reset in the 
-// CSimBox::UpdateMom() routine.
-//
-// Note that we also store the old velocity and force and zero the current
-// force arrays for later use in CSimBox::UpdateForce() and CSimBox::UpdateMom().
-// This is necessary because looping over CNT cells means we cannot zero the force
-// on a bead when we are in any particular cell.
-//
-// Also note that the erase() function increments the iterator but if the bead
-// does not change cell we have to increment it by hand.
-
-void CCNTCell::UpdatePos()
-{
-//	if( m_lBeads.size() > 0 )
-//	{
-//		TraceInt2("UpdatePos: Cell No has beads:", GetId(), CellBeadTotal());
-//		for( iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
-//		{
-//			TraceIntNoEndl((*iterBead)->GetId());
-//			TraceIntNoEndl((*iterBead)->GetType());
-//			TraceIntNoEndl((*iterBead)->GetMovable());
-//			TraceDoubleNoEndl((*iterBead)->GetXPos());
-//			TraceDoubleNoEndl((*iterBead)->GetYPos());
-//			TraceDoubleNoEndl((*iterBead)->GetZPos());
-//			TraceDoubleNoEndl((*iterBead)->GetunPBCXPos());
-//			TraceDoubleNoEndl((*iterBead)->GetunPBCYPos());
-//			TraceDoubleNoEndl((*iterBead)->GetunPBCZPos());
-//			TraceDoubleNoEndl((*iterBead)->m_Mom[0]);
-//			TraceDoubleNoEndl((*iterBead)->m_Mom[1]);
-//			TraceDoubleNoEndl((*iterBead)->m_Mom[2]);
-//			TraceDoubleNoEndl((*iterBead)->m_Force[0]);
-//			TraceDoubleNoEndl((*iterBead)->m_Force[1]);
-//			TraceDoubleNoEndl((*iterBead)->m_Force[2]);
-//			TraceEndl();
-//		}
-//		TraceEndl();
-//	}
-
-	// Note that absence of an increment step here. If a bead changes cells the
-	// iterator is incremented by the erase() function that removes it from 
-	// its original cell; if no change occurs we increment the iterator by hand.
-	// However, the Cray list<>::erase function does not return the next iterator
-	// so we have to provide a method for incrementing it manually.
-
-
-	double dx[3];
-
-	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); )
-	{
-		// Only allow bead to move if its IsMovable flag is true. This allows
-		// us to indicate when a bead has already crossed a cell boundary and
-		// should not be moved again in this timestep.
-		
-		if((*iterBead)->GetMovable())
-		{
-#if SimIdentifier == BD
-            // BD simulations
-			// Store current values of position and force for later use. Note that
-            // the velocity of the Brownian particles is identically zero.
-
-			(*iterBead)->m_oldPos[0] = (*iterBead)->m_Pos[0];
-			(*iterBead)->m_oldPos[1] = (*iterBead)->m_Pos[1];
-			(*iterBead)->m_oldPos[2] = (*iterBead)->m_Pos[2];
-
-			(*iterBead)->m_oldForce[0] = (*iterBead)->m_Force[0];
-			(*iterBead)->m_oldForce[1] = (*iterBead)->m_Force[1];
-			(*iterBead)->m_oldForce[2] = (*iterBead)->m_Force[2];
-
-	
-			// Update position coordinates. Generate a Gaussian-distributed
-            // random displacement for each bead
-
-			dx[0] = m_dtoverkt*(*iterBead)->m_Force[0] + m_dispmag*Gasdev();
-			dx[1] = m_dtoverkt*(*iterBead)->m_Force[1] + m_dispmag*Gasdev();
-			dx[2] = m_dtoverkt*(*iterBead)->m_Force[2] + m_dispmag*Gasdev();
-
-//          dx[0] = m_dtoverkt*(*iterBead)->m_Force[0] + m_dispmag*GetExternalRandomNumber();
-//			dx[1] = m_dtoverkt*(*iterBead)->m_Force[1] + m_dispmag*GetExternalRandomNumber();
-//			dx[2] = m_dtoverkt*(*iterBead)->m_Force[2] + m_dispmag*GetExternalRandomNumber();
- 
-//          dx[0] = m_dtoverkt*(*iterBead)->m_Force[0] + 0.1*m_dispmag;
-//			dx[1] = m_dtoverkt*(*iterBead)->m_Force[1] + 0.1*m_dispmag;
-//			dx[2] = m_dtoverkt*(*iterBead)->m_Force[2] + 0.1*m_dispmag;
-
-			(*iterBead)->m_Pos[0] += dx[0];
-			(*iterBead)->m_Pos[1] += dx[1];
-			(*iterBead)->m_Pos[2] += dx[2];
-
-//            std::cout << m_dtoverkt << "  " << m_dispmag << zEndl;
-//            std::cout << "Bead id " << (*iterBead)->GetId() << zEndl;
-//            std::cout << "cons forces " << (*iterBead)->m_Force[0] << "  " <<(*iterBead)->m_Force[1] << "  " <<(*iterBead)->m_Force[2] << zEndl; 
-//            std::cout << "old pos     " << (*iterBead)->m_oldPos[0] << "  " << (*iterBead)->m_oldPos[1] << "  " << (*iterBead)->m_oldPos[2] << zEndl; 
-//            std::cout << "dx[]        " << dx[0] << "  " << dx[1] << "  " <<dx[2] << zEndl; 
-//            std::cout << "new pos     " << (*iterBead)->GetXPos() << "  " << (*iterBead)->GetYPos() << "  " << (*iterBead)->GetZPos() << zEndl; 
-
-			// Update the unPBC coordinates for use in calculating bond lengths
-			// where we don't want to have to check for beads at opposite side
-			// of the simulation box.
-
-			(*iterBead)->m_unPBCPos[0] += dx[0];
-			(*iterBead)->m_unPBCPos[1] += dx[1];
-			(*iterBead)->m_unPBCPos[2] += dx[2];
-
-			// Store position increments for later ease of use
-
-			(*iterBead)->m_dPos[0] = dx[0];
-			(*iterBead)->m_dPos[1] = dx[1];
-			(*iterBead)->m_dPos[2] = dx[2];
-
-			// Zero current force on beads so that UpdateForce() just has to form
-			// a sum of all bead-bead interactions
-			
-			(*iterBead)->m_Force[0] = 0.0;
-			(*iterBead)->m_Force[1] = 0.0;
-			(*iterBead)->m_Force[2] = 0.0;
-
-#else
-            // DPD and MD simulations
-			// Store current values of position, velocity and force for later use
-
-			(*iterBead)->m_oldPos[0] = (*iterBead)->m_Pos[0];
-			(*iterBead)->m_oldPos[1] = (*iterBead)->m_Pos[1];
-			(*iterBead)->m_oldPos[2] = (*iterBead)->m_Pos[2];
-
-			(*iterBead)->m_oldMom[0] = (*iterBead)->m_Mom[0];
-			(*iterBead)->m_oldMom[1] = (*iterBead)->m_Mom[1];
-			(*iterBead)->m_oldMom[2] = (*iterBead)->m_Mom[2];
-
-			(*iterBead)->m_oldForce[0] = (*iterBead)->m_Force[0];
-			(*iterBead)->m_oldForce[1] = (*iterBead)->m_Force[1];
-			(*iterBead)->m_oldForce[2] = (*iterBead)->m_Force[2];
-	
-			// Update position coordinates
-
-			dx[0] = m_dt*(*iterBead)->m_Mom[0] + m_halfdt2*(*iterBead)->m_Force[0];
-			dx[1] = m_dt*(*iterBead)->m_Mom[1] + m_halfdt2*(*iterBead)->m_Force[1];
-			dx[2] = m_dt*(*iterBead)->m_Mom[2] + m_halfdt2*(*iterBead)->m_Force[2];
-
-			(*iterBead)->m_Pos[0] += dx[0];
-			(*iterBead)->m_Pos[1] += dx[1];
-			(*iterBead)->m_Pos[2] += dx[2];
-
-			// Update the unPBC coordinates for use in calculating bond lengths
-			// where we don't want to have to check for beads at opposite side
-			// of the simulation box.
-
-			(*iterBead)->m_unPBCPos[0] += dx[0];
-			(*iterBead)->m_unPBCPos[1] += dx[1];
-			(*iterBead)->m_unPBCPos[2] += dx[2];
-
-			// Store position increments for later ease of use
-
-			(*iterBead)->m_dPos[0] = dx[0];
-			(*iterBead)->m_dPos[1] = dx[1];
-			(*iterBead)->m_dPos[2] = dx[2];
-
-			// Update intermediate velocity
-
-			(*iterBead)->m_Mom[0] = (*iterBead)->m_oldMom[0] + m_lamdt*(*iterBead)->m_oldForce[0];
-			(*iterBead)->m_Mom[1] = (*iterBead)->m_oldMom[1] + m_lamdt*(*iterBead)->m_oldForce[1];
-			(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + m_lamdt*(*iterBead)->m_oldForce[2];
-
-			// Zero current force on beads so that UpdateForce() just has to form
-			// a sum of all bead-bead interactions
-
-			(*iterBead)->m_ForceCounter = 0;
-
-			(*iterBead)->m_Force[0] = 0.0;
-			(*iterBead)->m_Force[1] = 0.0;
-			(*iterBead)->m_Force[2] = 0.0;
-#endif
+				(*iterBead)->m_Force[0] = 0.0;
+				(*iterBead)->m_Force[1] = 0.0;
+				(*iterBead)->m_Force[2] = 0.0;
+			}
 
 // **********************************************************************
 // Check to see if the a bead moves from the current CNT cell to a 
@@ -2202,1164 +1999,820 @@ void CCNTCell::UpdatePos()
 						m_aNNCells[10]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
 					}
-#elif SimDimension == 2
-					if(m_bExternal && m_aNNCells[1]->IsExternal())
-					{
-						if( (*iterBead)->m_Pos[1] < 0.0 )
-							(*iterBead)->m_Pos[1]+= m_SimBoxYLength;
-					}
-					(*iterBead)->SetNotMovable();
-					m_aNNCells[1]->m_lBeads.push_front((*iterBead));
-						iterBead = m_lBeads.erase(iterBead);
-#endif
-				}
-				else	// no change in X, Y directions
-				{
-#if SimDimension == 3
-					if( (*iterBead)->m_Pos[2] > m_TRCoord[2] )	// bead moves U
-					{
-						if(m_bExternal && m_aNNCells[22]->IsExternal())
-						{
-							if( (*iterBead)->m_Pos[2] > m_SimBoxZLength )
-								(*iterBead)->m_Pos[2]-= m_SimBoxZLength;
-						}
-						(*iterBead)->SetNotMovable();
-						m_aNNCells[22]->m_lBeads.push_front((*iterBead));
-						iterBead = m_lBeads.erase(iterBead);
-					}
-					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves D
-					{
-						if(m_bExternal && m_aNNCells[4]->IsExternal())
-						{
-							if( (*iterBead)->m_Pos[2] < 0.0 )
-								(*iterBead)->m_Pos[2]+= m_SimBoxZLength;
-						}
-						(*iterBead)->SetNotMovable();
-						m_aNNCells[4]->m_lBeads.push_front((*iterBead));
-						iterBead = m_lBeads.erase(iterBead);
-					}
-					else
-					{
-						// If the bead did not change cells increment the
-						// iterator by hand.
-						
-						(*iterBead)->SetNotMovable();
-						iterBead++;	
-					}
-#elif SimDimension == 2
-					(*iterBead)->SetNotMovable();
-					iterBead++;
-#endif
-				}
-			}
-		}
-		else
-		{
-			iterBead++;	// if the bead is not movable increment the iterator
-		}
-// **********************************************************************
-	}
-}
-
-// Function to update the velocity of the beads using the old
-// velocity and the old and new values for the force. Note that this
-// function replaces the intermediate velocity (which is stored in
-// m_Mom[]) with the new value. The intermediate value is only needed
-// in the force calculation done in UpdateForce(). 
-//
-// This routine tells all beads derived from CAbstractBead to reset their 
-// movable flag using a virtual function that allows each derived class to 
-// override it. The CWallBead class, for example, ignores the setting because
-// wall beads cannot move. Beads that have been frozen also ignore the command
-// because the CBead::SetMovable() function takes the state of the m_bIsFrozen
-// flag into account when checking if a bead is movable.
-//
-// The angular momentum of the beads is also stored to check that it vanishes
-// on the average throughout the simulation.
-
-void CCNTCell::UpdateMom()
-{
-	for( BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++ )
-	{
-// Conditionally compile out the update of the momenta for those simulation types
-// that do not use them; but make sure the beads' SetMovable() function is called.
-
-#if SimIdentifier == BD
-        (*iterBead)->SetMovable();
-#else
-		if((*iterBead)->SetMovable())	// flag ignored by immovable beads
-		{
-			(*iterBead)->m_Mom[0] = (*iterBead)->m_oldMom[0] + 
-									 m_halfdt*((*iterBead)->m_Force[0] + (*iterBead)->m_oldForce[0]);
-			(*iterBead)->m_Mom[1] = (*iterBead)->m_oldMom[1] + 
-									 m_halfdt*((*iterBead)->m_Force[1] + (*iterBead)->m_oldForce[1]);
-			(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + 
-									 m_halfdt*((*iterBead)->m_Force[2] + (*iterBead)->m_oldForce[2]);		
-
-			(*iterBead)->m_AngMom[0]	= (*iterBead)->m_Pos[1]*(*iterBead)->m_Mom[2] - 
-										  (*iterBead)->m_Pos[2]*(*iterBead)->m_Mom[1];
-
-			(*iterBead)->m_AngMom[1]	= -(*iterBead)->m_Pos[0]*(*iterBead)->m_Mom[2] + 
-										   (*iterBead)->m_Pos[2]*(*iterBead)->m_Mom[0];
-
-			(*iterBead)->m_AngMom[2]	= (*iterBead)->m_Pos[0]*(*iterBead)->m_Mom[1] - 
-										  (*iterBead)->m_Pos[1]*(*iterBead)->m_Mom[0];
-		}
-#endif
-	}
-}
-
-// Function to map the index of a nearest-neighbour cell to a pointer
-// to the cell. Notice that the current cell is one of the possible 
-// values.
-//
-void CCNTCell::SetNNCellIndex(long index, CCNTCell *pCell)
-{
-
-#if SimDimension == 2
-	if( index >=0 && index < 9 )
-#elif SimDimension == 3
-	if( index >= 0 && index < 27 )
-#endif
-	{
-// map cell index to cell pointer using an array
-		m_aNNCells[index] = pCell;
-// map cell index to cell pointer using STL
-//		m_mNNCells.insert( make_pair(index, pCell) );
-	}
-	else
-	{
-		TraceInt("ERROR: Illegal index for NN cell mapping", index );
-	}
-
-}
-
-// Function to add a bead to the current cell.
-
-void CCNTCell::AddBeadtoCell(CAbstractBead *pBead)
-{
-	m_lBeads.push_front(pBead);
-}
-
-// Function to remove a bead from the current cell.
-
-void CCNTCell::RemoveBeadFromCell(CAbstractBead* const pBead)
-{
-	m_lBeads.remove(pBead);
-}
-
-// Function to remove all beads from the current cell. Note that this does NOT
-// delete the beads, it only removes their pointers from the cell.
-
-void CCNTCell::RemoveAllBeadsFromCell()
-{
-	m_lBeads.clear();
-}
-
-long CCNTCell::CellBeadTotal() const
-{
-	return m_lBeads.size();
-}
-
-// Function to store a pointer to a nearest-neighbour cell used in 
-// calculating the interactions between beads. Because the forces are
-// all pairwise we only have to loop over bead pairs once. Hence we store
-// pointers to those cells that are to the right of, or above the current cell.
-
-
-void CCNTCell::SetIntNNCellIndex( long index, CCNTCell* pCell )
-{
-
-#if SimDimension == 2
-	if( index >=0 && index < 4 )
-#elif SimDimension == 3
-	if( index >= 0 && index < 13 )
-#endif
-	{
-// map cell index to cell pointer using an array
-		m_aIntNNCells[index] = pCell;
-	}
-	else
-	{
-		TraceInt("ERROR: Illegal index for NN cell mapping", index );
-	}
-
-}
-
-// Function to return random number from a uniform generator. Note that 
-// Randf() alters some static variables inside itself. Also this is only 
-// used by other objects not within the main simulation loop. It is provided 
-// to avoid the calling routine from having to pass in a seed.
-
-double CCNTCell::GetRandomNo()
-{
-	return CCNTCell::Randf();
-}
-
-// Function to return an exponentially-distributed random number.
-
-double CCNTCell::GetExponentialRandomNo()
-{
-	return CCNTCell::Expdev();
-}
-
-// Function to return a Gaussian-distributed random number.
-
-double CCNTCell::GetGaussRandomNo()
-{
-    return CCNTCell::Gasdev();
-}
-
-// Private helper function to return a "random" number that is read in from 
-// an external file. This is useful for testing the integration scheme by 
-// forcing it to use a pre-defined sequence of numbers. The numbers are read in 
-// using the CRandomNumberSequence class that handles all the file IO. 
-// The numbers are stored in the containing instance for later use.
-
-double CCNTCell::GetExternalRandomNumber()
-{
-    // Ensure the numbers are only read in once
-    if(m_bReadFileOnce)
-    {
-        m_bReadFileOnce = false;
-        m_RandomNumbers.clear();
-
-        CRandomNumberSequence file("RandomNumbers500.txt", 500);
-        file.Serialize();
-
-        for(long i=0; i<file.GetActualSequenceSize(); i++)
-        {
-            m_RandomNumbers.push_back(file.GetNextNumber());
-        }
-     }
-
-    double x = 0.0;
-
-    if(m_NextRNIndex == static_cast<long>(m_RandomNumbers.size()))
-    {
-        m_NextRNIndex = 0;  // If we run out of numbers re-use the set.
-    }
-
-    x = m_RandomNumbers.at(m_NextRNIndex++);
-
-//    std::cout << "random number = " << x << zEndl;
-
-    return x;
-
-}
-
+#elif SimDimension == 2
+					if(m_bExternal && m_aNNCells[1]->IsExternal())
+					{
+						if( (*iterBead)->m_Pos[1] < 0.0 )
+							(*iterBead)->m_Pos[1]+= m_SimBoxYLength;
+					}
+					(*iterBead)->SetNotMovable();
+					m_aNNCells[1]->m_lBeads.push_front((*iterBead));
+						iterBead = m_lBeads.erase(iterBead);
+#endif
+				}
+				else	// no change in X, Y directions
+				{
+#if SimDimension == 3
+					if( (*iterBead)->m_Pos[2] > m_TRCoord[2] )	// bead moves U
+					{
+						if(m_bExternal && m_aNNCells[22]->IsExternal())
+						{
+							if( (*iterBead)->m_Pos[2] > m_SimBoxZLength )
+								(*iterBead)->m_Pos[2]-= m_SimBoxZLength;
+						}
+						(*iterBead)->SetNotMovable();
+						m_aNNCells[22]->m_lBeads.push_front((*iterBead));
+						iterBead = m_lBeads.erase(iterBead);
+					}
+					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves D
+					{
+						if(m_bExternal && m_aNNCells[4]->IsExternal())
+						{
+							if( (*iterBead)->m_Pos[2] < 0.0 )
+								(*iterBead)->m_Pos[2]+= m_SimBoxZLength;
+						}
+						(*iterBead)->SetNotMovable();
+						m_aNNCells[4]->m_lBeads.push_front((*iterBead));
+						iterBead = m_lBeads.erase(iterBead);
+					}
+					else
+					{
+						// If the bead did not change cells increment the
+						// iterator by hand.
+						
+						(*iterBead)->SetNotMovable();
+						iterBead++;	
+					}
+#elif SimDimension == 2
+					(*iterBead)->SetNotMovable();
+					iterBead++;
+#endif
+				}
+			}
+		}
+		else
+		{
+			iterBead++;	// if the bead is not movable increment the iterator
+		}
 // **********************************************************************
-// Random number generator using a 64-bit lcg.
-                                                
-double CCNTCell::Randf()
-{
-    return static_cast<double>(CCNTCell::lcg(CCNTCell::m_RNGSeed))*CCNTCell::m_Inv2Power32;
-}
-
-// Private static helper function for the lcg RNG
-
-uint32_t CCNTCell::lcg(uint64_t &state)
-{
-    state=6364136223846793005ull * state + 1;
-    return state>>32; // Return the top bits, as they are the best
-}
-                                
-// Gaussian random number generator.
-// It returns a normally distributed deviate with zero mean and unit variance, using Randf
-// as the source of uniform deviates.
-
-double CCNTCell::Gasdev()
-{
-    double v1, v2, s, ss;
-    
-    do{
-        v1 = 2.0*CCNTCell::Randf() - 1.0;
-        v2 = 2.0*CCNTCell::Randf() - 1.0;
-        s = v1*v1 + v2*v2;
-       } while (s >= 1.0 || s == 0.0);
-    
-    ss = sqrt(-2.0*log(s)/s);
-    
-    return v1*ss;
-}
-
-// Exponentially-distributed random number generator.
-// It returns a value, y, that is distributed according to exp(-y) and has
-// unit mean. It uses Randf() to supply a uniformly-distributed random number.
-
-double CCNTCell::Expdev()
-{
-    double value;
-
-    do{
-        value = CCNTCell::Randf();
-    } while (value == 0.0);
-
-    return -log(value);
-}
-
-// Static member function to return a randomly-generated string. We provide 
-// several overloads for this function that return strings of various types.
-// If any of the required sub-strings are empty (ie, a blank space), a random
-// string is generated to fill them. In this way, a completely random string
-// can be created.
-//
-// Sample string containing 8 digits:  12345678
-
-const zString CCNTCell::GetRandomString()
-{
-    double rfloat = CCNTCell::GetRandomNo();
-
-    while(rfloat < 0.00000001)
-    {
-        rfloat = CCNTCell::GetRandomNo();
-    }
-
-    const zString rstring =  IGlobalSimBox::Instance()->ToString(static_cast<long>(1.e+08*rfloat));
-
-    return rstring;
-}
-
-// String that has a user-defined prefix and a suffix separated by a user-defined
-// separator character. If the prefix is empty or contains only spaces, we 
-// generate a random string of letters (taken from m_AlphabetChars), and 
-// if the separator contains only spaces we use the character specified 
-// in the static member m_StringSeparator. But we allow the separator to be empty 
-// as this just concatenates the prefix with the randomly-generated string.
-//
-// A sample string returned by this function is:
-//
-// Bead-12345678 where "Bead" is the prefix and "-" is the separator.
-
-const zString CCNTCell::GetRandomString(const zString prefix, const zString separator)
-{
-    zString actualSeparator;
-
-    if(separator.find_first_of(" ") < separator.length())
-    {
-        actualSeparator = CCNTCell::m_StringSeparator;
-    }
-    else
-    {
-        actualSeparator = separator;
-    }
-
-    zString actualPrefix;
-
-    if(prefix.empty() || prefix.find_first_of(" ") < prefix.length())
-    {
-        actualPrefix = GetRandomAlphabeticString(CCNTCell::m_StringSize);
-    }
-    else
-    {
-        actualPrefix = prefix;
-    }
-
-    const zString rstring = actualPrefix + actualSeparator + GetRandomString();
-
-    return rstring;
-}
-
-// String that has a user-defined prefix and an integer counter, and returns
-// a random string of the form:
-//
-// e.g., Bead-12345678-1 where "-" is the separator and "1" is the counter
-//
-// Note that if  the prefix is empty, a random string is generated by the
-// GetRandomString() overload above, but we have to check that the separator is
-// not blank here as well as we use it explicitly.
-
-const zString CCNTCell::GetRandomString(const zString prefix, const zString separator, long counter)
-{
-    zString actualSeparator;
-
-    if(separator.find_first_of(" ") < separator.length())
-    {
-        actualSeparator = CCNTCell::m_StringSeparator;
-    }
-    else
-    {
-        actualSeparator = separator;
-    }
-
-    
-    const zString rstring = GetRandomString(prefix, separator) + separator + IGlobalSimBox::Instance()->ToString(counter);
-    return rstring;
+	}
 }
 
-// Static member function to return a random alphabetic string. This can be used
-// to construct names for bead and polymer types which must begin with a letter.
-// We just generate a random integer between 1 and 52 and return the corresponding
-// upper or lowercase letter.
-// The argument is the number of characters in the string; if this is zero,
-// we use the number stored in the static member m_StringSize.
+// Function to apply the thermostat of a split DPD integration scheme to the
+// beads in this cell. It visits the same pairs as UpdateForce(): the beads 
+// within the cell and those in the cell's 13 half-shell neighbours, taking
+// the PBCs into account. Each interacting pair's velocities are updated in
+// turn, so later pairs see the velocities left by earlier ones, and the cells
+// must be visited sequentially. CSimBox::Evolve() calls this for all cells 
+// before UpdatePos() when a split scheme has been selected using 
+// SetDPDIntegrator().
 
-const zString CCNTCell::GetRandomAlphabeticString(long size)
+void CCNTCell::UpdateThermostat()
 {
-    if(size < 1)
-    {
-        size = CCNTCell::m_StringSize;
-    }
-
-    zString rstring = "";
-
-    const long charSet = m_AlphabetChars.size();
-
-    for(long i=0; i<size; ++i)
-    {
-        double rfloat = GetRandomNo();
-        long index = static_cast<long>(1.e+08*rfloat) % charSet;
-
-        while(index < 0 || index >= charSet)
-        {
-            rfloat = GetRandomNo();
-            index = static_cast<long>(1.e+08*rfloat) % charSet;
-        }
-        
-        rstring += m_AlphabetChars.at(index);
-    }
+	if(GetSimIdentifier() == DPD)
+	{
+		// The Shardlow scheme needs the magnitude of the random impulse, sqrt(24*kT*dt),
+		// for the uniform random numbers used in UpdateForce(); the Lowe-Andersen
+		// scheme needs the thermal velocity sqrt(kT) of a unit-mass bead.
 
-    return rstring;
-}
+		const double noise = (m_DPDIntegrator == DPDShardlow) ? sqrt(24.0*m_kT*m_dt) : sqrt(m_kT);
 
-// Function to check that all the beads in the current CNTCell have coordinates
-// within the cell's boundaries.
+		BeadListIterator iterBead1;
+		BeadListIterator iterBead2;
 
-bool CCNTCell::CheckBeadsinCell()
-{
-	bool bBeadsFound = true;
+		double dx[3];
 
-	long index1, ix, iy, iz;
+		for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+		{
+			iterBead2 = iterBead1;
 
-	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
-	{
-		ix = static_cast<long>((*iterBead)->GetXPos()/m_CNTXCellWidth);
-		iy = static_cast<long>((*iterBead)->GetYPos()/m_CNTYCellWidth);
+			for( ++iterBead2; iterBead2!=m_lBeads.end(); iterBead2++ )
+			{
+				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
+				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
 
 #if SimDimension == 2
-		iz = 0;
+				dx[2] = 0.0;
 #elif SimDimension == 3
-		iz = static_cast<long>((*iterBead)->GetZPos()/m_CNTZCellWidth);		
+				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
 #endif
 
-		index1 = m_CNTXCellNo*(m_CNTYCellNo*iz+iy) + ix;
-
-		if(index1 != GetId())
-		{
-			bBeadsFound = false;
-
-			CAbstractBead* pBead = (*iterBead);
+				ThermostatPair(*iterBead1, *iterBead2, dx, noise);
+			}
 
-			// Post a warning message about the error. but only write to the screen
-			// during debug. Note that the time returned by the Monitor may be incorrect
-			// if the SamplePeriod is not 1, but it will be out by at most SamplePeriod.
-			// This is because the Monitor only updates its current time when the
-			// data is sampled.
+#if SimDimension == 2
+			for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+			for( int i=0; i<13; i++ )
+#endif
+			{
+				for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
+				{
+					dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
+					dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
 
-			new CLogCNTBeadError(m_pMonitor->GetCurrentTime(), 
-														  ix, iy, iz, index1, GetId(), pBead);
+#if SimDimension == 2
+					dx[2] = 0.0;
+#elif SimDimension == 3
+					dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
+#endif
 
-#ifdef TraceOn
-			TraceInt2(  "Cell has beads", GetId(), m_lBeads.size());
-			TraceInt2(  "  Bead has false cell index", (*iterBead)->GetId(), index1);
-			TraceInt3(  "  Cell BL index",  m_BLIndex[0], m_BLIndex[1], m_BLIndex[2]);
-			TraceVector("  Cell BL coords", m_BLCoord[0], m_BLCoord[1], m_BLCoord[2]);
-			TraceVector("  Cell TR coords", m_TRCoord[0], m_TRCoord[1], m_TRCoord[2]);
-			TraceVector("  Bead coords", (*iterBead)->GetXPos(), (*iterBead)->GetYPos(), (*iterBead)->GetZPos());
+					if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
+					{
+						if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+							dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+						else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+							dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
 
-			for(BeadListIterator iterBead2=m_lBeads.begin(); iterBead2!=m_lBeads.end(); iterBead2++)
-			{
-				TraceInt("Bead", (*iterBead2)->GetId());
-				TraceVector("  Pos",      (*iterBead2)->GetXPos(), (*iterBead2)->GetYPos(), (*iterBead2)->GetZPos());
-				TraceVector("  old Pos",  (*iterBead2)->m_oldPos[0], (*iterBead2)->m_oldPos[1], (*iterBead2)->m_oldPos[2]);
-				TraceVector("  Vel",      (*iterBead2)->GetXMom(), (*iterBead2)->GetYMom(), (*iterBead2)->GetZMom());
-				TraceVector("  old Vel",  (*iterBead2)->m_oldMom[0], (*iterBead2)->m_oldMom[1], (*iterBead2)->m_oldMom[2]);
-				TraceVector("  Force",    (*iterBead2)->m_Force[0], (*iterBead2)->m_Force[1], (*iterBead2)->m_Force[2]);
-				TraceVector("  old Force",(*iterBead2)->m_oldForce[0], (*iterBead2)->m_oldForce[1], (*iterBead2)->m_oldForce[2]);
+						if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+							dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+						else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+							dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
 
-//				Trace("its NNCells are:");
-//				for(long ic=0; ic<27; ic++)
-//				{
-//					TraceInt2("", ic, m_aNNCells[ic]->GetId()); 
-//				}
-				Trace("**********");
-			}
+#if SimDimension == 3
+						if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+							dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+						else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+							dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
 #endif
+					}
 
+					ThermostatPair(*iterBead1, *iterBead2, dx, noise);
+				}
+			}
 		}
 	}
-
-	return bBeadsFound;
 }
 
-// Function to return the potential energy of a bead interacting with all the
-// beads in the current cell and its neighbours. The bead itself must NOT be in 
-// the cell's bead list as this will lead to self-interactions. The calling 
-// routine must ensure that it is removed prior to calling this function. It 
-// should also only be called in an MD simulation because it uses the LJ and 
-// soft-core potential parameters,
+// Private helper function to update the velocities of a pair of beads with
+// the thermostat of the current split integration scheme. The pair's range
+// and weight function are those of UpdateForce(), and the range is selected
+// by the same flag as the CCNTCellBeadStore's force kernel. Wall beads and frozen beads
+// do not move, so they are treated as infinitely massive: the whole of the 
+// pair's impulse goes to the other bead.
 //
-// We use a method similar to the UpdateForce() algorithm to add the interactions
-// that are within range of the potentials, but we calculate the PE not the force.
-// The potentials are assumed to depend only on the current positions of the 
-// particles.
+// Shardlow:       the dissipative and random impulses over the time step
+//                 are applied as an explicit half step followed by an 
+//                 implicit half step, using the same random number for both.
+//
+// Lowe-Andersen:  with probability gamma*dt, the component of the pair's 
+//                 relative velocity along their separation is replaced by 
+//                 a Gaussian random number with variance kT/mu, where mu 
+//                 is the pair's reduced mass.
 
-double CCNTCell::GetPotentialEnergy(CAbstractBead *pBead) const
+void CCNTCell::ThermostatPair(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3], double noise)
 {
-	double totalPE = 0.0;
+	const double dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+	const double dr  = sqrt(dr2);
 
-#if SimIdentifier == MD
+	const double drmax = m_bBeadRadii ? pBead1->GetRadius() + pBead2->GetRadius() : 1.0;
 
-	double dx[3];
-	double dr, dr2;
+	if( dr >= drmax || dr <= 0.000000001 )
+		return;
 
-	double magLJ;						// LJ potential variables
-	double eLJ, sLJOverR, sLJR3, sLJR6;
+	const double wr = (1.0 - dr/drmax);
 
-	double magSC;						// SC potential variables
-	double eSC, sSCOverR, sSCR3;
+	const double invMass1 = pBead1->GetMovable() ? 1.0 : 0.0;
+	const double invMass2 = pBead2->GetMovable() ? 1.0 : 0.0;
+	const double invMassSum = invMass1 + invMass2;
 
-	for(cBeadListIterator iterBead2=m_lBeads.begin(); iterBead2!=m_lBeads.end(); iterBead2++)
-	{
-		dx[0] = pBead->m_Pos[0] - (*iterBead2)->m_Pos[0];
-		dx[1] = pBead->m_Pos[1] - (*iterBead2)->m_Pos[1];
+	if(invMassSum == 0.0)
+		return;
 
-#if SimDimension == 2
-		dx[2] = 0.0;
-#elif SimDimension == 3
-		dx[2] = pBead->m_Pos[2] - (*iterBead2)->m_Pos[2];
-#endif
+	const double gamma = m_vvSplitDissInt.at(pBead1->GetType()).at(pBead2->GetType());
 
-		dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+	double e[3], impulse;
 
-		if( dr2 < m_coradius2 )
-		{		
-			dr = sqrt(dr2);
+	e[0] = dx[0]/dr;
+	e[1] = dx[1]/dr;
+	e[2] = dx[2]/dr;
 
-			if( dr > 0.000000001 )
-			{
-				// Calculate common factors in the LJ potential
+	double rdotv = e[0]*(pBead1->m_Mom[0] - pBead2->m_Mom[0]) + 
+				   e[1]*(pBead1->m_Mom[1] - pBead2->m_Mom[1]) + 
+				   e[2]*(pBead1->m_Mom[2] - pBead2->m_Mom[2]);
 
-				eLJ       = m_vvLJDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
-				sLJOverR  = m_vvLJRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
-				sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
-				sLJR6	  = sLJR3*sLJR3;
-				magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
+	if(m_DPDIntegrator == DPDShardlow)
+	{
+		const double halfgdt  = 0.5*gamma*wr*wr*m_dt;
+		const double halfrand = 0.5*sqrt(gamma)*wr*noise*(0.5 - CCNTCell::Randf());
 
-				// Note that the cutoff radius has to be scaled by the first LJ potential
-				// range as well as the other terms.
+		impulse = halfrand - halfgdt*rdotv;
 
-					double mype = (magLJ - m_vvLJDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
-									  + m_vvLJSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+		for(short int i=0; i<3; i++)
+		{
+			pBead1->m_Mom[i] += invMass1*impulse*e[i];
+			pBead2->m_Mom[i] -= invMass2*impulse*e[i];
+		}
 
-				totalPE += (magLJ - m_vvLJDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
-					              + m_vvLJSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+		rdotv  += invMassSum*impulse;
+		impulse = (halfrand - halfgdt*rdotv)/(1.0 + halfgdt*invMassSum);
+	}
+	else
+	{
+		if(CCNTCell::Randf() >= gamma*m_dt)
+			return;
 
-				// Only add the soft-core potential if the potential depth is non-zero
+		impulse = (noise*sqrt(invMassSum)*CCNTCell::Gasdev() - rdotv)/invMassSum;
+	}
 
-				eSC = m_vvSCDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
+	for(short int i=0; i<3; i++)
+	{
+		pBead1->m_Mom[i] += invMass1*impulse*e[i];
+		pBead2->m_Mom[i] -= invMass2*impulse*e[i];
+	}
+}
 
-				if(eSC > 0.0)
-				{
-					sSCOverR  = m_vvSCRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
-					sSCR3     = sSCOverR*sSCOverR*sSCOverR;
-					magSC     = eSC*sSCR3*sSCR3*sSCR3;
+// Function to update the velocity of the beads using the old
+// velocity and the old and new values for the force. Note that this
+// function replaces the intermediate velocity (which is stored in
+// m_Mom[]) with the new value. The intermediate value is only needed
+// in the force calculation done in UpdateForce(). 
+//
+// This routine tells all beads derived from CAbstractBead to reset their 
+// movable flag using a virtual function that allows each derived class to 
+// override it. The CWallBead class, for example, ignores the setting because
+// wall beads cannot move. Beads that have been frozen also ignore the command
+// because the CBead::SetMovable() function takes the state of the m_bIsFrozen
+// flag into account when checking if a bead is movable.
+//
+// The angular momentum of the beads is also stored to check that it vanishes
+// on the average throughout the simulation.
 
-					double myscpe = (magSC - m_vvSCDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
-									  + m_vvSCSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+void CCNTCell::UpdateMom()
+{
+	for( BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++ )
+	{
+// Skip the update of the momenta for those simulation types that do not use 
+// them; but make sure the beads' SetMovable() function is called.
 
-						
-					totalPE += (magSC - m_vvSCDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
-								  + m_vvSCSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
-				}		
-			}
-			else
+		if(GetSimIdentifier() == BD)
+		{
+			(*iterBead)->SetMovable();
+		}
+		else
+		{
+			if((*iterBead)->SetMovable())	// flag ignored by immovable beads
 			{
-				TraceInt("same cell bead", pBead->GetId());
-				TraceInt("interacts with", (*iterBead2)->GetId());
-				TraceVector("1st pos",	pBead->GetXPos(),
-										pBead->GetYPos(), 
-										pBead->GetZPos() );
-				TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
-										(*iterBead2)->GetYPos(), 
-										(*iterBead2)->GetZPos() );
-				TraceDouble("Bead distance", dr);
+				(*iterBead)->m_Mom[0] = (*iterBead)->m_oldMom[0] + 
+										 m_halfdt*((*iterBead)->m_Force[0] + (*iterBead)->m_oldForce[0]);
+				(*iterBead)->m_Mom[1] = (*iterBead)->m_oldMom[1] + 
+										 m_halfdt*((*iterBead)->m_Force[1] + (*iterBead)->m_oldForce[1]);
+				(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + 
+										 m_halfdt*((*iterBead)->m_Force[2] + (*iterBead)->m_oldForce[2]);		
 			}
 		}
 	}
+}
 
-	// Next add in interactions with beads in neighbouring cells taking the
-	// PBCs into account and the presence of a wall. The PBCs are only applied
-	// if both the current CNT cell and the neighbouring one are external.
+// Function to map the index of a nearest-neighbour cell to a pointer
+// to the cell. Notice that the current cell is one of the possible 
+// values.
+//
+void CCNTCell::SetNNCellIndex(long index, CCNTCell *pCell)
+{
 
 #if SimDimension == 2
-	for( int i=0; i<4; i++ )
+	if( index >=0 && index < 9 )
 #elif SimDimension == 3
-	for( int i=0; i<13; i++ )
+	if( index >= 0 && index < 27 )
 #endif
 	{
-		for(cBeadListIterator iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++)
-		{
-			dx[0] = pBead->m_Pos[0] - (*iterBead2)->m_Pos[0];
-			dx[1] = pBead->m_Pos[1] - (*iterBead2)->m_Pos[1];
-
-#if SimDimension == 2
-			dx[2] = 0.0;
-#elif SimDimension == 3
-			dx[2] = pBead->m_Pos[2] - (*iterBead2)->m_Pos[2];
-#endif
-
-			if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
-			{
-				if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
-					dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
-				else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
-					dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+// map cell index to cell pointer using an array
+		m_aNNCells[index] = pCell;
+// map cell index to cell pointer using STL
+//		m_mNNCells.insert( make_pair(index, pCell) );
+	}
+	else
+	{
+		TraceInt("ERROR: Illegal index for NN cell mapping", index );
+	}
 
-				if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
-					dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
-				else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
-					dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+}
 
-#if SimDimension == 3
-				if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
-					dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
-				else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
-					dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
-#endif
+// Function to add a bead to the current cell.
 
-			}
+void CCNTCell::AddBeadtoCell(CAbstractBead *pBead)
+{
+	m_lBeads.push_front(pBead);
+}
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+// Function to remove a bead from the current cell.
 
-			if( dr2 < m_coradius2 )
-			{		
-				dr = sqrt(dr2);
+void CCNTCell::RemoveBeadFromCell(CAbstractBead* const pBead)
+{
+	m_lBeads.remove(pBead);
+}
 
-				if( dr > 0.000000001 )
-				{
-					// Calculate common factors in the LJ potential
+// Function to remove all beads from the current cell. Note that this does NOT
+// delete the beads, it only removes their pointers from the cell.
 
-					eLJ       = m_vvLJDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
-					sLJOverR  = m_vvLJRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
-					sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
-					sLJR6	  = sLJR3*sLJR3;
-					magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
+void CCNTCell::RemoveAllBeadsFromCell()
+{
+	m_lBeads.clear();
+}
 
-					// Note that the cutoff radius has to be scaled by the first LJ potential
-					// range as well as the other terms.
+long CCNTCell::CellBeadTotal() const
+{
+	return m_lBeads.size();
+}
 
-					totalPE += (magLJ - m_vvLJDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
-									  + m_vvLJSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
-						
-					// Only add the soft-core potential if the potential depth is non-zero
+// Function to store a pointer to a nearest-neighbour cell used in 
+// calculating the interactions between beads. Because the forces are
+// all pairwise we only have to loop over bead pairs once. Hence we store
+// pointers to those cells that are to the right of, or above the current cell.
 
-					eSC = m_vvSCDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
 
-					if(eSC > 0.0)
-					{
-						sSCOverR  = m_vvSCRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
-						sSCR3	  = sSCOverR*sSCOverR*sSCOverR;
-						magSC	  = eSC*sSCR3*sSCR3*sSCR3;
+void CCNTCell::SetIntNNCellIndex( long index, CCNTCell* pCell )
+{
 
-						totalPE += (magSC - m_vvSCDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
-										  + m_vvSCSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
-					}
-				}
-				else
-				{
-					TraceInt("neighbour cell bead", pBead->GetId());
-					TraceInt("interacts with", (*iterBead2)->GetId());
-					TraceVector("1st pos",	pBead->GetXPos(),
-											pBead->GetYPos(), 
-											pBead->GetZPos() );
-					TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
-											(*iterBead2)->GetYPos(), 
-											(*iterBead2)->GetZPos() );
-					TraceDouble("Bead distance", dr);
-				}
-			}
-		}
+#if SimDimension == 2
+	if( index >=0 && index < 4 )
+#elif SimDimension == 3
+	if( index >= 0 && index < 13 )
+#endif
+	{
+// map cell index to cell pointer using an array
+		m_aIntNNCells[index] = pCell;
+	}
+	else
+	{
+		TraceInt("ERROR: Illegal index for NN cell mapping", index );
 	}
 
-#endif
+}
 
-	return totalPE;
+// Function to return random number from a uniform generator. Note that 
+// Randf() alters some static variables inside itself. Also this is only 
+// used by other objects not within the main simulation loop. It is provided 
+// to avoid the calling routine from having to pass in a seed.
+
+double CCNTCell::GetRandomNo()
+{
+	return CCNTCell::Randf();
 }
 
-// Function to calculate the total kinetic energy and bead-bead potential energies 
-// for all beads in a CNT cell. This involves bead pairs in the current cell and 
-// adjacent cells. Bond and bondpair potential energies are not calculated here,
-// but are calculated from within CMonitor::ZeroTotalEnergy(). Bead energy data 
-// are not stored locally but passed directly to the CMonitor class for 
-// output to the CHistoryState object. 
-//
-// The kinetic energy of beads in the current cell is obtained directly from
-// the bead momenta, and their potential energy is obtained by iterating over all
-// beads in the cell, adding their mutual interaction energies, and then over all 
-// interactions between beads in the current cell and the neighbouring cells.
-// Self-interactions of beads in the same cell are prevented by checking bead ids.
-// Double-counting of bead pairs in adjacent CNT cells is prevented by only
-// adding contributions from bead pairs in which the adjacent cell bead has an
-// id higher than the current cell bead.
-//
-// NOTE. The function CMonitor::ZeroTotalEnergy() must be called before using this 
-// routine as the energy is added to a running total in CMonitor::AddBeadEnergy().
+// Function to return an exponentially-distributed random number.
+
+double CCNTCell::GetExponentialRandomNo()
+{
+	return CCNTCell::Expdev();
+}
 
-void CCNTCell::UpdateTotalEnergy(double* const pKinetic, double* const pPotential) const
+// Function to return a Gaussian-distributed random number.
+
+double CCNTCell::GetGaussRandomNo()
 {
-#if SimIdentifier != BD
-	// Common local data
+    return CCNTCell::Gasdev();
+}
 
-	double dx[3];
-	double dr, dr2;
-	double v2;
-    double pe;
-	double kinetic;
-	double potential;
+// Private helper function to return a "random" number that is read in from 
+// an external file. This is useful for testing the integration scheme by 
+// forcing it to use a pre-defined sequence of numbers. The numbers are read in 
+// using the CRandomNumberSequence class that handles all the file IO. 
+// The numbers are stored in the containing instance for later use.
 
-	// DPD-specific local data
+double CCNTCell::GetExternalRandomNumber()
+{
+    // Ensure the numbers are only read in once
+    if(m_bReadFileOnce)
+    {
+        m_bReadFileOnce = false;
+        m_RandomNumbers.clear();
 
-#if SimIdentifier == DPD
+        CRandomNumberSequence file("RandomNumbers500.txt", 500);
+        file.Serialize();
 
-	double wr, wr2;
+        for(long i=0; i<file.GetActualSequenceSize(); i++)
+        {
+            m_RandomNumbers.push_back(file.GetNextNumber());
+        }
+     }
 
-#ifdef UseDPDBeadRadii
-	double drmax;
-#endif
+    double x = 0.0;
 
-	// MD-specific local data
+    if(m_NextRNIndex == static_cast<long>(m_RandomNumbers.size()))
+    {
+        m_NextRNIndex = 0;  // If we run out of numbers re-use the set.
+    }
 
-#elif SimIdentifier == MD
+    x = m_RandomNumbers.at(m_NextRNIndex++);
 
-	double magLJ;						// LJ potential variables
-	double eLJ, sLJOverR, sLJR3, sLJR6;
+//    std::cout << "random number = " << x << zEndl;
 
-	double magSC;						// SC potential variables
-	double eSC, sSCOverR, sSCR3;
+    return x;
 
-#endif
+}
 
-    pe        = 0.0;
-	kinetic	  = 0.0;	// Zero running totals
-	potential = 0.0;
+// **********************************************************************
+// Random number generator using a 64-bit lcg.
+                                                
+double CCNTCell::Randf()
+{
+    return static_cast<double>(CCNTCell::lcg(CCNTCell::m_RNGSeed))*CCNTCell::m_Inv2Power32;
+}
 
-	for(cBeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
-	{
-		CAbstractBead* pBead1 = *iterBead1;
-		const long beadType1 = pBead1->GetType();
+// Private static helper function for the lcg RNG
 
-		// Bead kinetic energy
+uint32_t CCNTCell::lcg(uint64_t &state)
+{
+    state=6364136223846793005ull * state + 1;
+    return state>>32; // Return the top bits, as they are the best
+}
+                                
+// Private static helper function for the counter-based RNG. This is the 
+// Philox4x32-10 block cipher of Salmon et al. (SC11, 2011): it applies 10 rounds
+// of a multiply-xor bijection to the 128-bit counter using the 64-bit key,
+// and returns four 32-bit random numbers in the counter array. The same 
+// counter and key always give the same numbers.
 
-		v2 = pBead1->m_Mom[0]*pBead1->m_Mom[0] +
-			 pBead1->m_Mom[1]*pBead1->m_Mom[1] +
-			 pBead1->m_Mom[2]*pBead1->m_Mom[2];
+void CCNTCell::philox(uint32_t counter[4], uint32_t key[2])
+{
+    const uint64_t m0 = 0xD2511F53ull;
+    const uint64_t m1 = 0xCD9E8D57ull;
 
-		kinetic += v2;
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
 
-		// Bead potential energy.
-		// First add interactions between beads in the current cell. Note that
-		// we don't have to check the PBCs here and we perform a reverse loop
-		// over the neighbouring beads until the iterators are equal. Because you can't
-		// compare a forward and reverse iterator we compare the bead ids for
-		// the terminating condition.
+    for(short int round=0; round<10; round++)
+    {
+        const uint64_t p0 = m0*counter[0];
+        const uint64_t p1 = m1*counter[2];
 
-		for(crBeadListIterator riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
-		{
-			CAbstractBead* const pBead2 = *riterBead2;
-			const long beadType2 = pBead2->GetType();
+        const uint32_t c0 = static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ k0;
+        const uint32_t c2 = static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ k1;
 
-			dx[0] = (pBead1->m_Pos[0] - pBead2->m_Pos[0]);
-			dx[1] = (pBead1->m_Pos[1] - pBead2->m_Pos[1]);
+        counter[1] = static_cast<uint32_t>(p1);
+        counter[3] = static_cast<uint32_t>(p0);
+        counter[0] = c0;
+        counter[2] = c2;
 
-#if SimDimension == 2
-			dx[2] = 0.0;
-#elif SimDimension == 3
-			dx[2] = (pBead1->m_Pos[2] - pBead2->m_Pos[2]);
-#endif
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+// Counter-based uniform random number generator. It returns a number in
+// [0,1) that depends only on the seed, the time step set by SetRNGTimeStep()
+// and the two bead ids. The ids are ordered so that the result is the same
+// for both orderings of a pair of beads. The resolution is the same as Randf().
 
-// Calculate the interactions between the two beads for each simulation type.
+double CCNTCell::GetPairRandomNo(long id1, long id2)
+{
+    return GetPairRandomNo(m_PairRNGKey, m_PairRNGStep, id1, id2);
+}
 
-#if SimIdentifier == DPD
+// Overload of the counter-based generator that takes the key and time step 
+// explicitly, for use by threads that do not own the CCNTCell static members.
 
-#ifndef UseDPDBeadRadii
-			if( dr2 < 1.0 )
-			{		
-				dr = sqrt(dr2);
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr);
-					wr2 = wr*wr;
-#else
-			dr = sqrt(dr2);
-			drmax = pBead1->GetRadius() + pBead2->GetRadius();
+double CCNTCell::GetPairRandomNo(uint64_t rngKey, uint64_t rngStep, long id1, long id2)
+{
+    uint32_t key[2]     = {static_cast<uint32_t>(rngKey), static_cast<uint32_t>(rngKey >> 32)};
+    uint32_t counter[4] = {static_cast<uint32_t>(rngStep), static_cast<uint32_t>(rngStep >> 32),
+                           static_cast<uint32_t>(id1 < id2 ? id1 : id2), static_cast<uint32_t>(id1 < id2 ? id2 : id1)};
 
-			if( dr < drmax )
-			{		
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr/drmax);
-					wr2 = drmax*wr*wr;
-#endif
+    philox(counter, key);
 
-// Conservative potential energy: note the difference from the force calculation
-// in that wr2 includes the sum of the bead radii if the UseDPDBeadRadii flag is set.
+    return static_cast<double>(counter[0])*CCNTCell::m_Inv2Power32;
+}
 
-					pe  = 0.5*m_vvConsInt.at(beadType1).at(beadType2)*wr2;				
+// Counter-based Gaussian random number generator. It returns a normally 
+// distributed deviate with zero mean and unit variance for the given pair of
+// beads using the Box-Muller transformation of two uniform deviates from the
+// same block. The first deviate is shifted to (0,1] to avoid log(0).
 
-#elif SimIdentifier == MD
+double CCNTCell::GetPairGaussRandomNo(long id1, long id2)
+{
+    uint32_t key[2]     = {static_cast<uint32_t>(m_PairRNGKey), static_cast<uint32_t>(m_PairRNGKey >> 32)};
+    uint32_t counter[4] = {static_cast<uint32_t>(m_PairRNGStep), static_cast<uint32_t>(m_PairRNGStep >> 32),
+                           static_cast<uint32_t>(id1 < id2 ? id1 : id2), static_cast<uint32_t>(id1 < id2 ? id2 : id1)};
 
-			if( dr2 < m_coradius2 )
-			{		
-				dr = sqrt(dr2);
+    philox(counter, key);
 
-				if( dr > 0.000000001 )
-				{
-					// Calculate common factors in the LJ potential
+    const double u1 = (static_cast<double>(counter[0]) + 1.0)*CCNTCell::m_Inv2Power32;
+    const double u2 = static_cast<double>(counter[1])*CCNTCell::m_Inv2Power32;
 
-					eLJ       = m_vvLJDepth.at(beadType1).at(beadType2);	
-					sLJOverR  = m_vvLJRange.at(beadType1).at(beadType2)/dr;
-					sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
-					sLJR6	  = sLJR3*sLJR3;
-					magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
+    return sqrt(-2.0*log(u1))*cos(xxBase::m_globalTwoPI*u2);
+}
 
-					// Note that the cutoff radius has to be scaled by the first LJ potential
-					// range as well as the other terms.
+// Gaussian random number generator.
+// It returns a normally distributed deviate with zero mean and unit variance, using Randf
+// as the source of uniform deviates.
+
+double CCNTCell::Gasdev()
+{
+    double v1, v2, s, ss;
+    
+    do{
+        v1 = 2.0*CCNTCell::Randf() - 1.0;
+        v2 = 2.0*CCNTCell::Randf() - 1.0;
+        s = v1*v1 + v2*v2;
+       } while (s >= 1.0 || s == 0.0);
+    
+    ss = sqrt(-2.0*log(s)/s);
+    
+    return v1*ss;
+}
 
-					pe = (magLJ - m_vvLJDelta.at(beadType1).at(beadType2)
-							+ m_vvLJSlope.at(beadType1).at(beadType2)*(dr - m_cutoffradius));
+// Exponentially-distributed random number generator.
+// It returns a value, y, that is distributed according to exp(-y) and has
+// unit mean. It uses Randf() to supply a uniformly-distributed random number.
 
-					// Only add the soft-core potential if the potential depth is non-zero
+double CCNTCell::Expdev()
+{
+    double value;
 
-					eSC = m_vvSCDepth.at(beadType1).at(beadType2);	
+    do{
+        value = CCNTCell::Randf();
+    } while (value == 0.0);
 
-					if(eSC > 0.0)
-					{
-						sSCOverR  = m_vvSCRange.at(beadType1).at(beadType2)/dr;
-						sSCR3     = sSCOverR*sSCOverR*sSCOverR;
-						magSC     = eSC*sSCR3*sSCR3*sSCR3;
-							
-						pe += (magSC - m_vvSCDelta.at(beadType1).at(beadType2)
-								+ m_vvSCSlope.at(beadType1).at(beadType2)*(dr - m_cutoffradius));
-					}	
-					
-#endif
-				}
-				else
-				{
-					TraceInt("same cell bead", pBead1->GetId());
-					TraceInt("interacts with", pBead2->GetId());
-					TraceVector("1st pos",	pBead1->GetXPos(),
-											pBead1->GetYPos(), 
-											pBead1->GetZPos() );
-					TraceVector("2nd pos",	pBead2->GetXPos(),
-											pBead2->GetYPos(), 
-											pBead2->GetZPos() );
-					TraceDouble("Bead distance", dr);
-				}
+    return -log(value);
+}
 
-				potential += pe;
-			}
-		}
+// Static member function to return a randomly-generated string. We provide 
+// several overloads for this function that return strings of various types.
+// If any of the required sub-strings are empty (ie, a blank space), a random
+// string is generated to fill them. In this way, a completely random string
+// can be created.
+//
+// Sample string containing 8 digits:  12345678
 
-		// Next add in interactions with beads in neighbouring cells taking the
-		// PBCs into account and the presence of a wall. The PBCs are only applied
-		// if both the current CNT cell and the neighbouring one are external.
-		// We avoid double counting the contributions from beads in adjacent cells
-		// by only doing the calculation if the adjacent cell bead has an id
-		// higher than the current cell bead.
+const zString CCNTCell::GetRandomString()
+{
+    double rfloat = CCNTCell::GetRandomNo();
 
-#if SimDimension == 2
-		for( int i=0; i<4; i++ )
-#elif SimDimension == 3
-		for( int i=0; i<13; i++ )
-#endif
-		{
-			for(BeadListIterator iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
-			{
-				if((*iterBead2)->GetId() > pBead1->GetId())
-				{
-					CAbstractBead* const pBead2 = *iterBead2;
-					const long beadType2 = pBead2->GetType();
+    while(rfloat < 0.00000001)
+    {
+        rfloat = CCNTCell::GetRandomNo();
+    }
 
-					dx[0] = (pBead1->m_Pos[0] - pBead2->m_Pos[0]);
-					dx[1] = (pBead1->m_Pos[1] - pBead2->m_Pos[1]);
+    const zString rstring =  IGlobalSimBox::Instance()->ToString(static_cast<long>(1.e+08*rfloat));
 
-	#if SimDimension == 2
-					dx[2] = 0.0;
-	#elif SimDimension == 3
-					dx[2] = (pBead1->m_Pos[2] - pBead2->m_Pos[2]);
-	#endif
+    return rstring;
+}
 
-					if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
-					{
-						if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
-							dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
-						else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
-							dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+// String that has a user-defined prefix and a suffix separated by a user-defined
+// separator character. If the prefix is empty or contains only spaces, we 
+// generate a random string of letters (taken from m_AlphabetChars), and 
+// if the separator contains only spaces we use the character specified 
+// in the static member m_StringSeparator. But we allow the separator to be empty 
+// as this just concatenates the prefix with the randomly-generated string.
+//
+// A sample string returned by this function is:
+//
+// Bead-12345678 where "Bead" is the prefix and "-" is the separator.
 
-						if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
-							dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
-						else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
-							dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+const zString CCNTCell::GetRandomString(const zString prefix, const zString separator)
+{
+    zString actualSeparator;
 
-	#if SimDimension == 3
-						if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
-							dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
-						else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
-							dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
-	#endif
+    if(separator.find_first_of(" ") < separator.length())
+    {
+        actualSeparator = CCNTCell::m_StringSeparator;
+    }
+    else
+    {
+        actualSeparator = separator;
+    }
+
+    zString actualPrefix;
+
+    if(prefix.empty() || prefix.find_first_of(" ") < prefix.length())
+    {
+        actualPrefix = GetRandomAlphabeticString(CCNTCell::m_StringSize);
+    }
+    else
+    {
+        actualPrefix = prefix;
+    }
+
+    const zString rstring = actualPrefix + actualSeparator + GetRandomString();
 
-					}
+    return rstring;
+}
 
-					dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+// String that has a user-defined prefix and an integer counter, and returns
+// a random string of the form:
+//
+// e.g., Bead-12345678-1 where "-" is the separator and "1" is the counter
+//
+// Note that if  the prefix is empty, a random string is generated by the
+// GetRandomString() overload above, but we have to check that the separator is
+// not blank here as well as we use it explicitly.
 
-	// Calculate the interactions between the two beads for each simulation type.
+const zString CCNTCell::GetRandomString(const zString prefix, const zString separator, long counter)
+{
+    zString actualSeparator;
 
-	#if SimIdentifier == DPD
+    if(separator.find_first_of(" ") < separator.length())
+    {
+        actualSeparator = CCNTCell::m_StringSeparator;
+    }
+    else
+    {
+        actualSeparator = separator;
+    }
 
-	#ifndef UseDPDBeadRadii
-					if( dr2 < 1.0 )
-					{		
-						dr = sqrt(dr2);
-						if( dr > 0.000000001 )
-						{
-							wr = (1.0 - dr);
-							wr2 = wr*wr;
+    
+    const zString rstring = GetRandomString(prefix, separator) + separator + IGlobalSimBox::Instance()->ToString(counter);
+    return rstring;
+}
 
-	#else
-					dr = sqrt(dr2);
-					drmax = pBead1->GetRadius() + pBead2->GetRadius();
-					if( dr < drmax )
-					{		
-						if( dr > 0.000000001 )
-						{
-							wr = (1.0 - dr/drmax);
-							wr2 = drmax*wr*wr;
-	#endif
+// Static member function to return a random alphabetic string. This can be used
+// to construct names for bead and polymer types which must begin with a letter.
+// We just generate a random integer between 1 and 52 and return the corresponding
+// upper or lowercase letter.
+// The argument is the number of characters in the string; if this is zero,
+// we use the number stored in the static member m_StringSize.
+
+const zString CCNTCell::GetRandomAlphabeticString(long size)
+{
+    if(size < 1)
+    {
+        size = CCNTCell::m_StringSize;
+    }
 
-	// Conservative potential energy: note the difference from the force calculation
-	// in that wr2 includes the sum of the bead radii if the UseDPDBeadRadii flag is set.
+    zString rstring = "";
 
-							pe  = 0.5*m_vvConsInt.at(beadType1).at(beadType2)*wr2;				
+    const long charSet = m_AlphabetChars.size();
 
-	#elif SimIdentifier == MD
+    for(long i=0; i<size; ++i)
+    {
+        double rfloat = GetRandomNo();
+        long index = static_cast<long>(1.e+08*rfloat) % charSet;
 
-					if( dr2 < m_coradius2 )
-					{		
-						dr = sqrt(dr2);
+        while(index < 0 || index >= charSet)
+        {
+            rfloat = GetRandomNo();
+            index = static_cast<long>(1.e+08*rfloat) % charSet;
+        }
+        
+        rstring += m_AlphabetChars.at(index);
+    }
 
-						if( dr > 0.000000001 )
-						{
-							// Calculate common factors in the LJ potential
+    return rstring;
+}
 
-							eLJ       = m_vvLJDepth.at(beadType1).at(beadType2);	
-							sLJOverR  = m_vvLJRange.at(beadType1).at(beadType2)/dr;
-							sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
-							sLJR6	  = sLJR3*sLJR3;
-							magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
+// Function to check that all the beads in the current CNTCell have coordinates
+// within the cell's boundaries.
 
-							// Note that the cutoff radius has to be scaled by the first LJ potential
-							// range as well as the other terms.
+bool CCNTCell::CheckBeadsinCell()
+{
+	bool bBeadsFound = true;
 
-							pe = (magLJ - m_vvLJDelta.at(beadType1).at(beadType2)
-									+ m_vvLJSlope.at(beadType1).at(beadType2)*(dr - m_cutoffradius));
+	long index1, ix, iy, iz;
 
-							// Only add the soft-core potential if the potential depth is non-zero
+	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
+	{
+		ix = static_cast<long>((*iterBead)->GetXPos()/m_CNTXCellWidth);
+		iy = static_cast<long>((*iterBead)->GetYPos()/m_CNTYCellWidth);
 
-							eSC = m_vvSCDepth.at(beadType1).at(beadType2);	
+#if SimDimension == 2
+		iz = 0;
+#elif SimDimension == 3
+		iz = static_cast<long>((*iterBead)->GetZPos()/m_CNTZCellWidth);		
+#endif
 
-							if(eSC > 0.0)
-							{
-								sSCOverR  = m_vvSCRange.at(beadType1).at(beadType2)/dr;
-								sSCR3     = sSCOverR*sSCOverR*sSCOverR;
-								magSC     = eSC*sSCR3*sSCR3*sSCR3;
-									
-								pe += (magSC - m_vvSCDelta.at(beadType1).at(beadType2)
-										+ m_vvSCSlope.at(beadType1).at(beadType2)*(dr - m_cutoffradius));
-							}	
-	#endif
+		index1 = m_CNTXCellNo*(m_CNTYCellNo*iz+iy) + ix;
 
-						}
-						else
-						{
-							TraceInt("neighbour cell bead", pBead1->GetId());
-							TraceInt("interacts with", pBead2->GetId());
-							TraceVector("1st pos",	pBead1->GetXPos(),
-													pBead1->GetYPos(), 
-													pBead1->GetZPos() );
-							TraceVector("2nd pos",	pBead2->GetXPos(),
-													pBead2->GetYPos(), 
-													pBead2->GetZPos() );
-							TraceDouble("Bead distance", dr);
-						}
+		if(index1 != GetId())
+		{
+			bBeadsFound = false;
 
-						potential += pe;
-					}
-				}
-			}
-		}
-	}
+			CAbstractBead* pBead = (*iterBead);
 
-	// Return the kinetic and potential energies via the arguments
+			// Post a warning message about the error. but only write to the screen
+			// during debug. Note that the time returned by the Monitor may be incorrect
+			// if the SamplePeriod is not 1, but it will be out by at most SamplePeriod.
+			// This is because the Monitor only updates its current time when the
+			// data is sampled.
 
-	*pKinetic   = kinetic;
-	*pPotential = potential;
+			new CLogCNTBeadError(m_pMonitor->GetCurrentTime(), 
+														  ix, iy, iz, index1, GetId(), pBead);
 
-	// Pass the total kinetic and potential energies for the beads in the current cell
-	// to the CMonitor for summation and output. 
+#ifdef TraceOn
+			TraceInt2(  "Cell has beads", GetId(), m_lBeads.size());
+			TraceInt2(  "  Bead has false cell index", (*iterBead)->GetId(), index1);
+			TraceInt3(  "  Cell BL index",  m_BLIndex[0], m_BLIndex[1], m_BLIndex[2]);
+			TraceVector("  Cell BL coords", m_BLCoord[0], m_BLCoord[1], m_BLCoord[2]);
+			TraceVector("  Cell TR coords", m_TRCoord[0], m_TRCoord[1], m_TRCoord[2]);
+			TraceVector("  Bead coords", (*iterBead)->GetXPos(), (*iterBead)->GetYPos(), (*iterBead)->GetZPos());
 
-	m_pMonitor->AddBeadEnergy(kinetic, potential);
+			for(BeadListIterator iterBead2=m_lBeads.begin(); iterBead2!=m_lBeads.end(); iterBead2++)
+			{
+				TraceInt("Bead", (*iterBead2)->GetId());
+				TraceVector("  Pos",      (*iterBead2)->GetXPos(), (*iterBead2)->GetYPos(), (*iterBead2)->GetZPos());
+				TraceVector("  old Pos",  (*iterBead2)->m_oldPos[0], (*iterBead2)->m_oldPos[1], (*iterBead2)->m_oldPos[2]);
+				TraceVector("  Vel",      (*iterBead2)->GetXMom(), (*iterBead2)->GetYMom(), (*iterBead2)->GetZMom());
+				TraceVector("  old Vel",  (*iterBead2)->m_oldMom[0], (*iterBead2)->m_oldMom[1], (*iterBead2)->m_oldMom[2]);
+				TraceVector("  Force",    (*iterBead2)->m_Force[0], (*iterBead2)->m_Force[1], (*iterBead2)->m_Force[2]);
+				TraceVector("  old Force",(*iterBead2)->m_oldForce[0], (*iterBead2)->m_oldForce[1], (*iterBead2)->m_oldForce[2]);
 
+//				Trace("its NNCells are:");
+//				for(long ic=0; ic<27; ic++)
+//				{
+//					TraceInt2("", ic, m_aNNCells[ic]->GetId()); 
+//				}
+				Trace("**********");
+			}
 #endif
+
+		}
+	}
+
+	return bBeadsFound;
 }
 
-// Function that replaces UpdateForce() when the DPD density-dependent force
-// is included. This allows the appearance of liquid-gas interfaces in the 
-// simulation. It is only included if the EnableDPDLG flag is set, but even then
-// should only be called if the LG force is actually included as it is 
-// less efficient than the standard force calculation.
+// Function to return the potential energy of a bead interacting with all the
+// beads in the current cell and its neighbours. The bead itself must NOT be in 
+// the cell's bead list as this will lead to self-interactions. The calling 
+// routine must ensure that it is removed prior to calling this function. It 
+// should also only be called in an MD simulation because it uses the LJ and 
+// soft-core potential parameters,
 //
-// It peforms an extra calculation of the local bead density around each of the
-// pair of interacting beads and adds in a density-dependent force after
-// Warren PRL 2001.
+// We use a method similar to the UpdateForce() algorithm to add the interactions
+// that are within range of the potentials, but we calculate the PE not the force.
+// The potentials are assumed to depend only on the current positions of the 
+// particles.
 
-void CCNTCell::UpdateLGForce()
+double CCNTCell::GetPotentialEnergy(CAbstractBead *pBead) const
 {
-#if EnableDPDLG == ExperimentEnabled
-
-	BeadListIterator iterBead1;
-	BeadListIterator iterBead2;
-	rBeadListIterator riterBead2;
-
-	double dx[3], dv[3], newForce[3];
-	double dr, dr2;
-	double gammap, rdotv, wr, wr2;
-	double conForce, dissForce, randForce;
-	double drmax;
-
-    double lgForce, lgPrefactor;
-    double wrd, drdmax;  // Parameters needed for DPDLG force
+	double totalPE = 0.0;
 
-	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+	if(GetSimIdentifier() == MD)
 	{
-		// First add interactions between beads in the current cell. Note that
-		// we don't have to check the PBCs here and we perform a reverse loop
-		// over the neighbouring beads until the iterators are equal. Because you can't
-		// compare a forward and reverse iterator we compare the bead ids for
-		// the terminating condition.
+		double dx[3];
+		double dr, dr2;
 
-		// Zero the stress tensor for this bead. Notice that because of the
-		// way we only sum over beads distinct from the current bead in the same
-		// cell, and over beads in cells to the right and above the current cell
-		// we don't have to worry about double counting the pairwise forces. We
-		// can hence store the N(N-1)/2 contributions to the stress tensor in the
-		// beads that form the first ones accessed in the double loops.
+		double magLJ;						// LJ potential variables
+		double eLJ, sLJOverR, sLJR3, sLJR6;
 
-		for(short int j=0; j<9; j++)
-		{
-			(*iterBead1)->m_Stress[j] = 0.0;
-		}
+		double magSC;						// SC potential variables
+		double eSC, sSCOverR, sSCR3;
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
+		for(cBeadListIterator iterBead2=m_lBeads.begin(); iterBead2!=m_lBeads.end(); iterBead2++)
 		{
-			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
-			dv[0] = ((*iterBead1)->m_Mom[0] - (*riterBead2)->m_Mom[0]);
-
-			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
-			dv[1] = ((*iterBead1)->m_Mom[1] - (*riterBead2)->m_Mom[1]);
+			dx[0] = pBead->m_Pos[0] - (*iterBead2)->m_Pos[0];
+			dx[1] = pBead->m_Pos[1] - (*iterBead2)->m_Pos[1];
 
 #if SimDimension == 2
 			dx[2] = 0.0;
-			dv[2] = 0.0;
 #elif SimDimension == 3
-			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
-			dv[2] = ((*iterBead1)->m_Mom[2] - (*riterBead2)->m_Mom[2]);
+			dx[2] = pBead->m_Pos[2] - (*iterBead2)->m_Pos[2];
 #endif
 
 			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
 
-// Calculate the interactions between the two DPD beads including the 
-// density-dependent force. Note that the LG force prefactor depends on
-// the cube of the interaction range, and this may depend on bead type.
-// If all beads have the same LG range, then it is a constant factor and
-// it would be more efficient to include in the constant m_lgnorm.
-
-			dr = sqrt(dr2);
-			drmax  = (*iterBead1)->GetRadius()+(*riterBead2)->GetRadius();
-			drdmax = (*iterBead1)->GetLGRadius()+(*riterBead2)->GetLGRadius();
-
-			if( dr < drmax )
+			if( dr2 < m_coradius2 )
 			{		
+				dr = sqrt(dr2);
+
 				if( dr > 0.000000001 )
 				{
-					wr = (1.0 - dr/drmax);
-					wr2 = wr*wr;
-					wrd = (1.0 - dr/drdmax);
-                    lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
-
-// Conservative force magnitude
-
-					conForce  = m_vvConsInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr;				
-//					conForce = 0.0;
-
-// Density-dependent force magnitude: first we get the raw interaction parameter
-// then we multiply it by the local density function. This requires that the 
-// bead densities for every bead must be calculated before this loop.
-
-					lgForce  = lgPrefactor*m_vvLGInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*((*iterBead1)->GetLGDensity() + (*riterBead2)->GetLGDensity())*wrd;				
-
-// Dissipative and random force magnitudes. Note dr factor in newForce calculation
-
-					rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-					gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr2;
-
-					dissForce	= -gammap*rdotv;				
-					randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-
-					newForce[0] = (conForce + lgForce + dissForce + randForce)*dx[0]/dr;
-					newForce[1] = (conForce + lgForce + dissForce + randForce)*dx[1]/dr;
-					newForce[2] = (conForce + lgForce + dissForce + randForce)*dx[2]/dr;
-
-					(*iterBead1)->m_Force[0] += newForce[0];
-					(*iterBead1)->m_Force[1] += newForce[1];
-					(*iterBead1)->m_Force[2] += newForce[2];
+					// Calculate common factors in the LJ potential
 
-					(*riterBead2)->m_Force[0] -= newForce[0];
-					(*riterBead2)->m_Force[1] -= newForce[1];
-					(*riterBead2)->m_Force[2] -= newForce[2];
+					eLJ       = m_vvLJDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
+					sLJOverR  = m_vvLJRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
+					sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
+					sLJR6	  = sLJR3*sLJR3;
+					magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
 
-					// stress tensor summation
+					// Note that the cutoff radius has to be scaled by the first LJ potential
+					// range as well as the other terms.
 
-					(*iterBead1)->m_Stress[0] += dx[0]*newForce[0];
-					(*iterBead1)->m_Stress[1] += dx[1]*newForce[0];
-					(*iterBead1)->m_Stress[2] += dx[2]*newForce[0];
-					(*iterBead1)->m_Stress[3] += dx[0]*newForce[1];
-					(*iterBead1)->m_Stress[4] += dx[1]*newForce[1];
-					(*iterBead1)->m_Stress[5] += dx[2]*newForce[1];
-					(*iterBead1)->m_Stress[6] += dx[0]*newForce[2];
-					(*iterBead1)->m_Stress[7] += dx[1]*newForce[2];
-					(*iterBead1)->m_Stress[8] += dx[2]*newForce[2];
+						double mype = (magLJ - m_vvLJDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
+										  + m_vvLJSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
 
-					// Pass the stress tensor components to the CMonitor
-					// for use in analysing the stress over slices.
-					// Note that dx[2] might be close to zero and we should
-					// check for this.
+					totalPE += (magLJ - m_vvLJDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
+						              + m_vvLJSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
 
-//					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce, dx);
+					// Only add the soft-core potential if the potential depth is non-zero
+
+					eSC = m_vvSCDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
+
+					if(eSC > 0.0)
+					{
+						sSCOverR  = m_vvSCRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
+						sSCR3     = sSCOverR*sSCOverR*sSCOverR;
+						magSC     = eSC*sSCR3*sSCR3*sSCR3;
+
+						double myscpe = (magSC - m_vvSCDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
+										  + m_vvSCSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+
+						
+						totalPE += (magSC - m_vvSCDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
+									  + m_vvSCSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+					}		
 				}
 				else
 				{
-					TraceInt("same cell bead", (*iterBead1)->GetId());
-					TraceInt("interacts with", (*riterBead2)->GetId());
-					TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-											(*iterBead1)->GetYPos(), 
-											(*iterBead1)->GetZPos() );
-					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
-											(*riterBead2)->GetYPos(), 
-											(*riterBead2)->GetZPos() );
+					TraceInt("same cell bead", pBead->GetId());
+					TraceInt("interacts with", (*iterBead2)->GetId());
+					TraceVector("1st pos",	pBead->GetXPos(),
+											pBead->GetYPos(), 
+											pBead->GetZPos() );
+					TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
+											(*iterBead2)->GetYPos(), 
+											(*iterBead2)->GetZPos() );
 					TraceDouble("Bead distance", dr);
 				}
 			}
@@ -3375,20 +2828,15 @@ void CCNTCell::UpdateLGForce()
 		for( int i=0; i<13; i++ )
 #endif
 		{
-			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
+			for(cBeadListIterator iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++)
 			{
-				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-				dv[0] = ((*iterBead1)->m_Mom[0] - (*iterBead2)->m_Mom[0]);
-
-				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
-				dv[1] = ((*iterBead1)->m_Mom[1] - (*iterBead2)->m_Mom[1]);
+				dx[0] = pBead->m_Pos[0] - (*iterBead2)->m_Pos[0];
+				dx[1] = pBead->m_Pos[1] - (*iterBead2)->m_Pos[1];
 
 #if SimDimension == 2
 				dx[2] = 0.0;
-				dv[2] = 0.0;
 #elif SimDimension == 3
-				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
-				dv[2] = ((*iterBead1)->m_Mom[2] - (*iterBead2)->m_Mom[2]);
+				dx[2] = pBead->m_Pos[2] - (*iterBead2)->m_Pos[2];
 #endif
 
 				if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
@@ -3413,72 +2861,48 @@ void CCNTCell::UpdateLGForce()
 				}
 
 				dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-				dr = sqrt(dr2);
-				drmax  = (*iterBead1)->GetRadius()+(*iterBead2)->GetRadius();
-				drdmax = (*iterBead1)->GetLGRadius()+(*iterBead2)->GetLGRadius();
 
-				if( dr < drmax )
+				if( dr2 < m_coradius2 )
 				{		
+					dr = sqrt(dr2);
+
 					if( dr > 0.000000001 )
 					{
-					   wr = (1.0 - dr/drmax);
-                       wr2 = wr*wr;
-                       wrd = (1.0 - dr/drdmax);
-                       lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
-
-                       conForce	    = m_vvConsInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr;				
-//                       conForce = 0.0;
-
-// Density-dependent force magnitude: first we get the raw interaction parameter
-// then we multiply it by the local density function
-
-					    lgForce     = lgPrefactor*m_vvLGInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*((*iterBead1)->GetLGDensity() + (*riterBead2)->GetLGDensity())*wrd;				
-
-						rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-						gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr2;
-
-						dissForce	= -gammap*rdotv;				
-						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-
-						newForce[0] = (conForce + lgForce + dissForce + randForce)*dx[0]/dr;
-						newForce[1] = (conForce + lgForce + dissForce + randForce)*dx[1]/dr;
-						newForce[2] = (conForce + lgForce + dissForce + randForce)*dx[2]/dr;
-
-						(*iterBead1)->m_Force[0] += newForce[0];
-						(*iterBead1)->m_Force[1] += newForce[1];
-						(*iterBead1)->m_Force[2] += newForce[2];
+						// Calculate common factors in the LJ potential
 
-						(*iterBead2)->m_Force[0] -= newForce[0];
-						(*iterBead2)->m_Force[1] -= newForce[1];
-						(*iterBead2)->m_Force[2] -= newForce[2];
+						eLJ       = m_vvLJDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
+						sLJOverR  = m_vvLJRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
+						sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
+						sLJR6	  = sLJR3*sLJR3;
+						magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
 
-						// stress tensor summation
+						// Note that the cutoff radius has to be scaled by the first LJ potential
+						// range as well as the other terms.
 
-						(*iterBead1)->m_Stress[0] += dx[0]*newForce[0];
-						(*iterBead1)->m_Stress[1] += dx[1]*newForce[0];
-						(*iterBead1)->m_Stress[2] += dx[2]*newForce[0];
-						(*iterBead1)->m_Stress[3] += dx[0]*newForce[1];
-						(*iterBead1)->m_Stress[4] += dx[1]*newForce[1];
-						(*iterBead1)->m_Stress[5] += dx[2]*newForce[1];
-						(*iterBead1)->m_Stress[6] += dx[0]*newForce[2];
-						(*iterBead1)->m_Stress[7] += dx[1]*newForce[2];
-						(*iterBead1)->m_Stress[8] += dx[2]*newForce[2];
+						totalPE += (magLJ - m_vvLJDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
+										  + m_vvLJSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+						
+						// Only add the soft-core potential if the potential depth is non-zero
 
-						// Pass the stress tensor components to the CMonitor
-						// for use in analysing the stress over slices.
-						// Note that dx[2] might be close to zero and we should
-						// check for this.
+						eSC = m_vvSCDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
 
-//						m_pMonitor->AddBeadStress(*iterBead1, *iterBead2, newForce, dx);
+						if(eSC > 0.0)
+						{
+							sSCOverR  = m_vvSCRange.at(pBead->GetType()).at((*iterBead2)->GetType())/dr;
+							sSCR3	  = sSCOverR*sSCOverR*sSCOverR;
+							magSC	  = eSC*sSCR3*sSCR3*sSCR3;
 
+							totalPE += (magSC - m_vvSCDelta.at(pBead->GetType()).at((*iterBead2)->GetType())
+											  + m_vvSCSlope.at(pBead->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius));
+						}
 					}
 					else
 					{
-						TraceInt("neighbour cell bead", (*iterBead1)->GetId());
+						TraceInt("neighbour cell bead", pBead->GetId());
 						TraceInt("interacts with", (*iterBead2)->GetId());
-						TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-												(*iterBead1)->GetYPos(), 
-												(*iterBead1)->GetZPos() );
+						TraceVector("1st pos",	pBead->GetXPos(),
+												pBead->GetYPos(), 
+												pBead->GetZPos() );
 						TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
 												(*iterBead2)->GetYPos(), 
 												(*iterBead2)->GetZPos() );
@@ -3489,285 +2913,287 @@ void CCNTCell::UpdateLGForce()
 		}
 	}
 
-#endif
+	return totalPE;
 }
 
-// Function to calculate the local bead density around each bead in the cell.
-// This is used to weight the density-dependent force on the beads. We perform
-// a separate loop over the cells so that the density can be calculated for all
-// beads before we update the total force.
+// Function to calculate the total kinetic energy and bead-bead potential energies 
+// for all beads in a CNT cell. This involves bead pairs in the current cell and 
+// adjacent cells. Bond and bondpair potential energies are not calculated here,
+// but are calculated from within CMonitor::ZeroTotalEnergy(). Bead energy data 
+// are not stored locally but passed directly to the CMonitor class for 
+// output to the CHistoryState object. 
+//
+// The kinetic energy of beads in the current cell is obtained directly from
+// the bead momenta, and their potential energy is obtained by iterating over all
+// beads in the cell, adding their mutual interaction energies, and then over all 
+// interactions between beads in the current cell and the neighbouring cells.
+// Self-interactions of beads in the same cell are prevented by checking bead ids.
+// Double-counting of bead pairs in adjacent CNT cells is prevented by only
+// adding contributions from bead pairs in which the adjacent cell bead has an
+// id higher than the current cell bead.
+//
+// NOTE. The function CMonitor::ZeroTotalEnergy() must be called before using this 
+// routine as the energy is added to a running total in CMonitor::AddBeadEnergy().
 
-void CCNTCell::UpdateLGDensity()
+void CCNTCell::UpdateTotalEnergy(double* const pKinetic, double* const pPotential) const
 {
-#if EnableDPDLG == ExperimentEnabled
-    // Get a list of all beads in the current cell and its 26 neighbours
+	if(GetSimIdentifier() == BD)
+		return;
 
-    BeadList localBeads;
-    localBeads.clear();
+	double dx[3];
+	double dr2, drmax;
+	double v2;
+    double pe;
+	double kinetic;
+	double potential;
 
-    BeadList lNNBeads;
-    lNNBeads.clear();
+    pe        = 0.0;
+	kinetic	  = 0.0;	// Zero running totals
+	potential = 0.0;
+	drmax     = 1.0;
 
-    for(short int i=0; i<27; i++)
-    {
-        lNNBeads = m_aNNCells[i]->GetBeads();
-		copy(lNNBeads.begin(), lNNBeads.end(), back_inserter(localBeads));
-    }
+	for(cBeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+	{
+		CAbstractBead* pBead1 = *iterBead1;
+		const long beadType1 = pBead1->GetType();
 
-    // Now calculate the local density around each bead in the cell.
-    // Note that this does not include the constant normalisation factor that
-    // ensures the integral over the range is unity; that is factored into
-    // the density-dependent interaction parameter itself. We loop over all beads
-    // in the current cell and its 26 nearest neighbours, but as this includes
-    // the bead itself twice, we have to remove the self-interaction.
+		// Bead kinetic energy
 
-    double dx[3];
-    double dr, dr2, drdmax, drdmax2;
-    double wr2;
+		v2 = pBead1->m_Mom[0]*pBead1->m_Mom[0] +
+			 pBead1->m_Mom[1]*pBead1->m_Mom[1] +
+			 pBead1->m_Mom[2]*pBead1->m_Mom[2];
 
-    double density;
+		kinetic += v2;
 
-	for(BeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
-	{
-        density = 0.0;
+		// Bead potential energy.
+		// First add interactions between beads in the current cell. Note that
+		// we don't have to check the PBCs here and we perform a reverse loop
+		// over the neighbouring beads until the iterators are equal. Because you can't
+		// compare a forward and reverse iterator we compare the bead ids for
+		// the terminating condition.
 
-		for(BeadListIterator iterBead2=localBeads.begin(); iterBead2!=localBeads.end(); iterBead2++)
+		for(crBeadListIterator riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
 		{
-			dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-			dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
-			dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
+			CAbstractBead* const pBead2 = *riterBead2;
+
+			dx[0] = (pBead1->m_Pos[0] - pBead2->m_Pos[0]);
+			dx[1] = (pBead1->m_Pos[1] - pBead2->m_Pos[1]);
+
+#if SimDimension == 2
+			dx[2] = 0.0;
+#elif SimDimension == 3
+			dx[2] = (pBead1->m_Pos[2] - pBead2->m_Pos[2]);
+#endif
+
+			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
 
-            // If the current CNT cell is on the SimBox boundary, we check the 
-            // PBCs for all bead pairs as we don't do a loop over neighbouring 
-            // CNT cells here. As long as there are not too many beads in the 
-            // current cell this should not be a resource drain. 
+			if(m_bBeadRadii)
+			{
+				drmax = pBead1->GetRadius() + pBead2->GetRadius();
+			}
 
-			if(m_bExternal)
+			if(PairPotential(beadType1, pBead2->GetType(), drmax, dr2, pe))
 			{
-				if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
-					dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
-				else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
-					dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
-
-				if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
-					dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
-				else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
-					dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
-				if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
-					dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
-				else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
-					dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+				potential += pe;
 			}
+		}
 
+		// Next add in interactions with beads in neighbouring cells taking the
+		// PBCs into account and the presence of a wall. The PBCs are only applied
+		// if both the current CNT cell and the neighbouring one are external.
+		// We avoid double counting the contributions from beads in adjacent cells
+		// by only doing the calculation if the adjacent cell bead has an id
+		// higher than the current cell bead.
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-			drdmax = (*iterBead1)->GetLGRadius()+(*iterBead2)->GetLGRadius();
-            drdmax2 = drdmax*drdmax;
+#if SimDimension == 2
+		for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+		for( int i=0; i<13; i++ )
+#endif
+		{
+			for(BeadListIterator iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
+			{
+				if((*iterBead2)->GetId() > pBead1->GetId())
+				{
+					CAbstractBead* const pBead2 = *iterBead2;
 
-            // The second test should remove self-interactions
+					dx[0] = (pBead1->m_Pos[0] - pBead2->m_Pos[0]);
+					dx[1] = (pBead1->m_Pos[1] - pBead2->m_Pos[1]);
 
-            if(dr2 < drdmax2 && dr2 > 0.00000001)
-            {
-			    dr = sqrt(dr2);
-                wr2 = (1.0 - dr/drdmax)*(1.0 - dr/drdmax);
+	#if SimDimension == 2
+					dx[2] = 0.0;
+	#elif SimDimension == 3
+					dx[2] = (pBead1->m_Pos[2] - pBead2->m_Pos[2]);
+	#endif
 
-                density += wr2;
-            }
-        }
+					if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
+					{
+						if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+							dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+						else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+							dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
 
-        (*iterBead1)->SetLGDensity(density);
-	}
-#endif
-}
+						if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+							dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+						else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+							dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
 
-// Function a cell uses to calculate non-bonded, bead-bead forces between
-// beads in the current cell and its neighbouring cells that belong to adjacent
-// processors and that may be either instances of CCNTCell or CExternalCNTCell.
-// It is only used in parallel runs.
-//
-// Depending on its position in the owning processor's Border region, the cell
-// has a specific number of external cell neighbours that are hardwired into
-// its m_aExtNNCells[] array. These instances are CExternalCNTCell pointers not
-// CCNTCell pointers. Hence, we iterate over them retrieving the bead data that
-// has been collected there by the mpsSimBox before the force loop is entered.
-// Bead data are collected simply as (id, type, x, y, z, vx, vy, vz) and used to
-// calculate the forces on the beads in the current cell. The forces are then also
-// stored using the ids of the beads belonging to the adjacent processor so that they
-// can be sent back to update the other processor's beads.
+	#if SimDimension == 3
+						if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+							dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+						else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+							dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+	#endif
+
+					}
+
+					dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+					if(m_bBeadRadii)
+					{
+						drmax = pBead1->GetRadius() + pBead2->GetRadius();
+					}
+
+					if(PairPotential(beadType1, pBead2->GetType(), drmax, dr2, pe))
+					{
+						potential += pe;
+					}
+				}
+			}
+		}
+	}
 
-void CCNTCell::UpdateForceP()
-{
-	mpsSimBox::GlobalCellCounter++;
-	
-	long localCellCellCounter = 0;
+	// Return the kinetic and potential energies via the arguments
 
-    // Now we iterate over the neighbouring cells calling different functions
-    // depending on whether each neighbour is internal or external
+	*pKinetic   = kinetic;
+	*pPotential = potential;
 
-#if SimIdentifier == BD
+	// Pass the total kinetic and potential energies for the beads in the current cell
+	// to the CMonitor for summation and output. 
 
-    CAbstractBead*   pBead1;
-	BeadListIterator iterBead1;
-	BeadListIterator iterBead2;
-	rBeadListIterator riterBead2;
+	m_pMonitor->AddBeadEnergy(kinetic, potential);
+}
 
-	double dx[3];
-	double dr, dr2, drmax;
+// Function to calculate the non-bonded potential energy of a pair of DPD or MD
+// beads given the square of their separation. The sum of the beads' interaction
+// radii, drmax, is only used by DPD simulations with bead radii. It returns 
+// false if the beads do not interact.
 
-	double wr, wr2;
-	double conForce;
-    double newForce1[3], newForce2[3];
-		
+bool CCNTCell::PairPotential(long beadType1, long beadType2, double drmax, double dr2, double& pe)
+{
+	double dr, wr, wr2;
 
-	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+	if(GetSimIdentifier() == MD)
 	{
-        pBead1 = *iterBead1;
+		if( dr2 >= m_coradius2 )
+			return false;
 
-		// First add interactions between beads in the current cell. Note that
-		// we don't have to check the PBCs here and we perform a reverse loop
-		// over the neighbouring beads until the iterators are equal. Because you can't
-		// compare a forward and reverse iterator we compare the bead ids for
-		// the terminating condition.
+		dr = sqrt(dr2);
 
-		// Zero the stress tensor for this bead. Notice that because of the
-		// way we only sum over beads distinct from the current bead in the same
-		// cell, and over beads in cells to the right and above the current cell
-		// we don't have to worry about double counting the pairwise forces. We
-		// can hence store the N(N-1)/2 contributions to the stress tensor in the
-		// beads that form the first ones accessed in the double loops.
+		if( dr <= 0.000000001 )
+			return false;
 
-		for(short int j=0; j<9; j++)
-		{
-			pBead1->m_Stress[j] = 0.0;
-		}
+		// Calculate common factors in the LJ potential
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
-		{
-			dx[0] = (pBead1->m_Pos[0] - (*riterBead2)->m_Pos[0]);
-			dx[1] = (pBead1->m_Pos[1] - (*riterBead2)->m_Pos[1]);
+		const double eLJ      = m_vvLJDepth.at(beadType1).at(beadType2);	
+		const double sLJOverR = m_vvLJRange.at(beadType1).at(beadType2)/dr;
+		const double sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
+		const double sLJR6	  = sLJR3*sLJR3;
+		const double magLJ	  = eLJ*sLJR6*(sLJR6 - 1.0);
 
-#if SimDimension == 2
-			dx[2] = 0.0;
-#elif SimDimension == 3
-			dx[2] = (pBead1->m_Pos[2] - (*riterBead2)->m_Pos[2]);
-#endif
+		// Note that the cutoff radius has to be scaled by the first LJ potential
+		// range as well as the other terms.
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-			dr = sqrt(dr2);
-			drmax = pBead1->GetRadius()+(*riterBead2)->GetRadius();
-			if( dr < drmax )
-			{		
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr/drmax);
-					wr2 = wr*wr;
+		pe = (magLJ - m_vvLJDelta.at(beadType1).at(beadType2)
+				+ m_vvLJSlope.at(beadType1).at(beadType2)*(dr - m_cutoffradius));
 
-// Conservative force magnitude
+		// Only add the soft-core potential if the potential depth is non-zero
 
-					conForce = m_vvConsInt.at(pBead1->GetType()).at((*riterBead2)->GetType())*wr/dr;				
-//				    conForce = 0.0;		
- 
-                    for(short int i=0; i<3; i++)
-                    {
-                        newForce1[i] = conForce*dx[i];
- 					    newForce2[i] = -conForce*dx[i];
+		const double eSC = m_vvSCDepth.at(beadType1).at(beadType2);	
 
-                        pBead1->m_Force[i]  += newForce1[i];
-					    (*riterBead2)->m_Force[i] += newForce2[i];
-                    }
+		if(eSC > 0.0)
+		{
+			const double sSCOverR = m_vvSCRange.at(beadType1).at(beadType2)/dr;
+			const double sSCR3    = sSCOverR*sSCOverR*sSCOverR;
+			const double magSC    = eSC*sSCR3*sSCR3*sSCR3;
+				
+			pe += (magSC - m_vvSCDelta.at(beadType1).at(beadType2)
+					+ m_vvSCSlope.at(beadType1).at(beadType2)*(dr - m_cutoffradius));
+		}	
+	}
+	else if(m_bBeadRadii)
+	{
+		dr = sqrt(dr2);
 
-					// stress tensor summation
+		if( dr >= drmax || dr <= 0.000000001 )
+			return false;
 
-					pBead1->m_Stress[0] += dx[0]*newForce1[0];
-					pBead1->m_Stress[1] += dx[1]*newForce1[0];
-					pBead1->m_Stress[2] += dx[2]*newForce1[0];
-					pBead1->m_Stress[3] += dx[0]*newForce1[1];
-					pBead1->m_Stress[4] += dx[1]*newForce1[1];
-					pBead1->m_Stress[5] += dx[2]*newForce1[1];
-					pBead1->m_Stress[6] += dx[0]*newForce1[2];
-					pBead1->m_Stress[7] += dx[1]*newForce1[2];
-					pBead1->m_Stress[8] += dx[2]*newForce1[2];
+		// Conservative potential energy: note the difference from the force 
+		// calculation in that wr2 includes the sum of the bead radii.
 
-					// Pass the stress tensor components to the CMonitor
-					// for use in analysing the stress over slices.
-					// Note that dx[2] might be close to zero and we should
-					// check for this.
-                    // Is there a problem in the stress calculation now that the 
-                    // force on each bead in an interacting pair is not the same?
+		wr  = (1.0 - dr/drmax);
+		wr2 = drmax*wr*wr;
+		pe  = 0.5*m_vvConsInt.at(beadType1).at(beadType2)*wr2;				
+	}
+	else
+	{
+		if( dr2 >= 1.0 )
+			return false;
 
-					// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce1, dx);
-#endif
-				}
-				else
-				{
-					TraceInt("same cell bead", pBead1->GetId());
-					TraceInt("interacts with", (*riterBead2)->GetId());
-					TraceVector("1st pos",	pBead1->GetXPos(),
-											pBead1->GetYPos(), 
-											pBead1->GetZPos() );
-					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
-											(*riterBead2)->GetYPos(), 
-											(*riterBead2)->GetZPos() );
-					TraceDouble("Bead distance", dr);
-				}
-			}
-		}
+		dr = sqrt(dr2);
 
-		// Next add in interactions with beads in neighbouring cells.
-        // We have to do different processing depending on whether the neighbouring
-        // cell is internal or external. In the latter case, we pass the 
-        // bead pointer to the external cell so that it can calculate all 
-        // forces involving that bead, and the current cell's external pointer
-        // so the neighouring cell knows whether to apply the PBCs.
+		if( dr <= 0.000000001 )
+			return false;
 
-#if SimDimension == 2
-		for( int i=0; i<4; i++ )
-#elif SimDimension == 3
-		for( int i=0; i<13; i++ )
-#endif
-		{
-            CCNTCell* const pNNCell = m_aIntNNCells[i];
+		wr  = (1.0 - dr);
+		wr2 = wr*wr;
+		pe  = 0.5*m_vvConsInt.at(beadType1).at(beadType2)*wr2;				
+	}
 
-            pNNCell->UpdateForceBetweenCells(IsExternal(), pBead1);
-        }
-    }
+	return true;
+}
+
+// Function that replaces UpdateForce() when the DPD density-dependent force
+// is included. This allows the appearance of liquid-gas interfaces in the 
+// simulation. It should only be called if the LG force is actually included,
+// i.e., the control data file starts with the "dpdlg" token, as it is less 
+// efficient than the standard force calculation.
+//
+// It peforms an extra calculation of the local bead density around each of the
+// pair of interacting beads and adds in a density-dependent force after
+// Warren PRL 2001. As for UpdateForce(), the loop is specialised for cells on
+// the simulation box boundary so that interior cells never test for the PBCs.
 
-#else
-    // DPD and MD equations of motion
+void CCNTCell::UpdateLGForce()
+{
+	if(m_bExternal)
+	{
+		UpdateLGForceKernel<true>();
+	}
+	else
+	{
+		UpdateLGForceKernel<false>();
+	}
+}
 
-    CAbstractBead*   pBead1;
+template<bool bExternal>
+void CCNTCell::UpdateLGForceKernel()
+{
 	BeadListIterator iterBead1;
 	BeadListIterator iterBead2;
 	rBeadListIterator riterBead2;
 
 	double dx[3], dv[3], newForce[3];
 	double dr, dr2;
-
-#if SimIdentifier == DPD
-
 	double gammap, rdotv, wr, wr2;
 	double conForce, dissForce, randForce;
-
-#ifdef UseDPDBeadRadii
 	double drmax;
-#endif
 
-#elif SimIdentifier == MD
-
-	double magLJ;						// LJ potential variables
-	double eLJ, sLJOverR, sLJR3, sLJR6;
-
-	double magSC;						// SC potential variables
-	double eSC, sSCOverR, sSCR3;
-
-#endif
+    double lgForce, lgPrefactor;
+    double wrd, drdmax;  // Parameters needed for DPDLG force
 
 	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
 	{
-        pBead1 = *iterBead1;
-
 		// First add interactions between beads in the current cell. Note that
 		// we don't have to check the PBCs here and we perform a reverse loop
 		// over the neighbouring beads until the iterators are equal. Because you can't
@@ -3783,119 +3209,72 @@ void CCNTCell::UpdateForceP()
 
 		for(short int j=0; j<9; j++)
 		{
-			pBead1->m_Stress[j] = 0.0;
+			(*iterBead1)->m_Stress[j] = 0.0;
 		}
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
+		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
 		{
-			dx[0] = (pBead1->m_Pos[0] - (*riterBead2)->m_Pos[0]);
-			dv[0] = (pBead1->m_Mom[0] - (*riterBead2)->m_Mom[0]);
+			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
+			dv[0] = ((*iterBead1)->m_Mom[0] - (*riterBead2)->m_Mom[0]);
 
-			dx[1] = (pBead1->m_Pos[1] - (*riterBead2)->m_Pos[1]);
-			dv[1] = (pBead1->m_Mom[1] - (*riterBead2)->m_Mom[1]);
+			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
+			dv[1] = ((*iterBead1)->m_Mom[1] - (*riterBead2)->m_Mom[1]);
 
 #if SimDimension == 2
 			dx[2] = 0.0;
 			dv[2] = 0.0;
 #elif SimDimension == 3
-			dx[2] = (pBead1->m_Pos[2] - (*riterBead2)->m_Pos[2]);
-			dv[2] = (pBead1->m_Mom[2] - (*riterBead2)->m_Mom[2]);
+			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
+			dv[2] = ((*iterBead1)->m_Mom[2] - (*riterBead2)->m_Mom[2]);
 #endif
 
 			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
 
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we use the flag UseDPDBeadRadii to determine whether
-// the interaction radius is bead-specific or not. Note that when we use the
-// interaction radius we have to compare the actual distance between beads
-// not its square!
-
-#if SimIdentifier == DPD
+// Calculate the interactions between the two DPD beads including the 
+// density-dependent force. Note that the LG force prefactor depends on
+// the cube of the interaction range, and this may depend on bead type.
+// If all beads have the same LG range, then it is a constant factor and
+// it would be more efficient to include in the constant m_lgnorm.
 
-#ifndef UseDPDBeadRadii
-			if( dr2 < 1.0 )
-			{		
-				dr = sqrt(dr2);
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr);
-					wr2 = wr*wr;
-#else
 			dr = sqrt(dr2);
-			drmax = pBead1->GetRadius()+(*riterBead2)->GetRadius();
+			drmax  = (*iterBead1)->GetRadius()+(*riterBead2)->GetRadius();
+			drdmax = (*iterBead1)->GetLGRadius()+(*riterBead2)->GetLGRadius();
+
 			if( dr < drmax )
 			{		
 				if( dr > 0.000000001 )
 				{
 					wr = (1.0 - dr/drmax);
 					wr2 = wr*wr;
-#endif
+					wrd = (1.0 - dr/drdmax);
+                    lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
 
 // Conservative force magnitude
 
-					conForce  = m_vvConsInt.at(pBead1->GetType()).at((*riterBead2)->GetType())*wr;				
-//				    conForce = 0.0;		
+					conForce  = m_vvConsInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr;				
+//					conForce = 0.0;
+
+// Density-dependent force magnitude: first we get the raw interaction parameter
+// then we multiply it by the local density function. This requires that the 
+// bead densities for every bead must be calculated before this loop.
+
+					lgForce  = lgPrefactor*m_vvLGInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*((*iterBead1)->GetLGDensity() + (*riterBead2)->GetLGDensity())*wrd;				
 
 // Dissipative and random force magnitudes. Note dr factor in newForce calculation
 
 					rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-					gammap		= m_vvDissInt.at(pBead1->GetType()).at((*riterBead2)->GetType())*wr2;
+					gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr2;
 
 					dissForce	= -gammap*rdotv;				
 					randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
 
-					newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
-					newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
-					newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
-
-#elif SimIdentifier == MD
-
-			if( dr2 < m_coradius2 )
-			{		
-				dr = sqrt(dr2);
-
-				if( dr > 0.000000001 )
-				{
-					// Calculate common factors in the LJ potential and include shifted force.
-					// Note that the shifted force term needs to be multiplied by the 
-					// unit vector in the bead-bead separation whereas the force term 
-					// has the full vector.
-
-					eLJ		  = m_vvLJDepth.at(pBead1->GetType()).at((*riterBead2)->GetType());	
-					sLJOverR  = m_vvLJRange.at(pBead1->GetType()).at((*riterBead2)->GetType())/dr;
-					sLJR3     = sLJOverR*sLJOverR*sLJOverR;
-					sLJR6     = sLJR3*sLJR3;
-
-					magLJ = (6.0*eLJ*sLJR6*(2.0*sLJR6 - 1.0) 
-						     - dr*m_vvLJSlope.at(pBead1->GetType()).at((*riterBead2)->GetType()))/dr2;
-
-					// Only add the soft-core potential if the potential depth is non-zero
-
-					eSC = m_vvSCDepth.at(pBead1->GetType()).at((*riterBead2)->GetType());	
-
-					if(eSC > 0.0)
-					{
-						sSCOverR = m_vvSCRange.at(pBead1->GetType()).at((*riterBead2)->GetType())/dr;
-						sSCR3    = sSCOverR*sSCOverR*sSCOverR;
-						
-						magSC = (9.0*eSC*sSCR3*sSCR3*sSCR3
-							     - dr*m_vvSCSlope.at(pBead1->GetType()).at((*riterBead2)->GetType()))/dr2;
-					}
-					else
-					{
-						magSC = 0.0;
-					}
-
-					newForce[0] = (magLJ + magSC)*dx[0];
-					newForce[1] = (magLJ + magSC)*dx[1];
-					newForce[2] = (magLJ + magSC)*dx[2];
-#endif
-				    pBead1->m_ForceCounter++;
-				    (*riterBead2)->m_ForceCounter++;
+					newForce[0] = (conForce + lgForce + dissForce + randForce)*dx[0]/dr;
+					newForce[1] = (conForce + lgForce + dissForce + randForce)*dx[1]/dr;
+					newForce[2] = (conForce + lgForce + dissForce + randForce)*dx[2]/dr;
 
-					pBead1->m_Force[0] += newForce[0];
-					pBead1->m_Force[1] += newForce[1];
-					pBead1->m_Force[2] += newForce[2];
+					(*iterBead1)->m_Force[0] += newForce[0];
+					(*iterBead1)->m_Force[1] += newForce[1];
+					(*iterBead1)->m_Force[2] += newForce[2];
 
 					(*riterBead2)->m_Force[0] -= newForce[0];
 					(*riterBead2)->m_Force[1] -= newForce[1];
@@ -3903,118 +3282,37 @@ void CCNTCell::UpdateForceP()
 
 					// stress tensor summation
 
-					pBead1->m_Stress[0] += dx[0]*newForce[0];
-					pBead1->m_Stress[1] += dx[1]*newForce[0];
-					pBead1->m_Stress[2] += dx[2]*newForce[0];
-					pBead1->m_Stress[3] += dx[0]*newForce[1];
-					pBead1->m_Stress[4] += dx[1]*newForce[1];
-					pBead1->m_Stress[5] += dx[2]*newForce[1];
-					pBead1->m_Stress[6] += dx[0]*newForce[2];
-					pBead1->m_Stress[7] += dx[1]*newForce[2];
-					pBead1->m_Stress[8] += dx[2]*newForce[2];
-
-					// Pass the stress tensor components to the CMonitor
-					// for use in analysing the stress over slices.
-					// Note that dx[2] might be close to zero and we should
-					// check for this.
-
-					// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce, dx);
-#endif
-				}
-				else
-				{
-					TraceInt("same cell bead", pBead1->GetId());
-					TraceInt("interacts with", (*riterBead2)->GetId());
-					TraceVector("1st pos",	pBead1->GetXPos(),
-											pBead1->GetYPos(), 
-											pBead1->GetZPos() );
-					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
-											(*riterBead2)->GetYPos(), 
-											(*riterBead2)->GetZPos() );
-					TraceDouble("Bead distance", dr);
-				}
-			}
-		}
-
-		// Next add in interactions with beads in neighbouring cells taking the
-		// PBCs into account and the presence of a wall. The PBCs are only applied
-		// if both the current CNT cell and the neighbouring one are external.
-
-#if SimDimension == 2
-		for( int i=0; i<4; i++ )
-#elif SimDimension == 3
-		for( int i=0; i<13; i++ )
-#endif
-		{
-
-		    localCellCellCounter++;
-			
-            CCNTCell* const pNNCell = m_aIntNNCells[i];
-			
-/*			
-		    if(xxParallelBase::GlobalGetRank() == 0)
-			{
-		
-			    if(dynamic_cast<CExternalCNTCell*>(pNNCell))
-				{
-		            std::cout << "Calculating External  cell-cell forces for " << GetId() << " " << pNNCell->GetId() << zEndl;
-				}
-				else
-				{
-		            std::cout << "Calculating Internal  cell-cell forces for " << GetId() << " " << pNNCell->GetId() << zEndl;
-				}
-			}
-
-*/
-
-            pNNCell->UpdateForceBetweenCells(IsExternal(), pBead1);
-        }
-    }
-#endif
-
-	if(m_lBeads.size() > 0)
-	{
-	    localCellCellCounter /= m_lBeads.size();
-	}
-	else
-	{
-	    localCellCellCounter = 13;
-	}
-	
-    mpsSimBox::GlobalCellCellIntCounter += localCellCellCounter;
-
-
-
-}
-
-// VF used by this class to calculate forces between beads in two adjacent
-// cells that are both internal to one processor. The argument is a pointer
-// to a bead in the original cell being iterated over within UpdateForceP(), 
-// and the current cell is one of the nearest-neighbours of the original cell.
-// We perform the loop over all the beads in the current cell calculating their
-// forces with the original particle. 
-
-void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBead)
-{
-//    const long targetBeadId = 4; // Write out interactions for this bead only
-
-#if SimIdentifier == BD
-
-	BeadListIterator iterBead1;
-	BeadListIterator iterBead2;
-	rBeadListIterator riterBead2;
-
-	double dx[3];
-	double dr, dr2, drmax;
+					(*iterBead1)->m_Stress[0] += dx[0]*newForce[0];
+					(*iterBead1)->m_Stress[1] += dx[1]*newForce[0];
+					(*iterBead1)->m_Stress[2] += dx[2]*newForce[0];
+					(*iterBead1)->m_Stress[3] += dx[0]*newForce[1];
+					(*iterBead1)->m_Stress[4] += dx[1]*newForce[1];
+					(*iterBead1)->m_Stress[5] += dx[2]*newForce[1];
+					(*iterBead1)->m_Stress[6] += dx[0]*newForce[2];
+					(*iterBead1)->m_Stress[7] += dx[1]*newForce[2];
+					(*iterBead1)->m_Stress[8] += dx[2]*newForce[2];
 
-	double wr, wr2;
-	double conForce;
-    double newForce1[3], newForce2[3];
+					// Pass the stress tensor components to the CMonitor
+					// for use in analysing the stress over slices.
+					// Note that dx[2] might be close to zero and we should
+					// check for this.
 
-	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
-	{
+//					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce, dx);
+				}
+				else
+				{
+					TraceInt("same cell bead", (*iterBead1)->GetId());
+					TraceInt("interacts with", (*riterBead2)->GetId());
+					TraceVector("1st pos",	(*iterBead1)->GetXPos(),
+											(*iterBead1)->GetYPos(), 
+											(*iterBead1)->GetZPos() );
+					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
+											(*riterBead2)->GetYPos(), 
+											(*riterBead2)->GetZPos() );
+					TraceDouble("Bead distance", dr);
+				}
+			}
+		}
 
 		// Next add in interactions with beads in neighbouring cells taking the
 		// PBCs into account and the presence of a wall. The PBCs are only applied
@@ -4029,15 +3327,20 @@ void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBea
 			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
 			{
 				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
+				dv[0] = ((*iterBead1)->m_Mom[0] - (*iterBead2)->m_Mom[0]);
+
 				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
+				dv[1] = ((*iterBead1)->m_Mom[1] - (*iterBead2)->m_Mom[1]);
 
 #if SimDimension == 2
 				dx[2] = 0.0;
+				dv[2] = 0.0;
 #elif SimDimension == 3
 				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
+				dv[2] = ((*iterBead1)->m_Mom[2] - (*iterBead2)->m_Mom[2]);
 #endif
 
-				if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
+				if( bExternal && m_aIntNNCells[i]->IsExternal() )
 				{
 					if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
 						dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
@@ -4059,55 +3362,64 @@ void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBea
 				}
 
 				dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we have to change the distance-dependence according
-// to the bead interaction radii.
-
 				dr = sqrt(dr2);
-				drmax = (*iterBead1)->GetRadius()+(*iterBead2)->GetRadius();
+				drmax  = (*iterBead1)->GetRadius()+(*iterBead2)->GetRadius();
+				drdmax = (*iterBead1)->GetLGRadius()+(*iterBead2)->GetLGRadius();
+
 				if( dr < drmax )
 				{		
 					if( dr > 0.000000001 )
 					{
-						wr = (1.0 - dr/drmax);
-						wr2 = wr*wr;
- 
- // Conservative force magnitude
+					   wr = (1.0 - dr/drmax);
+                       wr2 = wr*wr;
+                       wrd = (1.0 - dr/drdmax);
+                       lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
+
+                       conForce	    = m_vvConsInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr;				
+//                       conForce = 0.0;
+
+// Density-dependent force magnitude: first we get the raw interaction parameter
+// then we multiply it by the local density function
+
+					    lgForce     = lgPrefactor*m_vvLGInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*((*iterBead1)->GetLGDensity() + (*iterBead2)->GetLGDensity())*wrd;				
+
+						rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
+						gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr2;
+
+						dissForce	= -gammap*rdotv;				
+						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+
+						newForce[0] = (conForce + lgForce + dissForce + randForce)*dx[0]/dr;
+						newForce[1] = (conForce + lgForce + dissForce + randForce)*dx[1]/dr;
+						newForce[2] = (conForce + lgForce + dissForce + randForce)*dx[2]/dr;
+
+						(*iterBead1)->m_Force[0] += newForce[0];
+						(*iterBead1)->m_Force[1] += newForce[1];
+						(*iterBead1)->m_Force[2] += newForce[2];
+
+						(*iterBead2)->m_Force[0] -= newForce[0];
+						(*iterBead2)->m_Force[1] -= newForce[1];
+						(*iterBead2)->m_Force[2] -= newForce[2];
 
-					    conForce = m_vvConsInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr/dr;				
-//                        conForce = 0.0;
-						
-                        for(short int i=0; i<3; i++)
-                        {
-                            newForce1[i] = conForce*dx[i];
- 					        newForce2[i] = -conForce*dx[i];
-
-                            (*iterBead1)->m_Force[i] += newForce1[i];
-					        (*iterBead2)->m_Force[i] += newForce2[i];
-                        }
-                       
 						// stress tensor summation
 
-						(*iterBead1)->m_Stress[0] += dx[0]*newForce1[0];
-						(*iterBead1)->m_Stress[1] += dx[1]*newForce1[0];
-						(*iterBead1)->m_Stress[2] += dx[2]*newForce1[0];
-						(*iterBead1)->m_Stress[3] += dx[0]*newForce1[1];
-						(*iterBead1)->m_Stress[4] += dx[1]*newForce1[1];
-						(*iterBead1)->m_Stress[5] += dx[2]*newForce1[1];
-						(*iterBead1)->m_Stress[6] += dx[0]*newForce1[2];
-						(*iterBead1)->m_Stress[7] += dx[1]*newForce1[2];
-						(*iterBead1)->m_Stress[8] += dx[2]*newForce1[2];
+						(*iterBead1)->m_Stress[0] += dx[0]*newForce[0];
+						(*iterBead1)->m_Stress[1] += dx[1]*newForce[0];
+						(*iterBead1)->m_Stress[2] += dx[2]*newForce[0];
+						(*iterBead1)->m_Stress[3] += dx[0]*newForce[1];
+						(*iterBead1)->m_Stress[4] += dx[1]*newForce[1];
+						(*iterBead1)->m_Stress[5] += dx[2]*newForce[1];
+						(*iterBead1)->m_Stress[6] += dx[0]*newForce[2];
+						(*iterBead1)->m_Stress[7] += dx[1]*newForce[2];
+						(*iterBead1)->m_Stress[8] += dx[2]*newForce[2];
 
 						// Pass the stress tensor components to the CMonitor
 						// for use in analysing the stress over slices.
 						// Note that dx[2] might be close to zero and we should
 						// check for this.
 
-					// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-						m_pMonitor->AddBeadStress(*iterBead1, *iterBead2, newForce1, dx);
-#endif
+//						m_pMonitor->AddBeadStress(*iterBead1, *iterBead2, newForce, dx);
+
 					}
 					else
 					{
@@ -4126,54 +3438,80 @@ void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBea
 		}
 	}
 
-#else
-    // DPD and MD equations of motion
+}
 
-	BeadListIterator iterBead2;
+// Function to calculate the local bead density around each bead in the cell.
+// This is used to weight the density-dependent force on the beads. We perform
+// a separate loop over the cells so that the density can be calculated for all
+// beads before we update the total force.
+//
+// The pairs are visited in the same way as in UpdateLGForce(): beads in the 
+// current cell and in the 13 half-shell neighbouring cells (4 in 2d), so each
+// pair is visited once and its weight added to the density of both beads.
+// Hence, ZeroLGDensity() must be called for all cells before this function 
+// is called for any of them. Note that the density does not include the 
+// constant normalisation factor that ensures the integral over the range is 
+// unity; that is factored into the density-dependent interaction parameter 
+// itself. Beads that are closer than a small distance are ignored as before.
 
-	double dx[3], dv[3], newForce[3];
-	double dr, dr2;
+void CCNTCell::UpdateLGDensity()
+{
+	BeadListIterator iterBead1;
+	BeadListIterator iterBead2;
+	rBeadListIterator riterBead2;
 
-#if SimIdentifier == DPD
+    double dx[3];
+    double dr, dr2, drdmax, wr;
 
-	double gammap, rdotv, wr, wr2;
-	double conForce, dissForce, randForce;
+	for(iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
+	{
+		for(riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2)
+		{
+			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
+			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
 
-#ifdef UseDPDBeadRadii
-	double drmax;
+#if SimDimension == 2
+			dx[2] = 0.0;
+#elif SimDimension == 3
+			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
 #endif
 
-#elif SimIdentifier == MD
+			dr2    = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+			drdmax = (*iterBead1)->GetLGRadius()+(*riterBead2)->GetLGRadius();
+
+            if(dr2 < drdmax*drdmax && dr2 > 0.00000001)
+            {
+			    dr = sqrt(dr2);
+                wr = (1.0 - dr/drdmax);
 
-	double magLJ;						// LJ potential variables
-	double eLJ, sLJOverR, sLJR3, sLJR6;
+                (*iterBead1)->AddLGDensity(wr*wr);
+                (*riterBead2)->AddLGDensity(wr*wr);
+            }
+		}
 
-	double magSC;						// SC potential variables
-	double eSC, sSCOverR, sSCR3;
+		// The PBCs are only applied if both the current CNT cell and the 
+		// neighbouring one are external.
 
+#if SimDimension == 2
+		for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+		for( int i=0; i<13; i++ )
 #endif
+		{
+			const bool bPBC = m_bExternal && m_aIntNNCells[i]->IsExternal();
 
-		// Add in interactions of the passed-in bead with beads in the current
-        // cell taking the PBCs into account. The PBCs are only applied
-		// if both the current CNT cell and the neighbouring one are external.
-
-			for( iterBead2=m_lBeads.begin(); iterBead2!=m_lBeads.end(); iterBead2++ )
+			for(iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++)
 			{
-				dx[0] = (pBead->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-				dv[0] = (pBead->m_Mom[0] - (*iterBead2)->m_Mom[0]);
-
-				dx[1] = (pBead->m_Pos[1] - (*iterBead2)->m_Pos[1]);
-				dv[1] = (pBead->m_Mom[1] - (*iterBead2)->m_Mom[1]);
+				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
+				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
 
 #if SimDimension == 2
 				dx[2] = 0.0;
-				dv[2] = 0.0;
 #elif SimDimension == 3
-				dx[2] = (pBead->m_Pos[2] - (*iterBead2)->m_Pos[2]);
-				dv[2] = (pBead->m_Mom[2] - (*iterBead2)->m_Mom[2]);
+				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
 #endif
 
-				if( m_bExternal && bExternal )
+				if(bPBC)
 				{
 					if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
 						dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
@@ -4191,144 +3529,114 @@ void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBea
 					else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
 						dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
 #endif
-
 				}
 
-				dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we have to change the distance-dependence according
-// to the bead interaction radii.
-
-#if SimIdentifier == DPD
+				dr2    = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+				drdmax = (*iterBead1)->GetLGRadius()+(*iterBead2)->GetLGRadius();
 
-#ifndef UseDPDBeadRadii
-				if( dr2 < 1.0 )
-				{		
+				if(dr2 < drdmax*drdmax && dr2 > 0.00000001)
+				{
 					dr = sqrt(dr2);
-					if( dr > 0.000000001 )
-					{
-						wr = (1.0 - dr);
-						wr2 = wr*wr;
-#else
-				dr = sqrt(dr2);
-				drmax = pBead->GetRadius()+(*iterBead2)->GetRadius();
-				if( dr < drmax )
-				{		
-					if( dr > 0.000000001 )
-					{
-						wr = (1.0 - dr/drmax);
-						wr2 = wr*wr;
-#endif
-						conForce	= m_vvConsInt.at(pBead->GetType()).at((*iterBead2)->GetType())*wr;				
-//                        conForce    = 0.0;
-
-						rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-						gammap		= m_vvDissInt.at(pBead->GetType()).at((*iterBead2)->GetType())*wr2;
-
-						dissForce	= -gammap*rdotv;				
-						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+					wr = (1.0 - dr/drdmax);
 
-						newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
-						newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
-						newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
+					(*iterBead1)->AddLGDensity(wr*wr);
+					(*iterBead2)->AddLGDensity(wr*wr);
+				}
+			}
+		}
+	}
+}
 
-#elif SimIdentifier == MD
+// Function to zero the local bead density of the beads in the cell before
+// the densities are accumulated by UpdateLGDensity().
 
-				if( dr2 < m_coradius2 )
-				{		
-					dr = sqrt(dr2);
+void CCNTCell::ZeroLGDensity()
+{
+	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
+	{
+		(*iterBead)->SetLGDensity(0.0);
+	}
+}
 
-					if( dr > 0.000000001 )
-					{
-						// Calculate common factors in the LJ potential and include shifted force.
-						// Note that the shifted force term needs to be multiplied by the 
-						// unit vector in the bead-bead separation whereas the force term 
-						// has the full vector.
+// Function a cell uses to calculate non-bonded, bead-bead forces between
+// beads in the current cell and its neighbouring cells that belong to adjacent
+// processors and that may be either instances of CCNTCell or CExternalCNTCell.
+// It is only used in parallel runs.
+//
+// Depending on its position in the owning processor's Border region, the cell
+// has a specific number of external cell neighbours that are hardwired into
+// its m_aExtNNCells[] array. These instances are CExternalCNTCell pointers not
+// CCNTCell pointers. Hence, we iterate over them retrieving the bead data that
+// has been collected there by the mpsSimBox before the force loop is entered.
+// Bead data are collected simply as (id, type, x, y, z, vx, vy, vz) and used to
+// calculate the forces on the beads in the current cell. The forces are then also
+// stored using the ids of the beads belonging to the adjacent processor so that they
+// can be sent back to update the other processor's beads.
+//
+// As for UpdateForce(), the loop is specialised for the simulation type and
+// bead radii flag by SelectForceKernel().
 
-						eLJ       = m_vvLJDepth.at(pBead->GetType()).at((*riterBead2)->GetType());	
-						sLJOverR  = m_vvLJRange.at(pBead->GetType()).at((*riterBead2)->GetType())/dr;
-						sLJR3     = sLJOverR*sLJOverR*sLJOverR;
-						sLJR6     = sLJR3*sLJR3;
+void CCNTCell::UpdateForceP()
+{
+	(this->*m_ForcePKernel)();
+}
 
-						magLJ = (6.0*eLJ*sLJR6*(2.0*sLJR6 - 1.0) 
-								 - dr*m_vvLJSlope.at(pBead->GetType()).at((*riterBead2)->GetType()))/dr2;
+template<long simType, bool bBeadRadii>
+void CCNTCell::UpdateForcePKernel()
+{
+	mpsSimBox::GlobalCellCounter++;
+	
+	long localCellCellCounter = 0;
 
-						// Only add the soft-core potential if the potential depth is non-zero
+	for(BeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
+	{
+		CAbstractBead* const pBead1 = *iterBead1;
 
-						eSC = m_vvSCDepth.at(pBead->GetType()).at((*iterBead2)->GetType());	
+		// First add interactions between beads in the current cell
 
-						if(eSC > 0.0)
-						{
-							sSCOverR = m_vvSCRange.at(pBead->GetType()).at((*riterBead2)->GetType())/dr;
-							sSCR3    = sSCOverR*sSCOverR*sSCOverR;
+		SameCellKernel<simType, bBeadRadii>(pBead1);
 
-							magSC = (9.0*eSC*sSCR3*sSCR3*sSCR3
-									 - dr*m_vvSCSlope.at(pBead->GetType()).at((*riterBead2)->GetType()))/dr2;
-						}
-						else
-						{
-							magSC = 0.0;
-						}
+		// Now we iterate over the neighbouring cells calling different functions
+		// depending on whether each neighbour is internal or external
 
-						newForce[0] = (magLJ + magSC)*dx[0];
-						newForce[1] = (magLJ + magSC)*dx[1];
-						newForce[2] = (magLJ + magSC)*dx[2];
+#if SimDimension == 2
+		for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+		for( int i=0; i<13; i++ )
 #endif
+		{
+		    localCellCellCounter++;
+			
+            CCNTCell* const pNNCell = m_aIntNNCells[i];
 
-//		if((pBead->GetId() == targetBeadId || (*iterBead2)->GetId() == targetBeadId))
-//		{
-//			std::cout << "CNTCell " << GetId() << " calculating internal force with NN cell " << " for its beads " << pBead->GetId() << " " << (*iterBead2)->GetId() << zEndl;
-//		}
-
-					    pBead->m_ForceCounter++;
-					    (*iterBead2)->m_ForceCounter++;
-						
-						pBead->m_Force[0] += newForce[0];
-						pBead->m_Force[1] += newForce[1];
-						pBead->m_Force[2] += newForce[2];
-
-						(*iterBead2)->m_Force[0] -= newForce[0];
-						(*iterBead2)->m_Force[1] -= newForce[1];
-						(*iterBead2)->m_Force[2] -= newForce[2];
-
-						// stress tensor summation
+            pNNCell->UpdateForceBetweenCells(IsExternal(), pBead1);
+        }
+    }
 
-						pBead->m_Stress[0] += dx[0]*newForce[0];
-						pBead->m_Stress[1] += dx[1]*newForce[0];
-						pBead->m_Stress[2] += dx[2]*newForce[0];
-						pBead->m_Stress[3] += dx[0]*newForce[1];
-						pBead->m_Stress[4] += dx[1]*newForce[1];
-						pBead->m_Stress[5] += dx[2]*newForce[1];
-						pBead->m_Stress[6] += dx[0]*newForce[2];
-						pBead->m_Stress[7] += dx[1]*newForce[2];
-						pBead->m_Stress[8] += dx[2]*newForce[2];
+	if(m_lBeads.size() > 0)
+	{
+	    localCellCellCounter /= m_lBeads.size();
+	}
+	else
+	{
+	    localCellCellCounter = 13;
+	}
+	
+    mpsSimBox::GlobalCellCellIntCounter += localCellCellCounter;
+}
 
-						// Pass the stress tensor components to the CMonitor
-						// for use in analysing the stress over slices.
-						// Note that dx[2] might be close to zero and we should
-						// check for this.
+// VF used by this class to calculate forces between beads in two adjacent
+// cells that are both internal to one processor. The argument is a pointer
+// to a bead in the original cell being iterated over within UpdateForceP(), 
+// and the current cell is one of the nearest-neighbours of the original cell.
+// We perform the loop over all the beads in the current cell calculating their
+// forces with the original particle. The PBCs are only applied if both cells
+// are external.
 
-					// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-						m_pMonitor->AddBeadStress(pBead, *iterBead2, newForce, dx);
-#endif
-					}
-					else
-					{
-						TraceInt("neighbour cell bead", pBead->GetId());
-						TraceInt("interacts with", (*iterBead2)->GetId());
-						TraceVector("1st pos",	pBead->GetXPos(),
-												pBead->GetYPos(), 
-												pBead->GetZPos() );
-						TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
-												(*iterBead2)->GetYPos(), 
-												(*iterBead2)->GetZPos() );
-						TraceDouble("Bead distance", dr);
-					}
-				}
-			}
-#endif
+void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBead)
+{
+	(this->*m_BetweenCellsKernel[m_bExternal && bExternal])(pBead);
 }
 
 
+
@@ -20,10 +20,12 @@ class CCNTCell : public CAbstractCell
 {
 	// friend functions of the CMonitor class needed to calculate observables
 	// and time series data for output. And the CExternalCNTCell class needs
-    // to copy data from the original CNT cells.
+    // to copy data from the original CNT cells. The CCNTCellBeadStore copies
+    // the bead lists and simulation constants for the DPD force loop.
 
 	friend class CMonitor;
     friend class CExternalCNTCell;
+    friend class CCNTCellBeadStore;
 
 	// ****************************************
 	// Construction/Destruction: base class has protected constructor
@@ -49,6 +51,15 @@ public:
 	static double Gasdev();
 	static double Expdev();
 
+	// Counter-based random numbers that depend only on the RNG seed, the
+	// current time step and the (unordered) pair of bead ids. They do not 
+	// advance the main RNG, so any thread can generate the random number for 
+	// a given bead pair independently of all others.
+
+	static double GetPairRandomNo(long id1, long id2);
+	static double GetPairRandomNo(uint64_t rngKey, uint64_t rngStep, long id1, long id2);
+	static double GetPairGaussRandomNo(long id1, long id2);
+
 	static const zString GetRandomString();
 	static const zString GetRandomString(const zString prefix, const zString separator);
 	static const zString GetRandomString(const zString prefix, const zString separator, long counter);
@@ -63,6 +74,8 @@ public:
 
 	static void SetRNGSeed(long idum);
 
+	static void SetRNGTimeStep(long step);
+
 	static void SetSimBoxLengths(long nx, long ny, long nz, double cntlx, double cntly, double cntlz);
 
 	static void SetTimeStepConstants(double dt, double lambda, double cutoffradius, double kT);
@@ -103,6 +116,39 @@ public:
 
 	static void AddDPDBeadType(long oldType);
 
+	// Select the DPD integration scheme. The split schemes remove the
+	// dissipative and random forces from UpdateForce() and thermalise the
+	// bead pairs in UpdateThermostat() instead.
+
+	enum DPDIntegrator {DPDVelocityVerlet = 0, DPDShardlow = 1, DPDLoweAndersen = 2};
+
+	static void SetDPDIntegrator(long integrator);
+
+	static inline long GetDPDIntegrator()     {return m_DPDIntegrator;}
+	static inline bool IsDPDThermostatSplit() {return m_DPDIntegrator != DPDVelocityVerlet;}
+
+	// Flag showing if the DPD beads have their own interaction radii. The
+	// CCNTCellBeadStore and the split-scheme thermostat both use it, so that 
+	// the force and thermostat cutoffs of a bead pair are the same.
+
+	static inline bool UsesBeadRadii() {return m_bBeadRadii;}
+
+	static void SetBeadRadii(bool bBeadRadii) {m_bBeadRadii = bBeadRadii;}
+
+	// Select the force kernels for the simulation type returned by 
+	// xxBase::GetSimIdentifier() and the bead radii flag. It must be called 
+	// once both are known and before the first force calculation.
+
+	static void SelectForceKernel();
+
+	// Non-bonded force between a pair of beads, specialised for the simulation
+	// type and bead radii flag. It is used by the force kernels here and by 
+	// the CExternalCNTCell.
+
+	template<long simType, bool bBeadRadii>
+	static bool PairForce(long type1, long type2, double drmax, const double dx[3], 
+	                      const double dv[3], double dr2, double newForce[3]);
+
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
 public:
@@ -129,6 +175,7 @@ public:
 	void UpdateForce();
 	void UpdateMom();
 	void UpdatePos();
+	void UpdateThermostat();
 
     // Parallel versions of the updating functions
 
@@ -138,6 +185,7 @@ public:
 
 	void UpdateLGForce();
 	void UpdateLGDensity();
+	void ZeroLGDensity();
 
 	// Function to calculate the kinetic and potential energy of the cell including
 	// both interactions within the cell and with its immediate neighbours
@@ -168,87 +216,123 @@ private:
 
 	double GetExternalRandomNumber();  // Helper function to RNG tests
 
+	static void ThermostatPair(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3], double noise);
+
     static uint32_t lcg(uint64_t &state);  // Internal helper function for RNG
 
+    static void philox(uint32_t counter[4], uint32_t key[2]);  // Internal helper function for the counter-based RNG
+
+	// Force kernels specialised for the simulation type, the bead radii flag,
+	// and whether the PBCs need to be tested. SelectForceKernel() stores
+	// pointers to the specialisations used by the current simulation.
+
+	typedef void (CCNTCell::*ForceKernel)();
+	typedef void (CCNTCell::*PairKernel)(CAbstractBead* const pBead);
+
+	template<long simType, bool bBeadRadii, bool bExternal> void UpdateForceKernel();
+	template<long simType, bool bBeadRadii> void UpdateForcePKernel();
+	template<long simType, bool bBeadRadii> void SameCellKernel(CAbstractBead* const pBead1);
+	template<long simType, bool bBeadRadii, bool bWrap> void BetweenCellsKernel(CAbstractBead* const pBead1);
+	template<bool bExternal> void UpdateLGForceKernel();
+
+	static void AddPairForce(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3], double newForce[3]);
+
+	static bool PairPotential(long beadType1, long beadType2, double drmax, double dr2, double& pe);
+
 	// ****************************************
 	// Data members
 private:
+
+	// The static members that depend on the simulation are thread_local so that
+	// a CEnsemble can run several simulations in one process. Threads that work
+	// on behalf of a simulation, such as the CCNTCellBeadStore's force threads,
+	// must be given copies of the values they need.
 	
-    static bool   m_bReadFileOnce;           // Flag showing if external random number file should be read once only
-    static long   m_NextRNIndex;             // Index of next random number to use
-    static zDoubleVector m_RandomNumbers;    // Externally-generated random numbers for testing
+    static thread_local bool   m_bReadFileOnce;           // Flag showing if external random number file should be read once only
+    static thread_local long   m_NextRNIndex;             // Index of next random number to use
+    static thread_local zDoubleVector m_RandomNumbers;    // Externally-generated random numbers for testing
     static long   m_StringSize;              // Default size of randomly-generated strings
     static const zString m_StringSeparator;  // Separator character used in random strings
     static const zString m_AlphabetChars;    // Set of characters that can be in the first position of a type name
 
-	static double m_SimBoxXLength;
-	static double m_SimBoxYLength;
-	static double m_SimBoxZLength;
-	static double m_HalfSimBoxXLength;
-	static double m_HalfSimBoxYLength;
-	static double m_HalfSimBoxZLength;
-
-	static long m_CNTXCellNo;
-	static long m_CNTYCellNo;
-	static long m_CNTZCellNo;
-	static double m_CNTXCellWidth;
-	static double m_CNTYCellWidth;
-	static double m_CNTZCellWidth;
-
-	static double m_dt;
-	static double m_lambda;
-	static double m_cutoffradius;		// Potential cut-off radius for both DPD and MD
-	static double m_coradius2;			// Square of cut-off radius
-	static double m_kT;
-	static double m_halfdt;
-	static double m_halfdt2;
-	static double m_invrootdt;
-	static double m_lamdt;
-    static double m_lgnorm;            // Constant part of DPD density-dependent force prefactor
-
-    static double m_dtoverkt;          // Prefactor of the BD force term: not including diffusion constant
-    static double m_dispmag;           // Prefactor of the BD displacement term: not including diffusion constant
-
-    static uint64_t m_RNGSeed;   // 64-bit seed for the lcg RNG
+	static thread_local double m_SimBoxXLength;
+	static thread_local double m_SimBoxYLength;
+	static thread_local double m_SimBoxZLength;
+	static thread_local double m_HalfSimBoxXLength;
+	static thread_local double m_HalfSimBoxYLength;
+	static thread_local double m_HalfSimBoxZLength;
+
+	static thread_local long m_CNTXCellNo;
+	static thread_local long m_CNTYCellNo;
+	static thread_local long m_CNTZCellNo;
+	static thread_local double m_CNTXCellWidth;
+	static thread_local double m_CNTYCellWidth;
+	static thread_local double m_CNTZCellWidth;
+
+	static thread_local double m_dt;
+	static thread_local double m_lambda;
+	static thread_local double m_cutoffradius;		// Potential cut-off radius for both DPD and MD
+	static thread_local double m_coradius2;			// Square of cut-off radius
+	static thread_local double m_kT;
+	static thread_local double m_halfdt;
+	static thread_local double m_halfdt2;
+	static thread_local double m_invrootdt;
+	static thread_local double m_lamdt;
+    static thread_local double m_lgnorm;            // Constant part of DPD density-dependent force prefactor
+
+    static thread_local double m_dtoverkt;          // Prefactor of the BD force term: not including diffusion constant
+    static thread_local double m_dispmag;           // Prefactor of the BD displacement term: not including diffusion constant
+
+    static thread_local uint64_t m_RNGSeed;   // 64-bit seed for the lcg RNG
+    static thread_local uint64_t m_PairRNGKey;      // Key for the counter-based RNG: the user-supplied seed
+    static thread_local uint64_t m_PairRNGStep;     // Time step used in the counter of the counter-based RNG
     static long double m_2Power32;         // 2**32
     static long double m_Inv2Power32;      // Inverse of 2**32
 
-	static CMonitor* m_pMonitor;	// Pointer to CMonitor to allow on-the-fly analysis
-	static ISimBox*  m_pISimBox;	// Pointer to ISimBox to allow on-the-fly analysis
+	static thread_local CMonitor* m_pMonitor;	// Pointer to CMonitor to allow on-the-fly analysis
+	static thread_local ISimBox*  m_pISimBox;	// Pointer to ISimBox to allow on-the-fly analysis
 
 	// Bead internal structure data including bead-bead interaction matrices
 	// for all simulation types: DPD, MD. We use static pointers so that we
 	// can initialize them but then copy the vectors into local storage in the 
 	// constructor to avoid having to dereference the pointers all the time.
 
-	static const zArray2dDouble* m_pvvConsInt;	// DPD
-	static const zArray2dDouble* m_pvvDissInt;
-	static const zArray2dDouble* m_pvvLGInt;
+	static thread_local const zArray2dDouble* m_pvvConsInt;	// DPD
+	static thread_local const zArray2dDouble* m_pvvDissInt;
+	static thread_local const zArray2dDouble* m_pvvLGInt;
 
-	static const zArray2dDouble* m_pvvLJDepth;	// MD
-	static const zArray2dDouble* m_pvvLJRange;
-	static const zArray2dDouble* m_pvvSCDepth;
-	static const zArray2dDouble* m_pvvSCRange;
+	static thread_local const zArray2dDouble* m_pvvLJDepth;	// MD
+	static thread_local const zArray2dDouble* m_pvvLJRange;
+	static thread_local const zArray2dDouble* m_pvvSCDepth;
+	static thread_local const zArray2dDouble* m_pvvSCRange;
 
 	// Static arrays to hold the above data without requiring a dereference
 
-	static zArray2dDouble m_vvConsInt;		// DPD
-	static zArray2dDouble m_vvDissInt;
-	static zArray2dDouble m_vvLGInt;
+	static thread_local zArray2dDouble m_vvConsInt;		// DPD
+	static thread_local zArray2dDouble m_vvDissInt;
+	static thread_local zArray2dDouble m_vvLGInt;
+
+	static thread_local zArray2dDouble m_vvConsIntBackup;	// DPD zero force array
+	static thread_local zArray2dDouble m_vvDissIntBackup;
+	static thread_local zArray2dDouble m_vvLGIntBackup;
+
+	static thread_local long           m_DPDIntegrator;		// DPD integration scheme
+	static thread_local zArray2dDouble m_vvSplitDissInt;	// Dissipation parameters used by a split scheme
+	static thread_local bool           m_bBeadRadii;		// Flag showing if beads use their own radii
 
-	static zArray2dDouble m_vvConsIntBackup;	// DPD zero force array
-	static zArray2dDouble m_vvDissIntBackup;
-	static zArray2dDouble m_vvLGIntBackup;
+	static thread_local ForceKernel    m_ForceKernel[2];		// UpdateForce() kernels for internal and external cells
+	static thread_local ForceKernel    m_ForcePKernel;			// UpdateForceP() kernel
+	static thread_local PairKernel     m_BetweenCellsKernel[2];	// UpdateForceBetweenCells() kernels without and with PBCs
 
-	static zArray2dDouble m_vvLJDepth;	// MD
-	static zArray2dDouble m_vvLJRange;
-	static zArray2dDouble m_vvSCDepth;
-	static zArray2dDouble m_vvSCRange;
+	static thread_local zArray2dDouble m_vvLJDepth;	// MD
+	static thread_local zArray2dDouble m_vvLJRange;
+	static thread_local zArray2dDouble m_vvSCDepth;
+	static thread_local zArray2dDouble m_vvSCRange;
 
-	static zArray2dDouble m_vvLJDelta;	// Shift in LJ potential 
-	static zArray2dDouble m_vvLJSlope;   // Slope of shifted LJ potential
-	static zArray2dDouble m_vvSCDelta;	// Ditto for SC potential
-	static zArray2dDouble m_vvSCSlope;
+	static thread_local zArray2dDouble m_vvLJDelta;	// Shift in LJ potential 
+	static thread_local zArray2dDouble m_vvLJSlope;   // Slope of shifted LJ potential
+	static thread_local zArray2dDouble m_vvSCDelta;	// Ditto for SC potential
+	static thread_local zArray2dDouble m_vvSCSlope;
 
 	// Local data members
 
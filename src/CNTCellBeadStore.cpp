@@ -0,0 +1,1773 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// CNTCellBeadStore.cpp: implementation of the CCNTCellBeadStore class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "SimMathFlags.h"
+#include "SimMiscellaneousFlags.h"
+#include "SimMPSFlags.h"
+#include "CNTCellBeadStore.h"
+#include "CNTCell.h"
+#include "AbstractBead.h"
+#include "ISimBox.h"
+#include "Monitor.h"			// Needed to receive stress tensor contributions for analysis
+
+// The batched SIMD pair kernel uses AVX2 intrinsics in functions compiled for 
+// that instruction set alone, so the rest of the code does not depend on it.
+// Whether it is used is decided at runtime from the CPU's capabilities.
+
+#if EnableSIMDPairKernel == SimMiscEnabled && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define UseAVX2PairKernel
+	#include <immintrin.h>
+#endif
+
+#if defined(UseAVX2PairKernel)
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Scratch data and AVX2 functions used by the batched SIMD pair kernel. They
+// are hidden in an anonymous namespace as they are only needed in this file.
+// Each thread has its own scratch data, which only grows, so the kernel does
+// not allocate memory once the largest neighbourhood has been seen.
+
+namespace
+{
+	struct PairBatch
+	{
+		// Candidate beads of the current cell: the cell's own beads in reverse
+		// order followed by the beads in its half-shell of neighbouring cells.
+		// The arrays are padded to a whole number of SIMD vectors.
+
+		zLongVector   slot;
+		zDoubleVector x;
+		zDoubleVector y;
+		zDoubleVector z;
+		zDoubleVector pbc;					// 1 if the PBCs apply to the candidate, 0 otherwise
+
+		zDoubleVector dx;					// Separation of the first bead from each candidate
+		zDoubleVector dy;
+		zDoubleVector dz;
+		zDoubleVector dr2;
+		zLongVector   inRange;				// Bit mask of candidates within range for each vector
+
+		zLongVector   pairSlot;				// Data for the pairs within range
+		zDoubleVector pairDx;
+		zDoubleVector pairDy;
+		zDoubleVector pairDz;
+		zDoubleVector pairDr;
+		zDoubleVector pairDvx;
+		zDoubleVector pairDvy;
+		zDoubleVector pairDvz;
+		zDoubleVector cons;
+		zDoubleVector diss;
+		zDoubleVector randNo;
+		zDoubleVector fx;
+		zDoubleVector fy;
+		zDoubleVector fz;
+
+		void Reserve(long total)
+		{
+			const unsigned long size = 4*((total+3)/4);
+
+			if(size > slot.size())
+			{
+				slot.resize(size);
+				x.resize(size);
+				y.resize(size);
+				z.resize(size);
+				pbc.resize(size);
+				dx.resize(size);
+				dy.resize(size);
+				dz.resize(size);
+				dr2.resize(size);
+				inRange.resize(size/4);
+				pairSlot.resize(size);
+				pairDx.resize(size);
+				pairDy.resize(size);
+				pairDz.resize(size);
+				pairDr.resize(size);
+				pairDvx.resize(size);
+				pairDvy.resize(size);
+				pairDvz.resize(size);
+				cons.resize(size);
+				diss.resize(size);
+				randNo.resize(size);
+				fx.resize(size);
+				fy.resize(size);
+				fz.resize(size);
+			}
+		}
+	};
+
+	thread_local PairBatch tlPairBatch;
+
+	// Function to calculate the separations of a bead from all candidates of
+	// its cell, four at a time, applying the PBCs in the lanes whose candidate 
+	// requires them. The lanes that lie within unit range are recorded as a 
+	// bit mask for each vector, and the lanes beyond the last candidate are 
+	// excluded from the masks.
+
+	__attribute__((target("avx2")))
+	void GetCandidateSeparationsAVX2(PairBatch& rBatch, const double pos1[3], long total, 
+									 const double length[3], const double halfLength[3])
+	{
+		const __m256d x1    = _mm256_set1_pd(pos1[0]);
+		const __m256d y1    = _mm256_set1_pd(pos1[1]);
+		const __m256d lx    = _mm256_set1_pd(length[0]);
+		const __m256d hx    = _mm256_set1_pd(halfLength[0]);
+		const __m256d mhx   = _mm256_set1_pd(-halfLength[0]);
+		const __m256d ly    = _mm256_set1_pd(length[1]);
+		const __m256d hy    = _mm256_set1_pd(halfLength[1]);
+		const __m256d mhy   = _mm256_set1_pd(-halfLength[1]);
+#if SimDimension == 3
+		const __m256d z1    = _mm256_set1_pd(pos1[2]);
+		const __m256d lz    = _mm256_set1_pd(length[2]);
+		const __m256d hz    = _mm256_set1_pd(halfLength[2]);
+		const __m256d mhz   = _mm256_set1_pd(-halfLength[2]);
+#endif
+		const __m256d one   = _mm256_set1_pd(1.0);
+		const __m256d halfOne = _mm256_set1_pd(0.5);
+
+		for(long k=0; k<total; k+=4)
+		{
+			const __m256d pbc = _mm256_cmp_pd(_mm256_loadu_pd(&rBatch.pbc[k]), halfOne, _CMP_GT_OQ);
+
+			__m256d dx = _mm256_sub_pd(x1, _mm256_loadu_pd(&rBatch.x[k]));
+			__m256d dy = _mm256_sub_pd(y1, _mm256_loadu_pd(&rBatch.y[k]));
+
+			dx = _mm256_blendv_pd(dx, _mm256_sub_pd(dx, lx), _mm256_and_pd(pbc, _mm256_cmp_pd(dx, hx,  _CMP_GT_OQ)));
+			dx = _mm256_blendv_pd(dx, _mm256_add_pd(dx, lx), _mm256_and_pd(pbc, _mm256_cmp_pd(dx, mhx, _CMP_LT_OQ)));
+			dy = _mm256_blendv_pd(dy, _mm256_sub_pd(dy, ly), _mm256_and_pd(pbc, _mm256_cmp_pd(dy, hy,  _CMP_GT_OQ)));
+			dy = _mm256_blendv_pd(dy, _mm256_add_pd(dy, ly), _mm256_and_pd(pbc, _mm256_cmp_pd(dy, mhy, _CMP_LT_OQ)));
+
+#if SimDimension == 2
+			const __m256d dz = _mm256_setzero_pd();
+#elif SimDimension == 3
+			__m256d dz = _mm256_sub_pd(z1, _mm256_loadu_pd(&rBatch.z[k]));
+
+			dz = _mm256_blendv_pd(dz, _mm256_sub_pd(dz, lz), _mm256_and_pd(pbc, _mm256_cmp_pd(dz, hz,  _CMP_GT_OQ)));
+			dz = _mm256_blendv_pd(dz, _mm256_add_pd(dz, lz), _mm256_and_pd(pbc, _mm256_cmp_pd(dz, mhz, _CMP_LT_OQ)));
+#endif
+
+			const __m256d dr2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+
+			_mm256_storeu_pd(&rBatch.dx[k],  dx);
+			_mm256_storeu_pd(&rBatch.dy[k],  dy);
+			_mm256_storeu_pd(&rBatch.dz[k],  dz);
+			_mm256_storeu_pd(&rBatch.dr2[k], dr2);
+
+			const long lanes = (total - k < 4) ? (total - k) : 4;
+
+			rBatch.inRange[k/4] = _mm256_movemask_pd(_mm256_cmp_pd(dr2, one, _CMP_LT_OQ)) & ((1 << lanes) - 1);
+		}
+	}
+
+	// Function to calculate the DPD forces for the pairs within range, four at
+	// a time. The operations are the same, and in the same order, as in the 
+	// scalar kernel. Unused lanes in the final vector are given a unit 
+	// separation so that they do not generate floating-point exceptions.
+
+	__attribute__((target("avx2")))
+	void GetPairForcesAVX2(PairBatch& rBatch, long total, double invrootdt)
+	{
+		for(long k=total; k<4*((total+3)/4); k++)
+		{
+			rBatch.pairDx[k]  = 0.0;
+			rBatch.pairDy[k]  = 0.0;
+			rBatch.pairDz[k]  = 0.0;
+			rBatch.pairDr[k]  = 1.0;
+			rBatch.pairDvx[k] = 0.0;
+			rBatch.pairDvy[k] = 0.0;
+			rBatch.pairDvz[k] = 0.0;
+			rBatch.cons[k]    = 0.0;
+			rBatch.diss[k]    = 0.0;
+			rBatch.randNo[k]  = 0.5;
+		}
+
+		const __m256d one      = _mm256_set1_pd(1.0);
+		const __m256d half     = _mm256_set1_pd(0.5);
+		const __m256d signBit  = _mm256_set1_pd(-0.0);
+		const __m256d rootdt   = _mm256_set1_pd(invrootdt);
+
+		for(long k=0; k<total; k+=4)
+		{
+			const __m256d dx = _mm256_loadu_pd(&rBatch.pairDx[k]);
+			const __m256d dy = _mm256_loadu_pd(&rBatch.pairDy[k]);
+			const __m256d dz = _mm256_loadu_pd(&rBatch.pairDz[k]);
+			const __m256d dr = _mm256_loadu_pd(&rBatch.pairDr[k]);
+			const __m256d dv = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, _mm256_loadu_pd(&rBatch.pairDvx[k])), 
+														   _mm256_mul_pd(dy, _mm256_loadu_pd(&rBatch.pairDvy[k]))), 
+														   _mm256_mul_pd(dz, _mm256_loadu_pd(&rBatch.pairDvz[k])));
+			const __m256d wr  = _mm256_sub_pd(one, dr);
+			const __m256d wr2 = _mm256_mul_pd(wr, wr);
+
+			const __m256d conForce  = _mm256_mul_pd(_mm256_loadu_pd(&rBatch.cons[k]), wr);
+			const __m256d rdotv     = _mm256_div_pd(dv, dr);
+			const __m256d gammap    = _mm256_mul_pd(_mm256_loadu_pd(&rBatch.diss[k]), wr2);
+			const __m256d dissForce = _mm256_mul_pd(_mm256_xor_pd(gammap, signBit), rdotv);
+			const __m256d randForce = _mm256_mul_pd(_mm256_mul_pd(_mm256_sqrt_pd(gammap), rootdt), 
+													_mm256_sub_pd(half, _mm256_loadu_pd(&rBatch.randNo[k])));
+
+			const __m256d force = _mm256_add_pd(_mm256_add_pd(conForce, dissForce), randForce);
+
+			_mm256_storeu_pd(&rBatch.fx[k], _mm256_div_pd(_mm256_mul_pd(force, dx), dr));
+			_mm256_storeu_pd(&rBatch.fy[k], _mm256_div_pd(_mm256_mul_pd(force, dy), dr));
+			_mm256_storeu_pd(&rBatch.fz[k], _mm256_div_pd(_mm256_mul_pd(force, dz), dr));
+		}
+	}
+}
+
+#endif
+
+// The mixed-precision pair kernel calculates the separations of a batch of
+// candidate beads before any of them is tested against the interaction range.
+
+namespace
+{
+	const long MixedPairBatchSize = 64;	// Maximum number of candidate pairs per batch
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// The CNT cell network is fixed once the CSimBox has created it, so we store
+// the half-shell neighbours of each cell as indices into the cell vector
+// together with a flag showing whether the PBCs have to be applied to the
+// pair of cells. This replicates the test in CCNTCell::UpdateForce() that
+// applies the PBCs only when both cells are external.
+//
+// The store starts with a single thread. Additional threads are only 
+// created by a call to SetThreadTotal().
+//
+// The force kernels used by the serial and threaded loops are selected here.
+// The CSimBox passes in the CCNTCell's bead radii flag as bBeadRadii. If it
+// is set the kernels use the sum of the two beads' radii as the range of 
+// each pair; otherwise the range is unity. The forces are
+// calculated in double precision until SetMixedPrecision() is called.
+
+CCNTCellBeadStore::CCNTCellBeadStore(const CNTCellVector& rvCells, bool bBeadRadii) : m_rvCells(rvCells),
+									m_CellTotal(rvCells.size()),
+#if SimDimension == 2
+									m_NNTotal(4),
+#elif SimDimension == 3
+									m_NNTotal(13),
+#endif
+									m_BeadTotal(0), m_TypeTotal(0),
+									m_bBeadRadii(bBeadRadii),
+									m_pSerialKernel(0), m_pThreadedKernel(0),
+									m_VerletSkin(0.0), m_ListMaxRadius(0.0), m_bListValid(false),
+									m_bMixedPrecision(false), m_bMixedKernel(false),
+									m_ThreadTotal(1), m_RowLength(CCNTCell::m_CNTXCellNo),
+									m_StartCounter(0), m_DoneTotal(0),
+									m_BarrierTotal(0), m_BarrierCounter(0),
+									m_bStopWorkers(false)
+{
+	CopyCellConstants();
+
+	m_vCellStart.resize(m_CellTotal+1, 0);
+	m_vNNCells.resize(m_NNTotal*m_CellTotal, 0);
+	m_vNNPBC.resize(m_NNTotal*m_CellTotal, false);
+	m_vCellPairStart.resize(m_CellTotal+1, 0);
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		const CCNTCell* const pCell = m_rvCells.at(ic);
+
+		for(long i=0; i<m_NNTotal; i++)
+		{
+			const CCNTCell* const pNNCell = pCell->GetIntNNCell(i);
+
+			m_vNNCells.at(m_NNTotal*ic+i) = pNNCell->GetId();
+			m_vNNPBC.at(m_NNTotal*ic+i)   = pCell->IsExternal() && pNNCell->IsExternal();
+		}
+	}
+
+	MakeRowColours(3, 2);
+
+	SelectKernels();
+}
+
+CCNTCellBeadStore::~CCNTCellBeadStore()
+{
+	StopThreads();
+}
+
+// Function to set the number of threads used to calculate the non-bonded 
+// forces. Any existing worker threads are stopped and a new set created.
+// The CMonitor is told to create a slice stress buffer for each thread, so 
+// that the threads can add their bead-bead stress contributions without 
+// contention. If the stress tensor sphere is compiled in, each thread also 
+// records its pairs for each colour separately so that they can be passed 
+// to the CSimBox in a fixed order.
+//
+// A single thread uses the serial loop and the main RNG, and gives results 
+// identical to the list-based force loop.
+
+void CCNTCellBeadStore::SetThreadTotal(long threads)
+{
+	StopThreads();
+
+	m_ThreadTotal = (threads > 1) ? threads : 1;
+
+#if EnableParallelSimBox == SimMPSDisabled
+	CCNTCell::m_pMonitor->SetSliceStressThreadTotal(m_ThreadTotal);
+#endif
+
+	m_vPairs.clear();
+	m_vPairs.resize((m_vColourStart.size() - 1)*m_ThreadTotal);
+
+	if(m_ThreadTotal > 1)
+	{
+		StartThreads();
+	}
+}
+
+// Function to set the skin used for the Verlet pair list. A positive skin 
+// replaces the search of each cell's half-shell of neighbours by a list of 
+// the bead pairs whose separation is less than the interaction range plus 
+// the skin. The list is built from the CNT cells and is only rebuilt when a
+// bead has moved more than half the skin since it was built, as no pair that
+// is out of range of the list can have come within the interaction range 
+// before then. A zero skin restores the cell-based search.
+//
+// The pairs are visited in a different order from the cell-based loop, so 
+// the trajectories are statistically equivalent to, but not identical with,
+// those of the list-based force loop.
+
+void CCNTCellBeadStore::SetVerletSkin(double skin)
+{
+	m_VerletSkin = (skin > 0.0) ? skin : 0.0;
+	m_bListValid = false;
+
+	if(m_VerletSkin == 0.0)
+	{
+		MakeRowColours(3, 2);
+	}
+
+	SelectKernels();
+}
+
+// Function to select whether the pair forces are calculated in mixed or
+// double precision. Mixed precision is only implemented for the cell-based
+// loop with beads of unit interaction range, and it relies on each cell's 
+// neighbours being distinct cells, so the store falls back to the double
+// precision kernels if a Verlet skin is set, if the beads have their own 
+// radii, or if the SimBox has fewer than three CNT cells in any dimension.
+// The request is remembered, so mixed precision is used again if the Verlet
+// skin is later set to zero.
+//
+// Because the pair forces are rounded differently, and pairs very close to 
+// the cutoff may be accepted or rejected differently, the trajectory is 
+// statistically equivalent to, but not identical with, that of the double
+// precision loop.
+
+void CCNTCellBeadStore::SetMixedPrecision(bool bMixed)
+{
+	m_bMixedPrecision = bMixed;
+
+	if(m_bMixedPrecision)
+	{
+		MakeNeighbourShifts();
+	}
+
+	SelectKernels();
+}
+
+// Function to copy the beads out of the CNT cells into the contiguous arrays.
+// The beads are stored cell by cell, and in the order they occur in each
+// cell's bead list, so that slot indices preserve the iteration order of the
+// list-based force loop. Because beads move between cells during every call 
+// to CCNTCell::UpdatePos(), the store must be re-sorted after the positions 
+// have been updated and before the forces are calculated.
+//
+// We also copy the current bead forces and force counters so that the 
+// pair forces are accumulated onto exactly the same starting values as 
+// in CCNTCell::UpdateForce().
+//
+// If the Verlet pair list is in use the slot indices must not change while
+// the list is valid, so the beads are copied into their existing slots 
+// instead. The beads are only re-sorted, and the list rebuilt, when one of
+// them has moved too far or the number of beads has changed.
+
+void CCNTCellBeadStore::Sort()
+{
+	if(m_bListValid && Gather())
+	{
+		CopyInteractions();
+		return;
+	}
+
+	long beadTotal = 0;
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		m_vCellStart[ic] = beadTotal;
+		beadTotal += m_rvCells[ic]->m_lBeads.size();
+	}
+	m_vCellStart[m_CellTotal] = beadTotal;
+
+	if(beadTotal != m_BeadTotal)
+	{
+		m_BeadTotal = beadTotal;
+
+		m_vBeads.resize(m_BeadTotal, 0);
+		m_vId.resize(m_BeadTotal, 0);
+		m_vType.resize(m_BeadTotal, 0);
+		m_vXPos.resize(m_BeadTotal, 0.0);
+		m_vYPos.resize(m_BeadTotal, 0.0);
+		m_vZPos.resize(m_BeadTotal, 0.0);
+		m_vXMom.resize(m_BeadTotal, 0.0);
+		m_vYMom.resize(m_BeadTotal, 0.0);
+		m_vZMom.resize(m_BeadTotal, 0.0);
+		m_vXForce.resize(m_BeadTotal, 0.0);
+		m_vYForce.resize(m_BeadTotal, 0.0);
+		m_vZForce.resize(m_BeadTotal, 0.0);
+		m_vStress.resize(9*m_BeadTotal, 0.0);
+		m_vForceCounter.resize(m_BeadTotal, 0);
+		if(m_bBeadRadii)
+		{
+			m_vRadius.resize(m_BeadTotal, 0.0);
+		}
+	}
+
+	long slot = 0;
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		const BeadList& rlBeads = m_rvCells[ic]->m_lBeads;
+
+		for(cBeadListIterator iterBead=rlBeads.begin(); iterBead!=rlBeads.end(); iterBead++)
+		{
+			m_vBeads[slot] = *iterBead;
+			CopyBead(slot);
+			slot++;
+		}
+	}
+
+	CopyInteractions();
+
+	if(m_VerletSkin > 0.0)
+	{
+		BuildPairList();
+	}
+
+	if(m_bMixedKernel)
+	{
+		CopyOffsets();
+	}
+}
+
+// Private helper function to copy the data of the bead held in a slot into
+// the arrays.
+
+void CCNTCellBeadStore::CopyBead(long slot)
+{
+	const CAbstractBead* const pBead = m_vBeads[slot];
+
+	m_vId[slot]           = pBead->m_id;
+	m_vType[slot]         = pBead->m_Type;
+	m_vXPos[slot]         = pBead->m_Pos[0];
+	m_vYPos[slot]         = pBead->m_Pos[1];
+	m_vZPos[slot]         = pBead->m_Pos[2];
+	m_vXMom[slot]         = pBead->m_Mom[0];
+	m_vYMom[slot]         = pBead->m_Mom[1];
+	m_vZMom[slot]         = pBead->m_Mom[2];
+	m_vXForce[slot]       = pBead->m_Force[0];
+	m_vYForce[slot]       = pBead->m_Force[1];
+	m_vZForce[slot]       = pBead->m_Force[2];
+	m_vForceCounter[slot] = pBead->m_ForceCounter;
+
+	if(m_bBeadRadii)
+	{
+		m_vRadius[slot]   = pBead->m_Radius;
+	}
+}
+
+// Private function to fill the single-precision arrays used by the mixed 
+// precision kernel. Each bead's position is stored relative to the origin of
+// the CNT cell that holds it, so the offsets are never larger than the cell
+// width and keep the full single-precision resolution.
+
+void CCNTCellBeadStore::CopyOffsets()
+{
+	m_vXOffset.resize(m_BeadTotal, 0.0f);
+	m_vYOffset.resize(m_BeadTotal, 0.0f);
+	m_vZOffset.resize(m_BeadTotal, 0.0f);
+	m_vXMomF.resize(m_BeadTotal, 0.0f);
+	m_vYMomF.resize(m_BeadTotal, 0.0f);
+	m_vZMomF.resize(m_BeadTotal, 0.0f);
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		const double x0 = m_rvCells[ic]->GetBLXCoord();
+		const double y0 = m_rvCells[ic]->GetBLYCoord();
+		const double z0 = m_rvCells[ic]->GetBLZCoord();
+
+		for(long slot=m_vCellStart[ic]; slot<m_vCellStart[ic+1]; slot++)
+		{
+			m_vXOffset[slot] = static_cast<float>(m_vXPos[slot] - x0);
+			m_vYOffset[slot] = static_cast<float>(m_vYPos[slot] - y0);
+			m_vZOffset[slot] = static_cast<float>(m_vZPos[slot] - z0);
+			m_vXMomF[slot]   = static_cast<float>(m_vXMom[slot]);
+			m_vYMomF[slot]   = static_cast<float>(m_vYMom[slot]);
+			m_vZMomF[slot]   = static_cast<float>(m_vZMom[slot]);
+		}
+	}
+}
+
+// Private function to store the separation of each cell's origin from the
+// origins of its half-shell neighbours. If the PBCs apply to a pair of cells
+// the minimum image of the separation is stored, so that adding it to the 
+// difference of two beads' offsets gives their separation with the PBCs 
+// already applied. This is the same as applying the PBCs to each pair of
+// beads provided the SimBox has at least three cells in each dimension.
+
+void CCNTCellBeadStore::MakeNeighbourShifts()
+{
+	m_vNNShift.resize(3*m_NNTotal*m_CellTotal, 0.0f);
+
+	double shift[3];
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		const CCNTCell* const pCell = m_rvCells[ic];
+
+		for(long i=0; i<m_NNTotal; i++)
+		{
+			const long nn = m_NNTotal*ic + i;
+			const CCNTCell* const pNNCell = m_rvCells[m_vNNCells[nn]];
+
+			shift[0] = pCell->GetBLXCoord() - pNNCell->GetBLXCoord();
+			shift[1] = pCell->GetBLYCoord() - pNNCell->GetBLYCoord();
+			shift[2] = pCell->GetBLZCoord() - pNNCell->GetBLZCoord();
+
+			if(m_vNNPBC[nn])
+			{
+				if( shift[0] > CCNTCell::m_HalfSimBoxXLength )
+					shift[0] = shift[0] - CCNTCell::m_SimBoxXLength;
+				else if( shift[0] < -CCNTCell::m_HalfSimBoxXLength )
+					shift[0] = shift[0] + CCNTCell::m_SimBoxXLength;
+
+				if( shift[1] > CCNTCell::m_HalfSimBoxYLength )
+					shift[1] = shift[1] - CCNTCell::m_SimBoxYLength;
+				else if( shift[1] < -CCNTCell::m_HalfSimBoxYLength )
+					shift[1] = shift[1] + CCNTCell::m_SimBoxYLength;
+
+				if( shift[2] > CCNTCell::m_HalfSimBoxZLength )
+					shift[2] = shift[2] - CCNTCell::m_SimBoxZLength;
+				else if( shift[2] < -CCNTCell::m_HalfSimBoxZLength )
+					shift[2] = shift[2] + CCNTCell::m_SimBoxZLength;
+			}
+
+			m_vNNShift[3*nn]   = static_cast<float>(shift[0]);
+			m_vNNShift[3*nn+1] = static_cast<float>(shift[1]);
+			m_vNNShift[3*nn+2] = static_cast<float>(shift[2]);
+		}
+	}
+}
+
+// Private function used when the Verlet pair list is valid to copy the beads
+// into the slots they occupied when the list was built. It returns false if
+// the list has to be rebuilt: because the number of beads in the CNT cells 
+// has changed, because a bead has moved more than half the skin from its 
+// position when the list was built, or because a bead's radius has become
+// larger than those used to build the list. The displacement is calculated
+// using the minimum image convention as beads may have crossed the PBCs.
+
+bool CCNTCellBeadStore::Gather()
+{
+	long beadTotal = 0;
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		beadTotal += m_rvCells[ic]->m_lBeads.size();
+	}
+
+	if(beadTotal != m_BeadTotal)
+		return false;
+
+	const double maxDisp2 = 0.25*m_VerletSkin*m_VerletSkin;
+
+	double dx[3];
+
+	for(long slot=0; slot<m_BeadTotal; slot++)
+	{
+		CopyBead(slot);
+
+		if(m_bBeadRadii && m_vRadius[slot] > m_ListMaxRadius)
+			return false;
+
+		dx[0] = m_vXPos[slot] - m_vXRef[slot];
+		dx[1] = m_vYPos[slot] - m_vYRef[slot];
+		dx[2] = m_vZPos[slot] - m_vZRef[slot];
+
+		if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+			dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+		else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+			dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+
+		if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+			dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+		else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+			dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+
+		if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+			dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+		else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+			dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+
+		if(dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2] > maxDisp2)
+			return false;
+	}
+
+	return true;
+}
+
+// Private function to build the Verlet pair list from the sorted beads. Each
+// pair of beads whose separation is less than the interaction range plus the
+// skin is stored once, in the flat arrays m_vPairFirst and m_vPairSecond, with
+// the bead in the lower slot first. The pairs are grouped by the cell holding
+// their first bead so that the threaded loop can use the same row colouring 
+// as the cell-based loop. Because the list range may exceed the CNT cell 
+// width, each cell is compared with all cells within the number of cells 
+// needed to cover the range in each dimension, and the colouring periods 
+// are increased so that rows of the same colour still write to distinct 
+// beads. The bead positions are stored for checking their displacements.
+
+void CCNTCellBeadStore::BuildPairList()
+{
+	double range = 1.0;
+
+	m_ListMaxRadius = 0.0;
+
+	if(m_bBeadRadii)
+	{
+		for(long slot=0; slot<m_BeadTotal; slot++)
+		{
+			if(m_vRadius[slot] > m_ListMaxRadius)
+				m_ListMaxRadius = m_vRadius[slot];
+		}
+
+		range = 2.0*m_ListMaxRadius;
+	}
+
+	const double listRange  = range + m_VerletSkin;
+	const double listRange2 = listRange*listRange;
+
+	const long xTotal = CCNTCell::m_CNTXCellNo;
+	const long yTotal = CCNTCell::m_CNTYCellNo;
+	const long zTotal = CCNTCell::m_CNTZCellNo;
+
+	const long xReach = static_cast<long>(ceil(listRange/CCNTCell::m_CNTXCellWidth));
+	const long yReach = static_cast<long>(ceil(listRange/CCNTCell::m_CNTYCellWidth));
+#if SimDimension == 2
+	const long zReach = 0;
+#elif SimDimension == 3
+	const long zReach = static_cast<long>(ceil(listRange/CCNTCell::m_CNTZCellWidth));
+#endif
+
+	if(m_ColourYPeriod != 2*yReach+1 || m_ColourZPeriod != 2*zReach+1)
+	{
+		MakeRowColours(2*yReach+1, 2*zReach+1);
+	}
+
+	m_vPairFirst.clear();
+	m_vPairSecond.clear();
+
+	zLongVector vXCells, vYCells, vZCells;
+
+	double dx[3];
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		m_vCellPairStart[ic] = m_vPairFirst.size();
+
+		GetNeighbourIndices(ic%xTotal,            xReach, xTotal, vXCells);
+		GetNeighbourIndices((ic/xTotal)%yTotal,   yReach, yTotal, vYCells);
+		GetNeighbourIndices(ic/(xTotal*yTotal),   zReach, zTotal, vZCells);
+
+		for(long i1=m_vCellStart[ic]; i1<m_vCellStart[ic+1]; i1++)
+		{
+			for(czLongVectorIterator iz=vZCells.begin(); iz!=vZCells.end(); iz++)
+			{
+				for(czLongVectorIterator iy=vYCells.begin(); iy!=vYCells.end(); iy++)
+				{
+					for(czLongVectorIterator ix=vXCells.begin(); ix!=vXCells.end(); ix++)
+					{
+						const long jc = *ix + xTotal*(*iy + yTotal*(*iz));
+
+						for(long i2=m_vCellStart[jc]; i2<m_vCellStart[jc+1]; i2++)
+						{
+							if(i2 <= i1)
+								continue;
+
+							dx[0] = m_vXPos[i1] - m_vXPos[i2];
+							dx[1] = m_vYPos[i1] - m_vYPos[i2];
+							dx[2] = m_vZPos[i1] - m_vZPos[i2];
+
+							if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+								dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+							else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+								dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+
+							if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+								dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+							else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+								dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+
+							if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+								dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+							else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+								dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+
+							if(dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2] < listRange2)
+							{
+								m_vPairFirst.push_back(i1);
+								m_vPairSecond.push_back(i2);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	m_vCellPairStart[m_CellTotal] = m_vPairFirst.size();
+
+	m_vXRef.assign(m_vXPos.begin(), m_vXPos.end());
+	m_vYRef.assign(m_vYPos.begin(), m_vYPos.end());
+	m_vZRef.assign(m_vZPos.begin(), m_vZPos.end());
+
+	m_bListValid = true;
+}
+
+// Private helper function to return the distinct indices of the cells within 
+// reach of a cell in one dimension, taking the PBCs into account. If the 
+// reach covers the whole SimBox every cell is returned once.
+
+void CCNTCellBeadStore::GetNeighbourIndices(long index, long reach, long total, zLongVector& rvIndices) const
+{
+	rvIndices.clear();
+
+	if(2*reach+1 >= total)
+	{
+		for(long i=0; i<total; i++)
+		{
+			rvIndices.push_back(i);
+		}
+	}
+	else
+	{
+		for(long i=index-reach; i<=index+reach; i++)
+		{
+			rvIndices.push_back((i+total)%total);
+		}
+	}
+}
+
+// Function to calculate the non-bonded DPD forces between all bead pairs 
+// using the contiguous arrays. For a single thread the cells are visited in
+// order and each pair's random force and slice stress are handled exactly as
+// in CCNTCell::UpdateForce(). For multiple threads the worker threads are 
+// started on the coloured rows of cells and the calling thread takes its own 
+// share. Each thread adds the slice stress contributions to its own CMonitor
+// buffer, and the buffers are summed by the CMonitor when it samples the 
+// stress profile. If the stress tensor sphere is compiled in, the recorded 
+// pairs are passed to the CSimBox once all threads have finished. They are 
+// passed colour by colour, and within a colour in thread order, which is 
+// the order of the rows.
+
+void CCNTCellBeadStore::UpdateForce()
+{
+	CopyCellConstants();
+
+	if(m_ThreadTotal == 1)
+	{
+		double* const pSliceStress = GetSliceStressBuffer(0);
+
+		for(long ic=0; ic<m_CellTotal; ic++)
+		{
+			(this->*m_pSerialKernel)(ic, pSliceStress, 0);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_DoneTotal = 0;
+		m_StartCounter++;
+	}
+	m_StartCondition.notify_all();
+
+	UpdateColours(0);
+
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_DoneCondition.wait(lock, [this]{return m_DoneTotal == m_ThreadTotal - 1;});
+	}
+
+#if EnableStressTensorSphere == SimMiscEnabled
+	for(long ip=0; ip<static_cast<long>(m_vPairs.size()); ip++)
+	{
+		for(std::vector<PairStress>::const_iterator iterPair=m_vPairs[ip].begin(); iterPair!=m_vPairs[ip].end(); iterPair++)
+		{
+			double localStress[9];
+
+			for(short int j=0; j<9; j++)
+			{
+				localStress[j] = iterPair->dx[j%3]*iterPair->force[j/3];
+			}
+
+			m_pISimBox->AddBeadStress(m_vBeads[iterPair->first]->m_Pos, m_vBeads[iterPair->second]->m_Pos, localStress);
+		}
+	}
+#endif
+}
+
+// Private function to copy the CCNTCell constants used by the force loop. The
+// CCNTCell static members are local to the thread that runs the simulation,
+// so that several simulations can run in one process, and the worker threads
+// read these copies instead. They are refreshed before every force loop as
+// the random number generator's time step changes each step.
+
+void CCNTCellBeadStore::CopyCellConstants()
+{
+	m_SimBoxLength[0]     = CCNTCell::m_SimBoxXLength;
+	m_SimBoxLength[1]     = CCNTCell::m_SimBoxYLength;
+	m_SimBoxLength[2]     = CCNTCell::m_SimBoxZLength;
+	m_HalfSimBoxLength[0] = CCNTCell::m_HalfSimBoxXLength;
+	m_HalfSimBoxLength[1] = CCNTCell::m_HalfSimBoxYLength;
+	m_HalfSimBoxLength[2] = CCNTCell::m_HalfSimBoxZLength;
+	m_InvRootDt           = CCNTCell::m_invrootdt;
+	m_PairRNGKey          = CCNTCell::m_PairRNGKey;
+	m_PairRNGStep         = CCNTCell::m_PairRNGStep;
+	m_pMonitor            = CCNTCell::m_pMonitor;
+	m_pISimBox            = CCNTCell::m_pISimBox;
+}
+
+// Private function to select the specialisations of the force kernel used by 
+// the serial and threaded loops. They differ in the random number generator
+// used, and both depend on whether the beads have their own radii and on 
+// whether the Verlet pair list is used. The mixed-precision kernel replaces
+// the cell-based loop if it has been requested and can be used; otherwise
+// the batched SIMD kernel is selected for the cell-based loop if it was 
+// compiled in and the CPU supports it.
+
+void CCNTCellBeadStore::SelectKernels()
+{
+#if SimDimension == 2
+	const bool bCellsDistinct = CCNTCell::m_CNTXCellNo >= 3 && CCNTCell::m_CNTYCellNo >= 3;
+#elif SimDimension == 3
+	const bool bCellsDistinct = CCNTCell::m_CNTXCellNo >= 3 && CCNTCell::m_CNTYCellNo >= 3 && CCNTCell::m_CNTZCellNo >= 3;
+#endif
+
+	m_bMixedKernel = m_bMixedPrecision && m_VerletSkin == 0.0 && !m_bBeadRadii && bCellsDistinct;
+
+	if(m_VerletSkin > 0.0)
+	{
+		if(m_bBeadRadii)
+		{
+			m_pSerialKernel   = &CCNTCellBeadStore::UpdateCellPairListForce<false, true>;
+			m_pThreadedKernel = &CCNTCellBeadStore::UpdateCellPairListForce<true,  true>;
+		}
+		else
+		{
+			m_pSerialKernel   = &CCNTCellBeadStore::UpdateCellPairListForce<false, false>;
+			m_pThreadedKernel = &CCNTCellBeadStore::UpdateCellPairListForce<true,  false>;
+		}
+	}
+	else if(m_bMixedKernel)
+	{
+		m_pSerialKernel   = &CCNTCellBeadStore::UpdateCellForceMixed<false>;
+		m_pThreadedKernel = &CCNTCellBeadStore::UpdateCellForceMixed<true>;
+	}
+	else if(m_bBeadRadii)
+	{
+		m_pSerialKernel   = &CCNTCellBeadStore::UpdateCellForce<false, true>;
+		m_pThreadedKernel = &CCNTCellBeadStore::UpdateCellForce<true,  true>;
+	}
+	else if(IsSIMDSupported())
+	{
+		m_pSerialKernel   = &CCNTCellBeadStore::UpdateCellForceSIMD<false>;
+		m_pThreadedKernel = &CCNTCellBeadStore::UpdateCellForceSIMD<true>;
+	}
+	else
+	{
+		m_pSerialKernel   = &CCNTCellBeadStore::UpdateCellForce<false, false>;
+		m_pThreadedKernel = &CCNTCellBeadStore::UpdateCellForce<true,  false>;
+	}
+}
+
+// Private helper function returning a thread's CMonitor buffer for the 
+// bead-bead slice stress contributions, or a null pointer if the stress 
+// profile is not needed in the current time step.
+
+double* CCNTCellBeadStore::GetSliceStressBuffer(long thread) const
+{
+#if EnableParallelSimBox == SimMPSDisabled
+	if(m_pMonitor->IsSliceStressOn())
+	{
+		return &m_pMonitor->m_vvBeadStressBuffer.at(thread)[0];
+	}
+#endif
+
+	return 0;
+}
+
+// Function to copy the accumulated forces, force counters and stress tensors
+// back into the beads. The forces were copied from the beads when the store
+// was sorted, so the beads end up with the same values as if the pair loop 
+// had operated on them directly.
+
+void CCNTCellBeadStore::Scatter()
+{
+	for(long slot=0; slot<m_BeadTotal; slot++)
+	{
+		CAbstractBead* const pBead = m_vBeads[slot];
+
+		pBead->m_Force[0]     = m_vXForce[slot];
+		pBead->m_Force[1]     = m_vYForce[slot];
+		pBead->m_Force[2]     = m_vZForce[slot];
+		pBead->m_ForceCounter = m_vForceCounter[slot];
+
+		for(short int j=0; j<9; j++)
+		{
+			pBead->m_Stress[j] = m_vStress[9*slot+j];
+		}
+	}
+}
+
+// Private helper function to copy the bead-bead interaction matrices into 
+// flat arrays indexed by type1*m_TypeTotal + type2. The matrices can be 
+// modified by commands at any time, and new bead types can be added, so 
+// we copy them each time the store is sorted. This is cheap as the number 
+// of bead types is small.
+
+void CCNTCellBeadStore::CopyInteractions()
+{
+	m_TypeTotal = CCNTCell::m_vvConsInt.size();
+
+	m_vConsInt.resize(m_TypeTotal*m_TypeTotal, 0.0);
+	m_vDissInt.resize(m_TypeTotal*m_TypeTotal, 0.0);
+
+	for(long i=0; i<m_TypeTotal; i++)
+	{
+		for(long j=0; j<m_TypeTotal; j++)
+		{
+			m_vConsInt[m_TypeTotal*i+j] = CCNTCell::m_vvConsInt[i][j];
+			m_vDissInt[m_TypeTotal*i+j] = CCNTCell::m_vvDissInt[i][j];
+		}
+	}
+}
+
+// Private helper function to assign a colour to each row of cells along the 
+// X axis. A row is identified by its Y and Z cell indices, and the colour is 
+// the product of a Y colour and a Z colour. In each dimension the rows are 
+// coloured cyclically with the given period up to the largest multiple of 
+// the period that fits in the SimBox; any remaining rows are given unique 
+// colours so that rows of the same colour are also independent across the 
+// periodic boundaries. Empty colours are discarded, and the rows of each 
+// colour are stored in order of increasing row index.
+//
+// The half-shell loop needs a period of 3 in Y and 2 in Z. The Verlet pair 
+// list writes to beads within a larger number of cells in both directions,
+// and needs correspondingly larger periods.
+
+void CCNTCellBeadStore::MakeRowColours(long yPeriod, long zPeriod)
+{
+	const long yTotal = CCNTCell::m_CNTYCellNo;
+	const long zTotal = CCNTCell::m_CNTZCellNo;
+
+	m_ColourYPeriod = yPeriod;
+	m_ColourZPeriod = zPeriod;
+
+	const long yMain   = yPeriod*(yTotal/yPeriod);
+	const long zMain   = zPeriod*(zTotal/zPeriod);
+	const long yColourTotal = yPeriod + yTotal - yMain;
+	const long zColourTotal = zPeriod + zTotal - zMain;
+
+	m_vColourStart.clear();
+	m_vColourRows.clear();
+
+	for(long yColour=0; yColour<yColourTotal; yColour++)
+	{
+		for(long zColour=0; zColour<zColourTotal; zColour++)
+		{
+			const long first = m_vColourRows.size();
+
+			for(long z=0; z<zTotal; z++)
+			{
+				const long zRowColour = (z < zMain) ? (z % zPeriod) : (zPeriod + z - zMain);
+
+				for(long y=0; y<yTotal; y++)
+				{
+					const long yRowColour = (y < yMain) ? (y % yPeriod) : (yPeriod + y - yMain);
+
+					if(yRowColour == yColour && zRowColour == zColour)
+					{
+						m_vColourRows.push_back(y + yTotal*z);
+					}
+				}
+			}
+
+			if(static_cast<long>(m_vColourRows.size()) > first)
+			{
+				m_vColourStart.push_back(first);
+			}
+		}
+	}
+
+	m_vColourStart.push_back(m_vColourRows.size());
+
+	m_vPairs.clear();
+	m_vPairs.resize((m_vColourStart.size() - 1)*m_ThreadTotal);
+}
+
+// Private helper functions to create and destroy the worker threads. The 
+// calling thread acts as thread 0, so only m_ThreadTotal-1 workers are created.
+// The workers are given the current value of the start counter so that they
+// cannot miss a force loop that starts before they first wait on it.
+
+void CCNTCellBeadStore::StartThreads()
+{
+	m_bStopWorkers = false;
+
+	for(long t=1; t<m_ThreadTotal; t++)
+	{
+		m_vWorkers.push_back(std::thread(&CCNTCellBeadStore::WorkerLoop, this, t, m_StartCounter));
+	}
+}
+
+void CCNTCellBeadStore::StopThreads()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bStopWorkers = true;
+	}
+	m_StartCondition.notify_all();
+
+	for(std::vector<std::thread>::iterator iterThread=m_vWorkers.begin(); iterThread!=m_vWorkers.end(); iterThread++)
+	{
+		iterThread->join();
+	}
+
+	m_vWorkers.clear();
+}
+
+// Function executed by each worker thread. It waits until the calling thread
+// starts a new force loop, processes its share of the rows, and signals when
+// it has finished.
+
+void CCNTCellBeadStore::WorkerLoop(long thread, long startCounter)
+{
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_StartCondition.wait(lock, [this, startCounter]{return m_bStopWorkers || m_StartCounter != startCounter;});
+
+			if(m_bStopWorkers)
+				return;
+
+			startCounter = m_StartCounter;
+		}
+
+		UpdateColours(thread);
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_DoneTotal++;
+		}
+		m_DoneCondition.notify_one();
+	}
+}
+
+// Function to calculate the forces for one thread's share of the rows of 
+// each colour in turn. All threads wait at a barrier between colours, as rows
+// of different colours may write to the same beads.
+
+void CCNTCellBeadStore::UpdateColours(long thread)
+{
+	double* const pSliceStress = GetSliceStressBuffer(thread);
+
+	const long colourTotal = m_vColourStart.size() - 1;
+
+	for(long colour=0; colour<colourTotal; colour++)
+	{
+		PairStressVector& rvPairs = m_vPairs[colour*m_ThreadTotal + thread];
+		rvPairs.clear();
+
+		const long rowTotal = m_vColourStart[colour+1] - m_vColourStart[colour];
+		const long firstRow = m_vColourStart[colour] + (rowTotal*thread)/m_ThreadTotal;
+		const long lastRow  = m_vColourStart[colour] + (rowTotal*(thread+1))/m_ThreadTotal;
+
+		for(long ir=firstRow; ir<lastRow; ir++)
+		{
+			const long firstCell = m_RowLength*m_vColourRows[ir];
+
+			for(long ic=firstCell; ic<firstCell+m_RowLength; ic++)
+			{
+				(this->*m_pThreadedKernel)(ic, pSliceStress, &rvPairs);
+			}
+		}
+
+		if(colour < colourTotal-1)
+		{
+			WaitAtBarrier();
+		}
+	}
+}
+
+// Private helper function that blocks until all threads have reached it.
+
+void CCNTCellBeadStore::WaitAtBarrier()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+
+	const long barrierCounter = m_BarrierCounter;
+
+	if(++m_BarrierTotal == m_ThreadTotal)
+	{
+		m_BarrierTotal = 0;
+		m_BarrierCounter++;
+		m_BarrierCondition.notify_all();
+	}
+	else
+	{
+		m_BarrierCondition.wait(lock, [this, barrierCounter]{return m_BarrierCounter != barrierCounter;});
+	}
+}
+
+// Function template to calculate the non-bonded DPD forces between the beads
+// in one cell and those in the same cell and its half-shell of neighbouring 
+// cells. The loop structure, and the arithmetic, are the same as the DPD 
+// branch of CCNTCell::UpdateForce(): see there for a description of the force
+// terms. Beads in the same cell interact with those later in the cell's bead 
+// list, visited in reverse order, followed by all beads in the neighbouring 
+// cells. The inner loop over each range of beads is done by AddPairForces(),
+// which is specialised for same-cell and neighbour-cell ranges, and for 
+// neighbour cells that do or do not require the PBCs to be applied, so that 
+// none of these choices is tested for each bead pair.
+//
+// The template parameters select the random number generator, the range of
+// the interactions and the pair kernel. For a single thread the random force 
+// uses the main CCNTCell RNG; otherwise it uses the counter-based RNG, which 
+// only depends on the pair of beads. If bBeadRadii is true the interaction 
+// range of a pair is the sum of the beads' radii, otherwise it is unity. 
+//
+// The stress tensor for each pair is stored in the first bead of the pair.
+
+template<bool bCounterRNG, bool bBeadRadii>
+void CCNTCellBeadStore::UpdateCellForce(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs)
+{
+	const long first = m_vCellStart[cellIndex];
+	const long last  = m_vCellStart[cellIndex+1];
+
+	for(long i1=first; i1<last; i1++)
+	{
+		double* const pStress1 = &m_vStress[9*i1];
+
+		for(short int j=0; j<9; j++)
+		{
+			pStress1[j] = 0.0;
+		}
+
+		AddPairForces<false, true, bCounterRNG, bBeadRadii>(i1, i1+1, last, pSliceStress, pvPairs);
+
+		for(long inn=0; inn<m_NNTotal; inn++)
+		{
+			const long nn     = m_NNTotal*cellIndex + inn;
+			const long nnCell = m_vNNCells[nn];
+
+			if(m_vNNPBC[nn])
+			{
+				AddPairForces<true, false, bCounterRNG, bBeadRadii>(i1, m_vCellStart[nnCell], m_vCellStart[nnCell+1], pSliceStress, pvPairs);
+			}
+			else
+			{
+				AddPairForces<false, false, bCounterRNG, bBeadRadii>(i1, m_vCellStart[nnCell], m_vCellStart[nnCell+1], pSliceStress, pvPairs);
+			}
+		}
+	}
+}
+
+// Function template to calculate the non-bonded DPD forces for the pairs in
+// the Verlet list that belong to one cell, that is, whose first bead was in 
+// the cell when the list was built. The PBCs are applied to all pairs as the
+// beads may have crossed the SimBox boundaries since the list was built. The
+// pairs that are now out of range are rejected by AddPairForce().
+
+template<bool bCounterRNG, bool bBeadRadii>
+void CCNTCellBeadStore::UpdateCellPairListForce(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs)
+{
+	for(long i1=m_vCellStart[cellIndex]; i1<m_vCellStart[cellIndex+1]; i1++)
+	{
+		for(short int j=0; j<9; j++)
+		{
+			m_vStress[9*i1+j] = 0.0;
+		}
+	}
+
+	for(long ip=m_vCellPairStart[cellIndex]; ip<m_vCellPairStart[cellIndex+1]; ip++)
+	{
+		AddPairForce<true, bCounterRNG, bBeadRadii>(m_vPairFirst[ip], m_vPairSecond[ip], pSliceStress, pvPairs);
+	}
+}
+
+// Function template to calculate the DPD forces between one bead and a range
+// of beads. If bSameCell is true the range is visited in reverse order, as in
+// the CNT cells' own loop.
+
+template<bool bPBC, bool bSameCell, bool bCounterRNG, bool bBeadRadii>
+void CCNTCellBeadStore::AddPairForces(long i1, long begin2, long end2, double* const pSliceStress, PairStressVector* pvPairs)
+{
+	for(long k=begin2; k<end2; k++)
+	{
+		const long i2 = bSameCell ? (end2 - 1 - (k - begin2)) : k;
+
+		AddPairForce<bPBC, bCounterRNG, bBeadRadii>(i1, i2, pSliceStress, pvPairs);
+	}
+}
+
+// Function template to calculate the DPD force between a pair of beads if 
+// they are within range. If bPBC is true the PBCs are applied to their 
+// separation.
+//
+// If a slice stress buffer is passed in, the pair's contribution is added to
+// it for the CMonitor's slice stress analysis. If a container for the pair 
+// data is passed in, the pair is recorded for the stress tensor sphere 
+// instead of being passed directly to the CSimBox.
+
+template<bool bPBC, bool bCounterRNG, bool bBeadRadii>
+void CCNTCellBeadStore::AddPairForce(long i1, long i2, double* const pSliceStress, PairStressVector* pvPairs)
+{
+	double dx[3], dv[3], newForce[3];
+	double dr, dr2, drmax;
+	double gammap, rdotv, wr, wr2;
+	double conForce, dissForce, randForce, randNo;
+
+	dx[0] = (m_vXPos[i1] - m_vXPos[i2]);
+	dv[0] = (m_vXMom[i1] - m_vXMom[i2]);
+
+	dx[1] = (m_vYPos[i1] - m_vYPos[i2]);
+	dv[1] = (m_vYMom[i1] - m_vYMom[i2]);
+
+#if SimDimension == 2
+	dx[2] = 0.0;
+	dv[2] = 0.0;
+#elif SimDimension == 3
+	dx[2] = (m_vZPos[i1] - m_vZPos[i2]);
+	dv[2] = (m_vZMom[i1] - m_vZMom[i2]);
+#endif
+
+	if(bPBC)
+	{
+		if( dx[0] > m_HalfSimBoxLength[0] )
+			dx[0] = dx[0] - m_SimBoxLength[0];
+		else if( dx[0] < -m_HalfSimBoxLength[0] )
+			dx[0] = dx[0] + m_SimBoxLength[0];
+
+		if( dx[1] > m_HalfSimBoxLength[1] )
+			dx[1] = dx[1] - m_SimBoxLength[1];
+		else if( dx[1] < -m_HalfSimBoxLength[1] )
+			dx[1] = dx[1] + m_SimBoxLength[1];
+
+#if SimDimension == 3
+		if( dx[2] > m_HalfSimBoxLength[2] )
+			dx[2] = dx[2] - m_SimBoxLength[2];
+		else if( dx[2] < -m_HalfSimBoxLength[2] )
+			dx[2] = dx[2] + m_SimBoxLength[2];
+#endif
+	}
+
+	dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+	// Beads with a fixed interaction range are rejected before the square
+	// root is taken; beads with their own radii need the distance itself.
+
+	if(bBeadRadii)
+	{
+		dr    = sqrt(dr2);
+		drmax = m_vRadius[i1] + m_vRadius[i2];
+
+		if( dr >= drmax || dr <= 0.000000001 )
+			return;
+
+		wr = (1.0 - dr/drmax);
+	}
+	else
+	{
+		if( dr2 >= 1.0 )
+			return;
+
+		dr = sqrt(dr2);
+
+		if( dr <= 0.000000001 )
+			return;
+
+		wr = (1.0 - dr);
+	}
+
+	wr2 = wr*wr;
+
+	const long type12 = m_TypeTotal*m_vType[i1] + m_vType[i2];
+
+	if(bCounterRNG)
+	{
+		randNo = CCNTCell::GetPairRandomNo(m_PairRNGKey, m_PairRNGStep, m_vId[i1], m_vId[i2]);
+	}
+	else
+	{
+		randNo = CCNTCell::Randf();
+	}
+
+	conForce  = m_vConsInt[type12]*wr;				
+
+	rdotv     = (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
+	gammap    = m_vDissInt[type12]*wr2;
+
+	dissForce = -gammap*rdotv;				
+	randForce = sqrt(gammap)*m_InvRootDt*(0.5 - randNo);
+
+	newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
+	newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
+	newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
+
+	AddPairResult(i1, i2, newForce, dx, pSliceStress, pvPairs);
+}
+
+// Private helper function to add the force between a pair of beads to both
+// beads, and the pair's contribution to the stress tensor to the first bead 
+// and to the slice stress and stress tensor sphere analyses. It is shared by 
+// the scalar and SIMD pair kernels so that both accumulate the results in 
+// the same way.
+
+inline void CCNTCellBeadStore::AddPairResult(long i1, long i2, const double newForce[3], const double dx[3], double* const pSliceStress, PairStressVector* pvPairs)
+{
+	double localStress[9];
+
+	m_vForceCounter[i1]++;
+	m_vForceCounter[i2]++;
+
+	m_vXForce[i1] += newForce[0];
+	m_vYForce[i1] += newForce[1];
+	m_vZForce[i1] += newForce[2];
+
+	m_vXForce[i2] -= newForce[0];
+	m_vYForce[i2] -= newForce[1];
+	m_vZForce[i2] -= newForce[2];
+
+	// stress tensor summation
+
+	localStress[0] = dx[0]*newForce[0];
+	localStress[1] = dx[1]*newForce[0];
+	localStress[2] = dx[2]*newForce[0];
+	localStress[3] = dx[0]*newForce[1];
+	localStress[4] = dx[1]*newForce[1];
+	localStress[5] = dx[2]*newForce[1];
+	localStress[6] = dx[0]*newForce[2];
+	localStress[7] = dx[1]*newForce[2];
+	localStress[8] = dx[2]*newForce[2];
+
+	double* const pStress1 = &m_vStress[9*i1];
+
+	for(short int j=0; j<9; j++)
+	{
+		pStress1[j] += localStress[j];
+	}
+
+#if EnableParallelSimBox == SimMPSDisabled
+	if(pSliceStress)
+	{
+		m_pMonitor->AddBeadStress(pSliceStress, m_vType[i1], m_vType[i2], m_vZPos[i1], m_vZPos[i2], newForce, dx);
+	}
+#endif
+
+#if EnableStressTensorSphere == SimMiscEnabled
+	if(pvPairs)
+	{
+		PairStress pair;
+		pair.first  = i1;
+		pair.second = i2;
+
+		for(short int j=0; j<3; j++)
+		{
+			pair.force[j] = newForce[j];
+			pair.dx[j]    = dx[j];
+		}
+
+		pvPairs->push_back(pair);
+	}
+	else
+	{
+		m_pISimBox->AddBeadStress(m_vBeads[i1]->m_Pos, m_vBeads[i2]->m_Pos, localStress);
+	}
+#endif
+}
+
+// Function template implementing the cell-based loop with the batched SIMD 
+// kernel for beads with unit interaction range. The cell's candidate beads,
+// that is, its own beads in reverse order followed by the beads in its 
+// half-shell of neighbouring cells, are copied into contiguous scratch arrays
+// once per cell, with a flag showing whether the PBCs apply to each one. 
+// Each bead in the cell is then processed in four stages:
+//
+//  1 The separations of the bead from all candidates are calculated in SIMD
+//    lanes, and the lanes within range are recorded as bit masks
+//  2 The pairs within range are compacted in the order in which the scalar
+//    loop visits them, skipping the same-cell candidates that precede the 
+//    bead, and their random numbers and interaction parameters are fetched
+//  3 The pair forces are calculated in SIMD lanes
+//  4 The forces and stress are accumulated in order by AddPairResult()
+//
+// Each bead has about 40 candidates at the usual density, of which about 6
+// are within range, so the lanes are filled and the scalar code only visits
+// the pairs that interact. Because the random numbers are drawn, and the 
+// forces accumulated, in the same order as in UpdateCellForce(), and the SIMD
+// arithmetic repeats the scalar operations exactly (without fused multiply-
+// adds), the results are identical to those of the scalar kernel. If the 
+// kernel is not compiled in, this function calls the scalar kernel.
+
+template<bool bCounterRNG>
+void CCNTCellBeadStore::UpdateCellForceSIMD(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs)
+{
+#if defined(UseAVX2PairKernel)
+
+	PairBatch& rBatch = tlPairBatch;
+
+	const long first     = m_vCellStart[cellIndex];
+	const long last      = m_vCellStart[cellIndex+1];
+	const long cellTotal = last - first;
+
+	long total = cellTotal;
+
+	for(long inn=0; inn<m_NNTotal; inn++)
+	{
+		const long nnCell = m_vNNCells[m_NNTotal*cellIndex + inn];
+
+		total += m_vCellStart[nnCell+1] - m_vCellStart[nnCell];
+	}
+
+	rBatch.Reserve(total);
+
+	long k = 0;
+
+	for(long i2=last-1; i2>=first; i2--, k++)
+	{
+		rBatch.slot[k] = i2;
+		rBatch.x[k]    = m_vXPos[i2];
+		rBatch.y[k]    = m_vYPos[i2];
+		rBatch.z[k]    = m_vZPos[i2];
+		rBatch.pbc[k]  = 0.0;
+	}
+
+	for(long inn=0; inn<m_NNTotal; inn++)
+	{
+		const long   nn     = m_NNTotal*cellIndex + inn;
+		const long   nnCell = m_vNNCells[nn];
+		const double pbc    = m_vNNPBC[nn] ? 1.0 : 0.0;
+
+		for(long i2=m_vCellStart[nnCell]; i2<m_vCellStart[nnCell+1]; i2++, k++)
+		{
+			rBatch.slot[k] = i2;
+			rBatch.x[k]    = m_vXPos[i2];
+			rBatch.y[k]    = m_vYPos[i2];
+			rBatch.z[k]    = m_vZPos[i2];
+			rBatch.pbc[k]  = pbc;
+		}
+	}
+
+	for(; k<4*((total+3)/4); k++)
+	{
+		rBatch.x[k]   = 0.0;
+		rBatch.y[k]   = 0.0;
+		rBatch.z[k]   = 0.0;
+		rBatch.pbc[k] = 0.0;
+	}
+
+	double pos1[3], newForce[3], dx[3];
+
+	for(long i1=first; i1<last; i1++)
+	{
+		double* const pStress1 = &m_vStress[9*i1];
+
+		for(short int j=0; j<9; j++)
+		{
+			pStress1[j] = 0.0;
+		}
+
+		pos1[0] = m_vXPos[i1];
+		pos1[1] = m_vYPos[i1];
+		pos1[2] = m_vZPos[i1];
+
+		GetCandidateSeparationsAVX2(rBatch, pos1, total, m_SimBoxLength, m_HalfSimBoxLength);
+
+		// Only the same-cell candidates that follow the bead in the cell, 
+		// which are the first ones in the reversed list, form pairs with it
+
+		const long sameTotal = last - 1 - i1;
+		const long typeRow   = m_TypeTotal*m_vType[i1];
+
+		long pairTotal = 0;
+
+		for(long kv=0; kv<total; kv+=4)
+		{
+			long bits = rBatch.inRange[kv/4];
+
+			while(bits)
+			{
+				const long kc = kv + __builtin_ctzl(bits);
+
+				bits &= bits - 1;
+
+				if(kc >= sameTotal && kc < cellTotal)
+					continue;
+
+				const double dr = sqrt(rBatch.dr2[kc]);
+
+				if(dr <= 0.000000001)
+					continue;
+
+				const long i2 = rBatch.slot[kc];
+
+				rBatch.pairSlot[pairTotal] = i2;
+				rBatch.pairDx[pairTotal]   = rBatch.dx[kc];
+				rBatch.pairDy[pairTotal]   = rBatch.dy[kc];
+				rBatch.pairDz[pairTotal]   = rBatch.dz[kc];
+				rBatch.pairDr[pairTotal]   = dr;
+				rBatch.pairDvx[pairTotal]  = m_vXMom[i1] - m_vXMom[i2];
+				rBatch.pairDvy[pairTotal]  = m_vYMom[i1] - m_vYMom[i2];
+#if SimDimension == 2
+				rBatch.pairDvz[pairTotal]  = 0.0;
+#elif SimDimension == 3
+				rBatch.pairDvz[pairTotal]  = m_vZMom[i1] - m_vZMom[i2];
+#endif
+				rBatch.cons[pairTotal]     = m_vConsInt[typeRow + m_vType[i2]];
+				rBatch.diss[pairTotal]     = m_vDissInt[typeRow + m_vType[i2]];
+
+				if(bCounterRNG)
+				{
+					rBatch.randNo[pairTotal] = CCNTCell::GetPairRandomNo(m_PairRNGKey, m_PairRNGStep, m_vId[i1], m_vId[i2]);
+				}
+				else
+				{
+					rBatch.randNo[pairTotal] = CCNTCell::Randf();
+				}
+
+				pairTotal++;
+			}
+		}
+
+		if(pairTotal > 0)
+		{
+			GetPairForcesAVX2(rBatch, pairTotal, m_InvRootDt);
+
+			for(long ip=0; ip<pairTotal; ip++)
+			{
+				newForce[0] = rBatch.fx[ip];
+				newForce[1] = rBatch.fy[ip];
+				newForce[2] = rBatch.fz[ip];
+				dx[0]       = rBatch.pairDx[ip];
+				dx[1]       = rBatch.pairDy[ip];
+				dx[2]       = rBatch.pairDz[ip];
+
+				AddPairResult(i1, rBatch.pairSlot[ip], newForce, dx, pSliceStress, pvPairs);
+			}
+		}
+	}
+
+#else
+
+	UpdateCellForce<bCounterRNG, false>(cellIndex, pSliceStress, pvPairs);
+
+#endif
+}
+
+// Function template implementing the cell-based loop in mixed precision. The
+// cells, beads and neighbouring cells are visited in the same order as in 
+// UpdateCellForce(), and the separation of the cells' origins is passed to 
+// the pair kernel with each range of beads.
+
+template<bool bCounterRNG>
+void CCNTCellBeadStore::UpdateCellForceMixed(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs)
+{
+	const float noShift[3] = {0.0f, 0.0f, 0.0f};
+
+	const long first = m_vCellStart[cellIndex];
+	const long last  = m_vCellStart[cellIndex+1];
+
+	for(long i1=first; i1<last; i1++)
+	{
+		double* const pStress1 = &m_vStress[9*i1];
+
+		for(short int j=0; j<9; j++)
+		{
+			pStress1[j] = 0.0;
+		}
+
+		AddPairForcesMixed<true, bCounterRNG>(i1, i1+1, last, noShift, pSliceStress, pvPairs);
+
+		for(long inn=0; inn<m_NNTotal; inn++)
+		{
+			const long nn     = m_NNTotal*cellIndex + inn;
+			const long nnCell = m_vNNCells[nn];
+
+			AddPairForcesMixed<false, bCounterRNG>(i1, m_vCellStart[nnCell], m_vCellStart[nnCell+1], &m_vNNShift[3*nn], pSliceStress, pvPairs);
+		}
+	}
+}
+
+// Function template to calculate the DPD forces between one bead and a range
+// of beads in single precision. The range is processed in batches in two
+// stages:
+//
+//  1 The separations of all candidate pairs are calculated from the cell 
+//    offsets in a loop without branches, which the compiler vectorises
+//  2 The pairs within range are visited in the order of the scalar loop, 
+//    so that the random numbers are drawn in the same sequence, and their
+//    forces calculated and passed to AddPairResult()
+//
+// The arithmetic of the force terms is the same as in AddPairForce(), but
+// in single precision. The random number and the interaction parameters 
+// are rounded to single precision, and the resulting force is converted 
+// back to double precision before it is accumulated.
+
+template<bool bSameCell, bool bCounterRNG>
+void CCNTCellBeadStore::AddPairForcesMixed(long i1, long begin2, long end2, const float shift[3], double* const pSliceStress, PairStressVector* pvPairs)
+{
+	if(begin2 >= end2)
+		return;
+
+	float dxBatch[MixedPairBatchSize];
+	float dyBatch[MixedPairBatchSize];
+	float dzBatch[MixedPairBatchSize];
+	float dr2Batch[MixedPairBatchSize];
+
+	const float* const pX  = &m_vXOffset[0];
+	const float* const pY  = &m_vYOffset[0];
+	const float* const pZ  = &m_vZOffset[0];
+	const float* const pVX = &m_vXMomF[0];
+	const float* const pVY = &m_vYMomF[0];
+	const float* const pVZ = &m_vZMomF[0];
+
+	const float x1  = pX[i1] + shift[0];
+	const float y1  = pY[i1] + shift[1];
+#if SimDimension == 3
+	const float z1  = pZ[i1] + shift[2];
+#endif
+	const float vx1 = pVX[i1];
+	const float vy1 = pVY[i1];
+	const float vz1 = pVZ[i1];
+
+	const float invrootdt = static_cast<float>(m_InvRootDt);
+
+	const long typeRow = m_TypeTotal*m_vType[i1];
+
+	double newForce[3], dx[3];
+
+	// Same-cell ranges are visited in reverse order, so their batches are 
+	// taken from the end of the range.
+
+	long remaining = end2 - begin2;
+
+	while(remaining > 0)
+	{
+		const long total = (remaining < MixedPairBatchSize) ? remaining : MixedPairBatchSize;
+		const long first = bSameCell ? (begin2 + remaining - total) : (end2 - remaining);
+
+		remaining -= total;
+
+		for(long k=0; k<total; k++)
+		{
+			const float ddx = x1 - pX[first+k];
+			const float ddy = y1 - pY[first+k];
+#if SimDimension == 2
+			const float ddz = 0.0f;
+#elif SimDimension == 3
+			const float ddz = z1 - pZ[first+k];
+#endif
+			dxBatch[k]  = ddx;
+			dyBatch[k]  = ddy;
+			dzBatch[k]  = ddz;
+			dr2Batch[k] = ddx*ddx + ddy*ddy + ddz*ddz;
+		}
+
+		for(long j=0; j<total; j++)
+		{
+			const long k = bSameCell ? (total - 1 - j) : j;
+
+			if( dr2Batch[k] >= 1.0f )
+				continue;
+
+			const float dr = sqrtf(dr2Batch[k]);
+
+			if( dr <= 0.000000001f )
+				continue;
+
+			const long i2 = first + k;
+
+			double randNo;
+
+			if(bCounterRNG)
+			{
+				randNo = CCNTCell::GetPairRandomNo(m_PairRNGKey, m_PairRNGStep, m_vId[i1], m_vId[i2]);
+			}
+			else
+			{
+				randNo = CCNTCell::Randf();
+			}
+
+			const float wr  = 1.0f - dr;
+			const float wr2 = wr*wr;
+
+			const float conForce  = static_cast<float>(m_vConsInt[typeRow + m_vType[i2]])*wr;
+			const float rdotv     = (dxBatch[k]*(vx1 - pVX[i2]) + dyBatch[k]*(vy1 - pVY[i2]) + dzBatch[k]*(vz1 - pVZ[i2]))/dr;
+			const float gammap    = static_cast<float>(m_vDissInt[typeRow + m_vType[i2]])*wr2;
+			const float dissForce = -gammap*rdotv;
+			const float randForce = sqrtf(gammap)*invrootdt*static_cast<float>(0.5 - randNo);
+
+			const float force = (conForce + dissForce + randForce)/dr;
+
+			newForce[0] = force*dxBatch[k];
+			newForce[1] = force*dyBatch[k];
+			newForce[2] = force*dzBatch[k];
+			dx[0]       = dxBatch[k];
+			dx[1]       = dyBatch[k];
+			dx[2]       = dzBatch[k];
+
+			AddPairResult(i1, i2, newForce, dx, pSliceStress, pvPairs);
+		}
+	}
+}
+
+// Static function showing whether the batched SIMD pair kernel can be used: 
+// it must have been compiled in and the CPU must support AVX2. 
+
+bool CCNTCellBeadStore::IsSIMDSupported()
+{
+#if defined(UseAVX2PairKernel)
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,289 @@
+// CNTCellBeadStore.h: interface for the CCNTCellBeadStore class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CNTCELLBEADSTORE_H__7A1C2E54_3B8D_4F60_9E21_5D0C8B4A6F13__INCLUDED_)
+#define AFX_CNTCELLBEADSTORE_H__7A1C2E54_3B8D_4F60_9E21_5D0C8B4A6F13__INCLUDED_
+
+
+// Forward declarations
+
+class CCNTCell;
+class CAbstractBead;
+class CMonitor;
+class ISimBox;
+
+
+#include "xxBase.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Contiguous, cell-sorted copy of the bead data needed by the non-bonded
+// DPD force loop. The CNT cells keep their linked lists of bead pointers,
+// and the CAbstractBead objects remain the authoritative state used by the
+// integrator, the analysis and the commands: this class copies the positions,
+// momenta, forces and types of all beads into structure-of-arrays storage
+// ordered by CNT cell, so that the pair loop reads memory sequentially
+// instead of dereferencing a heap-allocated bead for every pair.
+//
+// The bead pointers are kept alongside the arrays so that each slot can
+// act as a view on its bead, e.g., for passing the interacting pair to the
+// CSimBox for the stress tensor sphere analysis.
+//
+// Usage per time step is:
+//
+//  Sort()        - copy the beads out of the CNT cells in cell order
+//  UpdateForce() - calculate the DPD pair forces using the arrays
+//  Scatter()     - add the forces and stress back into the beads
+//
+// The pair loop visits cells, beads and neighbouring cells in exactly the
+// same order as CCNTCell::UpdateForce() so that the random number sequence,
+// and hence the trajectory, is identical to the list-based loop. The pair
+// loop is a family of function templates specialised on the random number
+// generator, the bead interaction range, the order in which a cell's beads
+// are visited and whether the PBCs apply to a pair of cells, so that these
+// choices are made once per cell or per run instead of once per bead pair.
+// Whether the beads have their own interaction radii is passed in by the 
+// CSimBox from CCNTCell::UsesBeadRadii(). The specialisation only covers this
+// store's DPD loop: the simulation type and the DPD-LG density force are 
+// still selected when the code is compiled.
+// If the CPU supports AVX2, beads with unit interaction range use a batched
+// SIMD kernel that gives the same results as the scalar one.
+//
+// If more than one thread is requested, the pair loop is shared between a
+// set of persistent worker threads. The cells are grouped into rows along
+// the X axis, and the rows are coloured so that no two rows of the same 
+// colour write to the same beads: a row writes to beads in its own row and 
+// the rows within one cell in Y and one cell in Z of it, so rows whose Y 
+// indices differ by at least 3, or whose Z indices differ by at least 2, are 
+// independent. The colours are processed in sequence, with the rows of each 
+// colour divided statically between the threads. The random force for each
+// pair is taken from the counter-based RNG keyed on the seed, time step and
+// the pair's bead ids, and on sampling steps each thread adds the slice 
+// stress contributions to its own CMonitor buffer. Because each bead is 
+// written by only one cell per colour, the forces are reproducible and do 
+// not depend on the number of threads; the summed slice stress depends on
+// it only through the rounding of the sum over the thread buffers.
+//
+// If a Verlet skin is set, the pairs of beads within the interaction range
+// plus the skin are stored in flat index arrays grouped by cell, and the 
+// force loop visits only those pairs. While the list is valid the beads 
+// are copied back into the same slots each step instead of being re-sorted; 
+// the list is rebuilt when any bead has moved more than half the skin since 
+// it was built. The pairs are visited in a different order from the 
+// cell-based loop, so the trajectory is statistically equivalent to, but 
+// not identical with, that of the list-based loop.
+//
+// If mixed precision is selected, the cell-based loop reads single-precision
+// copies of the bead positions, stored as offsets from the origin of the 
+// bead's CNT cell, and of the momenta, and calculates the pair forces in 
+// single precision. The separation of two beads is the difference of their 
+// offsets plus the separation of their cells' origins, which is fixed for 
+// each pair of neighbouring cells and already accounts for the PBCs, so the
+// offsets lose no accuracy however large the SimBox. The forces, stress 
+// and force counters are still accumulated in double precision. The loop
+// is batched so that the separations of a batch of candidate beads are 
+// calculated in a loop the compiler can vectorise with twice as many 
+// lanes as in double precision.
+
+class CCNTCellBeadStore
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CCNTCellBeadStore(const CNTCellVector& rvCells, bool bBeadRadii);
+
+	~CCNTCellBeadStore();
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetCellTotal()   const {return m_CellTotal;}
+	inline long GetBeadTotal()   const {return m_BeadTotal;}
+	inline long GetThreadTotal() const {return m_ThreadTotal;}
+
+	inline double GetVerletSkin() const {return m_VerletSkin;}
+
+	inline bool IsMixedPrecision() const {return m_bMixedPrecision;}
+	inline bool IsMixedKernel()    const {return m_bMixedKernel;}
+
+	void SetThreadTotal(long threads);
+	void SetVerletSkin(double skin);
+	void SetMixedPrecision(bool bMixed);
+
+	void Sort();
+	void UpdateForce();
+	void Scatter();
+
+	// ****************************************
+	// Implementation
+private:
+
+	// Pair data needed by the CSimBox's stress tensor sphere analysis, recorded
+	// by each thread so that it can be passed on after the threads have finished.
+
+	struct PairStress
+	{
+		long   first;
+		long   second;
+		double force[3];
+		double dx[3];
+	};
+
+	typedef std::vector<PairStress> PairStressVector;
+
+	// Pointer to one of the specialisations of UpdateCellForce()
+
+	typedef void (CCNTCellBeadStore::*CellForceKernel)(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs);
+
+	// ****************************************
+	// Private functions
+private:
+
+	void CopyInteractions();
+	void CopyCellConstants();
+	void MakeRowColours(long yPeriod, long zPeriod);
+	void CopyBead(long slot);
+	void CopyOffsets();
+	void MakeNeighbourShifts();
+	bool Gather();
+	void BuildPairList();
+	void GetNeighbourIndices(long index, long reach, long total, zLongVector& rvIndices) const;
+	void StartThreads();
+	void StopThreads();
+	void WorkerLoop(long thread, long startCounter);
+	void UpdateColours(long thread);
+	void WaitAtBarrier();
+	void SelectKernels();
+	double* GetSliceStressBuffer(long thread) const;
+
+	template<bool bCounterRNG, bool bBeadRadii>
+	void UpdateCellForce(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs);
+
+	template<bool bPBC, bool bSameCell, bool bCounterRNG, bool bBeadRadii>
+	void AddPairForces(long i1, long begin2, long end2, double* const pSliceStress, PairStressVector* pvPairs);
+
+	template<bool bCounterRNG, bool bBeadRadii>
+	void UpdateCellPairListForce(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs);
+
+	template<bool bPBC, bool bCounterRNG, bool bBeadRadii>
+	void AddPairForce(long i1, long i2, double* const pSliceStress, PairStressVector* pvPairs);
+
+	template<bool bCounterRNG>
+	void UpdateCellForceSIMD(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs);
+
+	template<bool bCounterRNG>
+	void UpdateCellForceMixed(long cellIndex, double* const pSliceStress, PairStressVector* pvPairs);
+
+	template<bool bSameCell, bool bCounterRNG>
+	void AddPairForcesMixed(long i1, long begin2, long end2, const float shift[3], double* const pSliceStress, PairStressVector* pvPairs);
+
+	void AddPairResult(long i1, long i2, const double newForce[3], const double dx[3], double* const pSliceStress, PairStressVector* pvPairs);
+
+	static bool IsSIMDSupported();
+
+	// ****************************************
+	// Data members
+private:
+
+	const CNTCellVector& m_rvCells;	// CNT cells owned by the CSimBox
+
+	const long m_CellTotal;			// Number of CNT cells
+	const long m_NNTotal;			// Number of half-shell neighbours per cell (4 or 13)
+	long       m_BeadTotal;			// Number of beads copied at the last sort
+	long       m_TypeTotal;			// Number of bead types in the interaction matrices
+	bool       m_bBeadRadii;		// Flag showing if the beads have their own interaction radii
+
+	CellForceKernel m_pSerialKernel;	// Force kernel used by a single thread
+	CellForceKernel m_pThreadedKernel;	// Force kernel used by multiple threads
+
+	double m_VerletSkin;			// Skin of the Verlet pair list: zero if no list is used
+	double m_ListMaxRadius;			// Largest bead radius when the list was built
+	bool   m_bListValid;			// Flag showing if the pair list matches the slots
+
+	bool   m_bMixedPrecision;		// Flag showing if mixed precision was requested
+	bool   m_bMixedKernel;			// Flag showing if the mixed-precision kernel is in use
+
+	zLongVector  m_vCellStart;		// Index of first bead in each cell, plus one past the end
+	zLongVector  m_vNNCells;		// Indices of each cell's half-shell neighbour cells
+	zBoolVector  m_vNNPBC;			// Flag showing if the PBCs apply to each cell-neighbour pair
+
+	AbstractBeadVector m_vBeads;	// Beads in cell order: the slots are views on these
+
+	zLongVector   m_vId;
+	zLongVector   m_vType;
+	zDoubleVector m_vXPos;
+	zDoubleVector m_vYPos;
+	zDoubleVector m_vZPos;
+	zDoubleVector m_vXMom;
+	zDoubleVector m_vYMom;
+	zDoubleVector m_vZMom;
+	zDoubleVector m_vXForce;
+	zDoubleVector m_vYForce;
+	zDoubleVector m_vZForce;
+	zDoubleVector m_vStress;		// 9 stress tensor components per bead
+	zLongVector   m_vForceCounter;
+
+	zDoubleVector m_vRadius;		// Only filled if m_bBeadRadii is true
+
+	// Single-precision bead data only filled if m_bMixedKernel is true
+
+	zFloatVector  m_vXOffset;		// Bead position relative to its cell's origin
+	zFloatVector  m_vYOffset;
+	zFloatVector  m_vZOffset;
+	zFloatVector  m_vXMomF;
+	zFloatVector  m_vYMomF;
+	zFloatVector  m_vZMomF;
+	zFloatVector  m_vNNShift;		// Separation of each cell's origin from those of its neighbours
+
+	zDoubleVector m_vConsInt;		// Flattened copies of the CCNTCell interaction matrices
+	zDoubleVector m_vDissInt;
+
+	// Copies of the CCNTCell constants read by the worker threads
+
+	double    m_SimBoxLength[3];
+	double    m_HalfSimBoxLength[3];
+	double    m_InvRootDt;
+	uint64_t  m_PairRNGKey;
+	uint64_t  m_PairRNGStep;
+	CMonitor* m_pMonitor;
+	ISimBox*  m_pISimBox;
+
+	// Verlet pair list
+
+	zLongVector   m_vCellPairStart;	// Index of first pair of each cell, plus one past the end
+	zLongVector   m_vPairFirst;		// Slot of the first bead of each pair
+	zLongVector   m_vPairSecond;	// Slot of the second bead of each pair
+	zDoubleVector m_vXRef;			// Bead positions when the list was built
+	zDoubleVector m_vYRef;
+	zDoubleVector m_vZRef;
+
+	// Data used by the threaded force loop
+
+	long m_ThreadTotal;				// Number of threads including the calling thread
+	long m_RowLength;				// Number of cells in each row along the X axis
+
+	zLongVector m_vColourStart;		// Index of first row of each colour, plus one past the end
+	zLongVector m_vColourRows;		// Row indices sorted by colour
+	long m_ColourYPeriod;			// Colouring periods in the Y and Z directions
+	long m_ColourZPeriod;
+
+	std::vector<PairStressVector> m_vPairs;		// Pair stress data recorded for each colour and thread
+
+	std::vector<std::thread> m_vWorkers;	// Threads 1 to m_ThreadTotal-1; the caller is thread 0
+	std::mutex               m_Mutex;
+	std::condition_variable  m_StartCondition;
+	std::condition_variable  m_DoneCondition;
+	std::condition_variable  m_BarrierCondition;
+	long m_StartCounter;			// Incremented to start the workers on a new force loop
+	long m_DoneTotal;				// Number of workers that have finished the current loop
+	long m_BarrierTotal;			// Number of threads waiting at the barrier
+	long m_BarrierCounter;			// Incremented each time the barrier is released
+	bool m_bStopWorkers;
+};
+
+#endif // !defined(AFX_CNTCELLBEADSTORE_H__7A1C2E54_3B8D_4F60_9E21_5D0C8B4A6F13__INCLUDED_)
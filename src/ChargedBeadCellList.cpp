@@ -0,0 +1,249 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// ChargedBeadCellList.cpp: implementation of the CChargedBeadCellList class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "ChargedBeadCellList.h"
+#include "BeadChargeWrapper.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// The grid has as many cells in each dimension as will fit with a width no 
+// smaller than the cutoff, and at least one. The neighbours of each cell are 
+// the cells within one cell of it in each dimension, taking the PBCs into 
+// account. Only those with an index no less than the cell's own are stored,
+// and each one only once even if the grid is so small that a neighbour is 
+// reached across more than one boundary, so that every pair of cells is 
+// visited exactly once.
+
+CChargedBeadCellList::CChargedBeadCellList(double cutoff, double lx, double ly, double lz) : m_Cutoff(cutoff),
+												m_Cutoff2(cutoff*cutoff), m_CellTotal(0)
+{
+	m_Length[0] = lx;
+	m_Length[1] = ly;
+	m_Length[2] = lz;
+
+	for(short int i=0; i<3; i++)
+	{
+		m_HalfLength[i] = 0.5*m_Length[i];
+		m_CellNo[i]     = static_cast<long>(m_Length[i]/m_Cutoff);
+
+		if(m_CellNo[i] < 1)
+		{
+			m_CellNo[i] = 1;
+		}
+
+		m_CellWidth[i] = m_Length[i]/static_cast<double>(m_CellNo[i]);
+	}
+
+#if SimDimension == 2
+	m_CellNo[2]    = 1;
+	m_CellWidth[2] = m_Length[2];
+#endif
+
+	m_CellTotal = m_CellNo[0]*m_CellNo[1]*m_CellNo[2];
+
+	m_vCellStart.resize(m_CellTotal+1, 0);
+	m_vNNStart.reserve(m_CellTotal+1);
+
+	zLongVector vXCells, vYCells, vZCells;
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		m_vNNStart.push_back(m_vNNCells.size());
+
+		GetNeighbourIndices(ic%m_CellNo[0],                m_CellNo[0], vXCells);
+		GetNeighbourIndices((ic/m_CellNo[0])%m_CellNo[1],  m_CellNo[1], vYCells);
+		GetNeighbourIndices(ic/(m_CellNo[0]*m_CellNo[1]),  m_CellNo[2], vZCells);
+
+		for(czLongVectorIterator iz=vZCells.begin(); iz!=vZCells.end(); iz++)
+		{
+			for(czLongVectorIterator iy=vYCells.begin(); iy!=vYCells.end(); iy++)
+			{
+				for(czLongVectorIterator ix=vXCells.begin(); ix!=vXCells.end(); ix++)
+				{
+					const long jc = *ix + m_CellNo[0]*(*iy + m_CellNo[1]*(*iz));
+
+					if(jc >= ic)
+					{
+						m_vNNCells.push_back(jc);
+					}
+				}
+			}
+		}
+	}
+
+	m_vNNStart.push_back(m_vNNCells.size());
+}
+
+CChargedBeadCellList::~CChargedBeadCellList()
+{
+
+}
+
+// Function to add the screened charge forces to all pairs of charged beads 
+// within the cutoff distance of each other. The beads are first sorted into 
+// the cells using a counting sort, then each cell is compared with itself and 
+// its neighbours. The PBCs are applied to the bead separations exactly as in 
+// CSimBox::AddChargedBeadForces(), and the force on each pair is calculated 
+// and added to both beads by CBeadChargeWrapper::AddForce().
+
+void CChargedBeadCellList::AddForces(const ChargedBeadList& rlBeads)
+{
+	const long beadTotal = rlBeads.size();
+
+	m_vBeadCell.resize(beadTotal);
+	m_vBeads.resize(beadTotal);
+
+	fill(m_vCellStart.begin(), m_vCellStart.end(), 0);
+
+	long bead = 0;
+
+	for(cChargedBeadListIterator iterBead=rlBeads.begin(); iterBead!=rlBeads.end(); iterBead++)
+	{
+		const long ic = GetCellIndex(*iterBead);
+
+		m_vBeadCell[bead++] = ic;
+		m_vCellStart[ic+1]++;
+	}
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		m_vCellStart[ic+1] += m_vCellStart[ic];
+	}
+
+	// Each cell's start is used as its insertion point and advanced, so that
+	// the beads keep the order of the bead list within each cell. The starts 
+	// are then restored by shifting them up by one cell.
+
+	bead = 0;
+
+	for(cChargedBeadListIterator iterBead=rlBeads.begin(); iterBead!=rlBeads.end(); iterBead++)
+	{
+		m_vBeads[m_vCellStart[m_vBeadCell[bead++]]++] = *iterBead;
+	}
+
+	for(long ic=m_CellTotal; ic>0; ic--)
+	{
+		m_vCellStart[ic] = m_vCellStart[ic-1];
+	}
+
+	m_vCellStart[0] = 0;
+
+	// Now calculate the forces between the beads in each cell and those in 
+	// its neighbouring cells.
+
+	double dx[3];
+
+	for(long ic=0; ic<m_CellTotal; ic++)
+	{
+		for(long inn=m_vNNStart[ic]; inn<m_vNNStart[ic+1]; inn++)
+		{
+			const long jc = m_vNNCells[inn];
+
+			for(long i1=m_vCellStart[ic]; i1<m_vCellStart[ic+1]; i1++)
+			{
+				CBeadChargeWrapper* const pBead1 = m_vBeads[i1];
+
+				const long first2 = (jc == ic) ? i1+1 : m_vCellStart[jc];
+
+				for(long i2=first2; i2<m_vCellStart[jc+1]; i2++)
+				{
+					CBeadChargeWrapper* const pBead2 = m_vBeads[i2];
+
+					dx[0] = pBead1->GetXPos() - pBead2->GetXPos();
+					dx[1] = pBead1->GetYPos() - pBead2->GetYPos();
+
+#if SimDimension == 2
+					dx[2] = 0.0;
+#elif SimDimension == 3
+					dx[2] = pBead1->GetZPos() - pBead2->GetZPos();
+#endif
+
+					if( dx[0] > m_HalfLength[0] )
+						dx[0] = dx[0] - m_Length[0];
+					else if( dx[0] < -m_HalfLength[0] )
+						dx[0] = dx[0] + m_Length[0];
+
+					if( dx[1] > m_HalfLength[1] )
+						dx[1] = dx[1] - m_Length[1];
+					else if( dx[1] < -m_HalfLength[1] )
+						dx[1] = dx[1] + m_Length[1];
+
+#if SimDimension == 3
+					if( dx[2] > m_HalfLength[2] )
+						dx[2] = dx[2] - m_Length[2];
+					else if( dx[2] < -m_HalfLength[2] )
+						dx[2] = dx[2] + m_Length[2];
+#endif
+
+					if(dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2] < m_Cutoff2)
+					{
+						pBead1->AddForce(pBead2, dx);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Private helper function to return the index of the cell containing a bead.
+// Beads exactly on the upper boundaries are put into the last cell.
+
+long CChargedBeadCellList::GetCellIndex(const CBeadChargeWrapper* const pBead) const
+{
+	long ix = static_cast<long>(pBead->GetXPos()/m_CellWidth[0]);
+	long iy = static_cast<long>(pBead->GetYPos()/m_CellWidth[1]);
+
+#if SimDimension == 2
+	long iz = 0;
+#elif SimDimension == 3
+	long iz = static_cast<long>(pBead->GetZPos()/m_CellWidth[2]);
+#endif
+
+	if(ix < 0) ix = 0; else if(ix >= m_CellNo[0]) ix = m_CellNo[0] - 1;
+	if(iy < 0) iy = 0; else if(iy >= m_CellNo[1]) iy = m_CellNo[1] - 1;
+	if(iz < 0) iz = 0; else if(iz >= m_CellNo[2]) iz = m_CellNo[2] - 1;
+
+	return ix + m_CellNo[0]*(iy + m_CellNo[1]*iz);
+}
+
+// Private helper function to return the distinct indices of the cells within
+// one cell of a given cell in one dimension, taking the PBCs into account. If
+// there are fewer than three cells in the dimension every cell is returned once.
+
+void CChargedBeadCellList::GetNeighbourIndices(long index, long total, zLongVector& rvIndices) const
+{
+	rvIndices.clear();
+
+	if(total < 3)
+	{
+		for(long i=0; i<total; i++)
+		{
+			rvIndices.push_back(i);
+		}
+	}
+	else
+	{
+		rvIndices.push_back((index+total-1)%total);
+		rvIndices.push_back(index);
+		rvIndices.push_back((index+1)%total);
+	}
+}
@@ -0,0 +1,78 @@
+// ChargedBeadCellList.h: interface for the CChargedBeadCellList class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CHARGEDBEADCELLLIST_H__5E93A0C7_1D42_4B8F_A6E1_0C7F2B98D3A5__INCLUDED_)
+#define AFX_CHARGEDBEADCELLLIST_H__5E93A0C7_1D42_4B8F_A6E1_0C7F2B98D3A5__INCLUDED_
+
+
+// Forward declarations
+
+class CBeadChargeWrapper;
+
+
+#include "xxBase.h"
+
+// Cell-list engine for the screened charge forces between charged beads. The
+// reference calculation in CSimBox::AddChargedBeadForces() visits every pair 
+// of charged beads, so its cost grows as the square of the number of charged 
+// beads. Because the screened force decays exponentially, this class instead
+// ignores pairs further apart than a cutoff distance, and finds the remaining
+// pairs by sorting the charged beads into a grid of cells whose sides are no
+// shorter than the cutoff. Each cell then only has to be compared with its
+// nearest-neighbour cells. The force on each pair is still calculated by 
+// CBeadChargeWrapper::AddForce().
+//
+// The grid is independent of the CNT cells, as the cutoff is typically 
+// several times the DPD interaction range. The charged beads are re-sorted 
+// at every call, so the engine holds no state between time steps apart from 
+// the grid itself, and is unaffected by beads being charged or uncharged.
+
+class CChargedBeadCellList
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CChargedBeadCellList(double cutoff, double lx, double ly, double lz);
+
+	~CChargedBeadCellList();
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline double GetCutoff()    const {return m_Cutoff;}
+	inline long   GetCellTotal() const {return m_CellTotal;}
+
+	void AddForces(const ChargedBeadList& rlBeads);
+
+	// ****************************************
+	// Private functions
+private:
+
+	long GetCellIndex(const CBeadChargeWrapper* const pBead) const;
+	void GetNeighbourIndices(long index, long total, zLongVector& rvIndices) const;
+
+	// ****************************************
+	// Data members
+private:
+
+	const double m_Cutoff;				// Maximum range of the screened charge force
+	const double m_Cutoff2;				// Square of the cutoff
+
+	double m_Length[3];					// SimBox side lengths
+	double m_HalfLength[3];				// Half of the SimBox side lengths
+	long   m_CellNo[3];					// Number of cells in each dimension
+	double m_CellWidth[3];				// Cell widths: no smaller than the cutoff
+	long   m_CellTotal;
+
+	zLongVector m_vNNStart;				// Index of first neighbour of each cell, plus one past the end
+	zLongVector m_vNNCells;				// Distinct neighbour cells with indices no less than the cell's
+
+	zLongVector m_vCellStart;			// Index of first bead in each cell, plus one past the end
+	zLongVector m_vBeadCell;			// Cell index of each bead in the order of the bead list
+	ChargedBeadVector m_vBeads;			// Charged beads sorted by cell
+};
+
+#endif // !defined(AFX_CHARGEDBEADCELLLIST_H__5E93A0C7_1D42_4B8F_A6E1_0C7F2B98D3A5__INCLUDED_)
@@ -22,7 +22,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // Static member variable holding the number of command targets created.
 
-long CCommandTargetNode::m_CommandTargetTotal = 0;
+thread_local long CCommandTargetNode::m_CommandTargetTotal = 0;
 
 long CCommandTargetNode::GetCommandTargetTotal()
 {
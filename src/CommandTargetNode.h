@@ -47,7 +47,7 @@ public:
 
 private:
 
-	static long m_CommandTargetTotal;	// Number of command targets created
+	static thread_local long m_CommandTargetTotal;	// Number of command targets created
 
 	// ****************************************
 	// PVFs that must be implemented by all instantiated derived classes 
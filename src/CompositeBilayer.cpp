@@ -1420,6 +1420,14 @@ void CCompositeBilayer::ConvertNames(const CAnalysisState &raState)
 	}
 }
 
+// The surface tension is calculated from the stress tensor profile each time 
+// the aggregate is sampled.
+
+bool CCompositeBilayer::IsStressProfileUsed() const
+{
+	return true;
+}
+
 
 // **********************************************************************
 // Function to calculate the thickness of the bilayer as a 1d function
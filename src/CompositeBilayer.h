@@ -81,6 +81,10 @@ public:
 
 	virtual void ConvertNames(const CAnalysisState& raState);
 
+	// Function showing that the bilayer analysis needs the stress profile
+
+	virtual bool IsStressProfileUsed() const;
+
 
 	// ****************************************
 	// CAnalysisTool forwarding functions
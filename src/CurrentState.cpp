@@ -25,13 +25,14 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Bead.h"
 #include "Polymer.h"
 #include "Bond.h"
+#include "CNTCell.h"
 
 // **********************************************************************
 // Global Functions and members
 //
 // Static member function to clear the map prior to use.
 
-LongLongMap CCurrentState::m_mBeadDisplayId;
+thread_local LongLongMap CCurrentState::m_mBeadDisplayId;
 
 void CCurrentState::ClearBeadDisplayIdMap()
 {
@@ -113,6 +114,7 @@ CCurrentState::CCurrentState(const long currentTime, const zString runId,
 							 double xmin, double ymin, double zmin,
                              double xmax, double ymax, double zmax) : xxState(xxBase::GetCSPrefix() + runId + ".con." + ToString(currentTime) + pFormat->GetFileExtension(), true, currentTime, runId),
 															 m_pFormat(pFormat),
+															 m_pSnapshot(0),
 															 m_vAllBeads(pISimBox->GetBeads()),
 															 m_vAllPolymers(pISimBox->GetPolymers()),
 															 m_bRestrictCoords(bRestrictCoords),
@@ -250,6 +252,85 @@ bool CCurrentState::Serialize()
 	return Close();
 }
 
+// Function to show whether the state can be written from a snapshot. Formats 
+// that write bonds or read the SimBox directly need the live simulation data
+// and must be written on the simulation thread using Serialize().
+
+bool CCurrentState::CanSnapshot() const
+{
+	return !m_pFormat->UsesBonds() && !m_pFormat->UsesSimBox();
+}
+
+// Function to copy the data of the beads to be drawn into a buffer owned by
+// the CAsyncStateWriter. The same beads are selected as by Serialize(), and
+// each one's display id, type, radius and coordinates are stored. The display 
+// id is copied here because it may be changed by command before the snapshot
+// is written.
+
+void CCurrentState::TakeSnapshot(CAsyncStateWriter::Buffer* const pBuffer)
+{
+	zLongVector&   rvLong   = pBuffer->m_vLong;
+	zDoubleVector& rvDouble = pBuffer->m_vDouble;
+
+	rvLong.clear();
+	rvDouble.clear();
+	rvLong.reserve(2*m_vAllBeads.size());
+	rvDouble.reserve(4*m_vAllBeads.size());
+
+	for(cAbstractBeadVectorIterator iterBead=m_vAllBeads.begin(); iterBead!=m_vAllBeads.end(); iterBead++)
+	{
+		const double x = (*iterBead)->GetXPos();
+		const double y = (*iterBead)->GetYPos();
+		const double z = (*iterBead)->GetZPos();
+
+		if((*iterBead)->GetVisible() &&
+		   (!m_bRestrictCoords || (m_XMin < x && x < m_XMax &&
+								   m_YMin < y && y < m_YMax &&
+								   m_ZMin < z && z < m_ZMax)))
+		{
+			rvLong.push_back(CCurrentState::GetBeadDisplayId((*iterBead)->GetId()));
+			rvLong.push_back((*iterBead)->GetType());
+			rvDouble.push_back((*iterBead)->GetRadius());
+			rvDouble.push_back(x);
+			rvDouble.push_back(y);
+			rvDouble.push_back(z);
+		}
+	}
+
+	m_pSnapshot = pBuffer;
+}
+
+// Function called on the CAsyncStateWriter's thread to write the snapshot
+// taken by TakeSnapshot(). The output is identical to that of Serialize().
+
+bool CCurrentState::WriteSnapshot()
+{
+	if(!m_pSnapshot)
+		return false;
+
+	const zLongVector&   rvLong   = m_pSnapshot->m_vLong;
+	const zDoubleVector& rvDouble = m_pSnapshot->m_vDouble;
+
+	const long beadTotal = rvLong.size()/2;
+
+	m_pFormat->SerializeHeader(m_outStream, beadTotal);
+
+	for(long i=0; i<beadTotal; i++)
+	{
+		m_pFormat->SerializeBead(m_outStream, m_BeadNames.at(rvLong[2*i+1]), rvLong[2*i], 
+								 rvDouble[4*i], rvDouble[4*i+1], rvDouble[4*i+2], rvDouble[4*i+3]);
+
+		if(!m_outStream.good())
+			return IOError("Error writing CurrentState data to file");
+	}
+
+	m_pFormat->SerializeFooter(m_outStream, beadTotal);
+
+	m_outStream << zFlush;
+
+	return Close();
+}
+
 // Private helper function to count the number of beads to be drawn in the
 // output file. We perform the output loop but only count those beads not excluded 
 // by type or coordinate range.
@@ -390,11 +471,7 @@ bool CCurrentState::SerializePN(long beadTotal, long idArray[], long beadTypeArr
 		    const double         y = YArray[i];
 		    const double         z = ZArray[i];
 
-#if !defined(UseDPDBeadRadii)
-		    const double    radius = 0.5;   // Hardwired unless user sets the compilation flag
-#else
-		    const double    radius = RadiusArray[i];
-#endif
+		    const double    radius = CCNTCell::UsesBeadRadii() ? RadiusArray[i] : 0.5;   // Hardwired unless the CDF sets BeadRadii
 		    if(m_XMin < x && x < m_XMax &&
 		       m_YMin < y && y < m_YMax &&
 		       m_ZMin < z && z < m_ZMax)
@@ -417,11 +494,7 @@ bool CCurrentState::SerializePN(long beadTotal, long idArray[], long beadTypeArr
 		    const double         y = YArray[i];
 		    const double         z = ZArray[i];
 
-#if !defined(UseDPDBeadRadii)
-		    const double    radius = 0.5;   // Hardwired unless user sets the compilation flag
-#else
-		    const double    radius = RadiusArray[i];
-#endif
+		    const double    radius = CCNTCell::UsesBeadRadii() ? RadiusArray[i] : 0.5;   // Hardwired unless the CDF sets BeadRadii
 			m_pFormat->SerializeBead(m_outStream, name, displayId, radius, x, y, z);
 
 			if(!m_outStream.good())
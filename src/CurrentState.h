@@ -17,8 +17,10 @@ class CCurrentStateFormat;
 
 
 #include "xxState.h"
+#include "IStateSnapshot.h"
+#include "AsyncStateWriter.h"
 
-class CCurrentState : public xxState  
+class CCurrentState : public xxState, public IStateSnapshot
 {
 	// ****************************************
 	// Construction/Destruction: 
@@ -48,12 +50,16 @@ private:
 	// Map of (beadId, displayId) pairs that determines what colour each
 	// bead is drawn in current state snapshots.
 
-	static LongLongMap	m_mBeadDisplayId;
+	static thread_local LongLongMap	m_mBeadDisplayId;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
 public:
 
+	// Function called by the CAsyncStateWriter to write the snapshot
+
+	virtual bool WriteSnapshot();
+
 	// ****************************************
 	// Public access functions
 public:
@@ -62,6 +68,12 @@ public:
 
 	bool Serialize();
 
+    // Functions to copy the displayed bead data so that the state can be
+    // written by the CAsyncStateWriter while the simulation continues
+
+	bool CanSnapshot() const;
+	void TakeSnapshot(CAsyncStateWriter::Buffer* const pBuffer);
+
     // Parallel code functions
 
 	bool SerializeP0();
@@ -92,6 +104,11 @@ private:
 
 	CCurrentStateFormat* m_pFormat;
 
+	// Snapshot of the displayed beads' display ids, types, radii and
+	// coordinates, or null if the state is written from the beads directly
+
+	const CAsyncStateWriter::Buffer* m_pSnapshot;
+
 	
 	// Local copy of bead vector from the CSimBox so that it contains any beads
 	// that may have moved between processors
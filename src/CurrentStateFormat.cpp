@@ -99,6 +99,12 @@ bool CCurrentStateFormat::UsesBonds() const
 	return false;
 }
 
+// Default behaviour is that formats only use the bead data passed to them
+bool CCurrentStateFormat::UsesSimBox() const
+{
+	return false;
+}
+
 // Protected function that returns a named colour given a numeric bead type.
 // If the type is larger than the colour array, we return the first entry.
 
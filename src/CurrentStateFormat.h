@@ -34,6 +34,11 @@ public:
 	// Return true if this format needs to know about bonds
 	virtual bool UsesBonds() const;
 
+	// Return true if this format reads the SimBox directly instead of
+	// using the bead data passed to it
+
+	virtual bool UsesSimBox() const;
+
 	// Function to ensure that derived classes can write their data to file
 
 	virtual void SerializeHeader(zOutStream& os, const long beadTotal) = 0;
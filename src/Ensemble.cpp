@@ -0,0 +1,115 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// Ensemble.cpp: implementation of the CEnsemble class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "Ensemble.h"
+#include "Experiment.h"
+
+#include <thread>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+thread_local bool CEnsemble::m_bReplicaThread = false;
+
+// Static function showing whether the calling thread is running one of the 
+// simulations of an ensemble. It is used to disable features that would
+// share the state of a simulation between threads.
+
+bool CEnsemble::IsReplicaThread()
+{
+	return m_bReplicaThread;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CEnsemble::CEnsemble(long threadTotal, const StringSequence& rvRunIds) : m_ThreadTotal(threadTotal > 0 ? threadTotal : 1),
+																	   m_vRunIds(rvRunIds),
+																	   m_NextRun(0), m_FailedTotal(0)
+{
+}
+
+CEnsemble::~CEnsemble()
+{
+}
+
+// Function to run all the simulations and wait for them to finish. We create
+// no more threads than there are simulations, and the calling thread acts as
+// thread 0. The function returns true if all the simulations succeeded.
+
+bool CEnsemble::Run()
+{
+	const long threadTotal = std::min(m_ThreadTotal, GetRunTotal());
+
+	std::vector<std::thread> vThreads;
+
+	for(long thread=1; thread<threadTotal; thread++)
+	{
+		vThreads.push_back(std::thread(&CEnsemble::RunReplicas, this));
+	}
+
+	RunReplicas();
+
+	for(std::vector<std::thread>::iterator iterThread=vThreads.begin(); iterThread!=vThreads.end(); iterThread++)
+	{
+		iterThread->join();
+	}
+
+	return m_FailedTotal == 0;
+}
+
+// Private function executed by each thread. It takes the next simulation that
+// has not been started and runs it to completion until none are left. The
+// CExperiment is created and destroyed in this thread so that it uses the 
+// thread's own singletons.
+
+void CEnsemble::RunReplicas()
+{
+	m_bReplicaThread = true;
+
+	while(true)
+	{
+		zString runId;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if(m_NextRun == GetRunTotal())
+				break;
+
+			runId = m_vRunIds.at(m_NextRun++);
+		}
+
+		IExperiment* pIExpt = CExperiment::Instance("epstd", runId, true);
+
+		const bool bSuccess = pIExpt->Run();
+
+		delete pIExpt;
+
+		if(!bSuccess)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_FailedTotal++;
+		}
+	}
+
+	m_bReplicaThread = false;
+}
@@ -0,0 +1,87 @@
+// Ensemble.h: interface for the CEnsemble class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_ENSEMBLE_H__3A8E52C1_F06D_4B7A_9C24_D81B6E0F47A3__INCLUDED_)
+#define AFX_ENSEMBLE_H__3A8E52C1_F06D_4B7A_9C24_D81B6E0F47A3__INCLUDED_
+
+
+#include "xxBase.h"
+
+#include <mutex>
+
+// Runs a set of independent serial simulations, typically replicas of one
+// system that differ only in their random number seeds, concurrently in one
+// process. Each simulation is identified by its runId, as on the command line
+// of a sequential run, and is run by a CExperiment on one of a fixed number 
+// of threads. When a thread finishes a simulation it starts the next one that
+// has not been run, so that the threads stay busy when the runs differ in 
+// length.
+//
+// The singletons and counters that hold the state of a simulation (CSimBox, 
+// CMonitor, CLogState, the CCNTCell constants, etc.) are thread_local static 
+// members, so each thread has its own set and the simulations do not 
+// interact. The class factories, which are filled during static 
+// initialisation and not modified afterwards, are shared by all threads. 
+// Each simulation reads its own control data file and writes its own output
+// files.
+//
+// A simulation in an ensemble runs on a single thread: the SetThreadTotal
+// command fails if it is issued in a replica, as the ensemble already uses 
+// the available threads.
+
+class CEnsemble
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CEnsemble(long threadTotal, const StringSequence& rvRunIds);
+
+	~CEnsemble();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static bool IsReplicaThread();
+
+private:
+
+	static thread_local bool m_bReplicaThread;	// Flag showing the thread is running a simulation in an ensemble
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetThreadTotal() const {return m_ThreadTotal;}
+	inline long GetRunTotal()    const {return m_vRunIds.size();}
+	inline long GetFailedTotal() const {return m_FailedTotal;}
+
+	bool Run();
+
+	// ****************************************
+	// Private functions
+private:
+
+	void RunReplicas();
+
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CEnsemble(const CEnsemble& oldEnsemble);
+	CEnsemble& operator=(const CEnsemble& rhs);
+
+	// ****************************************
+	// Data members
+private:
+
+	const long           m_ThreadTotal;	// Number of simulations run at the same time
+	const StringSequence m_vRunIds;		// RunIds of the simulations to run
+
+	long       m_NextRun;				// Index of the next simulation to start
+	long       m_FailedTotal;			// Number of simulations that failed
+	std::mutex m_Mutex;
+};
+
+#endif // !defined(AFX_ENSEMBLE_H__3A8E52C1_F06D_4B7A_9C24_D81B6E0F47A3__INCLUDED_)
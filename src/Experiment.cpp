@@ -47,7 +47,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance.
 
-IExperiment* CExperiment::m_pInstance = 0;
+thread_local IExperiment* CExperiment::m_pInstance = 0;
 
 // Public member function to create a single instance of the CExperiment class.
 // We call different constructors depending on whether the experiment wraps
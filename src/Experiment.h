@@ -51,7 +51,7 @@ public:
 
 private:
 
-	static IExperiment* m_pInstance;		
+	static thread_local IExperiment* m_pInstance;		
 
 	
 	// ****************************************
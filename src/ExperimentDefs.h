@@ -14,6 +14,8 @@
 //            by EnableXMLProtocol flag.
 //  10/10/07  I added a flag showing if a liquid-gas DPD simulation is
 //            being performed. If not set, all lgDPD functions are compiled out.
+//  18/10/26  I removed the EnableDPDLG flag: the LG force is always compiled
+//            in and is selected by the "dpdlg" token in the control data file.
 //
 // **********************************************************************
 
@@ -24,7 +26,6 @@
 #define ExperimentEnabled   1
 #define ExperimentDisabled  2
 
-	#define EnableDPDLG               ExperimentDisabled
 
 
 
@@ -83,6 +83,33 @@ CExternalCNTCell::~CExternalCNTCell()
 // incorrect allocation of forces to beads.
 
 void CExternalCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBead)
+{
+	const bool bWrap = IsExternal() && bExternal;
+
+	if(GetSimIdentifier() == DPD)
+	{
+		if(UsesBeadRadii())
+		{
+			ExternalForceKernel<DPD, true>(bWrap, pBead);
+		}
+		else
+		{
+			ExternalForceKernel<DPD, false>(bWrap, pBead);
+		}
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		ExternalForceKernel<MD, false>(bWrap, pBead);
+	}
+
+	// BD: Not implemented yet
+}
+
+// Force loop over the stored bead coordinates specialised for the simulation
+// type and bead radii flag. The pair force is calculated by CCNTCell::PairForce().
+
+template<long simType, bool bBeadRadii>
+void CExternalCNTCell::ExternalForceKernel(bool bWrap, CAbstractBead* const pBead)
 {
 //    const long targetBeadId = 4; // Write out interactions for this bead only
 	
@@ -91,6 +118,8 @@ void CExternalCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* co
     // cell as the current cell. Also the stored bead coordinates must not be shifted 
     // into the same cell as the PBC check will then fail.
 
+	double dx[3], dv[3], newForce[3];
+	double dr2, drmax = 1.0;
 
     for(long i=0; i<GetBeadTotal(); i++)
     {
@@ -103,37 +132,6 @@ void CExternalCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* co
         const double  vy = m_vVY.at(i);
         const double  vz = m_vVZ.at(i);
 
-#if SimIdentifier == BD
-
-        // Not implemented yet
-
-#else
-    // DPD and MD equations of motion
-
-	    BeadListIterator iterBead2;
-
-	    double dx[3], dv[3], newForce[3];
-	    double dr, dr2;
-
-#if SimIdentifier == DPD
-
-	    double gammap, rdotv, wr, wr2;
-	    double conForce, dissForce, randForce;
-
-#ifdef UseDPDBeadRadii
-	    double drmax;
-#endif
-
-#elif SimIdentifier == MD
-
-	    double magLJ;						// LJ potential variables
-	    double eLJ, sLJOverR, sLJR3, sLJR6;
-
-	    double magSC;						// SC potential variables
-	    double eSC, sSCOverR, sSCR3;
-
-#endif
-
 		// Add in interactions of the passed-in bead with beads in the current
         // cell taking the PBCs into account. The PBCs are only applied
 		// if both the current CNT cell and the neighbouring one are external.
@@ -152,8 +150,7 @@ void CExternalCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* co
 		dv[2] = (pBead->m_Mom[2] - vz);
 #endif
 
-
-		if( IsExternal() && bExternal )
+		if( bWrap )
 		{
 			if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
 			{
@@ -193,145 +190,49 @@ void CExternalCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* co
 
 		dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
 
-// Calculate the interactions between the two beads for each simulation type.
-// For the DPD interactions we have to change the distance-dependence according
-// to the bead interaction radii.
-
-#if SimIdentifier == DPD
-
-#ifndef UseDPDBeadRadii
-		if( dr2 < 1.0 )
-		{		
-			dr = sqrt(dr2);
-			if( dr > 0.000000001 )
-			{
-				wr = (1.0 - dr);
-				wr2 = wr*wr;
-#else
-		dr = sqrt(dr2);
-		drmax = pBead->GetRadius()+m_vBeadRadii.at(i);
-		if( dr < drmax )
-		{		
-			if( dr > 0.000000001 )
-			{
-				wr = (1.0 - dr/drmax);
-				wr2 = wr*wr;
-#endif
-				conForce	= m_vvConsInt.at(pBead->GetType()).at(type)*wr;		
-//				conForce = 0.0;		
-
-				rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-				gammap		= m_vvDissInt.at(pBead->GetType()).at(type)*wr2;
-
-				dissForce	= -gammap*rdotv;				
-				randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-
-				newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
-				newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
-				newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
-				
-#elif SimIdentifier == MD
-
-		if( dr2 < m_coradius2 )
-		{		
-			dr = sqrt(dr2);
-
-			if( dr > 0.000000001 )
-			{
-				// Calculate common factors in the LJ potential and include shifted force.
-				// Note that the shifted force term needs to be multiplied by the 
-				// unit vector in the bead-bead separation whereas the force term 
-				// has the full vector.
-
-				eLJ       = m_vvLJDepth.at(pBead->GetType()).at(type);	
-				sLJOverR  = m_vvLJRange.at(pBead->GetType()).at(type)/dr;
-				sLJR3     = sLJOverR*sLJOverR*sLJOverR;
-				sLJR6     = sLJR3*sLJR3;
-
-				magLJ = (6.0*eLJ*sLJR6*(2.0*sLJR6 - 1.0) 
-						 - dr*m_vvLJSlope.at(pBead->GetType()).at(type))/dr2;
-
-				// Only add the soft-core potential if the potential depth is non-zero
-
-				eSC = m_vvSCDepth.at(pBead->GetType()).at(type);	
-
-				if(eSC > 0.0)
-				{
-					sSCOverR = m_vvSCRange.at(pBead->GetType()).at(type)/dr;
-					sSCR3    = sSCOverR*sSCOverR*sSCOverR;
-
-					magSC = (9.0*eSC*sSCR3*sSCR3*sSCR3
-							 - dr*m_vvSCSlope.at(pBead->GetType()).at(type))/dr2;
-				}
-				else
-				{
-					magSC = 0.0;
-				}
-
-				newForce[0] = (magLJ + magSC)*dx[0];
-				newForce[1] = (magLJ + magSC)*dx[1];
-				newForce[2] = (magLJ + magSC)*dx[2];
-#endif
+		if(bBeadRadii)
+		{
+			drmax = pBead->GetRadius() + m_vBeadRadii.at(i);
+		}
 
-//                if((pBead->GetId() == targetBeadId || id == targetBeadId))
-//				{
-//				    std::cout << "ExternalCNTCell " << GetId() << " calculating external force between beads " << pBead->GetId() << " " << id << " " << x << " " << y << " " << z << zEndl;
-//				}
-				
-				pBead->m_ForceCounter++;
-		        m_vForceCounter.at(i) = m_vForceCounter.at(i) + 1;
-				
-				pBead->m_Force[0] += newForce[0];
-				pBead->m_Force[1] += newForce[1];
-				pBead->m_Force[2] += newForce[2];
-
-                // Next lines store the force on each bead in this cell 
-                // to send back to the neighbouring processor that owns them.
-
-                m_vFX.at(i)  = m_vFX.at(i) - newForce[0];
-                m_vFY.at(i)  = m_vFY.at(i) - newForce[1];
-                m_vFZ.at(i)  = m_vFZ.at(i) - newForce[2];
-				
-				// Next calculate any bond forces between the passed-in bead and other beads from the neighbouring processor. We use the owning
-				// polymer to get the bonds containing the passed-in bead and then extract their opposite bead ids and compare them to the current
-				// cell's beads.
-
-				// stress tensor summation
-
-				pBead->m_Stress[0] += dx[0]*newForce[0];
-				pBead->m_Stress[1] += dx[1]*newForce[0];
-				pBead->m_Stress[2] += dx[2]*newForce[0];
-				pBead->m_Stress[3] += dx[0]*newForce[1];
-				pBead->m_Stress[4] += dx[1]*newForce[1];
-				pBead->m_Stress[5] += dx[2]*newForce[1];
-				pBead->m_Stress[6] += dx[0]*newForce[2];
-				pBead->m_Stress[7] += dx[1]*newForce[2];
-				pBead->m_Stress[8] += dx[2]*newForce[2];
-
-				// Pass the stress tensor components to the CMonitor
-				// for use in analysing the stress over slices.
-				// Note that dx[2] might be close to zero and we should
-				// check for this.
-
-				// 12/02/10 This is disabled for the parallel code as no analysis is implemented yet
-#if EnableParallelSimBox == SimMPSDisabled
-						m_pMonitor->AddBeadStress(pBead, *iterBead2, newForce, dx);
-#endif
-			}
-			else
-			{
-				TraceInt("neighbour cell bead", pBead->GetId());
-				TraceInt("interacts with", id);
-				TraceVector("1st pos",	pBead->GetXPos(),
-										pBead->GetYPos(), 
-										pBead->GetZPos() );
-				TraceVector("2nd pos",	x, y, z );
-				TraceDouble("Bead distance", dr);
-			}
+		if(PairForce<simType, bBeadRadii>(pBead->GetType(), type, drmax, dx, dv, dr2, newForce))
+		{
+//          if((pBead->GetId() == targetBeadId || id == targetBeadId))
+//			{
+//			    std::cout << "ExternalCNTCell " << GetId() << " calculating external force between beads " << pBead->GetId() << " " << id << " " << x << " " << y << " " << z << zEndl;
+//			}
+			
+			pBead->m_ForceCounter++;
+	        m_vForceCounter.at(i) = m_vForceCounter.at(i) + 1;
+			
+			pBead->m_Force[0] += newForce[0];
+			pBead->m_Force[1] += newForce[1];
+			pBead->m_Force[2] += newForce[2];
+
+            // Next lines store the force on each bead in this cell 
+            // to send back to the neighbouring processor that owns them.
+
+            m_vFX.at(i)  = m_vFX.at(i) - newForce[0];
+            m_vFY.at(i)  = m_vFY.at(i) - newForce[1];
+            m_vFZ.at(i)  = m_vFZ.at(i) - newForce[2];
+
+			// stress tensor summation
+
+			pBead->m_Stress[0] += dx[0]*newForce[0];
+			pBead->m_Stress[1] += dx[1]*newForce[0];
+			pBead->m_Stress[2] += dx[2]*newForce[0];
+			pBead->m_Stress[3] += dx[0]*newForce[1];
+			pBead->m_Stress[4] += dx[1]*newForce[1];
+			pBead->m_Stress[5] += dx[2]*newForce[1];
+			pBead->m_Stress[6] += dx[0]*newForce[2];
+			pBead->m_Stress[7] += dx[1]*newForce[2];
+			pBead->m_Stress[8] += dx[2]*newForce[2];
+
+			// The stress is not passed to the CMonitor as the beads in this
+			// cell belong to another processor, and no parallel analysis is 
+			// implemented yet.
 		}
-#endif
     }
-
 }
 
 // Function used by Border regions to add beads to the external CNT cells preparatory
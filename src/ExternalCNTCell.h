@@ -78,6 +78,8 @@ protected:
 	// Private functions
 private:
 
+	template<long simType, bool bBeadRadii> void ExternalForceKernel(bool bWrap, CAbstractBead* const pBead);
+
 
 	// ****************************************
 	// Data members
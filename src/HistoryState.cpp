@@ -22,6 +22,19 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "InputData.h"
 #include "TimeSeriesData.h"
 
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Size in bytes above which the formatted data are written to file when
+// the history state is streamed. The file stream is only written to once
+// per block, however short the analysis period is.
+
+namespace
+{
+	const long HistoryBlockSize = 1048576;
+}
+
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -41,7 +54,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 CHistoryState::CHistoryState(const CInputData& rData) : xxState(xxBase::GetHSPrefix() + rData.GetRunId() + ".xml", true, 0, rData.GetRunId()),
 														m_SamplePeriod(rData.GetSamplePeriod()),
-														m_LastPeriodSerialized(0)													
+														m_SamplesSerialized(0),
+														m_bStreaming(false)													
 {
 
 	// First write the xml and stylesheet PIs: note that the version and
@@ -58,7 +72,8 @@ CHistoryState::CHistoryState(const CInputData& rData) : xxState(xxBase::GetHSPre
 
 CHistoryState::CHistoryState(const CInputData& rData) : xxState(xxBase::GetHSPrefix() + rData.GetRunId(), true, 0, rData.GetRunId()),
 														m_SamplePeriod(rData.GetSamplePeriod()),
-														m_LastPeriodSerialized(0)
+														m_SamplesSerialized(0),
+														m_bStreaming(false)
 {														
 
 #endif
@@ -80,6 +95,10 @@ CHistoryState::CHistoryState(const CInputData& rData) : xxState(xxBase::GetHSPre
 
 CHistoryState::~CHistoryState()
 {
+	// Write out any data still held in the streaming buffer
+
+	WriteBlock();
+
 	// Write out the end tag for the XML-enabled output file.
 
 #if EnableXMLProcesses == SimXMLEnabled
@@ -104,23 +123,78 @@ CHistoryState::~CHistoryState()
 }
 
 // We serialize the time series data in chunks from the last analysis period
-// to the current time. Note that when the sampling period is not 1 we cannot
-// use the simulation time as the index into the arrays.
+// to the current time. 
+//
+// If the history state is streamed, the data are formatted into a buffer and
+// the CTimeSeriesData objects are deleted, so that only the data collected
+// since the last analysis period are held in memory. The buffer is written
+// to file when it exceeds the block size.
 
 bool CHistoryState::Serialize()
 {
-	if(m_IOFlag)	
+	if(m_IOFlag && m_bStreaming)
 	{
-		for(long time=m_LastPeriodSerialized; time<((m_vTimeSeries.back())->GetTime())/m_SamplePeriod; time++)
+		for(TimeSeriesIterator iterTSD=m_vTimeSeries.begin(); iterTSD!=m_vTimeSeries.end(); iterTSD++)
 		{
-			m_outStream << *m_vTimeSeries.at(time);
+			m_Block << **iterTSD;
+			delete *iterTSD;
+		}
+
+		m_vTimeSeries.clear();
+
+		m_ProbeBeadXPos.clear();
+		m_ProbeBeadYPos.clear();
+		m_ProbeBeadZPos.clear();
+
+		if(m_Block.tellp() > HistoryBlockSize)
+		{
+			WriteBlock();
 		}
-		m_LastPeriodSerialized = (m_vTimeSeries.back())->GetTime()/m_SamplePeriod;
+	}
+	else if(m_IOFlag)	
+	{
+		for(unsigned long no=m_SamplesSerialized; no<m_vTimeSeries.size(); no++)
+		{
+			m_outStream << *m_vTimeSeries.at(no);
+		}
+		m_SamplesSerialized = m_vTimeSeries.size();
 	}
 
 	return true;
 }
 
+// Function to turn the streaming of the history state on or off. When it is 
+// turned on, the data that have already been written are deleted and the 
+// memory reserved for the whole run is released; when it is turned off, the 
+// buffered data are written so that the file remains in time order.
+
+void CHistoryState::SetStreaming(bool bStreaming)
+{
+	if(bStreaming && !m_bStreaming)
+	{
+		for(unsigned long no=0; no<m_SamplesSerialized; no++)
+		{
+			delete m_vTimeSeries.at(no);
+		}
+
+		TimeSeriesSequence vPending;
+
+		vPending.insert(vPending.end(), m_vTimeSeries.begin()+m_SamplesSerialized, m_vTimeSeries.end());
+		m_vTimeSeries.swap(vPending);
+
+		zDoubleVector().swap(m_ProbeBeadXPos);
+		zDoubleVector().swap(m_ProbeBeadYPos);
+		zDoubleVector().swap(m_ProbeBeadZPos);
+	}
+	else if(!bStreaming && m_bStreaming)
+	{
+		WriteBlock();
+	}
+
+	m_SamplesSerialized = 0;
+	m_bStreaming = bStreaming;
+}
+
 // Function to add the probe bead trajectory data for the current timestep.
 
 void CHistoryState::AddProbeBeadData(const double x, const double y, const double z)
@@ -139,3 +213,16 @@ void CHistoryState::AddTimeSeriesData(CTimeSeriesData *pTSD)
 {
 	m_vTimeSeries.push_back(pTSD);
 }
+
+// Private function to write the buffered data to file and empty the buffer.
+
+void CHistoryState::WriteBlock()
+{
+	if(m_Block.tellp() > 0)
+	{
+		m_outStream << m_Block.str();
+		m_outStream.flush();
+
+		m_Block.str("");
+	}
+}
@@ -43,6 +43,10 @@ public:
 	void AddTimeSeriesData(CTimeSeriesData* pTSD);
 	void AddProbeBeadData(const double x, const double y, const double z);
 
+	inline bool IsStreaming() const {return m_bStreaming;}
+
+	void SetStreaming(bool bStreaming);
+
 	// ****************************************
 	// Protected local functions
 protected:
@@ -56,6 +60,7 @@ protected:
 	// Private functions
 private:
 
+	void WriteBlock();
 
 	// ****************************************
 	// Data members
@@ -69,7 +74,10 @@ private:								// Data arrays
 
 										// Local data
 	const long m_SamplePeriod;
-	long m_LastPeriodSerialized;
+	unsigned long m_SamplesSerialized;		// Number of time series objects written to file
+
+	bool m_bStreaming;						// Flag showing if data are released after being written
+	zOutStringStream m_Block;				// Formatted data waiting to be written in streaming mode
 
 };
 
@@ -21,6 +21,7 @@ class IActiveBondUnbindsFromPolymer;
 class IActiveBondHydrolysesATP;
 class IActiveBondReleasesPi;
 class IActiveBondPhosphorylation;
+class aeActiveBondHash;
 #endif
 
 
@@ -82,6 +83,10 @@ public:
 	virtual IActiveBondHydrolysesATP* GetIActiveBondHydrolysesATP() = 0;
 	virtual IActiveBondReleasesPi* GetIActiveBondReleasesPi() = 0;
 	virtual IActiveBondPhosphorylation* GetIActiveBondPhosphorylation() = 0;
+
+	// Function to return the spatial hash of the free bonds of all ACNs
+
+	virtual aeActiveBondHash* GetBondHash() const = 0;
 #endif
 
 	// ****************************************
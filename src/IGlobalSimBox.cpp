@@ -38,7 +38,7 @@ const IGlobalSimBox* IGlobalSimBox::Instance()
 	return m_pInstance;
 }
 
-ISimBox* IGlobalSimBox::m_pInstance = 0;
+thread_local ISimBox* IGlobalSimBox::m_pInstance = 0;
 
 
 //////////////////////////////////////////////////////////////////////
@@ -121,11 +121,7 @@ double IGlobalSimBox::GetHalfSimBoxZLength() const
 
 bool IGlobalSimBox::IsDPDLG() const
 {
-#if EnableDPDLG == ExperimentEnabled
     return IGlobalSimBox::m_pInstance->IISimState()->IsDPDLG();
-#elif EnableDPDLG == ExperimentDisabled
-    return false;
-#endif
 }
 
 // Forwarding functions to the ISimState class, and its nested members,  to get bead, bond, bondpair and polymer data.
@@ -34,6 +34,14 @@ IModifySimStateIntegration::~IModifySimStateIntegration()
 
 }
 
+// Function to select the scheme used to integrate the DPD equations of
+// motion in response to a command. It passes the command on to the CSimState.
+
+void IModifySimStateIntegration::SetDPDIntegrator(long integrator)
+{
+	m_rSimState.SetDPDIntegrator(integrator);
+}
+
 // Function to change the integration time step in response to 
 // a command. It passes the command on to the CSimState.
 
@@ -33,6 +33,7 @@ public:
 	// Public access functions
 public:
 
+	void SetDPDIntegrator(long integrator);
 	void SetTimeStep(double dt);
 	void SetTotalTime(long newTime);
 	bool ToggleDPDBeadConservativeForces();
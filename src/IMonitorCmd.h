@@ -72,14 +72,17 @@ public:
 	virtual void		         SetPolymerTypeDisplayId(const xxCommand* const pCommand) = 0;
 	virtual void				        SetRestartPeriod(const xxCommand* const pCommand) = 0;
 	virtual void   SetRestartStateDefaultBeadCoordinates(const xxCommand* const pCommand) = 0;
+	virtual void	        SetRestartStateDefaultBinary(const xxCommand* const pCommand) = 0;
 	virtual void	     SetRestartStateDefaultInclusive(const xxCommand* const pCommand) = 0;
 	virtual void		          SetRunCompleteInterval(const xxCommand* const pCommand) = 0;
 	virtual void				         SetSamplePeriod(const xxCommand* const pCommand) = 0;
     virtual void            SetSAXSProcessBeadElectronNo(const xxCommand* const pCommand) = 0;
+    virtual void                  SetSAXSProcessBinWidth(const xxCommand* const pCommand) = 0;
 	virtual void			           ToggleBeadDisplay(const xxCommand* const pCommand) = 0;
 	virtual void		           ToggleCurrentStateBox(const xxCommand* const pCommand) = 0;
 	virtual void		        ToggleDensityFieldOutput(const xxCommand* const pCommand) = 0;
 	virtual void			        TogglePolymerDisplay(const xxCommand* const pCommand) = 0;
+	virtual void	         ToggleHistoryStateStreaming(const xxCommand* const pCommand) = 0;
 	virtual void	        ToggleRestartWarningMessages(const xxCommand* const pCommand) = 0;
 	virtual void			             WriteLogMessage(const xxCommand* const pCommand) = 0;
 
@@ -27,7 +27,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-long IRegionAnalysis::m_RegionAnalysisTotal = 0;
+thread_local long IRegionAnalysis::m_RegionAnalysisTotal = 0;
 
 long IRegionAnalysis::GetRegionAnalysisTotal()
 {
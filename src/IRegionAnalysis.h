@@ -37,7 +37,7 @@ public:
 
 private:
 
-	static long m_RegionAnalysisTotal;
+	static thread_local long m_RegionAnalysisTotal;
 
 
 	// ****************************************
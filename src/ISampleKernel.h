@@ -0,0 +1,41 @@
+// ISampleKernel.h: interface for the ISampleKernel class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_ISAMPLEKERNEL_H__A3D51F08_6C27_4B9E_8E14_27F6C0B5D9A2__INCLUDED_)
+#define AFX_ISAMPLEKERNEL_H__A3D51F08_6C27_4B9E_8E14_27F6C0B5D9A2__INCLUDED_
+
+
+// Forward declarations
+
+class CAbstractBead;
+
+
+// Interface for observables that accumulate data from every bead in the 
+// SimBox when the CMonitor samples the simulation. Instead of each observable 
+// iterating over all the beads itself, the CMonitor visits the beads once, in
+// CNT cell order, and passes each bead to all the registered kernels. If more
+// than one thread is used, the CNT cells are divided into contiguous blocks,
+// one per thread, and each kernel must keep separate accumulators for each 
+// thread and combine them in EndSample(). Kernels are registered using
+// CMonitor::AddSampleKernel().
+//
+//	StartSample()  - zero the accumulators for the given number of threads
+//	SampleBead()   - add one bead's contribution to a thread's accumulators
+//	EndSample()    - combine the threads' accumulators in thread order
+
+class ISampleKernel
+{
+public:
+	virtual ~ISampleKernel();
+
+	virtual void StartSample(long threadTotal) = 0;
+	virtual void SampleBead(long thread, const CAbstractBead* const pBead) = 0;
+	virtual void EndSample() = 0;
+
+protected:
+
+	ISampleKernel();
+};
+
+#endif // !defined(AFX_ISAMPLEKERNEL_H__A3D51F08_6C27_4B9E_8E14_27F6C0B5D9A2__INCLUDED_)
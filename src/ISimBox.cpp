@@ -22,6 +22,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "mpsSimBox.h"
 #include "Monitor.h"
 #include "CNTCell.h"
+#include "BeadRange.h"
 #include "pmSimBoxNeighbourCall.h"
 #include "pmSimBoxAssembly.h"
 
@@ -37,7 +38,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable holding a pointer to the single instance of ISimBox.
 // Note that it does not get assigned a value until the user creates the instance.
 
-ISimBox* ISimBox::m_pInstance = 0;
+thread_local ISimBox* ISimBox::m_pInstance = 0;
 
 // Public member function to create a single instance of the ISimBox class.
 
@@ -596,10 +597,18 @@ AbstractBeadVector ISimBox::GetBeads() const
 	return m_pSimBox->GetAllBeadsInCNTCells();
 }
 
+// Function to return a view of all the beads in the SimBox that does not
+// copy them. It must not be kept across time steps.
+
+CBeadRange ISimBox::GetBeadRange() const
+{
+	return CBeadRange(m_pSimBox->GetCNTCells());
+}
+
 // Function to return the number of beads currently in the SimBox.
 
 long ISimBox::GetBeadTotal() const
 {
-	return m_pSimBox->GetAllBeadsInCNTCells().size();
+	return GetBeadRange().size();
 }
 
@@ -15,6 +15,7 @@ class ISimEvent;
 class IActiveSimBox;
 class IMonitorCmd;
 class CMonitor;
+class CBeadRange;
 
 // Include files
 
@@ -44,7 +45,7 @@ public:
 
 private:
 
-	static ISimBox* m_pInstance;	// Pointer to single instance of ISimBox class
+	static thread_local ISimBox* m_pInstance;	// Pointer to single instance of ISimBox class
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -110,6 +111,7 @@ public:
 
 	long GetBeadTotal() const;
 	AbstractBeadVector GetBeads() const;
+	CBeadRange GetBeadRange() const;
 
 	inline long GetBondTotal()					const {return m_rSimState.GetBondTotal();}
 	inline long GetBondPairTotal()				const {return m_rSimState.GetBondPairTotal();}
@@ -21,6 +21,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "ISimBoxBase.h"
 
 #include "ISimBox.h"
+#include "BeadRange.h"
 #include "IMonitorCmd.h"
 
 
@@ -73,6 +74,11 @@ const AbstractBeadVector ISimBoxBase::GetSimBoxBeads() const
 	return m_pISimBox->GetBeads();
 }
 
+CBeadRange ISimBoxBase::GetSimBoxBeadRange() const
+{
+	return m_pISimBox->GetBeadRange();
+}
+
 const BondVector& ISimBoxBase::GetSimBoxBonds() const
 {
 	return m_pISimBox->GetBonds();
@@ -420,6 +426,11 @@ void ISimBoxBase::SetRestartStateDefaultBeadCoordinates(const xxCommand* const p
 	m_pISimBox->IIMonitorCmd()->SetRestartStateDefaultBeadCoordinates(pCommand);
 }
 
+void ISimBoxBase::SetRestartStateDefaultBinary(const xxCommand* const pCommand) const
+{
+	m_pISimBox->IIMonitorCmd()->SetRestartStateDefaultBinary(pCommand);
+}
+
 void ISimBoxBase::SetRestartStateDefaultInclusive(const xxCommand* const pCommand) const
 {
 	m_pISimBox->IIMonitorCmd()->SetRestartStateDefaultInclusive(pCommand);
@@ -440,6 +451,11 @@ void ISimBoxBase::SetSAXSProcessBeadElectronNo(const xxCommand* const pCommand)
     m_pISimBox->IIMonitorCmd()->SetSAXSProcessBeadElectronNo(pCommand);
 }
 
+void ISimBoxBase::SetSAXSProcessBinWidth(const xxCommand* const pCommand) const
+{
+    m_pISimBox->IIMonitorCmd()->SetSAXSProcessBinWidth(pCommand);
+}
+
 void ISimBoxBase::ShowAllProcesses(const xxCommand* const pCommand) const
 {
 #if EnableMonitorCommand == SimCommandEnabled
@@ -488,6 +504,11 @@ void ISimBoxBase::TogglePolymerDisplay(const xxCommand* const pCommand) const
 	m_pISimBox->IIMonitorCmd()->TogglePolymerDisplay(pCommand);
 }
 
+void ISimBoxBase::ToggleHistoryStateStreaming(const xxCommand* const pCommand) const
+{
+	m_pISimBox->IIMonitorCmd()->ToggleHistoryStateStreaming(pCommand);
+}
+
 void ISimBoxBase::ToggleRestartWarningMessages(const xxCommand* const pCommand) const
 {
 	m_pISimBox->IIMonitorCmd()->ToggleRestartWarningMessages(pCommand);
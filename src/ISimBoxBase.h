@@ -11,6 +11,7 @@
 class ISimBox;
 class CBond;
 class CBondPair;
+class CBeadRange;
 	
 #include "xxParallelBase.h"
 
@@ -46,6 +47,7 @@ public:
 	long	GetSimBoxBondPairTypeTotal()			const;
 
 	const   AbstractBeadVector GetSimBoxBeads()		const;
+	CBeadRange                 GetSimBoxBeadRange()	const;
 	const   BondVector&		   GetSimBoxBonds()		const;
 	const   BondPairVector&    GetSimBoxBondPairs()	const;
 	const   CNTCellVector&	   GetSimBoxCells()		const;
@@ -115,10 +117,12 @@ public:
 	void                    SetPolymerTypeDisplayId(const xxCommand* const pCommand) const;
 	void		                   SetRestartPeriod(const xxCommand* const pCommand) const;
 	void      SetRestartStateDefaultBeadCoordinates(const xxCommand* const pCommand) const;
+	void               SetRestartStateDefaultBinary(const xxCommand* const pCommand) const;
 	void            SetRestartStateDefaultInclusive(const xxCommand* const pCommand) const;
 	void	                 SetRunCompleteInterval(const xxCommand* const pCommand) const;
 	void                            SetSamplePeriod(const xxCommand* const pCommand) const;
     void               SetSAXSProcessBeadElectronNo(const xxCommand* const pCommand) const;
+    void                     SetSAXSProcessBinWidth(const xxCommand* const pCommand) const;
 	void			               ShowAllProcesses(const xxCommand* const pCommand) const;
 	void	                ShowModifiableProcesses(const xxCommand* const pCommand) const;
 	void			              ToggleBeadDisplay(const xxCommand* const pCommand) const;
@@ -128,6 +132,7 @@ public:
 	void		                 ToggleEnergyOutput(const xxCommand* const pCommand) const;
 	void	                ToggleSliceEnergyOutput(const xxCommand* const pCommand) const;
 	void		               TogglePolymerDisplay(const xxCommand* const pCommand) const;
+	void                ToggleHistoryStateStreaming(const xxCommand* const pCommand) const;
 	void               ToggleRestartWarningMessages(const xxCommand* const pCommand) const;
 	void	                 ZoomCurrentStateCamera(const xxCommand* const pCommand) const;
 	void                            WriteLogMessage(const xxCommand* const pCommand) const;
@@ -198,11 +198,16 @@ public:
 	virtual void			      SetBondStrengthbyType(const xxCommand* const pCommand) = 0;
 	virtual void	  SetBondStrengthByPositionInTarget(const xxCommand* const pCommand) = 0;
 	virtual void				SetBondStrengthInTarget(const xxCommand* const pCommand) = 0;
+	virtual void			       SetChargedBeadCutoff(const xxCommand* const pCommand) = 0;
 	virtual void					    SetCommandTimer(const xxCommand* const pCommand) = 0;
 	virtual void				      SetDPDBeadConsInt(const xxCommand* const pCommand) = 0;
 	virtual void			    SetDPDBeadConsIntByType(const xxCommand* const pCommand) = 0;
 	virtual void				      SetDPDBeadDissInt(const xxCommand* const pCommand) = 0;
+	virtual void				   SetDPDIntegrator(const xxCommand* const pCommand) = 0;
 	virtual void			    SetDPDBeadDissIntByType(const xxCommand* const pCommand) = 0;
+	virtual void				  SetForcePrecision(const xxCommand* const pCommand) = 0;
+	virtual void					     SetThreadTotal(const xxCommand* const pCommand) = 0;
+	virtual void					    SetVerletSkin(const xxCommand* const pCommand) = 0;
 	virtual void					    SetTimeStepSize(const xxCommand* const pCommand) = 0;
 	virtual void						      SineForce(const xxCommand* const pCommand) = 0;
 	virtual void				      SineForceOnTarget(const xxCommand* const pCommand) = 0;
@@ -446,6 +446,16 @@ void ISimState::SetRenormaliseMomenta(bool bRenormalise)
 	m_rSimState.SetRenormaliseMomenta(bRenormalise);
 }
 
+void ISimState::SetThreadTotal(long threads)
+{
+	m_rSimState.SetThreadTotal(threads);
+}
+
+void ISimState::SetVerletSkin(double skin)
+{
+	m_rSimState.SetVerletSkin(skin);
+}
+
 void ISimState::SetWallOn(bool bWall)
 {
 	m_rSimState.SetWallOn(bWall);
@@ -728,6 +738,16 @@ const zString ISimState::GetPolymerNameFromType(long type) const
 	return m_rSimState.GetAnalysisState().GetPolymerNameFromType(type);
 }
 
+long ISimState::GetThreadTotal() const
+{
+	return m_rSimState.GetThreadTotal();
+}
+
+double ISimState::GetVerletSkin() const
+{
+	return m_rSimState.GetVerletSkin();
+}
+
 long ISimState::GetProcessorsXNo() const
 {
 	return m_rSimState.GetProcessorsXNo();
@@ -807,11 +827,7 @@ CommandTargetSequence ISimState::GetCommandTargets() const
 
 bool ISimState::IsDPDLG() const
 {
-#if EnableDPDLG == ExperimentEnabled
     return m_rSimState.IsDPDLG();
-#elif EnableDPDLG == ExperimentDisabled
-    return false;
-#endif
 }
 
 // Functions to return the origin of  the owning processor's SimBox in the whole
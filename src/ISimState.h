@@ -136,6 +136,8 @@ protected:
 	void SetBondPairStressContributionOn(bool bStress);
 	void SetGravityOn(bool bGravity);
 	void SetRenormaliseMomenta(bool bRenormalise);
+	void SetThreadTotal(long threads);
+	void SetVerletSkin(double skin);
 	void SetWallOn(bool bWall);
 
 
@@ -160,6 +162,9 @@ protected:
 
 	// Functions that return information about the physical state of the simulation
 
+	long GetThreadTotal() const;				// No of threads for the non-bonded forces
+	double GetVerletSkin() const;				// Skin of the Verlet pair list
+
 	long GetProcessorsXNo() const;
 	long GetProcessorsYNo() const;              // No of processors in each dimension
 	long GetProcessorsZNo() const;
@@ -0,0 +1,28 @@
+// IStateSnapshot.h: interface for the IStateSnapshot class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_ISTATESNAPSHOT_H__5E2A9C37_D184_4B6F_9A03_C7F1E86B2D45__INCLUDED_)
+#define AFX_ISTATESNAPSHOT_H__5E2A9C37_D184_4B6F_9A03_C7F1E86B2D45__INCLUDED_
+
+
+// Interface for xxState-derived objects whose output can be written by the
+// CAsyncStateWriter. The state copies the data it needs into a snapshot 
+// buffer on the simulation thread, and the writer thread later calls 
+// WriteSnapshot() to format the data and write it to file. WriteSnapshot()
+// must not read any data from the simulation, as the simulation continues 
+// while it runs. The writer deletes the state after writing it.
+
+class IStateSnapshot
+{
+public:
+	virtual ~IStateSnapshot();
+
+	virtual bool WriteSnapshot() = 0;
+
+protected:
+
+	IStateSnapshot();
+};
+
+#endif // !defined(AFX_ISTATESNAPSHOT_H__5E2A9C37_D184_4B6F_9A03_C7F1E86B2D45__INCLUDED_)
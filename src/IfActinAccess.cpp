@@ -20,6 +20,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "IfActinAccess.h"
 #include "aefActinNetwork.h"
 #include "aeActiveBond.h"
+#include "aeActiveBondHash.h"
+#include "IActiveSimBox.h"
 #include "aeBondExternalTriggerOn.h"
 #include "aeBondExternalTriggerOff.h"
 
@@ -53,72 +55,23 @@ IfActinAccess::~IfActinAccess()
 // We cannot use the unPBC coordinates as the monomers may be far apart in
 // the unPBC space.
 //
-// We search all possible mActin monomers for now: it would be more efficient
-// just to search the aeCNTCells surrounding the passed in point. If found,
-// the returned monomer is NOT removed from the network's free monomer container,
-// this is left to the calling routine that should use RemoveNearbyMonomer() to 
-// do this.
+// The search uses the active SimBox's spatial hash of free bonds, so only
+// the cells surrounding the passed-in point are examined unless the nearest
+// monomer is far away. The hash is brought up to date first if the beads 
+// have moved since it was last used. If found, the returned monomer is NOT removed from the 
+// network's free monomer container, this is left to the calling routine that
+// should use RemoveNearbyMonomer() to do this.
 //
 // Note that it is possible that no monomer is found so the calling routine 
 // must check for a returned NULL pointer.
 
 aeActiveBond* IfActinAccess::GetNearbyMonomer(double x, double y, double z)
 {
-	aeActiveBond* pNearbyBond = 0;
+	aeActiveBondHash* const pHash = m_pNetwork->GetIActiveSimBox()->GetBondHash();
 
-	double minSquareSep = -1.0;
-	double sqSep        = 0.0;
+	pHash->Update();
 
-	const double SimBoxXLength = m_pNetwork->GetIActiveSimBox()->GetSimBoxXLength();
-	const double SimBoxYLength = m_pNetwork->GetIActiveSimBox()->GetSimBoxYLength();
-	const double SimBoxZLength = m_pNetwork->GetIActiveSimBox()->GetSimBoxZLength();
-
-	const double HalfSimBoxXLength = m_pNetwork->GetIActiveSimBox()->GetHalfSimBoxXLength();
-	const double HalfSimBoxYLength = m_pNetwork->GetIActiveSimBox()->GetHalfSimBoxYLength();
-	const double HalfSimBoxZLength = m_pNetwork->GetIActiveSimBox()->GetHalfSimBoxZLength();
-
-	ActiveBondListIterator iterBond=m_pNetwork->m_FreeActiveBonds.begin();
-
-	while(iterBond != m_pNetwork->m_FreeActiveBonds.end())
-	{
-		CAbstractBead* pTail = (*iterBond)->GetTailTailBead();
-
-		double dx = pTail->GetXPos() - x;
-		double dy = pTail->GetYPos() - y;
-		double dz = pTail->GetZPos() - z;
-
-		if( dx > HalfSimBoxXLength )
-			dx = dx - SimBoxXLength;
-		else if( dx < -HalfSimBoxXLength )
-			dx = dx + SimBoxXLength;
-
-		if( dy > HalfSimBoxYLength )
-			dy = dy - SimBoxYLength;
-		else if( dy < -HalfSimBoxYLength )
-			dy = dy + SimBoxYLength;
-
-#if SimDimension == 3
-		if( dz > HalfSimBoxZLength )
-			dz = dz - SimBoxZLength;
-		else if( dz < -HalfSimBoxZLength )
-			dz = dz + SimBoxZLength;
-#else
-		dz = 0.0;
-#endif
-
-		sqSep = dx*dx + dy*dy + dz*dz;
-
-		if(sqSep < minSquareSep || minSquareSep < 0.0)
-		{
-//		    std::cout << "Found  fActin monomer with id " << (*iterBond)->GetId() << " near " << x << " " << y << " " << z << " with separation " << sqSep << zEndl;
-			minSquareSep = sqSep;
-			pNearbyBond = *iterBond;
-		}
-
-		iterBond++;
-	} 
-
-	return pNearbyBond;
+	return pHash->GetNearestBond(m_pNetwork, aeActiveBondHash::Tail, x, y, z);
 }
 
 // Function to allow the calling network to remove a monomer from this network's
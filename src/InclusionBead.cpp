@@ -56,7 +56,6 @@ bool CInclusionBead::SetFrozen()
 	for(short int i=0; i<3; i++)
 	{
 		m_Mom[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= m_Pos[i];
 		m_oldMom[i]		= 0.0;
 	}
@@ -75,7 +74,6 @@ bool CInclusionBead::SetNotFrozen()
 	for(short int i=0; i<3; i++)
 	{
 		m_Mom[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 	}
 
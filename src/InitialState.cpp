@@ -28,6 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Bond.h"
 #include "BondPair.h"
 #include "Polymer.h"
+#include "PolymerArena.h"
 #include "acfTargetFactory.h"
 #include "CommandTargetNode.h"
 
@@ -87,6 +88,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
     CInitialState::CInitialState(CSimState* pSimState, const CInputData& rData) : xxState(xxBase::GetISPrefix() + rData.GetRunId() + ".xml", true, 0, rData.GetRunId()),
                                                         m_pIRS(new IInclusiveRestartState(pSimState)),
+                                                        m_pPolymerArena(new CPolymerArena()),
                                                         m_bDPDLG(rData.IsDPDLG()),
 														RNGSeed(rData.GetRNGSeed()),
 														ProcessorsXNo(rData.GetProcessorsXNo()),
@@ -112,6 +114,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
         CInitialState::CInitialState(CSimState* pSimState, const CInputData& rData) : xxState(xxBase::GetISPrefix() + rData.GetRunId(), true, 0, rData.GetRunId()),
                                                         m_pIRS(new IInclusiveRestartState(pSimState)),
+                                                        m_pPolymerArena(new CPolymerArena()),
                                                         m_bDPDLG(rData.IsDPDLG()),
                                                         RNGSeed(rData.GetRNGSeed()),
 														ProcessorsXNo(rData.GetProcessorsXNo()),
@@ -258,19 +261,24 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 	// the CNTCell static pointers point to the CInputData structure, although
 	// these are then used to copy the data itself.
 
-#if SimIdentifier == BD
-	m_vvConsInt = *rData.GetDPDBeadConsIntArray();
-	m_vvDissInt = *rData.GetDPDBeadDissIntArray();
-#elif SimIdentifier == DPD
-	m_vvConsInt = *rData.GetDPDBeadConsIntArray();
-	m_vvDissInt = *rData.GetDPDBeadDissIntArray();
-	m_vvLGInt   = *rData.GetDPDBeadLGIntArray();
-#elif SimIdentifier == MD
-	m_vvLJDepth = *rData.GetMDBeadLJDepthArray();
-	m_vvLJRange = *rData.GetMDBeadLJRangeArray();
-	m_vvSCDepth = *rData.GetMDBeadSCDepthArray();
-	m_vvSCRange = *rData.GetMDBeadSCRangeArray();
-#endif
+	if(GetSimIdentifier() == BD)
+	{
+		m_vvConsInt = *rData.GetDPDBeadConsIntArray();
+		m_vvDissInt = *rData.GetDPDBeadDissIntArray();
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		m_vvConsInt = *rData.GetDPDBeadConsIntArray();
+		m_vvDissInt = *rData.GetDPDBeadDissIntArray();
+		m_vvLGInt   = *rData.GetDPDBeadLGIntArray();
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		m_vvLJDepth = *rData.GetMDBeadLJDepthArray();
+		m_vvLJRange = *rData.GetMDBeadLJRangeArray();
+		m_vvSCDepth = *rData.GetMDBeadSCDepthArray();
+		m_vvSCRange = *rData.GetMDBeadSCRangeArray();
+	}
 
     // Ensure the local containers of command targets and decorators are empty. 
     // They are only used when reading a restart state that contains saved targets.
@@ -290,7 +298,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // created using new in CInputData, but are stored here.
 //
 // The serial code owns all the beads, bonds, bondpairs and polymers, so it can delete them here 
-// as it knows they are of constant number. It also deletes all dynamically-created polymerized bonds.
+// as it knows they are of constant number. They are held in a CPolymerArena that destroys them
+// all at once. It also deletes all dynamically-created polymerized bonds.
 // 
 // But for the parallel code, polymers (and their containe beads, bonds and bondpairs) are owned and destroyed by the parallel SimBox,
 // that is also responsible for deleting any dynamically-created polymerized bonds.
@@ -305,28 +314,11 @@ CInitialState::~CInitialState()
     m_pParallelIS = 0;
 	
 #else
-	// Delete all the polymers that were created to form the initial state object, and
-	// let the CPolymers destroy their own beads and bonds. 
+	// The polymers, including the CWallPolymers that compose the walls, and their 
+	// beads, bonds and bondpairs belong to the arena and are destroyed with it below.
 
-	if(!vAllPolymers.empty())
-	{
-		for(PolymerVectorIterator iterPolymer=vAllPolymers.begin(); iterPolymer!=vAllPolymers.end(); iterPolymer++)
-		{
-			delete (*iterPolymer);
-		} 
-		vAllPolymers.clear();
-	}
-
-	// Now do the same for the CWallPolymers that compose the walls in the simulation
-
-	if( !vWallPolymers.empty() )
-	{
-		for(PolymerVectorIterator iterPolymer=vWallPolymers.begin(); iterPolymer!=vWallPolymers.end(); iterPolymer++)
-		{
-			delete (*iterPolymer);
-		} 
-		vWallPolymers.clear();
-	}
+	vAllPolymers.clear();
+	vWallPolymers.clear();
 
 	// Delete the polymerised bonds separately because they are not stored within
 	// polymers
@@ -342,6 +334,8 @@ CInitialState::~CInitialState()
 
 #endif
 
+	delete m_pPolymerArena;
+
 	// For both the serial and parallel code, delete the bead, bond, bondpair and polymer templates stored in vectors of "types"
 
 	for(BeadVectorIterator iterBead=vBeadTypes.begin(); iterBead!=vBeadTypes.end(); iterBead++)
@@ -482,17 +476,45 @@ void CInitialState::CreatePolymers()
 	// We also store pointers to all the beads, bonds and polymers in single 
 	// arrays to speed up the loops in the CSimBox.
 	
+	//
+	// The polymers and their beads, bonds and bondpairs are created in the
+	// CPolymerArena, which places each kind of object contiguously in the
+	// order in which the polymers are created. We reserve exactly the storage 
+	// needed first so that each kind occupies a single block.
+	
 	long BeadTotal		= 0; 
 	long BondTotal		= 0;
 	long BondPairTotal	= 0;
 	long PolymerTotal	= 0;
 
+	for(cPolymerVectorIterator iterPolyType=vPolymerTypes.begin(); iterPolyType!=vPolymerTypes.end(); iterPolyType++)
+	{
+		const long polymerNo = m_vPolymerTypeTotal.at((*iterPolyType)->GetType());
+
+		PolymerTotal	+= polymerNo;
+		BeadTotal		+= polymerNo*(*iterPolyType)->GetSize();
+		BondTotal		+= polymerNo*(*iterPolyType)->GetBonds().size();
+		BondPairTotal	+= polymerNo*(*iterPolyType)->GetBondPairs().size();
+	}
+
+	m_pPolymerArena->Reserve(PolymerTotal, BeadTotal, BondTotal, BondPairTotal);
+
+	vAllPolymers.reserve(PolymerTotal);
+	vAllBeads.reserve(BeadTotal);
+	vAllBonds.reserve(BondTotal);
+	vAllBondPairs.reserve(BondPairTotal);
+
+	BeadTotal		= 0; 
+	BondTotal		= 0;
+	BondPairTotal	= 0;
+	PolymerTotal	= 0;
+
 	for(cPolymerVectorIterator iterPolyType=vPolymerTypes.begin(); iterPolyType!=vPolymerTypes.end(); iterPolyType++)
 	{
 		for(long pno=0; pno<m_vPolymerTypeTotal.at((*iterPolyType)->GetType()); pno++)
 		{
 			PolymerTotal++;
-			CPolymer* pPolymer = new CPolymer(**iterPolyType);
+			CPolymer* pPolymer = m_pPolymerArena->CreatePolymer(**iterPolyType);
 			pPolymer->SetId(PolymerTotal);
 
 			BeadTotal		= pPolymer->SetBeadIds(BeadTotal);
@@ -607,10 +629,14 @@ void CInitialState::CreateWallPolymers()
 
 	CPolymer* pPolymerType = vPolymerTypes.at(WallPolymerType);
 
+	m_pPolymerArena->Reserve(totalWallBeads, totalWallBeads*pPolymerType->GetSize(), 
+							 totalWallBeads*pPolymerType->GetBonds().size(),
+							 totalWallBeads*pPolymerType->GetBondPairs().size());
+
 	for(long pno=0; pno<totalWallBeads; pno++)
 	{
 		WallPolymerTotal++;
-		CPolymer* pPolymer = new CPolymer(*pPolymerType);
+		CPolymer* pPolymer = m_pPolymerArena->CreatePolymer(*pPolymerType);
 		pPolymer->SetId(PolymerTotal + WallPolymerTotal);
 
 		BeadTotal		= pPolymer->SetBeadIds(BeadTotal);
@@ -799,57 +825,56 @@ void CInitialState::WriteBeadTypeData() const
 	{
 		TraceInt("Bead type", (*iterBead)->GetType());
 
-#if SimIdentifier == BD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			TraceDoubleNoEndl(m_vvConsInt.at((*iterBead)->GetType()).at(j));
-		}
-		TraceEndl();
-		for(j=0; j<vBeadTypes.size(); j++)
-		{
-			TraceDoubleNoEndl(m_vvDissInt.at((*iterBead)->GetType()).at(j));
-		}
-		TraceEndl();
-
-#elif SimIdentifier == DPD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		if(GetSimIdentifier() == BD)
 		{
-			TraceDoubleNoEndl(m_vvConsInt.at((*iterBead)->GetType()).at(j));
-		}
-		TraceEndl();
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			TraceDoubleNoEndl(m_vvDissInt.at((*iterBead)->GetType()).at(j));
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvConsInt.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvDissInt.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
 		}
-		TraceEndl();
-
-#elif SimIdentifier == MD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == DPD)
 		{
-			TraceDoubleNoEndl(m_vvLJDepth.at((*iterBead)->GetType()).at(j));
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvConsInt.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvDissInt.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
 		}
-		TraceEndl();
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == MD)
 		{
-			TraceDoubleNoEndl(m_vvLJRange.at((*iterBead)->GetType()).at(j));
-		}
-		TraceEndl();
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvLJDepth.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvLJRange.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			TraceDoubleNoEndl(m_vvSCDepth.at((*iterBead)->GetType()).at(j));
-		}
-		TraceEndl();
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			TraceDoubleNoEndl(m_vvSCRange.at((*iterBead)->GetType()).at(j));
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvSCDepth.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				TraceDoubleNoEndl(m_vvSCRange.at((*iterBead)->GetType()).at(j));
+			}
+			TraceEndl();
 		}
-		TraceEndl();
-
-#endif
 	}
 }
 
@@ -981,100 +1006,83 @@ void CInitialState::SerializeXMLFile()
 		m_outStream << "<Bead>" << zEndl;
 		m_outStream << "<Type>"  << (*iterBead)->GetType() << "</Type>" << zEndl;
 
-#if SimIdentifier == BD
-
-		m_outStream << "<Radius>"  << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
-		m_outStream << "<TranslationalDiffusionCoefficient>"  << (*iterBead)->GetTransDiff() << "</TranslationalDiffusionCoefficient>" << zEndl;
-		m_outStream << "<RotationalDiffusionCoefficient>"     << (*iterBead)->GetRotDiff()   << "</RotationalDiffusionCoefficient>" << zEndl;
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		if(GetSimIdentifier() == BD)
 		{
-			m_outStream << "<ConsInt>"  << m_vvConsInt.at((*iterBead)->GetType()).at(j) << "</ConsInt>";
-		}
-		m_outStream << zEndl;
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<DissInt>"  << m_vvDissInt.at((*iterBead)->GetType()).at(j) << "</DissInt>";
-		}
-		m_outStream << zEndl;
+			m_outStream << "<Radius>"  << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
+			m_outStream << "<TranslationalDiffusionCoefficient>"  << (*iterBead)->GetTransDiff() << "</TranslationalDiffusionCoefficient>" << zEndl;
+			m_outStream << "<RotationalDiffusionCoefficient>"     << (*iterBead)->GetRotDiff()   << "</RotationalDiffusionCoefficient>" << zEndl;
 
-#elif SimIdentifier == DPD
-
-#if EnableDPDLG == ExperimentEnabled
-
-        if(IsDPDLG())
-        {
-		    m_outStream << "<Radius>"    << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
-		    m_outStream << "<LGRadius>"  << (*iterBead)->GetLGRadius() << "</LGRadius>" << zEndl;
-        }
-        else
-        {
-		    m_outStream << "<Radius>"    << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
-        }
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<ConsInt>"  << m_vvConsInt.at((*iterBead)->GetType()).at(j) << "</ConsInt>";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<ConsInt>"  << m_vvConsInt.at((*iterBead)->GetType()).at(j) << "</ConsInt>";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<DissInt>"  << m_vvDissInt.at((*iterBead)->GetType()).at(j) << "</DissInt>";
+			}
+			m_outStream << zEndl;
 		}
-		m_outStream << zEndl;
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == DPD)
 		{
-			m_outStream << "<DissInt>"  << m_vvDissInt.at((*iterBead)->GetType()).at(j) << "</DissInt>";
-		}
-		m_outStream << zEndl;
+	        if(IsDPDLG())
+	        {
+			    m_outStream << "<Radius>"    << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
+			    m_outStream << "<LGRadius>"  << (*iterBead)->GetLGRadius() << "</LGRadius>" << zEndl;
+	        }
+	        else
+	        {
+			    m_outStream << "<Radius>"    << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
+	        }
 
-        if(IsDPDLG())
-        {
-		    for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		    {
-			    m_outStream << "<LGInt>"  << m_vvLGInt.at((*iterBead)->GetType()).at(j) << "</LGInt>";
-		    }
-		    m_outStream << zEndl;
-        }
-#elif EnableDPDLG == ExperimentDisabled
-		m_outStream << "<Radius>"  << (*iterBead)->GetRadius() << "</Radius>" << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<ConsInt>"  << m_vvConsInt.at((*iterBead)->GetType()).at(j) << "</ConsInt>";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<ConsInt>"  << m_vvConsInt.at((*iterBead)->GetType()).at(j) << "</ConsInt>";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<DissInt>"  << m_vvDissInt.at((*iterBead)->GetType()).at(j) << "</DissInt>";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<DissInt>"  << m_vvDissInt.at((*iterBead)->GetType()).at(j) << "</DissInt>";
+	        if(IsDPDLG())
+	        {
+			    for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			    {
+				    m_outStream << "<LGInt>"  << m_vvLGInt.at((*iterBead)->GetType()).at(j) << "</LGInt>";
+			    }
+			    m_outStream << zEndl;
+	        }
 		}
-		m_outStream << zEndl;
-#endif
-#elif SimIdentifier == MD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == MD)
 		{
-			m_outStream << "<LJDepth>"  << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << "</LJDepth>";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<LJDepth>"  << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << "</LJDepth>";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<LJRange>"  << m_vvLJRange.at((*iterBead)->GetType()).at(j) << "</LJRange>";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<LJRange>"  << m_vvLJRange.at((*iterBead)->GetType()).at(j) << "</LJRange>";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<SCDepth>"  << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << "</SCDepth>";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<SCDepth>"  << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << "</SCDepth>";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "<SCRange>"  << m_vvSCRange.at((*iterBead)->GetType()).at(j) << "</SCRange>";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "<SCRange>"  << m_vvSCRange.at((*iterBead)->GetType()).at(j) << "</SCRange>";
+			}
+			m_outStream << zEndl;
 		}
-		m_outStream << zEndl;
-
-#endif
 		m_outStream << "</Bead>" << zEndl;
 	}
 	m_outStream << "</Beads>" << zEndl;
@@ -1179,112 +1187,93 @@ void CInitialState::SerializeAsciiFile()
 		m_outStream << zEndl;
 		m_outStream << "Bead type " << (*iterBead)->GetType() << zEndl;
 
-#if SimIdentifier == BD
-
-		m_outStream << "  Radius: ";
-		m_outStream << (*iterBead)->GetRadius() << zEndl;
-		m_outStream << "  Translational Diffusion: ";
-		m_outStream << (*iterBead)->GetTransDiff() << zEndl;
-		m_outStream << "  Rotational Diffusion: ";
-		m_outStream << (*iterBead)->GetRotDiff() << zEndl;
-
-		m_outStream << "  Cons Int: ";
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		if(GetSimIdentifier() == BD)
 		{
-			m_outStream << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
-
-		m_outStream << "  Diss Int: ";
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
-
-#elif SimIdentifier == DPD
-
-#if EnableDPDLG == ExperimentEnabled
-		m_outStream << "  Radius: ";
+			m_outStream << "  Radius: ";
+			m_outStream << (*iterBead)->GetRadius() << zEndl;
+			m_outStream << "  Translational Diffusion: ";
+			m_outStream << (*iterBead)->GetTransDiff() << zEndl;
+			m_outStream << "  Rotational Diffusion: ";
+			m_outStream << (*iterBead)->GetRotDiff() << zEndl;
 
-        if(IsDPDLG())
-        {
-		    m_outStream << (*iterBead)->GetRadius() << " " << (*iterBead)->GetLGRadius() << zEndl;
-        }
-        else
-        {
-		    m_outStream << (*iterBead)->GetRadius() << zEndl;
-        }
+			m_outStream << "  Cons Int: ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 
-		m_outStream << "  Cons Int: ";
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
+			m_outStream << "  Diss Int: ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 		}
-		m_outStream << zEndl;
-
-		m_outStream << "  Diss Int: ";
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == DPD)
 		{
-			m_outStream << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
+			m_outStream << "  Radius: ";
 
-        if(IsDPDLG())
-        {
-		    m_outStream << "  LG Int:   ";
-		    for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		    {
-			    m_outStream << m_vvLGInt.at((*iterBead)->GetType()).at(j) << " ";
-		    }
+	        if(IsDPDLG())
+	        {
+			    m_outStream << (*iterBead)->GetRadius() << " " << (*iterBead)->GetLGRadius() << zEndl;
+	        }
+	        else
+	        {
+			    m_outStream << (*iterBead)->GetRadius() << zEndl;
+	        }
 
-		    m_outStream << zEndl;
-        }
-#elif EnableDPDLG == ExperimentDisabled
-		m_outStream << "  Radius: ";
-		m_outStream << (*iterBead)->GetRadius() << zEndl;
+			m_outStream << "  Cons Int: ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 
-		m_outStream << "  Cons Int: ";
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
+			m_outStream << "  Diss Int: ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 
-		m_outStream << "  Diss Int: ";
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
-#endif
-#elif SimIdentifier == MD
+	        if(IsDPDLG())
+	        {
+			    m_outStream << "  LG Int:   ";
+			    for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			    {
+				    m_outStream << m_vvLGInt.at((*iterBead)->GetType()).at(j) << " ";
+			    }
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "  LJ depth: " << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << " ";
+			    m_outStream << zEndl;
+	        }
 		}
-		m_outStream << zEndl;
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == MD)
 		{
-			m_outStream << "  LJ range: " << m_vvLJRange.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "  LJ depth: " << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "  SC depth: " << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "  LJ range: " << m_vvLJRange.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			m_outStream << "  SC range: " << m_vvSCRange.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		m_outStream << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "  SC depth: " << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
 
-#endif
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				m_outStream << "  SC range: " << m_vvSCRange.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			m_outStream << zEndl;
+		}
 	}
 
 	// Bond data 
@@ -1374,21 +1363,19 @@ double CInitialState::GetDPDBeadDissInt(long first, long second) const
 }
 
 // Functions to return the DPD bead density-dependent interaction
-// parameters. We check first that the types specified are legal.
+// parameters. We check first that the types specified are legal and
+// that the run includes the density-dependent force.
 
 double CInitialState::GetDPDBeadLGInt(long first, long second) const
 {
-#if EnableDPDLG == ExperimentEnabled
-	if(0 <= first  && first  < GetBeadTypeTotal() && 
+	if(IsDPDLG() &&
+	   0 <= first  && first  < GetBeadTypeTotal() && 
 	   0 <= second && second < GetBeadTypeTotal())
 	{
 		return m_vvLGInt.at(first).at(second);
 	}
 	else
 		return 0.0;
-#else
-    return 0.0;
-#endif
 }
 
 // Functions to set a new value for the DPD bead-bead conservative and dissipative
@@ -1418,14 +1405,13 @@ void CInitialState::SetDPDBeadDissInt(long first, long second, double newValue)
 
 void CInitialState::SetDPDBeadLGInt(long first, long second, double newValue)
 {
-#if EnableDPDLG == ExperimentEnabled
-	if(0 <= first  && first  < GetBeadTypeTotal() && 
+	if(IsDPDLG() &&
+	   0 <= first  && first  < GetBeadTypeTotal() && 
 	   0 <= second && second < GetBeadTypeTotal())
 	{
 		m_vvLGInt.at(first).at(second) = newValue;
 		m_vvLGInt.at(second).at(first) = newValue;
 	}
-#endif
 }
 
 // Functions to return the energy and length scales in the simulation.
@@ -1437,24 +1423,26 @@ void CInitialState::SetDPDBeadLGInt(long first, long second, double newValue)
 
 double CInitialState::GetEnergyScale() const
 {
-#if SimIdentifier == BD
-    return 1.0;
-#elif SimIdentifier == DPD
-	return 1.0;
-#elif SimIdentifier == MD
-	return m_vvLJDepth.at(0).at(0);
-#endif
+	if(GetSimIdentifier() == MD)
+	{
+		return m_vvLJDepth.at(0).at(0);
+	}
+	else
+	{
+		return 1.0;
+	}
 }
 
 double CInitialState::GetLengthScale() const
 {
-#if SimIdentifier == BD
-    return 1.0;
-#elif SimIdentifier == DPD
-	return 1.0;
-#elif SimIdentifier == MD
-	return m_vvLJRange.at(0).at(0);
-#endif
+	if(GetSimIdentifier() == MD)
+	{
+		return m_vvLJRange.at(0).at(0);
+	}
+	else
+	{
+		return 1.0;
+	}
 }
 
 // Function to store bonds between polymerised polymers. It is used for
@@ -1708,97 +1696,62 @@ zInStream& CInitialState::Read(zInStream& is)
 //        std::cout << "setting Bead old/new type " << (*iterBead)->GetType() << " " << type << " radius to " << radius << zEndl;
         (*iterBead)->SetRadius(radius);
 
-#if SimIdentifier == BD
-
-//		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-//		{
-//			is >> cons;
-//          m_vvConsInt.at(type).at(j) = cons;
-//		}
-//		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-//		{
-//			is >> diss;
-//          m_vvDissInt.at(type).at(j) = diss;
-//		}
+        // Only the DPD interaction parameters are stored in a restart state
 
-#elif SimIdentifier == DPD
-
-        // First, read in the conservative interactions with existing types
-		for(long j=0; j<oldTypes; j++)
-		{
-		  is >> cons;
-          if(!is.good())
-          {
-            SetRestartStateInvalid("Restart state error: invalid bead-bead conservative parameter");
-            return is;
-          }
-          m_vvConsInt.at(type).at(j) = cons;
-//          std::cout << "setting Bead type " << type << " cons int with type " << j << " to " << cons << zEndl;
-		}
+        if(GetSimIdentifier() == DPD)
+        {
+	        // First, read in the conservative interactions with existing types
+			for(long j=0; j<oldTypes; j++)
+			{
+			  is >> cons;
+	          if(!is.good())
+	          {
+	            SetRestartStateInvalid("Restart state error: invalid bead-bead conservative parameter");
+	            return is;
+	          }
+	          m_vvConsInt.at(type).at(j) = cons;
+	//          std::cout << "setting Bead type " << type << " cons int with type " << j << " to " << cons << zEndl;
+			}
 
-        // Now append the interactions with the new types
-		for(long j=oldTypes; j<newTypes; j++)
-		{
-		  is >> cons;
-          if(!is.good())
-          {
-            SetRestartStateInvalid("Restart state error: invalid bead-bead conservative parameter");
-            return is;
-          }
-          m_vvConsInt.at(type).push_back(cons);
-//          std::cout << "adding Bead type " << type << " cons int with type " << j << " to " << cons << zEndl;
-		}
+	        // Now append the interactions with the new types
+			for(long j=oldTypes; j<newTypes; j++)
+			{
+			  is >> cons;
+	          if(!is.good())
+	          {
+	            SetRestartStateInvalid("Restart state error: invalid bead-bead conservative parameter");
+	            return is;
+	          }
+	          m_vvConsInt.at(type).push_back(cons);
+	//          std::cout << "adding Bead type " << type << " cons int with type " << j << " to " << cons << zEndl;
+			}
 
-        // Now do the same for the dissipative interactions
-		for(long j=0; j<oldTypes; j++)
-		{
-		  is >> diss;
-          if(!is.good() || diss < 0.0)
-          {
-            SetRestartStateInvalid("Restart state error: invalid bead-bead dissipative parameter");
-            return is;
-          }
-          m_vvDissInt.at(type).at(j) = diss;
-//          std::cout << "setting Bead type " << type << " diss int with type " << j << " to " << diss << zEndl;
-		}
+	        // Now do the same for the dissipative interactions
+			for(long j=0; j<oldTypes; j++)
+			{
+			  is >> diss;
+	          if(!is.good() || diss < 0.0)
+	          {
+	            SetRestartStateInvalid("Restart state error: invalid bead-bead dissipative parameter");
+	            return is;
+	          }
+	          m_vvDissInt.at(type).at(j) = diss;
+	//          std::cout << "setting Bead type " << type << " diss int with type " << j << " to " << diss << zEndl;
+			}
 
-        // Now append the interactions with the new types
-		for(long j=oldTypes; j<newTypes; j++)
-		{
-		  is >> diss;
-          if(!is.good() || diss < 0.0)
-          {
-            SetRestartStateInvalid("Restart state error: invalid bead-bead dissipative parameter");
-            return is;
-          }
-          m_vvDissInt.at(type).push_back(diss);
-//          std::cout << "adding Bead type " << type << " diss int with type " << j << " to " << diss << zEndl;
+	        // Now append the interactions with the new types
+			for(long j=oldTypes; j<newTypes; j++)
+			{
+			  is >> diss;
+	          if(!is.good() || diss < 0.0)
+	          {
+	            SetRestartStateInvalid("Restart state error: invalid bead-bead dissipative parameter");
+	            return is;
+	          }
+	          m_vvDissInt.at(type).push_back(diss);
+	//          std::cout << "adding Bead type " << type << " diss int with type " << j << " to " << diss << zEndl;
+			}
 		}
-
-#elif SimIdentifier == MD
-
-//		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-//		{
-//			os << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << " ";
-//		}
-//		os << zEndl;
-//		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-//		{
-//			os << m_vvLJRange.at((*iterBead)->GetType()).at(j) << " ";
-//		}
-//		os << zEndl;
-
-//		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-//		{
-//			os << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << " ";
-//		}
-//		os << zEndl;
-//		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-//		{
-//			os << m_vvSCRange.at((*iterBead)->GetType()).at(j) << " ";
-//		}
-//		os << zEndl;
-#endif
 	}
 
     // Now add new bead types if any are required
@@ -1818,71 +1771,36 @@ zInStream& CInitialState::Read(zInStream& is)
             m_pIRS->AddBeadType(type, name);
             (vBeadTypes.at(jb))->SetRadius(radius);
 
-    #if SimIdentifier == BD
-
-    //		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-    //		{
-    //			is >> cons;
-    //          m_vvConsInt.at(type).at(j) = cons;
-    //		}
-    //		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-    //		{
-    //			is >> diss;
-    //          m_vvDissInt.at(type).at(j) = diss;
-    //		}
-
-    #elif SimIdentifier == DPD
-
-            // Conservative and dissipative interaction parameters have already
-            // been added for the new types, so we just have to overwrite them.
-
-		    for(long j=0; j<newTypes; j++)
-		    {
-		      is >> cons;
-              if(!is.good())
-              {
-                SetRestartStateInvalid("Restart state error: invalid bead-bead conservative parameter");
-                return is;
-              }
-              m_vvConsInt.at(type).at(j) = cons;
-//              std::cout << "setting Bead type " << type << " cons int with type " << j << " to " << cons << zEndl;
-		    }
-		    for(long j=0; j<newTypes; j++)
-		    {
-		      is >> diss;
-              if(!is.good() || diss < 0.0)
-              {
-                SetRestartStateInvalid("Restart state error: invalid bead-bead dissipative parameter");
-                return is;
-              }
-              m_vvDissInt.at(type).at(j) = diss;
-//              std::cout << "setting Bead type " << type << " diss int with type " << j << " to " << diss << zEndl;
-		    }
-
-    #elif SimIdentifier == MD
-
-    //		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-    //		{
-    //			os << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << " ";
-    //		}
-    //		os << zEndl;
-    //		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-    //		{
-    //			os << m_vvLJRange.at((*iterBead)->GetType()).at(j) << " ";
-    //		}
-    //		os << zEndl;
-
-    //		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-    //		{
-    //			os << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << " ";
-    //		}
-    //		os << zEndl;
-    //		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-    //		{
-    //			os << m_vvSCRange.at((*iterBead)->GetType()).at(j) << " ";
-    //		}
-    //		os << zEndl;
-    #endif
+            // Only the DPD interaction parameters are stored in a restart state
+
+            if(GetSimIdentifier() == DPD)
+            {
+	            // Conservative and dissipative interaction parameters have already
+	            // been added for the new types, so we just have to overwrite them.
+
+			    for(long j=0; j<newTypes; j++)
+			    {
+			      is >> cons;
+	              if(!is.good())
+	              {
+	                SetRestartStateInvalid("Restart state error: invalid bead-bead conservative parameter");
+	                return is;
+	              }
+	              m_vvConsInt.at(type).at(j) = cons;
+	//              std::cout << "setting Bead type " << type << " cons int with type " << j << " to " << cons << zEndl;
+			    }
+			    for(long j=0; j<newTypes; j++)
+			    {
+			      is >> diss;
+	              if(!is.good() || diss < 0.0)
+	              {
+	                SetRestartStateInvalid("Restart state error: invalid bead-bead dissipative parameter");
+	                return is;
+	              }
+	              m_vvDissInt.at(type).at(j) = diss;
+	//              std::cout << "setting Bead type " << type << " diss int with type " << j << " to " << diss << zEndl;
+			    }
+            }
         }
 
     }
@@ -1901,19 +1819,10 @@ zInStream& CInitialState::Read(zInStream& is)
 
 // NOTE BD and MD not implemented yet
 
-#if SimIdentifier == BD
-//		CCNTCell::SetBDBeadStructure(rInputData.GetDPDBeadConsIntArray(),
-//									 rInputData.GetDPDBeadDissIntArray());
-#elif SimIdentifier == DPD
-
-        m_pIRS->SetDPDBeadIntArrays(&m_vvConsInt, &m_vvDissInt);
-
-#elif SimIdentifier == MD
-		CCNTCell::SetMDBeadStructure(rInputData.GetMDBeadLJDepthArray(), 
-									 rInputData.GetMDBeadLJRangeArray(),
-									 rInputData.GetMDBeadSCDepthArray(), 
-								     rInputData.GetMDBeadSCRangeArray());
-#endif
+        if(GetSimIdentifier() == DPD)
+        {
+            m_pIRS->SetDPDBeadIntArrays(&m_vvConsInt, &m_vvDissInt);
+        }
 
 
     // Now the bond data
@@ -2172,56 +2081,56 @@ zOutStream& CInitialState::Write(zOutStream& os) const
 	{
 	    os << (*iterBead)->GetType() << " " << m_pIRS->GetBeadNameFromType((*iterBead)->GetType()) << " " << (*iterBead)->GetRadius() << zEndl;
 
-#if SimIdentifier == BD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		if(GetSimIdentifier() == BD)
 		{
-			os << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		os << zEndl;
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			os << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		os << zEndl;
-
-#elif SimIdentifier == DPD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			os << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		os << zEndl;
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			os << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
 		}
-		os << zEndl;
-
-#elif SimIdentifier == MD
-
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == DPD)
 		{
-			os << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << " ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvConsInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvDissInt.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
 		}
-		os << zEndl;
-		for(j=0; j<vBeadTypes.size(); j++)
+		else if(GetSimIdentifier() == MD)
 		{
-			os << m_vvLJRange.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		os << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvLJDepth.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvLJRange.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
 
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			os << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << " ";
-		}
-		os << zEndl;
-		for(long unsigned int j=0; j<vBeadTypes.size(); j++)
-		{
-			os << m_vvSCRange.at((*iterBead)->GetType()).at(j) << " ";
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvSCDepth.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
+			for(long unsigned int j=0; j<vBeadTypes.size(); j++)
+			{
+				os << m_vvSCRange.at((*iterBead)->GetType()).at(j) << " ";
+			}
+			os << zEndl;
 		}
-		os << zEndl;
-#endif
 	}
 
     // Now the bond data
@@ -2426,11 +2335,7 @@ void CInitialState::SetBeadTypeVisible(long type)
 
 bool CInitialState::IsDPDLG() const
 {
-#if EnableDPDLG == ExperimentEnabled
     return m_bDPDLG;
-#elif EnableDPDLG == ExperimentDisabled
-    return false;
-#endif
 }
 
 // Functions to return the total number of beads/bonds/bondpairs/polymers created on ALL processors. 
@@ -14,6 +14,7 @@ class CInputData;
 class CInitialStateData;
 class CLamellaBuilder;
 class CCompositeLamellaBuilder;
+class CPolymerArena;
 class IInclusiveRestartState;
 
 
@@ -360,6 +361,8 @@ private:
 	BondVector     vAllPolymerisedBonds;	// All polymerised bonds
 	PolymerVector  vWallPolymers;			// Polymers bound to the walls
 
+	CPolymerArena* const m_pPolymerArena;	// Owns the polymers, beads, bonds and bondpairs in the serial code
+
 	// Map from polymer types to their size and number fraction
 
 	LongLongMap         m_mPolymerSizes;
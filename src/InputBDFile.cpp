@@ -191,12 +191,6 @@ CInputBDFile::~CInputBDFile()
 
 bool CInputBDFile::Serialize()
 {
-	// **********************************************************************
-    // We conditionally compile out the BD code as the CAbstractBead class does
-    // not have certain member variables for other simulation types but this class
-    // is always compiled in.
-
-#if SimIdentifier == BD
 	if(m_IOFlag)	
 	{
 		// First token identifies simulation type in the data file
@@ -1019,7 +1013,6 @@ bool CInputBDFile::Serialize()
 			} // eof after process token
 		}
     }
-#endif
 
 	return true;
 }
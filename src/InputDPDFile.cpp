@@ -53,8 +53,8 @@ CInputDPDFile::CInputDPDFile(zString iFileName, bool IOFlag,
 															  pGD(NULL),
 															  pWD(NULL),
 															  m_rISD(rISD),
-															  m_pISO(NULL)
-													
+															  m_pISO(NULL),
+															  m_bBeadRadii(false)
 {
 	vProcessObjects.clear();
 	vAnalysisObjects.clear();
@@ -189,12 +189,6 @@ CInputDPDFile::~CInputDPDFile()
 
 bool CInputDPDFile::Serialize()
 {
-	// **********************************************************************
-    // We conditionally compile out this function to make it inaccessible when
-    // a different simulation type is being used.
-
-#if SimIdentifier == DPD
-
 	if(m_IOFlag)	
 	{
 		// First token identifies simulation type in the data file
@@ -416,6 +410,8 @@ bool CInputDPDFile::Serialize()
 
 // If the next keyword is "Wall" then read the CWallData object, or if it is
 // "Gravity" read the CGravityData object, otherwise pass onto the bead data read statements. 
+// The optional "BeadRadii" keyword makes the DPD forces use the radius given for
+// each bead type as its interaction range instead of the unit cut-off.
 
 		m_inStream >> token;
 		if(!m_inStream.good())
@@ -452,9 +448,16 @@ bool CInputDPDFile::Serialize()
 					if(!m_inStream.good() || !pGD->IsDataValid())
 						return IOError("Error reading gravity data");
 				}
+				else if (token == "BeadRadii" && m_inStream.good())
+				{
+					if(m_bBeadRadii)
+						return IOError("Error BeadRadii keyword repeated");
+					else
+						m_bBeadRadii = true;
+				}
 				else
 				{
-					return IOError("Error reading Gravity or Wall data");
+					return IOError("Error reading Gravity, Wall or BeadRadii data");
 				}
 
 				m_inStream >> token;
@@ -513,13 +516,16 @@ bool CInputDPDFile::Serialize()
 				}
 
 // Only use the bead radii input by the user if indicated to do so 
-// by the SimDefs.h file
+// by the BeadRadii keyword
 
-#ifndef UseDPDBeadRadii
-				AddNewBeadType(beadName, consInt, dissInt);
-#else
-				AddNewBeadType(beadName, beadRadius, consInt, dissInt);
-#endif
+				if(m_bBeadRadii)
+				{
+					AddNewBeadType(beadName, beadRadius, consInt, dissInt);
+				}
+				else
+				{
+					AddNewBeadType(beadName, consInt, dissInt);
+				}
 
 				m_inStream >> token;
 				if(!m_inStream.good())
@@ -1044,7 +1050,6 @@ bool CInputDPDFile::Serialize()
 			} // eof after process token
 		}
     }
-#endif
 
 	return true;
 }
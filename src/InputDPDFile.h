@@ -28,6 +28,8 @@ public:
 
 	bool Serialize();
 
+    bool UsesBeadRadii() const {return m_bBeadRadii;}
+
 	void AddNewBeadType(zString name, zDoubleVector consInt, zDoubleVector dissInt);
 	void AddNewBeadType(zString name, double radius, zDoubleVector consInt, zDoubleVector dissInt);
 	void AddNewBondType(zString name1, zString name2, double SprConst, double UnStrLen);
@@ -96,6 +98,8 @@ private:
 	const CInitialStateData& m_rISD;	// Default initial state data object
 	CInitialStateObject* m_pISO;		// Wrapper class for pISD;
 
+    bool  m_bBeadRadii;     // Flag showing if the bead radii set the DPD interaction range
+
 };
 
 #endif // !defined(AFX_INPUTDPDFILE_H__B5F919C3_5A24_11D3_820E_0060088AD300__INCLUDED_)
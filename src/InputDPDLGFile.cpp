@@ -49,9 +49,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //
 // We allow both standard DPD and DPDLG parameters to be serialised by this file.
 // The distinction is propagated to the rest of the simulation via the
-// IsLG() function that returns true for an LG run. This flag can only be
-// used in conjunction with the EnableDPDLG flag in ExperimentDefs.h, and
-// is only read in from a CDF: the default CDF is always a standard one.
+// IsLG() function that returns true for an LG run. This flag is set by the
+// "dpdlg" token at the start of a CDF: the default CDF is always a standard one.
 	
 CInputDPDLGFile::CInputDPDLGFile(zString iFileName, bool IOFlag, 
 							 const CInitialStateData& rISD) : xxFile(iFileName, IOFlag),
@@ -60,7 +59,8 @@ CInputDPDLGFile::CInputDPDLGFile(zString iFileName, bool IOFlag,
 															  pWD(NULL),
 															  m_rISD(rISD),
 															  m_pISO(NULL),
-                                                              m_bLG(false)
+                                                              m_bLG(false),
+                                                              m_bBeadRadii(false)
 {
 	vProcessObjects.clear();
 	vAnalysisObjects.clear();
@@ -195,12 +195,6 @@ CInputDPDLGFile::~CInputDPDLGFile()
 
 bool CInputDPDLGFile::Serialize()
 {
-	// **********************************************************************
-    // We conditionally compile out this function to make it inaccessible when
-    // a different simulation type is being used.
-
-#if SimIdentifier == DPD
-
 	if(m_IOFlag)	
 	{
 		// First token identifies simulation type in the data file
@@ -456,6 +450,8 @@ bool CInputDPDLGFile::Serialize()
 
 // If the next keyword is "Wall" then read the CWallData object, or if it is
 // "Gravity" read the CGravityData object, otherwise pass onto the bead data read statements. 
+// The optional "BeadRadii" keyword makes the DPD forces use the radius given for
+// each bead type as its interaction range instead of the unit cut-off.
 
 		m_inStream >> token;
 		if(!m_inStream.good())
@@ -492,9 +488,16 @@ bool CInputDPDLGFile::Serialize()
 					if(!m_inStream.good() || !pGD->IsDataValid())
 						return IOError("Error reading gravity data");
 				}
+				else if (token == "BeadRadii" && m_inStream.good())
+				{
+					if(m_bBeadRadii)
+						return IOError("Error BeadRadii keyword repeated");
+					else
+						m_bBeadRadii = true;
+				}
 				else
 				{
-					return IOError("Error reading Gravity or Wall data");
+					return IOError("Error reading Gravity, Wall or BeadRadii data");
 				}
 
 				m_inStream >> token;
@@ -575,10 +578,14 @@ bool CInputDPDLGFile::Serialize()
 
 				    AddNewBeadType(beadName, beadRadius, beadLGRadius, consInt, dissInt, lgInt);
                 }
-                else
+                else if(m_bBeadRadii)
                 {
 				    AddNewBeadType(beadName, beadRadius, consInt, dissInt);
                 }
+                else
+                {
+				    AddNewBeadType(beadName, consInt, dissInt);
+                }
 
 				m_inStream >> token;
 				if(!m_inStream.good())
@@ -1088,11 +1095,19 @@ bool CInputDPDLGFile::Serialize()
 			} // eof after process token
 		}
     }
-#endif
 
 	return true;
 }
 
+// Overloaded function to add a new bead type that uses the default interaction radius.
+
+void CInputDPDLGFile::AddNewBeadType(zString name, zDoubleVector consInt, zDoubleVector dissInt)
+{
+	CBeadType* pBead = CBeadType::AddDPDBeadType(name, consInt, dissInt);
+
+	mNewBeadTypes.insert(zPairLongBeadType(CBeadType::GetTotal(), pBead));
+}
+
 // Overloaded function to add a new bead type that includes the interaction radius.
 
 void CInputDPDLGFile::AddNewBeadType(zString name, double radius, zDoubleVector consInt, zDoubleVector dissInt)
@@ -46,7 +46,9 @@ public:
 public:
 
     bool IsLG() const {return m_bLG;}
+    bool UsesBeadRadii() const {return m_bBeadRadii;}
 
+	void AddNewBeadType(zString name, zDoubleVector consInt, zDoubleVector dissInt);
 	void AddNewBeadType(zString name, double radius, zDoubleVector consInt, zDoubleVector dissInt);
 	void AddNewBeadType(zString name, double radius, double lgRadius, zDoubleVector consInt, zDoubleVector dissInt, zDoubleVector lgInt);
 	void AddNewBondType(zString name1, zString name2, double SprConst, double UnStrLen);
@@ -131,6 +133,7 @@ private:
 	CInitialStateObject* m_pISO;		// Wrapper class for pISD;
 
     bool  m_bLG;            // Flag showing if density-dependent LG force is included
+    bool  m_bBeadRadii;     // Flag showing if the bead radii set the DPD interaction range
 
 };
 
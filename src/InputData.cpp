@@ -46,9 +46,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "pmCommandNames.h"
 #include "mpmInitialState.h"
 
-#if EnableDPDLG == ExperimentEnabled
 #include "InputDPDLGFile.h"
-#endif
 
 #include "InputMDFile.h"
 #include "BDBeadStructure.h"
@@ -175,6 +173,7 @@ CInputData::CInputData(const zString runid) : runId(runid),
                                               WallYWidth(0),
                                               WallZWidth(0),
                                               m_bLG(false),
+                                              m_bBeadRadii(false),
 											  m_bGravity(false),
 											  m_bWall(false),
 											  m_bShear(false),
@@ -218,13 +217,18 @@ CInputData::CInputData(const zString runid) : runId(runid),
 
 	// Specify the default initial state for each simulation type
 
-#if SimIdentifier == BD
-	m_pISD = new CInitialStateRandom;
-#elif SimIdentifier == DPD
-	m_pISD = new CInitialStateLamella;
-#elif SimIdentifier == MD
-	m_pISD = new CInitialStateLamella;
-#endif
+	if(GetSimIdentifier() == BD)
+	{
+		m_pISD = new CInitialStateRandom;
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		m_pISD = new CInitialStateLamella;
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		m_pISD = new CInitialStateLamella;
+	}
 
 
 #if SimMPS == SimulationEnabled
@@ -283,38 +287,37 @@ CInputData::CInputData(const zString runid) : runId(runid),
 	WallYWidth			= 0;
 	WallZWidth			= 0;
 
-#if SimIdentifier == BD
-
-	// BD-specific parameters or values for common parameters.  Irrelevant
-	// parameters have been set to zero in the constructor's initialisation list.
-
-	Lambda				= 0.0;
-	StepSize			= 0.001;
-	AverageBeadDensity	= 0.09156; // Creates 1000 actin monomers (A3-M-T3) in a 32**3 box
-	kT					= 1.0;
-
-#elif SimIdentifier == DPD
-
-	// DPD-specific parameters.
-
-	Lambda				= 0.5;
-	StepSize			= 0.02;
-	AverageBeadDensity	= 3.0;
-	kT					= 1.0;
-
-#elif SimIdentifier == MD
-
-	// MD-specific parameters.
+	if(GetSimIdentifier() == BD)
+	{
+		// BD-specific parameters or values for common parameters.  Irrelevant
+		// parameters have been set to zero in the constructor's initialisation list.
 
-	Lambda				= 0.0;
-	StepSize			= 0.02;
-	AverageBeadDensity	= 0.666667;
-	kT					= 1.35;
-	RCutOff				= 2.5;
-	MCStepSize			= 0.1;
-	TotalMCTime			= 10000;
+		Lambda				= 0.0;
+		StepSize			= 0.001;
+		AverageBeadDensity	= 0.09156; // Creates 1000 actin monomers (A3-M-T3) in a 32**3 box
+		kT					= 1.0;
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		// DPD-specific parameters.
 
-#endif
+		Lambda				= 0.5;
+		StepSize			= 0.02;
+		AverageBeadDensity	= 3.0;
+		kT					= 1.0;
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		// MD-specific parameters.
+
+		Lambda				= 0.0;
+		StepSize			= 0.02;
+		AverageBeadDensity	= 0.666667;
+		kT					= 1.35;
+		RCutOff				= 2.5;
+		MCStepSize			= 0.1;
+		TotalMCTime			= 10000;
+	}
 
 	// Ensure the containers of processes, aggregates, events, commands 
 	// and force targets, command targets and command groups are empty 
@@ -405,8 +408,8 @@ CInputData::~CInputData()
 // is added. We use a vector of vector of doubles to hold the data so that
 // we don't have to store the interaction constants in every bead.
 //
-// If the flag UseDPDBeadRadii is set the radius of interaction of the bead type
-// is set in the newly-created CBead object.
+// The radius of interaction of the bead type is set in the newly-created CBead 
+// object. It is only used if the control data file contains the BeadRadii keyword.
 //	
 // MD Bead Structure
 // ******************
@@ -416,24 +419,18 @@ CInputData::~CInputData()
 
 bool CInputData::AddBeadType(zString name, const CBeadStructure* pStructure)
 {
-#if SimIdentifier == BD
-
-	const CBDBeadStructure* pBeadStruct = dynamic_cast<const CBDBeadStructure*>(pStructure);
-
-#elif SimIdentifier == DPD
+	// Only the structure matching the simulation type is non-null
 
-	const CDPDBeadStructure* pBeadStruct = dynamic_cast<const CDPDBeadStructure*>(pStructure);
-
-#elif SimIdentifier == MD
-
-	const CMDBeadStructure* pBeadStruct   = dynamic_cast<const CMDBeadStructure*>(pStructure);
-
-#endif
+	const CBDBeadStructure*  pBDStruct  = dynamic_cast<const CBDBeadStructure*>(pStructure);
+	const CDPDBeadStructure* pDPDStruct = dynamic_cast<const CDPDBeadStructure*>(pStructure);
+	const CMDBeadStructure*  pMDStruct  = dynamic_cast<const CMDBeadStructure*>(pStructure);
 
 	if(!IsNameValid(name))
 		return false;
 	else if(mBeadNames.find(name) != mBeadNames.end())
 		return false;
+	else if(!pBDStruct && !pDPDStruct && !pMDStruct)
+		return false;
 	else
 	{
 		long BeadTypeTotal = vBeadTypes.size();
@@ -444,99 +441,59 @@ bool CInputData::AddBeadType(zString name, const CBeadStructure* pStructure)
 		// Create a template CBead object to hold the data for all beads 
 		// of this type.
 
-		CBead* pBead;
-
-		if( vBeadTypes.empty() )	// first bead type defined
-		{
-			pBead = new CBead(BeadTypeTotal);
-			vBeadTypes.push_back(pBead);
-
-#if SimIdentifier == BD
+		CBead* pBead = new CBead(BeadTypeTotal);
+		vBeadTypes.push_back(pBead);
 
-			pBead->SetRadius(pBeadStruct->GetRadius());
-		    pBead->SetTransDiff(pBeadStruct->GetTransDiff());
-			pBead->SetRotDiff(pBeadStruct->GetRotDiff());
-			m_vvConsInt.push_back(pBeadStruct->GetConsInt());
-			m_vvDissInt.push_back(pBeadStruct->GetDissInt());
+		// If previous bead types exist add their interactions with the new bead
+		// before adding the new type's own row.
 
-#elif SimIdentifier == DPD
-
-			pBead->SetRadius(pBeadStruct->GetRadius());
-			m_vvConsInt.push_back(pBeadStruct->GetConsInt());
-			m_vvDissInt.push_back(pBeadStruct->GetDissInt());
-
-#if EnableDPDLG == ExperimentEnabled
-            if(IsDPDLG())
-            {
-			    pBead->SetLGRadius(pBeadStruct->GetLGRadius());
-			    m_vvLGInt.push_back(pBeadStruct->GetLGInt());
-            }
-#endif
-
-#elif SimIdentifier == MD
-
-			m_vvLJDepth.push_back(pBeadStruct->GetLJDepth());
-			m_vvLJRange.push_back(pBeadStruct->GetLJRange());
-			m_vvSCDepth.push_back(pBeadStruct->GetSCDepth());
-			m_vvSCRange.push_back(pBeadStruct->GetSCRange());
-#endif
-		}
-		else	// previous bead types exist so add their interactions with the new bead
+		if(pBDStruct)
 		{
-			pBead = new CBead(BeadTypeTotal);
-			vBeadTypes.push_back(pBead);
-
-			// Update current beads before adding the new type
-#if SimIdentifier == BD
-
-			pBead->SetRadius(pBeadStruct->GetRadius());
-			pBead->SetTransDiff(pBeadStruct->GetTransDiff());
-			pBead->SetRotDiff(pBeadStruct->GetRotDiff());
+			pBead->SetRadius(pBDStruct->GetRadius());
+			pBead->SetTransDiff(pBDStruct->GetTransDiff());
+			pBead->SetRotDiff(pBDStruct->GetRotDiff());
 			for(long beadType=0; beadType<BeadTypeTotal; beadType++)
 			{
-				m_vvConsInt.at(beadType).push_back((pBeadStruct->GetConsInt()).at(beadType));
-				m_vvDissInt.at(beadType).push_back((pBeadStruct->GetDissInt()).at(beadType));
+				m_vvConsInt.at(beadType).push_back((pBDStruct->GetConsInt()).at(beadType));
+				m_vvDissInt.at(beadType).push_back((pBDStruct->GetDissInt()).at(beadType));
 			}
-			m_vvConsInt.push_back(pBeadStruct->GetConsInt());
-			m_vvDissInt.push_back(pBeadStruct->GetDissInt());
-
-#elif SimIdentifier == DPD
-
-			pBead->SetRadius(pBeadStruct->GetRadius());
+			m_vvConsInt.push_back(pBDStruct->GetConsInt());
+			m_vvDissInt.push_back(pBDStruct->GetDissInt());
+		}
+		else if(pDPDStruct)
+		{
+			pBead->SetRadius(pDPDStruct->GetRadius());
 			for(long beadType=0; beadType<BeadTypeTotal; beadType++)
 			{
-				m_vvConsInt.at(beadType).push_back((pBeadStruct->GetConsInt()).at(beadType));
-				m_vvDissInt.at(beadType).push_back((pBeadStruct->GetDissInt()).at(beadType));
+				m_vvConsInt.at(beadType).push_back((pDPDStruct->GetConsInt()).at(beadType));
+				m_vvDissInt.at(beadType).push_back((pDPDStruct->GetDissInt()).at(beadType));
 			}
-			m_vvConsInt.push_back(pBeadStruct->GetConsInt());
-			m_vvDissInt.push_back(pBeadStruct->GetDissInt());
+			m_vvConsInt.push_back(pDPDStruct->GetConsInt());
+			m_vvDissInt.push_back(pDPDStruct->GetDissInt());
 
-#if EnableDPDLG == ExperimentEnabled
             if(IsDPDLG())
             {
-			    pBead->SetLGRadius(pBeadStruct->GetLGRadius());
+			    pBead->SetLGRadius(pDPDStruct->GetLGRadius());
 			    for(long beadType1=0; beadType1<BeadTypeTotal; beadType1++)
 			    {
-				    m_vvLGInt.at(beadType1).push_back((pBeadStruct->GetLGInt()).at(beadType1));
+				    m_vvLGInt.at(beadType1).push_back((pDPDStruct->GetLGInt()).at(beadType1));
 			    }
-			    m_vvLGInt.push_back(pBeadStruct->GetLGInt());
+			    m_vvLGInt.push_back(pDPDStruct->GetLGInt());
             }
-#endif
-#elif SimIdentifier == MD
-
+		}
+		else
+		{
 			for(long beadType=0; beadType<BeadTypeTotal; beadType++)
 			{
-				m_vvLJDepth.at(beadType).push_back((pBeadStruct->GetLJDepth()).at(beadType));
-				m_vvLJRange.at(beadType).push_back((pBeadStruct->GetLJRange()).at(beadType));
-				m_vvSCDepth.at(beadType).push_back((pBeadStruct->GetSCDepth()).at(beadType));
-				m_vvSCRange.at(beadType).push_back((pBeadStruct->GetSCRange()).at(beadType));
+				m_vvLJDepth.at(beadType).push_back((pMDStruct->GetLJDepth()).at(beadType));
+				m_vvLJRange.at(beadType).push_back((pMDStruct->GetLJRange()).at(beadType));
+				m_vvSCDepth.at(beadType).push_back((pMDStruct->GetSCDepth()).at(beadType));
+				m_vvSCRange.at(beadType).push_back((pMDStruct->GetSCRange()).at(beadType));
 			}
-			m_vvLJDepth.push_back(pBeadStruct->GetLJDepth());
-			m_vvLJRange.push_back(pBeadStruct->GetLJRange());
-			m_vvSCDepth.push_back(pBeadStruct->GetSCDepth());
-			m_vvSCRange.push_back(pBeadStruct->GetSCRange());
-
-#endif
+			m_vvLJDepth.push_back(pMDStruct->GetLJDepth());
+			m_vvLJRange.push_back(pMDStruct->GetLJRange());
+			m_vvSCDepth.push_back(pMDStruct->GetSCDepth());
+			m_vvSCRange.push_back(pMDStruct->GetSCRange());
 		}
 	}
 
@@ -1933,42 +1890,33 @@ void CInputData::SetCNTZCellWidth(double zcellwidth)
 }
 
 // Function to open a stream to the CDF and call its Serialize() method to 
-// write the default data appropriate to the simulation type. This is selected 
-// by conditional compilation of the appropriate class. Note that for a DPD
-// simulation we only write out a standard CDF not the liquid-gas one.
+// write the default data appropriate to the simulation type. The type is the 
+// one returned by GetSimIdentifier(), which is DPD unless a control data file 
+// has selected another type. Note that for a DPD simulation we only write out 
+// a standard CDF not the liquid-gas one.
 
 bool CInputData::WriteDefaultControlDataFile(const zString iFileName)
 {
-#if SimIdentifier == BD
-
-	CInputBDFile inFile(iFileName, true, *m_pISD);	// true = write to file
-
-	inFile.Title	= "Actin monomers";
-	inFile.Date		= "8/5/06";
-	inFile.Comment	= "1000 actin monomers in a 32**3 box";
-
-#elif SimIdentifier == DPD
-
-	CInputDPDFile inFile(iFileName, true, *m_pISD);	// true = write to file
-
-	inFile.Title	= "Water/surfactant";
-	inFile.Date		= "2/7/01";
-	inFile.Comment	= "Default test run of 2057h";
-
-#elif SimIdentifier == MD
-
-	CInputMDFile inFile(iFileName, true, *m_pISD);	
-
-	inFile.Title	= "Default MD Oil/Water";
-	inFile.Date		= "26/1/00";
-	inFile.Comment	= "Under construction";
-
-#endif
+	if(GetSimIdentifier() == BD)
+	{
+		return WriteDefaultBDFile(iFileName);
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		return WriteDefaultMDFile(iFileName);
+	}
+	else
+	{
+		return WriteDefaultDPDFile(iFileName);
+	}
+}
 
 // Copy data common to all simulation types to the input file object.
 // We conditionally compile in the processor numbers because they do
 // not exist in the input file unless a parallel run is being done.
 
+template<class TInputFile> void CInputData::CopyDefaultData(TInputFile& inFile) const
+{
 #if SimMPS == SimulationEnabled
     inFile.ProcXNo              = ProcXNo;
     inFile.ProcYNo              = ProcYNo;
@@ -1984,15 +1932,6 @@ bool CInputData::WriteDefaultControlDataFile(const zString iFileName)
 	inFile.AverageBeadDensity	= AverageBeadDensity;
 	inFile.kT					= kT;
 	inFile.RNGSeed				= RNGSeed;
-
-#if SimIdentifier == BD
-	inFile.Lambda				= Lambda;
-#elif SimIdentifier == DPD
-	inFile.Lambda				= Lambda;
-#elif SimIdentifier == MD
-	inFile.RCutOff				= RCutOff;
-#endif
-
 	inFile.StepSize				= StepSize;
 	inFile.TotalTime			= TotalTime;
 	inFile.SamplePeriod			= SamplePeriod;
@@ -2003,295 +1942,347 @@ bool CInputData::WriteDefaultControlDataFile(const zString iFileName)
 	inFile.GridXCellNo			= GridXCellNo;
 	inFile.GridYCellNo			= GridYCellNo;
 	inFile.GridZCellNo			= GridZCellNo;
+}
 
-	// **********************************************************************
-	// Data for the default run correspond to the control data file 2057h.
-	// This is used to check the behaviour of the code after general modifications.
-	// But note that it does not test any of the analysis options only the 
-	// general properties of the simulation and global observable in CMonitor.
-	//
-	// Bead name	Conservative					Dissipative
-	//	H			25.0						4.5
-	//	A			25.0 25.0					4.5	4.5
-	//	B			50.0 50.0 25.0				9   9   4.5
-	//	T			50.0 50.0 25.0 25.0			9   9   4.5  4.5
-	//	W			35.0 35.0 75.0 75.0 25.0	4.5 4.5 20.0 20.0 4.5
-
-	// Create two bond types with names that correspond to the names of the
-	// beads at each end concatenated. We pass in the names of the beads
-	// at each end of the bond and the function creates the bond name.
-	//
-	// Type		Spring constant    Unstretched length
-	//	HT			128.0					0.5
-	//	TT			128.0					0.5
-	//
-	// Polymer shapes are defined as strings and are parsed within the CInputData
-	// object overloaded functions AddPolymerType(). We define a grammar for 
-	// the polymer structures that
-	// allows the user to define branches and loops and repeated bead names.
-	// The whole structure must be inclosed within brackets, and any operators
-	// must be the first token after a left bracket.
-	//
-	// The only tokens that can appear in a polymer shape are:
-	//
-	// 1	"(" and ")" to denote the start and end of sequences of elements
-	// 2	"ABC1234"	strings that represent bead names (must start a with letter)
-	// 3	" "			spaces as separators for elements
-	// 4    "*" "/"     operators defining a side branch and loop
-	// 5	"123"		numbers representing a repeat multiplier
-	//
-	//
-	// The only characters that can appear in a bead or polymer name are
-	// alphanumeric ones. No underscores, spaces, dashes etc.
-	//
-	// Bond names are constructed by concatenating the names of the beads
-	// at each end. No user-assigned name is allowed.
-	//
-	// We have tested the code on the following structures:
-	//
-	//	(A B B A)
-	//  (A B (* B) B (* B) A)
-	//  (A B (4 (* B)) B A)
-	//  (A A (* (4 B)(*(A A A A)) (2 (* B)) B A)
-	//  (A(B)B)
-	//  (A(*B)(*B)B)
-	//  (W)
-	//
-	// Note that spaces must separate bead names (and a numeric operator and
-	// a bead name) otherwise the whole sequence of
-	// of chars will be taken as one name. However, brackets may be adjacent
-	// to a bead name or operator.
-
-#if SimIdentifier == BD
-	
-		zString name;
+// Function to write the default BD control data file: 1000 actin monomers.
+
+bool CInputData::WriteDefaultBDFile(const zString iFileName)
+{
+	CInputBDFile inFile(iFileName, true, *m_pISD);	// true = write to file
+
+	inFile.Title	= "Actin monomers";
+	inFile.Date		= "8/5/06";
+	inFile.Comment	= "1000 actin monomers in a 32**3 box";
+
+	CopyDefaultData(inFile);
+	inFile.Lambda				= Lambda;
+
+	zString name;
         double radius, transDiff, rotDiff;
-		zDoubleVector consInt, dissInt;
+	zDoubleVector consInt, dissInt;
 
-		name = "A3";
+	name = "A3";
         radius = 0.5;
         transDiff = 1.0;
         rotDiff = 0.0;
-		consInt.push_back(25.0);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, radius, transDiff, rotDiff, consInt, dissInt);
+	consInt.push_back(25.0);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, radius, transDiff, rotDiff, consInt, dissInt);
 
-		name = "M";
+	name = "M";
         radius = 0.5;
         transDiff = 1.0;
         rotDiff = 0.0;
-		consInt.clear();
-		dissInt.clear();
-		consInt.push_back(25.0);
-		consInt.push_back(25.0);
-		dissInt.push_back(4.5);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, radius, transDiff, rotDiff, consInt, dissInt);
-
-		name = "T3";
+	consInt.clear();
+	dissInt.clear();
+	consInt.push_back(25.0);
+	consInt.push_back(25.0);
+	dissInt.push_back(4.5);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, radius, transDiff, rotDiff, consInt, dissInt);
+
+	name = "T3";
         radius = 0.5;
         transDiff = 1.0;
         rotDiff = 0.0;
-		consInt.clear();
-		dissInt.clear();
-		consInt.push_back(25.0);
-		consInt.push_back(25.0);
-		consInt.push_back(25.0);
-		dissInt.push_back(4.5);
-		dissInt.push_back(4.5);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, radius, transDiff, rotDiff, consInt, dissInt);
-
-		inFile.AddNewBondType("A3", "M",  128.0, 0.75);
-		inFile.AddNewBondType("A3", "T3", 128.0, 0.75);
-		inFile.AddNewBondType("M",  "T3", 128.0, 0.75);
+	consInt.clear();
+	dissInt.clear();
+	consInt.push_back(25.0);
+	consInt.push_back(25.0);
+	consInt.push_back(25.0);
+	dissInt.push_back(4.5);
+	dissInt.push_back(4.5);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, radius, transDiff, rotDiff, consInt, dissInt);
+
+	inFile.AddNewBondType("A3", "M",  128.0, 0.75);
+	inFile.AddNewBondType("A3", "T3", 128.0, 0.75);
+	inFile.AddNewBondType("M",  "T3", 128.0, 0.75);
 
         // We have to explicitly specify the polymer's Head and Tail because of the 
         // loop tokens at the beginning and end of the polymer's shape.
 
-		inFile.AddNewPolymerType("mActin", " ((/ 1 A3) M (/ 1 T3)) ", 1.0, "A3", "T3");
+	inFile.AddNewPolymerType("mActin", " ((/ 1 A3) M (/ 1 T3)) ", 1.0, "A3", "T3");
 
-		// Add any commands present in the default state: none are included for now.
+	// Add any commands present in the default state: none are included for now.
 
-#elif SimIdentifier == DPD
-	
-		zString name;
-		zDoubleVector consInt, dissInt;
-
-		name = "H";
-		consInt.push_back(25.0);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, consInt, dissInt);
-
-		name = "A";
-		consInt.clear();
-		dissInt.clear();
-		consInt.push_back(25.0);
-		consInt.push_back(25.0);
-		dissInt.push_back(4.5);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, consInt, dissInt);
-
-		name = "B";
-		consInt.clear();
-		dissInt.clear();
-		consInt.push_back(50.0);
-		consInt.push_back(50.0);
-		consInt.push_back(25.0);
-		dissInt.push_back(9.0);
-		dissInt.push_back(9.0);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, consInt, dissInt);
-
-		name = "T";
-		consInt.clear();
-		dissInt.clear();
-		consInt.push_back(50.0);
-		consInt.push_back(50.0);
-		consInt.push_back(25.0);
-		consInt.push_back(25.0);
-		dissInt.push_back(9.0);
-		dissInt.push_back(9.0);
-		dissInt.push_back(4.5);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, consInt, dissInt);
-
-		name = "W";
-		consInt.clear();
-		dissInt.clear();
-		consInt.push_back(35.0);
-		consInt.push_back(35.0);
-		consInt.push_back(75.0);
-		consInt.push_back(75.0);
-		consInt.push_back(25.0);
-		dissInt.push_back(4.5);
-		dissInt.push_back(4.5);
-		dissInt.push_back(20.0);
-		dissInt.push_back(20.0);
-		dissInt.push_back(4.5);
-		inFile.AddNewBeadType(name, consInt, dissInt);
-
-		inFile.AddNewBondType("H", "T", 128.0, 0.5);
-		inFile.AddNewBondType("T", "T", 128.0, 0.5);
-
-		inFile.AddNewBondPairType("H", "T", "T", 10.0, 0.0);
-		inFile.AddNewBondPairType("T", "T", "T", 10.0, 0.0);
-
-		inFile.AddNewPolymerType("Water", " (W) ", 0.957628);
-		inFile.AddNewPolymerType("Lipid", " (H T T T T T T) ", 0.042372);
-
-		// Add any commands present in the default state: none are included for now.
-
-#elif SimIdentifier == MD
-
-		zString name;
-		zDoubleVector ljDepth, ljRange;
-		zDoubleVector scDepth, scRange;
-
-		name = "A";
-		ljDepth.clear();
-		ljRange.clear();
-		scDepth.clear();
-		scRange.clear();
-		ljDepth.push_back(2.0);
-		ljRange.push_back(1.0);
-		scDepth.push_back(2.5);
-		scRange.push_back(1.5);
-
-		inFile.AddNewBeadType(name, ljDepth, ljRange, scDepth, scRange);
-
-		name = "B";
-		ljDepth.clear();
-		ljRange.clear();
-		scDepth.clear();
-		scRange.clear();
-		ljDepth.push_back(4.0);
-		ljDepth.push_back(4.0);
-		ljRange.push_back(3.0);
-		ljRange.push_back(3.0);
-		scDepth.push_back(4.5);
-		scDepth.push_back(4.5);
-		scRange.push_back(3.5);
-		scRange.push_back(3.5);
-
-		inFile.AddNewBeadType(name, ljDepth, ljRange, scDepth, scRange);
-
-		name = "W";
-		ljDepth.clear();
-		ljRange.clear();
-		scDepth.clear();
-		scRange.clear();
-		ljDepth.push_back(6.0);
-		ljDepth.push_back(6.0);
-		ljDepth.push_back(6.0);
-		ljRange.push_back(5.0);
-		ljRange.push_back(5.0);
-		ljRange.push_back(5.0);
-		scDepth.push_back(6.5);
-		scDepth.push_back(6.5);
-		scDepth.push_back(6.5);
-		scRange.push_back(5.5);
-		scRange.push_back(5.5);
-		scRange.push_back(5.5);
-
-		inFile.AddNewBeadType(name, ljDepth, ljRange, scDepth, scRange);
-
-		inFile.AddNewBondType("B", "B", 1.0, 0.4);
-		inFile.AddNewBondType("A", "B", 2.0, 0.7);
-
-		inFile.AddNewPolymerType("Water", "(W)", 0.86);
-		inFile.AddNewPolymerType("Lipid",  "(B B A B B)", 0.14);
+	return inFile.Serialize();
+}
 
-#endif
+// Function to write the default DPD control data file.
+//
+// Data for the default run correspond to the control data file 2057h.
+// This is used to check the behaviour of the code after general modifications.
+// But note that it does not test any of the analysis options only the 
+// general properties of the simulation and global observable in CMonitor.
+//
+// Bead name	Conservative					Dissipative
+//	H			25.0						4.5
+//	A			25.0 25.0					4.5	4.5
+//	B			50.0 50.0 25.0				9   9   4.5
+//	T			50.0 50.0 25.0 25.0			9   9   4.5  4.5
+//	W			35.0 35.0 75.0 75.0 25.0	4.5 4.5 20.0 20.0 4.5
+//
+// Create two bond types with names that correspond to the names of the
+// beads at each end concatenated. We pass in the names of the beads
+// at each end of the bond and the function creates the bond name.
+//
+// Type		Spring constant    Unstretched length
+//	HT			128.0					0.5
+//	TT			128.0					0.5
+//
+// Polymer shapes are defined as strings and are parsed within the CInputData
+// object overloaded functions AddPolymerType(). We define a grammar for 
+// the polymer structures that
+// allows the user to define branches and loops and repeated bead names.
+// The whole structure must be inclosed within brackets, and any operators
+// must be the first token after a left bracket.
+//
+// The only tokens that can appear in a polymer shape are:
+//
+// 1	"(" and ")" to denote the start and end of sequences of elements
+// 2	"ABC1234"	strings that represent bead names (must start a with letter)
+// 3	" "			spaces as separators for elements
+// 4    "*" "/"     operators defining a side branch and loop
+// 5	"123"		numbers representing a repeat multiplier
+//
+//
+// The only characters that can appear in a bead or polymer name are
+// alphanumeric ones. No underscores, spaces, dashes etc.
+//
+// Bond names are constructed by concatenating the names of the beads
+// at each end. No user-assigned name is allowed.
+//
+// We have tested the code on the following structures:
+//
+//	(A B B A)
+//  (A B (* B) B (* B) A)
+//  (A B (4 (* B)) B A)
+//  (A A (* (4 B)(*(A A A A)) (2 (* B)) B A)
+//  (A(B)B)
+//  (A(*B)(*B)B)
+//  (W)
+//
+// Note that spaces must separate bead names (and a numeric operator and
+// a bead name) otherwise the whole sequence of
+// of chars will be taken as one name. However, brackets may be adjacent
+// to a bead name or operator.
+
+bool CInputData::WriteDefaultDPDFile(const zString iFileName)
+{
+	CInputDPDFile inFile(iFileName, true, *m_pISD);	// true = write to file
+
+	inFile.Title	= "Water/surfactant";
+	inFile.Date		= "2/7/01";
+	inFile.Comment	= "Default test run of 2057h";
+
+	CopyDefaultData(inFile);
+	inFile.Lambda				= Lambda;
+
+	zString name;
+	zDoubleVector consInt, dissInt;
+
+	name = "H";
+	consInt.push_back(25.0);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, consInt, dissInt);
+
+	name = "A";
+	consInt.clear();
+	dissInt.clear();
+	consInt.push_back(25.0);
+	consInt.push_back(25.0);
+	dissInt.push_back(4.5);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, consInt, dissInt);
+
+	name = "B";
+	consInt.clear();
+	dissInt.clear();
+	consInt.push_back(50.0);
+	consInt.push_back(50.0);
+	consInt.push_back(25.0);
+	dissInt.push_back(9.0);
+	dissInt.push_back(9.0);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, consInt, dissInt);
+
+	name = "T";
+	consInt.clear();
+	dissInt.clear();
+	consInt.push_back(50.0);
+	consInt.push_back(50.0);
+	consInt.push_back(25.0);
+	consInt.push_back(25.0);
+	dissInt.push_back(9.0);
+	dissInt.push_back(9.0);
+	dissInt.push_back(4.5);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, consInt, dissInt);
+
+	name = "W";
+	consInt.clear();
+	dissInt.clear();
+	consInt.push_back(35.0);
+	consInt.push_back(35.0);
+	consInt.push_back(75.0);
+	consInt.push_back(75.0);
+	consInt.push_back(25.0);
+	dissInt.push_back(4.5);
+	dissInt.push_back(4.5);
+	dissInt.push_back(20.0);
+	dissInt.push_back(20.0);
+	dissInt.push_back(4.5);
+	inFile.AddNewBeadType(name, consInt, dissInt);
+
+	inFile.AddNewBondType("H", "T", 128.0, 0.5);
+	inFile.AddNewBondType("T", "T", 128.0, 0.5);
+
+	inFile.AddNewBondPairType("H", "T", "T", 10.0, 0.0);
+	inFile.AddNewBondPairType("T", "T", "T", 10.0, 0.0);
+
+	inFile.AddNewPolymerType("Water", " (W) ", 0.957628);
+	inFile.AddNewPolymerType("Lipid", " (H T T T T T T) ", 0.042372);
+
+	// Add any commands present in the default state: none are included for now.
+
+	return inFile.Serialize();
+}
+
+// Function to write the default MD control data file.
+
+bool CInputData::WriteDefaultMDFile(const zString iFileName)
+{
+	CInputMDFile inFile(iFileName, true, *m_pISD);	
+
+	inFile.Title	= "Default MD Oil/Water";
+	inFile.Date		= "26/1/00";
+	inFile.Comment	= "Under construction";
+
+	CopyDefaultData(inFile);
+	inFile.RCutOff				= RCutOff;
+
+	zString name;
+	zDoubleVector ljDepth, ljRange;
+	zDoubleVector scDepth, scRange;
+
+	name = "A";
+	ljDepth.clear();
+	ljRange.clear();
+	scDepth.clear();
+	scRange.clear();
+	ljDepth.push_back(2.0);
+	ljRange.push_back(1.0);
+	scDepth.push_back(2.5);
+	scRange.push_back(1.5);
+
+	inFile.AddNewBeadType(name, ljDepth, ljRange, scDepth, scRange);
+
+	name = "B";
+	ljDepth.clear();
+	ljRange.clear();
+	scDepth.clear();
+	scRange.clear();
+	ljDepth.push_back(4.0);
+	ljDepth.push_back(4.0);
+	ljRange.push_back(3.0);
+	ljRange.push_back(3.0);
+	scDepth.push_back(4.5);
+	scDepth.push_back(4.5);
+	scRange.push_back(3.5);
+	scRange.push_back(3.5);
+
+	inFile.AddNewBeadType(name, ljDepth, ljRange, scDepth, scRange);
+
+	name = "W";
+	ljDepth.clear();
+	ljRange.clear();
+	scDepth.clear();
+	scRange.clear();
+	ljDepth.push_back(6.0);
+	ljDepth.push_back(6.0);
+	ljDepth.push_back(6.0);
+	ljRange.push_back(5.0);
+	ljRange.push_back(5.0);
+	ljRange.push_back(5.0);
+	scDepth.push_back(6.5);
+	scDepth.push_back(6.5);
+	scDepth.push_back(6.5);
+	scRange.push_back(5.5);
+	scRange.push_back(5.5);
+	scRange.push_back(5.5);
+
+	inFile.AddNewBeadType(name, ljDepth, ljRange, scDepth, scRange);
+
+	inFile.AddNewBondType("B", "B", 1.0, 0.4);
+	inFile.AddNewBondType("A", "B", 2.0, 0.7);
+
+	inFile.AddNewPolymerType("Water", "(W)", 0.86);
+	inFile.AddNewPolymerType("Lipid",  "(B B A B B)", 0.14);
 
 	return inFile.Serialize();
 }
 
 // Function to open a stream attached to the CDF and read all the data 
-// needed for a simulation of the current type. It provides the inverse 
-// operation to WriteDefaultControlDataFile().
+// needed for a simulation. It provides the inverse operation to 
+// WriteDefaultControlDataFile().
 //
-// It is conditionally compiled to create an object of the appropriate 
-// simulation type to read the data from a file. The Serialize() method 
+// The first token in the file selects the simulation type: "bd", "md", or
+// "dpd"/"dpdlg". We set the simulation identifier from it and create an object 
+// of the appropriate class to read the data from the file. The Serialize() method 
 // is called to get the data. Once the data has been read it is used to 
 // fill up the CInputData object's parameter values. For DPD simulations
 // there are two options: a standard DPD run with conservative and dissipative
 // forces, and a run that also includes a density-dependent force to allow
-// liquid-gas interfaces to occur. We read a boolean flag from the input
-// file to determine which of these is being simulated, and then copy the
-// state into a local flag for later use in reading the interaction parameters.
-// Note that even if the EnableDPDLG flag is compiled in, we can still do 
-// a standard DPD run by setting the input file appropriately.
+// liquid-gas interfaces to occur. Both are read by the CInputDPDLGFile class, 
+// which also reads the optional BeadRadii keyword. Any other first token is 
+// passed to the DPD reader so that it reports the error.
 //
 // If an error occurs on reading the data the function returns false, if everything
 // is successful it returns true.
 
 bool CInputData::ReadControlDataFile(const zString iFileName)
 {
+	zInFileStream simTypeStream(iFileName.c_str());
+
+	zString sSimType;
+	simTypeStream >> sSimType;
+	simTypeStream.close();
 
-#if SimIdentifier == BD
+	if(sSimType == "bd")
+	{
+		SetSimIdentifier(BD);
 
-	CInputBDFile inFile(iFileName, false, *m_pISD);	// false = read from file
+		CInputBDFile inFile(iFileName, false, *m_pISD);	// false = read from file
 
-#elif SimIdentifier == DPD
+		return ReadControlData(inFile);
+	}
+	else if(sSimType == "md")
+	{
+		SetSimIdentifier(MD);
 
-#if EnableDPDLG == ExperimentEnabled
-	CInputDPDLGFile inFile(iFileName, false, *m_pISD);
-#elif EnableDPDLG == ExperimentDisabled
-	CInputDPDFile inFile(iFileName, false, *m_pISD);	// false = read from file
-#endif
+		CInputMDFile inFile(iFileName, false, *m_pISD);	
 
-#elif SimIdentifier == MD
+		return ReadControlData(inFile);
+	}
+	else
+	{
+		SetSimIdentifier(DPD);
 
-	CInputMDFile inFile(iFileName, false, *m_pISD);	
+		CInputDPDLGFile inFile(iFileName, false, *m_pISD);
 
-#endif
+		return ReadControlData(inFile);
+	}
+}
 
+// Function to copy the data read by one of the control data file classes into
+// the CInputData object and validate it. The data specific to each simulation
+// type is copied by the overloaded CopySimTypeData() functions.
+
+template<class TInputFile> bool CInputData::ReadControlData(TInputFile& inFile)
+{
 	if(inFile.IsFileStateOk() && inFile.Serialize())	// if no IO errors copy data into CInputData object
 	{
-#if EnableDPDLG == ExperimentEnabled
-        SetDPDLG(inFile.IsLG());
-#endif
 		SetTitle(inFile.Title);
 		SetDate(inFile.Date);
 		SetComment(inFile.Comment);
@@ -2310,17 +2301,6 @@ bool CInputData::ReadControlDataFile(const zString iFileName)
 		SetAveBeadDensity(inFile.AverageBeadDensity);
 		SetTemp(inFile.kT);
 		SetRNGSeed(inFile.RNGSeed);
-
-#if SimIdentifier == BD
-		SetLambda(inFile.Lambda);
-#elif SimIdentifier == DPD
-		SetLambda(inFile.Lambda);
-#elif SimIdentifier == MD
-		SetCutOffRadius(inFile.RCutOff);
-		SetMCStepSize(inFile.MCStepSize);
-		SetTotalMCTime(inFile.TotalMCTime);
-#endif
-
 		SetStepSize(inFile.StepSize);
 		SetTotalTime(inFile.TotalTime);
 		SetSamplePeriod(inFile.SamplePeriod);
@@ -2332,14 +2312,7 @@ bool CInputData::ReadControlDataFile(const zString iFileName)
 		SetGridYCellNo(inFile.GridYCellNo);
 		SetGridZCellNo(inFile.GridZCellNo);
 
-		// Normalize the MD interaction parameters prior to copying the
-		// BeadTypes, BondTypes and BondPairTypes into CBead, CBond and
-		// CBondPair objects. This is unnecessary for DPD because the 
-		// values entered by the user are already dimensionless.
-
-#if SimIdentifier == MD
-			NormalizeMD(inFile.mNewBeadTypes, inFile.mNewBondTypes, inFile.mNewBondPairTypes, inFile.mNewPolymerTypes);
-#endif
+		CopySimTypeData(inFile);
 
 		// Create the beads, bonds and polymers from the representations
 		// read from the input file. If these are valid check that the optional
@@ -2387,12 +2360,42 @@ bool CInputData::ReadControlDataFile(const zString iFileName)
 		return false;
 }
 
+// Functions to copy the data specific to each simulation type. 
+// We leave Lambda in a BD simulation for compatibility of the CDF's.
+
+void CInputData::CopySimTypeData(CInputBDFile& inFile)
+{
+	SetLambda(inFile.Lambda);
+}
+
+void CInputData::CopySimTypeData(CInputDPDLGFile& inFile)
+{
+	SetDPDLG(inFile.IsLG());
+	SetBeadRadii(inFile.UsesBeadRadii());
+	SetLambda(inFile.Lambda);
+}
+
+// Normalize the MD interaction parameters prior to copying the
+// BeadTypes, BondTypes and BondPairTypes into CBead, CBond and
+// CBondPair objects. This is unnecessary for DPD because the 
+// values entered by the user are already dimensionless.
+
+void CInputData::CopySimTypeData(CInputMDFile& inFile)
+{
+	SetCutOffRadius(inFile.RCutOff);
+	SetMCStepSize(inFile.MCStepSize);
+	SetTotalMCTime(inFile.TotalMCTime);
+
+	NormalizeMD(inFile.mNewBeadTypes, inFile.mNewBondTypes, inFile.mNewBondPairTypes, inFile.mNewPolymerTypes);
+}
+
+
 // Function to convert the CBeadType, CBondType, CBondPairType and CPolymerType 
 // objects into the  internal representation needed by the CInputData object 
 // so that it can create 
 // multiple copies of beads, bonds and polymers to be used in the simulation. 
-// We use #def to distinguish the different simulation types. This removes the 
-// possibility of a mixture of DPD and MD beads created in the same
+// We use the simulation identifier to distinguish the different simulation types. 
+// This removes the possibility of a mixture of DPD and MD beads created in the same
 // simulation. The data on the bead-bead interactions is passed using the
 // CBeadStructure-derived classes.
 //
@@ -2412,19 +2415,18 @@ bool CInputData::CreateNewTypes(LongBeadTypeMap     mNewBeadTypes,
 	{
 		CBeadType* pBead = (*iterBead).second;
 
-#if SimIdentifier == BD
-
-		newTypeAdded = AddBeadType(pBead->GetName(), pBead->GetBDStructure());
-
-#elif SimIdentifier == DPD
-
-		newTypeAdded = AddBeadType(pBead->GetName(), pBead->GetDPDStructure());
-
-#elif SimIdentifier == MD
-
-		newTypeAdded = AddBeadType(pBead->GetName(), pBead->GetMDStructure());
-
-#endif
+		if(GetSimIdentifier() == BD)
+		{
+			newTypeAdded = AddBeadType(pBead->GetName(), pBead->GetBDStructure());
+		}
+		else if(GetSimIdentifier() == DPD)
+		{
+			newTypeAdded = AddBeadType(pBead->GetName(), pBead->GetDPDStructure());
+		}
+		else if(GetSimIdentifier() == MD)
+		{
+			newTypeAdded = AddBeadType(pBead->GetName(), pBead->GetMDStructure());
+		}
 
 		if(!newTypeAdded)
 			return ErrorTrace("Error adding bead type to CInputData");
@@ -2481,26 +2483,32 @@ bool CInputData::CreateNewTypes(LongBeadTypeMap     mNewBeadTypes,
 }
 
 // Function showing if a DPD simulation includes the density-dependent force
-// that allows liquid-gas interfaces. If the EnableDPDLG flag is not set,
-// this is automatically false.
+// that allows liquid-gas interfaces. It is set by the "dpdlg" token at the 
+// start of the control data file.
 
 bool CInputData::IsDPDLG() const
 {
-#if EnableDPDLG == ExperimentEnabled
     return m_bLG;
-#elif EnableDPDLG == ExperimentDisabled
-    return false;
-#endif
 }
 // Function to set a flag showing if the density-dependent force is inclued in DPD
 
 void CInputData::SetDPDLG(bool bLG)
 {
-#if EnableDPDLG == ExperimentEnabled
     m_bLG = bLG;
-#elif EnableDPDLG == ExperimentDisabled
-    m_bLG = false;
-#endif
+}
+
+// Function showing if the DPD forces use the radii of the bead types instead 
+// of a unit cut-off. It is set by the optional BeadRadii keyword in the control 
+// data file.
+
+bool CInputData::UsesBeadRadii() const
+{
+    return m_bBeadRadii;
+}
+
+void CInputData::SetBeadRadii(bool bBeadRadii)
+{
+    m_bBeadRadii = bBeadRadii;
 }
 
 // Function to set the title of the current data set
@@ -3090,25 +3098,40 @@ bool CInputData::IsRestartDataValid(LongBeadTypeMap    mNewBeadTypes,
 									LongBondTypeMap    mNewBondTypes,
 									LongPolymerTypeMap mNewPolymerTypes) const
 {
-	// Define a flag showing whether the control data files match
-
-	bool bRestartOK = true;
-
     zString oldFileName = xxBase::GetCDFPrefix() + dynamic_cast<CInitialStateRestart*>(m_pISD)->GetRunId();
 
-#if SimIdentifier == BD
+	if(GetSimIdentifier() == BD)
+	{
+		CInputBDFile oldinFile(oldFileName, false, *m_pISD);	// false = read from file
 
-	CInputBDFile oldinFile(oldFileName, false, *m_pISD);	// false = read from file
+		return IsRestartDataValid(oldinFile, mNewBeadTypes, mNewBondTypes, mNewPolymerTypes);
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		CInputMDFile oldinFile(oldFileName, false, *m_pISD);	
 
-#elif SimIdentifier == DPD
+		return IsRestartDataValid(oldinFile, mNewBeadTypes, mNewBondTypes, mNewPolymerTypes);
+	}
+	else
+	{
+		CInputDPDLGFile oldinFile(oldFileName, false, *m_pISD);
 
-	CInputDPDFile oldinFile(oldFileName, false, *m_pISD);	// false = read from file
+		return IsRestartDataValid(oldinFile, mNewBeadTypes, mNewBondTypes, mNewPolymerTypes);
+	}
+}
 
-#elif SimIdentifier == MD
+// Function to compare the data read from the original control data file with 
+// the current values.
 
-	CInputMDFile oldinFile(oldFileName, false, *m_pISD);	
+template<class TInputFile> 
+bool CInputData::IsRestartDataValid(TInputFile&        oldinFile,
+									LongBeadTypeMap    mNewBeadTypes,
+									LongBondTypeMap    mNewBondTypes,
+									LongPolymerTypeMap mNewPolymerTypes) const
+{
+	// Define a flag showing whether the control data files match
 
-#endif
+	bool bRestartOK = true;
 
 	// Compare critical data with new values to make sure only legitimate changes 
 	// have been made. We set a flag true and then make it false if a discrepancy
@@ -3157,23 +3180,10 @@ bool CInputData::IsRestartDataValid(LongBeadTypeMap    mNewBeadTypes,
 		// We don't check the RNGSeed because we may want to change it 
 		// between runs
 
-#if SimIdentifier == BD
-        // We leave Lambda in a BD simulation for compatibility of the CDF's
-		if( Lambda != oldinFile.Lambda )
-		{
-			return ErrorTrace("Lambda keyword error in restart control data file");
-		}
-#elif SimIdentifier == DPD
-		if( Lambda != oldinFile.Lambda )
-		{
-			return ErrorTrace("Lambda keyword error in restart control data file");
-		}
-#elif SimIdentifier == MD
-		if( RCutOff != oldinFile.RCutOff )
+		if(!IsRestartSimTypeDataValid(oldinFile))
 		{
-			return ErrorTrace("RCutOff keyword error in restart control data file");
+			return false;
 		}
-#endif
 
 		// Check the number of bead, bond and polymer types and the fraction,
 		// shape and head/tail bead names for each polymer. The names are
@@ -3240,6 +3250,36 @@ bool CInputData::IsRestartDataValid(LongBeadTypeMap    mNewBeadTypes,
 	return bRestartOK;
 }
 
+// Functions to check the parameters specific to each simulation type in a
+// restart. We leave Lambda in a BD simulation for compatibility of the CDF's.
+
+bool CInputData::IsRestartSimTypeDataValid(const CInputBDFile& oldinFile) const
+{
+	if( Lambda != oldinFile.Lambda )
+	{
+		return ErrorTrace("Lambda keyword error in restart control data file");
+	}
+	return true;
+}
+
+bool CInputData::IsRestartSimTypeDataValid(const CInputDPDLGFile& oldinFile) const
+{
+	if( Lambda != oldinFile.Lambda )
+	{
+		return ErrorTrace("Lambda keyword error in restart control data file");
+	}
+	return true;
+}
+
+bool CInputData::IsRestartSimTypeDataValid(const CInputMDFile& oldinFile) const
+{
+	if( RCutOff != oldinFile.RCutOff )
+	{
+		return ErrorTrace("RCutOff keyword error in restart control data file");
+	}
+	return true;
+}
+
 // Function to set the data needed to impose a uniaxial shear on the simulation box.
 
 // NOT IMPLEMENTED YET.
@@ -3730,15 +3770,20 @@ void CInputData::ReceiveInputData(const pmInputData* const pMsg)
 	SetTemp(pMsg->GetTemperature());
 	SetRNGSeed(pMsg->GetRNGSeed());
 
-#if SimIdentifier == BD
-	SetLambda(pMsg->GetLambda());
-#elif SimIdentifier == DPD
-	SetLambda(pMsg->GetLambda());
-#elif SimIdentifier == MD
-	SetCutOffRadius(pMsg->GetRCutOff());
-	SetMCStepSize(pMsg->GetMCStepSize());
-	SetTotalMCTime(pMsg->GetTotalMCTime());
-#endif
+	if(GetSimIdentifier() == BD)
+	{
+		SetLambda(pMsg->GetLambda());
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		SetLambda(pMsg->GetLambda());
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		SetCutOffRadius(pMsg->GetRCutOff());
+		SetMCStepSize(pMsg->GetMCStepSize());
+		SetTotalMCTime(pMsg->GetTotalMCTime());
+	}
 
 	SetStepSize(pMsg->GetStepSize());
 	SetTotalTime(pMsg->GetTotalTime());
@@ -3799,9 +3844,10 @@ void CInputData::ReceiveBeadTypeData(const pmBeadData* const pMsg)
     m_vBeadTypesPN.push_back(pBead);
 
     // To allow for extensions we check the simulation type here
-#if SimIdentifier == DPD
-	AddBeadType(name, pBead->GetDPDStructure());
-#endif
+	if(GetSimIdentifier() == DPD)
+	{
+		AddBeadType(name, pBead->GetDPDStructure());
+	}
 
     // Debug output to check messaging:
 
@@ -33,6 +33,10 @@ class CInitialStateData;
 class CGravityData;
 class CWallData;
 class CBeadStructure;
+class CInputBDFile;
+class CInputDPDFile;
+class CInputDPDLGFile;
+class CInputMDFile;
 class pmInputData;
 class pmBeadData;
 class pmBondData;
@@ -169,6 +173,7 @@ public:
 	// Access functions for other simulation data
 
     bool IsDPDLG() const;  // Flag showing if DPD density-dependent force is included
+    bool UsesBeadRadii() const;  // Flag showing if DPD forces use the bead radii
 
 	inline const zString& GetRunId()    const {return runId;}
 	inline const zString& GetTitle()    const {return Title;}
@@ -290,8 +295,23 @@ private:
 
 	bool ReadControlDataFile(const zString iFileName);
 	bool WriteDefaultControlDataFile(const zString iFileName);
+	bool WriteDefaultBDFile(const zString iFileName);
+	bool WriteDefaultDPDFile(const zString iFileName);
+	bool WriteDefaultMDFile(const zString iFileName);
+
+	template<class TInputFile> void CopyDefaultData(TInputFile& inFile) const;
+
+	// Copy the data common to all simulation types from a control data file,
+	// and the data specific to each type using the overloaded functions
+
+	template<class TInputFile> bool ReadControlData(TInputFile& inFile);
+
+	void CopySimTypeData(CInputBDFile& inFile);
+	void CopySimTypeData(CInputDPDLGFile& inFile);
+	void CopySimTypeData(CInputMDFile& inFile);
 
     void SetDPDLG(bool bLG);
+    void SetBeadRadii(bool bBeadRadii);
 	void SetTitle(zString title);
 	void SetDate(zString date);
 	void SetComment(zString comment);
@@ -391,6 +411,16 @@ private:
 							LongBondTypeMap    mNewBondTypes,
 							LongPolymerTypeMap mNewPolymerTypes) const;
 
+	template<class TInputFile> 
+	bool IsRestartDataValid(TInputFile&        oldinFile,
+							LongBeadTypeMap    mNewBeadTypes,
+							LongBondTypeMap    mNewBondTypes,
+							LongPolymerTypeMap mNewPolymerTypes) const;
+
+	bool IsRestartSimTypeDataValid(const CInputBDFile&    oldinFile) const;
+	bool IsRestartSimTypeDataValid(const CInputDPDLGFile& oldinFile) const;
+	bool IsRestartSimTypeDataValid(const CInputMDFile&    oldinFile) const;
+
 
 	// ****************************************
 	// Functions to send the ValidateData message to all xxProcessObject,
@@ -544,6 +574,7 @@ private:
 	// Local implementation variables
 
     bool m_bLG;                 // Flag showing if density-dependent LG force is included
+    bool m_bBeadRadii;          // Flag showing if DPD forces use the bead radii
 	bool m_bGravity;			// External body force defined flag
 	bool m_bWall;				// Wall defined flag
 	bool m_bShear;				// Shear defined flag
@@ -185,12 +185,6 @@ CInputMDFile::~CInputMDFile()
 
 bool CInputMDFile::Serialize()
 {
-	// **********************************************************************
-    // We conditionally compile out this function to make it inaccessible when
-    // a different simulation type is being used.
-
-#if SimIdentifier == MD
-
 	if(m_IOFlag)	
 	{
 		// First token identifies simulation type in the data file
@@ -1035,7 +1029,6 @@ bool CInputMDFile::Serialize()
 			} // eof after process token
 		}
     }
-#endif
 
 	return true;
 }
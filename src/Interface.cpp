@@ -183,6 +183,14 @@ void CInterface::ConvertNames(const CAnalysisState& raState)
 	m_MinorTailType = raState.GetPolymerTailType(m_MinorType);
 }
 
+// The surface tension is calculated from the stress tensor profile each time 
+// the aggregate is sampled.
+
+bool CInterface::IsStressProfileUsed() const
+{
+	return true;
+}
+
 // Main function to measure and analyse all the observables relating to an interface.
 // It breaks the SimBox data (stored in CNTCells) into slices, row or cells and 
 // uses function objects to iterate over the collections measuring the data of interest.
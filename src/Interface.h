@@ -56,6 +56,10 @@ public:
 
 	virtual void ConvertNames(const CAnalysisState& raState);
 
+	// Function showing that the interface analysis needs the stress profile
+
+	virtual bool IsStressProfileUsed() const;
+
 private:
 	void Stress1d(const ISimBox* const pISimBox);
 	void SurfaceTension();
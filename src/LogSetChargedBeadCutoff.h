@@ -0,0 +1,65 @@
+// LogSetChargedBeadCutoff.h: interface for the CLogSetChargedBeadCutoff class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETCHARGEDBEADCUTOFF_H__71D0B5E3_2A6C_48F9_B3E7_9C4A06D81F25__INCLUDED_)
+#define AFX_LOGSETCHARGEDBEADCUTOFF_H__71D0B5E3_2A6C_48F9_B3E7_9C4A06D81F25__INCLUDED_
+
+
+#include "LogConstraintMessage.h"
+
+class CLogSetChargedBeadCutoff : public CLogConstraintMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetChargedBeadCutoff(long time, double cutoff);
+
+	virtual ~CLogSetChargedBeadCutoff();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetChargedBeadCutoff& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetChargedBeadCutoff(const CLogSetChargedBeadCutoff& oldMessage);
+	CLogSetChargedBeadCutoff& operator=(const CLogSetChargedBeadCutoff& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const double m_Cutoff;	// Cutoff distance of the screened charge force
+};
+
+
+#endif // !defined(AFX_LOGSETCHARGEDBEADCUTOFF_H__71D0B5E3_2A6C_48F9_B3E7_9C4A06D81F25__INCLUDED_)
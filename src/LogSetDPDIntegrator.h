@@ -0,0 +1,65 @@
+// LogSetDPDIntegrator.h: interface for the CLogSetDPDIntegrator class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETDPDINTEGRATOR_H__A4E61C38_9B2D_4F75_8C13_E2F7B05D6A91__INCLUDED_)
+#define AFX_LOGSETDPDINTEGRATOR_H__A4E61C38_9B2D_4F75_8C13_E2F7B05D6A91__INCLUDED_
+
+
+#include "LogConstraintMessage.h"
+
+class CLogSetDPDIntegrator : public CLogConstraintMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetDPDIntegrator(long time, const zString name);
+
+	virtual ~CLogSetDPDIntegrator();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetDPDIntegrator& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetDPDIntegrator(const CLogSetDPDIntegrator& oldMessage);
+	CLogSetDPDIntegrator& operator=(const CLogSetDPDIntegrator& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const zString m_Integrator;	// Name of the DPD integration scheme
+};
+
+
+#endif // !defined(AFX_LOGSETDPDINTEGRATOR_H__A4E61C38_9B2D_4F75_8C13_E2F7B05D6A91__INCLUDED_)
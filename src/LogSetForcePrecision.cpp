@@ -0,0 +1,81 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// LogSetForcePrecision.cpp: implementation of the CLogSetForcePrecision class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "LogSetForcePrecision.h"
+
+//////////////////////////////////////////////////////////////////////
+// Global function for serialization
+//////////////////////////////////////////////////////////////////////
+
+zOutStream& operator<<(zOutStream& os, const CLogSetForcePrecision& rMsg)
+{
+#if EnableXMLCommands == SimXMLEnabled
+
+	// XML output
+	os << "<Body>" << zEndl;
+	os << "<Name>SetForcePrecision</Name>" << zEndl;
+	os << "<Text>" << zEndl;
+	os << "Non-bonded bead-bead forces calculated in " << rMsg.m_Precision << " precision";
+	if(rMsg.m_Precision != rMsg.m_Requested)
+	{
+		os << " (" << rMsg.m_Requested << " precision not available with a Verlet skin, bead radii or fewer than 3 CNT cells per dimension)";
+	}
+	os << "</Text>" << zEndl;
+	os << "</Body>" << zEndl;
+
+#elif EnableXMLCommands == SimXMLDisabled
+
+	// ASCII output 
+	os << "Non-bonded bead-bead forces calculated in " << rMsg.m_Precision << " precision";
+	if(rMsg.m_Precision != rMsg.m_Requested)
+	{
+		os << " (" << rMsg.m_Requested << " precision not available with a Verlet skin, bead radii or fewer than 3 CNT cells per dimension)";
+	}
+
+#endif
+
+	return os;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CLogSetForcePrecision::CLogSetForcePrecision(long time, const zString requested, 
+											 const zString used) : CLogConstraintMessage(time), 
+																   m_Requested(requested),
+																   m_Precision(used)
+{
+
+}
+
+CLogSetForcePrecision::~CLogSetForcePrecision()
+{
+
+}
+
+// Pure virtual function to allow the xxMessage-derived object to 
+// write its data to file when invoked through an xxMessage pointer. 
+
+void CLogSetForcePrecision::Serialize(zOutStream& os) const
+{
+	CLogConstraintMessage::Serialize(os);
+
+	os << (*this);
+}
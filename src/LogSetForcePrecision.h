@@ -0,0 +1,66 @@
+// LogSetForcePrecision.h: interface for the CLogSetForcePrecision class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETFORCEPRECISION_H__C73E0A92_1D5F_4B68_9A24_6E8B3F5D17C0__INCLUDED_)
+#define AFX_LOGSETFORCEPRECISION_H__C73E0A92_1D5F_4B68_9A24_6E8B3F5D17C0__INCLUDED_
+
+
+#include "LogConstraintMessage.h"
+
+class CLogSetForcePrecision : public CLogConstraintMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetForcePrecision(long time, const zString requested, const zString used);
+
+	virtual ~CLogSetForcePrecision();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetForcePrecision& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetForcePrecision(const CLogSetForcePrecision& oldMessage);
+	CLogSetForcePrecision& operator=(const CLogSetForcePrecision& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const zString m_Requested;	// Precision requested by the command
+	const zString m_Precision;	// Precision actually used for the non-bonded forces
+};
+
+
+#endif // !defined(AFX_LOGSETFORCEPRECISION_H__C73E0A92_1D5F_4B68_9A24_6E8B3F5D17C0__INCLUDED_)
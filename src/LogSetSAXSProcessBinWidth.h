@@ -0,0 +1,64 @@
+// LogSetSAXSProcessBinWidth.h: interface for the CLogSetSAXSProcessBinWidth class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETSAXSPROCESSBINWIDTH_H__fba3b3f4_7815_42f6_bb3d_0636d080c236__INCLUDED_)
+#define AFX_LOGSETSAXSPROCESSBINWIDTH_H__fba3b3f4_7815_42f6_bb3d_0636d080c236__INCLUDED_
+
+
+#include "LogInfoMessage.h" 
+
+class CLogSetSAXSProcessBinWidth : public CLogInfoMessage
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetSAXSProcessBinWidth(long time, const zString procName, double width);
+
+	virtual ~CLogSetSAXSProcessBinWidth();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetSAXSProcessBinWidth& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetSAXSProcessBinWidth(const CLogSetSAXSProcessBinWidth& oldMessage);
+	CLogSetSAXSProcessBinWidth& operator=(const CLogSetSAXSProcessBinWidth& rhs);
+
+	// ****************************************
+	// Data members
+private:
+
+    const zString m_ProcName;   // Name of the SAXS process being modifed
+	const double  m_BinWidth;   // Width of the pair distance histogram bins (0 for direct sum)
+};
+
+#endif // !defined(AFX_LOGSETSAXSPROCESSBINWIDTH_H__fba3b3f4_7815_42f6_bb3d_0636d080c236__INCLUDED_)
@@ -0,0 +1,65 @@
+// LogSetThreadTotal.h: interface for the CLogSetThreadTotal class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETTHREADTOTAL_H__D2A85F31_7C4E_4B96_8E03_A91B6C2F5E47__INCLUDED_)
+#define AFX_LOGSETTHREADTOTAL_H__D2A85F31_7C4E_4B96_8E03_A91B6C2F5E47__INCLUDED_
+
+
+#include "LogConstraintMessage.h"
+
+class CLogSetThreadTotal : public CLogConstraintMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetThreadTotal(long time, long threads);
+
+	virtual ~CLogSetThreadTotal();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetThreadTotal& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetThreadTotal(const CLogSetThreadTotal& oldMessage);
+	CLogSetThreadTotal& operator=(const CLogSetThreadTotal& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const long m_ThreadTotal;	// Number of threads used for the non-bonded forces
+};
+
+
+#endif // !defined(AFX_LOGSETTHREADTOTAL_H__D2A85F31_7C4E_4B96_8E03_A91B6C2F5E47__INCLUDED_)
@@ -0,0 +1,65 @@
+// LogSetVerletSkin.h: interface for the CLogSetVerletSkin class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETVERLETSKIN_H__3B7F0C92_E4A1_4D58_96C3_58D2F1A07B6E__INCLUDED_)
+#define AFX_LOGSETVERLETSKIN_H__3B7F0C92_E4A1_4D58_96C3_58D2F1A07B6E__INCLUDED_
+
+
+#include "LogConstraintMessage.h"
+
+class CLogSetVerletSkin : public CLogConstraintMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetVerletSkin(long time, double skin);
+
+	virtual ~CLogSetVerletSkin();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetVerletSkin& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetVerletSkin(const CLogSetVerletSkin& oldMessage);
+	CLogSetVerletSkin& operator=(const CLogSetVerletSkin& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const double m_Skin;	// Skin of the Verlet pair list for the non-bonded forces
+};
+
+
+#endif // !defined(AFX_LOGSETVERLETSKIN_H__3B7F0C92_E4A1_4D58_96C3_58D2F1A07B6E__INCLUDED_)
@@ -32,7 +32,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance. 
 
-CLogState* CLogState::m_pInstance = NULL;
+thread_local CLogState* CLogState::m_pInstance = NULL;
 
 
 // Static member function to add a newly-created message to the message sequence
@@ -55,7 +55,8 @@ void CLogState::StaticAddMessage(xxMessage* const pMsg)
 
 #if EnableXMLCommands == SimXMLEnabled
 
-CLogState::CLogState(const CInputData& rData) : xxState(xxBase::GetLSPrefix() + rData.GetRunId() + ".xml", true, 0, rData.GetRunId())
+CLogState::CLogState(const CInputData& rData) : xxState(xxBase::GetLSPrefix() + rData.GetRunId() + ".xml", true, 0, rData.GetRunId()),
+												m_MessageTotal(0)
 {
 	// First write the xml and stylesheet PIs: note that the version and
 	// stylesheet name are hardwired here.
@@ -72,7 +73,8 @@ CLogState::CLogState(const CInputData& rData) : xxState(xxBase::GetLSPrefix() +
 
 #elif EnableXMLCommands == SimXMLDisabled
 
-    CLogState::CLogState(const CInputData& rData) : xxState(xxBase::GetLSPrefix() + rData.GetRunId(), true, 0, rData.GetRunId())
+    CLogState::CLogState(const CInputData& rData) : xxState(xxBase::GetLSPrefix() + rData.GetRunId(), true, 0, rData.GetRunId()),
+													m_MessageTotal(0)
 {
 
 #endif
@@ -82,12 +84,14 @@ CLogState::CLogState(const CInputData& rData) : xxState(xxBase::GetLSPrefix() +
 
 	CLogState::m_pInstance = this;
 
+	// Message ids start at 1 for each simulation
+
+	xxMessage::StaticResetMessageIds();
+
 	// Create enough memory for the default number of messages. Any more and memory
 	// must be reallocated. Note that the unwritten message sequence holds the
-	// messages until they have been serialized when their pointers are removed.
-	// But we only delete the CLogMessage objects via the m_vMessages container.
+	// messages until they have been serialized, when they are deleted.
 
-	m_vMessages.reserve(1000);
 	m_vUnWrittenMessages.reserve(1000);
 
 }
@@ -121,20 +125,14 @@ CLogState::~CLogState()
 
 	m_pInstance = NULL;
 
-	// Delete created messages
+	// Delete any messages that could not be written
 
-	for(MessageIterator iterMsg=m_vMessages.begin(); iterMsg!=m_vMessages.end(); iterMsg++)
-	{
-		delete (*iterMsg);
-	}
-
-	m_vMessages.clear();
-	m_vUnWrittenMessages.clear();
+	DeleteUnWrittenMessages();
 }
 
 long CLogState::GetMessageTotal()
 {
-	return m_vMessages.size();
+	return m_MessageTotal;
 }
 
 long CLogState::GetUnWrittenMessageTotal()
@@ -145,9 +143,9 @@ long CLogState::GetUnWrittenMessageTotal()
 
 // Function to write out the logging messages to file. We iterate over the 
 // unwritten message container calling the CLogMessage::operator<<() for each 
-// one. Once a message has been serialized, we remove it from the container. 
-// Note that it is still held in the m_vMessages container until the CLogState
-// object is destroyed at the end of the simulation.
+// one. Once the messages have been serialized, we delete them and empty the
+// container, so that the memory used by the log does not grow with the length
+// of the run.
 //
 
 bool CLogState::Serialize()
@@ -161,7 +159,7 @@ bool CLogState::Serialize()
 				m_outStream << (**iterMsg);
 			}
 
-			m_vUnWrittenMessages.clear();
+			DeleteUnWrittenMessages();
 		}
 	}
 	else
@@ -196,7 +194,7 @@ bool CLogState::SerializeP()
 				    m_outStream << (**iterMsg);
 			    }
 
-			    m_vUnWrittenMessages.clear();
+			    DeleteUnWrittenMessages();
 		    }
 	    }
 	    else
@@ -208,7 +206,7 @@ bool CLogState::SerializeP()
 	
 	    // For now we ignore all messages from PN: we assume that any message that P0 writes to file applies to all PN as well.
 	
-	
+	    DeleteUnWrittenMessages();
 	
 	}
 
@@ -223,6 +221,19 @@ bool CLogState::SerializeP()
 
 void CLogState::AddMessage(xxMessage *const pMsg)
 {
-	m_vMessages.push_back(pMsg);
+	m_MessageTotal++;
 	m_vUnWrittenMessages.push_back(pMsg);
 }
+
+// Private function to delete the messages that are waiting to be written. It is
+// called once they have been written, and for messages that cannot be written.
+
+void CLogState::DeleteUnWrittenMessages()
+{
+	for(MessageIterator iterMsg=m_vUnWrittenMessages.begin(); iterMsg!=m_vUnWrittenMessages.end(); iterMsg++)
+	{
+		delete (*iterMsg);
+	}
+
+	m_vUnWrittenMessages.clear();
+}
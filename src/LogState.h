@@ -35,7 +35,7 @@ public:
 
 private:
 
-	static CLogState* m_pInstance;		// Pointer to single instance of CLogState class
+	static thread_local CLogState* m_pInstance;		// Pointer to single instance of CLogState class
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -76,12 +76,14 @@ private:
 
 	void AddMessage(xxMessage* const pMsg);
 
+	void DeleteUnWrittenMessages();
+
 
 	// ****************************************
 	// Data members
 private:
 
-	MessageSequence m_vMessages;			// Set of all messages
+	long            m_MessageTotal;			// Number of messages added
 	MessageSequence m_vUnWrittenMessages;	// Set of messages not yet serialized
 
 };
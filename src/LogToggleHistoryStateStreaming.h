@@ -0,0 +1,65 @@
+// LogToggleHistoryStateStreaming.h: interface for the CLogToggleHistoryStateStreaming class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGTOGGLEHISTORYSTATESTREAMING_H__3A6F8C25_E9D1_47B0_A2C8_5D04B7E9F31A__INCLUDED_)
+#define AFX_LOGTOGGLEHISTORYSTATESTREAMING_H__3A6F8C25_E9D1_47B0_A2C8_5D04B7E9F31A__INCLUDED_
+
+
+#include "LogInfoMessage.h"
+
+class CLogToggleHistoryStateStreaming : public CLogInfoMessage  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogToggleHistoryStateStreaming(long time, bool bStreaming);
+
+	virtual ~CLogToggleHistoryStateStreaming();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogToggleHistoryStateStreaming& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogToggleHistoryStateStreaming(const CLogToggleHistoryStateStreaming& oldMessage);
+	CLogToggleHistoryStateStreaming& operator=(const CLogToggleHistoryStateStreaming& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+	
+	const bool m_bStreaming;	// Flag showing whether the history state is streamed or not
+
+};
+
+#endif // !defined(AFX_LOGTOGGLEHISTORYSTATESTREAMING_H__3A6F8C25_E9D1_47B0_A2C8_5D04B7E9F31A__INCLUDED_)
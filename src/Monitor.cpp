@@ -87,6 +87,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "SimMathFlags.h"
 #include "SimAlgorithmFlags.h"
 #include "SimFunctionalFlags.h"
+#include "SimMiscellaneousFlags.h"
 #include "Bead.h"
 #include "Bond.h"
 #include "BondPair.h"
@@ -95,6 +96,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "CurrentState.h"
 #include "DensityState.h"
 #include "InclusiveRestartState.h"
+#include "BinaryRestartState.h"
+#include "BeadRange.h"
 #include "RestartState.h"
 #include "SimState.h"
 #include "ISimBox.h"
@@ -114,6 +117,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "PovrayFormat.h"
 #include "AmiraFormat.h"
 #include "ParaviewFormat.h"
+#include "BinaryTrajectoryState.h"
 #include "SolventFreeFormat.h"
 
 // Parallel code include files
@@ -148,6 +152,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // STL include files
 
+#include <thread>
+
 
 
 //////////////////////////////////////////////////////////////////////
@@ -155,7 +161,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance.
 
-CMonitor* CMonitor::m_pInstance = NULL;
+thread_local CMonitor* CMonitor::m_pInstance = NULL;
 
 // Public member function to create a single instance of the CMonitor class.
 
@@ -195,6 +201,7 @@ CMonitor::CMonitor(CSimState* const psState, const ISimBox* const pISimBox) : IS
 													   m_UpperStressSliceRem(0.0),
 													   m_StressSliceWidth(0.0),
 													   m_invSliceWidth(0.0),
+													   m_bSliceStressOn(false),
 													   m_FixedObservableNo(0),
 													   m_RunCompleteInterval(0),
 													   m_MinXFraction(0.0),
@@ -211,7 +218,13 @@ CMonitor::CMonitor(CSimState* const psState, const ISimBox* const pISimBox) : IS
 													   m_bEnergyOutput(false),
 													   m_bLogRestartWarningMessages(false),
 													   m_bNormalizePerBead(false),
-                                                       m_bInclusiveRestartStates(true)
+                                                       m_bInclusiveRestartStates(true),
+                                                       m_bBinaryRestartStates(false),
+													   m_BeadGridKernel(psState->GetGridXCellNo(), psState->GetGridYCellNo(), psState->GetGridZCellNo(),
+																		psState->GetSimBoxXLength()/static_cast<double>(psState->GetGridXCellNo()),
+																		psState->GetSimBoxYLength()/static_cast<double>(psState->GetGridYCellNo()),
+																		psState->GetSimBoxZLength()/static_cast<double>(psState->GetGridZCellNo())),
+													   m_pTrajectory(0)
 
 {
 
@@ -246,6 +259,12 @@ CMonitor::CMonitor(CSimState* const psState, const ISimBox* const pISimBox) : IS
 	m_GridYCellWidth = m_SimBoxYLength/static_cast<double>(m_GridYCellNo);
 	m_GridZCellWidth = m_SimBoxZLength/static_cast<double>(m_GridZCellNo);
 
+	// The global bead observables and the bead density grid are accumulated 
+	// in the single sampling pass over the beads
+
+	m_vSampleKernels.push_back(&m_SingleBeadKernel);
+	m_vSampleKernels.push_back(&m_BeadGridKernel);
+
 	// **************************************************
 	// Set the vector of numbers of bead of each type initially to zero.
 	// This is important because the copy algorithm does not increase the
@@ -271,8 +290,8 @@ CMonitor::CMonitor(CSimState* const psState, const ISimBox* const pISimBox) : IS
 
 	CCurrentState::ClearBeadDisplayIdMap();
 
-	AbstractBeadVector vAllBeads = GetSimBoxBeads();
-	for(cAbstractBeadVectorIterator citerBead=vAllBeads.begin(); citerBead!=vAllBeads.end(); citerBead++)
+	const CBeadRange vAllBeads = GetSimBoxBeadRange();
+	for(CBeadRange::const_iterator citerBead=vAllBeads.begin(); citerBead!=vAllBeads.end(); citerBead++)
 	{
 		CCurrentState::SetBeadDisplayId((*citerBead)->GetId(), (*citerBead)->GetType());
 	}
@@ -697,7 +716,27 @@ CMonitor::~CMonitor()
 		m_DensityFields.clear();
 	}
 
+#if EnableAsyncStateWriter == SimMiscEnabled
+
+	// Wait for the current state snapshots still being written in the 
+	// background so that any that failed are reported
+
+	m_StateWriter.Stop();
+
+	ReportFailedStateWrites();
+
+#endif
 
+	// Write the frame index to the binary trajectory if one was created
+
+	if(m_pTrajectory)
+	{
+		if(!m_pTrajectory->Serialize())
+			ErrorTrace("Error in CMonitor::~CMonitor: binary trajectory index not written");
+
+		delete m_pTrajectory;
+		m_pTrajectory = 0;
+	}
 }
 
 // Function to calculate observables that depend only on properties of independent polymers.
@@ -777,6 +816,93 @@ void CMonitor::CalculateSinglePolymerData()
 }
 
 
+// Function to add an observable to the sampling pass over the beads. The 
+// CMonitor does not own the kernel: it must be removed before it is destroyed.
+
+void CMonitor::AddSampleKernel(ISampleKernel* const pKernel)
+{
+	if(find(m_vSampleKernels.begin(), m_vSampleKernels.end(), pKernel) == m_vSampleKernels.end())
+	{
+		m_vSampleKernels.push_back(pKernel);
+	}
+}
+
+void CMonitor::RemoveSampleKernel(ISampleKernel* const pKernel)
+{
+	m_vSampleKernels.erase(remove(m_vSampleKernels.begin(), m_vSampleKernels.end(), pKernel), m_vSampleKernels.end());
+}
+
+// Private function to visit every bead in the SimBox once and pass it to all
+// the sample kernels. The beads are visited in CNT cell order directly from the
+// cells' bead lists. If more than one thread is set for the non-bonded forces,
+// the CNT cells are divided into contiguous blocks that are sampled in parallel,
+// with the calling thread taking the first block; each kernel keeps separate 
+// sums for each thread and combines them in thread order. With a single 
+// thread, the beads are summed in the same order as before.
+
+void CMonitor::RunSampleKernels()
+{
+	const long cellTotal   = GetSimBoxCells().size();
+	const long threadTotal = std::max(1L, std::min(m_pSimState->GetThreadTotal(), cellTotal));
+
+	m_SingleBeadKernel.SetBeadTypeTotal(m_BeadTypeSize);
+	m_BeadGridKernel.SetBeadTypeTotal(m_BeadTypeSize);
+
+	for(std::vector<ISampleKernel*>::iterator iterKernel=m_vSampleKernels.begin(); iterKernel!=m_vSampleKernels.end(); iterKernel++)
+	{
+		(*iterKernel)->StartSample(threadTotal);
+	}
+
+	if(threadTotal == 1)
+	{
+		SampleKernelCells(0, 0, cellTotal);
+	}
+	else
+	{
+		std::vector<std::thread> vThreads;
+
+		for(long thread=1; thread<threadTotal; thread++)
+		{
+			vThreads.push_back(std::thread(&CMonitor::SampleKernelCells, this, thread, (thread*cellTotal)/threadTotal, ((thread+1)*cellTotal)/threadTotal));
+		}
+
+		SampleKernelCells(0, 0, cellTotal/threadTotal);
+
+		for(std::vector<std::thread>::iterator iterThread=vThreads.begin(); iterThread!=vThreads.end(); iterThread++)
+		{
+			iterThread->join();
+		}
+	}
+
+	for(std::vector<ISampleKernel*>::iterator iterKernel=m_vSampleKernels.begin(); iterKernel!=m_vSampleKernels.end(); iterKernel++)
+	{
+		(*iterKernel)->EndSample();
+	}
+}
+
+// Private function to pass the beads in a block of CNT cells to all the sample
+// kernels on behalf of one thread.
+
+void CMonitor::SampleKernelCells(long thread, long firstCell, long lastCell)
+{
+	const CNTCellVector& rvCells = GetSimBoxCells();
+
+	const long kernelTotal = m_vSampleKernels.size();
+
+	for(long cell=firstCell; cell<lastCell; cell++)
+	{
+		const BeadList& rlBeads = rvCells[cell]->GetBeadList();
+
+		for(cBeadListIterator iterBead=rlBeads.begin(); iterBead!=rlBeads.end(); iterBead++)
+		{
+			for(long kernel=0; kernel<kernelTotal; kernel++)
+			{
+				m_vSampleKernels[kernel]->SampleBead(thread, *iterBead);
+			}
+		}
+	}
+}
+
 // Function to calculate observables that depend only on properties of independent beads.
 //
 // Current observables are:	Temperature
@@ -786,124 +912,55 @@ void CMonitor::CalculateSinglePolymerData()
 //							Stress tensor (diagonal elements only)
 //							Inertia tensor
 //
+// The sums over all beads of the distance moved, centre of mass position, 
+// total momentum, total angular momentum, stress and inertia tensors, and the
+// bead counts in the analysis grid, have been accumulated by the sample kernels 
+// in RunSampleKernels(). Here we calculate the temperature and pressure, and
+// normalise the other observables.
 
 void CMonitor::CalculateSingleBeadData()
 {
-	// Zero observables before performing sums over all beads
-
 	m_meanTemp		= 0.0;
 	m_meanPress		= 0.0;	// this holds the NkT term in the virial
 
 	for(short int i=0; i<3; i++)	
 	{
-		m_cmPos[i]				    = 0.0;	// Centre of Mass location
-		m_cmMom[i]				    = 0.0;	// Centre of Mass momentum
-		m_totalSqMom[i]			    = 0.0;	// Total bead squared momentum
-		m_totalAngMom[i]		    = 0.0;  // Total bead angular momentum
-		m_totalStress[3*i]		    = 0.0;	// these hold the r.F terms in the virial
-		m_totalStress[3*i+1]	    = 0.0;
-		m_totalStress[3*i+2]	    = 0.0;
+		m_cmPos[i]				    = m_SingleBeadKernel.GetCMPos()[i];			// Centre of Mass location
+		m_cmMom[i]				    = m_SingleBeadKernel.GetCMMom()[i];			// Centre of Mass momentum
+		m_totalSqMom[i]			    = m_SingleBeadKernel.GetTotalSqMom()[i];	// Total bead squared momentum
+		m_totalAngMom[i]		    = m_SingleBeadKernel.GetTotalAngMom()[i];	// Total bead angular momentum
 		m_totalStressSphere[3*i]	= 0.0;	// these hold the r.F terms in the virial calculated using curvilinear coords
 		m_totalStressSphere[3*i+1]	= 0.0;
 		m_totalStressSphere[3*i+2]	= 0.0;
-		m_totalInertia[3*i]		    = 0.0;	
-		m_totalInertia[3*i+1]	    = 0.0;
-		m_totalInertia[3*i+2]	    = 0.0;
 	}
 
-	// Zero the vector holding the MSD for each bead type
-
-	for(zDoubleVectorIterator iter=m_vBeadMSD.begin(); iter!=m_vBeadMSD.end(); iter++)
+	for(short int j=0; j<9; j++)
 	{
-		(*iter) = 0.0;
+		m_totalStress[j]  = m_SingleBeadKernel.GetTotalStress()[j];		// these hold the r.F terms in the virial
+		m_totalInertia[j] = m_SingleBeadKernel.GetTotalInertia()[j];
 	}
 
-	// loop over all beads and calculate distance moved, centre of mass position,
-	// total momentum, total angular momentum and average kinetic energy. Then 
-	// calculate the temperature, pressure and the stress and inertia tensors
-
-	double dPos[3];
-	double magPos;
-
-	AbstractBeadVector vAllBeads = GetSimBoxBeads();
-	for(AbstractBeadVectorIterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
+	for(long type=0; type<m_BeadTypeSize; type++)
 	{
-		// We must use the un-periodic boundary positions for the diffusion coefficient
-		// calculation
-
-		dPos[0]	=  (*iterBead)->m_unPBCPos[0] - (*iterBead)->m_InitialPos[0];
-		dPos[1]	=  (*iterBead)->m_unPBCPos[1] - (*iterBead)->m_InitialPos[1];
-		dPos[2]	=  (*iterBead)->m_unPBCPos[2] - (*iterBead)->m_InitialPos[2];
-		magPos	= dPos[0]*dPos[0] + dPos[1]*dPos[1] + dPos[2]*dPos[2];
-
-		m_vBeadMSD.at((*iterBead)->GetType()) += magPos;
-
-		m_cmPos[0]	+= (*iterBead)->m_Pos[0];
-		m_cmPos[1]	+= (*iterBead)->m_Pos[1];
-		m_cmPos[2]	+= (*iterBead)->m_Pos[2];
-
-		m_cmMom[0] += (*iterBead)->m_Mom[0];
-		m_cmMom[1] += (*iterBead)->m_Mom[1];
-		m_cmMom[2] += (*iterBead)->m_Mom[2];
-
-		m_totalSqMom[0] += (*iterBead)->m_Mom[0]*(*iterBead)->m_Mom[0];
-		m_totalSqMom[1] += (*iterBead)->m_Mom[1]*(*iterBead)->m_Mom[1];
-		m_totalSqMom[2] += (*iterBead)->m_Mom[2]*(*iterBead)->m_Mom[2];
-
-		m_totalAngMom[0] +=  (*iterBead)->m_Pos[1]*(*iterBead)->m_Mom[2] - (*iterBead)->m_Pos[2]*(*iterBead)->m_Mom[1];
-		m_totalAngMom[1] += -(*iterBead)->m_Pos[0]*(*iterBead)->m_Mom[2] + (*iterBead)->m_Pos[2]*(*iterBead)->m_Mom[0];
-		m_totalAngMom[2] +=  (*iterBead)->m_Pos[0]*(*iterBead)->m_Mom[1] - (*iterBead)->m_Pos[1]*(*iterBead)->m_Mom[0];
+		m_vBeadMSD.at(type) = m_SingleBeadKernel.GetBeadMSD().at(type);
+	}
 
-#if SimDimension == 2
+	// Add the number of beads of each type in the grid cells covering the
+	// simulation box to the density fields. We use the fact that the CObservable
+	// objects are stored in the same order as the bead types to access the 
+	// correct observable for each type of bead
 
-		m_totalStress[0] += (*iterBead)->m_Stress[0];
-		m_totalStress[1] += (*iterBead)->m_Stress[1];
-		m_totalStress[3] += (*iterBead)->m_Stress[3];
-		m_totalStress[4] += (*iterBead)->m_Stress[4];
+	const long gridCellTotal = m_BeadGridKernel.GetGridCellTotal();
+	const zDoubleVector& rvCounts = m_BeadGridKernel.GetCounts();
 
-#elif SimDimension == 3
+	for(long type=0; type<m_BeadTypeSize; type++)
+	{
+		zDoubleVector& rvField = m_vGridObservables.at(type)->m_vField;
 
-		for(short int i=0; i<9; i++)
+		for(long index=0; index<gridCellTotal; index++)
 		{
-			m_totalStress[i] += (*iterBead)->m_Stress[i];
+			rvField.at(index) += rvCounts[type*gridCellTotal + index];
 		}
-
-		m_totalInertia[0] +=	(*iterBead)->m_Pos[1]*(*iterBead)->m_Pos[1] +
-							    (*iterBead)->m_Pos[2]*(*iterBead)->m_Pos[2];
-
-		m_totalInertia[1] +=	-(*iterBead)->m_Pos[0]*(*iterBead)->m_Pos[1];
-
-		m_totalInertia[2] +=	-(*iterBead)->m_Pos[0]*(*iterBead)->m_Pos[2];
-
-		m_totalInertia[4] +=	(*iterBead)->m_Pos[0]*(*iterBead)->m_Pos[0] +
-							    (*iterBead)->m_Pos[2]*(*iterBead)->m_Pos[2];
-
-		m_totalInertia[5] +=	-(*iterBead)->m_Pos[1]*(*iterBead)->m_Pos[2];
-
-		m_totalInertia[8] +=	(*iterBead)->m_Pos[0]*(*iterBead)->m_Pos[0] +
-							    (*iterBead)->m_Pos[1]*(*iterBead)->m_Pos[1];
-
-#endif
-
-		// Count the number of beads of each type in the grid cells covering the
-		// simulation box. Note that the iz index is calculated within the
-		// conditionally-compiled sections of code immediately above here.
-		// We use the fact that the  CObservable objects are stored in the 
-		// same order as the bead types to access the correct observable
-		// for each type of bead
-
-		long ix = static_cast<long>((*iterBead)->m_Pos[0]/m_GridXCellWidth);
-		long iy = static_cast<long>((*iterBead)->m_Pos[1]/m_GridYCellWidth);
-
-#if SimDimension == 2
-		long iz = 0;	
-#elif SimDimension == 3
-		long iz = static_cast<long>((*iterBead)->m_Pos[2]/m_GridZCellWidth);	
-#endif
-
-		long index = m_GridXCellNo*(m_GridYCellNo*iz+iy) + ix;
-
-		m_vGridObservables.at((*iterBead)->GetType())->m_vField.at(index) += 1.0;
 	}
 
 	// Normalize all observables according to the dimension of the simulation.
@@ -1276,6 +1333,11 @@ void CMonitor::Sample()
 {
 	m_SamplesTaken++;					// increment sample counter
 
+	// Visit all beads once, passing them to the observables that accumulate
+	// data from every bead, then calculate the observables from the sums
+
+	RunSampleKernels();
+
 	CalculateSingleBeadData();
 
 	if(m_pSimState->GetBondTotal() > 0)	     // only calculate bond averages if they exist
@@ -1287,7 +1349,12 @@ void CMonitor::Sample()
 	CalculateSinglePolymerData();
 	
 	// Combine previous global analysis with a search for mesoscopic
-	// aggregates such as micelles, bilayers, vesicles etc.
+	// aggregates such as micelles, bilayers, vesicles etc. If any of them 
+	// use the stress profile, the bead-bead contributions accumulated during 
+	// this time step are first collected from the force threads' buffers.
+
+	if(m_bSliceStressOn)
+		ReduceSliceStress();
 
 	FindAggregates();
 
@@ -1442,12 +1509,19 @@ void CMonitor::SaveNonBeadInclusiveRestartState() const
 // that only writes out data. We get the current simulation time from 
 // the ISimBox as the sample period of the monitor, which is used to increment 
 // its time, may not be commensurate with the period of the restart state.
-// The default type of restart state (coordinates only or inclusive) is set in the
-// constructor and may be changed by command.
+// The default type of restart state (coordinates only, inclusive or binary) is set
+// in the constructor and may be changed by command. Restart states are always 
+// written on the simulation thread, not by the CAsyncStateWriter.
 
 void CMonitor::SaveRestartState() const
 {
-    if(m_bInclusiveRestartStates)
+    if(m_bBinaryRestartStates)
+    {
+	    CBinaryRestartState rState(GetCurrentTime(), GetRunId(), GetISimBox(), m_pSimState->GetInitialState());
+	    if(!rState.Serialize())
+		    ErrorTrace("Error in CMonitor::SaveRestartState: binary restart state failed");	
+    }
+    else if(m_bInclusiveRestartStates)
     {
 	    CInclusiveRestartState rState(GetCurrentTime(), GetRunId(), true, m_bLogRestartWarningMessages, GetISimBox(), &m_pSimState->GetAnalysisState(), m_pSimState->GetInitialState());
 	    if(!rState.Serialize())
@@ -1485,9 +1559,30 @@ void CMonitor::SaveRestartState() const
 // displayed as their visibility flag is toggled off. However, beads that are
 // assembled into targets can have their visibility changed according to the target's
 // display state instead of their type.
+//
+// The BinaryTrajectory format does not create a CCurrentState: each snapshot
+// is appended as a frame to a single trajectory file that stays open for the
+// rest of the run. These frames are not kept for analysis.
 
 void CMonitor::SaveCurrentState()
 {
+	if( m_DefaultCurrentStateFormat == "BinaryTrajectory" )
+	{
+		if(!m_pTrajectory)
+		{
+			m_pTrajectory = new CBinaryTrajectoryState(GetRunId(), GetISimBox());
+		}
+
+		if(!m_pTrajectory->AddFrame(GetCurrentTime(), m_bRestrictCurrentStateCoords,
+									m_MinXFraction, m_MinYFraction, m_MinZFraction,
+									m_MaxXFraction, m_MaxYFraction, m_MaxZFraction))
+		{
+			ErrorTrace("Error in CMonitor::SaveCurrentState BinaryTrajectory");
+		}
+
+		return;
+	}
+
 	// Replace the constructor call with the factory pattern that returns a new
 	// format object
 
@@ -1552,6 +1647,26 @@ void CMonitor::SaveCurrentState()
 											   m_MinXFraction, m_MinYFraction, m_MinZFraction,
 											   m_MaxXFraction, m_MaxYFraction, m_MaxZFraction);
 
+#if EnableAsyncStateWriter == SimMiscEnabled
+
+	// If the snapshot is not kept for analysis, and its format only needs the 
+	// bead data, we copy the data and let the writer thread format and write 
+	// the file while the simulation continues. The writer deletes the state.
+
+	if(!m_bCurrentStateAnalysis && pcState->CanSnapshot())
+	{
+		CAsyncStateWriter::Buffer* const pBuffer = m_StateWriter.AcquireBuffer();
+
+		pcState->TakeSnapshot(pBuffer);
+
+		m_StateWriter.Submit(pcState, pBuffer);
+
+		ReportFailedStateWrites();
+		return;
+	}
+
+#endif
+
 	if(!pcState->Serialize())
 	{
 		ErrorTrace("Error in CMonitor::SaveCurrentState");
@@ -1567,6 +1682,20 @@ void CMonitor::SaveCurrentState()
 	}
 }
 
+// Private function to report the current state snapshots that the background
+// writer has failed to write since the last check. It is called on the 
+// simulation thread because the writer thread must not create log messages.
+
+void CMonitor::ReportFailedStateWrites()
+{
+	const long failedTotal = m_StateWriter.TakeFailedTotal();
+
+	if(failedTotal > 0)
+	{
+		ErrorTrace("Error in CMonitor::SaveCurrentState: " + ToString(failedTotal) + " current state snapshot(s) not written");
+	}
+}
+
 // Parallel version of the SaveCurrentState function that allows all PN to send their
 // bead coordinates to P0 so that it can write them to file. Recall that we only allow
 // P0 to do file IO. Also note that if the EnableParallelMonitor flag is not set, no
@@ -1656,8 +1785,8 @@ void CMonitor::SaveCurrentStateP()
         // we shift bead coordinates into the whole simulation Space 
         // before sending them to P0 inside the message's AddBead() function.
 
-		AbstractBeadVector vAllBeads = GetISimBox()->GetBeads();
-	    for(cAbstractBeadVectorIterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
+		const CBeadRange vAllBeads = GetISimBox()->GetBeadRange();
+	    for(CBeadRange::const_iterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
         {
             pCS->AddBead(*iterBead);
         }
@@ -1708,7 +1837,8 @@ void CMonitor::SavePrevisCurrentState()
 // other programs. 
 //
 // Each set of grid data is saved to a separate CDensityState object and serialized
-// to its own file in the same format.
+// to its own file in the same format. The states are kept for analysis, so they
+// are written here rather than by the CAsyncStateWriter.
 
 void CMonitor::SaveDensityStates()
 {
@@ -1733,7 +1863,8 @@ void CMonitor::SaveDensityStates()
 // We create a CTimeSeriesData object, fill it with data from the current simulation
 // state and pass it to the CHistoryState object. Note that the CTimeSeriesData
 // objects are destroyed by the CHistoryState object as it maintains a vector of 
-// them for doing time-based analysis at the end of the simulation.
+// them for doing time-based analysis at the end of the simulation. If the history
+// state is streamed, it deletes them as soon as they have been written.
 //
 // Observables saved
 // *****************
@@ -1882,22 +2013,42 @@ void CMonitor::SaveAggregateState() const
 }
 
 // Function used by the CCNTCell class to pass the bead-bead contributions to
-// the stress tensor for analysis. We check the special cases for the two bead Z 
+// the stress tensor for analysis. The contributions are only needed on the
+// sampling steps of an aggregate analysis that uses the stress profile, so
+// the function returns immediately on other time steps. Otherwise, the 
+// contribution is added to the first thread's buffer: see the overloaded 
+// function below.
+
+void CMonitor::AddBeadStress(const CAbstractBead* const pBead1, const CAbstractBead* const pBead2, const double force[3], const double dx[3])
+{
+	if(m_bSliceStressOn)
+	{
+		AddBeadStress(&m_vvBeadStressBuffer[0][0], pBead1->GetType(), pBead2->GetType(), pBead1->m_Pos[2], pBead2->m_Pos[2], force, dx);
+	}
+}
+
+// Function to add the contribution from a pair of interacting beads to a flat 
+// buffer of slice stress data. We check the special cases for the two bead Z 
 // coordinates, and adjust the f(z1,z2,zs) factor according to the results in 
 // Appendix B of Goetz and Lipowsky, 1998.
 //
-// The data are stored in a set of 9 vectors using an index created from the bead types. 
-// We store the inverse distance that is used to calculate the approximate number of 
-// analysis slices between the two beads in the appropriate normal direction to avoid 
-// having to do 9 divisions.
+// The data are stored in the buffer using an index created from the slice, 
+// the bead types and the tensor component, and are copied into the 9 arrays 
+// used by the analysis in ReduceSliceStress(). We store the inverse distance
+// that is used to calculate the approximate number of analysis slices between
+// the two beads in the appropriate normal direction to avoid having to do 9 
+// divisions.
 //
-// Because we form a running sum of the stress contributions, the ZeroSliceStress() 
-// function must be called before the first call of AddBeadStress() for each time-step.
+// The function only uses local variables, so it may be called concurrently 
+// by several threads as long as each thread writes to its own buffer.
+//
+// Because we form a running sum of the stress contributions, the buffers 
+// must be zeroed before the first call of AddBeadStress() for each time-step.
 //
 // The function is currently hard-wired for z-axis slices only.
 //
 
-void CMonitor::AddBeadStress(const CAbstractBead* const pBead1, const CAbstractBead* const pBead2, const double force[3], const double dx[3])
+void CMonitor::AddBeadStress(double* const pSliceStress, long type1, long type2, double z1, double z2, const double force[3], const double dx[3]) const
 {
 	// Calculate the f(z1, z2, zs) factors that determine how much the bead interaction
 	// contributes to each slice zs noting that more than one slice may be involved.
@@ -1919,92 +2070,72 @@ void CMonitor::AddBeadStress(const CAbstractBead* const pBead1, const CAbstractB
 	// That problem affects the component of the actual stress tensor not the matrix
 	// of contributions from the different bead-bead types.
 
-	const long stressTypeIndex = pBead1->GetType()*m_BeadTypeSize + pBead2->GetType();
+	const long stressTypeIndex = type1*m_BeadTypeSize + type2;
 
 	// Store the product of force*distance for the current interaction. Note that 
 	// because the force is central it does not change sign under reversal of the
 	// order of the two bead indices. We do not need a minus sign because we have
 	// already converted to force from the gradient of the potential.
 	
-	m_fdx[0] = force[0]*dx[0];
-	m_fdx[1] = force[0]*dx[1];
-	m_fdx[2] = force[0]*dx[2];
-	m_fdx[3] = force[1]*dx[0];
-	m_fdx[4] = force[1]*dx[1];
-	m_fdx[5] = force[1]*dx[2];
-	m_fdx[6] = force[2]*dx[0];
-	m_fdx[7] = force[2]*dx[1];
-	m_fdx[8] = force[2]*dx[2];
+	double fdx[9];
+
+	fdx[0] = force[0]*dx[0];
+	fdx[1] = force[0]*dx[1];
+	fdx[2] = force[0]*dx[2];
+	fdx[3] = force[1]*dx[0];
+	fdx[4] = force[1]*dx[1];
+	fdx[5] = force[1]*dx[2];
+	fdx[6] = force[2]*dx[0];
+	fdx[7] = force[2]*dx[1];
+	fdx[8] = force[2]*dx[2];
 
 	double zDiff = dx[2];
+	double upperSliceCoord;
+	double lowerSliceCoord;
 
 	if(zDiff > 0.00001)			// Bead 1 above 2
 	{
-		m_UpperStressSliceCoord = pBead1->m_Pos[2]*m_invSliceWidth;
-		m_LowerStressSliceCoord = pBead2->m_Pos[2]*m_invSliceWidth;
+		upperSliceCoord = z1*m_invSliceWidth;
+		lowerSliceCoord = z2*m_invSliceWidth;
 	}
 	else if(zDiff < -0.00001)	// Bead 2 above 1
 	{
 		zDiff = -zDiff;	// Change sign so that calculation of f() uses a positive distance
-		m_UpperStressSliceCoord = pBead2->m_Pos[2]*m_invSliceWidth;
-		m_LowerStressSliceCoord = pBead1->m_Pos[2]*m_invSliceWidth;
+		upperSliceCoord = z2*m_invSliceWidth;
+		lowerSliceCoord = z1*m_invSliceWidth;
 	}
 	else
 	{
-		m_UpperStressSliceCoord = pBead1->m_Pos[2]*m_invSliceWidth;
-		m_LowerStressSliceCoord = m_UpperStressSliceCoord;
+		upperSliceCoord = z1*m_invSliceWidth;
+		lowerSliceCoord = upperSliceCoord;
 	}
 
-	m_UpperStressSliceIndex = static_cast<long>(m_UpperStressSliceCoord);
-	m_UpperStressSliceRem   = m_UpperStressSliceCoord - static_cast<double>(m_UpperStressSliceIndex);
+	const long   upperSliceIndex = static_cast<long>(upperSliceCoord);
+	const double upperSliceRem   = upperSliceCoord - static_cast<double>(upperSliceIndex);
 
-	m_LowerStressSliceIndex = static_cast<long>(m_LowerStressSliceCoord);
-	m_LowerStressSliceRem   = m_LowerStressSliceCoord - static_cast<double>(m_LowerStressSliceIndex);
+	long         lowerSliceIndex = static_cast<long>(lowerSliceCoord);
+	const double lowerSliceRem   = lowerSliceCoord - static_cast<double>(lowerSliceIndex);
 
 	// The next case takes care of coincident and non-coincident beads within a slice and
 	// those coincident on a slice border.
 
-	if(m_UpperStressSliceIndex == m_LowerStressSliceIndex)	// Beads in same slice: assign f() = 1
+	if(upperSliceIndex == lowerSliceIndex)	// Beads in same slice: assign f() = 1
 	{
-		if(m_UpperStressSliceCoord != m_LowerStressSliceCoord ||
-		   m_UpperStressSliceRem > 0.00001)				// Beads not coincident or not on border
+		if(upperSliceCoord != lowerSliceCoord ||
+		   upperSliceRem > 0.00001)				// Beads not coincident or not on border
 		{
-			m_vvSliceStress11.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[0];
-			m_vvSliceStress12.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[1];
-			m_vvSliceStress13.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[2];
-			m_vvSliceStress21.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[3];
-			m_vvSliceStress22.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[4];
-			m_vvSliceStress23.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[5];
-			m_vvSliceStress31.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[6];
-			m_vvSliceStress32.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[7];
-			m_vvSliceStress33.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[8];
+			AddSliceStressTerm(pSliceStress, lowerSliceIndex, stressTypeIndex, fdx, 1.0);
 		}
 		else	// Beads coincident on a slice border: assign f() = 0.5 to each slice
 		{
-			m_vvSliceStress11.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[0]*0.5;
-			m_vvSliceStress12.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[1]*0.5;
-			m_vvSliceStress13.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[2]*0.5;
-			m_vvSliceStress21.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[3]*0.5;
-			m_vvSliceStress22.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[4]*0.5;
-			m_vvSliceStress23.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[5]*0.5;
-			m_vvSliceStress31.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[6]*0.5;
-			m_vvSliceStress32.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[7]*0.5;
-			m_vvSliceStress33.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[8]*0.5;
+			AddSliceStressTerm(pSliceStress, upperSliceIndex, stressTypeIndex, fdx, 0.5);
 
 			// Check the pbcs for the slice beneath the one on whose border the two beads lie
 
-			if(--m_LowerStressSliceIndex < 0)
-				m_LowerStressSliceIndex += m_StressSliceTotal;
+			if(--lowerSliceIndex < 0)
+				lowerSliceIndex += m_StressSliceTotal;
 
-			m_vvSliceStress11.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[0]*0.5;
-			m_vvSliceStress12.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[1]*0.5;
-			m_vvSliceStress13.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[2]*0.5;
-			m_vvSliceStress21.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[3]*0.5;
-			m_vvSliceStress22.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[4]*0.5;
-			m_vvSliceStress23.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[5]*0.5;
-			m_vvSliceStress31.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[6]*0.5;
-			m_vvSliceStress32.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[7]*0.5;
-			m_vvSliceStress33.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[8]*0.5;
+			AddSliceStressTerm(pSliceStress, lowerSliceIndex, stressTypeIndex, fdx, 0.5);
 		}
 	}
 	else	// Multiple slices: f() = Slice width/zDiff for all inner slices and 
@@ -2025,89 +2156,103 @@ void CMonitor::AddBeadStress(const CAbstractBead* const pBead1, const CAbstractB
 
 		const double innerInvComp = m_StressSliceWidth/zDiff;
 
-		if(m_UpperStressSliceIndex > m_LowerStressSliceIndex)
+		if(upperSliceIndex > lowerSliceIndex)
 		{
-			for(long sliceIndex=m_LowerStressSliceIndex+1; sliceIndex<=m_UpperStressSliceIndex-1; sliceIndex++)
+			for(long sliceIndex=lowerSliceIndex+1; sliceIndex<=upperSliceIndex-1; sliceIndex++)
 			{
-				m_vvSliceStress11.at(sliceIndex).at(stressTypeIndex) += m_fdx[0]*innerInvComp;
-				m_vvSliceStress12.at(sliceIndex).at(stressTypeIndex) += m_fdx[1]*innerInvComp;
-				m_vvSliceStress13.at(sliceIndex).at(stressTypeIndex) += m_fdx[2]*innerInvComp;
-				m_vvSliceStress21.at(sliceIndex).at(stressTypeIndex) += m_fdx[3]*innerInvComp;
-				m_vvSliceStress22.at(sliceIndex).at(stressTypeIndex) += m_fdx[4]*innerInvComp;
-				m_vvSliceStress23.at(sliceIndex).at(stressTypeIndex) += m_fdx[5]*innerInvComp;
-				m_vvSliceStress31.at(sliceIndex).at(stressTypeIndex) += m_fdx[6]*innerInvComp;
-				m_vvSliceStress32.at(sliceIndex).at(stressTypeIndex) += m_fdx[7]*innerInvComp;
-				m_vvSliceStress33.at(sliceIndex).at(stressTypeIndex) += m_fdx[8]*innerInvComp;
+				AddSliceStressTerm(pSliceStress, sliceIndex, stressTypeIndex, fdx, innerInvComp);
 			}
 		}
 		else
 		{
-			for(long sliceIndexPBC=m_LowerStressSliceIndex+1; sliceIndexPBC<=m_StressSliceTotal+m_UpperStressSliceIndex-1; sliceIndexPBC++)
+			for(long sliceIndexPBC=lowerSliceIndex+1; sliceIndexPBC<=m_StressSliceTotal+upperSliceIndex-1; sliceIndexPBC++)
 			{
 				long sliceIndex = sliceIndexPBC;
 
 				if(sliceIndex >= m_StressSliceTotal)
 					sliceIndex -= m_StressSliceTotal;
 
-				m_vvSliceStress11.at(sliceIndex).at(stressTypeIndex) += m_fdx[0]*innerInvComp;
-				m_vvSliceStress12.at(sliceIndex).at(stressTypeIndex) += m_fdx[1]*innerInvComp;
-				m_vvSliceStress13.at(sliceIndex).at(stressTypeIndex) += m_fdx[2]*innerInvComp;
-				m_vvSliceStress21.at(sliceIndex).at(stressTypeIndex) += m_fdx[3]*innerInvComp;
-				m_vvSliceStress22.at(sliceIndex).at(stressTypeIndex) += m_fdx[4]*innerInvComp;
-				m_vvSliceStress23.at(sliceIndex).at(stressTypeIndex) += m_fdx[5]*innerInvComp;
-				m_vvSliceStress31.at(sliceIndex).at(stressTypeIndex) += m_fdx[6]*innerInvComp;
-				m_vvSliceStress32.at(sliceIndex).at(stressTypeIndex) += m_fdx[7]*innerInvComp;
-				m_vvSliceStress33.at(sliceIndex).at(stressTypeIndex) += m_fdx[8]*innerInvComp;
+				AddSliceStressTerm(pSliceStress, sliceIndex, stressTypeIndex, fdx, innerInvComp);
 			}
 		}
 
-		if(m_LowerStressSliceRem > 0.000001)	// Lower bead not on slice border
+		if(lowerSliceRem > 0.000001)	// Lower bead not on slice border
 		{
-			const double lowerInvComp = (1.0 - m_LowerStressSliceRem)*innerInvComp;
-			m_vvSliceStress11.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[0]*lowerInvComp;
-			m_vvSliceStress12.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[1]*lowerInvComp;
-			m_vvSliceStress13.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[2]*lowerInvComp;
-			m_vvSliceStress21.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[3]*lowerInvComp;
-			m_vvSliceStress22.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[4]*lowerInvComp;
-			m_vvSliceStress23.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[5]*lowerInvComp;
-			m_vvSliceStress31.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[6]*lowerInvComp;
-			m_vvSliceStress32.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[7]*lowerInvComp;
-			m_vvSliceStress33.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[8]*lowerInvComp;
+			const double lowerInvComp = (1.0 - lowerSliceRem)*innerInvComp;
+			AddSliceStressTerm(pSliceStress, lowerSliceIndex, stressTypeIndex, fdx, lowerInvComp);
 		}
 		else									// Lower bead is on slice border
 		{
-			m_vvSliceStress11.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[0]*innerInvComp;
-			m_vvSliceStress12.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[1]*innerInvComp;
-			m_vvSliceStress13.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[2]*innerInvComp;
-			m_vvSliceStress21.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[3]*innerInvComp;
-			m_vvSliceStress22.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[4]*innerInvComp;
-			m_vvSliceStress23.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[5]*innerInvComp;
-			m_vvSliceStress31.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[6]*innerInvComp;
-			m_vvSliceStress32.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[7]*innerInvComp;
-			m_vvSliceStress33.at(m_LowerStressSliceIndex).at(stressTypeIndex) += m_fdx[8]*innerInvComp;
+			AddSliceStressTerm(pSliceStress, lowerSliceIndex, stressTypeIndex, fdx, innerInvComp);
 		}
 
-		if(m_UpperStressSliceRem > 0.000001)	// Upper bead not on slice border
+		if(upperSliceRem > 0.000001)	// Upper bead not on slice border
 		{
-			const double upperInvComp = m_UpperStressSliceRem*innerInvComp;
-			m_vvSliceStress11.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[0]*upperInvComp;
-			m_vvSliceStress12.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[1]*upperInvComp;
-			m_vvSliceStress13.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[2]*upperInvComp;
-			m_vvSliceStress21.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[3]*upperInvComp;
-			m_vvSliceStress22.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[4]*upperInvComp;
-			m_vvSliceStress23.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[5]*upperInvComp;
-			m_vvSliceStress31.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[6]*upperInvComp;
-			m_vvSliceStress32.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[7]*upperInvComp;
-			m_vvSliceStress33.at(m_UpperStressSliceIndex).at(stressTypeIndex) += m_fdx[8]*upperInvComp;
+			const double upperInvComp = upperSliceRem*innerInvComp;
+			AddSliceStressTerm(pSliceStress, upperSliceIndex, stressTypeIndex, fdx, upperInvComp);
 		}
 	}
 }
 
-// Function called by the CSimBox to zero the stress arrays prior to adding 
-// new data in the CCNTCell::UpdateForce() and CSimBox functions.
+// Private helper function to add one contribution to the 9 tensor components 
+// for a given slice and bead-pair type in a slice stress buffer. The factor is
+// the f(z1,z2,zs) weight of the slice.
+
+void CMonitor::AddSliceStressTerm(double* const pSliceStress, long slice, long stressTypeIndex, const double fdx[9], double factor) const
+{
+	double* const pTerm = pSliceStress + 9*(slice*m_StressBeadPairTotal + stressTypeIndex);
+
+	for(short int j=0; j<9; j++)
+	{
+		pTerm[j] += fdx[j]*factor;
+	}
+}
+
+// Function called by the CSimBox before the forces are calculated in each 
+// time step. It checks whether any aggregate analysis needs the stress 
+// profile at the current time, and if so, zeroes the stress arrays prior to 
+// adding new data in the CCNTCell::UpdateForce() and CSimBox functions. 
+// Otherwise, the bead, bond and bondpair contributions are not accumulated.
 
 void CMonitor::ZeroSliceStress()
 {
+	m_bSliceStressOn = IsSliceStressRequired();
+
+	if(m_bSliceStressOn)
+	{
+		ClearSliceStress();
+	}
+}
+
+// Function to check if the slice stress profile is needed in the current time
+// step. This is only so on sampling steps, and then only if an aggregate 
+// analysis that uses the stress profile is sampled.
+
+bool CMonitor::IsSliceStressRequired() const
+{
+	const long currentTime = GetCurrentTime();
+
+	if(currentTime%m_pSimState->GetSamplePeriod() != 0)
+		return false;
+
+	for(cAggregateIterator citerAgg=m_vAggregates.begin(); citerAgg!=m_vAggregates.end(); citerAgg++)
+	{
+		if((*citerAgg)->IsStressProfileUsed() && (*citerAgg)->TimeToSample(currentTime))
+			return true;
+	}
+
+	return false;
+}
+
+// Function to zero the stress buffers and arrays.
+
+void CMonitor::ClearSliceStress()
+{
+	for(long t=0; t<static_cast<long>(m_vvBeadStressBuffer.size()); t++)
+	{
+		fill(m_vvBeadStressBuffer[t].begin(), m_vvBeadStressBuffer[t].end(), 0.0);
+	}
+
 	for(long i=0; i<m_StressSliceTotal; i++)
 	{
 		for(long j=0; j<m_StressBeadPairTotal; j++)
@@ -2252,9 +2397,72 @@ void CMonitor::InitialiseSliceStress()
 		m_vvSliceStressBondPair33.at(i).resize(m_BondPairTypeSize);
 	}
 
-	// Use the private member function to zero the stress arrays
+	// Create the buffer for the bead-bead contributions for a single thread,
+	// and use the private member function to zero the stress arrays
+
+	SetSliceStressThreadTotal(1);
 
-	ZeroSliceStress();
+	ClearSliceStress();
+}
+
+// Function to set the number of flat buffers holding the bead-bead stress
+// contributions, one for each thread that calculates the non-bonded forces.
+// It is also called to resize the buffers when new bead types are created.
+// The buffers are zeroed.
+
+void CMonitor::SetSliceStressThreadTotal(long threads)
+{
+	const long bufferSize = 9*m_StressSliceTotal*m_StressBeadPairTotal;
+
+	m_vvBeadStressBuffer.resize(threads);
+
+	for(long t=0; t<threads; t++)
+	{
+		m_vvBeadStressBuffer[t].assign(bufferSize, 0.0);
+	}
+}
+
+// Function to sum the bead-bead stress contributions from the buffers of
+// all threads into the arrays used by the aggregate analysis. This is done 
+// once per sampling step, before the aggregates are analysed. For a single 
+// thread the arrays receive exactly the values accumulated in the buffer.
+
+void CMonitor::ReduceSliceStress()
+{
+	const long threadTotal = m_vvBeadStressBuffer.size();
+
+	double sum[9];
+
+	for(long i=0; i<m_StressSliceTotal; i++)
+	{
+		for(long j=0; j<m_StressBeadPairTotal; j++)
+		{
+			const long index = 9*(i*m_StressBeadPairTotal + j);
+
+			for(short int k=0; k<9; k++)
+			{
+				sum[k] = m_vvBeadStressBuffer[0][index+k];
+			}
+
+			for(long t=1; t<threadTotal; t++)
+			{
+				for(short int k=0; k<9; k++)
+				{
+					sum[k] += m_vvBeadStressBuffer[t][index+k];
+				}
+			}
+
+			m_vvSliceStress11.at(i).at(j) = sum[0];
+			m_vvSliceStress12.at(i).at(j) = sum[1];
+			m_vvSliceStress13.at(i).at(j) = sum[2];
+			m_vvSliceStress21.at(i).at(j) = sum[3];
+			m_vvSliceStress22.at(i).at(j) = sum[4];
+			m_vvSliceStress23.at(i).at(j) = sum[5];
+			m_vvSliceStress31.at(i).at(j) = sum[6];
+			m_vvSliceStress32.at(i).at(j) = sum[7];
+			m_vvSliceStress33.at(i).at(j) = sum[8];
+		}
+	}
 }
 
 // Function used by the CSimBox class to pass the bond contributions to
@@ -2282,6 +2490,12 @@ void CMonitor::InitialiseSliceStress()
 
 void CMonitor::AddBondStress(const CBond* const pBond)
 {
+	// The contributions are only accumulated when the stress profile is needed
+	// in the current time step: see ZeroSliceStress().
+
+	if(!m_bSliceStressOn)
+		return;
+
 	// Calculate the f(z1, z2, zs) factors that determine how much the bead interaction
 	// contributes to each slice zs noting that more than one slice may be involved.
 	// We first sort the two beads to find out which one is above the other or whether
@@ -2519,6 +2733,12 @@ void CMonitor::AddBondStress(const CBond* const pBond)
 
 void CMonitor::AddBondPairStress(const CBondPair* const pBondPair)
 {
+	// The contributions are only accumulated when the stress profile is needed
+	// in the current time step: see ZeroSliceStress().
+
+	if(!m_bSliceStressOn)
+		return;
+
 	// Calculate the f(z1, z2, zs) factors that determine how much the interaction
 	// contributes to each slice, zs, noting that more than one slice may be involved.
 	// We first sort the two beads to find out which one is above the other or whether
@@ -2880,6 +3100,7 @@ void CMonitor::UpdateBeadTypes()
 		m_vvSliceStress33.at(i).resize(m_StressBeadPairTotal);
 	}
 
+	SetSliceStressThreadTotal(m_vvBeadStressBuffer.size());
 }
 
 // Function used by the ISimBox to update the number of bond types in
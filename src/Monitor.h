@@ -9,10 +9,14 @@
 
 class CSimState;
 class CCurrentStateFormat;
+class CBinaryTrajectoryState;
 
 
 #include "ISimBoxBase.h"
 #include "IMonitorCmd.h"
+#include "SingleBeadSampleKernel.h"
+#include "BeadGridSampleKernel.h"
+#include "AsyncStateWriter.h"
 
 #if EnableMonitorCommand == SimCommandEnabled
     #include "mcCommentImpl.h"
@@ -63,14 +67,17 @@ class CCurrentStateFormat;
 #include "mcSetPolymerTypeDisplayIdImpl.h"
 #include "mcSetRestartPeriodImpl.h"
 #include "mcSetRestartStateDefaultBeadCoordinatesImpl.h"
+#include "mcSetRestartStateDefaultBinaryImpl.h"
 #include "mcSetRestartStateDefaultInclusiveImpl.h"
 #include "mcSetRunCompleteIntervalImpl.h"
 #include "mcSetSamplePeriodImpl.h"
 #include "mcSetSAXSProcessBeadElectronNoImpl.h"
+#include "mcSetSAXSProcessBinWidthImpl.h"
 #include "mcToggleBeadDisplayImpl.h"
 #include "mcToggleCurrentStateBoxImpl.h"
 #include "mcToggleDensityFieldOutputImpl.h"
 #include "mcTogglePolymerDisplayImpl.h"
+#include "mcToggleHistoryStateStreamingImpl.h"
 #include "mcToggleRestartWarningMessagesImpl.h"
 #include "mcWriteLogMessageImpl.h"
 
@@ -123,14 +130,17 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 				public mcSetPolymerTypeDisplayIdImpl,
 				public mcSetRestartPeriodImpl,
 				public mcSetRestartStateDefaultBeadCoordinatesImpl,
+				public mcSetRestartStateDefaultBinaryImpl,
 				public mcSetRestartStateDefaultInclusiveImpl,
 				public mcSetRunCompleteIntervalImpl,
 				public mcSetSamplePeriodImpl,
                 public mcSetSAXSProcessBeadElectronNoImpl,
+                public mcSetSAXSProcessBinWidthImpl,
 				public mcToggleBeadDisplayImpl,
 				public mcToggleCurrentStateBoxImpl,
 				public mcToggleDensityFieldOutputImpl,
 				public mcTogglePolymerDisplayImpl,
+				public mcToggleHistoryStateStreamingImpl,
 				public mcToggleRestartWarningMessagesImpl,
 				public mcWriteLogMessageImpl
 
@@ -140,6 +150,7 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 	// need access to the CMonitor's data.
 
 	friend class CCNTCell;
+	friend class CCNTCellBeadStore;
 	friend class CExternalCNTCell;
 	friend class ISimBox;
 #if EnableMonitorCommand == SimCommandEnabled
@@ -190,14 +201,17 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 	friend class  mcSetPolymerTypeDisplayIdImpl;
 	friend class  mcSetRestartPeriodImpl;
 	friend class  mcSetRestartStateDefaultBeadCoordinatesImpl;
+	friend class  mcSetRestartStateDefaultBinaryImpl;
 	friend class  mcSetRestartStateDefaultInclusiveImpl;
 	friend class  mcSetRunCompleteIntervalImpl;
 	friend class  mcSetSamplePeriodImpl;
     friend class  mcSetSAXSProcessBeadElectronNoImpl;
+    friend class  mcSetSAXSProcessBinWidthImpl;
 	friend class  mcToggleBeadDisplayImpl;
 	friend class  mcToggleCurrentStateBoxImpl;
 	friend class  mcToggleDensityFieldOutputImpl;
 	friend class  mcTogglePolymerDisplayImpl;
+	friend class  mcToggleHistoryStateStreamingImpl;
 	friend class  mcToggleRestartWarningMessagesImpl;
 	friend class  mcWriteLogMessageImpl;
 
@@ -241,7 +255,18 @@ public:
 	inline bool	IsDensityFieldAnalysisOn() const {return !m_DensityFields.empty();}
 	inline long GetDensityFieldTotal()	   const {return m_DensityFields.size();}
 
+	// Functions to add and remove observables that accumulate data from 
+	// every bead during the single sampling pass over the SimBox
 
+	void AddSampleKernel(ISampleKernel* const pKernel);
+	void RemoveSampleKernel(ISampleKernel* const pKernel);
+
+
+
+	// Flag showing if the slice stress contributions are being accumulated 
+	// in the current time step
+
+	inline bool IsSliceStressOn() const {return m_bSliceStressOn;}
 
 	// Allow the aggregates to get the the stress tensor calculation results
 
@@ -331,6 +356,9 @@ protected:
 	// Private functions
 private:
 
+	void RunSampleKernels();
+	void ReportFailedStateWrites();
+	void SampleKernelCells(long thread, long firstCell, long lastCell);
 	void CalculateSingleBeadData();
 	void CalculateSingleBondData();
 	void CalculateSingleBondPairData();
@@ -343,7 +371,13 @@ private:
 										// Pass stress contributions from CNTCells
 	void InitialiseSliceStress();
 	void ZeroSliceStress();
+	void ClearSliceStress();
+	void ReduceSliceStress();
+	void SetSliceStressThreadTotal(long threads);
+	bool IsSliceStressRequired() const;
 	void AddBeadStress(const CAbstractBead* const pBead1, const CAbstractBead* const pBead2, const double force[3], const double dx[3]);
+	void AddBeadStress(double* const pSliceStress, long type1, long type2, double z1, double z2, const double force[3], const double dx[3]) const;
+	void AddSliceStressTerm(double* const pSliceStress, long slice, long stressTypeIndex, const double fdx[9], double factor) const;
 	void AddBondStress(const CBond* const pBond);
 	void AddBondPairStress(const CBondPair* const pBondPair);
 
@@ -376,7 +410,7 @@ private:
 
 private:
 
-	static CMonitor* m_pInstance;		// Pointer to single instance of CMonitor class
+	static thread_local CMonitor* m_pInstance;		// Pointer to single instance of CMonitor class
 
 	CSimState* const m_pSimState;		// Pointer is const but CSimState can be changed
 
@@ -425,6 +459,14 @@ private:
 	double m_invSliceWidth;				// Inverse of stress tensor slice width
 	double m_fdx[9];					// Array to hold temporary force*dx terms
 
+	bool m_bSliceStressOn;				// Flag showing if the bead stress is accumulated this time step
+
+	// Flat buffers, one per force thread, holding the bead-bead contributions
+	// for each slice, bead-pair type and tensor component. They are summed 
+	// into the 2-dimensional arrays below once per sampling step.
+
+	zArray2dDouble m_vvBeadStressBuffer;
+
 	// 2-dimensional arrays to hold the contributions to the stress tensor
 	// averaged over slices through the SimBox from the bead-bead interactions,
 	// the bond forces (Hookean springs) and bondpair forces (3-body forces).
@@ -558,6 +600,17 @@ private:
     bool m_bNormalizePerBead;				// Normalize energy terms by bead total or not
 
     bool m_bInclusiveRestartStates;         // Save inclusive restart states by default
+    bool m_bBinaryRestartStates;            // Save restart states in the binary format
+
+	// Observables sampled in a single pass over the beads
+
+	CSingleBeadSampleKernel m_SingleBeadKernel;	// Sums for the global bead observables
+	CBeadGridSampleKernel   m_BeadGridKernel;	// Bead counts in the analysis grid
+	std::vector<ISampleKernel*> m_vSampleKernels;	// All kernels run by the sampling pass
+
+	CAsyncStateWriter m_StateWriter;	// Writes current state snapshots in the background
+
+	CBinaryTrajectoryState* m_pTrajectory;	// Trajectory file used by the BinaryTrajectory format
 
 };
 
@@ -28,7 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // Static member variable holding the number of commands created.
 
-long CNanoparticle::m_NanoparticleTotal = 0;
+thread_local long CNanoparticle::m_NanoparticleTotal = 0;
 
 long CNanoparticle::GetNanoparticleTotal()
 {
@@ -37,7 +37,7 @@ public:
 
 private:
 
-	static long m_NanoparticleTotal;	// Number of nanoparticles created
+	static thread_local long m_NanoparticleTotal;	// Number of nanoparticles created
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
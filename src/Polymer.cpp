@@ -19,6 +19,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "SimDefs.h"
 #include "SimAlgorithmFlags.h"
 #include "Polymer.h"
+#include "PolymerArena.h"
 #include "Bead.h"
 #include "Bond.h"
 #include "BondPair.h"
@@ -47,7 +48,7 @@ bool operator==(const CPolymer& a, const CPolymer& b)
 //////////////////////////////////////////////////////////////////////
 // Default constructor used to make empty polymer instances.
 
-CPolymer::CPolymer() : m_id(0), m_Type(0), m_pHead(0), m_pTail(0)
+CPolymer::CPolymer() : m_id(0), m_Type(0), m_pHead(0), m_pTail(0), m_bArenaOwned(false)
 {
 
 #if EnableParallelSimBox == SimMPSEnabled
@@ -82,6 +83,7 @@ CPolymer::CPolymer(long type, bool blinear, double fraction,
 				   BondVector& vBonds) : m_id(-1),  m_Type(type), 
 													m_pHead(pHead),
 													m_pTail(pTail),
+													m_bArenaOwned(false),
 													m_vBeads(vBeads),
 													m_vBonds(vBonds)
 {
@@ -99,6 +101,7 @@ CPolymer::CPolymer(long type, bool blinear, double fraction,
 													m_Type(type), 
 													m_pHead(pHead),
 													m_pTail(pTail),
+													m_bArenaOwned(false),
 													m_vBeads(vBeads),
 													m_vBonds(vBonds),
 													m_vBondPairs(vBondPairs)
@@ -112,18 +115,26 @@ CPolymer::CPolymer(long type, bool blinear, double fraction,
 
 
 // The CPolymer destructor is responsible for destroying its own CBeads, CBonds and
-// CBondPair objects.
+// CBondPair objects unless they were created in a CPolymerArena, in which case
+// the arena destroys them.
 
 CPolymer::~CPolymer()
 {
 	// Remove the head bead if it is a CWallBead not included in the vector of
-	// CBeads that are deleted next.
+	// CBeads that are deleted next. Wall beads are never created in an arena.
 
 	if(dynamic_cast<CWallBead*>(m_pHead))
 	{
 		delete m_pHead;
 	}
 
+	if(m_bArenaOwned)
+	{
+		m_vBeads.clear();
+		m_vBonds.clear();
+		m_vBondPairs.clear();
+	}
+
 	if(!m_vBeads.empty())
 	{
 		for(BeadVectorIterator iterBead=m_vBeads.begin(); iterBead!=m_vBeads.end(); iterBead++)
@@ -166,6 +177,7 @@ CPolymer::CPolymer(const CPolymer &oldPolymer)
 {
 	m_id				=	oldPolymer.m_id;
 	m_Type				=	oldPolymer.m_Type;
+	m_bArenaOwned		=	false;
 
 	// Now create new beads and bonds to compose this polymer by copying them
 	// from the appropriate template class. We cannot set their ids here as 
@@ -216,6 +228,54 @@ CPolymer::CPolymer(const CPolymer &oldPolymer)
 
 }
 
+// Copy constructor used by the CPolymerArena. It copies the polymer type in
+// the same way as the ordinary copy constructor but creates the beads, bonds
+// and bondpairs in the arena, so that the components of consecutive polymers
+// are stored contiguously. The arena owns them, and the polymer must not
+// delete them. Arena polymers are only used in the serial code.
+
+CPolymer::CPolymer(const CPolymer &oldPolymer, CPolymerArena& rArena) : m_id(oldPolymer.m_id),
+																		m_Type(oldPolymer.m_Type),
+																		m_pHead(0),
+																		m_pTail(0),
+																		m_bArenaOwned(true)
+{
+
+#if EnableParallelSimBox == SimMPSEnabled
+    m_pExtPolymer = 0;
+#endif
+
+	m_vBeads.reserve(oldPolymer.m_vBeads.size());
+	m_vBonds.reserve(oldPolymer.m_vBonds.size());
+	m_vBondPairs.reserve(oldPolymer.m_vBondPairs.size());
+
+	for(cBeadVectorIterator iterBead=oldPolymer.m_vBeads.begin(); iterBead!=oldPolymer.m_vBeads.end(); iterBead++)
+	{
+		CBead* pBead = rArena.CreateBead(**iterBead);
+
+		if((*iterBead) == oldPolymer.m_pHead)
+			m_pHead = pBead;
+		if((*iterBead) == oldPolymer.m_pTail)
+			m_pTail = pBead;
+		m_vBeads.push_back(pBead);
+	}
+
+	for(cBondVectorIterator iterBond=oldPolymer.m_vBonds.begin(); iterBond!=oldPolymer.m_vBonds.end(); iterBond++)
+	{
+		CBond* pBond = rArena.CreateBond(**iterBond);
+		pBond->SetBeads(m_vBeads.at(pBond->GetHeadIndex()), m_vBeads.at(pBond->GetTailIndex()));
+		m_vBonds.push_back(pBond);
+	}
+
+	for(cBondPairVectorIterator iterBP=oldPolymer.m_vBondPairs.begin(); iterBP!=oldPolymer.m_vBondPairs.end(); iterBP++)
+	{
+		CBondPair* pBondPair = rArena.CreateBondPair(**iterBP);
+		pBondPair->SetBonds( m_vBonds.at((*iterBP)->GetFirstIndex()), 
+							 m_vBonds.at((*iterBP)->GetSecondIndex()) );
+		m_vBondPairs.push_back(pBondPair);
+	}
+}
+
 // Assignment operator for CPolymer objets.
 //
 // We don't expect this to be used but it is good to define it anyway.
@@ -308,16 +368,20 @@ void CPolymer::ChangeHeadtoWallBead()
 
 	// Delete the old head bead and set the new head and tail pointers but don't add
 	// the new head bead into m_vBeads because that only holds CBead* and the head bead
-	// is now a CWallBead*
+	// is now a CWallBead*. If the old head is in an arena it stays there unused
+	// until the arena is destroyed.
 
-	if(m_pTail == m_pHead)	// update the head and tail pointers and delete old head
+	if(!m_bArenaOwned)
 	{
 		delete m_pHead;
+	}
+
+	if(m_pTail == m_pHead)	// update the head and tail pointers
+	{
 		m_pTail = m_pHead = pNewHead;
 	}
 	else
 	{
-		delete m_pHead;
 		m_pHead = pNewHead;
 	}
 
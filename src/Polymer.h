@@ -10,6 +10,7 @@
 
 class ISimBoxBase;
 class mpuExtendedPolymer;
+class CPolymerArena;
 
 
 // Include file to gain access to the typedefs for beads and bonds
@@ -42,6 +43,11 @@ public:
 	CPolymer(const CPolymer& oldPolymer);
 	CPolymer& operator =(const CPolymer &oldPolymer);
 
+	// Copy constructor that creates the polymer's beads, bonds and bondpairs
+	// in an arena that owns them instead of allocating each one separately
+
+	CPolymer(const CPolymer& oldPolymer, CPolymerArena& rArena);
+
 	// ****************************************
 	// Global functions, static member functions and variables
 public:
@@ -177,6 +183,8 @@ private:
 
 	CAbstractBead* m_pHead;		// allow for CWallBeads to be stored here
 	CAbstractBead* m_pTail;
+
+	bool m_bArenaOwned;			// Flag showing if the beads, bonds and bondpairs belong to a CPolymerArena
 	
 #if EnableParallelSimBox == SimMPSEnabled
     mpuExtendedPolymer*   m_pExtPolymer;   // Wrapper extended polymer needed when the polymer spans more than two processor Spaces
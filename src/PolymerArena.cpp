@@ -0,0 +1,98 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// PolymerArena.cpp: implementation of the CPolymerArena class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "PolymerArena.h"
+#include "Polymer.h"
+#include "Bead.h"
+#include "Bond.h"
+#include "BondPair.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// The CPolymerArena owns all the polymers created from the polymer types at
+// the start of a serial simulation, together with their beads, bonds and
+// bondpairs. Each kind of object is stored in its own contiguous arena in
+// the order in which the polymers are created, so that the beads of a polymer
+// are adjacent in memory and the bonded force loops walk through memory
+// sequentially. It replaces one heap allocation per object with a few large
+// blocks, and the objects are destroyed in bulk when the arena is destroyed.
+//
+// Polymers created by the arena know that they do not own their beads, bonds
+// and bondpairs: see CPolymer::CPolymer(const CPolymer&, CPolymerArena&).
+
+CPolymerArena::CPolymerArena()
+{
+}
+
+// The polymers must be destroyed before their beads as a polymer may still
+// refer to them, so we clear the arenas explicitly in the reverse order of 
+// their dependencies.
+
+CPolymerArena::~CPolymerArena()
+{
+	Clear();
+}
+
+// Function to reserve storage so that the objects created for the given numbers
+// of polymers, beads, bonds and bondpairs each occupy a single block.
+
+void CPolymerArena::Reserve(long polymerTotal, long beadTotal, long bondTotal, long bondPairTotal)
+{
+	m_Polymers.Reserve(polymerTotal);
+	m_Beads.Reserve(beadTotal);
+	m_Bonds.Reserve(bondTotal);
+	m_BondPairs.Reserve(bondPairTotal);
+}
+
+// Function to create a polymer by copying a polymer type. The new polymer's
+// beads, bonds and bondpairs are also created in this arena.
+
+CPolymer* CPolymerArena::CreatePolymer(const CPolymer& oldPolymer)
+{
+	return m_Polymers.Create(oldPolymer, *this);
+}
+
+CBead* CPolymerArena::CreateBead(const CBead& oldBead)
+{
+	return m_Beads.Create(oldBead);
+}
+
+CBond* CPolymerArena::CreateBond(const CBond& oldBond)
+{
+	return m_Bonds.Create(oldBond);
+}
+
+CBondPair* CPolymerArena::CreateBondPair(const CBondPair& oldBondPair)
+{
+	return m_BondPairs.Create(oldBondPair);
+}
+
+// Function to destroy all objects in the arena. Any pointers to them held
+// elsewhere are invalid afterwards.
+
+void CPolymerArena::Clear()
+{
+	m_Polymers.Clear();
+	m_BondPairs.Clear();
+	m_Bonds.Clear();
+	m_Beads.Clear();
+}
@@ -0,0 +1,93 @@
+// PolymerArena.h: interface for the CPolymerArena class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_POLYMERARENA_H__9D2B6E14_7A0C_4F63_B5E8_1C4A7F3D28B9__INCLUDED_)
+#define AFX_POLYMERARENA_H__9D2B6E14_7A0C_4F63_B5E8_1C4A7F3D28B9__INCLUDED_
+
+
+// Forward declarations
+
+class CBead;
+class CBond;
+class CBondPair;
+class CPolymer;
+
+
+#include "xxArena.h"
+
+class CPolymerArena
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CPolymerArena();
+
+	~CPolymerArena();
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// Reserve contiguous storage for the polymers about to be created and
+	// all their beads, bonds and bondpairs
+
+	void Reserve(long polymerTotal, long beadTotal, long bondTotal, long bondPairTotal);
+
+	// Functions to copy a template object into the arena
+
+	CPolymer*  CreatePolymer(const CPolymer& oldPolymer);
+	CBead*     CreateBead(const CBead& oldBead);
+	CBond*     CreateBond(const CBond& oldBond);
+	CBondPair* CreateBondPair(const CBondPair& oldBondPair);
+
+	inline long GetPolymerTotal()  const {return m_Polymers.size();}
+	inline long GetBeadTotal()     const {return m_Beads.size();}
+	inline long GetBondTotal()     const {return m_Bonds.size();}
+	inline long GetBondPairTotal() const {return m_BondPairs.size();}
+
+	void Clear();
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	// Explicitly disallow the copy constructor and assignment operator
+	// by declaring them privately but providing NO definitions.
+
+	CPolymerArena(const CPolymerArena& oldArena);
+	CPolymerArena& operator=(const CPolymerArena& rhs);
+
+	// ****************************************
+	// Data members
+private:
+
+	xxArena<CBead>     m_Beads;
+	xxArena<CBond>     m_Bonds;
+	xxArena<CBondPair> m_BondPairs;
+	xxArena<CPolymer>  m_Polymers;
+};
+
+#endif // !defined(AFX_POLYMERARENA_H__9D2B6E14_7A0C_4F63_B5E8_1C4A7F3D28B9__INCLUDED_)
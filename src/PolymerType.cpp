@@ -48,7 +48,7 @@ bool operator==(const CPolymerType& a, const CPolymerType& b)
 // Static member definitions
 //////////////////////////////////////////////////////////////////////
 
-long CPolymerType::m_PolymerTypeTotal = 0;	// No of polymer types created so far
+thread_local long CPolymerType::m_PolymerTypeTotal = 0;	// No of polymer types created so far
 
 long CPolymerType::GetTotal()
 {
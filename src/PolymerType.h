@@ -37,7 +37,7 @@ protected:
 				 zString head, zString tail);
 
 private:
-	static long m_PolymerTypeTotal;
+	static thread_local long m_PolymerTypeTotal;
 
 	zString m_Name;
 	zString m_Shape;
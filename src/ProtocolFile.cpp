@@ -171,17 +171,10 @@ bool CProtocolFile::Serialize()
 
 	// The DPD integration scheme requires the lambda parameter whereas MD does not
 
-#if SimIdentifier == BD
-
-	m_outStream << "	<Lambda>" << m_Lambda << "</Lambda>" << zEndl;
-
-#elif SimIdentifier == DPD
-
-	m_outStream << "	<Lambda>" << m_Lambda << "</Lambda>" << zEndl;
-
-#elif SimIdentifier == MD
-
-#endif
+	if(GetSimIdentifier() != MD)
+	{
+		m_outStream << "	<Lambda>" << m_Lambda << "</Lambda>" << zEndl;
+	}
 
 	m_outStream << "	</Integration>" << zEndl;
 	m_outStream << "</SimBox>" << zEndl;
@@ -23,7 +23,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // **********************************************************************
 // Global Functions and members
 //
-bool CRandomNumberSequence::m_bReadOnceOnly = true;  // Read file in once by default
+thread_local bool CRandomNumberSequence::m_bReadOnceOnly = true;  // Read file in once by default
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -22,7 +22,7 @@ public:
 	// Global functions, static member functions and variables
 public:
 
-    static bool m_bReadOnceOnly; // Flag showing if the file should be read only once
+    static thread_local bool m_bReadOnceOnly; // Flag showing if the file should be read only once
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
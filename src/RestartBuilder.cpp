@@ -20,6 +20,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "RestartBuilder.h"
 #include "InitialState.h"
 #include "InclusiveRestartState.h"
+#include "BinaryRestartState.h"
 
 #include "SimMathFlags.h"
 
@@ -79,11 +80,20 @@ bool CRestartBuilder::Assemble(CInitialState& riState)
     // file, the data are all stored in the initial state object as this builder
     // has no access to the other simulation state objects. The initial state
     // instance is then responsible for propagating the data to the rest of the
-    // simulation.
+    // simulation. A restart state written in the binary format is recognised
+    // by the identifier at the start of the file and read by a 
+    // CBinaryRestartState instead.
 
 	// If the original control data file does not exist, or an error occurs
 	// opening the file or while reading the data we cancel the restart run.
 
+	if(CBinaryRestartState::IsBinaryRestartState(m_StateId, m_RunId))
+	{
+		CBinaryRestartState binaryState(m_StateId, m_RunId, riState);
+
+		return binaryState.IsFileStateOk() && binaryState.Serialize();
+	}
+
 	CInclusiveRestartState oldState(m_StateId, m_RunId, riState);
 
 	if(oldState.IsFileStateOk() && oldState.Serialize())
@@ -265,7 +265,7 @@ bool CRestartState::Serialize()
         // restart state being read in, but we store the largest type found so that 
         // the data can be checked for consistency.
 		//
-		// If the flag UseDPDBeadRadii is set then read in the bead radii but allow
+		// If the BeadRadii keyword is set then read in the bead radii but allow
 		// them to be different from the ones in the previous run.
 	
 		long polyId, polyType;
@@ -49,6 +49,10 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Polymer.h"
 #include "CNTCell.h"
 #include "CNTCellSlice.h"
+#include "CNTCellBeadStore.h"
+#include "Ensemble.h"
+#include "BeadRange.h"
+#include "ChargedBeadCellList.h"
 #include "Cell.h"
 #include "Row.h"
 #include "Slice.h"
@@ -63,11 +67,16 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "ccSetBondStiffness.h"
 #include "ccSetBondStrength.h"
 #include "ccSetBondStrengthbyType.h"
+#include "ccSetChargedBeadCutoff.h"
 #include "ccSetCommandTimer.h"
 #include "ccSetDPDBeadConsInt.h"
 #include "ccSetDPDBeadConsIntByType.h"
 #include "ccSetDPDBeadDissInt.h"
 #include "ccSetDPDBeadDissIntByType.h"
+#include "ccSetDPDIntegrator.h"
+#include "ccSetForcePrecision.h"
+#include "ccSetThreadTotal.h"
+#include "ccSetVerletSkin.h"
 #include "ccSetTimeStepSize.h"
 #include "ccStop.h"
 #include "ccStopNoSave.h"
@@ -225,7 +234,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "LogMCAcceptanceRate.h"
 #include "LogRestoreBeadType.h"
 #include "LogRestoreOriginalBeadType.h"
+#include "LogSetChargedBeadCutoff.h"
 #include "LogSetCommandTimer.h"
+#include "LogSetDPDIntegrator.h"
+#include "LogSetForcePrecision.h"
+#include "LogSetThreadTotal.h"
+#include "LogSetVerletSkin.h"
 #include "LogSetTimeStepSize.h"
 #include "LogSimErrorTrace.h"
 #include "LogStressContribution.h"
@@ -262,7 +276,7 @@ using std::mem_fn; // Covert to std::mem_fn, as mem_fun deprecated in c++17
 // Static member variable holding a pointer to the single instance of CSimBox.
 // Note that it does not get assigned a value until the user creates the instance.
 
-CSimBox* CSimBox::m_pInstance = 0;
+thread_local CSimBox* CSimBox::m_pInstance = 0;
 
 // Public member function to create a single instance of the CSimBox class.
 
@@ -455,6 +469,28 @@ CSimBox::CSimBox(CSimState& simState, const ISimBox* const pISimBox) : ISimState
 #endif
     }
 
+#if EnableCellBeadStore == SimMiscEnabled
+    // Create the contiguous bead store used by the DPD force loop. It holds
+    // the cell network's neighbour structure and is filled from the cells'
+    // bead lists at each time step. Only the standard DPD force uses it.
+    // Its force kernel uses the bead radii only if the control data file
+    // contains the BeadRadii keyword, as do the CCNTCell force loops.
+
+	if(GetSimIdentifier() == DPD)
+	{
+		m_pBeadStore = new CCNTCellBeadStore(m_vCNTCells, CCNTCell::UsesBeadRadii());
+	}
+	else
+	{
+		m_pBeadStore = 0;
+	}
+#endif
+
+	// The forces between charged beads are calculated for all pairs unless
+	// a cutoff is set by a command.
+
+	m_pChargedBeadCellList = 0;
+
 #if EnableStressTensorSphere == SimMiscEnabled
     // Create the stress grid if the feature is compiled in.
 	
@@ -597,6 +633,14 @@ CSimBox::~CSimBox()
 	}
 #endif
 
+#if EnableCellBeadStore == SimMiscEnabled
+	if(m_pBeadStore)
+	{
+		delete m_pBeadStore;
+		m_pBeadStore = 0;
+	}
+#endif
+
 	// Delete all CNT cells created using new in the CSimBox::MakeCNTCells
 	// function. As we store pointers to the cells and not the objects
 	// themselves we only have to delete them once.
@@ -696,6 +740,12 @@ CSimBox::~CSimBox()
 
 #endif
 
+	if(m_pChargedBeadCellList)
+	{
+		delete m_pChargedBeadCellList;
+		m_pChargedBeadCellList = 0;
+	}
+
 	// Delete any CNanoparticles created in both the serial and parallel codes.
     
 	if(!m_Nanoparticles.empty())
@@ -972,11 +1022,23 @@ CCNTCell* CSimBox::GetCNTCellFromCoords(double r[3]) const
 //  
 //  3	Update velocity of all beads from old and new values of the force (UpdateMom())
 //
-//
+// If a split DPD integration scheme has been selected by a ccSetDPDIntegrator
+// command, the dissipative and random forces are not calculated in step 2.
+// Instead, the velocities of all interacting pairs of beads are thermalised
+// before step 1 (UpdateThermostat()), and steps 1-3 integrate the conservative
+// forces alone.
 
 void CSimBox::Evolve()
 {
-	CNTCellIterator iterCell;  // used in all three loops below
+	CNTCellIterator iterCell;  // used in all the loops below
+
+	if(GetSimIdentifier() == DPD && CCNTCell::IsDPDThermostatSplit())
+	{
+		for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+		{
+			(*iterCell)->UpdateThermostat();
+		} 
+	}
 
 	for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	{
@@ -990,18 +1052,25 @@ void CSimBox::Evolve()
 	// ISimBox that can then pass it to the CMonitor. Note that the stress
 	// contributions from bonds and bondpairs are also zeroed within the
 	// ZeroSliceStress() function but they are calculated and added serparately.
+	// The CMonitor only accumulates the contributions on sampling steps when 
+	// an aggregate analysis uses the stress profile.
 
     // If the density-dependent DPDLG force is enabled and is being used
     // for the given input file, we first calculate the local bead density around
     // every bead in the SimBox and then call the UpdateLGForce() function to 
-    // calculate the new force instead of the standard UpdateForce().
+    // calculate the new force instead of the standard UpdateForce(). The 
+    // densities are accumulated for both beads of each pair so they must all
+    // be zeroed first.
 
 	ZeroSliceStress();
 
-#if EnableDPDLG == ExperimentEnabled
-
     if(IsDPDLG())
     {
+	    for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+	    {
+		    (*iterCell)->ZeroLGDensity();
+	    } 
+
 	    for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	    {
 		    (*iterCell)->UpdateLGDensity();
@@ -1014,21 +1083,9 @@ void CSimBox::Evolve()
     }
     else
     {
-	    for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
-	    {
-		    (*iterCell)->UpdateForce();
-	    } 
+	    UpdateNonBondedForces();
     }
 
-#elif EnableDPDLG == ExperimentDisabled
-
-	for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
-	{
-		(*iterCell)->UpdateForce();
-	} 
-
-#endif
-
 	// Add in the forces between bonded beads and the stiff bond force. Note that
 	// AddBondPairForces() must be called after AddBondForces() because it relies
 	// on the bond lengths having already been calculated in CBond::AddForce().
@@ -1103,11 +1160,10 @@ void CSimBox::Evolve()
 	// the monitor function AddBeadEnergy() directly. We have to pass in two
 	// dummy parameters for now
 
-#if SimIdentifier != BD
 	double kinetic = 0.0;
 	double potential = 0.0;
 
-	if(IsEnergyOutputOn())
+	if(GetSimIdentifier() != BD && IsEnergyOutputOn())
 	{
 		ZeroTotalEnergy();
 
@@ -1116,7 +1172,35 @@ void CSimBox::Evolve()
 			(*cIterCell)->UpdateTotalEnergy(&kinetic, &potential);
 		} 
 	}
+}
+
+// Function to calculate the non-bonded forces between all pairs of beads in
+// neighbouring CNT cells. If the cell-sorted bead store is compiled in and 
+// has been created (only for DPD simulations), the beads are copied out of the
+// CNT cells into its contiguous arrays, the pair forces are calculated there,
+// and the results copied back into the beads. Otherwise, each CNT cell loops
+// over its own bead list. The two routes give identical results for a single
+// thread. The current time is passed to the counter-based RNG used when the 
+// store's force loop runs on several threads.
+
+void CSimBox::UpdateNonBondedForces()
+{
+#if EnableCellBeadStore == SimMiscEnabled
+	if(m_pBeadStore)
+	{
+		CCNTCell::SetRNGTimeStep(m_SimTime);
+
+		m_pBeadStore->Sort();
+		m_pBeadStore->UpdateForce();
+		m_pBeadStore->Scatter();
+		return;
+	}
 #endif
+
+	for(CNTCellIterator iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+	{
+		(*iterCell)->UpdateForce();
+	} 
 }
 
 // Function to evolve the state of all beads in a parallel simulation forward 
@@ -1242,7 +1326,10 @@ void CSimBox::EvolveP()
 // bead's coordinates with the coordinates of the bottom-left and top-right 
 // corners of the cell. Because of the way the CNT update works if the step size
 // is large a bead might cross a whole CNT cell in one time step and be added
-// to the wrong cell.
+// to the wrong cell. Because this walks every bead, it is only done each time
+// step if the EnableCNTCellCheck debug flag is set; otherwise it is done just 
+// before a restart state is written so that a misplaced bead is reported 
+// before it is saved.
 //
 // Events may be triggered by conditions in the SimBox so we check the sequence of
 // events first. This preceeds the commands because an event may lead to commands
@@ -1310,16 +1397,16 @@ void CSimBox::Run()
             ExecuteCommands();
 
             // Remove unnecessary features from each simulation type
-#if SimIdentifier != BD
-		    if(IsRenormalisationOn() && m_SimTime%m_RenormalisationPeriod == 0)
+		    if(GetSimIdentifier() != BD && IsRenormalisationOn() && m_SimTime%m_RenormalisationPeriod == 0)
 		    {
 			    UpdateRenormalisedMom();
 		    }
-#endif
 
 		    Evolve();
 
+#if EnableCNTCellCheck == SimMiscEnabled
 		    CNTCellCheck();		// check beads are in correct CNT cells
+#endif
 
 		    // Sample the simulation state to construct observables, check if any
 		    // events have happened and update the state of all processes.
@@ -1348,6 +1435,9 @@ void CSimBox::Run()
 
 		    if(TimeToRestart())
 		    {
+#if EnableCNTCellCheck == SimMiscDisabled
+			    CNTCellCheck();
+#endif
     			SaveRestartState();
 		    }
         }
@@ -1462,11 +1552,21 @@ void CSimBox::AddBodyForce()
 // the bead-bead separation to the AddForce() function because the beads themselves
 // have no knowledge of the boundaries of the SimBox. It is more appropriate to
 // apply boundary checks inside the SimBox than pass its size into the bead class.
+//
+// If a cutoff has been set by a SetChargedBeadCutoff command, the pairs of beads
+// within the cutoff are found using a cell list instead of visiting every pair.
+// The loop below is retained as the reference calculation.
 
 void CSimBox::AddChargedBeadForces()
 {
 #if EnableMiscClasses == SimMiscEnabled
 
+	if(m_pChargedBeadCellList)
+	{
+		m_pChargedBeadCellList->AddForces(m_lAllChargedBeads);
+		return;
+	}
+
     for(ChargedBeadListIterator iterBead1=m_lAllChargedBeads.begin(); iterBead1!=m_lAllChargedBeads.end(); iterBead1++)
 	{
 		for(rChargedBeadListIterator riterBead2=m_lAllChargedBeads.rbegin(); (*riterBead2)->GetId()!=(*iterBead1)->GetId(); ++riterBead2)
@@ -3129,12 +3229,9 @@ void CSimBox::RunMCRelaxation()
 		(*iterBead)->m_oldMom[2] = (*iterBead)->GetZMom();
 	}
 
-	CNTCellIterator iterCell;
+	// The non-bonded forces use the same kernel as the time steps that follow
 
-	for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
-	{
-		(*iterCell)->UpdateForce();
-	} 
+	UpdateNonBondedForces();
 
 	// Add in the forces between bonded beads and the stiff bond force. Note that
 	// AddBondPairForces() must be called after AddBondForces() because it relies
@@ -3143,7 +3240,7 @@ void CSimBox::RunMCRelaxation()
 	AddBondForces();
 	AddBondPairForces();
 
-	for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+	for(CNTCellIterator iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	{
 		(*iterCell)->UpdateMom();
 	} 
@@ -3465,9 +3562,11 @@ void CSimBox::SetBondStiffness(const xxCommand* const pCommand)
 	if(0 <= type && type < GetBondPairTypeTotal())
 	{
 
-#if SimIdentifier == MD
-		modulus /= GetEnergyScale();
-#endif
+		if(GetSimIdentifier() == MD)
+		{
+			modulus /= GetEnergyScale();
+		}
+
 		// Loop over all polymers changing the properties of those bondpairs
 		// targetted by the command
 
@@ -3524,10 +3623,12 @@ void CSimBox::SetBondStrength(const xxCommand* const pCommand)
 	if(0 <= type && type < GetBondTypeTotal())
 	{
 
-#if SimIdentifier == MD
-		springConstant *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
-		unStrLength    /= GetLengthScale();
-#endif
+		if(GetSimIdentifier() == MD)
+		{
+			springConstant *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
+			unStrLength    /= GetLengthScale();
+		}
+
 		// Loop over all polymers changing the properties of those bonds that are
 		// targetted by the command
 
@@ -3829,10 +3930,11 @@ void CSimBox::ChargeBeadType(const xxCommand *const pCommand)
 
 		// How do I normalise the MD parameters???
 
-#if SimIdentifier == MD
-		strength *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
-		range    /= GetLengthScale();
-#endif
+		if(GetSimIdentifier() == MD)
+		{
+			strength *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
+			range    /= GetLengthScale();
+		}
 
 		// If the user has set the range to less than 10**-08, we treat this as 
 		// having a strength of zero.
@@ -3976,10 +4078,12 @@ void CSimBox::SetBondStrengthbyType(const xxCommand * const pCommand)
 
 	if(0 <= type && type <= GetBondTypeTotal())
 	{
-#if SimIdentifier == MD
-		springConstant *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
-		unStrLength    /= GetLengthScale();
-#endif
+		if(GetSimIdentifier() == MD)
+		{
+			springConstant *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
+			unStrLength    /= GetLengthScale();
+		}
+
 		// Loop over all polymers changing the properties of those bonds that are
 		// targetted by the command
 
@@ -4207,6 +4311,168 @@ void CSimBox::RestoreOriginalBeadType(const xxCommand* const pCommand)
 #endif
 }
 
+// Handler function to implement a ccSetDPDIntegrator command that selects the
+// scheme used to integrate the DPD equations of motion. The split schemes
+// (Shardlow and Lowe-Andersen) update the velocities of each pair of beads in
+// turn, so they are only available in serial DPD simulations: the command 
+// fails for other simulation types and in a parallel run. See 
+// CCNTCell::SetDPDIntegrator() for a description of the schemes.
+
+void CSimBox::SetDPDIntegrator(const xxCommand* const pCommand)
+{
+	const ccSetDPDIntegrator* const pCmd = dynamic_cast<const ccSetDPDIntegrator*>(pCommand);
+
+#if EnableParallelSimBox == SimMPSDisabled
+	if(GetSimIdentifier() == DPD)
+	{
+		const zString name = pCmd->GetIntegrator();
+
+		long integrator = CCNTCell::DPDVelocityVerlet;
+
+		if(name == "Shardlow")
+		{
+			integrator = CCNTCell::DPDShardlow;
+		}
+		else if(name == "LoweAndersen")
+		{
+			integrator = CCNTCell::DPDLoweAndersen;
+		}
+
+		IModifyIntegration()->SetDPDIntegrator(integrator);
+
+		new CLogSetDPDIntegrator(m_SimTime, name);
+	}
+	else
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+	}
+#else
+	new CLogCommandFailed(m_SimTime, pCmd);
+#endif
+}
+
+// Handler function to implement a ccSetForcePrecision command that selects
+// whether the non-bonded bead-bead forces are calculated in double or mixed
+// precision. The mixed-precision loop is implemented by the cell-sorted bead
+// store, so the command fails if the store is not compiled in or is not
+// used by the current simulation type. The store falls back to the double
+// precision loop if a Verlet skin is set, beads have radii, or there are
+// fewer than 3 CNT cells in any dimension, so we log the precision that is
+// actually used as well as the one requested.
+
+void CSimBox::SetForcePrecision(const xxCommand* const pCommand)
+{
+	const ccSetForcePrecision* const pCmd = dynamic_cast<const ccSetForcePrecision*>(pCommand);
+
+#if EnableCellBeadStore == SimMiscEnabled
+	if(m_pBeadStore)
+	{
+		const zString name = pCmd->GetPrecision();
+
+		m_pBeadStore->SetMixedPrecision(name == "Mixed");
+
+		new CLogSetForcePrecision(m_SimTime, name, m_pBeadStore->IsMixedKernel() ? "Mixed" : "Double");
+	}
+	else
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+	}
+#else
+	new CLogCommandFailed(m_SimTime, pCmd);
+#endif
+}
+
+// Handler function to implement a ccSetThreadTotal command that sets the 
+// number of threads used to calculate the non-bonded bead-bead forces in a
+// serial run. The threads operate on the cell-sorted bead store, so the 
+// command fails if the store is not compiled in or is not used by the 
+// current simulation type. Setting the number of threads to one restores
+// the single-threaded force loop. It also fails in a simulation that is part 
+// of a CEnsemble, as the ensemble already runs one simulation per thread.
+
+void CSimBox::SetThreadTotal(const xxCommand* const pCommand)
+{
+	const ccSetThreadTotal* const pCmd = dynamic_cast<const ccSetThreadTotal*>(pCommand);
+
+#if EnableCellBeadStore == SimMiscEnabled
+	if(m_pBeadStore && !CEnsemble::IsReplicaThread())
+	{
+		const long threads = pCmd->GetThreadTotal();
+
+		m_pBeadStore->SetThreadTotal(threads);
+		ISimState::SetThreadTotal(threads);
+
+		new CLogSetThreadTotal(m_SimTime, threads);
+	}
+	else
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+	}
+#else
+	new CLogCommandFailed(m_SimTime, pCmd);
+#endif
+}
+
+// Handler function to implement a ccSetVerletSkin command that sets the 
+// skin of the Verlet pair list used to calculate the non-bonded bead-bead 
+// forces. The list is held by the cell-sorted bead store, so the command 
+// fails if the store is not compiled in or is not used by the current 
+// simulation type. A zero skin restores the cell-based force loop.
+
+void CSimBox::SetVerletSkin(const xxCommand* const pCommand)
+{
+	const ccSetVerletSkin* const pCmd = dynamic_cast<const ccSetVerletSkin*>(pCommand);
+
+#if EnableCellBeadStore == SimMiscEnabled
+	if(m_pBeadStore)
+	{
+		const double skin = pCmd->GetSkin();
+
+		m_pBeadStore->SetVerletSkin(skin);
+		ISimState::SetVerletSkin(skin);
+
+		new CLogSetVerletSkin(m_SimTime, skin);
+	}
+	else
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+	}
+#else
+	new CLogCommandFailed(m_SimTime, pCmd);
+#endif
+}
+
+// Handler function to implement a ccSetChargedBeadCutoff command that sets the
+// cutoff distance of the screened charge force between charged beads. A 
+// positive cutoff replaces the calculation over all pairs of charged beads by
+// a cell list that only finds the pairs within the cutoff; a zero cutoff 
+// restores the all-pairs calculation. The command fails if the charged bead 
+// classes are not compiled in.
+
+void CSimBox::SetChargedBeadCutoff(const xxCommand* const pCommand)
+{
+	const ccSetChargedBeadCutoff* const pCmd = dynamic_cast<const ccSetChargedBeadCutoff*>(pCommand);
+
+#if EnableMiscClasses == SimMiscEnabled
+	const double cutoff = pCmd->GetCutoff();
+
+	if(m_pChargedBeadCellList)
+	{
+		delete m_pChargedBeadCellList;
+		m_pChargedBeadCellList = 0;
+	}
+
+	if(cutoff > 0.0)
+	{
+		m_pChargedBeadCellList = new CChargedBeadCellList(cutoff, m_SimBoxXLength, m_SimBoxYLength, m_SimBoxZLength);
+	}
+
+	new CLogSetChargedBeadCutoff(m_SimTime, cutoff);
+#else
+	new CLogCommandFailed(m_SimTime, pCmd);
+#endif
+}
+
 // Handler function to implement a ccSetTimeStepSize command that changes 
 // the integration time step to a new value. The step size must be positive
 // definite (this is checked in the command class), and takes effect from 
@@ -5382,8 +5648,8 @@ void CSimBox::SetBondStrengthInTarget(const xxCommand* const pCommand)
 
 	const zString label			= pCmd->GetTargetLabel();
 	const zString bondName		= pCmd->GetName();
-	const double springConstant	= pCmd->GetSpringConstant();
-	const double unStrLength	= pCmd->GetUnstretchedLength();
+	double springConstant	= pCmd->GetSpringConstant();
+	double unStrLength	= pCmd->GetUnstretchedLength();
 
 	const long bondType	= GetBondTypeFromName(bondName);
 
@@ -5398,10 +5664,11 @@ void CSimBox::SetBondStrengthInTarget(const xxCommand* const pCommand)
 	if(pCmdTarget && !pCmdTarget->IsComposite())
 	{
 
-#if SimIdentifier == MD
-		springConstant *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
-		unStrLength    /= GetLengthScale();
-#endif
+		if(GetSimIdentifier() == MD)
+		{
+			springConstant *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
+			unStrLength    /= GetLengthScale();
+		}
 
 		PolymerVector vTargetPolymers = pCmdTarget->GetPolymers();
 
@@ -5476,7 +5743,7 @@ void CSimBox::SetBondStiffnessInTarget(const xxCommand* const pCommand)
 
     const zString label            = pCmd->GetTargetLabel();
     const zString bondPairName     = pCmd->GetName();
-    const double modulus           = pCmd->GetBendingModulus();
+    double modulus                 = pCmd->GetBendingModulus();
     const double phi0              = pCmd->GetPhi0();
 
     const long bondPairType        = GetBondPairTypeFromName(bondPairName);
@@ -5492,9 +5759,10 @@ void CSimBox::SetBondStiffnessInTarget(const xxCommand* const pCommand)
     if(pCmdTarget && !pCmdTarget->IsComposite())
     {
 
-#if SimIdentifier == MD
-        modulus /= GetEnergyScale();
-#endif
+        if(GetSimIdentifier() == MD)
+        {
+            modulus /= GetEnergyScale();
+        }
 
         PolymerVector vTargetPolymers = pCmdTarget->GetPolymers();
 
@@ -5878,17 +6146,20 @@ mpsSimBox* CSimBox::GetParallelSimBox() const
 // This is used to avoid having to store a container of bead pointers that
 // must be updated continually during a parallel run. As reconstructing the
 // container is expensive, it should only be used in commands or other infrequently
-// executed functions.
+// executed functions. Code that only needs to visit the beads should use
+// a CBeadRange instead as it does not copy them.
 
 AbstractBeadVector CSimBox::GetAllBeadsInCNTCells()
 {
+	const CBeadRange vRange(m_vCNTCells);
+
     AbstractBeadVector vBeads;
-    vBeads.clear();
+    vBeads.reserve(vRange.size());
 
 	for(CNTCellIterator iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	{
-        BeadList lBeads = (*iterCell)->GetBeads();
-        copy(lBeads.begin(), lBeads.end(), back_inserter(vBeads));
+        const BeadList& rlBeads = (*iterCell)->GetBeadList();
+        vBeads.insert(vBeads.end(), rlBeads.begin(), rlBeads.end());
     }
 
     return vBeads;
@@ -15,7 +15,11 @@
 // Forward declarations
 
 class CNanoparticle;
+class CChargedBeadCellList;
 
+#if EnableCellBeadStore == SimMiscEnabled
+class CCNTCellBeadStore;
+#endif
 
 #if EnableParallelSimBox == SimMPSEnabled
 // Forward declarations and parallel include files
@@ -586,11 +590,16 @@ private:
 	virtual void					   SetBondStrengthbyType(const xxCommand* const pCommand);
 	virtual void		   SetBondStrengthByPositionInTarget(const xxCommand* const pCommand);
 	virtual void					 SetBondStrengthInTarget(const xxCommand* const pCommand);
+	virtual void						SetChargedBeadCutoff(const xxCommand* const pCommand);
 	virtual void							 SetCommandTimer(const xxCommand* const pCommand);
 	virtual void						   SetDPDBeadConsInt(const xxCommand* const pCommand);
 	virtual void					 SetDPDBeadConsIntByType(const xxCommand* const pCommand);
 	virtual void						   SetDPDBeadDissInt(const xxCommand* const pCommand);
+	virtual void						    SetDPDIntegrator(const xxCommand* const pCommand);
 	virtual void					 SetDPDBeadDissIntByType(const xxCommand* const pCommand);
+	virtual void						   SetForcePrecision(const xxCommand* const pCommand);
+	virtual void							  SetThreadTotal(const xxCommand* const pCommand);
+	virtual void							   SetVerletSkin(const xxCommand* const pCommand);
 	virtual void							 SetTimeStepSize(const xxCommand* const pCommand);
 	virtual void								   SineForce(const xxCommand* const pCommand);
 	virtual void						   SineForceOnTarget(const xxCommand* const pCommand);
@@ -645,6 +654,7 @@ private:
 	// Functions to evolve a serial simulation
 
 	void Evolve();					// Calls CCNTCell functions to integrate equations of motion
+	void UpdateNonBondedForces();	// Calculates the pairwise bead forces in the CNT cells
 	void CNTCellCheck();			// Check that beads are in the correct cells
 	void AddBodyForce();			// Add the external body force to all affected beads
 	void AddBondForces();			// Add bond forces to the beads in polymers
@@ -659,7 +669,7 @@ private:
 
 private:
 
-	static CSimBox* m_pInstance;	// Pointer to the single instance of the CSimBox class
+	static thread_local CSimBox* m_pInstance;	// Pointer to the single instance of the CSimBox class
 
 #if EnableShadowSimBox == SimACNEnabled
     // Pointer to the shadow SimBox if it has been created and ACN functionality 
@@ -676,6 +686,12 @@ private:
     mpsSimBox* m_pParallel;   
 #endif
 
+#if EnableCellBeadStore == SimMiscEnabled
+    // Contiguous, cell-sorted copy of the bead data used by the DPD force loop.
+
+    CCNTCellBeadStore* m_pBeadStore;
+#endif
+
 
 	// ****************************************
 	// Containers holding the set of events, commands etc that are
@@ -738,6 +754,8 @@ private:
 
 	zLongVector			m_vChargedBeadTypes;	// Types of charged beads
 	zLongVector			m_vChargedBeadTotals;	// No of each charged bead type
+
+	CChargedBeadCellList* m_pChargedBeadCellList;	// Cell list for charged beads: null if all pairs are used
 	
 	// Local data relating to the stress tensor calculation in curvilinear coordinates.
 	
@@ -86,6 +86,10 @@
 //
 //  11/02/25    I removed all legacy platforms except for the standard linux/mac version from xxBase.h
 //
+//  18/10/26    The simulation type is now read from the first token of the control 
+//              data file, and UseDPDBeadRadii is replaced by the optional BeadRadii
+//              keyword, so one executable runs DPD, MD and BD simulations. 
+//
 // **********************************************************************
 
 // True/false flags used to distinguish binary compilation options.
@@ -94,14 +98,15 @@
 #define SimulationDisabled  2
 
 // ***********************
-// Simulation type
+// Simulation types. The type of a run is selected by the first token of its
+// control data file and is returned by xxBase::GetSimIdentifier(). The force
+// kernels for each type are specialised at compile time and one is chosen
+// when the simulation starts (see CCNTCell::SelectForceKernel()).
 
 #define DPD	1
 #define MD  2
 #define BD  3
 
-#define SimIdentifier  DPD
-
 
 // ***********************
 // Simulation dimension
@@ -149,12 +154,6 @@
 #define NEWPLATFORM10 	21
 
 
-// ***********************
-// Uncomment the next variable to allow each DPD bead type to have an explicit
-// radius of interaction. This is not relevant for MD simulations.
-
-//#define UseDPDBeadRadii 1
-
 // Uncomment the next pragma to avoid some warnings when compiling on a PC
 
 //#pragma warning (disable:4786)
@@ -11,6 +11,10 @@
 //	20/3/06    Baseline version.
 //  04/05/06   I copied the CW55MAC flags to XCMAC.
 //  04/05/10   I added a flag to toggle the calculation of the stress tensor in non-cartesian coordinate systems.
+//  18/10/26   I added a flag to toggle the cell-sorted structure-of-arrays bead store used by the DPD force loop.
+//  18/10/26   I added a flag to toggle the AVX2 pair kernel used by the bead store when the CPU supports it.
+//  18/10/26   I added a debug flag to check that the beads are in the correct CNT cells every time step.
+//  18/10/26   I added a flag to toggle writing current state snapshots on a background thread.
 // **********************************************************************
 
 #define SimMiscEnabled	1
@@ -18,4 +22,8 @@
 
 	#define EnableMiscClasses               SimMiscEnabled
 	#define EnableStressTensorSphere        SimMiscDisabled
+	#define EnableCellBeadStore             SimMiscEnabled
+	#define EnableSIMDPairKernel            SimMiscEnabled
+	#define EnableCNTCellCheck              SimMiscDisabled
+	#define EnableAsyncStateWriter          SimMiscEnabled
 
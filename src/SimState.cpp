@@ -53,9 +53,12 @@ CSimState::CSimState(ISimulation* pISim, const CInputData& rInputData) : m_pISim
 													m_bIsBondStressAdded(true),
 													m_bIsBondPairStressAdded(true),
 													m_bEnergyOutput(false),
+													m_ThreadTotal(1),
+													m_VerletSkin(0.0),
 													m_bIsDPDBeadConsForceZero(false),
 													m_bIsDPDBeadForceZero(false),
 													m_bIsDPDBeadThermostatZero(false),
+													m_DPDIntegrator(CCNTCell::DPDVelocityVerlet),
 													m_bRenormaliseMomenta(false)
 {
 	// Initialise the random number generator prior to any possible use. A valid 
@@ -84,18 +87,18 @@ CSimState::CSimState(ISimulation* pISim, const CInputData& rInputData) : m_pISim
 	// so that the integration scheme has efficient access to them when
 	// calculating the forces between beads.
 
-#if SimIdentifier == BD
-// We use the same forces for BD as in DPD for now
+	if(GetSimIdentifier() == BD)
+	{
+		// We use the same forces for BD as in DPD for now
+
 		SetBDBeadIntArrays(rInputData.GetDPDBeadConsIntArray(), 
 						   rInputData.GetDPDBeadDissIntArray());
-
-#elif SimIdentifier == DPD
-
-// We distringuish between a DPD simulation of a liquid-gas system and
-// the standard liquid system. Even if the LG system is enabled, the input
-// may be just the standard DPD one.
-
-#if EnableDPDLG == ExperimentEnabled
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		// We distringuish between a DPD simulation of a liquid-gas system and
+		// the standard liquid system. Even if the LG system is enabled, the input
+		// may be just the standard DPD one.
 
         if(rInputData.IsDPDLG())
         {
@@ -108,32 +111,37 @@ CSimState::CSimState(ISimulation* pISim, const CInputData& rInputData) : m_pISim
             SetDPDBeadIntArrays(rInputData.GetDPDBeadConsIntArray(), 
 							    rInputData.GetDPDBeadDissIntArray());
         }
-#elif EnableDPDLG == ExperimentDisabled
-        SetDPDBeadIntArrays(rInputData.GetDPDBeadConsIntArray(), 
-							rInputData.GetDPDBeadDissIntArray());
-#endif
-
-#elif SimIdentifier == MD
-
+	}
+	else if(GetSimIdentifier() == MD)
+	{
         SetMDBeadIntArrays(rInputData.GetMDBeadLJDepthArray(), 
 						   rInputData.GetMDBeadLJRangeArray(),
 						   rInputData.GetMDBeadSCDepthArray(), 
-						   rInputData.GetMDBeadSCRangeArray())
+						   rInputData.GetMDBeadSCRangeArray());
+	}
 
-#endif
+	// Choose the force kernels for the simulation type and bead radii flag
+	// read from the control data file.
 
+	CCNTCell::SetBeadRadii(rInputData.UsesBeadRadii());
+	CCNTCell::SelectForceKernel();
 
 	// If we are doing an MD simulation then set the momenta renormalisation on, 
 	// but turn it off for DPD. The default case can be overridden by using
 	// a RenormaliseMomenta command.
 
-#if SimIdentifier == BD
-	m_bRenormaliseMomenta = false;
-#elif SimIdentifier == DPD
-	m_bRenormaliseMomenta = false;
-#elif SimIdentifier == MD
-	m_bRenormaliseMomenta = true;
-#endif
+	if(GetSimIdentifier() == BD)
+	{
+		m_bRenormaliseMomenta = false;
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		m_bRenormaliseMomenta = false;
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		m_bRenormaliseMomenta = true;
+	}
 
 }
 
@@ -185,9 +193,12 @@ CSimState::CSimState(const CInputData& rInputData) : m_pISimulation(0),
 													m_bIsBondStressAdded(true),
 													m_bIsBondPairStressAdded(true),
 													m_bEnergyOutput(false),
+													m_ThreadTotal(1),
+													m_VerletSkin(0.0),
 													m_bIsDPDBeadConsForceZero(false),
 													m_bIsDPDBeadForceZero(false),
 													m_bIsDPDBeadThermostatZero(false),
+													m_DPDIntegrator(CCNTCell::DPDVelocityVerlet),
 													m_bRenormaliseMomenta(false)
 {
 	// Initialise the random number generator prior to any possible use. A valid 
@@ -216,36 +227,45 @@ CSimState::CSimState(const CInputData& rInputData) : m_pISimulation(0),
 	// so that the integration scheme has efficient access to them when
 	// calculating the forces between beads.
 
-#if SimIdentifier == BD
-// We use the same forces for BD as in DPD for now
+	if(GetSimIdentifier() == BD)
+	{
+		// We use the same forces for BD as in DPD for now
+
 		SetBDBeadIntArrays(rInputData.GetDPDBeadConsIntArray(), 
 						   rInputData.GetDPDBeadDissIntArray());
-
-#elif SimIdentifier == DPD
-
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
         SetDPDBeadIntArrays(rInputData.GetDPDBeadConsIntArray(), 
 							rInputData.GetDPDBeadDissIntArray());
-
-#elif SimIdentifier == MD
-
+	}
+	else if(GetSimIdentifier() == MD)
+	{
         SetMDBeadIntArrays(rInputData.GetMDBeadLJDepthArray(), 
 						   rInputData.GetMDBeadLJRangeArray(),
 						   rInputData.GetMDBeadSCDepthArray(), 
-						   rInputData.GetMDBeadSCRangeArray())
+						   rInputData.GetMDBeadSCRangeArray());
+	}
 
-#endif
+	CCNTCell::SetBeadRadii(rInputData.UsesBeadRadii());
+	CCNTCell::SelectForceKernel();
 
 	// If we are doing an MD simulation then set the momenta renormalisation on, 
 	// but turn it off for DPD. The default case can be overridden by using
 	// a RenormaliseMomenta command.
 
-#if SimIdentifier == BD
-	m_bRenormaliseMomenta = false;
-#elif SimIdentifier == DPD
-	m_bRenormaliseMomenta = false;
-#elif SimIdentifier == MD
-	m_bRenormaliseMomenta = true;
-#endif
+	if(GetSimIdentifier() == BD)
+	{
+		m_bRenormaliseMomenta = false;
+	}
+	else if(GetSimIdentifier() == DPD)
+	{
+		m_bRenormaliseMomenta = false;
+	}
+	else if(GetSimIdentifier() == MD)
+	{
+		m_bRenormaliseMomenta = true;
+	}
 
 }
 
@@ -375,6 +395,24 @@ void CSimState::SetEnergyOutput(bool bEnergy)
 	m_bEnergyOutput = bEnergy;
 }
 
+// Function to set the number of threads used to calculate the non-bonded
+// bead-bead forces. This is set by the SetThreadTotal command and only
+// affects a serial run: the default of 1 uses no additional threads.
+
+void CSimState::SetThreadTotal(long threads)
+{
+	m_ThreadTotal = threads;
+}
+
+// Function to set the skin of the Verlet pair list used to calculate the 
+// non-bonded bead-bead forces. This is set by the SetVerletSkin command: 
+// the default of 0 uses the cell-based force loop without a pair list.
+
+void CSimState::SetVerletSkin(double skin)
+{
+	m_VerletSkin = skin;
+}
+
 // Function to toggle the bead contribution to the stress tensor analysis
 // on and off.
 
@@ -444,14 +482,12 @@ void CSimState::SetDPDDissInt(long firstType, long secondType, double newValue)
 
 void CSimState::SetDPDLGInt(long firstType, long secondType, double newValue)
 {
-#if EnableDPDLG == ExperimentEnabled
 	if(0 <= firstType  && firstType  < GetBeadTypeTotal() &&
 	   0 <= secondType && secondType < GetBeadTypeTotal())
 	{
 		CCNTCell::SetDPDBeadLGInt(firstType, secondType, newValue);
         m_rInitialState.SetDPDBeadLGInt(firstType, secondType, newValue);
 	}
-#endif
 }
 
 // Function used to add a new bead type dynamically as the result of a
@@ -568,6 +604,18 @@ void CSimState::SetTimeStep(double dt)
 	}
 }
 
+// Function used to select the scheme that integrates the DPD equations of
+// motion as the result of a ccSetDPDIntegrator command. The CCNTCell class
+// holds the scheme and the dissipation parameters it uses in static member
+// variables; we store the scheme here so that it can be queried.
+
+void CSimState::SetDPDIntegrator(long integrator)
+{
+	m_DPDIntegrator = integrator;
+
+	CCNTCell::SetDPDIntegrator(integrator);
+}
+
 // Function used to set the simulation time to a new value as the result of
 // a ccExtendTotalTime command. The new time must be greater than or equal to 
 // the current time or the command is ignored.
@@ -688,9 +736,7 @@ void CSimState::SetDPDBeadIntArrays(const zArray2dDouble* pvvConsInt, const zArr
 
 void CSimState::SetDPDBeadIntArrays(const zArray2dDouble* pvvConsInt, const zArray2dDouble* pvvDissInt, const zArray2dDouble* pvvLGInt)
 {
-#if EnableDPDLG == ExperimentEnabled
 	CCNTCell::SetDPDBeadStructure(pvvConsInt, pvvDissInt, pvvLGInt);
-#endif
 }
 
 // Function to copy the MD bead-bead interaction parameters into the CCTNCell 
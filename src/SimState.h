@@ -184,9 +184,18 @@ public:
 
 	inline bool IsEnergyOutputOn()			const {return m_bEnergyOutput;}
 
+	// Function returning the number of threads used for the non-bonded forces
+
+	inline long GetThreadTotal()			const {return m_ThreadTotal;}
+
+	// Function returning the skin of the Verlet pair list: zero if not used
+
+	inline double GetVerletSkin()			const {return m_VerletSkin;}
+
 	// DPD only functions
 
 	inline bool IsDPDBeadForceZero()		const {return m_bIsDPDBeadForceZero;}
+	inline long GetDPDIntegrator()			const {return m_DPDIntegrator;}
 
 	// MD only functions
 
@@ -212,6 +221,8 @@ public:
 	void SetRestartPeriod(long period);
 	void SetSamplePeriod(long period);
 	void SetShearOn(bool bShear);
+	void SetThreadTotal(long threads);
+	void SetVerletSkin(double skin);
 	void SetWallOn(bool bWall);
 
 	// ****************************************
@@ -247,6 +258,7 @@ private:
 
 	// IModifySimStateIntegration
 
+	void SetDPDIntegrator(long integrator);	// Changes the DPD integration scheme
 	void SetTimeStep(double dt);		// Changes the integration time step
 	void SetTotalTime(long newTime);	// Changes the total simulation time
 	bool ToggleDPDBeadForces();			// Turns DPD bead-bead interactions on/off
@@ -313,12 +325,21 @@ private:
 
 	bool m_bEnergyOutput;
 
+	// Number of threads used to calculate the non-bonded forces in a serial run
+
+	long m_ThreadTotal;
+
+	// Skin of the Verlet pair list used for the non-bonded forces: zero if not used
+
+	double m_VerletSkin;
+
 	// ****************************************
 	// DPD only data
 
 	bool m_bIsDPDBeadConsForceZero;
 	bool m_bIsDPDBeadForceZero;
 	bool m_bIsDPDBeadThermostatZero;
+	long m_DPDIntegrator;			// One of the CCNTCell::DPDIntegrator schemes
 
 	// ****************************************
 	// MD only data
@@ -49,7 +49,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance.
 
-ISimulation* CSimulation::m_pInstance = 0;
+thread_local ISimulation* CSimulation::m_pInstance = 0;
 
 // Public member function to create a single instance of the CSimulation class.
 
@@ -478,9 +478,10 @@ bool CSimulation::Run()
 
 #elif EnableParallelSimBox == SimMPSDisabled
 
-#if SimIdentifier == MD
-		m_pISimBox->RunMCRelaxation();
-#endif
+		if(GetSimIdentifier() == MD)
+		{
+			m_pISimBox->RunMCRelaxation();
+		}
 
 		m_pISimBox->Run();
 #endif
@@ -56,7 +56,7 @@ public:
 
 private:
 
-	static ISimulation* m_pInstance;		
+	static thread_local ISimulation* m_pInstance;		
 
 	
 	// ****************************************
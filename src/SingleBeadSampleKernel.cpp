@@ -0,0 +1,135 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// SingleBeadSampleKernel.cpp: implementation of the CSingleBeadSampleKernel class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "SingleBeadSampleKernel.h"
+#include "AbstractBead.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CSingleBeadSampleKernel::CSingleBeadSampleKernel() : m_TypeTotal(0), m_BlockSize(0), m_ThreadTotal(0)
+{
+}
+
+CSingleBeadSampleKernel::~CSingleBeadSampleKernel()
+{
+}
+
+// Function to set the number of bead types whose MSD is accumulated. It must
+// be called again if new bead types are created during a run.
+
+void CSingleBeadSampleKernel::SetBeadTypeTotal(long typeTotal)
+{
+	m_TypeTotal = typeTotal;
+}
+
+// Function to zero the sums for each thread. Each thread's block is rounded 
+// up to a multiple of 8 doubles so that threads do not write to the same 
+// cache line.
+
+void CSingleBeadSampleKernel::StartSample(long threadTotal)
+{
+	m_ThreadTotal = threadTotal;
+	m_BlockSize   = 8*((MSD + m_TypeTotal + 7)/8);
+
+	m_vSums.assign(m_ThreadTotal*m_BlockSize, 0.0);
+	m_vBeadMSD.assign(m_TypeTotal, 0.0);
+}
+
+// Function to add a bead's contribution to the sums. We must use the 
+// un-periodic boundary positions for the diffusion coefficient calculation.
+
+void CSingleBeadSampleKernel::SampleBead(long thread, const CAbstractBead* const pBead)
+{
+	double* const pSums = GetThreadSums(thread);
+
+	const double* const pPos = pBead->m_Pos;
+	const double* const pMom = pBead->m_Mom;
+
+	double dPos[3];
+
+	dPos[0]	=  pBead->m_unPBCPos[0] - pBead->GetInitialXPos();
+	dPos[1]	=  pBead->m_unPBCPos[1] - pBead->GetInitialYPos();
+	dPos[2]	=  pBead->m_unPBCPos[2] - pBead->GetInitialZPos();
+
+	pSums[MSD + pBead->GetType()] += dPos[0]*dPos[0] + dPos[1]*dPos[1] + dPos[2]*dPos[2];
+
+	pSums[CMPos]   += pPos[0];
+	pSums[CMPos+1] += pPos[1];
+	pSums[CMPos+2] += pPos[2];
+
+	pSums[CMMom]   += pMom[0];
+	pSums[CMMom+1] += pMom[1];
+	pSums[CMMom+2] += pMom[2];
+
+	pSums[SqMom]   += pMom[0]*pMom[0];
+	pSums[SqMom+1] += pMom[1]*pMom[1];
+	pSums[SqMom+2] += pMom[2]*pMom[2];
+
+	pSums[AngMom]   +=  pPos[1]*pMom[2] - pPos[2]*pMom[1];
+	pSums[AngMom+1] += -pPos[0]*pMom[2] + pPos[2]*pMom[0];
+	pSums[AngMom+2] +=  pPos[0]*pMom[1] - pPos[1]*pMom[0];
+
+#if SimDimension == 2
+
+	pSums[Stress]   += pBead->m_Stress[0];
+	pSums[Stress+1] += pBead->m_Stress[1];
+	pSums[Stress+3] += pBead->m_Stress[3];
+	pSums[Stress+4] += pBead->m_Stress[4];
+
+#elif SimDimension == 3
+
+	for(short int i=0; i<9; i++)
+	{
+		pSums[Stress+i] += pBead->m_Stress[i];
+	}
+
+	pSums[Inertia]   +=  pPos[1]*pPos[1] + pPos[2]*pPos[2];
+	pSums[Inertia+1] += -pPos[0]*pPos[1];
+	pSums[Inertia+2] += -pPos[0]*pPos[2];
+	pSums[Inertia+4] +=  pPos[0]*pPos[0] + pPos[2]*pPos[2];
+	pSums[Inertia+5] += -pPos[1]*pPos[2];
+	pSums[Inertia+8] +=  pPos[0]*pPos[0] + pPos[1]*pPos[1];
+
+#endif
+}
+
+// Function to add the sums of threads 1 to N-1 to those of thread 0 in thread
+// order, so that the totals only depend on the number of threads.
+
+void CSingleBeadSampleKernel::EndSample()
+{
+	double* const pTotals = GetThreadSums(0);
+
+	for(long thread=1; thread<m_ThreadTotal; thread++)
+	{
+		const double* const pSums = GetThreadSums(thread);
+
+		for(long i=0; i<MSD+m_TypeTotal; i++)
+		{
+			pTotals[i] += pSums[i];
+		}
+	}
+
+	for(long type=0; type<m_TypeTotal; type++)
+	{
+		m_vBeadMSD[type] = pTotals[MSD + type];
+	}
+}
@@ -0,0 +1,74 @@
+// SingleBeadSampleKernel.h: interface for the CSingleBeadSampleKernel class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_SINGLEBEADSAMPLEKERNEL_H__6F2B8E41_9D35_4C07_B1A6_E84D3C7025F9__INCLUDED_)
+#define AFX_SINGLEBEADSAMPLEKERNEL_H__6F2B8E41_9D35_4C07_B1A6_E84D3C7025F9__INCLUDED_
+
+
+#include "ISampleKernel.h"
+#include "xxBase.h"
+
+// Sample kernel that accumulates the sums over all beads needed by the 
+// CMonitor's global observables: the mean-square displacement of each bead
+// type, the centre of mass position and momentum, the total squared and 
+// angular momentum, and the bead contributions to the stress and inertia 
+// tensors. The sums are returned unnormalised: the CMonitor divides them 
+// by the bead total and SimBox volume as before.
+
+class CSingleBeadSampleKernel : public ISampleKernel
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CSingleBeadSampleKernel();
+
+	virtual ~CSingleBeadSampleKernel();
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual void StartSample(long threadTotal);
+	virtual void SampleBead(long thread, const CAbstractBead* const pBead);
+	virtual void EndSample();
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void SetBeadTypeTotal(long typeTotal);
+
+	inline const zDoubleVector& GetBeadMSD()		const {return m_vBeadMSD;}
+	inline const double*		GetCMPos()			const {return &m_vSums[CMPos];}
+	inline const double*		GetCMMom()			const {return &m_vSums[CMMom];}
+	inline const double*		GetTotalSqMom()		const {return &m_vSums[SqMom];}
+	inline const double*		GetTotalAngMom()	const {return &m_vSums[AngMom];}
+	inline const double*		GetTotalStress()	const {return &m_vSums[Stress];}
+	inline const double*		GetTotalInertia()	const {return &m_vSums[Inertia];}
+
+	// ****************************************
+	// Private functions
+private:
+
+	// Offsets of the sums in each thread's block of m_vSums: the MSDs for each
+	// bead type follow the fixed-size sums.
+
+	enum {CMPos = 0, CMMom = 3, SqMom = 6, AngMom = 9, Stress = 12, Inertia = 21, MSD = 30};
+
+	inline double* GetThreadSums(long thread) {return &m_vSums[thread*m_BlockSize];}
+
+	// ****************************************
+	// Data members
+private:
+
+	long m_TypeTotal;			// Number of bead types
+	long m_BlockSize;			// Number of sums per thread
+	long m_ThreadTotal;			// Number of threads in the current sample
+
+	zDoubleVector m_vSums;		// Sums for each thread: thread 0 holds the totals after EndSample()
+	zDoubleVector m_vBeadMSD;	// Total MSD for each bead type
+};
+
+#endif // !defined(AFX_SINGLEBEADSAMPLEKERNEL_H__6F2B8E41_9D35_4C07_B1A6_E84D3C7025F9__INCLUDED_)
@@ -39,6 +39,11 @@ public:
 	// PVFs that must be overridden by all derived classes
 public:
 
+	// The polymer data are read from the SimBox when the header is written
+
+	virtual bool UsesSimBox() const
+	{ return true; }
+
 	// Function to ensure that derived classes can write their data to file
 
 	virtual void SerializeHeader(zOutStream& os, const long beadTotal);
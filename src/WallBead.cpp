@@ -47,15 +47,10 @@ CWallBead::CWallBead(CAbstractBead& oldBead)
 		m_Pos[i]		= 0.0;			// CAbstractBead members
 		m_Mom[i]		= 0.0;
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_Stress[3*i]	= 0.0;
-		m_Stress[3*i+1]	= 0.0;
-		m_Stress[3*i+2]	= 0.0;
 	}
 }
 
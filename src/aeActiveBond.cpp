@@ -23,6 +23,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "aeBondConnection.h"
 #include "aeBondOnCondition.h"
 #include "aeBondOffCondition.h"
+#include "aeBondOffRate.h"
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -265,6 +266,43 @@ bool aeActiveBond::TailOffCondition() const
 	return m_pOff->ActivateTail(this);
 }
 
+// Functions that return the probability with which the HeadOffCondition() and
+// TailOffCondition() functions succeed, or -1 if the bond's off condition is
+// not a fixed probability per trial, e.g., it depends on the bond's position.
+
+double aeActiveBond::HeadOffProbability() const
+{
+	const aeBondOffRate* const pOffRate = dynamic_cast<const aeBondOffRate*>(m_pOff);
+
+	return (pOffRate ? pOffRate->GetHeadProbability() : -1.0);
+}
+
+double aeActiveBond::TailOffProbability() const
+{
+	const aeBondOffRate* const pOffRate = dynamic_cast<const aeBondOffRate*>(m_pOff);
+
+	return (pOffRate ? pOffRate->GetTailProbability() : -1.0);
+}
+
+// VFs that allow the ACN to schedule the unbinding events of a polymer's end
+// bonds. Derived classes whose Deactivate() function is a fixed-probability 
+// trial return its probability, and an upper bound on the values it can take 
+// as the bond's internal state changes. The unbinding events sample their 
+// trials using the upper bound and accept a successful trial with the ratio
+// of the current probability to the bound, so that changes of state between
+// trials do not require the events to be rescheduled. By default, 
+// Deactivate() is called every time step.
+
+double aeActiveBond::GetOffProbability() const
+{
+	return -1.0;
+}
+
+double aeActiveBond::GetMaxOffProbability() const
+{
+	return GetOffProbability();
+}
+
 // Function to add a new bond adjacent to the current bond's head. 
 //
 // We check that the current bond is not already connected at its head and that
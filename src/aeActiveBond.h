@@ -48,6 +48,13 @@ public:
 	virtual bool	Activate(aeActiveBond* const pTargetBond) = 0;
 	virtual bool	Deactivate()							  = 0;
 
+	// Functions used by the ACN to schedule the unbinding of a polymer's end
+	// bond instead of calling Deactivate() every time step. They return a 
+	// negative value if Deactivate() is not a fixed-probability trial.
+
+	virtual double	GetOffProbability() const;
+	virtual double	GetMaxOffProbability() const;
+
 	// ****************************************
 	// Public access functions
 public:
@@ -127,6 +134,9 @@ protected:
 	bool HeadOffCondition() const;
 	bool TailOffCondition() const;
 
+	double HeadOffProbability() const;
+	double TailOffProbability() const;
+
 	// Protected data members
 protected:
 
@@ -0,0 +1,440 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// aeActiveBondHash.cpp: implementation of the aeActiveBondHash class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "aeActiveBondHash.h"
+#include "aeActiveBond.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// The hash cells are normally the CNT cells of the SimBox, so the SimBox
+// side lengths are the products of the number of cells and their widths.
+
+aeActiveBondHash::aeActiveBondHash(long nx, long ny, long nz, double xw, double yw, double zw) : m_BondTotal(0),
+																								m_bStale(false)
+{
+	m_CellNo[0]    = nx;
+	m_CellNo[1]    = ny;
+	m_CellNo[2]    = nz;
+	m_CellWidth[0] = xw;
+	m_CellWidth[1] = yw;
+	m_CellWidth[2] = zw;
+
+	for(short int i=0; i<3; i++)
+	{
+		m_SimBoxLength[i]     = static_cast<double>(m_CellNo[i])*m_CellWidth[i];
+		m_HalfSimBoxLength[i] = 0.5*m_SimBoxLength[i];
+	}
+
+	m_vCellFirst.resize(m_CellNo[0]*m_CellNo[1]*m_CellNo[2], -1);
+
+	m_vBonds.clear();
+	m_vBondIds.clear();
+	m_vNetworks.clear();
+	m_vEntryCell.clear();
+	m_vEntryNext.clear();
+	m_vEntryPrev.clear();
+	m_vFreeSlots.clear();
+	m_vSlots.clear();
+	m_mNetworkTotals.clear();
+}
+
+// The hash does not own the bonds, so there is nothing to delete.
+
+aeActiveBondHash::~aeActiveBondHash()
+{
+}
+
+// Function to return the number of bonds belonging to one network.
+
+long aeActiveBondHash::GetBondTotal(const aeActiveCellNetwork* const pNetwork) const
+{
+	std::map<const aeActiveCellNetwork*, long>::const_iterator citerNetwork = m_mNetworkTotals.find(pNetwork);
+
+	if(citerNetwork != m_mNetworkTotals.end())
+		return citerNetwork->second;
+
+	return 0;
+}
+
+// Function to add a free bond belonging to a network to the hash. Both ends
+// of the bond are placed in the cells containing their beads. A bond that is
+// already in the hash is ignored. The bond's id is that of its tail monomer,
+// so the ids are distinct and bounded by the number of polymers.
+
+void aeActiveBondHash::AddBond(const aeActiveCellNetwork* const pNetwork, aeActiveBond* const pBond)
+{
+	const long id = pBond->GetId();
+
+	if(id >= static_cast<long>(m_vSlots.size()))
+	{
+		m_vSlots.resize(id+1, -1);
+	}
+	else if(m_vSlots[id] != -1)
+	{
+		return;
+	}
+
+	long slot = 0;
+
+	if(!m_vFreeSlots.empty())
+	{
+		slot = m_vFreeSlots.back();
+		m_vFreeSlots.pop_back();
+
+		m_vBonds[slot]    = pBond;
+		m_vBondIds[slot]  = id;
+		m_vNetworks[slot] = pNetwork;
+	}
+	else
+	{
+		slot = m_vBonds.size();
+
+		m_vBonds.push_back(pBond);
+		m_vBondIds.push_back(id);
+		m_vNetworks.push_back(pNetwork);
+
+		for(short int end=0; end<2; end++)
+		{
+			m_vEntryCell.push_back(-1);
+			m_vEntryNext.push_back(-1);
+			m_vEntryPrev.push_back(-1);
+		}
+	}
+
+	for(long entry=2*slot; entry<2*slot+2; entry++)
+	{
+		const CAbstractBead* const pBead = GetEntryBead(entry);
+
+		LinkEntry(entry, GetCellIndex(pBead->GetXPos(), pBead->GetYPos(), pBead->GetZPos()));
+	}
+
+	m_vSlots[id] = slot;
+	m_BondTotal++;
+	m_mNetworkTotals[pNetwork]++;
+}
+
+// Function to remove a bond from the hash when it binds into a polymer or is
+// destroyed. A bond that is not in the hash is ignored.
+
+void aeActiveBondHash::RemoveBond(const aeActiveBond* const pBond)
+{
+	const long id = pBond->GetId();
+
+	if(id < static_cast<long>(m_vSlots.size()) && m_vSlots[id] != -1)
+	{
+		RemoveSlot(m_vSlots[id]);
+	}
+}
+
+// Function to remove all the bonds belonging to a network when it is deleted
+// or its free bonds are reassigned. The bonds are not accessed as their 
+// monomers may already have been destroyed.
+
+void aeActiveBondHash::RemoveNetwork(const aeActiveCellNetwork* const pNetwork)
+{
+	for(long slot=0; slot<static_cast<long>(m_vBonds.size()); slot++)
+	{
+		if(m_vBonds[slot] && m_vNetworks[slot] == pNetwork)
+		{
+			RemoveSlot(slot);
+		}
+	}
+
+	m_mNetworkTotals.erase(pNetwork);
+}
+
+// Function called by the active SimBox after the beads have moved to show 
+// that the hash must be updated before it is next queried.
+
+void aeActiveBondHash::Invalidate()
+{
+	m_bStale = true;
+}
+
+// Function to move the ends of the bonds whose beads have changed cells since
+// the last update. It must be called before a query, and does nothing if the
+// beads have not moved since it was last called. It touches only the flat 
+// arrays and the beads' coordinates.
+
+void aeActiveBondHash::Update()
+{
+	if(!m_bStale)
+		return;
+
+	m_bStale = false;
+
+	for(long slot=0; slot<static_cast<long>(m_vBonds.size()); slot++)
+	{
+		if(m_vBonds[slot])
+		{
+			for(long entry=2*slot; entry<2*slot+2; entry++)
+			{
+				const CAbstractBead* const pBead = GetEntryBead(entry);
+
+				const long cell = GetCellIndex(pBead->GetXPos(), pBead->GetYPos(), pBead->GetZPos());
+
+				if(cell != m_vEntryCell[entry])
+				{
+					UnlinkEntry(entry);
+					LinkEntry(entry, cell);
+				}
+			}
+		}
+	}
+}
+
+// Function to return the free bond of a network whose specified end is 
+// closest to a point. The separations use the minimum image convention, as 
+// in IfActinAccess::GetNearbyMonomer(). The cells are searched in cubes of 
+// increasing size around the cell containing the point: once a cube of reach
+// n cells has been searched, any bond that has not been found is at least n
+// cell widths away, so the search stops when the nearest bond found so far
+// is closer than this or the cube covers the whole SimBox.
+//
+// If the network has no free bonds a null pointer is returned.
+
+aeActiveBond* aeActiveBondHash::GetNearestBond(const aeActiveCellNetwork* const pNetwork, BondEnd end,
+											   double x, double y, double z) const
+{
+	if(GetBondTotal(pNetwork) == 0)
+		return 0;
+
+	long centre[3];
+	GetCellCoords(x, y, z, centre);
+
+#if SimDimension == 2
+	const double minWidth = std::min(m_CellWidth[0], m_CellWidth[1]);
+#elif SimDimension == 3
+	const double minWidth = std::min(m_CellWidth[0], std::min(m_CellWidth[1], m_CellWidth[2]));
+#endif
+
+	aeActiveBond* pNearestBond = 0;
+	double minSquareSep = -1.0;
+
+	zLongVector vXCells, vYCells, vZCells;
+
+	for(long reach=1; ; reach*=2)
+	{
+		GetNeighbourIndices(centre[0], reach, m_CellNo[0], vXCells);
+		GetNeighbourIndices(centre[1], reach, m_CellNo[1], vYCells);
+		GetNeighbourIndices(centre[2], reach, m_CellNo[2], vZCells);
+
+		for(czLongVectorIterator iz=vZCells.begin(); iz!=vZCells.end(); iz++)
+		{
+			for(czLongVectorIterator iy=vYCells.begin(); iy!=vYCells.end(); iy++)
+			{
+				for(czLongVectorIterator ix=vXCells.begin(); ix!=vXCells.end(); ix++)
+				{
+					const long cell = *ix + m_CellNo[0]*(*iy + m_CellNo[1]*(*iz));
+
+					for(long entry=m_vCellFirst[cell]; entry!=-1; entry=m_vEntryNext[entry])
+					{
+						if(entry%2 == end && m_vNetworks[entry/2] == pNetwork)
+						{
+							const double sqSep = GetSquareSeparation(GetEntryBead(entry), x, y, z);
+
+							if(sqSep < minSquareSep || minSquareSep < 0.0)
+							{
+								minSquareSep = sqSep;
+								pNearestBond = m_vBonds[entry/2];
+							}
+						}
+					}
+				}
+			}
+		}
+
+		const bool bAllCells = static_cast<long>(vXCells.size()) == m_CellNo[0] &&
+							   static_cast<long>(vYCells.size()) == m_CellNo[1] &&
+							   static_cast<long>(vZCells.size()) == m_CellNo[2];
+
+		const double searched = static_cast<double>(reach)*minWidth;
+
+		if(bAllCells || (pNearestBond && minSquareSep <= searched*searched))
+			break;
+	}
+
+	return pNearestBond;
+}
+
+// Private helper function returning the bead that represents one end of a
+// bond: the head or tail bead of the bond's tail monomer.
+
+const CAbstractBead* aeActiveBondHash::GetEntryBead(long entry) const
+{
+	const aeActiveBond* const pBond = m_vBonds[entry/2];
+
+	if(entry%2 == Head)
+		return pBond->GetTailHeadBead();
+	else
+		return pBond->GetTailTailBead();
+}
+
+// Private helper functions to return the cell containing a point, and its
+// coordinates in the grid of cells. Points on the upper boundaries of the
+// SimBox are put in the last cell.
+
+long aeActiveBondHash::GetCellIndex(double x, double y, double z) const
+{
+	long coords[3];
+
+	GetCellCoords(x, y, z, coords);
+
+	return coords[0] + m_CellNo[0]*(coords[1] + m_CellNo[1]*coords[2]);
+}
+
+void aeActiveBondHash::GetCellCoords(double x, double y, double z, long coords[3]) const
+{
+	coords[0] = static_cast<long>(x/m_CellWidth[0]);
+	coords[1] = static_cast<long>(y/m_CellWidth[1]);
+
+#if SimDimension == 2
+	coords[2] = 0;
+#elif SimDimension == 3
+	coords[2] = static_cast<long>(z/m_CellWidth[2]);
+#endif
+
+	for(short int i=0; i<3; i++)
+	{
+		if(coords[i] < 0)
+			coords[i] = 0;
+		else if(coords[i] >= m_CellNo[i])
+			coords[i] = m_CellNo[i] - 1;
+	}
+}
+
+// Private helper function to return the distinct indices of the cells within 
+// reach of a cell in one dimension, taking the PBCs into account. If the 
+// reach covers the whole SimBox every cell is returned once.
+
+void aeActiveBondHash::GetNeighbourIndices(long index, long reach, long total, zLongVector& rvIndices) const
+{
+	rvIndices.clear();
+
+	if(2*reach+1 >= total)
+	{
+		for(long i=0; i<total; i++)
+		{
+			rvIndices.push_back(i);
+		}
+	}
+	else
+	{
+		for(long i=index-reach; i<=index+reach; i++)
+		{
+			rvIndices.push_back((i+total)%total);
+		}
+	}
+}
+
+// Private helper function to return the square of the separation of a bead
+// from a point using the minimum image convention.
+
+double aeActiveBondHash::GetSquareSeparation(const CAbstractBead* const pBead, double x, double y, double z) const
+{
+	double dx = pBead->GetXPos() - x;
+	double dy = pBead->GetYPos() - y;
+	double dz = pBead->GetZPos() - z;
+
+	if( dx > m_HalfSimBoxLength[0] )
+		dx = dx - m_SimBoxLength[0];
+	else if( dx < -m_HalfSimBoxLength[0] )
+		dx = dx + m_SimBoxLength[0];
+
+	if( dy > m_HalfSimBoxLength[1] )
+		dy = dy - m_SimBoxLength[1];
+	else if( dy < -m_HalfSimBoxLength[1] )
+		dy = dy + m_SimBoxLength[1];
+
+#if SimDimension == 3
+	if( dz > m_HalfSimBoxLength[2] )
+		dz = dz - m_SimBoxLength[2];
+	else if( dz < -m_HalfSimBoxLength[2] )
+		dz = dz + m_SimBoxLength[2];
+#else
+	dz = 0.0;
+#endif
+
+	return dx*dx + dy*dy + dz*dz;
+}
+
+// Private helper function to remove the bond in a slot from the hash and 
+// make the slot available for reuse.
+
+void aeActiveBondHash::RemoveSlot(long slot)
+{
+	UnlinkEntry(2*slot);
+	UnlinkEntry(2*slot+1);
+
+	m_mNetworkTotals[m_vNetworks[slot]]--;
+
+	m_vSlots[m_vBondIds[slot]] = -1;
+
+	m_vBonds[slot]    = 0;
+	m_vBondIds[slot]  = -1;
+	m_vNetworks[slot] = 0;
+	m_vFreeSlots.push_back(slot);
+
+	m_BondTotal--;
+}
+
+// Private helper functions to insert an entry at the front of a cell's list
+// and to remove it from its current cell's list.
+
+void aeActiveBondHash::LinkEntry(long entry, long cell)
+{
+	const long first = m_vCellFirst[cell];
+
+	m_vEntryCell[entry] = cell;
+	m_vEntryPrev[entry] = -1;
+	m_vEntryNext[entry] = first;
+
+	if(first != -1)
+	{
+		m_vEntryPrev[first] = entry;
+	}
+
+	m_vCellFirst[cell] = entry;
+}
+
+void aeActiveBondHash::UnlinkEntry(long entry)
+{
+	const long prev = m_vEntryPrev[entry];
+	const long next = m_vEntryNext[entry];
+
+	if(prev != -1)
+	{
+		m_vEntryNext[prev] = next;
+	}
+	else
+	{
+		m_vCellFirst[m_vEntryCell[entry]] = next;
+	}
+
+	if(next != -1)
+	{
+		m_vEntryPrev[next] = prev;
+	}
+
+	m_vEntryCell[entry] = -1;
+	m_vEntryPrev[entry] = -1;
+	m_vEntryNext[entry] = -1;
+}
@@ -0,0 +1,142 @@
+// aeActiveBondHash.h: interface for the aeActiveBondHash class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_AEACTIVEBONDHASH_H__0C5E7B92_6D1A_4E38_8F24_B37A91D6C5E0__INCLUDED_)
+#define AFX_AEACTIVEBONDHASH_H__0C5E7B92_6D1A_4E38_8F24_B37A91D6C5E0__INCLUDED_
+
+
+// Forward declarations
+
+class aeActiveBond;
+class aeActiveCellNetwork;
+class CAbstractBead;
+
+
+#include "xxBase.h"
+
+// Spatial hash of the free active bonds of all the ACNs in the active SimBox.
+// The SimBox is divided into a grid of cells, and each free bond is stored
+// twice: once in the cell containing the head bead of its tail monomer, and
+// once in the cell containing the tail bead of its tail monomer. These are
+// the beads whose separations are tested when bonds bind to each other, so
+// the hash allows the ACNs to find the bonds near a point by searching only
+// the surrounding cells instead of all the free bonds in a network.
+//
+// The hash is stored in flat arrays. Each bond occupies a slot, and the two
+// ends of the bond in slot s are entries 2s (head) and 2s+1 (tail). The
+// entries in each cell form a doubly-linked list threaded through the
+// arrays, so that an entry can be moved between cells, and a bond added or
+// removed, in constant time. Slots freed by removed bonds are reused.
+//
+// The ACNs add and remove their bonds as they become free or bind into
+// polymers. The active SimBox calls Invalidate() once per time step, and the
+// entries whose beads have changed cells are only moved when Update() is 
+// called before a query, so steps without queries do not scan the bonds.
+// Each entry records the ACN that owns its bond, so that queries can be 
+// restricted to one network. The slots are found from the bonds' ids.
+
+class aeActiveBondHash
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	aeActiveBondHash(long nx, long ny, long nz, double xw, double yw, double zw);
+
+	~aeActiveBondHash();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	// Ends of a bond that are stored in the hash
+
+	enum BondEnd {Head = 0, Tail = 1};
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetBondTotal() const {return m_BondTotal;}
+
+	long GetBondTotal(const aeActiveCellNetwork* const pNetwork) const;
+
+	void AddBond(const aeActiveCellNetwork* const pNetwork, aeActiveBond* const pBond);
+	void RemoveBond(const aeActiveBond* const pBond);
+	void RemoveNetwork(const aeActiveCellNetwork* const pNetwork);
+
+	void Invalidate();
+	void Update();
+
+	// Queries restricted to the bonds of a single network
+
+	aeActiveBond* GetNearestBond(const aeActiveCellNetwork* const pNetwork, BondEnd end,
+								 double x, double y, double z) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	// Explicitly disallow the copy constructor and assignment operator
+	// by declaring them privately but providing NO definitions.
+
+	aeActiveBondHash(const aeActiveBondHash& oldHash);
+	aeActiveBondHash& operator=(const aeActiveBondHash& rhs);
+
+	const CAbstractBead* GetEntryBead(long entry) const;
+
+	long GetCellIndex(double x, double y, double z) const;
+	void GetCellCoords(double x, double y, double z, long coords[3]) const;
+	void GetNeighbourIndices(long index, long reach, long total, zLongVector& rvIndices) const;
+	double GetSquareSeparation(const CAbstractBead* const pBead, double x, double y, double z) const;
+
+	void RemoveSlot(long slot);
+
+	void LinkEntry(long entry, long cell);
+	void UnlinkEntry(long entry);
+
+	// ****************************************
+	// Data members
+private:
+
+	long         m_CellNo[3];			// Number of hash cells in each dimension
+	double       m_CellWidth[3];		// Width of the hash cells in each dimension
+	double       m_SimBoxLength[3];
+	double       m_HalfSimBoxLength[3];
+
+	zLongVector  m_vCellFirst;			// First entry in each cell: -1 if the cell is empty
+
+	ActiveBondSequence m_vBonds;		// Bond in each slot: null if the slot is free
+	zLongVector  m_vBondIds;			// Id of the bond in each slot: -1 if the slot is free
+	std::vector<const aeActiveCellNetwork*> m_vNetworks;	// Network owning each slot's bond
+
+	zLongVector  m_vEntryCell;			// Cell holding each entry
+	zLongVector  m_vEntryNext;			// Next and previous entries in the same cell: -1 at the ends
+	zLongVector  m_vEntryPrev;
+
+	zLongVector  m_vFreeSlots;			// Slots available for reuse
+
+	zLongVector  m_vSlots;				// Slot holding each bond indexed by bond id: -1 if not in the hash
+
+	long         m_BondTotal;			// Number of bonds in the hash
+	bool         m_bStale;				// Flag showing the beads may have moved since the last Update()
+
+	std::map<const aeActiveCellNetwork*, long> m_mNetworkTotals;	// Number of bonds of each network
+};
+
+#endif // !defined(AFX_AEACTIVEBONDHASH_H__0C5E7B92_6D1A_4E38_8F24_B37A91D6C5E0__INCLUDED_)
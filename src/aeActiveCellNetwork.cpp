@@ -34,6 +34,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "aevBondPhosphorylation.h"
 #include "IActiveSimBox.h"
 #include "IACNAccessControl.h"
+#include "aeActiveBondHash.h"
+#include "aeActiveEventScheduler.h"
 #include "aeActiveBond1dProfile.h"
 #include "taEventSourceDecorator.h"
 #include "LogTextMessage.h"
@@ -46,6 +48,7 @@ aeActiveCellNetwork::aeActiveCellNetwork(IActiveSimBox* const pShadow, long xn,
 					double xw, double yw, double zw) : m_pIACNAccess(0),
 							m_PolymerFormsTotal(0), m_PolymerDissolvesTotal(0), 
 							m_pShadow(pShadow),
+							m_pScheduler(new aeActiveEventScheduler()),
 							m_pPolymerFormsEvent(0),
 						        m_pPolymerDissolvesEvent(0),
 							m_pBondBindsToPolymerHeadEvent(0),
@@ -183,6 +186,14 @@ aeActiveCellNetwork::~aeActiveCellNetwork()
 		m_Events.clear();
 	}
 
+	// The scheduler destroys the events that it holds
+
+	if(m_pScheduler)
+	{
+		delete m_pScheduler;
+		m_pScheduler = 0;
+	}
+
 	// Delete all CNT cells created in the MakeCNTCells function. 
 
 	if(!m_vCNTCells.empty())
@@ -200,6 +211,10 @@ aeActiveCellNetwork::~aeActiveCellNetwork()
     // the m_FreePhantomBonds container are also in the m_FreeActiveBonds container
     // we must not delete its contents.
 
+	// The free bonds are first removed from the active SimBox's bond hash.
+
+	m_pShadow->GetBondHash()->RemoveNetwork(this);
+
 	if(!m_FreeActiveBonds.empty())
 	{
 		for(ActiveBondListIterator iterBond=m_FreeActiveBonds.begin(); iterBond!=m_FreeActiveBonds.end(); iterBond++)
@@ -389,9 +404,14 @@ long aeActiveCellNetwork::MapCelltoNNIndex(long alpha, long beta, long gamma) co
 //
 // This routine should only be called ONCE after creating active bonds as it
 // insert the newly-created bonds into the m_FreeActiveBonds container. 
+// Commands that reassign a network's bonds also call it, so we first remove
+// the network's old entries from the shared bond hash to keep it identical
+// to the m_FreeActiveBonds container.
 
 void aeActiveCellNetwork::AssignActiveBondsToCells(ActiveBondList lFreeActiveBonds)
 {
+	m_pShadow->GetBondHash()->RemoveNetwork(this);
+
 	for(ActiveBondListIterator iterBond=lFreeActiveBonds.begin(); iterBond!=lFreeActiveBonds.end(); iterBond++)
 	{
 		long ix = static_cast<long>((*iterBond)->GetTailMonomer()->GetHead()->GetXPos()/m_CNTXCellWidth);
@@ -405,6 +425,8 @@ void aeActiveCellNetwork::AssignActiveBondsToCells(ActiveBondList lFreeActiveBon
 
 		const long index = m_CNTXCellNo*(m_CNTYCellNo*iz+iy) + ix;
 		m_vCNTCells[index]->AddActiveBondToCell(*iterBond);
+
+		m_pShadow->GetBondHash()->AddBond(this, *iterBond);
 	} 
 
 	// Now store the free active bonds locally so that we can iterate over them
@@ -436,17 +458,26 @@ void aeActiveCellNetwork::UpdateActiveBondsInCells()
 	{
 		const long cellId = (*iterCell)->GetId();
 
-		ActiveBondList lBonds = (*iterCell)->GetBonds();
+		// Iterate over the cell's own container instead of a copy, advancing
+		// the iterator before a bond is moved out of the cell
 
-		for(ActiveBondListIterator iterBond=lBonds.begin(); iterBond!=lBonds.end(); iterBond++)
+		const ActiveBondList& lBonds = (*iterCell)->GetBonds();
+
+		cActiveBondListIterator iterBond=lBonds.begin();
+
+		while(iterBond!=lBonds.end())
 		{
-			long ix = static_cast<long>((*iterBond)->GetTailMonomer()->GetHead()->GetXPos()/m_CNTXCellWidth);
-			long iy = static_cast<long>((*iterBond)->GetTailMonomer()->GetHead()->GetYPos()/m_CNTYCellWidth);
+			const cActiveBondListIterator citerBond = iterBond++;
+
+			const CAbstractBead* const pHead = (*citerBond)->GetTailMonomer()->GetHead();
+
+			long ix = static_cast<long>(pHead->GetXPos()/m_CNTXCellWidth);
+			long iy = static_cast<long>(pHead->GetYPos()/m_CNTYCellWidth);
 
 	#if SimDimension == 2
 			long iz = 0;
 	#elif SimDimension == 3
-			long iz = static_cast<long>((*iterBond)->GetTailMonomer()->GetHead()->GetZPos()/m_CNTZCellWidth);		
+			long iz = static_cast<long>(pHead->GetZPos()/m_CNTZCellWidth);
 	#endif
 	  
 			const long index = m_CNTXCellNo*(m_CNTYCellNo*iz+iy) + ix;
@@ -455,9 +486,7 @@ void aeActiveCellNetwork::UpdateActiveBondsInCells()
 
 			if(index != cellId)
 			{
-				(*iterCell)->RemoveActiveBondFromCell(*iterBond);
-
-				m_vCNTCells[index]->AddActiveBondToCell(*iterBond);
+				(*iterCell)->MoveActiveBondToCell(citerBond, m_vCNTCells[index]);
 			}
 		} 
 	}
@@ -941,6 +970,8 @@ void aeActiveCellNetwork::AddFreeBond(aeActiveBond* const pBond)
 	}
 
 	m_FreeActiveBonds.push_back(pBond);
+
+	m_pShadow->GetBondHash()->AddBond(this, pBond);
 }
 
 // Function to remove a bond from the ACN's free bond container when it binds to 
@@ -958,6 +989,8 @@ void aeActiveCellNetwork::RemoveFreeBond(aeActiveBond* const pBond)
 	}
 
 	m_FreeActiveBonds.remove(pBond);
+
+	m_pShadow->GetBondHash()->RemoveBond(pBond);
 }
 
 // Second function to remove a bond from the ACN's free bond container and update
@@ -973,6 +1006,8 @@ ActiveBondListIterator aeActiveCellNetwork::RemoveFreeBondByIterator(ActiveBondL
 		(*iterBond)->SetVisible(GetFreePolymerDisplayStatus());
 	}
 
+	m_pShadow->GetBondHash()->RemoveBond(*iterBond);
+
 	ActiveBondListIterator nextBond = m_FreeActiveBonds.erase(iterBond);
 
 	return nextBond;
@@ -1115,7 +1150,8 @@ void aeActiveCellNetwork::DeleteEvent(aevActiveEvent* pEvent)
 }
 
 // Function to remove an event from the ACN's event container without destroying
-// the event itself.
+// the event itself. If the event is not found there, it may be waiting in the
+// scheduler.
 
 void aeActiveCellNetwork::RemoveEvent(aevActiveEvent* pEvent)
 {
@@ -1125,6 +1161,10 @@ void aeActiveCellNetwork::RemoveEvent(aevActiveEvent* pEvent)
 	{
 		m_Events.erase(iterEvent);
 	}
+	else
+	{
+		m_pScheduler->RemoveEvent(pEvent);
+	}
 }
 
 // Protected function to allow concrete ACN classes to update the state of 
@@ -1134,20 +1174,78 @@ void aeActiveCellNetwork::RemoveEvent(aevActiveEvent* pEvent)
 // pre-conditions are satisfied and to take the appropriate action. The 
 // aevActiveEvent::Execute() function returns a bool so we can see if an event 
 // should continue executing or be destroyed.
+//
+// Events that only wait for a fixed-probability trial to succeed, such as the
+// ATP hydrolysis cycle of actin monomers, are not polled. The first time one
+// is found in the container it is moved to the scheduler, which stores it
+// until the sampled time of its successful trial. We execute the events whose
+// time has arrived first, so that any events they create are scheduled in
+// the same time step. The cost of these events then depends on how many of
+// them succeed and not on how many exist.
+//
+// Some events, such as the unbinding of a polymer's end bond, only wait for a
+// trial while they are idle, and must be polled while they act on the polymer.
+// When their trial succeeds they are returned to the front of the container,
+// ahead of the first polled event, so that they are not executed twice in the
+// same time step, and they return to the scheduler when they are idle again.
 
 void aeActiveCellNetwork::UpdateEvents()
 {
-	if(!m_Events.empty())
+	const long currentTime = GetCurrentTime();
+
+	const ActiveEventListIterator iterFirstPolled = m_Events.begin();
+
+	aevActiveEvent* pEvent = m_pScheduler->RemoveNextEvent(currentTime);
+
+	while(pEvent)
+	{
+		if(pEvent->ExecuteScheduled(m_pShadow))
+		{
+			// Either the event's other conditions were not satisfied so we
+			// sample a new execution time for it, or it must now be polled
+
+			if(pEvent->IsScheduled())
+			{
+				ScheduleEvent(pEvent);
+			}
+			else
+			{
+				m_Events.insert(iterFirstPolled, pEvent);
+			}
+		}
+		else if(!pEvent->IsDependent())
+		{
+			delete pEvent;
+		}
+
+		pEvent = m_pScheduler->RemoveNextEvent(currentTime);
+	}
+
+	if(iterFirstPolled != m_Events.end())
 	{
-		ActiveEventListIterator iterEvent=m_Events.begin();
+		ActiveEventListIterator iterEvent=iterFirstPolled;
 
 		while(iterEvent != m_Events.end())
 		{
-			if((*iterEvent)->Execute(m_pShadow))
+			if((*iterEvent)->IsScheduled())
+			{
+				ScheduleEvent(*iterEvent);
+				iterEvent = m_Events.erase(iterEvent);
+			}
+			else if((*iterEvent)->Execute(m_pShadow))
 			{
-				// Event is still active so move to the next one
+				// Event is still active so move to the next one, unless it
+				// is now idle and can wait in the scheduler
 
-				iterEvent++;
+				if((*iterEvent)->IsScheduled())
+				{
+					ScheduleEvent(*iterEvent);
+					iterEvent = m_Events.erase(iterEvent);
+				}
+				else
+				{
+					iterEvent++;
+				}
 			}
 			else if(!(*iterEvent)->IsDependent())
 			{
@@ -1161,6 +1259,81 @@ void aeActiveCellNetwork::UpdateEvents()
 	}
 }
 
+// Private helper function to store an event in the scheduler. The event makes
+// one trial every execution period, or every time step if its period is zero,
+// and we sample the number of trials up to and including the first success.
+// An event whose probability is zero is stored with a time that is never 
+// reached, until a command changes its probability and it is rescheduled.
+
+void aeActiveCellNetwork::ScheduleEvent(aevActiveEvent* const pEvent)
+{
+	const long period = (pEvent->GetExecutionPeriod() > 0 ? pEvent->GetExecutionPeriod() : 1);
+
+	const long trials = aeActiveEventScheduler::GetTrialsToSuccess(pEvent->GetTrialProbability(), CCNTCell::GetRandomNo());
+
+	long time = aeActiveEventScheduler::m_NeverFires;
+
+	if(trials > 0 && trials < (aeActiveEventScheduler::m_NeverFires - GetCurrentTime())/period)
+	{
+		time = GetCurrentTime() + trials*period;
+	}
+
+	m_pScheduler->AddEvent(pEvent, GetATPDependentEventBondId(pEvent), time);
+}
+
+// Function to return the number of events owned by the ACN, including those
+// waiting in the scheduler.
+
+long aeActiveCellNetwork::GetEventTotal() const
+{
+	return m_Events.size() + m_pScheduler->GetEventTotal();
+}
+
+// Private helper function to collect all the events owned by the ACN: the 
+// polled events in the order they were created, followed by the scheduled 
+// events in the order of the bonds they wrap. Functions that report or 
+// modify all events use this so that scheduled events are not left out.
+
+void aeActiveCellNetwork::GetAllEvents(ActiveEventSequence& rvEvents) const
+{
+	copy(m_Events.begin(), m_Events.end(), back_inserter(rvEvents));
+
+	m_pScheduler->GetEvents(rvEvents);
+}
+
+// Function to sample new execution times for all the scheduled events of a
+// given type. It is called when a command changes the probability of the 
+// events' trials or their execution period. Because the trials are 
+// independent, the time remaining until the next success does not depend on
+// how long an event has already waited, so resampling from the current time 
+// is exact.
+
+void aeActiveCellNetwork::RescheduleEventsByType(const zString eventType)
+{
+	ActiveEventSequence vEvents;
+
+	m_pScheduler->RemoveEventsByType(eventType, vEvents);
+
+	const long period = GetInternalEventExecutionPeriodFromName(eventType);
+
+	for(ActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
+	{
+		(*iterEvent)->ResetExecutionPeriod(period);
+
+		ScheduleEvent(*iterEvent);
+	}
+}
+
+// Function to sample new execution times for the events that wait for the
+// end bonds of the ACN's polymers to detach. It is called when a command 
+// changes the bonds' off rates or the largest value they can take.
+
+void aeActiveCellNetwork::RescheduleBondUnbindsEvents()
+{
+	RescheduleEventsByType(GetInternalBondUnbindsFromPolymerHeadEventType());
+	RescheduleEventsByType(GetInternalBondUnbindsFromPolymerTailEventType());
+}
+
 // Function to return the event instance that is being used by the ACN to
 // form active polymers out of its monomers. This allows the event's parameters
 // to be modified by command.
@@ -1490,10 +1663,15 @@ void aeActiveCellNetwork::AttachProcess(xxProcess* pProcess)
 // able to use the data. For example, the aevPolymerForms event
 // automatically creates events for the binding and unbinding of monomers to
 // the head and tail of the active polymer. Each active polymer contains
-// at least 4 events: bond on and off at each end.
+// at least 4 events: bond on and off at each end. Events held by the
+// scheduler follow the polled events, ordered by the bond they wrap.
 
 void aeActiveCellNetwork::CalculateEventCounters()
 {
+    ActiveEventSequence vEvents;
+
+    GetAllEvents(vEvents);
+
     // Reset event counters if the appropriate flag indicates that 
     // time series are required instead of cumulative statistics.
 
@@ -1504,11 +1682,11 @@ void aeActiveCellNetwork::CalculateEventCounters()
         // This is necessary because new filaments forming, or old ones
         // disintegrating, changes the number of events being sampled.
 
-        if(GetEventTotal() != static_cast<long>(m_EventSuccessCounters.size()))
+        if(static_cast<long>(vEvents.size()) != static_cast<long>(m_EventSuccessCounters.size()))
         {
            ResetACNEventCounters();
 
-           for(cActiveEventListIterator iterEvent=m_Events.begin(); iterEvent!=m_Events.end(); iterEvent++)
+           for(cActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
            {
                m_EventSuccessCounters.push_back((*iterEvent)->GetSuccessCounter());
                m_EventFailureCounters.push_back((*iterEvent)->GetFailureCounter());
@@ -1518,7 +1696,7 @@ void aeActiveCellNetwork::CalculateEventCounters()
         {
             // Accumulate statistics
             long eventNo = 0;
-            for(cActiveEventListIterator iterEvent=m_Events.begin(); iterEvent!=m_Events.end(); iterEvent++)
+            for(cActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
             {
                 m_EventSuccessCounters.at(eventNo) += ((*iterEvent)->GetSuccessCounter());
                 m_EventFailureCounters.at(eventNo) += ((*iterEvent)->GetFailureCounter());
@@ -1532,7 +1710,7 @@ void aeActiveCellNetwork::CalculateEventCounters()
 
         ResetACNEventCounters();
 
-        for(cActiveEventListIterator iterEvent=m_Events.begin(); iterEvent!=m_Events.end(); iterEvent++)
+        for(cActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
         {
             m_EventSuccessCounters.push_back((*iterEvent)->GetSuccessCounter());
             m_EventFailureCounters.push_back((*iterEvent)->GetFailureCounter());
@@ -1574,11 +1752,13 @@ long aeActiveCellNetwork::GetEventFailureCounter(long i) const
 }
 
 // Function to return a specific event. Because events are stored in a list,
-// we have to iterate through the list to find the required event.
+// we have to iterate through the list to find the required event. Indices
+// beyond the polled events refer to the events held by the scheduler in
+// the order used by CalculateEventCounters().
 
 aevActiveEvent* aeActiveCellNetwork::GetEvent(long i)
 {
-    if(i >= 0 && i < GetEventTotal())
+    if(i >= 0 && i < static_cast<long>(m_Events.size()))
     {
         ActiveEventListIterator iterEvent = m_Events.begin();
 
@@ -1589,6 +1769,14 @@ aevActiveEvent* aeActiveCellNetwork::GetEvent(long i)
 
         return *iterEvent;
     }
+    else if(i >= 0 && i < GetEventTotal())
+    {
+        ActiveEventSequence vEvents;
+
+        m_pScheduler->GetEvents(vEvents);
+
+        return vEvents.at(i - m_Events.size());
+    }
     else
     {
         return 0;
@@ -1621,7 +1809,11 @@ bool aeActiveCellNetwork::ToggleCumulativeEventStatisticsHandler()
 
 void aeActiveCellNetwork::ResetAllEventCounters()
 {
-    for(ActiveEventListIterator iterEvent = m_Events.begin(); iterEvent!=m_Events.end(); iterEvent++)
+    ActiveEventSequence vEvents;
+
+    GetAllEvents(vEvents);
+
+    for(ActiveEventIterator iterEvent = vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
     {
         (*iterEvent)->ResetAllCounters();
     }
@@ -1754,9 +1946,47 @@ bool aeActiveCellNetwork::DeleteATPDependentEventWrappingBond(long bondId)
            }
     }
 
+    // Events that are waiting in the scheduler are owned by it, so we destroy
+    // them here
+
+    aevActiveEvent* const pScheduledEvent = m_pScheduler->RemoveEventWrappingBond(bondId);
+
+    if(pScheduledEvent)
+    {
+        if(!pScheduledEvent->IsDependent())
+        {
+            delete pScheduledEvent;
+        }
+
+        bEventDestroyed = true;
+    }
+
     return bEventDestroyed;
 }
 
+// Private helper function to return the id of the bond wrapped by an 
+// ATP-dependent event, or -1 if the event is of another type. This allows the
+// scheduler to find the events that must be deleted when a bond leaves a
+// filament.
+
+long aeActiveCellNetwork::GetATPDependentEventBondId(const aevActiveEvent* const pEvent) const
+{
+    if(dynamic_cast<const aevBondHydrolysesATP*>(pEvent))
+    {
+        return dynamic_cast<const aevBondHydrolysesATP*>(pEvent)->GetBondId();
+    }
+    else if(dynamic_cast<const aevBondReleasesPi*>(pEvent))
+    {
+        return dynamic_cast<const aevBondReleasesPi*>(pEvent)->GetBondId();
+    }
+    else if(dynamic_cast<const aevBondPhosphorylation*>(pEvent))
+    {
+        return dynamic_cast<const aevBondPhosphorylation*>(pEvent)->GetBondId();
+    }
+
+    return -1;
+}
+
 // Function to set the period with which a named event type attempts to execute.
 // This reduces the sampling frequency of the event and allows a larger 
 // probability to be used in the test. We store the (event name, execution period) 
@@ -1828,6 +2058,10 @@ void aeActiveCellNetwork::UpdateEventPeriodByType(const zString eventType)
         }
 	}
 
+    // Scheduled events must also have their execution times resampled
+
+    RescheduleEventsByType(eventType);
+
     // Now update the stored prototype events. We have to compare the type of each
     // of these with the specified type. This is ugly, but there is no other way.
 
@@ -1896,11 +2130,15 @@ void aeActiveCellNetwork::BroadcastEventState(const aevActiveEvent* const pEvent
 bool aeActiveCellNetwork::AddEventSource(const zString eventType, taEventSourceDecorator* const pSource)
 {
     // First set a flag in all instances of the specified event type so that
-    // they broadcast their success state
+    // they broadcast their success state, including those in the scheduler
 
-	if(!m_Events.empty())
+    ActiveEventSequence vEvents;
+
+    GetAllEvents(vEvents);
+
+	if(!vEvents.empty())
 	{
-		for(ActiveEventListIterator iterEvent=m_Events.begin(); iterEvent!=m_Events.end(); iterEvent++)
+		for(ActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
         {
 //            std::cout <<"found event of type " << (*iterEvent)->GetEventType() << " and comparing to " << eventType << zEndl;
 
@@ -1936,9 +2174,13 @@ bool aeActiveCellNetwork::AddEventSource(const zString eventType, taEventSourceD
 
 bool aeActiveCellNetwork::RemoveEventSource(const zString eventType, taEventSourceDecorator* const pSource)
 {
-	if(!m_Events.empty())
+    ActiveEventSequence vEvents;
+
+    GetAllEvents(vEvents);
+
+	if(!vEvents.empty())
 	{
-		for(ActiveEventListIterator iterEvent=m_Events.begin(); iterEvent!=m_Events.end(); iterEvent++)
+		for(ActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
         {
             if((*iterEvent)->GetEventType() == eventType)
             {
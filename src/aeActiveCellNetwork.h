@@ -14,6 +14,7 @@ class aevActiveEvent;
 class CDensityField1d;
 class xxProcess;
 class taEventSourceDecorator;
+class aeActiveEventScheduler;
 
 
 // Include header files used by derived classes
@@ -173,7 +174,7 @@ public:
 	// modified by command: note that we use "Internal" to distinguish
 	// them from the IModifyActiveCellNetwork interface functions
 
-	inline long GetEventTotal()                 const {return m_Events.size();}
+	long GetEventTotal() const;
 	inline long GetPolymerFormsEventTotal()     const {return m_PolymerFormsTotal;}
 	inline long GetPolymerDissolvesEventTotal() const {return m_PolymerDissolvesTotal;}
 
@@ -221,6 +222,12 @@ public:
 
     bool DeleteATPDependentEventWrappingBond(long bondId);
 
+    // Function to sample new execution times for all scheduled events of a 
+    // given type when a command changes their probability or period
+
+    void RescheduleEventsByType(const zString eventType);
+    void RescheduleBondUnbindsEvents();
+
     // Functions to set and get the execution period for a named event type.
     // A private helper function that updates stored events' periods is declared
     // below.
@@ -335,6 +342,12 @@ protected:
 	// Private functions
 private:
 
+    // Helper functions used to store events in the scheduler at a sampled time
+
+    void ScheduleEvent(aevActiveEvent* const pEvent);
+    long GetATPDependentEventBondId(const aevActiveEvent* const pEvent) const;
+    void GetAllEvents(ActiveEventSequence& rvEvents) const;
+
     // Helper function used by the commands that change event execution periods
     // to update all stored events, and prototype event instances, in the ACN.
 
@@ -371,6 +384,8 @@ private:
 
         ActiveEventList m_Events;				// Active events owned by this network
 
+        aeActiveEventScheduler* m_pScheduler;	// Events executed at sampled times instead of being polled
+
 	aevActiveEvent* m_pPolymerFormsEvent;				// Event managing polymer formation
 	aevActiveEvent* m_pPolymerDissolvesEvent;			// Event managing polymer breakup
 	aevActiveEvent* m_pBondBindsToPolymerHeadEvent;		// Event managing polyer growth at the head
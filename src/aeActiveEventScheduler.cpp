@@ -0,0 +1,253 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// aeActiveEventScheduler.cpp: implementation of the aeActiveEventScheduler class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "aeActiveEventScheduler.h"
+#include "aevActiveEvent.h"
+
+#include <limits>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Events stored with this time are never returned by RemoveNextEvent().
+
+const long aeActiveEventScheduler::m_NeverFires = std::numeric_limits<long>::max();
+
+// Function to sample the number of trials up to and including the first
+// success of a sequence of independent trials that each succeed with
+// probability prob. The trial count is geometrically distributed, and is
+// obtained by inverting its cumulative distribution using a random number
+// rno uniformly distributed in [0,1). We use 1 - rno so that the logarithm
+// is never taken of zero, and log1p() so that very small probabilities are
+// not rounded to zero.
+//
+// The function returns zero if the trials can never succeed, or if the
+// number of trials is too large to be represented.
+
+long aeActiveEventScheduler::GetTrialsToSuccess(double prob, double rno)
+{
+	if(prob <= 0.0)
+	{
+		return 0;
+	}
+	else if(prob >= 1.0)
+	{
+		return 1;
+	}
+
+	const double trials = ceil(log1p(-rno)/log1p(-prob));
+
+	if(trials < 1.0)
+	{
+		return 1;
+	}
+	else if(trials > 1.0e15)
+	{
+		return 0;
+	}
+	else
+	{
+		return static_cast<long>(trials);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+aeActiveEventScheduler::aeActiveEventScheduler()
+{
+	m_mEventFromTime.clear();
+	m_mTimeFromEvent.clear();
+	m_mBondIdFromEvent.clear();
+	m_mEventFromBondId.clear();
+}
+
+// The scheduler owns its events, so we destroy any that have not fired.
+// As in the ACN, dependent events are destroyed by their controlling event.
+// The containers are emptied first in case an event's destructor tries to
+// remove another event from the scheduler.
+
+aeActiveEventScheduler::~aeActiveEventScheduler()
+{
+	ActiveEventSequence vEvents;
+
+	for(LongEventMMap::iterator iterTime=m_mEventFromTime.begin(); iterTime!=m_mEventFromTime.end(); iterTime++)
+	{
+		vEvents.push_back(iterTime->second);
+	}
+
+	m_mEventFromTime.clear();
+	m_mTimeFromEvent.clear();
+	m_mBondIdFromEvent.clear();
+	m_mEventFromBondId.clear();
+
+	for(ActiveEventIterator iterEvent=vEvents.begin(); iterEvent!=vEvents.end(); iterEvent++)
+	{
+		if(!(*iterEvent)->IsDependent())
+		{
+			delete *iterEvent;
+		}
+	}
+}
+
+// Function to store an event that will fire at the specified time. If the
+// event wraps a bond, its id is passed in so that the event can be found
+// from the bond; otherwise the id should be negative. An event that is
+// already in the scheduler is moved to its new time.
+
+void aeActiveEventScheduler::AddEvent(aevActiveEvent* const pEvent, long bondId, long time)
+{
+	RemoveEvent(pEvent);
+
+	m_mTimeFromEvent[pEvent] = m_mEventFromTime.insert(std::make_pair(time, pEvent));
+
+	if(bondId >= 0)
+	{
+		m_mBondIdFromEvent[pEvent]  = bondId;
+		m_mEventFromBondId[bondId] = pEvent;
+	}
+}
+
+// Function to remove and return the earliest event whose firing time is
+// not later than the specified time. It returns a null pointer when no
+// more events are due. Events that fire at the same time are returned in
+// the order in which they were scheduled.
+
+aevActiveEvent* aeActiveEventScheduler::RemoveNextEvent(long time)
+{
+	if(!m_mEventFromTime.empty() && m_mEventFromTime.begin()->first <= time)
+	{
+		aevActiveEvent* const pEvent = m_mEventFromTime.begin()->second;
+
+		EraseEntry(m_mEventFromTime.begin());
+
+		return pEvent;
+	}
+
+	return 0;
+}
+
+// Function to remove and return the event that wraps the specified bond,
+// or a null pointer if there is no such event. The caller takes ownership
+// of the event.
+
+aevActiveEvent* aeActiveEventScheduler::RemoveEventWrappingBond(long bondId)
+{
+	std::map<long, aevActiveEvent*>::iterator iterBond = m_mEventFromBondId.find(bondId);
+
+	if(iterBond != m_mEventFromBondId.end())
+	{
+		aevActiveEvent* const pEvent = iterBond->second;
+
+		RemoveEvent(pEvent);
+
+		return pEvent;
+	}
+
+	return 0;
+}
+
+// Function to remove an event from the scheduler without destroying it.
+// It returns false if the event was not found.
+
+bool aeActiveEventScheduler::RemoveEvent(aevActiveEvent* const pEvent)
+{
+	std::map<aevActiveEvent*, LongEventMMap::iterator>::iterator iterEvent = m_mTimeFromEvent.find(pEvent);
+
+	if(iterEvent != m_mTimeFromEvent.end())
+	{
+		EraseEntry(iterEvent->second);
+		return true;
+	}
+
+	return false;
+}
+
+// Function to remove all events of the specified type so that the ACN can
+// sample new firing times for them when their probability or execution
+// period changes. The events are returned in their firing order, and the 
+// caller takes ownership of them.
+
+void aeActiveEventScheduler::RemoveEventsByType(const zString eventType, ActiveEventSequence& rvEvents)
+{
+	LongEventMMap::iterator iterTime = m_mEventFromTime.begin();
+
+	while(iterTime != m_mEventFromTime.end())
+	{
+		aevActiveEvent* const pEvent = iterTime->second;
+
+		// Advance the iterator before its entry is erased
+
+		iterTime++;
+
+		if(pEvent->GetEventType() == eventType)
+		{
+			rvEvents.push_back(pEvent);
+
+			RemoveEvent(pEvent);
+		}
+	}
+}
+
+// Function to append all the events held by the scheduler to a container
+// without removing them. Events that wrap a bond are returned in order of the
+// bond id, so that their positions do not change as their firing times are 
+// resampled, followed by any other events in their firing order.
+
+void aeActiveEventScheduler::GetEvents(ActiveEventSequence& rvEvents) const
+{
+	for(std::map<long, aevActiveEvent*>::const_iterator citerBond=m_mEventFromBondId.begin(); citerBond!=m_mEventFromBondId.end(); citerBond++)
+	{
+		rvEvents.push_back(citerBond->second);
+	}
+
+	for(LongEventMMap::const_iterator citerTime=m_mEventFromTime.begin(); citerTime!=m_mEventFromTime.end(); citerTime++)
+	{
+		if(m_mBondIdFromEvent.find(citerTime->second) == m_mBondIdFromEvent.end())
+		{
+			rvEvents.push_back(citerTime->second);
+		}
+	}
+}
+
+// Private function to erase an event's entries from all the containers.
+
+void aeActiveEventScheduler::EraseEntry(LongEventMMap::iterator iterTime)
+{
+	aevActiveEvent* const pEvent = iterTime->second;
+
+	std::map<aevActiveEvent*, long>::iterator iterBond = m_mBondIdFromEvent.find(pEvent);
+
+	if(iterBond != m_mBondIdFromEvent.end())
+	{
+		std::map<long, aevActiveEvent*>::iterator iterId = m_mEventFromBondId.find(iterBond->second);
+
+		if(iterId != m_mEventFromBondId.end() && iterId->second == pEvent)
+		{
+			m_mEventFromBondId.erase(iterId);
+		}
+
+		m_mBondIdFromEvent.erase(iterBond);
+	}
+
+	m_mTimeFromEvent.erase(pEvent);
+	m_mEventFromTime.erase(iterTime);
+}
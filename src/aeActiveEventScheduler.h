@@ -0,0 +1,109 @@
+// aeActiveEventScheduler.h: interface for the aeActiveEventScheduler class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_AEACTIVEEVENTSCHEDULER_H__7D2C4E18_93B5_4F0A_A6E1_2F58C0B7D943__INCLUDED_)
+#define AFX_AEACTIVEEVENTSCHEDULER_H__7D2C4E18_93B5_4F0A_A6E1_2F58C0B7D943__INCLUDED_
+
+
+// Forward declarations
+
+class aevActiveEvent;
+
+
+#include "xxBase.h"
+
+// Priority queue of the active events of an ACN that are executed at a
+// sampled time instead of being polled every time step.
+//
+// Some events, such as the ATP hydrolysis cycle of actin monomers, have no
+// precondition except a trial that succeeds with a fixed probability once
+// every execution period. The number of trials up to and including the
+// first success is geometrically distributed, so the ACN draws it once when
+// the event is created, stores the event here keyed on the time step at which
+// it will succeed, and only touches the event again when that time arrives.
+// The cost of these events then scales with the number that fire rather than
+// the number that exist.
+//
+// Events whose probability is zero never fire: they are stored with a time
+// that is never reached until the ACN reschedules them after a command
+// changes their probability or execution period.
+//
+// The scheduler also indexes the events by the id of the bond that they wrap,
+// so that the ACN can remove a bond's events when the bond leaves a filament.
+// The scheduler owns the events it holds and destroys any that remain when
+// it is destroyed.
+
+class aeActiveEventScheduler
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	aeActiveEventScheduler();
+
+	~aeActiveEventScheduler();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static long GetTrialsToSuccess(double prob, double rno);
+
+	static const long m_NeverFires;		// Time used for events with zero probability
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetEventTotal() const {return m_mEventFromTime.size();}
+
+	void AddEvent(aevActiveEvent* const pEvent, long bondId, long time);
+
+	aevActiveEvent* RemoveNextEvent(long time);
+	aevActiveEvent* RemoveEventWrappingBond(long bondId);
+
+	bool RemoveEvent(aevActiveEvent* const pEvent);
+	void RemoveEventsByType(const zString eventType, ActiveEventSequence& rvEvents);
+
+	void GetEvents(ActiveEventSequence& rvEvents) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	// Explicitly disallow the copy constructor and assignment operator
+	// by declaring them privately but providing NO definitions.
+
+	aeActiveEventScheduler(const aeActiveEventScheduler& oldScheduler);
+	aeActiveEventScheduler& operator=(const aeActiveEventScheduler& rhs);
+
+	typedef std::multimap<long, aevActiveEvent*> LongEventMMap;
+
+	void EraseEntry(LongEventMMap::iterator iterTime);
+
+	// ****************************************
+	// Data members
+private:
+
+	LongEventMMap m_mEventFromTime;							// Events ordered by the time they fire
+	std::map<aevActiveEvent*, LongEventMMap::iterator> m_mTimeFromEvent;	// Position of each event in the queue
+	std::map<aevActiveEvent*, long> m_mBondIdFromEvent;		// Id of the bond wrapped by each event
+	std::map<long, aevActiveEvent*> m_mEventFromBondId;		// Event wrapping each bond
+};
+
+#endif // !defined(AFX_AEACTIVEEVENTSCHEDULER_H__7D2C4E18_93B5_4F0A_A6E1_2F58C0B7D943__INCLUDED_)
@@ -30,7 +30,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //
 // Static member variable holding the number of active polymers created.
 
-long aeActivePolymer::m_PolymerTotal = 0;
+thread_local long aeActivePolymer::m_PolymerTotal = 0;
 
 // Static member function to obtain the number of active polymers.
 
@@ -37,7 +37,7 @@ public:
 
 private:
 
-	static long m_PolymerTotal;
+	static thread_local long m_PolymerTotal;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -23,6 +23,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "ISimBox.h"
 #include "aeActiveSimBox.h"
 #include "aevActiveEvent.h"
+#include "aeActiveBondHash.h"
 
 // Active network classes
 
@@ -54,7 +55,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable holding a pointer to the single instance of aeActiveSimBox.
 // Note that it does not get assigned a value until the user creates the instance.
 
-aeActiveSimBox* aeActiveSimBox::m_pInstance = 0;
+thread_local aeActiveSimBox* aeActiveSimBox::m_pInstance = 0;
 
 // Public member function to create a single instance of the CSimBox class.
 
@@ -78,7 +79,8 @@ const IActiveSimBox* aeActiveSimBox::GetIActiveSimBox()
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-aeActiveSimBox::aeActiveSimBox(const ISimBox* const pISimBox) : m_pISimBox(pISimBox)
+aeActiveSimBox::aeActiveSimBox(const ISimBox* const pISimBox) : m_pISimBox(pISimBox),
+																m_pBondHash(0)
 {
 	// Ensure maps are empty
 
@@ -101,6 +103,14 @@ aeActiveSimBox::~aeActiveSimBox()
 
 	m_mACN.clear();
 
+	// The bond hash is destroyed after the ACNs as they remove their bonds from it
+
+	if(m_pBondHash)
+	{
+		delete m_pBondHash;
+		m_pBondHash = 0;
+	}
+
 	// Set the single aeActiveSimBox pointer to 0 to ensure that multiple simulations
 	// use different objects, and zero the active event counter so that successive runs
     // label events starting at 1.
@@ -213,6 +223,14 @@ void aeActiveSimBox::CreateReceptorNetwork(long xn, long yn, long zn)
 
 void aeActiveSimBox::Evolve()
 {
+	// The beads have moved, so the bond hash must be updated before the
+	// ACNs next query it
+
+	if(m_pBondHash)
+	{
+		m_pBondHash->Invalidate();
+	}
+
 	for(StringActiveACNIterator iterACN=m_mACN.begin(); iterACN!=m_mACN.end(); iterACN++)
 	{
 		(*iterACN).second->Evolve();
@@ -256,6 +274,14 @@ IACNAccessControl* aeActiveSimBox::GetIACNAccessControlFromType(const zString ty
 	return pTargetACN;
 }
 
+// Function to return the spatial hash of the free bonds of all the ACNs.
+// It is null until the first ACN is created.
+
+aeActiveBondHash* aeActiveSimBox::GetBondHash() const
+{
+	return m_pBondHash;
+}
+
 // Protected functions to allow the ACNs access to the original SimBox data
 
 const zString aeActiveSimBox::GetRunId() const
@@ -433,6 +459,17 @@ void aeActiveSimBox::CreateACNFromType(const zString acnType, long xn, long yn,
 		const long cntYNo = m_pISimBox->GetCNTYCellNo();
 		const long cntZNo = m_pISimBox->GetCNTZCellNo();
 
+		// The bond hash uses the CNT cells of the SimBox. It must exist before
+		// the ACN is created so that the ACN's initial bonds can be added to it.
+
+		if(!m_pBondHash)
+		{
+			m_pBondHash = new aeActiveBondHash(cntXNo, cntYNo, cntZNo,
+											   m_pISimBox->GetCNTXCellWidth(),
+											   m_pISimBox->GetCNTYCellWidth(),
+											   m_pISimBox->GetCNTZCellWidth());
+		}
+
 		// Calculate the (integer) number of active cells per dimension and their widths
 
 		long xNo = cntXNo/xn;
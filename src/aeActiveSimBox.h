@@ -14,6 +14,7 @@ class aeArp23Network;
 class aefActinNetwork;
 class aeForminNetwork;
 class aeReceptorNetwork;
+class aeActiveBondHash;
 
 
 #include "IActiveSimBox.h"
@@ -42,7 +43,7 @@ public:
 
 private:
 
-	static aeActiveSimBox* m_pInstance;
+	static thread_local aeActiveSimBox* m_pInstance;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -65,6 +66,8 @@ public:
 
 	virtual IACNAccessControl* GetIACNAccessControlFromType(const zString type);
 
+	virtual aeActiveBondHash* GetBondHash() const;
+
 	// ****************************************
 	// Public access functions
 public:
@@ -146,6 +149,10 @@ private:
 	
 	StringAccessibleACNMap	m_mAccessACN;	// Map of (string, IAccessControlACN*) pairs
 
+	// Spatial hash of the free bonds of all the ACNs: created with the first ACN
+
+	aeActiveBondHash*		m_pBondHash;
+
 };
 
 #endif // !defined(AFX_AEACTIVESIMBOX_H__581F3756_5F08_4ACF_966A_40A7EB2B0655__INCLUDED_)
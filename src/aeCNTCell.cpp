@@ -29,12 +29,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-long   aeCNTCell::m_CNTXCellNo			= 0;
-long   aeCNTCell::m_CNTYCellNo			= 0;
-long   aeCNTCell::m_CNTZCellNo			= 0;
-double aeCNTCell::m_CNTXCellWidth		= 0.0;
-double aeCNTCell::m_CNTYCellWidth		= 0.0;
-double aeCNTCell::m_CNTZCellWidth		= 0.0;
+thread_local long   aeCNTCell::m_CNTXCellNo			= 0;
+thread_local long   aeCNTCell::m_CNTYCellNo			= 0;
+thread_local long   aeCNTCell::m_CNTZCellNo			= 0;
+thread_local double aeCNTCell::m_CNTXCellWidth		= 0.0;
+thread_local double aeCNTCell::m_CNTYCellWidth		= 0.0;
+thread_local double aeCNTCell::m_CNTZCellWidth		= 0.0;
 
 // Static function to define the number and sizes of the active network's CNT cells.
 //
@@ -155,9 +155,19 @@ void aeCNTCell::RemoveActiveBondFromCell(aeActiveBond *pBond)
 	m_lBonds.remove(pBond);
 }
 
+// Function to move an active bond from this cell to another one. The bond's
+// list node is spliced onto the front of the new cell's list, so the bonds
+// end up in the same order as if it had been removed and added again, but
+// without searching the list or reallocating the node.
+
+void aeCNTCell::MoveActiveBondToCell(cActiveBondListIterator citerBond, aeCNTCell* pCell)
+{
+	pCell->m_lBonds.splice(pCell->m_lBonds.begin(), m_lBonds, citerBond);
+}
+
 // Function to return a container of all active bonds in the cell.
 
-ActiveBondList aeCNTCell::GetBonds()
+const ActiveBondList& aeCNTCell::GetBonds() const
 {
 	return m_lBonds;
 }
@@ -274,7 +284,7 @@ aeActiveBond* aeCNTCell::UpdatePolymerisation(aeActiveBond* const pBond)
 
     for(short int i=0; i<27; i++)
     {
-        ActiveBondList lNNBonds = m_aNNCells[i]->GetBonds();
+        const ActiveBondList& lNNBonds = m_aNNCells[i]->GetBonds();
 		copy(lNNBonds.begin(), lNNBonds.end(), back_inserter(vLocalBonds));
     }
 
@@ -27,12 +27,12 @@ public:
 
 public:
 
-	static long m_CNTXCellNo;
-	static long m_CNTYCellNo;
-	static long m_CNTZCellNo;
-	static double m_CNTXCellWidth;
-	static double m_CNTYCellWidth;
-	static double m_CNTZCellWidth;
+	static thread_local long m_CNTXCellNo;
+	static thread_local long m_CNTYCellNo;
+	static thread_local long m_CNTZCellNo;
+	static thread_local double m_CNTXCellWidth;
+	static thread_local double m_CNTYCellWidth;
+	static thread_local double m_CNTZCellWidth;
 
 
 	// ****************************************
@@ -54,7 +54,8 @@ public:
 
 	void AddActiveBondToCell(aeActiveBond* pBond);
 	void RemoveActiveBondFromCell(aeActiveBond* pBond);
-	ActiveBondList GetBonds();
+	void MoveActiveBondToCell(cActiveBondListIterator citerBond, aeCNTCell* pCell);
+	const ActiveBondList& GetBonds() const;
 
 	// ****************************************
 	// Protected local functions
@@ -127,6 +127,21 @@ bool aeForminBond::Deactivate()
 	return false;
 }
 
+// Function returning the probability that Deactivate() succeeds so that the
+// ACN can schedule the unbinding events of the polymer's end bonds.
+
+double aeForminBond::GetOffProbability() const
+{
+	if(GetHeadMonomer())	// Current bond is the tail of the active polymer
+	{
+		return HeadOffProbability();
+	}
+	else	// Current bond is the head of the active polymer
+	{
+		return TailOffProbability();
+	}
+}
+
 // Function to change the probability of an active bond detaching from its
 // neighbour via its head connection. If the bond does not implement the
 // appropriate aeBondOffCondition, it is not modified.
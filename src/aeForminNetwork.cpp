@@ -874,6 +874,10 @@ void aeForminNetwork::SetFixedHeadOffRate(double rate)
 
 		dynamic_cast<aeForminBond*>(pHeadBond)->SetFixedHeadOffRate(rate);
 	}
+
+	// Resample the waiting times of the unbinding events
+
+	RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set a fixed probability for a monomer to detach
@@ -915,4 +919,8 @@ void aeForminNetwork::SetFixedTailOffRate(double rate)
 
 		dynamic_cast<aeForminBond*>(pHeadBond)->SetFixedTailOffRate(rate);
 	}
+
+	// Resample the waiting times of the unbinding events
+
+	RescheduleBondUnbindsEvents();
 }
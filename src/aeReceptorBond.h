@@ -36,6 +36,8 @@ public:
 	virtual bool Activate(aeActiveBond* const pTargetBond);
 	virtual bool Deactivate();
 
+	virtual double GetOffProbability() const;
+
 	// ****************************************
 	// Public access functions
 public:
@@ -823,6 +823,10 @@ void aeReceptorNetwork::SetFixedHeadOffRate(double rate)
 
 		dynamic_cast<aeReceptorBond*>(pHeadBond)->SetFixedHeadOffRate(rate);
 	}
+
+	// Resample the waiting times of the unbinding events
+
+	RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set a fixed probability for a monomer to detach
@@ -864,4 +868,8 @@ void aeReceptorNetwork::SetFixedTailOffRate(double rate)
 
 		dynamic_cast<aeReceptorBond*>(pHeadBond)->SetFixedTailOffRate(rate);
 	}
+
+	// Resample the waiting times of the unbinding events
+
+	RescheduleBondUnbindsEvents();
 }
@@ -48,17 +48,19 @@ long aefActinBond::m_ActiveBondsPerPolymer = 1000;
 // internal state does not influence their behaviour. They must be
 // set by command.
 //
-double aefActinBond::m_ATPHydrolysisProb       = 0.0;  // Probability of ATP hydrolysis
-double aefActinBond::m_ADPReleasePiProb        = 0.0;  // Probability of releasing Pi
-double aefActinBond::m_ADPPhosphorylationProb  = 0.0;  // Probability of phosphorylation
+thread_local double aefActinBond::m_ATPHydrolysisProb       = 0.0;  // Probability of ATP hydrolysis
+thread_local double aefActinBond::m_ADPReleasePiProb        = 0.0;  // Probability of releasing Pi
+thread_local double aefActinBond::m_ADPPhosphorylationProb  = 0.0;  // Probability of phosphorylation
 
 
-double aefActinBond::m_HeadBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament head
-double aefActinBond::m_TailBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament tail
-double aefActinBond::m_HeadADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at head
-double aefActinBond::m_TailADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
-double aefActinBond::m_HeadADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at head
-double aefActinBond::m_TailADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at tail
+thread_local double aefActinBond::m_HeadBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament head
+thread_local double aefActinBond::m_TailBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament tail
+thread_local double aefActinBond::m_HeadADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at head
+thread_local double aefActinBond::m_TailADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
+thread_local double aefActinBond::m_HeadADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at head
+thread_local double aefActinBond::m_TailADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at tail
+thread_local double aefActinBond::m_HeadMaxOffMultiplier = 1.0;     // Largest multiplier applied to the basal rate at head
+thread_local double aefActinBond::m_TailMaxOffMultiplier = 1.0;     // Largest multiplier applied to the basal rate at tail
 
 
 // Function to set the probability of the transitions ATP --> ADP-Pi
@@ -226,6 +228,38 @@ bool aefActinBond::Deactivate()
 	return false;
 }
 
+// Functions returning the probability that Deactivate() succeeds, and the
+// largest value it can take as the bond's ATP state changes. The current 
+// rate is always the basal rate times one of the multipliers that have been 
+// set, as changing the basal rate resets the current rate of all bonds, so
+// we keep the largest multiplier and never reduce it.
+
+double aefActinBond::GetOffProbability() const
+{
+	if(GetHeadMonomer())	// Current bond is the tail of the active polymer
+	{
+		return HeadOffProbability();
+	}
+	else	// Current bond is the head of the active polymer
+	{
+		return TailOffProbability();
+	}
+}
+
+double aefActinBond::GetMaxOffProbability() const
+{
+	const double prob = GetOffProbability();
+
+	if(prob < 0.0)
+	{
+		return prob;
+	}
+
+	const double maxProb = (GetHeadMonomer() ? m_HeadMaxOffMultiplier*m_HeadBasalOffRate : m_TailMaxOffMultiplier*m_TailBasalOffRate);
+
+	return std::min(1.0, std::max(prob, maxProb));
+}
+
 // Command handler function to change the basal probability of an active bond 
 // detaching from its neighbour via its head connection. If the bond does not 
 // implement the appropriate aeBondOffCondition, it is not modified.
@@ -361,16 +395,7 @@ bool aefActinBond::Hydrolyse()
 {
     if(CCNTCell::GetRandomNo() < m_ATPHydrolysisProb)
     {
-	    m_bATP = false;
-	    m_bPi  = true;
-
-        // Change the probabilities of binding/unbinding according
-        // to a factor that represents the effects of ATP hydrolysis
-        // on the process.
-
-        SetCurrentHeadOffRate(m_HeadADPPiMultiplier*m_HeadBasalOffRate);
-        SetCurrentTailOffRate(m_TailADPPiMultiplier*m_TailBasalOffRate);
-
+        SetADPPiBound();
         return true;
     }
     else
@@ -386,16 +411,7 @@ bool aefActinBond::ReleasePi()
 {
     if(CCNTCell::GetRandomNo() < m_ADPReleasePiProb)
     {
-	    m_bATP = false;
-	    m_bPi  = false;
-
-        // Change the probabilities of binding/unbinding according
-        // to a factor that represents the effects of ADP releasing
-        // Pi on the process.
-
-        SetCurrentHeadOffRate(m_HeadADPMultiplier*m_HeadBasalOffRate);
-        SetCurrentTailOffRate(m_TailADPMultiplier*m_TailBasalOffRate);
-
+        SetADPBound();
         return true;
     }
     else
@@ -411,16 +427,7 @@ bool aefActinBond::Phosphorylate()
 {
     if(CCNTCell::GetRandomNo() < m_ADPPhosphorylationProb)
     {
-	    m_bATP = true;
-	    m_bPi  = false;
-
-        // Change the probabilities of binding/unbinding according
-        // to a factor that represents the effects of ADP being
-        // phosphorylated to ATP on the process.
-
-        SetCurrentHeadOffRate(m_HeadBasalOffRate);
-        SetCurrentTailOffRate(m_TailBasalOffRate);
-
+        SetATPBound();
         return true;
     }
     else
@@ -429,6 +436,51 @@ bool aefActinBond::Phosphorylate()
     }
 }
 
+// Function to make the transition ATP --> ADP-Pi.
+
+void aefActinBond::SetADPPiBound()
+{
+    m_bATP = false;
+    m_bPi  = true;
+
+    // Change the probabilities of binding/unbinding according
+    // to a factor that represents the effects of ATP hydrolysis
+    // on the process.
+
+    SetCurrentHeadOffRate(m_HeadADPPiMultiplier*m_HeadBasalOffRate);
+    SetCurrentTailOffRate(m_TailADPPiMultiplier*m_TailBasalOffRate);
+}
+
+// Function to make the transition ADP-Pi --> ADP.
+
+void aefActinBond::SetADPBound()
+{
+    m_bATP = false;
+    m_bPi  = false;
+
+    // Change the probabilities of binding/unbinding according
+    // to a factor that represents the effects of ADP releasing
+    // Pi on the process.
+
+    SetCurrentHeadOffRate(m_HeadADPMultiplier*m_HeadBasalOffRate);
+    SetCurrentTailOffRate(m_TailADPMultiplier*m_TailBasalOffRate);
+}
+
+// Function to make the transition ADP --> ATP.
+
+void aefActinBond::SetATPBound()
+{
+    m_bATP = true;
+    m_bPi  = false;
+
+    // Change the probabilities of binding/unbinding according
+    // to a factor that represents the effects of ADP being
+    // phosphorylated to ATP on the process.
+
+    SetCurrentHeadOffRate(m_HeadBasalOffRate);
+    SetCurrentTailOffRate(m_TailBasalOffRate);
+}
+
 // Command handler function to change the multiplier that is applied
 // to the basal rate for the bond detaching at its head when it is in
 // the ADP-Pi state.
@@ -438,6 +490,7 @@ void aefActinBond::SetHeadADPPiMultiplier(double factor)
     if(factor >= 0.0)
     {
         m_HeadADPPiMultiplier = factor;
+        m_HeadMaxOffMultiplier = std::max(m_HeadMaxOffMultiplier, factor);
     }
 }
 
@@ -450,6 +503,7 @@ void aefActinBond::SetTailADPPiMultiplier(double factor)
     if(factor >= 0.0)
     {
         m_TailADPPiMultiplier = factor;
+        m_TailMaxOffMultiplier = std::max(m_TailMaxOffMultiplier, factor);
     }
 }
 
@@ -462,6 +516,7 @@ void aefActinBond::SetHeadADPMultiplier(double factor)
     if(factor >= 0.0)
     {
         m_HeadADPMultiplier = factor;
+        m_HeadMaxOffMultiplier = std::max(m_HeadMaxOffMultiplier, factor);
     }
 }
 
@@ -474,6 +529,7 @@ void aefActinBond::SetTailADPMultiplier(double factor)
     if(factor >= 0.0)
     {
         m_TailADPMultiplier = factor;
+        m_TailMaxOffMultiplier = std::max(m_TailMaxOffMultiplier, factor);
     }
 }
 
@@ -32,6 +32,10 @@ public:
 	static void SetADPReleasePiProbability(double prob);
 	static void SetADPPhosphorylationProbability(double prob);
 
+	static double GetATPHydrolysisProbability()      {return m_ATPHydrolysisProb;}
+	static double GetADPReleasePiProbability()       {return m_ADPReleasePiProb;}
+	static double GetADPPhosphorylationProbability() {return m_ADPPhosphorylationProb;}
+
 	static void SetHeadADPPiMultiplier(double factor);
 	static void SetTailADPPiMultiplier(double factor);
 	static void SetHeadADPMultiplier(double factor);
@@ -41,16 +45,18 @@ private:
 
 	static long	m_ActiveBondsPerPolymer;
 
-    static double m_ATPHydrolysisProb;       // Probability of ATP hydrolysis
-    static double m_ADPReleasePiProb;        // Probability of releasing Pi
-    static double m_ADPPhosphorylationProb;  // Probability of phosphorylation
+    static thread_local double m_ATPHydrolysisProb;       // Probability of ATP hydrolysis
+    static thread_local double m_ADPReleasePiProb;        // Probability of releasing Pi
+    static thread_local double m_ADPPhosphorylationProb;  // Probability of phosphorylation
 
-    static double m_HeadBasalOffRate;         // Probability for ATP monomer to detach from filament head
-    static double m_TailBasalOffRate;         // Probability for ATP monomer to detach from filament tail
-    static double m_HeadADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at head
-    static double m_TailADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
-    static double m_HeadADPMultiplier;        // Multiplier applied to basal rate when Pi is released at head
-    static double m_TailADPMultiplier;        // Multiplier applied to basal rate when Pi is released at tail
+    static thread_local double m_HeadBasalOffRate;         // Probability for ATP monomer to detach from filament head
+    static thread_local double m_TailBasalOffRate;         // Probability for ATP monomer to detach from filament tail
+    static thread_local double m_HeadADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at head
+    static thread_local double m_TailADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
+    static thread_local double m_HeadADPMultiplier;        // Multiplier applied to basal rate when Pi is released at head
+    static thread_local double m_TailADPMultiplier;        // Multiplier applied to basal rate when Pi is released at tail
+    static thread_local double m_HeadMaxOffMultiplier;     // Largest multiplier applied to the basal rate at head
+    static thread_local double m_TailMaxOffMultiplier;     // Largest multiplier applied to the basal rate at tail
 
     // ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -60,6 +66,9 @@ public:
 	virtual bool Activate(aeActiveBond* const pTargetBond);
 	virtual bool Deactivate();
 
+	virtual double GetOffProbability() const;
+	virtual double GetMaxOffProbability() const;
+
 	// ****************************************
 	// Public access functions
 public:
@@ -90,6 +99,13 @@ public:
 	bool ReleasePi();		// ADP-Pi --> ADP
 	bool Phosphorylate();	// ADP    --> ATP
 
+	// Functions that make the transitions unconditionally: these are used
+	// by events whose firing time has already been sampled by the ACN
+
+	void SetADPPiBound();	// ATP    --> ADP-Pi
+	void SetADPBound();		// ADP-Pi --> ADP
+	void SetATPBound();		// ADP    --> ATP
+
 	// ****************************************
 	// Protected local functions
 protected:
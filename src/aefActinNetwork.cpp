@@ -35,6 +35,9 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "aevBondBindsForwardConeToPolymerTail.h"
 #include "aevBondUnbindsFromPolymerHead.h"
 #include "aevBondUnbindsFromPolymerTail.h"
+#include "aevBondHydrolysesATP.h"
+#include "aevBondReleasesPi.h"
+#include "aevBondPhosphorylation.h"
 
 //////////////////////////////////////////////////////////////////////
 // Global members
@@ -641,6 +644,10 @@ void aefActinNetwork::SetFixedHeadOffRate(double rate)
 
 		dynamic_cast<aefActinBond*>(pHeadBond)->SetFixedHeadOffRate(rate);
 	}
+
+	// Resample the waiting times of the unbinding events
+
+	RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set a fixed probability for a monomer to detach
@@ -682,6 +689,10 @@ void aefActinNetwork::SetFixedTailOffRate(double rate)
 
 		dynamic_cast<aefActinBond*>(pHeadBond)->SetFixedTailOffRate(rate);
 	}
+
+	// Resample the waiting times of the unbinding events
+
+	RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set the fixed probability for an actin
@@ -689,10 +700,13 @@ void aefActinNetwork::SetFixedTailOffRate(double rate)
 // internal state change can be used to modify the probabilities of its
 // behaviour, e.g., detaching from a filament. 
 // Note that we check that the new probability is within [0,1] in the aefActinBond function.
+// The events waiting for their transitions are rescheduled using the new probability.
 
 void aefActinNetwork::SetATPHydrolysisProbability(double rate)
 {
     aefActinBond::SetATPHydrolysisProbability(rate);
+
+    RescheduleEventsByType(aevBondHydrolysesATP::GetType());
 }
 
 // Command handler function to set the fixed probability for an actin
@@ -704,6 +718,8 @@ void aefActinNetwork::SetATPHydrolysisProbability(double rate)
 void aefActinNetwork::SetADPReleasePiProbability(double rate)
 {
     aefActinBond::SetADPReleasePiProbability(rate);
+
+    RescheduleEventsByType(aevBondReleasesPi::GetType());
 }
 
 // Command handler function to set the fixed probability for an actin
@@ -715,6 +731,8 @@ void aefActinNetwork::SetADPReleasePiProbability(double rate)
 void aefActinNetwork::SetADPPhosphorylationProbability(double rate)
 {
     aefActinBond::SetADPPhosphorylationProbability(rate);
+
+    RescheduleEventsByType(aevBondPhosphorylation::GetType());
 }
 
 // Command handler function to set the multiplier for an ADP-Pi
@@ -725,6 +743,8 @@ void aefActinNetwork::SetADPPhosphorylationProbability(double rate)
 void aefActinNetwork::SetHeadADPPiMultiplier(double factor)
 {
     aefActinBond::SetHeadADPPiMultiplier(factor);
+
+    RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set the multiplier for an ADP-Pi
@@ -735,6 +755,8 @@ void aefActinNetwork::SetHeadADPPiMultiplier(double factor)
 void aefActinNetwork::SetTailADPPiMultiplier(double factor)
 {
     aefActinBond::SetTailADPPiMultiplier(factor);
+
+    RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set the multiplier for an ADP
@@ -745,6 +767,8 @@ void aefActinNetwork::SetTailADPPiMultiplier(double factor)
 void aefActinNetwork::SetHeadADPMultiplier(double factor)
 {
     aefActinBond::SetHeadADPMultiplier(factor);
+
+    RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to set the multiplier for an ADP
@@ -755,6 +779,8 @@ void aefActinNetwork::SetHeadADPMultiplier(double factor)
 void aefActinNetwork::SetTailADPMultiplier(double factor)
 {
     aefActinBond::SetTailADPMultiplier(factor);
+
+    RescheduleBondUnbindsEvents();
 }
 
 // Command handler function to display fActin monomers according to their bound
@@ -46,7 +46,7 @@ zInStream& operator>>(zInStream& is, aevActiveEvent& event)
 
 // Static member variable holding the number of events created.
 
-long aevActiveEvent::m_EventTotal = 0;
+thread_local long aevActiveEvent::m_EventTotal = 0;
 
 long aevActiveEvent::GetEventTotal()
 {
@@ -433,6 +433,28 @@ void aevActiveEvent::BroadcastState()
 {
 }
 
+// VFs that are over-ridden by events that can be scheduled by their ACN. 
+// ExecuteScheduled() is called when the event's trial has succeeded, and
+// returns false if the event has executed and should be destroyed, or true
+// if its other conditions were not satisfied so that the ACN must sample 
+// a new execution time. By default, events are polled every time step, and 
+// a scheduled execution falls back to the normal Execute() function.
+
+bool aevActiveEvent::IsScheduled() const
+{
+	return false;
+}
+
+double aevActiveEvent::GetTrialProbability() const
+{
+	return 1.0;
+}
+
+bool aevActiveEvent::ExecuteScheduled(IActiveSimBox* const pShadow)
+{
+	return Execute(pShadow);
+}
+
 // Function to return the current time from the event. This allows event source 
 // decorators to get the time at which an event succeeds for analysis.
 
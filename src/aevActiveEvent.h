@@ -44,7 +44,7 @@ public:
 
 private:
 
-	static long m_EventTotal;		// Number of events created
+	static thread_local long m_EventTotal;		// Number of events created
 
 	// ****************************************
 	// PVS that must be overridden by all derived classes
@@ -73,6 +73,16 @@ public:
 
 	virtual bool InternalValidateData();
 
+	// VFs used by the containing ACN to schedule events whose only condition
+	// for execution is a trial that succeeds with a fixed probability once
+	// every execution period. Instead of polling them, the ACN samples the
+	// time of the first successful trial and calls ExecuteScheduled() when it
+	// arrives. The defaults provided here mark an event as polled.
+
+	virtual bool   IsScheduled() const;
+	virtual double GetTrialProbability() const;
+	virtual bool   ExecuteScheduled(IActiveSimBox* const pShadow);
+
 protected:
 
     // VF that allows derived classes to inform their containing instance when their
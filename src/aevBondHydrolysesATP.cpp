@@ -198,17 +198,7 @@ bool aevBondHydrolysesATP::Execute(IActiveSimBox* const pShadow)
     {
 	    if(DecrementTimer() && m_pBond->Hydrolyse())
 	    {
-            // Create next event in the chain and store it in the containing bond.
-            // Note that we know the identity of the next event so we don't need
-            // to get the default instance type from the ACN, we just create 
-            // a new instance of the desired type, viz, aevBondReleasesPi.
-
-            aevBondReleasesPi* pNextEvent = dynamic_cast<aevBondReleasesPi*>(AddEvent(aevBondReleasesPi::GetType()));
-
-            pNextEvent->SetContainingACN(GetACN());
-            pNextEvent->SetBond(m_pBond);
-            pNextEvent->SetExecutionPeriod(GetACN()->GetInternalEventExecutionPeriodFromName(pNextEvent->GetEventType()));
-		    pNextEvent->CheckPreconditions();
+            AddNextEvent();
 
  //           std::cout << "ATP Hydrolysed " << m_pBond->GetId() << zEndl;
 
@@ -218,6 +208,57 @@ bool aevBondHydrolysesATP::Execute(IActiveSimBox* const pShadow)
     return true;
 }
 
+// **********************************************************************
+// Functions that allow the ACN to schedule the event. Its only random 
+// condition is the bond's fixed hydrolysis probability, so the ACN samples
+// the time step at which hydrolysis succeeds and calls ExecuteScheduled()
+// then. If a contra event is active at that time, we return true and the 
+// ACN samples a new time.
+
+bool aevBondHydrolysesATP::IsScheduled() const
+{
+	return m_pBond != 0;
+}
+
+double aevBondHydrolysesATP::GetTrialProbability() const
+{
+	return aefActinBond::GetATPHydrolysisProbability();
+}
+
+bool aevBondHydrolysesATP::ExecuteScheduled(IActiveSimBox* const pShadow)
+{
+	if(!m_pIEvent)
+	{
+		m_pIEvent = pShadow->GetIActiveBondHydrolysesATP();
+	}
+
+	if(IsAnyContraEventActive())
+	{
+		return true;
+	}
+
+	m_pBond->SetADPPiBound();
+
+	AddNextEvent();
+
+	return false;
+}
+
+// Private function to create the next event in the chain and store it in the
+// containing bond. Note that we know the identity of the next event so we
+// don't need to get the default instance type from the ACN, we just create
+// a new instance of the desired type, viz, aevBondReleasesPi.
+
+void aevBondHydrolysesATP::AddNextEvent()
+{
+	aevBondReleasesPi* pNextEvent = dynamic_cast<aevBondReleasesPi*>(AddEvent(aevBondReleasesPi::GetType()));
+
+	pNextEvent->SetContainingACN(GetACN());
+	pNextEvent->SetBond(m_pBond);
+	pNextEvent->SetExecutionPeriod(GetACN()->GetInternalEventExecutionPeriodFromName(pNextEvent->GetEventType()));
+	pNextEvent->CheckPreconditions();
+}
+
 // Function to return the id of the wrapped bond.
 
 long aevBondHydrolysesATP::GetBondId() const
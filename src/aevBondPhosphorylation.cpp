@@ -222,6 +222,40 @@ bool aevBondPhosphorylation::Execute(IActiveSimBox* const pShadow)
     return true;
 }
 
+// **********************************************************************
+// Scheduling functions. The phosphorylation trial is independent of the 
+// bond's state, so when the sampled time arrives the event still requires
+// the bond to be free, as in Execute(). If it is bound into a filament the
+// trial would have failed, and the ACN samples the next successful trial
+// from the current time.
+
+bool aevBondPhosphorylation::IsScheduled() const
+{
+	return m_pBond != 0;
+}
+
+double aevBondPhosphorylation::GetTrialProbability() const
+{
+	return aefActinBond::GetADPPhosphorylationProbability();
+}
+
+bool aevBondPhosphorylation::ExecuteScheduled(IActiveSimBox* const pShadow)
+{
+	if(!m_pIEvent)
+	{
+		m_pIEvent = pShadow->GetIActiveBondPhosphorylation();
+	}
+
+	if(IsAnyContraEventActive() || m_pBond->IsPolymerised())
+	{
+		return true;
+	}
+
+	m_pBond->SetATPBound();
+
+	return false;
+}
+
 // Function to return the id of the wrapped bond.
 
 long aevBondPhosphorylation::GetBondId() const
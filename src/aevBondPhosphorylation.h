@@ -50,6 +50,10 @@ public:
 
 	virtual bool InternalValidateData();
 
+	virtual bool   IsScheduled() const;
+	virtual double GetTrialProbability() const;
+	virtual bool   ExecuteScheduled(IActiveSimBox* const pShadow);
+
 protected:
 
 	// ****************************************
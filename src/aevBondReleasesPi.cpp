@@ -198,17 +198,7 @@ bool aevBondReleasesPi::Execute(IActiveSimBox* const pShadow)
     {
 	    if(DecrementTimer() && m_pBond->ReleasePi())
 	    {
-            // Create next event in the chain and store it in the containing bond.
-            // Note that we know the identity of the next event so we don't need
-            // to get the default instance type from the ACN, we just create 
-            // a new instance of the desired type, viz, aevBondPhosphorylation.
-
-            aevBondPhosphorylation* pNextEvent = dynamic_cast<aevBondPhosphorylation*>(AddEvent(aevBondPhosphorylation::GetType()));
-
-            pNextEvent->SetContainingACN(GetACN());
-            pNextEvent->SetBond(m_pBond);
-            pNextEvent->SetExecutionPeriod(GetACN()->GetInternalEventExecutionPeriodFromName(pNextEvent->GetEventType()));
-            pNextEvent->CheckPreconditions();
+            AddNextEvent();
 
 //             std::cout << "Pi released " << m_pBond->GetId() << zEndl;
 
@@ -218,6 +208,55 @@ bool aevBondReleasesPi::Execute(IActiveSimBox* const pShadow)
     return true;
 }
 
+// **********************************************************************
+// Scheduling functions: as for aevBondHydrolysesATP, the ACN samples the
+// time step at which the bond releases its Pi, and this event only has
+// to check its contra events and make the transition when it is called.
+
+bool aevBondReleasesPi::IsScheduled() const
+{
+	return m_pBond != 0;
+}
+
+double aevBondReleasesPi::GetTrialProbability() const
+{
+	return aefActinBond::GetADPReleasePiProbability();
+}
+
+bool aevBondReleasesPi::ExecuteScheduled(IActiveSimBox* const pShadow)
+{
+	if(!m_pIEvent)
+	{
+		m_pIEvent = pShadow->GetIActiveBondReleasesPi();
+	}
+
+	if(IsAnyContraEventActive())
+	{
+		return true;
+	}
+
+	m_pBond->SetADPBound();
+
+	AddNextEvent();
+
+	return false;
+}
+
+// Private function to create the next event in the chain and store it in the
+// containing bond. Note that we know the identity of the next event so we
+// don't need to get the default instance type from the ACN, we just create
+// a new instance of the desired type, viz, aevBondPhosphorylation.
+
+void aevBondReleasesPi::AddNextEvent()
+{
+	aevBondPhosphorylation* pNextEvent = dynamic_cast<aevBondPhosphorylation*>(AddEvent(aevBondPhosphorylation::GetType()));
+
+	pNextEvent->SetContainingACN(GetACN());
+	pNextEvent->SetBond(m_pBond);
+	pNextEvent->SetExecutionPeriod(GetACN()->GetInternalEventExecutionPeriodFromName(pNextEvent->GetEventType()));
+	pNextEvent->CheckPreconditions();
+}
+
 // Function to return the id of the wrapped bond.
 
 long aevBondReleasesPi::GetBondId() const
@@ -50,6 +50,10 @@ public:
 
 	virtual bool InternalValidateData();
 
+	virtual bool   IsScheduled() const;
+	virtual double GetTrialProbability() const;
+	virtual bool   ExecuteScheduled(IActiveSimBox* const pShadow);
+
 protected:
 
 	// ****************************************
@@ -78,6 +82,8 @@ protected:
 	// Private functions
 private:						
 
+	void AddNextEvent();
+
 
 	// ****************************************
 	// Data members
@@ -28,6 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "IActiveBondUnbindsFromPolymer.h"
 #include "aeActiveCellNetwork.h"
 #include "aefActinBond.h"
+#include "CNTCell.h"
 
 
 
@@ -253,24 +254,7 @@ bool aevBondUnbindsFromPolymerHead::Execute(IActiveSimBox* const pShadow)
     {
 	    if(!IsActive() && DecrementTimer() && m_pPolymer->GetSize() > 2 && m_pPolymer->GetHeadBond()->Deactivate())
 	    {
-            SetActive();
-
-            // Set up the initial conditions for the bond detaching
-
- 		    m_Counter = GetDuration();
-			m_pInternalBond->SetBeads(m_pPolymer->GetHeadBond()->GetTailAdjacentBond()->GetTailHeadBead(), m_pPolymer->GetHeadBond()->GetTailHeadBead());
-		    m_pInternalBond->SetSpringConstant(GetSpringConstant());
-		    m_pInternalBond->SetUnStretchedLength(2.0*GetLength());
-
-            // Store the old terminal bond until it has completed its separation, but
-            // remove it from the polymer so that polymers of length 3 do not initiate
-            // unbding events at both ends. Indicate to all contra events that 
-            // this event is now active. We ignore the return value from 
-		    // RemoveHeadBond() as we have checked above that the polymer 
-            // has more than its minimal number of bonds.
-
-		    m_pOldHeadBond = m_pPolymer->GetHeadBond();
-		    m_pPolymer->RemoveHeadBond();
+            StartDetachment();
         }  
         else if(IsActive())
         {
@@ -356,6 +340,72 @@ bool aevBondUnbindsFromPolymerHead::Execute(IActiveSimBox* const pShadow)
 
 }
 
+// **********************************************************************
+// Functions that allow the ACN to schedule the event while it waits for the
+// polymer's head bond to detach. This is only possible when the bond's
+// Deactivate() function is a fixed-probability trial, e.g., an aeBondOffRate
+// off condition. The trials are sampled using the largest probability the
+// bond can have, and a successful trial is accepted with the ratio of the
+// current probability to that bound. This is exact even though the end bond
+// and its internal state change while the event waits. If the other conditions 
+// are not satisfied when the trial succeeds, we return true and the ACN 
+// samples a new time. Once the bond starts to detach, the event is polled 
+// until it has been released.
+
+bool aevBondUnbindsFromPolymerHead::IsScheduled() const
+{
+	return m_pPolymer && !IsActive() && m_pPolymer->GetHeadBond()->GetOffProbability() >= 0.0;
+}
+
+double aevBondUnbindsFromPolymerHead::GetTrialProbability() const
+{
+	return m_pPolymer->GetHeadBond()->GetMaxOffProbability();
+}
+
+bool aevBondUnbindsFromPolymerHead::ExecuteScheduled(IActiveSimBox* const pShadow)
+{
+	if(!m_pIEvent)
+	{
+		m_pIEvent = pShadow->GetIActiveBondUnbindsFromPolymer();
+	}
+
+	const aeActiveBond* const pEndBond = m_pPolymer->GetHeadBond();
+
+	if(!IsAnyContraEventActive() && m_pPolymer->GetSize() > 2 &&
+	   CCNTCell::GetRandomNo()*pEndBond->GetMaxOffProbability() < pEndBond->GetOffProbability())
+	{
+		StartDetachment();
+	}
+
+	return true;
+}
+
+// Private function to start detaching the polymer's end bond once its off
+// condition has been satisfied. It is used both when the event is polled and
+// when its scheduled trial succeeds.
+
+void aevBondUnbindsFromPolymerHead::StartDetachment()
+{
+	SetActive();
+
+	// Set up the initial conditions for the bond detaching
+
+	m_Counter = GetDuration();
+	m_pInternalBond->SetBeads(m_pPolymer->GetHeadBond()->GetTailAdjacentBond()->GetTailHeadBead(), m_pPolymer->GetHeadBond()->GetTailHeadBead());
+	m_pInternalBond->SetSpringConstant(GetSpringConstant());
+	m_pInternalBond->SetUnStretchedLength(2.0*GetLength());
+
+	// Store the old terminal bond until it has completed its separation, but
+	// remove it from the polymer so that polymers of length 3 do not initiate
+	// unbding events at both ends. Indicate to all contra events that 
+	// this event is now active. We ignore the return value from 
+	// RemoveHeadBond() as we have checked above that the polymer 
+	// has more than its minimal number of bonds.
+
+	m_pOldHeadBond = m_pPolymer->GetHeadBond();
+	m_pPolymer->RemoveHeadBond();
+}
+
 // VF that allows this event class to broadcast information about its state
 // to its containing instance for analysis by event source/analysis decorators.
 // Currently, this event just tells its containing ACN that it has successfully
@@ -50,6 +50,10 @@ public:
 
 	virtual bool InternalValidateData();
 
+	virtual bool   IsScheduled() const;
+	virtual double GetTrialProbability() const;
+	virtual bool   ExecuteScheduled(IActiveSimBox* const pShadow);
+
 protected:
 
     // Over-ridden VF to allow the event class to broadcast its state.
@@ -86,6 +90,8 @@ protected:
 	// Private functions
 private:						
 
+	void StartDetachment();
+
 
 	// ****************************************
 	// Data members
@@ -79,10 +79,11 @@ void ccChargeBeadByTypeImpl::ChargeBeadByType(const xxCommand* const pCommand)
 
 		// How do I normalize the MD parameters???
 
-#if SimIdentifier == MD
-		strength *= (GetLengthScale()*GetLengthScale()/GetEnergyScale());
-		range    /= GetLengthScale();
-#endif
+		if(xxBase::GetSimIdentifier() == MD)
+		{
+			strength *= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
+			range    /= pSimBox->GetLengthScale();
+		}
 
 		// If the user has set the range to less than 10**-08, we treat this as 
 		// having a strength of zero.
@@ -94,8 +94,8 @@ void ccCreateNanoparticlePentagonImpl::CreateNanoparticlePentagon(const xxComman
 	const long   maxBondsPerPolymer	= pCmd->GetMaxBondsPerPolymer();
 	const double range			    = pCmd->GetRange();
 	const double fraction			= pCmd->GetBondFraction();
-	const double springConstant		= pCmd->GetSpringConstant();
-	const double unStretchedLength  = pCmd->GetUnstretchedLength();
+	double springConstant		= pCmd->GetSpringConstant();
+	double unStretchedLength  = pCmd->GetUnstretchedLength();
 //	const double numberType         = pCmd->GetNumberTypes();
 	const zLongVector vBeadTypes    = pCmd->GetBeadTypes();
 	const zDoubleVector vConsInt    = pCmd->GetConsInt();
@@ -481,11 +481,12 @@ void ccCreateNanoparticlePentagonImpl::CreateNanoparticlePentagon(const xxComman
 //            std::cout << logText << zEndl;
 
         
-#if SimIdentifier == MD
-            // If this is an MD run, we rescale parameters by the energy and length scales.
-		    springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
-		    unStretchedLength   /= pSimBox->GetLengthScale();
-#endif
+		    if(xxBase::GetSimIdentifier() == MD)
+		    {
+	            // If this is an MD run, we rescale parameters by the energy and length scales.
+			    springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
+			    unStretchedLength   /= pSimBox->GetLengthScale();
+		    }
         
 		    // Create a template bond for use in creating all polymerised bonds with a unique name and store the template. 
             // We get the current number of bond types from the CInitialState object and create a new type to be used as a 
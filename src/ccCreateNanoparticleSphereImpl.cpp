@@ -84,8 +84,8 @@ void ccCreateNanoparticleSphereImpl::CreateNanoparticleSphere(const xxCommand* c
 	const long   maxBondsPerPolymer	= pCmd->GetMaxBondsPerPolymer();
 	const double range			    = pCmd->GetRange();
 	const double fraction			= pCmd->GetBondFraction();
-	const double springConstant		= pCmd->GetSpringConstant();
-	const double unStretchedLength  = pCmd->GetUnstretchedLength();
+	double springConstant		= pCmd->GetSpringConstant();
+	double unStretchedLength  = pCmd->GetUnstretchedLength();
 //	const double numberType         = pCmd->GetNumberTypes();
 	const zLongVector vBeadTypes    = pCmd->GetBeadTypes();
 	const zDoubleVector vConsInt    = pCmd->GetConsInt();
@@ -443,10 +443,11 @@ void ccCreateNanoparticleSphereImpl::CreateNanoparticleSphere(const xxCommand* c
         
 		CBond* pPolyBondTemplate = 0;
         
-#if SimIdentifier == MD
-		springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
-		unStretchedLength   /= pSimBox->GetLengthScale();
-#endif
+		if(xxBase::GetSimIdentifier() == MD)
+		{
+			springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
+			unStretchedLength   /= pSimBox->GetLengthScale();
+		}
         
 		pPolyBondTemplate = new CBond(polyBondType, springConstant, unStretchedLength);
         
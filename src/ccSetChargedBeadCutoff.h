@@ -0,0 +1,79 @@
+// ccSetChargedBeadCutoff.h: interface for the ccSetChargedBeadCutoff class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CCSETCHARGEDBEADCUTOFF_H__A4C61E08_93B7_4F25_8D1A_E75F3C20B946__INCLUDED_)
+#define AFX_CCSETCHARGEDBEADCUTOFF_H__A4C61E08_93B7_4F25_8D1A_E75F3C20B946__INCLUDED_
+
+
+#include "xxCommand.h"
+
+class ccSetChargedBeadCutoff : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	ccSetChargedBeadCutoff(long executionTime);
+	ccSetChargedBeadCutoff(const ccSetChargedBeadCutoff& oldCommand);
+
+	ccSetChargedBeadCutoff(long executionTime, bool bLog, double cutoff);
+
+	virtual ~ccSetChargedBeadCutoff();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline double GetCutoff() const {return m_Cutoff;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	double  m_Cutoff;			// Cutoff distance of the screened charge force
+};
+
+#endif // !defined(AFX_CCSETCHARGEDBEADCUTOFF_H__A4C61E08_93B7_4F25_8D1A_E75F3C20B946__INCLUDED_)
@@ -0,0 +1,81 @@
+// ccSetDPDIntegrator.h: interface for the ccSetDPDIntegrator class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CCSETDPDINTEGRATOR_H__5D93B1E7_2A6C_4F08_8B41_C7E03D95A2F6__INCLUDED_)
+#define AFX_CCSETDPDINTEGRATOR_H__5D93B1E7_2A6C_4F08_8B41_C7E03D95A2F6__INCLUDED_
+
+
+#include "xxCommand.h"
+
+class ccSetDPDIntegrator : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	ccSetDPDIntegrator(long executionTime);
+	ccSetDPDIntegrator(const ccSetDPDIntegrator& oldCommand);
+
+	ccSetDPDIntegrator(long executionTime, bool bLog, const zString name);
+
+	virtual ~ccSetDPDIntegrator();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+	static bool IsIntegratorValid(const zString name);
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline const zString GetIntegrator() const {return m_Integrator;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	zString  m_Integrator;		// Name of the DPD integration scheme
+};
+
+#endif // !defined(AFX_CCSETDPDINTEGRATOR_H__5D93B1E7_2A6C_4F08_8B41_C7E03D95A2F6__INCLUDED_)
@@ -0,0 +1,81 @@
+// ccSetForcePrecision.h: interface for the ccSetForcePrecision class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CCSETFORCEPRECISION_H__2F9C61D7_84B3_4E0A_B6C5_93D1E7A4082B__INCLUDED_)
+#define AFX_CCSETFORCEPRECISION_H__2F9C61D7_84B3_4E0A_B6C5_93D1E7A4082B__INCLUDED_
+
+
+#include "xxCommand.h"
+
+class ccSetForcePrecision : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	ccSetForcePrecision(long executionTime);
+	ccSetForcePrecision(const ccSetForcePrecision& oldCommand);
+
+	ccSetForcePrecision(long executionTime, bool bLog, const zString name);
+
+	virtual ~ccSetForcePrecision();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+	static bool IsPrecisionValid(const zString name);
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline const zString GetPrecision() const {return m_Precision;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	zString  m_Precision;		// Precision of the non-bonded forces: Double or Mixed
+};
+
+#endif // !defined(AFX_CCSETFORCEPRECISION_H__2F9C61D7_84B3_4E0A_B6C5_93D1E7A4082B__INCLUDED_)
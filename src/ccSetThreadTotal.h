@@ -0,0 +1,79 @@
+// ccSetThreadTotal.h: interface for the ccSetThreadTotal class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CCSETTHREADTOTAL_H__4C9E7B12_A6D3_4E8F_B1C5_2F70D9E83A64__INCLUDED_)
+#define AFX_CCSETTHREADTOTAL_H__4C9E7B12_A6D3_4E8F_B1C5_2F70D9E83A64__INCLUDED_
+
+
+#include "xxCommand.h"
+
+class ccSetThreadTotal : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	ccSetThreadTotal(long executionTime);
+	ccSetThreadTotal(const ccSetThreadTotal& oldCommand);
+
+	ccSetThreadTotal(long executionTime, bool bLog, long threads);
+
+	virtual ~ccSetThreadTotal();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetThreadTotal() const {return m_ThreadTotal;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	long  m_ThreadTotal;			// Number of threads used for the non-bonded forces
+};
+
+#endif // !defined(AFX_CCSETTHREADTOTAL_H__4C9E7B12_A6D3_4E8F_B1C5_2F70D9E83A64__INCLUDED_)
@@ -0,0 +1,79 @@
+// ccSetVerletSkin.h: interface for the ccSetVerletSkin class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CCSETVERLETSKIN_H__8E2D4A61_5F3B_4C97_A0D8_6B1E92C7F354__INCLUDED_)
+#define AFX_CCSETVERLETSKIN_H__8E2D4A61_5F3B_4C97_A0D8_6B1E92C7F354__INCLUDED_
+
+
+#include "xxCommand.h"
+
+class ccSetVerletSkin : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	ccSetVerletSkin(long executionTime);
+	ccSetVerletSkin(const ccSetVerletSkin& oldCommand);
+
+	ccSetVerletSkin(long executionTime, bool bLog, double skin);
+
+	virtual ~ccSetVerletSkin();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline double GetSkin() const {return m_Skin;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	double  m_Skin;			// Skin of the Verlet pair list for the non-bonded forces
+};
+
+#endif // !defined(AFX_CCSETVERLETSKIN_H__8E2D4A61_5F3B_4C97_A0D8_6B1E92C7F354__INCLUDED_)
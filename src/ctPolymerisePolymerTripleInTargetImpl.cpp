@@ -65,8 +65,8 @@ void ctPolymerisePolymerTripleInTargetImpl::PolymerisePolymerTripleInTarget(cons
 	const zString polyName			= pCmd->GetPolymerName();
 	const zLongVector vHeadPos		= pCmd->GetHeadPositions();
 	const zLongVector vTailPos		= pCmd->GetTailPositions();
-	const double springConstant		= pCmd->GetSpringConstant();
-	const double unStretchedLength	= pCmd->GetUnstretchedLength();
+	double springConstant		= pCmd->GetSpringConstant();
+	double unStretchedLength	= pCmd->GetUnstretchedLength();
 
 	const long polyType	= pSimBox->GetPolymerTypeFromName(polyName);
 
@@ -131,10 +131,11 @@ void ctPolymerisePolymerTripleInTargetImpl::PolymerisePolymerTripleInTarget(cons
 		std::cout << headSize << "  " << tailSize << zEndl;
 
 
-#if SimIdentifier == MD
-		springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
-		unStretchedLength   /= pSimBox->GetLengthScale();
-#endif
+		if(xxBase::GetSimIdentifier() == MD)
+		{
+			springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
+			unStretchedLength   /= pSimBox->GetLengthScale();
+		}
 
 		pPolyBondTemplate = new CBond(polyBondType, springConstant, unStretchedLength);
 
@@ -81,8 +81,8 @@ void ctPolymerisePolymersInTargetImpl::PolymerisePolymersInTarget(const xxComman
 	const long   maxBondsPerPolymer	= pCmd->GetMaxBondsPerPolymer();
 	const double range			    = pCmd->GetRange();
 	const double fraction			= pCmd->GetBondFraction();
-	const double springConstant		= pCmd->GetSpringConstant();
-	const double unStretchedLength  = pCmd->GetUnstretchedLength();
+	double springConstant		= pCmd->GetSpringConstant();
+	double unStretchedLength  = pCmd->GetUnstretchedLength();
 
 	// Derived data
 
@@ -249,10 +249,11 @@ void ctPolymerisePolymersInTargetImpl::PolymerisePolymersInTarget(const xxComman
 
 		CBond* pPolyBondTemplate = 0;
 
-#if SimIdentifier == MD
-		springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
-		unStretchedLength   /= pSimBox->GetLengthScale();
-#endif
+		if(xxBase::GetSimIdentifier() == MD)
+		{
+			springConstant		*= (pSimBox->GetLengthScale()*pSimBox->GetLengthScale()/pSimBox->GetEnergyScale());
+			unStretchedLength   /= pSimBox->GetLengthScale();
+		}
 
 		pPolyBondTemplate = new CBond(polyBondType, springConstant, unStretchedLength);
 
@@ -45,6 +45,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
    If a runId of an existing simulation is specified the old output files are 
    overwritten.
   
+   In the serial code, if the first argument is "-ensemble" followed by a number 
+   of threads N, the remaining arguments are runIds of independent simulations 
+   that are run concurrently, N at a time, in this process. This is intended 
+   for replicas of a simulation that differ only in their random number seeds,
+   and the simulations must not depend on each other's output.
+  
    Error codes
    ***********
   
@@ -54,12 +60,14 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
    3 = Parallel simulation failed: Unable to initialise MPI
    4 = Parallel simulation failed: Unable to finalize MPI
    5 = Parallel batch simulation failed
+   6 = Serial ensemble simulation failed: at least one simulation failed
    
  ********************************************************************** */
 
 #include "StdAfx.h"
 #include "SimDefs.h"
 #include "Experiment.h"
+#include "Ensemble.h"
 
 int main(int argc, char* argv[])
 {
@@ -102,13 +110,7 @@ int main(int argc, char* argv[])
 
         if(my_rank == 0)
         {
-			#if SimIdentifier == BD
-				std::cout << "BD Experiment Code 1.5" << zEndl;
-			#elif SimIdentifier == DPD
-				std::cout << "DPD Experiment Code 1.5" << zEndl;
-			#elif SimIdentifier == MD
-				std::cout << "MD Experiment Code 1.5" << zEndl;
-			#endif
+			std::cout << "DPD Experiment Code 1.5" << zEndl;
 			std::cout << "Enter a runId (nnn): ";
 			std::cin >> runId;
 
@@ -199,17 +201,39 @@ int main(int argc, char* argv[])
 		// the error code is replaced by the successful value.
 		// If we reach here in the parallel code, it is an error as we only
 		// allow a single run on multiple processors.
+		//
+		// If an ensemble is requested, the simulations are run concurrently 
+		// and the error code shows if any of them failed.
 		
-		for(int i=1; i<argc; i++)
+		if(argc > 2 && zString(argv[1]) == "-ensemble")
 		{
-			runId.assign(argv[i]);
+			StringSequence vRunIds;
 
-			IExperiment* pIExpt = CExperiment::Instance("epstd", runId, true);
-			if(!pIExpt->Run())
+			for(int i=3; i<argc; i++)
 			{
-				errCode = 2;
+				vRunIds.push_back(zString(argv[i]));
+			}
+
+			CEnsemble ensemble(atol(argv[2]), vRunIds);
+
+			if(!ensemble.Run())
+			{
+				errCode = 6;
+			}
+		}
+		else
+		{
+			for(int i=1; i<argc; i++)
+			{
+				runId.assign(argv[i]);
+
+				IExperiment* pIExpt = CExperiment::Instance("epstd", runId, true);
+				if(!pIExpt->Run())
+				{
+					errCode = 2;
+				}
+				delete pIExpt;
 			}
-			delete pIExpt;
 		}
 #endif
 	}
@@ -54,13 +54,18 @@ void mcSaveProtocolFileImpl::SaveProtocolFile(const xxCommand* const pCommand)
 
 	zString simType;
 
-#if SimIdentifier == BD
-	simType = "bd";
-#elif SimIdentifier == DPD
-	simType = "dpd";
-#elif SimIdentifier == MD
-	simType = "md";
-#endif
+	if(xxBase::GetSimIdentifier() == BD)
+	{
+		simType = "bd";
+	}
+	else if(xxBase::GetSimIdentifier() == DPD)
+	{
+		simType = "dpd";
+	}
+	else if(xxBase::GetSimIdentifier() == MD)
+	{
+		simType = "md";
+	}
 
 	const zString protocolId	= pISimBox->GetInitialStateType();
 	const zString runId			= pISimBox->GetRunId();
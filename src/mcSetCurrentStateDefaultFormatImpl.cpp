@@ -136,6 +136,12 @@ void mcSetCurrentStateDefaultFormatImpl::SetCurrentStateDefaultFormat(const xxCo
             
             new CLogSetCurrentStateDefaultFormat(pMon->GetCurrentTime(), pMon->m_DefaultCurrentStateFormat);
     }
+	else if(format == "BinaryTrajectory")
+	{
+		pMon->m_DefaultCurrentStateFormat = "BinaryTrajectory";
+
+		new CLogSetCurrentStateDefaultFormat(pMon->GetCurrentTime(), pMon->m_DefaultCurrentStateFormat);
+	}
 	else
 	{
 		 new CLogCommandFailed(pMon->GetCurrentTime(), pCmd);
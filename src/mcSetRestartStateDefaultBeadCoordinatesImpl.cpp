@@ -45,6 +45,7 @@ void mcSetRestartStateDefaultBeadCoordinatesImpl::SetRestartStateDefaultBeadCoor
 	CMonitor* const pMon = dynamic_cast<CMonitor*>(this);
 
         pMon->m_bInclusiveRestartStates = false;
+        pMon->m_bBinaryRestartStates    = false;
 
 	new CLogSetRestartStateDefaultType(pMon->GetCurrentTime(), "bead coordinates only");
 }
@@ -0,0 +1,72 @@
+// mcSetRestartStateDefaultBinary.h: interface for the mcSetRestartStateDefaultBinary class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCSETRESTARTSTATEDEFAULTBINARY_H__5C3E91A7_2D84_4B6F_A0E3_97B1D46C8F25__INCLUDED_)
+#define AFX_MCSETRESTARTSTATEDEFAULTBINARY_H__5C3E91A7_2D84_4B6F_A0E3_97B1D46C8F25__INCLUDED_
+
+
+// Forward declarations
+
+class ISimCmd;
+
+
+#include "xxCommand.h"
+
+class mcSetRestartStateDefaultBinary : public xxCommand  
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+	mcSetRestartStateDefaultBinary(long executionTime);
+	mcSetRestartStateDefaultBinary(const mcSetRestartStateDefaultBinary& oldCommand);
+
+	virtual ~mcSetRestartStateDefaultBinary();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const zString GetCommandType() const;
+
+	static const zString GetType();	// Return the type of command
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Protected local functions
+
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+};
+
+#endif // !defined(AFX_MCSETRESTARTSTATEDEFAULTBINARY_H__5C3E91A7_2D84_4B6F_A0E3_97B1D46C8F25__INCLUDED_)
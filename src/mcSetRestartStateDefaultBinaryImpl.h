@@ -0,0 +1,61 @@
+// mcSetRestartStateDefaultBinaryImpl.h: interface for the mcSetRestartStateDefaultBinaryImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCSETRESTARTSTATEDEFAULTBINARYIMPL_H__B8F0E6D2_41C7_4A95_8E3B_0C5A7D29F164__INCLUDED_)
+#define AFX_MCSETRESTARTSTATEDEFAULTBINARYIMPL_H__B8F0E6D2_41C7_4A95_8E3B_0C5A7D29F164__INCLUDED_
+
+
+// Forward declarations
+
+class xxCommand;
+
+#include "IMonitorCmd.h"
+
+class mcSetRestartStateDefaultBinaryImpl : public virtual IMonitorCmd
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	mcSetRestartStateDefaultBinaryImpl();
+
+	virtual ~mcSetRestartStateDefaultBinaryImpl();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void SetRestartStateDefaultBinary(const xxCommand* const pCommand);
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+};
+
+#endif // !defined(AFX_MCSETRESTARTSTATEDEFAULTBINARYIMPL_H__B8F0E6D2_41C7_4A95_8E3B_0C5A7D29F164__INCLUDED_)
@@ -45,6 +45,7 @@ void mcSetRestartStateDefaultInclusiveImpl::SetRestartStateDefaultInclusive(cons
 	CMonitor* const pMon = dynamic_cast<CMonitor*>(this);
 
         pMon->m_bInclusiveRestartStates = true;
+        pMon->m_bBinaryRestartStates    = false;
 	new CLogSetRestartStateDefaultType(pMon->GetCurrentTime(), "inclusive");
 }
 
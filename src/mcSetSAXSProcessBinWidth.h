@@ -0,0 +1,82 @@
+// mcSetSAXSProcessBinWidth.h: interface for the mcSetSAXSProcessBinWidth class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCSETSAXSPROCESSBINWIDTH_H__9f643af6_a70b_48a2_9be1_0abea201b848__INCLUDED_)
+#define AFX_MCSETSAXSPROCESSBINWIDTH_H__9f643af6_a70b_48a2_9be1_0abea201b848__INCLUDED_
+
+
+// Forward declarations
+
+class ISimCmd;
+
+
+#include "xxCommand.h"
+
+class mcSetSAXSProcessBinWidth : public xxCommand
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	mcSetSAXSProcessBinWidth(long executionTime);
+	mcSetSAXSProcessBinWidth(const mcSetSAXSProcessBinWidth& oldCommand);
+
+	mcSetSAXSProcessBinWidth(long executionTime, long pid, double width);
+
+	virtual ~mcSetSAXSProcessBinWidth();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+    long    GetProcessId() const {return m_Pid;}
+    double  GetBinWidth()  const {return m_BinWidth;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+	// ****************************************
+	// Private functions
+private:
+
+	// ****************************************
+	// Data members
+private:
+
+    long      m_Pid;        // Unique id of the process in the order of creation of all processes
+    double    m_BinWidth;   // Width of the pair distance histogram bins (0 selects the direct pair sum)
+
+};
+
+#endif // !defined(AFX_MCSETSAXSPROCESSBINWIDTH_H__9f643af6_a70b_48a2_9be1_0abea201b848__INCLUDED_)
@@ -0,0 +1,77 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// mcSetSAXSProcessBinWidthImpl.cpp: implementation of the mcSetSAXSProcessBinWidthImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "mcSetSAXSProcessBinWidthImpl.h"
+#include "mcSetSAXSProcessBinWidth.h"
+#include "Monitor.h"
+#include "ISimBox.h"
+#include "aaRegionToType.h"
+#include "prSAXS.h"
+#include "LogSetSAXSProcessBinWidth.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+mcSetSAXSProcessBinWidthImpl::mcSetSAXSProcessBinWidthImpl()
+{
+}
+
+mcSetSAXSProcessBinWidthImpl::~mcSetSAXSProcessBinWidthImpl()
+{
+
+}
+
+// Command handler to select how a SAXS process evaluates the Debye sum. A positive bin width makes the process bin the
+// bead pair distances into a histogram of that width at each sample and obtain I(q) from the histogram; zero restores
+// the direct sum over all bead pairs. If the process does not exist, or is not a SAXS process, we exit with a
+// command failed message.
+
+void mcSetSAXSProcessBinWidthImpl::SetSAXSProcessBinWidth(const xxCommand* const pCommand)
+{
+	const mcSetSAXSProcessBinWidth* const pCmd = dynamic_cast<const mcSetSAXSProcessBinWidth*>(pCommand);
+
+    const long    pid      = pCmd->GetProcessId();
+	const double  width    = pCmd->GetBinWidth();
+
+	CMonitor* pMon = dynamic_cast<CMonitor*>(this);
+
+    ProcessSequence vProcesses = pMon->GetISimBox()->GetProcesses();
+    ProcessIterator iterProc = find_if(vProcesses.begin(), vProcesses.end(), aaGetProcessId(pid));
+        
+	if(iterProc!= vProcesses.end())
+	{
+        prSAXS* pSAXS = dynamic_cast<prSAXS*>(*iterProc);
+        
+        if(pSAXS && pSAXS->SetBinWidth(width))
+        {
+            const zString procName = prSAXS::GetType() + pMon->ToString(pid);
+                   
+            new CLogSetSAXSProcessBinWidth(pMon->GetCurrentTime(), procName, width);
+        }
+        else
+        {
+            new CLogCommandFailed(pMon->GetCurrentTime(), pCmd);
+        }
+	}
+	else
+	{
+		 new CLogCommandFailed(pMon->GetCurrentTime(), pCmd);
+	}
+}
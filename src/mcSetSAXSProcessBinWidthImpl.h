@@ -0,0 +1,61 @@
+// mcSetSAXSProcessBinWidthImpl.h: interface for the mcSetSAXSProcessBinWidthImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCSETSAXSPROCESSBINWIDTH_H__3663ac57_6790_47c5_b494_ce64622ca2cb__INCLUDED_)
+#define AFX_MCSETSAXSPROCESSBINWIDTH_H__3663ac57_6790_47c5_b494_ce64622ca2cb__INCLUDED_
+
+
+// Forward declarations
+
+class xxCommand;
+
+#include "IMonitorCmd.h"
+
+class mcSetSAXSProcessBinWidthImpl : public virtual IMonitorCmd
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	mcSetSAXSProcessBinWidthImpl();
+
+	virtual ~mcSetSAXSProcessBinWidthImpl();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void SetSAXSProcessBinWidth(const xxCommand* const pCommand);
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+};
+
+#endif // !defined(AFX_MCSETSAXSPROCESSBINWIDTH_H__3663ac57_6790_47c5_b494_ce64622ca2cb__INCLUDED_)
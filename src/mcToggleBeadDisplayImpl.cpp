@@ -22,6 +22,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Monitor.h"
 #include "SimState.h"
 #include "AbstractBead.h"
+#include "BeadRange.h"
 #include "LogBeadDisplay.h"
 
 //////////////////////////////////////////////////////////////////////
@@ -79,8 +80,8 @@ void mcToggleBeadDisplayImpl::ToggleBeadDisplay(const xxCommand* const pCommand)
             // The parallel code has to modify the beads actually held in the SimBox not those originally in the initial state instance
 			// as beads that move between processors are not added to the initial state.
 
-	        AbstractBeadVector vAllBeads = pMon->GetSimBoxBeads();
-	        for(AbstractBeadVectorIterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
+	        const CBeadRange vAllBeads = pMon->GetSimBoxBeadRange();
+	        for(CBeadRange::const_iterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
 	        {
                 if((*iterBead)->GetType() == beadType)
                 {
@@ -99,8 +100,8 @@ void mcToggleBeadDisplayImpl::ToggleBeadDisplay(const xxCommand* const pCommand)
             // The parallel code has to modify the beads actually held in the SimBox not those originally in the initial state instance
 			// as beads that move between processors are not added to the initial state.
 
-	        AbstractBeadVector vAllBeads = pMon->GetSimBoxBeads();
-	        for(AbstractBeadVectorIterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
+	        const CBeadRange vAllBeads = pMon->GetSimBoxBeadRange();
+	        for(CBeadRange::const_iterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
 	        {
                 if((*iterBead)->GetType() == beadType)
                 {
@@ -0,0 +1,71 @@
+// mcToggleHistoryStateStreaming.h: interface for the mcToggleHistoryStateStreaming class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCTOGGLEHISTORYSTATESTREAMING_H__8E2A5D37_C14B_4F98_9D06_3B7F1E2C6A84__INCLUDED_)
+#define AFX_MCTOGGLEHISTORYSTATESTREAMING_H__8E2A5D37_C14B_4F98_9D06_3B7F1E2C6A84__INCLUDED_
+
+
+// Forward declarations
+
+class ISimCmd;
+
+
+#include "xxCommand.h"
+
+class mcToggleHistoryStateStreaming : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: protected constructor declared below
+public:
+	mcToggleHistoryStateStreaming(long executionTime);
+	mcToggleHistoryStateStreaming(const mcToggleHistoryStateStreaming& oldCommand);
+
+	virtual ~mcToggleHistoryStateStreaming();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+
+	// ****************************************
+	// Public access functions
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const zString GetCommandType() const;
+
+	static const zString GetType();	// Return the type of command
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Protected local functions
+
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+};
+
+#endif // !defined(AFX_MCTOGGLEHISTORYSTATESTREAMING_H__8E2A5D37_C14B_4F98_9D06_3B7F1E2C6A84__INCLUDED_)
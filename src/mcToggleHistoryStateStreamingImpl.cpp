@@ -0,0 +1,62 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// mcToggleHistoryStateStreamingImpl.cpp: implementation of the mcToggleHistoryStateStreamingImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "mcToggleHistoryStateStreamingImpl.h"
+#include "mcToggleHistoryStateStreaming.h"
+#include "Monitor.h"
+#include "SimState.h"
+#include "HistoryState.h"
+#include "LogToggleHistoryStateStreaming.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+mcToggleHistoryStateStreamingImpl::mcToggleHistoryStateStreamingImpl()
+{
+}
+
+mcToggleHistoryStateStreamingImpl::~mcToggleHistoryStateStreamingImpl()
+{
+
+}
+
+// Command handler function to toggle on or off the streaming of the history
+// state. When streaming is on, the time series data are written to file in
+// large blocks and deleted after they are written, so that the memory used by
+// the history state does not grow with the length of the run. When it is off,
+// all the time series data are kept until the end of the run.
+//
+// The default is to keep the data.
+
+void mcToggleHistoryStateStreamingImpl::ToggleHistoryStateStreaming(const xxCommand* const pCommand)
+{
+//	const mcToggleHistoryStateStreaming* const pCmd = dynamic_cast<const mcToggleHistoryStateStreaming*>(pCommand);
+
+	CMonitor* pMon = dynamic_cast<CMonitor*>(this);
+
+	CHistoryState& rHistoryState = pMon->m_pSimState->GetHistoryState();
+
+	rHistoryState.SetStreaming(!rHistoryState.IsStreaming());
+
+	// This command cannot fail
+
+	new CLogToggleHistoryStateStreaming(pMon->GetCurrentTime(), rHistoryState.IsStreaming());
+}
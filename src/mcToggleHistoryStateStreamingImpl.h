@@ -0,0 +1,62 @@
+// mcToggleHistoryStateStreamingImpl.h: interface for the mcToggleHistoryStateStreamingImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCTOGGLEHISTORYSTATESTREAMINGIMPL_H__D49C0B61_7A2E_4C53_B8F4_E15A2D93706B__INCLUDED_)
+#define AFX_MCTOGGLEHISTORYSTATESTREAMINGIMPL_H__D49C0B61_7A2E_4C53_B8F4_E15A2D93706B__INCLUDED_
+
+
+// Forward declarations
+
+class xxCommand;
+
+#include "IMonitorCmd.h"
+
+
+class mcToggleHistoryStateStreamingImpl : public virtual IMonitorCmd
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	mcToggleHistoryStateStreamingImpl();
+
+	virtual ~mcToggleHistoryStateStreamingImpl();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void ToggleHistoryStateStreaming(const xxCommand* const pCommand);
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+};
+
+#endif // !defined(AFX_MCTOGGLEHISTORYSTATESTREAMINGIMPL_H__D49C0B61_7A2E_4C53_B8F4_E15A2D93706B__INCLUDED_)
@@ -56,7 +56,7 @@ namespace
 #endif
 }
 
-long mcToggleSliceEnergyOutput::m_CommandCounter = 0;
+thread_local long mcToggleSliceEnergyOutput::m_CommandCounter = 0;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -153,9 +153,12 @@ void pmBeadData::SetMessageData(const CInputData *const pData)
 
     m_BeadRadius = (pData->GetBeadTypes()).at(m_BeadType)->GetRadius();
  
-#if EnableDPDLG == ExperimentEnabled
-    m_LGRadius = pData->GetBeadTypes().at(m_BeadType).GetLGRadius();
-#endif
+    // The LG radius and interactions are only defined for a "dpdlg" run
+
+    if(pData->IsDPDLG())
+    {
+        m_LGRadius = (pData->GetBeadTypes()).at(m_BeadType)->GetLGRadius();
+    }
 
     // Now the conservative and dissipative interactions. We just want
     // the row in the vector corresponding to the bead type's interactions
@@ -165,18 +168,17 @@ void pmBeadData::SetMessageData(const CInputData *const pData)
     zArray2dDouble  vvConsInt = *pData->GetDPDBeadConsIntArray();
     zArray2dDouble  vvDissInt = *pData->GetDPDBeadDissIntArray();
 
-#if EnableDPDLG == ExperimentEnabled
     zArray2dDouble  vvLGInt = *pData->GetDPDBeadLGIntArray();
-#endif
 
 	for(long j=0; j<m_TypeTotal; j++)
 	{
 		m_vConsInt.push_back(vvConsInt.at(m_BeadType).at(j));
 		m_vDissInt.push_back(vvDissInt.at(m_BeadType).at(j));
 
-#if EnableDPDLG == ExperimentEnabled
-		m_vLGInt.push_back(vvLGInt.at(m_BeadType).at(j));
-#endif
+        if(pData->IsDPDLG())
+        {
+		    m_vLGInt.push_back(vvLGInt.at(m_BeadType).at(j));
+        }
 	}
 }
 
@@ -191,12 +193,10 @@ bool pmBeadData::Validate()
     {
         bSuccess = false;
     }
-#if EnableDPDLG == ExperimentEnabled
     else if(m_LGRadius < 0.0)
     {
         bSuccess = false;
     }
-#endif
 
     // Check the bead-bead interactions: note that the conservative parameters
     // are allowed to be negative, but not the dissipative or LG parameters.
@@ -208,12 +208,10 @@ bool pmBeadData::Validate()
             bSuccess = false;
         }
 
-#if EnableDPDLG == ExperimentEnabled
-        if(m_vLGInt.at(j) < 0.0)
+        if(!m_vLGInt.empty() && m_vLGInt.at(j) < 0.0)
         {
             bSuccess = false;
         }
-#endif
 	}
 
     return bSuccess;
@@ -165,15 +165,16 @@ void pmInputData::SetMessageData(const CInputData *const pData)
 
     // Simulation type-dependent parameters
 
-#if SimIdentifier == BD
-    m_Lambda            = pData->GetLambda();
-#elif SimIdentifier == DPD
-    m_Lambda            = pData->GetLambda();
-#elif SimIdentifier == MD
-    m_TotalMCTime       = pData->GetTotalMCTime();
-    m_RCutOff           = pData->GetCutOffRadius();
-    m_MCStepSize        = pData->GetMCStepSize();
-#endif
+    if(xxBase::GetSimIdentifier() == MD)
+    {
+        m_TotalMCTime       = pData->GetTotalMCTime();
+        m_RCutOff           = pData->GetCutOffRadius();
+        m_MCStepSize        = pData->GetMCStepSize();
+    }
+    else
+    {
+        m_Lambda            = pData->GetLambda();
+    }
 }
 
 // ****************************************
@@ -255,23 +256,17 @@ bool pmInputData::Validate()
         bSuccess = false;
     }
 
-#if SimIdentifier == BD
-    if(m_Lambda < 0.0 || m_Lambda > 1.0)
+    if(xxBase::GetSimIdentifier() == MD)
     {
-        bSuccess = false;
+        if(m_TotalMCTime < 0 || !(m_RCutOff > 0.0) || m_MCStepSize < 0.000001)
+        {
+            bSuccess = false;
+        }
     }
-#elif SimIdentifier == DPD
-    if(m_Lambda < 0.0 || m_Lambda > 1.0)
+    else if(m_Lambda < 0.0 || m_Lambda > 1.0)
     {
         bSuccess = false;
     }
-#elif SimIdentifier == MD
-    if(m_TotalMCTime < 0 || !(m_RCutOff > 0.0) || m_MCStepSize < 0.000001)
-    {
-        bSuccess = false;
-    }
-
-#endif
 
     return bSuccess;
 }
@@ -488,15 +483,13 @@ void pmInputData::BuildDerivedType(MsgDataTypePtr pMsgDataType)
     MPI_Get_address(&m_CNTZCellWidth,  &address);
     displacements[25] = address - startAddress;
 
-#if SimIdentifier == BD
-    MPI_Get_address(&m_Lambda,  &address);
-    displacements[26] = address - startAddress;
-#elif SimIdentifier == DPD
-    MPI_Get_address(&m_Lambda,  &address);
-    displacements[26] = address - startAddress;
-#elif SimIdentifier == MD
-// Not implemented yet
-#endif
+    // The MD parameters are not sent yet
+
+    if(xxBase::GetSimIdentifier() != MD)
+    {
+        MPI_Get_address(&m_Lambda,  &address);
+        displacements[26] = address - startAddress;
+    }
 
     // Build the derived datatype and commit it
 
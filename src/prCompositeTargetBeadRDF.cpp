@@ -74,7 +74,8 @@ namespace
 prCompositeTargetBeadRDF::prCompositeTargetBeadRDF() : m_AnalysisPeriods(0), m_DataPoints(0),
 									   m_TargetName(""), m_BeadType(-1), m_pTarget(0),
                                        m_RMax(0.0),
-									   m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_dr(0.0)
+									   m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_dr(0.0),
+									   m_Histogram(0, 0.0)
 {
 	m_vBeads.clear();
 	m_vRDF.clear();
@@ -95,7 +96,8 @@ prCompositeTargetBeadRDF::prCompositeTargetBeadRDF(const CSimState* const pSimSt
 									m_DataPoints(dataPoints),
 									m_TargetName(targetName), m_BeadType(beadType), m_pTarget(pTarget),
                                     m_RMax(rMax),
-									m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_dr(m_RMax/static_cast<double>(m_DataPoints))
+									m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_dr(m_RMax/static_cast<double>(m_DataPoints)),
+									m_Histogram(dataPoints, rMax)
 {
 	m_vBeads.clear();
 	m_vRDF.resize(m_DataPoints, 0.0);
@@ -212,61 +214,10 @@ void prCompositeTargetBeadRDF::UpdateState(CSimState& rSimState, const ISimBox*
 		std::cout << "Sample " <<  m_SamplesTaken << " of RDF at time " << pISimBox->GetCurrentTime() << zEndl;
 		
 		// Calculate the instantaneous RDF for beads of selected type and add to the running histogram.
-		// We iterate over each bead and add the number of beads within each spherical shell to a running
-		// total.
+		// Each pair of beads within the maximum distance is binned once into its shell by the
+		// shared cell-based histogram, using the number of threads set for the simulation.
 		
-		long beadPairNorm = 0;
-		
-		double dx[3];
-		
-		for(long ir=0; ir < m_DataPoints; ++ir)
-		{
-			const double rin = ir*m_dr;
-			const double rout = rin + m_dr;
-			
-			for(cBeadVectorIterator iterBead1 = m_vBeads.begin(); iterBead1!=m_vBeads.end(); ++iterBead1)
-			{
-				for(cBeadVectorIterator iterBead2 = m_vBeads.begin(); iterBead2!=m_vBeads.end(); ++iterBead2)
-				{
-					if(iterBead1 != iterBead2)
-					{
-						dx[0] = (*iterBead1)->GetXPos() - (*iterBead2)->GetXPos();
-						dx[1] = (*iterBead1)->GetYPos() - (*iterBead2)->GetYPos();
-						
-							// Correct for the PBCs
-
-							if( dx[0] > IGlobalSimBox::Instance()->GetHalfSimBoxXLength() )
-								dx[0] = dx[0] - IGlobalSimBox::Instance()->GetSimBoxXLength();
-							else if( dx[0] < -IGlobalSimBox::Instance()->GetHalfSimBoxXLength() )
-								dx[0] = dx[0] + IGlobalSimBox::Instance()->GetSimBoxXLength();
-
-							if( dx[1] > IGlobalSimBox::Instance()->GetHalfSimBoxYLength() )
-								dx[1] = dx[1] - IGlobalSimBox::Instance()->GetSimBoxYLength();
-							else if( dx[1] < -IGlobalSimBox::Instance()->GetHalfSimBoxYLength() )
-								dx[1] = dx[1] + IGlobalSimBox::Instance()->GetSimBoxYLength();
-
-						#if SimDimension == 3
-							dx[2] = (*iterBead1)->GetZPos() - (*iterBead2)->GetZPos();
-
-							if( dx[2] > IGlobalSimBox::Instance()->GetHalfSimBoxZLength() )
-								dx[2] = dx[2] - IGlobalSimBox::Instance()->GetSimBoxZLength();
-							else if( dx[2] < -IGlobalSimBox::Instance()->GetHalfSimBoxZLength() )
-								dx[2] = dx[2] + IGlobalSimBox::Instance()->GetSimBoxZLength();
-						#else
-							dx[2] = 0.0;
-						#endif
-						
-						const double dr = sqrt(dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2]);
-						
-						if(dr > rin && dr <= rout)
-						{
-							++beadPairNorm;
-							m_vRDF.at(ir) += 1;
-						}
-					}
-				}
-			}
-		}
+		long beadPairNorm = m_Histogram.AddPairs(m_vBeads, pISimBox, rSimState.GetThreadTotal(), m_vRDF);
 		
 		
 		// Normalise the summed histograms by the number of bead pairs found over all samples and shell volumes,
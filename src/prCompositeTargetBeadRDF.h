@@ -13,6 +13,7 @@ class CSimState;
 
 
 #include "xxProcess.h"
+#include "BeadPairHistogram.h"
 
 class prCompositeTargetBeadRDF : public xxProcess
 {
@@ -114,6 +115,8 @@ private:								// Data specific to the process
 	BeadVector  m_vBeads;				// Set of beads whose RDF is calculated
 	
 	zDoubleVector  m_vRDF;				// Vector of values in the RDF
+
+	CBeadPairHistogram  m_Histogram;	// Cell-based histogram of bead pair separations
 };
 
 #endif // !defined(AFX_PRCompositeTargetBeadRDF_H__006594ed_437a_497b_be01_ba455475c9d7__INCLUDED_)
@@ -72,7 +72,8 @@ namespace
 
 prPairCorrelationFunction::prPairCorrelationFunction() : m_AnalysisPeriods(0), m_DataPoints(0),
 									   m_RMax(0.0),
-									   m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_QPoints(0), m_dr(0.0)
+									   m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_QPoints(0), m_dr(0.0),
+									   m_Histogram(0, 0.0)
 {
     m_mPolyTypes.clear();
 	m_vBeads.clear();
@@ -94,7 +95,8 @@ prPairCorrelationFunction::prPairCorrelationFunction(const CSimState* const pSim
 									m_DataPoints(dataPoints), m_RMax(rMax),
 									m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0), m_QPoints(100),
                                     m_dr(m_RMax/static_cast<double>(m_DataPoints)),
-                                    m_mPolyTypes(mPolyTypes)
+                                    m_mPolyTypes(mPolyTypes),
+                                    m_Histogram(dataPoints, rMax)
 {
 	m_vBeads.clear();
     m_vRDF.resize(m_DataPoints, 0.0);
@@ -217,61 +219,10 @@ void prPairCorrelationFunction::UpdateState(CSimState& rSimState, const ISimBox*
 //		std::cout << "Sample " <<  m_SamplesTaken << " of g(r) at time " << pISimBox->GetCurrentTime() << zEndl;
 		
 		// Calculate the instantaneous RDF for beads of the selected types and add to the running histogram.
-		// We iterate over each bead and add the number of beads within each spherical shell to a running
-		// total.
+		// Each pair of beads within the maximum distance is binned once into its shell by the
+		// shared cell-based histogram, using the number of threads set for the simulation.
 		
-		long beadPairNorm = 0;
-		
-		double dx[3];
-		
-		for(long ir=0; ir < m_DataPoints; ++ir)
-		{
-			const double rin = ir*m_dr;
-			const double rout = rin + m_dr;
-			
-			for(cBeadVectorIterator iterBead1 = m_vBeads.begin(); iterBead1!=m_vBeads.end(); ++iterBead1)
-			{
-				for(cBeadVectorIterator iterBead2 = m_vBeads.begin(); iterBead2!=m_vBeads.end(); ++iterBead2)
-				{
-					if(iterBead1 != iterBead2)
-					{
-						dx[0] = (*iterBead1)->GetXPos() - (*iterBead2)->GetXPos();
-						dx[1] = (*iterBead1)->GetYPos() - (*iterBead2)->GetYPos();
-						
-							// Correct for the PBCs
-
-							if( dx[0] > IGlobalSimBox::Instance()->GetHalfSimBoxXLength() )
-								dx[0] = dx[0] - IGlobalSimBox::Instance()->GetSimBoxXLength();
-							else if( dx[0] < -IGlobalSimBox::Instance()->GetHalfSimBoxXLength() )
-								dx[0] = dx[0] + IGlobalSimBox::Instance()->GetSimBoxXLength();
-
-							if( dx[1] > IGlobalSimBox::Instance()->GetHalfSimBoxYLength() )
-								dx[1] = dx[1] - IGlobalSimBox::Instance()->GetSimBoxYLength();
-							else if( dx[1] < -IGlobalSimBox::Instance()->GetHalfSimBoxYLength() )
-								dx[1] = dx[1] + IGlobalSimBox::Instance()->GetSimBoxYLength();
-
-						#if SimDimension == 3
-							dx[2] = (*iterBead1)->GetZPos() - (*iterBead2)->GetZPos();
-
-							if( dx[2] > IGlobalSimBox::Instance()->GetHalfSimBoxZLength() )
-								dx[2] = dx[2] - IGlobalSimBox::Instance()->GetSimBoxZLength();
-							else if( dx[2] < -IGlobalSimBox::Instance()->GetHalfSimBoxZLength() )
-								dx[2] = dx[2] + IGlobalSimBox::Instance()->GetSimBoxZLength();
-						#else
-							dx[2] = 0.0;
-						#endif
-						
-						const double dr = sqrt(dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2]);
-						
-						if(dr > rin && dr <= rout)
-						{
-							++beadPairNorm;
-							m_vRDF.at(ir) += 1;
-						}
-					}
-				}
-			}
-		}
+		long beadPairNorm = m_Histogram.AddPairs(m_vBeads, pISimBox, rSimState.GetThreadTotal(), m_vRDF);
 		
 		
 		// Normalise the summed histograms by the number of bead pairs found over all samples and shell volumes,
@@ -381,54 +332,20 @@ bool prPairCorrelationFunction::InternalValidateData(const ISimState* const pISi
 	return true;
 }
 
-// Trapezoidal approximation to an integral. We use the stored values of g(r) calculated above. The infinitesimal width of the bins is passed
-// in as the only argument. But if this routine is used to integrate a function specified at a discrete number of points, the calling routine
+// Trapezoidal approximation to the integral of g(r) weighted by sin(qr)/qr over all space. We use the stored values of g(r) 
+// calculated above, and the integral itself is evaluated by the shared CBeadPairHistogram so that other processes can
+// transform their histograms in the same way. The infinitesimal width of the bins is passed in as the only argument. 
+// But if this routine is used to integrate a function specified at a discrete number of points, the calling routine
 // must ensure that dh is set to the spacing of the data.
-//
-// Note that dividing the integration range into N points actually requires N+1 values of the function as we integrate from 0 to N*h inclusively.
-// There must be enough points in vector to account for this.
 
 void prPairCorrelationFunction::TrapezoidalRule(const double dh)
 {    
-    const long N = m_vRDF.size()-1;  // No of values of integrand in integral
-    
     const double qmin = xxBase::m_globalTwoPI/IGlobalSimBox::Instance()->GetSimBoxZLength();  // We assume the box is cubic and use LZ
     const double qmax = xxBase::m_globalTwoPI;  // d0 = 1
         
     const double dq = (qmax - qmin)/static_cast<double>(m_QPoints);
     
-   // Zero the vector holding the I(q) function. Note it was sized in the constructor.
-    
-//    std::cout << "****************************************" << zEndl;
-//    std::cout << "Trapezoidal rule using data: " << qmin << " " << qmax << " " << dq << " " << m_QPoints << " " << dh << " " << N << " " << m_vRDF.size() << zEndl;
-    
-    double qvalue = qmin;
-    
-    for(long iq = 0; iq < m_QPoints; ++iq)
-    {
-        // Integrate g(r) over all space
-        
-        double integrand;
-        integrand = 0.0;
-        
-        double rvalue;
-        rvalue = m_dr;
-
-        for(long ir = 1; ir < N; ++ir)
-        {
-            integrand += m_vRDF.at(ir)*sin(qvalue*rvalue)/(qvalue*rvalue);
-            rvalue += m_dr;
-        }
-    
-        // Now add in the end points, noting that sin(0)/0 = 1.
-        
-        integrand += 0.5*(m_vRDF.at(0) + m_vRDF.at(N)*sin(qvalue*rvalue)/(qvalue*rvalue));
-        
-        integrand *= dh*xxBase::m_globalFourPI;
-        
-        m_vIQ.at(iq) = integrand;
-        
-        qvalue += dq;
-    }
+    // The vector holding the I(q) function was sized in the constructor.
 
+    CBeadPairHistogram::SineTransform(m_vRDF, dh, qmin, dq, m_vIQ);
 }
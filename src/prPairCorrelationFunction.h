@@ -12,6 +12,7 @@ class CSimState;
 
 
 #include "xxProcess.h"
+#include "BeadPairHistogram.h"
 
 class prPairCorrelationFunction : public xxProcess
 {
@@ -119,6 +120,8 @@ private:								// Data specific to the process
 	
 	zDoubleVector  m_vRDF;				// Vector of values in the RDF
     zDoubleVector  m_vIQ;               // Scattering function I(q)
+
+	CBeadPairHistogram  m_Histogram;	// Cell-based histogram of bead pair separations
 };
 
 #endif // !defined(AFX_PRPAIRCORRELATIONFUNCTION_H__cea70618_9e49_4b90_8cf4_3ada0dad639d__INCLUDED_)
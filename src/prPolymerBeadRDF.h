@@ -12,6 +12,7 @@ class CSimState;
 
 
 #include "xxProcess.h"
+#include "BeadPairHistogram.h"
 
 class prPolymerBeadRDF : public xxProcess
 {
@@ -112,6 +113,8 @@ private:								// Data specific to the process
 	BeadVector  m_vBeads;				// Set of beads whose RDF is calculated
 	
 	zDoubleVector  m_vRDF;				// Vector of values in the RDF
+
+	CBeadPairHistogram  m_Histogram;	// Cell-based histogram of bead pair separations
 };
 
 #endif // !defined(AFX_PRPOLYMERBEADRDF_H__cbdecf22_41a0_4085_9e2a_eeef73cd0edb__INCLUDED_)
@@ -85,7 +85,8 @@ namespace
 
 // Default constructor
 
-prSAXS::prSAXS() : m_AnalysisPeriods(0), m_QPoints(0), m_QMin(0.0), m_QMax(0.0), m_dQ(0.0), m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0)
+prSAXS::prSAXS() : m_AnalysisPeriods(0), m_QPoints(0), m_QMin(0.0), m_QMax(0.0), m_dQ(0.0), m_BinWidth(0.0), m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0),
+                   m_BinTotal(0)
 {
     m_mBeadTypes.clear();
 	m_vBeads.clear();
@@ -109,8 +110,9 @@ prSAXS::prSAXS(const CSimState* const pSimState,
                                     m_QMin(xxBase::m_globalTwoPI/IGlobalSimBox::Instance()->GetSimBoxZLength()),
                                     m_QMax(xxBase::m_globalTwoPI),
                                     m_dQ((m_QMax - m_QMin)/static_cast<double>(m_QPoints-1)),
+                                    m_BinWidth(0.0),
 									m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0),
-                                    m_mBeadTypes(mBeadTypes)
+                                    m_mBeadTypes(mBeadTypes), m_BinTotal(0)
 {
 	m_vBeads.clear();
     m_vIQ.resize(m_QPoints, 0.0);  // This can be overwritten in the sum over bead pairs
@@ -189,8 +191,9 @@ prSAXS::prSAXS(const CSimState* const pSimState,
                                     m_QPoints(qPoints),
                                     m_QMin(qMin), m_QMax(qMax),
                                     m_dQ((m_QMax - m_QMin)/static_cast<double>(m_QPoints-1)),
+                                    m_BinWidth(0.0),
                                     m_SamplePeriod(0), m_SampleTotal(0), m_SamplesTaken(0),
-                                    m_mBeadTypes(mBeadTypes)
+                                    m_mBeadTypes(mBeadTypes), m_BinTotal(0)
 {
     m_vBeads.clear();
     m_vIQ.resize(m_QPoints, 0.0);
@@ -329,13 +332,19 @@ void prSAXS::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
             m_vIQ.assign(origIq.begin(), origIq.end());
             m_vIQSq.assign(origIqSqr.begin(), origIqSqr.end());
             begin=now();		
-            UpdateState_InnerLoop_v4_threads(rSimState, pISimBox);
+            if(m_BinWidth > 0.0){
+                UpdateState_Histogram(rSimState, pISimBox);
+            }else{
+                UpdateState_InnerLoop_v4_threads(rSimState, pISimBox);
+            }
             end=now();
             std::cout<<"   v2 took "<<(end-begin)<<"secs\n";
 
             for(unsigned i=0; i<refIq.size(); i++){
                 std::cout<<"   "<<i<<", "<<refIq[i]<<", "<<m_vIQ[i]<<"\n";
             }
+        }else if(m_BinWidth > 0.0){
+            UpdateState_Histogram(rSimState, pISimBox);
         }else{
             UpdateState_InnerLoop_v4_threads(rSimState, pISimBox);
         }
@@ -1331,6 +1340,176 @@ bool prSAXS::InternalValidateData(const ISimState* const pISimState)
 	return true;
 }
 
+
+// Histogram mode for the Debye sum. Instead of evaluating sin(qr)/qr for every bead pair and every q value,
+// the electron-weighted pair distances are binned once per sample into a histogram of width m_BinWidth,
+// and the Debye transform is applied to the histogram for each q value. The cost per sample is O(N*N) for
+// the binning plus O(bins*Q) for the transform, instead of O(N*N*Q). The histogram is accumulated in 
+// double precision, and each bin contributes at its centre so the relative error in sin(qr)/qr is of 
+// order (q*binWidth)**2/24. The pairs are not restricted to a cutoff, so the full Debye sum is retained; 
+// as in the reference loop, no PBCs are applied to the separations.
+//
+// The beads are shared between the threads set for the simulation, each thread binning its pairs into
+// its own histogram. The histogram of the squared weights reproduces the m_vIQSq sum of the reference loop.
+
+void prSAXS::UpdateState_Histogram(CSimState& rSimState, const ISimBox* const pISimBox)
+{
+    const long beadTotal = m_vBeads.size();
+
+    if(beadTotal == 0)
+        return;
+
+    m_vPos.resize(3*beadTotal);
+    m_vENo.resize(beadTotal);
+
+    // Copy the bead coordinates and electron numbers, and add up the i = j terms, which contribute
+    // F(q)**2 at every q because sin(x)/x = 1 when x = 0. We also find the bounding box of the beads
+    // to size the histogram.
+
+    double selfSum   = 0.0;
+    double selfSqSum = 0.0;
+    double lower[3] = {0.0, 0.0, 0.0};
+    double upper[3] = {0.0, 0.0, 0.0};
+
+    for(long i=0; i<beadTotal; i++)
+    {
+        const CBead* const pBead = m_vBeads[i];
+
+        LongDoubleIterator iterENo = m_mElectronNo.find(pBead->GetType());
+
+        const double eno = (iterENo != m_mElectronNo.end()) ? iterENo->second : 0.0;
+
+        m_vPos[3*i]   = pBead->GetXPos();
+        m_vPos[3*i+1] = pBead->GetYPos();
+        m_vPos[3*i+2] = pBead->GetZPos();
+        m_vENo[i]     = eno;
+
+        selfSum   += eno*eno;
+        selfSqSum += eno*eno*eno*eno;
+
+        for(short int j=0; j<3; j++)
+        {
+            if(i == 0 || m_vPos[3*i+j] < lower[j])
+                lower[j] = m_vPos[3*i+j];
+            if(i == 0 || m_vPos[3*i+j] > upper[j])
+                upper[j] = m_vPos[3*i+j];
+        }
+    }
+
+    const double rMax = sqrt((upper[0]-lower[0])*(upper[0]-lower[0]) + (upper[1]-lower[1])*(upper[1]-lower[1]) + (upper[2]-lower[2])*(upper[2]-lower[2]));
+
+    m_BinTotal = static_cast<long>(rMax/m_BinWidth) + 2;
+
+    const long threadTotal = std::max(1L, std::min(rSimState.GetThreadTotal(), beadTotal));
+
+    m_vPairHist.assign(threadTotal*m_BinTotal, 0.0);
+    m_vPairHistSq.assign(threadTotal*m_BinTotal, 0.0);
+
+    if(threadTotal == 1)
+    {
+        BinPairs(0, 1);
+    }
+    else
+    {
+        std::vector<std::thread> vThreads;
+
+        for(long thread=1; thread<threadTotal; thread++)
+        {
+            vThreads.push_back(std::thread(&prSAXS::BinPairs, this, thread, threadTotal));
+        }
+
+        BinPairs(0, threadTotal);
+
+        for(std::vector<std::thread>::iterator iterThread=vThreads.begin(); iterThread!=vThreads.end(); iterThread++)
+        {
+            iterThread->join();
+        }
+
+        for(long thread=1; thread<threadTotal; thread++)
+        {
+            for(long bin=0; bin<m_BinTotal; bin++)
+            {
+                m_vPairHist[bin]   += m_vPairHist[thread*m_BinTotal + bin];
+                m_vPairHistSq[bin] += m_vPairHistSq[thread*m_BinTotal + bin];
+            }
+        }
+    }
+
+    // Apply the Debye transform to the histogram for each q value
+
+    for(long iq=0; iq<m_QPoints; ++iq)
+    {
+        const double qvalue = m_QMin + iq*m_dQ;
+
+        double iqSum   = selfSum;
+        double iqSqSum = selfSqSum;
+
+        for(long bin=0; bin<m_BinTotal; bin++)
+        {
+            if(m_vPairHist[bin] != 0.0 || m_vPairHistSq[bin] != 0.0)
+            {
+                const double qr   = qvalue*(static_cast<double>(bin) + 0.5)*m_BinWidth;
+                const double sinc = sin(qr)/qr;
+
+                iqSum   += m_vPairHist[bin]*sinc;
+                iqSqSum += m_vPairHistSq[bin]*sinc*sinc;
+            }
+        }
+
+        m_vIQ[iq]   += iqSum;
+        m_vIQSq[iq] += iqSqSum;
+    }
+}
+
+// Private function to bin the separations of the pairs (i1, i2), with i2 > i1, for every threadTotal'th 
+// bead i1 starting at bead thread into the thread's own histograms. Each pair is counted twice, for i1 < i2 
+// and i2 < i1, as in the reference loop.
+
+void prSAXS::BinPairs(long thread, long threadTotal)
+{
+    const long beadTotal = m_vENo.size();
+    const double invBinWidth = 1.0/m_BinWidth;
+
+    double* const pHist   = &m_vPairHist[thread*m_BinTotal];
+    double* const pHistSq = &m_vPairHistSq[thread*m_BinTotal];
+
+    for(long i1=thread; i1<beadTotal; i1+=threadTotal)
+    {
+        const double x1   = m_vPos[3*i1];
+        const double y1   = m_vPos[3*i1+1];
+        const double z1   = m_vPos[3*i1+2];
+        const double eno1 = m_vENo[i1];
+
+        for(long i2=i1+1; i2<beadTotal; i2++)
+        {
+            const double dx = x1 - m_vPos[3*i2];
+            const double dy = y1 - m_vPos[3*i2+1];
+            const double dz = z1 - m_vPos[3*i2+2];
+
+            const double eprod = eno1*m_vENo[i2];
+
+            const long bin = std::min(m_BinTotal-1, static_cast<long>(sqrt(dx*dx + dy*dy + dz*dz)*invBinWidth));
+
+            pHist[bin]   += 2.0*eprod;
+            pHistSq[bin] += 2.0*eprod*eprod;
+        }
+    }
+}
+
+// Function to select the histogram evaluation of the Debye sum. A positive bin width makes the process bin the
+// pair distances into a histogram of that width at each sample and obtain I(q) from it; zero restores the direct 
+// sum over all bead pairs. Negative values are rejected.
+
+bool prSAXS::SetBinWidth(double binWidth)
+{
+    if(binWidth < 0.0)
+        return false;
+
+    m_BinWidth = binWidth;
+
+    return true;
+}
+
 // Function to set the number of electrons in a specified bead type. We allow fractional values.
 
 bool prSAXS::SetBeadTypeElectronNo(long beadType, double eno)
@@ -77,6 +77,7 @@ public:
 public:
 
     bool SetBeadTypeElectronNo(long beadType, double eno);
+    bool SetBinWidth(double binWidth);
     
     
 	// ****************************************
@@ -104,6 +105,9 @@ protected:
 	void UpdateState_InnerLoop_v4_stl_parallel(CSimState& rSimState, const ISimBox* const pISimBox);
 	#endif
 
+	void UpdateState_Histogram(CSimState& rSimState, const ISimBox* const pISimBox);
+	void BinPairs(long thread, long threadTotal);
+
 	double DistanceMetric(const CAbstractBead *a, const CAbstractBead *b) const;
 	float DistanceMetric(const float *a, const float *b) const;
 
@@ -117,6 +121,7 @@ private:								// Data specific to the process
     double       m_QMin;                // Minimum q value in range (inverse Angstrom)
     double       m_QMax;                // Maximum q value in range (inverse Angstrom)
     const double m_dQ;                  // Increment in the scattering wave vector magnitude q (inverse Angstrom)
+    double       m_BinWidth;            // Width of the pair distance histogram bins (0 selects the direct pair sum)
 
     LongLongMap  m_mBeadTypes;          // Map of the bead numeric type ids to include in calculation
     
@@ -132,6 +137,14 @@ private:								// Data specific to the process
     zDoubleVector  m_vIQSq;             // Sqaure of the scattering function I(q)*I(q)
 
     LongDoubleMap  m_mElectronNo;       // Map of bead type to electron number
+
+    // Data used by the histogram mode
+
+    long           m_BinTotal;          // Number of bins in the pair distance histogram at the current sample
+    zDoubleVector  m_vPos;              // Bead coordinates, three per bead
+    zDoubleVector  m_vENo;              // Bead electron numbers
+    zDoubleVector  m_vPairHist;         // Electron-weighted pair distance histogram for each thread
+    zDoubleVector  m_vPairHistSq;       // Histogram of the squared weights for each thread
 };
 
 #endif // !defined(AFX_PRSAXS_H__61400260_244d_4846_9515_83b1ff18a708__INCLUDED_)
@@ -0,0 +1,151 @@
+// xxArena.h: interface for the xxArena class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_XXARENA_H__6C1F0B7E_52D4_4A39_9E83_2B7D4C90A5F1__INCLUDED_)
+#define AFX_XXARENA_H__6C1F0B7E_52D4_4A39_9E83_2B7D4C90A5F1__INCLUDED_
+
+
+#include <new>
+#include <utility>
+#include <vector>
+
+// Typed arena that constructs objects of class T in large contiguous blocks
+// instead of allocating each one separately with new. Objects are placed
+// in the order in which they are created, and they live until the arena is
+// cleared or destroyed: there is no way to free a single object. The arena
+// owns its objects and calls their destructors, in the reverse order of
+// their creation, when it is cleared. Objects created in an arena must
+// therefore never be deleted by their users.
+//
+// Calling Reserve() with the number of objects that are about to be created
+// guarantees that they occupy a single block. If more objects are created
+// than were reserved a new block is started, so the objects never move
+// once constructed and pointers to them remain valid.
+//
+// Usage:
+//
+//	xxArena<CBead> beads;
+//	beads.Reserve(beadTotal);
+//	CBead* pBead = beads.Create(*pBeadType);
+
+template <class T>
+class xxArena
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	xxArena() : m_Size(0)
+	{
+	}
+
+	~xxArena()
+	{
+		Clear();
+	}
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long size() const  {return m_Size;}
+	inline bool empty() const {return m_Size == 0;}
+
+	// Ensure that the next total objects are created in a single block.
+	// Any unused space in the current block is abandoned if it is too small.
+
+	void Reserve(long total)
+	{
+		if(total > 0 && (m_Blocks.empty() || m_Blocks.back().capacity - m_Blocks.back().size < total))
+		{
+			AddBlock(total);
+		}
+	}
+
+	// Construct a new object in the arena, forwarding the arguments to
+	// T's constructor. Typically this is a copy of a template object.
+
+	template <typename... Args>
+	T* Create(Args&&... args)
+	{
+		if(m_Blocks.empty() || m_Blocks.back().size == m_Blocks.back().capacity)
+		{
+			long capacity = m_DefaultBlockSize;
+
+			if(!m_Blocks.empty())
+			{
+				capacity = 2*m_Blocks.back().capacity;
+			}
+
+			AddBlock(capacity);
+		}
+
+		Block& rBlock = m_Blocks.back();
+
+		T* const pObject = new(rBlock.pFirst + rBlock.size) T(std::forward<Args>(args)...);
+
+		rBlock.size++;
+		m_Size++;
+
+		return pObject;
+	}
+
+	// Destroy all objects, most recently created first, and release the memory.
+
+	void Clear()
+	{
+		while(!m_Blocks.empty())
+		{
+			Block& rBlock = m_Blocks.back();
+
+			for(long i=rBlock.size-1; i>=0; i--)
+			{
+				rBlock.pFirst[i].~T();
+			}
+
+			::operator delete(rBlock.pFirst);
+			m_Blocks.pop_back();
+		}
+
+		m_Size = 0;
+	}
+
+	// ****************************************
+	// Private functions
+private:
+
+	// Explicitly disallow the copy constructor and assignment operator
+	// by declaring them privately but providing NO definitions.
+
+	xxArena(const xxArena& oldArena);
+	xxArena& operator=(const xxArena& rhs);
+
+	void AddBlock(long capacity)
+	{
+		Block newBlock;
+		newBlock.pFirst   = static_cast<T*>(::operator new(capacity*sizeof(T)));
+		newBlock.size     = 0;
+		newBlock.capacity = capacity;
+
+		m_Blocks.push_back(newBlock);
+	}
+
+	// ****************************************
+	// Data members
+private:
+
+	struct Block
+	{
+		T*   pFirst;		// Uninitialised storage for capacity objects
+		long size;			// Number of objects constructed in the block
+		long capacity;
+	};
+
+	static const long m_DefaultBlockSize = 1024;
+
+	std::vector<Block> m_Blocks;
+	long               m_Size;		// Number of objects in all blocks
+};
+
+#endif // !defined(AFX_XXARENA_H__6C1F0B7E_52D4_4A39_9E83_2B7D4C90A5F1__INCLUDED_)
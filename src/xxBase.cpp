@@ -32,6 +32,8 @@ const double xxBase::m_globalTwoPI	 = 2.0*m_globalPI;
 const double xxBase::m_globalFourPI	 = 4.0*m_globalPI;
 const double xxBase::m_globalPIByTwo = 0.5*m_globalPI;
 
+thread_local long xxBase::m_SimIdentifier = DPD;
+
 // **********************************************************************
 // Global Functions.
 //
@@ -54,6 +56,15 @@ const zString xxBase::GetFilePrefix()
     return "dmpc";
 }
     
+// Function to set the simulation type for the run in the calling thread. It is 
+// called by CInputData when it reads the first token of the control data file,
+// before any beads or cells are created, and defaults to DPD.
+
+void xxBase::SetSimIdentifier(long simType)
+{
+    m_SimIdentifier = simType;
+}
+
 // Return the prefix for each input/output file type. Note that the "." between
 // the prefix and extension IS included in these strings.
 
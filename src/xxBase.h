@@ -235,6 +235,10 @@ typedef xxBasevector<double>							zDoubleVector;
 typedef xxBasevector<double>::iterator					zDoubleVectorIterator;
 typedef xxBasevector<double>::const_iterator			czDoubleVectorIterator;
 
+typedef xxBasevector<float>								zFloatVector;
+typedef xxBasevector<float>::iterator					zFloatVectorIterator;
+typedef xxBasevector<float>::const_iterator				czFloatVectorIterator;
+
 typedef	xxBasevector<xxBasevector<long> >				zArray2dLong;
 typedef	xxBasevector<xxBasevector<double> >				zArray2dDouble;
 typedef	xxBasevector<xxBasevector<zString> >	        zArray2dString;
@@ -819,6 +823,12 @@ public:			// static constants used in initialisation routines
 
     static const zString GetFilePrefix();
 
+    // Simulation type (DPD, MD or BD defined in SimDefs.h) of the run in the 
+    // calling thread, set when its control data file is read.
+
+    static inline long GetSimIdentifier() {return m_SimIdentifier;}
+    static void SetSimIdentifier(long simType);
+
     static const zString GetAAPrefix();
     static const zString GetASPrefix();
     static const zString GetCDFPrefix();
@@ -858,6 +868,9 @@ protected:
 	virtual void TraceDouble2(zString msgStr, double var1, double var2) const;
 	virtual void TraceVector(zString msgStr, double var1, double var2, double var3) const;
 
+private:
+
+    static thread_local long m_SimIdentifier;
 
 };
 
@@ -59,9 +59,12 @@ zOutStream& operator<<(zOutStream& os, xxMessage& rMsg)
 	return os;
 }
 
-// Static member variable holding the number of messages created.
+// Static member variables holding the number of messages that exist and
+// the number of ids issued. They differ because the CLogState deletes 
+// messages once they have been written to file.
 
-long   xxMessage::m_MessageTotal = 0;
+thread_local long   xxMessage::m_MessageTotal   = 0;
+thread_local long   xxMessage::m_MessageIdTotal = 0;
 
 // Static member function to return the total number of messages created.
 // We have to name it differently so that it does not clash with the 
@@ -72,18 +75,26 @@ long xxMessage::StaticGetMessageTotal()
 	return m_MessageTotal;
 }
 
+// Static member function to restart the message ids at 1 for a new simulation.
+
+void xxMessage::StaticResetMessageIds()
+{
+	m_MessageIdTotal = 0;
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 //
 // Increment the message counter for each message created. When a message is
-// destroyed, the counter is decremented.
+// destroyed, the counter is decremented. The message's id is taken from a
+// separate counter so that ids stay unique when messages are deleted.
 
-xxMessage::xxMessage(long time) : m_id(++m_MessageTotal), m_Time(time),
+xxMessage::xxMessage(long time) : m_id(++m_MessageIdTotal), m_Time(time),
 								  m_bIsSerialized(false)
 
 {
-
+	m_MessageTotal++;
 }
 
 xxMessage::~xxMessage()
@@ -29,10 +29,12 @@ public:
 	friend zOutStream& operator<<(zOutStream& os, xxMessage& rMsg);
 
 	static long StaticGetMessageTotal();
+	static void StaticResetMessageIds();
 
 private:
 
-	static long m_MessageTotal;		// Total number of created messages
+	static thread_local long m_MessageTotal;		// Total number of existing messages
+	static thread_local long m_MessageIdTotal;	// Number of message ids issued
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -22,11 +22,11 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // ****************************************
 // Global members to return information about a parallel experiment
 
-long   xxParallelBase::m_World = 0;
-long   xxParallelBase::m_Rank  = 0;
-double xxParallelBase::m_SimBoxXOrigin  = 0.0;
-double xxParallelBase::m_SimBoxYOrigin  = 0.0;
-double xxParallelBase::m_SimBoxZOrigin  = 0.0;
+thread_local long   xxParallelBase::m_World = 0;
+thread_local long   xxParallelBase::m_Rank  = 0;
+thread_local double xxParallelBase::m_SimBoxXOrigin  = 0.0;
+thread_local double xxParallelBase::m_SimBoxYOrigin  = 0.0;
+thread_local double xxParallelBase::m_SimBoxZOrigin  = 0.0;
 
 long xxParallelBase::GlobalGetWorld()
 {
@@ -38,12 +38,12 @@ public:
 
 protected:
 
-    static long m_World;  // Number of processors used for a parallel experiment
-    static long m_Rank;   // Rank of this instance of the program
+    static thread_local long m_World;  // Number of processors used for a parallel experiment
+    static thread_local long m_Rank;   // Rank of this instance of the program
 
-    static double m_SimBoxXOrigin;
-    static double m_SimBoxYOrigin;  // Coordinates of processor's origin in Space
-    static double m_SimBoxZOrigin;
+    static thread_local double m_SimBoxXOrigin;
+    static thread_local double m_SimBoxYOrigin;  // Coordinates of processor's origin in Space
+    static thread_local double m_SimBoxZOrigin;
 
 
 	// ****************************************
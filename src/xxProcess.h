@@ -43,7 +43,7 @@ public:
 
 private:
 
-	static long m_ProcessTotal;	// Number of processes created
+	static thread_local long m_ProcessTotal;	// Number of processes created
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes